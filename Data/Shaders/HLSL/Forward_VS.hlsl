@@ -1,6 +1,7 @@
 #include "Include/Forward.hlsli"
 #include "Include/Forward_VS.hlsli"
 #include "Include/Skinning.hlsli"
+#include "Include/VertexCompression.hlsli"
 
 // WRITE_VELOCITY (false, true)
 // SKINNED (false, true)
@@ -9,6 +10,13 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
 {
     VS_OUTPUT OUT = (VS_OUTPUT)0;
 
+    ObjectData objectData = GetPerObjectData();
+    float3 position = DecodePosition(IN.Position, objectData.CompactVertices, objectData.PositionScale, objectData.PositionBias);
+    float3 normal;
+    float4 tangent;
+    float4 biTangent;
+    DecodeTangentFrame(IN.Position, IN.Normal, IN.Tangent, IN.BiTangent, objectData.CompactVertices, normal, tangent, biTangent);
+
 #if SKINNED == 1
     float3x4 blendMatrix = (float3x4)0;
     float3x4 prevBlendMatrix = (float3x4)0;
@@ -16,20 +24,20 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
 
     if(instanceid == 0)
     {
-        OUT.Position = float4(IN.Position, 1.0f);
-        OUT.CurrPosition = float4(IN.Position, 1.0f); // Clip Space
-        OUT.PrevPosition = float4(IN.Position, 1.0f); // Clip Space
-        OUT.PositionWS = float4(IN.Position, 1.0f); // World Space
+        OUT.Position = float4(position, 1.0f);
+        OUT.CurrPosition = float4(position, 1.0f); // Clip Space
+        OUT.PrevPosition = float4(position, 1.0f); // Clip Space
+        OUT.PositionWS = float4(position, 1.0f); // World Space
 
-        OUT.Normal = IN.Normal;
-        OUT.Tangent = IN.Tangent;
-        OUT.BiTangent = IN.BiTangent;
+        OUT.Normal = normal;
+        OUT.Tangent = tangent;
+        OUT.BiTangent = biTangent;
 
 #if SKINNED == 1
-        if(gHasAnimation)
+        if(objectData.HasAnimation)
         {
-            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
-            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, objectData.BoneOffset);
+            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices, objectData.PrevBoneOffset);
 
             OUT.Position = float4(mul(blendMatrix, OUT.Position), 1.0);
             OUT.CurrPosition = float4(mul(blendMatrix, OUT.CurrPosition), 1.0);
@@ -43,52 +51,53 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
         }
 #endif
 
-        OUT.Position = mul(gMatWorld, OUT.Position);
+        OUT.Position = mul(objectData.MatWorld, OUT.Position);
         OUT.Position = mul(gCamera.MatViewProj, OUT.Position);
 
-        OUT.CurrPosition = mul(gMatWorld, OUT.CurrPosition);
+        OUT.CurrPosition = mul(objectData.MatWorld, OUT.CurrPosition);
         OUT.CurrPosition = mul(gCamera.MatViewProj, OUT.CurrPosition);
 
-        OUT.PrevPosition = mul(gMatPrevWorld, OUT.PrevPosition);
+        OUT.PrevPosition = mul(objectData.MatPrevWorld, OUT.PrevPosition);
         OUT.PrevPosition = mul(gCamera.MatPrevViewProj, OUT.PrevPosition);
 
-        OUT.Normal = normalize(mul(gMatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gMatWorld, float4(OUT.Tangent.xyz, 0.0f)));
-        OUT.BiTangent = normalize(mul(gMatWorld, float4(OUT.BiTangent.xyz, 0.0f)));
+        OUT.Normal = normalize(mul(objectData.MatWorld, float4(OUT.Normal, 0.0f))).xyz;
+        OUT.Tangent = normalize(mul(objectData.MatWorld, float4(OUT.Tangent.xyz, 0.0f)));
+        OUT.BiTangent = normalize(mul(objectData.MatWorld, float4(OUT.BiTangent.xyz, 0.0f)));
 
         OUT.UV0 = FlipUV(IN.UV0);
         OUT.UV1 = FlipUV(IN.UV1);
 
-        OUT.PositionWS = mul(gMatWorld, OUT.PositionWS);
+        OUT.PositionWS = mul(objectData.MatWorld, OUT.PositionWS);
 
 #if WRITE_VELOCITY == 1
-        OUT.Other.x = (gWriteVelocity == 1) ? 1.0 : 0.0;
+        OUT.Other.x = (objectData.WriteVelocity == 1) ? 1.0 : 0.0;
 #endif
-        OUT.Other.y = (gCastLights == 1) ? 1.0 : 0.0;
-        OUT.Other.z = (gReceiveShadows == 1) ? 1.0 : 0.0;
+        OUT.Other.y = (objectData.CastLights == 1) ? 1.0 : 0.0;
+        OUT.Other.z = (objectData.ReceiveShadows == 1) ? 1.0 : 0.0;
     }
     else
     {
+        ObjectData instanceData = GetInstanceData(instanceid);
 
 #if SKINNED == 1
-        if(gInstanceData[instanceid].HasAnimation)
+        if(instanceData.HasAnimation)
         {
-            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
-            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+            blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, objectData.BoneOffset);
+            prevBlendMatrix = GetPrevBlendMatrix(IN.BlendWeights, IN.BlendIndices, objectData.PrevBoneOffset);
         }
 #endif
 
-        OUT.Position = float4(IN.Position, 1.0f);
-        OUT.CurrPosition = float4(IN.Position, 1.0f); // Clip Space
-        OUT.PrevPosition = float4(IN.Position, 1.0f); // Clip Space
-        OUT.PositionWS = float4(IN.Position, 1.0f); // World Space
+        OUT.Position = float4(position, 1.0f);
+        OUT.CurrPosition = float4(position, 1.0f); // Clip Space
+        OUT.PrevPosition = float4(position, 1.0f); // Clip Space
+        OUT.PositionWS = float4(position, 1.0f); // World Space
 
-        OUT.Normal = IN.Normal;
-        OUT.Tangent = IN.Tangent;
-        OUT.BiTangent = IN.BiTangent;
+        OUT.Normal = normal;
+        OUT.Tangent = tangent;
+        OUT.BiTangent = biTangent;
 
 #if SKINNED == 1
-        if(gHasAnimation)
+        if(objectData.HasAnimation)
         {
             OUT.Position = float4(mul(blendMatrix, OUT.Position), 1.0);
             OUT.CurrPosition = float4(mul(blendMatrix, OUT.CurrPosition), 1.0);
@@ -102,28 +111,28 @@ VS_OUTPUT main( VS_INPUT IN, uint instanceid : SV_InstanceID )
         }
 #endif
 
-        OUT.Position = mul(gInstanceData[instanceid].MatWorld, OUT.Position);
+        OUT.Position = mul(instanceData.MatWorld, OUT.Position);
         OUT.Position = mul(gCamera.MatViewProj, OUT.Position);
 
-        OUT.CurrPosition = mul(gInstanceData[instanceid].MatWorld, OUT.CurrPosition);
+        OUT.CurrPosition = mul(instanceData.MatWorld, OUT.CurrPosition);
         OUT.CurrPosition = mul(gCamera.MatViewProj, OUT.CurrPosition);
 
-        OUT.PrevPosition = mul(gInstanceData[instanceid].MatPrevWorld, OUT.PrevPosition);
+        OUT.PrevPosition = mul(instanceData.MatPrevWorld, OUT.PrevPosition);
         OUT.PrevPosition = mul(gCamera.MatPrevViewProj, OUT.PrevPosition);
 
-        OUT.Normal = normalize(mul(gInstanceData[instanceid].MatWorld, float4(OUT.Normal, 0.0f))).xyz;
-        OUT.Tangent = normalize(mul(gInstanceData[instanceid].MatWorld, float4(OUT.Tangent.xyz, 0.0f)));
-        OUT.BiTangent = normalize(mul(gInstanceData[instanceid].MatWorld, float4(OUT.BiTangent.xyz, 0.0f)));
+        OUT.Normal = normalize(mul(instanceData.MatWorld, float4(OUT.Normal, 0.0f))).xyz;
+        OUT.Tangent = normalize(mul(instanceData.MatWorld, float4(OUT.Tangent.xyz, 0.0f)));
+        OUT.BiTangent = normalize(mul(instanceData.MatWorld, float4(OUT.BiTangent.xyz, 0.0f)));
 
         OUT.UV0 = FlipUV(IN.UV0);
         OUT.UV1 = FlipUV(IN.UV1);
 
-        OUT.PositionWS = mul(gInstanceData[instanceid].MatWorld, OUT.PositionWS);
+        OUT.PositionWS = mul(instanceData.MatWorld, OUT.PositionWS);
 
 #if WRITE_VELOCITY == 1
-        OUT.Other.x = (gInstanceData[instanceid].WriteVelocity == 1) ? 1.0 : 0.0;
+        OUT.Other.x = (instanceData.WriteVelocity == 1) ? 1.0 : 0.0;
 #endif
-        OUT.Other.y = (gInstanceData[instanceid].CastLights == 1) ? 1.0 : 0.0;
+        OUT.Other.y = (instanceData.CastLights == 1) ? 1.0 : 0.0;
         OUT.Other.z = (gCamera.UseSRGB == 1) ? 1.0 : 0.0;
     }
 
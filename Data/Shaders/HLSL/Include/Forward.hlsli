@@ -11,10 +11,10 @@
 
 struct VS_INPUT
 {
-    float3 Position      : POSITION;
+    float4 Position      : POSITION;
     uint4  BlendIndices  : BLENDINDICES;
     float4 BlendWeights  : BLENDWEIGHT;
-    float3 Normal        : NORMAL;
+    float4 Normal        : NORMAL;
     float4 Tangent       : TANGENT;
     float4 BiTangent     : BINORMAL;
     float2 UV0           : TEXCOORD0;
@@ -42,7 +42,7 @@ struct VS_OUTPUT
 
 struct VS_Z_INPUT
 {
-    float3 Position      : POSITION;
+    float4 Position      : POSITION;
     uint4  BlendIndices  : BLENDINDICES;
     float4 BlendWeights  : BLENDWEIGHT;
 };
@@ -39,9 +39,43 @@ cbuffer PerObjectBuffer : register(b2)
     uint   gWriteVelocity;
     uint   gCastLights;
     uint   gReceiveShadows;
-    float3 gPadding;
+    uint   gBoneOffset;
+    uint   gPrevBoneOffset;
+    uint   gCompactVertices;
+    float4 gPositionScale;
+    float4 gPositionBias;
+    uint   gObjectIdx;
 }
 
+// Replaces gInstanceData when objects are part of the GPU scene: index of the object of each instance, 4 per entry
+cbuffer PerInstanceObjectBuffer : register(b3)
+{
+    uint4 gInstanceObjects[STANDARD_FORWARD_MAX_INSTANCED_BLOCK / 4];
+}
+
+#include "Include/GpuScene.hlsli"
+
 // #################### HELPER FUNCTIONS
 
+/** Returns the data of an instance, other than the first one, of an instanced draw. */
+ObjectData GetInstanceData(uint instanceid)
+{
+    // Instances are all part of the GPU scene or none of them is
+    if(gObjectIdx != 0)
+        return GetObjectData(gInstanceObjects[instanceid / 4][instanceid % 4]);
+
+    ObjectData objectData = GetPerObjectData();
+    objectData.MatWorld = gInstanceData[instanceid].MatWorld;
+    objectData.MatInvWorld = gInstanceData[instanceid].MatInvWorld;
+    objectData.MatWorldNoScale = gInstanceData[instanceid].MatWorldNoScale;
+    objectData.MatInvWorldNoScale = gInstanceData[instanceid].MatInvWorldNoScale;
+    objectData.MatPrevWorld = gInstanceData[instanceid].MatPrevWorld;
+    objectData.Layer = gInstanceData[instanceid].Layer;
+    objectData.HasAnimation = gInstanceData[instanceid].HasAnimation;
+    objectData.WriteVelocity = gInstanceData[instanceid].WriteVelocity;
+    objectData.CastLights = gInstanceData[instanceid].CastLights;
+
+    return objectData;
+}
+
 #endif // __FORWARD_VS__
@@ -0,0 +1,69 @@
+#ifndef __GPU_SCENE__
+#define __GPU_SCENE__
+
+// Must be included after PerObjectBuffer is declared: objects which aren't part of the GPU scene still read their data
+// from it
+
+// #################### STRUCTS
+
+struct ObjectData
+{
+    matrix MatWorld;
+    matrix MatInvWorld;
+    matrix MatWorldNoScale;
+    matrix MatInvWorldNoScale;
+    matrix MatPrevWorld;
+    uint   Layer;
+    uint   HasAnimation;
+    uint   WriteVelocity;
+    uint   CastLights;
+    uint   ReceiveShadows;
+    uint   BoneOffset;
+    uint   PrevBoneOffset;
+    uint   CompactVertices;
+    float4 PositionScale;
+    float4 PositionBias;
+    float4 Bounds; // World space bounding sphere
+};
+
+// #################### BUFFERS
+
+// Per-object data of all renderables, indexed by gObjectIdx. Slot 0 is never used by an object, a zeroed gObjectIdx
+// means the object isn't part of the GPU scene
+StructuredBuffer<ObjectData> SceneObjects : register(t2);
+
+// #################### HELPER FUNCTIONS
+
+ObjectData GetObjectData(uint objectIdx)
+{
+    return SceneObjects[objectIdx];
+}
+
+/** Returns the data of the drawn object, from the GPU scene if it is part of it, from PerObjectBuffer otherwise. */
+ObjectData GetPerObjectData()
+{
+    if(gObjectIdx != 0)
+        return GetObjectData(gObjectIdx);
+
+    ObjectData objectData;
+    objectData.MatWorld = gMatWorld;
+    objectData.MatInvWorld = gMatInvWorld;
+    objectData.MatWorldNoScale = gMatWorldNoScale;
+    objectData.MatInvWorldNoScale = gMatInvWorldNoScale;
+    objectData.MatPrevWorld = gMatPrevWorld;
+    objectData.Layer = gLayer;
+    objectData.HasAnimation = gHasAnimation;
+    objectData.WriteVelocity = gWriteVelocity;
+    objectData.CastLights = gCastLights;
+    objectData.ReceiveShadows = gReceiveShadows;
+    objectData.BoneOffset = gBoneOffset;
+    objectData.PrevBoneOffset = gPrevBoneOffset;
+    objectData.CompactVertices = gCompactVertices;
+    objectData.PositionScale = gPositionScale;
+    objectData.PositionBias = gPositionBias;
+    objectData.Bounds = float4(0.0f, 0.0f, 0.0f, 0.0f);
+
+    return objectData;
+}
+
+#endif // __GPU_SCENE__
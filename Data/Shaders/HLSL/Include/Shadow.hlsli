@@ -2,6 +2,9 @@
 #define __SHADOW__
 
 #include "Include/Skinning.hlsli"
+#include "Include/VertexCompression.hlsli"
+
+#define SHADOW_MAX_INSTANCED_BLOCK 128
 
 cbuffer PerShadowBuffer : register(b0)
 {
@@ -23,15 +26,28 @@ cbuffer PerObjectBuffer : register(b1)
     uint   gWriteVelocity;
     uint   gCastLights;
     uint   gReceiveShadows;
-    float3 gPadding;
+    uint   gBoneOffset;
+    uint   gPrevBoneOffset;
+    uint   gCompactVertices;
+    float4 gPositionScale;
+    float4 gPositionBias;
+    uint   gObjectIdx;
+}
+
+#include "Include/GpuScene.hlsli"
+
+// Casters without skinning are drawn instanced, PerObjectBuffer then only provides the vertex decoding parameters
+cbuffer PerShadowInstanceBuffer : register(b4)
+{
+    float4x4 gInstanceWorld[SHADOW_MAX_INSTANCED_BLOCK];
 }
 
 struct VS_INPUT
 {
-    float3 Position      : POSITION;
+    float4 Position      : POSITION;
     uint4  BlendIndices  : BLENDINDICES;
     float4 BlendWeights  : BLENDWEIGHT;
-    float3 Normal        : NORMAL;
+    float4 Normal        : NORMAL;
     float4 Tangent       : TANGENT;
     float4 BiTangent     : BINORMAL;
     float2 UV0           : TEXCOORD0;
@@ -64,21 +80,24 @@ float NDCZToDeviceZ(float ndcZ)
     return (ndcZ + gNDCZToDeviceZ.y) * gNDCZToDeviceZ.x;
 }
 
-VS_OUTPUT VS_MAIN(VS_INPUT IN)
+VS_OUTPUT VS_MAIN(VS_INPUT IN, uint instanceId)
 {
     VS_OUTPUT OUT = (VS_OUTPUT)0;
-    float4 worldPosition = float4(IN.Position, 1.0f);
+    ObjectData objectData = GetPerObjectData();
+    float4 worldPosition = float4(DecodePosition(IN.Position, objectData.CompactVertices, objectData.PositionScale, objectData.PositionBias), 1.0f);
 
 #if SKINNED == 1
-    if(gHasAnimation)
+    if(objectData.HasAnimation)
     {
         float3x4 blendMatrix = (float3x4)0;
-        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, objectData.BoneOffset);
         worldPosition = float4(mul(blendMatrix, worldPosition), 1.0);
     }
-#endif // SKINNED
 
-    worldPosition = mul(gMatWorld, worldPosition);
+    worldPosition = mul(objectData.MatWorld, worldPosition);
+#else // SKINNED
+    worldPosition = mul(gInstanceWorld[instanceId], worldPosition);
+#endif // SKINNED
 
 #ifdef USES_GS
     OUT.WorldPosition = worldPosition;
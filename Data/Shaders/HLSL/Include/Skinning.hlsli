@@ -1,6 +1,7 @@
 #ifndef __SKINNING__
 #define __SKINNING__
 
+// Bone matrices of all skinned objects are packed in the same buffer, each object starting at its own bone offset
 Buffer<float4> BoneMatrices : register(t0);
 Buffer<float4> PrevBoneMatrices : register(t1);
 
@@ -22,34 +23,34 @@ float3x4 GetPrevBoneMatrix(uint idx)
     return float3x4(row0, row1, row2);
 }
 
-float3x4 GetBlendMatrix(float4 blendWeights, uint4 blendIndices)
+float3x4 GetBlendMatrix(float4 blendWeights, uint4 blendIndices, uint boneOffset)
 {
     float3x4 result = (float3x4)0; 
 
     if(blendIndices.x >= 0)
-        result += blendWeights.x * GetBoneMatrix(blendIndices.x);
+        result += blendWeights.x * GetBoneMatrix(boneOffset + blendIndices.x);
     if(blendIndices.y >= 0)
-        result += blendWeights.y * GetBoneMatrix(blendIndices.y);
+        result += blendWeights.y * GetBoneMatrix(boneOffset + blendIndices.y);
     if(blendIndices.z >= 0)
-        result += blendWeights.z * GetBoneMatrix(blendIndices.z);
+        result += blendWeights.z * GetBoneMatrix(boneOffset + blendIndices.z);
     if(blendIndices.w >= 0)
-        result += blendWeights.w * GetBoneMatrix(blendIndices.w);
+        result += blendWeights.w * GetBoneMatrix(boneOffset + blendIndices.w);
 
     return result;
 }
 
-float3x4 GetPrevBlendMatrix(float4 blendWeights, uint4 blendIndices)
+float3x4 GetPrevBlendMatrix(float4 blendWeights, uint4 blendIndices, uint boneOffset)
 {
     float3x4 result = (float3x4)0; 
 
     if(blendIndices.x >= 0)
-        result += blendWeights.x * GetPrevBoneMatrix(blendIndices.x);
+        result += blendWeights.x * GetPrevBoneMatrix(boneOffset + blendIndices.x);
     if(blendIndices.y >= 0)
-        result += blendWeights.y * GetPrevBoneMatrix(blendIndices.y);
+        result += blendWeights.y * GetPrevBoneMatrix(boneOffset + blendIndices.y);
     if(blendIndices.z >= 0)
-        result += blendWeights.z * GetPrevBoneMatrix(blendIndices.z);
+        result += blendWeights.z * GetPrevBoneMatrix(boneOffset + blendIndices.z);
     if(blendIndices.w >= 0)
-        result += blendWeights.w * GetPrevBoneMatrix(blendIndices.w);
+        result += blendWeights.w * GetPrevBoneMatrix(boneOffset + blendIndices.w);
 
     return result;
 }
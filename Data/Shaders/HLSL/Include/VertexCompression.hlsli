@@ -0,0 +1,45 @@
+#ifndef __VERTEX_COMPRESSION__
+#define __VERTEX_COMPRESSION__
+
+// Meshes imported with compact vertices (see RendererMeshData::Compress) store :
+//  - Position as snorm16 over the mesh bounds, w holding the sign of the bitangent
+//  - Octahedral normal in Normal.xy and octahedral tangent in Normal.zw, no tangent nor bitangent
+// Full precision meshes go through unchanged, their position and normal are read with w = 1
+
+/** Maps a point of the octahedron unfolded over the [-1, 1] square back to a unit vector. */
+float3 OctahedronDecode(float2 encoded)
+{
+    float3 vec = float3(encoded.xy, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = saturate(-vec.z);
+    vec.xy += (vec.xy >= 0.0) ? -t : t;
+    return normalize(vec);
+}
+
+/** Returns the object space position of a vertex. */
+float3 DecodePosition(float4 position, uint compact, float4 scale, float4 bias)
+{
+    if(compact)
+        return position.xyz * scale.xyz + bias.xyz;
+
+    return position.xyz;
+}
+
+/** Returns the object space normal, tangent and bitangent of a vertex. */
+void DecodeTangentFrame(float4 position, float4 normal, float4 tangent, float4 biTangent, uint compact,
+    out float3 outNormal, out float4 outTangent, out float4 outBiTangent)
+{
+    if(compact)
+    {
+        outNormal = OctahedronDecode(normal.xy);
+        outTangent = float4(OctahedronDecode(normal.zw), 0.0);
+        outBiTangent = float4(cross(outNormal, outTangent.xyz) * (position.w < 0.0 ? -1.0 : 1.0), 0.0);
+    }
+    else
+    {
+        outNormal = normal.xyz;
+        outTangent = tangent;
+        outBiTangent = biTangent;
+    }
+}
+
+#endif // __VERTEX_COMPRESSION__
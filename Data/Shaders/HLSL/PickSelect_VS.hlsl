@@ -1,4 +1,5 @@
 #include "Include/Skinning.hlsli"
+#include "Include/VertexCompression.hlsli"
 
 cbuffer PerFrameBuffer : register(b0)
 {
@@ -12,12 +13,16 @@ cbuffer PerObjectBuffer : register(b1)
     matrix gMatWorld;
     float4 gColor;
     uint   gHasAnimation;
+    uint   gBoneOffset;
+    uint   gCompactVertices;
+    float4 gPositionScale;
+    float4 gPositionBias;
 }
 
 struct VS_INPUT
 {
-    float3 Position : POSITION;
-    float3 Normal : NORMAL;
+    float4 Position : POSITION;
+    float4 Normal : NORMAL;
     float4 BlendWeights : BLENDWEIGHT;
     uint4  BlendIndices : BLENDINDICES;
 };
@@ -36,12 +41,15 @@ VS_OUTPUT main( VS_INPUT IN )
 
     float3x4 blendMatrix = (float3x4)0;
 
+    float3 position = DecodePosition(IN.Position, gCompactVertices, gPositionScale, gPositionBias);
+    float3 normal = gCompactVertices ? OctahedronDecode(IN.Normal.xy) : IN.Normal.xyz;
+
     if(gHasAnimation)
-        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices);
+        blendMatrix = GetBlendMatrix(IN.BlendWeights, IN.BlendIndices, gBoneOffset);
 
-    OUT.Position = float4(IN.Position, 1.0f);
-    OUT.PositionWS = float4(IN.Position, 1.0f);
-    OUT.Normal = IN.Normal;
+    OUT.Position = float4(position, 1.0f);
+    OUT.PositionWS = float4(position, 1.0f);
+    OUT.Normal = normal;
 
     if(gHasAnimation)
     {
@@ -3,9 +3,9 @@
 
 #include "Include/Shadow.hlsli"
 
-VS_OUTPUT main( VS_INPUT IN )
+VS_OUTPUT main( VS_INPUT IN, uint instanceId : SV_InstanceID )
 {
-    return VS_MAIN(IN);
+    return VS_MAIN(IN, instanceId);
 }
 
 // TODO Shadow
@@ -0,0 +1,30 @@
+set (TE_BENCHMARK_INC_NOFILTER
+    "TeBenchmark.h"
+    "TeBenchmarkRenderAPI.h"
+)
+
+set (TE_BENCHMARK_SRC_NOFILTER
+    "Main.cpp"
+    "TeBenchmark.cpp"
+    "TeAnimationBenchmark.cpp"
+    "TeMathBenchmark.cpp"
+    "TeImportBenchmark.cpp"
+    "TeMeshletBenchmark.cpp"
+    "TePickingBenchmark.cpp"
+    "TeMaterialBenchmark.cpp"
+    "TeBenchmarkRenderAPI.cpp"
+    "TeGpuSceneBenchmark.cpp"
+)
+
+if (PHYSICS_MODULE MATCHES "BulletPhysics")
+    list (APPEND TE_BENCHMARK_SRC_NOFILTER
+        "TePhysicsBenchmark.cpp"
+    )
+endif ()
+
+source_group ("" FILES ${TE_BENCHMARK_SRC_NOFILTER} ${TE_BENCHMARK_INC_NOFILTER})
+
+set (TE_BENCHMARK_SRC
+    ${TE_BENCHMARK_INC_NOFILTER}
+    ${TE_BENCHMARK_SRC_NOFILTER}
+)
@@ -0,0 +1,22 @@
+#include "TeBenchmark.h"
+
+/**
+ * Runs CPU micro-benchmarks for engine systems that don't require a window or a render API. Results are printed to the
+ * standard output.
+ */
+int main()
+{
+    te::RunMathBenchmarks();
+    te::RunAnimationBenchmarks();
+    te::RunImportBenchmarks();
+    te::RunMeshletBenchmarks();
+    te::RunPickingBenchmarks();
+    te::RunMaterialBenchmarks();
+    te::RunGpuSceneBenchmarks();
+
+#if defined(TE_BENCHMARK_PHYSICS)
+    te::RunPhysicsBenchmarks();
+#endif
+
+    return 0;
+}
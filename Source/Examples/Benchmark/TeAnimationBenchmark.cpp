@@ -0,0 +1,294 @@
+#include "TeBenchmark.h"
+#include "Animation/TeSkeleton.h"
+#include "Animation/TeSkeletonPoseKernels.h"
+#include "Math/TeSIMD.h"
+
+#include <random>
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 NUM_BONES = 96;
+        constexpr UINT32 NUM_ITERATIONS = 20000;
+
+        /** Curve values for every bone of one animation state, as they would come out of curve evaluation. */
+        struct SampledState
+        {
+            Vector<Vector3> Positions;
+            Vector<Quaternion> Rotations;
+            Vector<Vector3> Scales;
+            float Weight = 1.0f;
+            bool Additive = false;
+        };
+
+        /** Synthetic skeleton and animation data shared by both evaluation paths. */
+        struct PoseBenchmarkData
+        {
+            Vector<UINT32> Parents;
+            Vector<Matrix4> InvBindPoses;
+            Vector<SampledState> States;
+
+            Vector<UINT32> SortedBones;
+            Vector<UINT32> SortedParents;
+        };
+
+        PoseBenchmarkData CreateData()
+        {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+            auto randomRotation = [&]()
+            {
+                Quaternion q(dist(rng), dist(rng), dist(rng), dist(rng));
+                q.Normalize();
+                return q;
+            };
+
+            PoseBenchmarkData data;
+
+            // Random tree, stored in shuffled order so that parents don't necessarily come before their children
+            Vector<UINT32> permutation(NUM_BONES);
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+                permutation[i] = i;
+
+            std::shuffle(permutation.begin() + 1, permutation.end(), rng);
+
+            data.Parents.resize(NUM_BONES);
+            data.Parents[permutation[0]] = (UINT32)-1;
+            for (UINT32 i = 1; i < NUM_BONES; i++)
+            {
+                UINT32 parent = std::uniform_int_distribution<UINT32>(std::max(0, (INT32)i - 4), i - 1)(rng);
+                data.Parents[permutation[i]] = permutation[parent];
+            }
+
+            data.InvBindPoses.resize(NUM_BONES);
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+            {
+                Vector3 position(dist(rng), dist(rng), dist(rng));
+                data.InvBindPoses[i] = Matrix4::TRS(position, randomRotation(), Vector3::ONE).InverseAffine();
+            }
+
+            // Two blended states and an additive one
+            const float weights[] = { 0.7f, 0.3f, 0.5f };
+            const bool additive[] = { false, false, true };
+
+            for (UINT32 i = 0; i < 3; i++)
+            {
+                SampledState state;
+                state.Weight = weights[i];
+                state.Additive = additive[i];
+
+                for (UINT32 j = 0; j < NUM_BONES; j++)
+                {
+                    state.Positions.push_back(Vector3(dist(rng), dist(rng), dist(rng)));
+                    state.Rotations.push_back(randomRotation());
+                    state.Scales.push_back(Vector3(1.0f + dist(rng) * 0.1f, 1.0f + dist(rng) * 0.1f, 1.0f + dist(rng) * 0.1f));
+                }
+
+                data.States.push_back(state);
+            }
+
+            data.SortedBones.resize(NUM_BONES);
+            data.SortedParents.resize(NUM_BONES);
+            SkeletonPoseKernels::SortHierarchy(data.Parents.data(), NUM_BONES, data.SortedBones.data(), data.SortedParents.data());
+
+            return data;
+        }
+
+        /** Per-bone scalar evaluation, as Skeleton::GetPose() used to perform it. */
+        void EvaluateScalar(const PoseBenchmarkData& data, Vector3* positions, Quaternion* rotations, Vector3* scales,
+            Matrix4* pose)
+        {
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+            {
+                positions[i] = Vector3::ZERO;
+                rotations[i] = Quaternion::ZERO;
+                scales[i] = Vector3::ONE;
+            }
+
+            for (auto& state : data.States)
+            {
+                float normWeight = state.Weight;
+                for (UINT32 k = 0; k < NUM_BONES; k++)
+                {
+                    positions[k] += state.Positions[k] * normWeight;
+                    scales[k] *= state.Scales[k] * normWeight;
+
+                    if (state.Additive)
+                    {
+                        bool isAssigned = rotations[k].w != 0.0f;
+                        if (!isAssigned)
+                            rotations[k] = Quaternion::IDENTITY;
+
+                        Quaternion value = Quaternion::Lerp(normWeight, Quaternion::IDENTITY, state.Rotations[k]);
+                        rotations[k] *= value;
+                    }
+                    else
+                    {
+                        Quaternion value = state.Rotations[k] * normWeight;
+                        if (value.Dot(rotations[k]) < 0.0f)
+                            value = -value;
+
+                        rotations[k] += value;
+                    }
+                }
+            }
+
+            bool isGlobal[NUM_BONES] = { };
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+            {
+                bool isAssigned = rotations[i].w != 0.0f;
+                if (!isAssigned)
+                    rotations[i] = Quaternion::IDENTITY;
+                else
+                    rotations[i].Normalize();
+
+                pose[i] = Matrix4::TRS(positions[i], rotations[i], scales[i]);
+            }
+
+            std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+            {
+                UINT32 parentBoneIdx = data.Parents[boneIdx];
+                if (parentBoneIdx == (UINT32)-1)
+                {
+                    isGlobal[boneIdx] = true;
+                    return;
+                }
+
+                if (!isGlobal[parentBoneIdx])
+                    calcGlobal(parentBoneIdx);
+
+                pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
+                isGlobal[boneIdx] = true;
+            };
+
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+            {
+                if (!isGlobal[i])
+                    calcGlobal(i);
+            }
+
+            for (UINT32 i = 0; i < NUM_BONES; i++)
+                pose[i] = pose[i] * data.InvBindPoses[i];
+        }
+
+        /** Scratch memory used by the SIMD path, laid out the same way as in Skeleton::GetPose(). */
+        struct SIMDScratch
+        {
+            SIMDScratch(UINT32 stride)
+                : Buffer((float*)te_allocate_aligned16(sizeof(float) * stride * 11))
+            {
+                memset(Buffer, 0, sizeof(float) * stride * 11);
+
+                float* iter = Buffer;
+                for (UINT32 i = 0; i < 3; i++, iter += stride) Positions[i] = iter;
+                for (UINT32 i = 0; i < 4; i++, iter += stride) Rotations[i] = iter;
+                for (UINT32 i = 0; i < 3; i++, iter += stride) Scales[i] = iter;
+                Weights = iter;
+            }
+
+            ~SIMDScratch() { te_free_aligned16(Buffer); }
+
+            float* Buffer;
+            float* Positions[3];
+            float* Rotations[4];
+            float* Scales[3];
+            float* Weights;
+        };
+
+        /** Batched evaluation using the same kernels and evaluation order as Skeleton::GetPose(). */
+        void EvaluateSIMD(const PoseBenchmarkData& data, LocalSkeletonPose& localPose, SIMDScratch& scratch,
+            Matrix4* pose)
+        {
+            const UINT32 stride = localPose.Stride;
+            for (UINT32 i = 0; i < 3; i++)
+            {
+                std::fill(localPose.Positions[i], localPose.Positions[i] + stride, 0.0f);
+                std::fill(localPose.Scales[i], localPose.Scales[i] + stride, 1.0f);
+            }
+
+            for (UINT32 i = 0; i < 4; i++)
+                std::fill(localPose.Rotations[i], localPose.Rotations[i] + stride, 0.0f);
+
+            for (auto& state : data.States)
+            {
+                for (UINT32 k = 0; k < NUM_BONES; k++)
+                {
+                    scratch.Positions[0][k] = state.Positions[k].x;
+                    scratch.Positions[1][k] = state.Positions[k].y;
+                    scratch.Positions[2][k] = state.Positions[k].z;
+                    scratch.Rotations[0][k] = state.Rotations[k].x;
+                    scratch.Rotations[1][k] = state.Rotations[k].y;
+                    scratch.Rotations[2][k] = state.Rotations[k].z;
+                    scratch.Rotations[3][k] = state.Rotations[k].w;
+                    scratch.Scales[0][k] = state.Scales[k].x;
+                    scratch.Scales[1][k] = state.Scales[k].y;
+                    scratch.Scales[2][k] = state.Scales[k].z;
+                    scratch.Weights[k] = state.Weight;
+                }
+
+                SkeletonPoseKernels::BlendPositions(localPose.Positions, scratch.Positions, scratch.Weights, stride);
+                SkeletonPoseKernels::BlendScales(localPose.Scales, scratch.Scales, scratch.Weights, stride);
+
+                if (state.Additive)
+                    SkeletonPoseKernels::BlendRotationsAdditive(localPose.Rotations, scratch.Rotations, scratch.Weights, stride);
+                else
+                    SkeletonPoseKernels::BlendRotations(localPose.Rotations, scratch.Rotations, scratch.Weights, stride);
+            }
+
+            SkeletonPoseKernels::NormalizeRotations(localPose.Rotations, stride);
+            SkeletonPoseKernels::ComputeLocalTransforms(pose, localPose);
+            SkeletonPoseKernels::ComputeModelTransforms(pose, data.SortedBones.data(), data.SortedParents.data(),
+                localPose.HasOverride, NUM_BONES);
+
+            SkeletonPoseKernels::ApplyInvBindPoses(pose, data.InvBindPoses.data(), NUM_BONES);
+        }
+    }
+
+    void RunAnimationBenchmarks()
+    {
+        Benchmark::ReportSection("Skeleton pose evaluation (" + ToString(NUM_BONES) + " bones, 3 states)");
+
+        PoseBenchmarkData data = CreateData();
+
+        // Scalar path
+        Vector<Vector3> positions(NUM_BONES);
+        Vector<Quaternion> rotations(NUM_BONES);
+        Vector<Vector3> scales(NUM_BONES);
+        Vector<Matrix4> scalarPose(NUM_BONES);
+
+        // SIMD path
+        LocalSkeletonPose localPose(NUM_BONES);
+        memset(localPose.HasOverride, 0, sizeof(bool) * NUM_BONES);
+
+        SIMDScratch scratch(localPose.Stride);
+        Vector<Matrix4> simdPose(NUM_BONES);
+
+        BenchmarkResult scalarResult = Benchmark::Run("Scalar per-bone path", NUM_ITERATIONS, NUM_BONES, [&]()
+        {
+            EvaluateScalar(data, positions.data(), rotations.data(), scales.data(), scalarPose.data());
+        });
+
+        BenchmarkResult simdResult = Benchmark::Run("SIMD kernels + sorted hierarchy", NUM_ITERATIONS, NUM_BONES, [&]()
+        {
+            EvaluateSIMD(data, localPose, scratch, simdPose.data());
+        });
+
+        Benchmark::Report(scalarResult);
+        Benchmark::Report(simdResult);
+        Benchmark::ReportSpeedup(scalarResult, simdResult);
+
+        float maxError = 0.0f;
+        for (UINT32 i = 0; i < NUM_BONES; i++)
+        {
+            for (UINT32 row = 0; row < 4; row++)
+            {
+                for (UINT32 col = 0; col < 4; col++)
+                    maxError = std::max(maxError, Math::Abs(scalarPose[i][row][col] - simdPose[i][row][col]));
+            }
+        }
+
+        Benchmark::ReportCheck("Results match scalar path", maxError < 1e-3f, maxError);
+    }
+}
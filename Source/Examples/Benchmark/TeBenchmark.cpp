@@ -0,0 +1,69 @@
+#include "TeBenchmark.h"
+#include "Utility/TeTimer.h"
+
+#include <iostream>
+#include <iomanip>
+
+namespace te
+{
+    BenchmarkResult Benchmark::Run(const String& name, UINT64 numIterations, UINT64 numItems,
+        const std::function<void()>& func)
+    {
+        // Warm-up, so caches and branch predictors are in a steady state
+        UINT64 numWarmupIterations = std::max((UINT64)1, numIterations / 10);
+        for (UINT64 i = 0; i < numWarmupIterations; i++)
+            func();
+
+        BenchmarkResult result;
+        result.Name = name;
+        result.NumIterations = numIterations;
+        result.NumItems = numItems;
+
+        Timer timer;
+        for (UINT64 i = 0; i < numIterations; i++)
+            func();
+
+        result.TotalMicroseconds = timer.GetMicroseconds();
+        return result;
+    }
+
+    void Benchmark::Report(const BenchmarkResult& result)
+    {
+        double totalItems = (double)result.NumIterations * (double)std::max((UINT64)1, result.NumItems);
+        double nsPerItem = (double)result.TotalMicroseconds * 1000.0 / totalItems;
+        double itemsPerSec = totalItems / std::max(1e-6, (double)result.TotalMicroseconds * 1e-6);
+
+        std::cout << "  " << std::left << std::setw(48) << result.Name
+            << std::right << std::setw(10) << std::fixed << std::setprecision(2) << nsPerItem << " ns/item"
+            << std::setw(14) << std::setprecision(2) << itemsPerSec / 1e6 << " M items/s"
+            << std::endl;
+    }
+
+    void Benchmark::ReportSpeedup(const BenchmarkResult& reference, const BenchmarkResult& optimized)
+    {
+        double referenceTime = (double)reference.TotalMicroseconds / std::max((UINT64)1, reference.NumIterations * reference.NumItems);
+        double optimizedTime = (double)optimized.TotalMicroseconds / std::max((UINT64)1, optimized.NumIterations * optimized.NumItems);
+
+        std::cout << "  " << std::left << std::setw(48) << ("Speedup (" + optimized.Name + ")")
+            << std::right << std::setw(10) << std::fixed << std::setprecision(2)
+            << (optimizedTime > 0.0 ? referenceTime / optimizedTime : 0.0) << "x" << std::endl;
+    }
+
+    void Benchmark::ReportSection(const String& name)
+    {
+        std::cout << std::endl << "[" << name << "]" << std::endl;
+    }
+
+    void Benchmark::ReportCheck(const String& name, bool success, float maxError)
+    {
+        std::cout << "  " << std::left << std::setw(48) << name
+            << (success ? "OK" : "MISMATCH") << " (max error " << std::scientific << std::setprecision(3) << maxError
+            << ")" << std::fixed << std::endl;
+    }
+
+    void Benchmark::ReportValue(const String& name, UINT64 value, const String& unit)
+    {
+        std::cout << "  " << std::left << std::setw(48) << name
+            << std::right << std::setw(10) << value << " " << unit << std::endl;
+    }
+}
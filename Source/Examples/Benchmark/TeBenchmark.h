@@ -0,0 +1,81 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+#include <functional>
+
+namespace te
+{
+    /** Result of a single measured benchmark case. */
+    struct BenchmarkResult
+    {
+        String Name;
+        UINT64 TotalMicroseconds = 0;
+        UINT64 NumIterations = 0;
+        UINT64 NumItems = 0; /**< Number of items (bones, rays, ...) processed by a single iteration. */
+    };
+
+    /** Minimal harness used to measure and report micro-benchmarks. */
+    class Benchmark
+    {
+    public:
+        /**
+         * Runs @p func @p numIterations times (after a short warm-up) and returns the measured timings.
+         *
+         * @param[in]	name			Name of the case, used when reporting.
+         * @param[in]	numIterations	Number of times to run @p func.
+         * @param[in]	numItems		Number of items processed by a single call to @p func. Used to report throughput.
+         * @param[in]	func			Code to measure.
+         */
+        static BenchmarkResult Run(const String& name, UINT64 numIterations, UINT64 numItems,
+            const std::function<void()>& func);
+
+        /** Prints a single result. */
+        static void Report(const BenchmarkResult& result);
+
+        /** Prints how much faster @p optimized is compared to @p reference. */
+        static void ReportSpeedup(const BenchmarkResult& reference, const BenchmarkResult& optimized);
+
+        /** Prints a section header. */
+        static void ReportSection(const String& name);
+
+        /** Prints the outcome of a correctness check performed alongside a benchmark. */
+        static void ReportCheck(const String& name, bool success, float maxError);
+
+        /** Prints a value measured alongside a benchmark, such as an amount of memory or a number of calls. */
+        static void ReportValue(const String& name, UINT64 value, const String& unit);
+    };
+
+    /** Benchmarks comparing SIMD skeleton pose evaluation kernels against the scalar per-bone path. */
+    void RunAnimationBenchmarks();
+
+    /** Benchmarks comparing the SIMD math types against their previous scalar implementation. */
+    void RunMathBenchmarks();
+
+    /** Benchmarks comparing the parallel mesh import against a single threaded import. */
+    void RunImportBenchmarks();
+
+    /**
+     * Benchmarks comparing batched physics scene queries against one query per call, and the simulation of a rigid body
+     * pile with the single threaded and the multithreaded Bullet pipelines.
+     */
+    void RunPhysicsBenchmarks();
+
+    /** Benchmarks building meshlets and culling them against a view, checking which triangles are culled. */
+    void RunMeshletBenchmarks();
+
+    /** Benchmarks comparing mesh ray casts through a BVH against testing every triangle. */
+    void RunPickingBenchmarks();
+
+    /**
+     * Benchmarks assigning the parameters of every draw of a forward pass, by name and with every material parameter
+     * written against handles and writing only the parameters that changed.
+     */
+    void RunMaterialBenchmarks();
+
+    /**
+     * Benchmarks updating the per-object data of a scene of static and moving renderables, with a parameter block per
+     * renderable against the GPU scene, and reports the amount of data uploaded by each.
+     */
+    void RunGpuSceneBenchmarks();
+}
@@ -0,0 +1,201 @@
+#include "TeBenchmarkRenderAPI.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "RenderAPI/TeGpuParams.h"
+#include "RenderAPI/TeGpuParamDesc.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+#include "Math/TeMath.h"
+#include "Math/TeMatrix4.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Buffer keeping its contents in system memory. */
+        class SystemMemoryBuffer : public HardwareBuffer
+        {
+        public:
+            SystemMemoryBuffer(UINT32 size, GpuBufferUsage usage)
+                : HardwareBuffer(size, usage, GDF_DEFAULT)
+                , _data(size, 0)
+            { }
+
+            void ReadData(UINT32 offset, UINT32 length, void* dest, UINT32 deviceIdx = 0, UINT32 queueIdx = 0) override
+            {
+                memcpy(dest, _data.data() + offset, length);
+            }
+
+            void WriteData(UINT32 offset, UINT32 length, const void* source, BufferWriteType writeFlags = BWT_NORMAL,
+                UINT32 queueIdx = 0) override
+            {
+                memcpy(_data.data() + offset, source, length);
+            }
+
+            void CopyData(HardwareBuffer& srcBuffer, UINT32 srcOffset, UINT32 dstOffset, UINT32 length,
+                bool discardWholeBuffer = false) override
+            {
+                srcBuffer.ReadData(srcOffset, length, _data.data() + dstOffset);
+            }
+
+        protected:
+            void* Map(UINT32 offset, UINT32 length, GpuLockOptions options, UINT32 deviceIdx, UINT32 queueIdx) override
+            {
+                return _data.data() + offset;
+            }
+
+        private:
+            Vector<UINT8> _data;
+        };
+
+        void DeleteBuffer(HardwareBuffer* buffer)
+        {
+            te_delete(static_cast<SystemMemoryBuffer*>(buffer));
+        }
+
+        class SystemMemoryGpuBuffer : public GpuBuffer
+        {
+        public:
+            SystemMemoryGpuBuffer(const GPU_BUFFER_DESC& desc, GpuDeviceFlags deviceMask)
+                : GpuBuffer(desc, deviceMask)
+            {
+                _buffer = te_new<SystemMemoryBuffer>(GetSize(), desc.Usage);
+                _bufferDeleter = &DeleteBuffer;
+            }
+
+            SystemMemoryGpuBuffer(const GPU_BUFFER_DESC& desc, SPtr<HardwareBuffer> underlyingBuffer)
+                : GpuBuffer(desc, std::move(underlyingBuffer))
+            { }
+        };
+
+        class SystemMemoryParamBlockBuffer : public GpuParamBlockBuffer
+        {
+        public:
+            SystemMemoryParamBlockBuffer(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask)
+                : GpuParamBlockBuffer(size, usage, deviceMask)
+            {
+                _buffer = te_new<SystemMemoryBuffer>(size, usage);
+            }
+
+            ~SystemMemoryParamBlockBuffer()
+            {
+                te_delete(static_cast<SystemMemoryBuffer*>(_buffer));
+            }
+        };
+    }
+
+    BenchmarkRenderAPI::BenchmarkRenderAPI()
+    {
+        _numDevices = 1;
+        _capabilities = te_newN<RenderAPICapabilities>(_numDevices);
+    }
+
+    void BenchmarkRenderAPI::ConvertProjectionMatrix(const Matrix4& matrix, Matrix4& dest)
+    {
+        dest = matrix;
+    }
+
+    GpuParamBlockDesc BenchmarkRenderAPI::GenerateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params)
+    {
+        GpuParamBlockDesc block;
+        block.BlockSize = 0;
+        block.IsShareable = true;
+        block.Name = name;
+        block.Slot = 0;
+        block.Set = 0;
+
+        for (auto& param : params)
+        {
+            const GpuParamDataTypeInfo& typeInfo = GpuParams::PARAM_SIZES.lookup[param.Type];
+
+            if (param.ArraySize > 1)
+            {
+                // Arrays perform no packing and their elements are always padded and aligned to four component vectors
+                UINT32 size;
+                if (param.Type == GPDT_STRUCT)
+                    size = Math::DivideAndRoundUp(param.ElementSize, 16U) * 4;
+                else
+                    size = Math::DivideAndRoundUp(typeInfo.size, 16U) * 4;
+
+                block.BlockSize = Math::DivideAndRoundUp(block.BlockSize, 4U) * 4;
+
+                param.ElementSize = size;
+                param.ArrayElementStride = size;
+                param.CpuMemOffset = block.BlockSize;
+                param.GpuMemOffset = 0;
+
+                // Last array element isn't rounded up to four component vectors unless it's a struct
+                if (param.Type != GPDT_STRUCT)
+                {
+                    block.BlockSize += size * (param.ArraySize - 1);
+                    block.BlockSize += typeInfo.size / 4;
+                }
+                else
+                    block.BlockSize += param.ArraySize * size;
+            }
+            else
+            {
+                UINT32 size;
+                if (param.Type == GPDT_STRUCT)
+                {
+                    // Structs are always aligned and arounded up to 4 component vectors
+                    size = Math::DivideAndRoundUp(param.ElementSize, 16U) * 4;
+                    block.BlockSize = Math::DivideAndRoundUp(block.BlockSize, 4U) * 4;
+                }
+                else
+                {
+                    size = typeInfo.baseTypeSize * (typeInfo.numRows * typeInfo.numColumns) / 4;
+
+                    // Pack everything as tightly as possible as long as the data doesn't cross 16 byte boundary
+                    UINT32 alignOffset = block.BlockSize % 4;
+                    if (alignOffset != 0 && size > (4 - alignOffset))
+                    {
+                        UINT32 padding = (4 - alignOffset);
+                        block.BlockSize += padding;
+                    }
+                }
+
+                param.ElementSize = size;
+                param.ArrayElementStride = size;
+                param.CpuMemOffset = block.BlockSize;
+                param.GpuMemOffset = 0;
+
+                block.BlockSize += size;
+            }
+
+            param.ParamBlockSlot = 0;
+            param.ParamBlockSet = 0;
+        }
+
+        // Constant buffer size must always be a multiple of 16
+        if (block.BlockSize % 4 != 0)
+            block.BlockSize += (4 - (block.BlockSize % 4));
+
+        return block;
+    }
+
+    SPtr<GpuParamBlockBuffer> BenchmarkHardwareBufferManager::CreateGpuParamBlockBufferInternal(UINT32 size,
+        GpuBufferUsage usage, GpuDeviceFlags deviceMask)
+    {
+        SPtr<GpuParamBlockBuffer> paramBlockBuffer = te_core_ptr_new<SystemMemoryParamBlockBuffer>(size, usage, deviceMask);
+        paramBlockBuffer->SetThisPtr(paramBlockBuffer);
+
+        return paramBlockBuffer;
+    }
+
+    SPtr<GpuBuffer> BenchmarkHardwareBufferManager::CreateGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+        GpuDeviceFlags deviceMask)
+    {
+        SPtr<GpuBuffer> buffer = te_core_ptr_new<SystemMemoryGpuBuffer>(desc, deviceMask);
+        buffer->SetThisPtr(buffer);
+
+        return buffer;
+    }
+
+    SPtr<GpuBuffer> BenchmarkHardwareBufferManager::CreateGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+        SPtr<HardwareBuffer> underlyingBuffer)
+    {
+        SPtr<GpuBuffer> buffer = te_core_ptr_new<SystemMemoryGpuBuffer>(desc, std::move(underlyingBuffer));
+        buffer->SetThisPtr(buffer);
+
+        return buffer;
+    }
+}
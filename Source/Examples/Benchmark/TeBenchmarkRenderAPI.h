@@ -0,0 +1,71 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "RenderAPI/TeRenderAPI.h"
+#include "RenderAPI/TeHardwareBufferManager.h"
+
+namespace te
+{
+    /**
+     * Render API that draws nothing, for benchmarks of renderer code running without a window or a GPU. Parameter blocks
+     * are laid out as the DirectX 11 render API does.
+     */
+    class BenchmarkRenderAPI : public RenderAPI
+    {
+    public:
+        BenchmarkRenderAPI();
+
+        SPtr<RenderWindow> CreateRenderWindow(const RENDER_WINDOW_DESC& windowDesc) override { return nullptr; }
+        void SetGpuParams(const SPtr<GpuParams>& gpuParams, UINT32 gpuParamsBindFlags,
+            UINT32 gpuParamsBlockBindFlags, const Vector<String>& paramBlocksToBind) override { }
+        void SetGraphicsPipeline(const SPtr<GraphicsPipelineState>& pipelineState) override { }
+        void SetComputePipeline(const SPtr<ComputePipelineState>& pipelineState) override { }
+        void SetViewport(const Rect2& area) override { }
+        void SetScissorRect(UINT32 left, UINT32 top, UINT32 right, UINT32 bottom) override { }
+        void SetStencilRef(UINT32 value) override { }
+        void SetVertexBuffers(UINT32 index, SPtr<VertexBuffer>* buffers, UINT32 numBuffers) override { }
+        void SetIndexBuffer(const SPtr<IndexBuffer>& buffer) override { }
+        void SetVertexDeclaration(const SPtr<VertexDeclaration>& vertexDeclaration) override { }
+        void SetDrawOperation(DrawOperationType op) override { }
+        void Draw(UINT32 vertexOffset, UINT32 vertexCount, UINT32 instanceCount) override { }
+        void DrawIndexed(UINT32 startIndex, UINT32 indexCount, UINT32 vertexOffset, UINT32 vertexCount,
+            UINT32 instanceCount) override { }
+        void DispatchCompute(UINT32 numGroupsX, UINT32 numGroupsY, UINT32 numGroupsZ) override { }
+        void SwapBuffers(const SPtr<RenderTarget>& target) override { }
+        void SetRenderTarget(const SPtr<RenderTarget>& target, UINT32 readOnlyFlags) override { }
+        void ClearRenderTarget(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+            UINT8 targetMask) override { }
+        void ClearViewport(UINT32 buffers, const Color& color, float depth, UINT16 stencil,
+            UINT8 targetMask) override { }
+        void ConvertProjectionMatrix(const Matrix4& matrix, Matrix4& dest) override;
+        UINT64 GetGPUMemory() override { return 0; }
+        UINT64 GetSharedMemory() override { return 0; }
+        UINT64 GetUsedGPUMemory() override { return 0; }
+
+        /** @copydoc RenderAPI::GenerateParamBlockDesc */
+        GpuParamBlockDesc GenerateParamBlockDesc(const String& name, Vector<GpuParamDataDesc>& params) override;
+    };
+
+    /**
+     * Creates parameter blocks and GPU buffers whose contents live in system memory, so writing to them costs the copy
+     * a real upload would start with. Vertex and index buffers aren't supported.
+     */
+    class BenchmarkHardwareBufferManager : public HardwareBufferManager
+    {
+    protected:
+        SPtr<VertexBuffer> CreateVertexBufferInternal(const VERTEX_BUFFER_DESC& desc,
+            GpuDeviceFlags deviceMask = GDF_DEFAULT) override { return nullptr; }
+
+        SPtr<IndexBuffer> CreateIndexBufferInternal(const INDEX_BUFFER_DESC& desc,
+            GpuDeviceFlags deviceMask = GDF_DEFAULT) override { return nullptr; }
+
+        SPtr<GpuParamBlockBuffer> CreateGpuParamBlockBufferInternal(UINT32 size,
+            GpuBufferUsage usage = GBU_DYNAMIC, GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+        SPtr<GpuBuffer> CreateGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+            GpuDeviceFlags deviceMask = GDF_DEFAULT) override;
+
+        SPtr<GpuBuffer> CreateGpuBufferInternal(const GPU_BUFFER_DESC& desc,
+            SPtr<HardwareBuffer> underlyingBuffer) override;
+    };
+}
@@ -0,0 +1,222 @@
+#include "TeBenchmark.h"
+#include "TeBenchmarkRenderAPI.h"
+#include "TeGpuScene.h"
+#include "TeRendererRenderable.h"
+#include "Renderer/TeRenderable.h"
+#include "Renderer/TeParamBlocks.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+#include "CoreUtility/TeCoreObjectManager.h"
+#include "Profiling/TeProfilerGPU.h"
+#include "Scene/TeTransform.h"
+#include "Utility/TeTime.h"
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 NUM_STATIC_RENDERABLES = 8192;
+        constexpr UINT32 NUM_MOVING_RENDERABLES = 512;
+        constexpr UINT32 NUM_RENDERABLES = NUM_STATIC_RENDERABLES + NUM_MOVING_RENDERABLES;
+        constexpr UINT32 NUM_FRAMES = 200;
+
+        /** Renderables of a scene as the renderer sees them. */
+        struct SceneData
+        {
+            Vector<SPtr<Renderable>> Renderables;
+            Vector<RendererRenderable*> RendererRenderables;
+            Vector<UINT32> MovingRenderables;
+            UPtr<GpuScene> GpuSceneElem;
+            UINT32 Frame = 0;
+        };
+
+        /**
+         * Returns true if the renderable at @p renderableIdx moves every frame. Moving renderables are either all added
+         * after the static ones, or spread evenly between them.
+         */
+        bool IsMoving(UINT32 renderableIdx, bool spreadMoving)
+        {
+            if (spreadMoving)
+                return (renderableIdx % (NUM_RENDERABLES / NUM_MOVING_RENDERABLES)) == 0;
+
+            return renderableIdx >= NUM_STATIC_RENDERABLES;
+        }
+
+        Transform GetTransform(UINT32 renderableIdx, UINT32 frame)
+        {
+            const float x = (float)(renderableIdx % 128);
+            const float z = (float)(renderableIdx / 128);
+            const float y = (float)frame * 0.01f;
+
+            return Transform(Vector3(x, y, z), Quaternion::IDENTITY, Vector3::ONE);
+        }
+
+        void CreateScene(SceneData& scene, bool useGpuScene, bool spreadMoving)
+        {
+            if (useGpuScene)
+                scene.GpuSceneElem = te_unique_ptr_new<GpuScene>();
+
+            for (UINT32 i = 0; i < NUM_RENDERABLES; i++)
+            {
+                SPtr<Renderable> renderable = Renderable::CreateEmpty();
+
+                // Transforms can only be set on movable renderables, static ones are placed before switching them back
+                renderable->SetMobility(ObjectMobility::Movable);
+                renderable->SetTransform(GetTransform(i, 0));
+
+                if (IsMoving(i, spreadMoving))
+                    scene.MovingRenderables.push_back(i);
+                else
+                    renderable->SetMobility(ObjectMobility::Static);
+
+                RendererRenderable* rendererRenderable = te_new<RendererRenderable>();
+                rendererRenderable->RenderablePtr = renderable.get();
+                rendererRenderable->WorldTfrm = renderable->GetMatrix();
+                rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
+
+                rendererRenderable->SetGpuScene(scene.GpuSceneElem.get());
+                rendererRenderable->UpdatePerObjectBuffer();
+
+                scene.Renderables.push_back(renderable);
+                scene.RendererRenderables.push_back(rendererRenderable);
+            }
+        }
+
+        void DestroyScene(SceneData& scene)
+        {
+            for (auto& rendererRenderable : scene.RendererRenderables)
+                te_delete(rendererRenderable);
+
+            scene.RendererRenderables.clear();
+            scene.Renderables.clear();
+            scene.MovingRenderables.clear();
+            scene.GpuSceneElem = nullptr;
+        }
+
+        /** Updates the data of the moving renderables, then binds the per-object data of every renderable once. */
+        void RenderFrame(SceneData& scene)
+        {
+            gProfilerGPU().BeginFrame();
+            scene.Frame++;
+
+            for (auto& i : scene.MovingRenderables)
+            {
+                RendererRenderable* rendererRenderable = scene.RendererRenderables[i];
+                scene.Renderables[i]->SetTransform(GetTransform(i, scene.Frame));
+
+                rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
+                rendererRenderable->WorldTfrm = scene.Renderables[i]->GetMatrix();
+                rendererRenderable->UpdatePerObjectBuffer();
+            }
+
+            // As RendererScene::UpdateGpuScene() does
+            if (scene.GpuSceneElem)
+            {
+                scene.GpuSceneElem->Flush();
+
+                const GpuSceneStats& stats = scene.GpuSceneElem->GetStats();
+                TE_ADD_PROFILER_GPU(NumObjectDataWrites, stats.NumObjectWrites);
+                TE_ADD_PROFILER_GPU(NumObjectDataUploads, stats.NumUploads);
+                TE_ADD_PROFILER_GPU(ObjectDataUploadedBytes, stats.UploadedBytes);
+            }
+
+            // Binding the per-object block of a draw uploads it if it was written to
+            for (auto& rendererRenderable : scene.RendererRenderables)
+                rendererRenderable->PerObjectParamBuffer->FlushToGPU();
+
+            gProfilerGPU().EndFrame();
+        }
+
+        /** Returns the largest difference between the world matrix the GPU reads for each renderable and its own. */
+        float GetWorldMatrixError(const SceneData& scene)
+        {
+            float maxError = 0.0f;
+            for (auto& rendererRenderable : scene.RendererRenderables)
+            {
+                Matrix4 matWorld;
+                if (scene.GpuSceneElem)
+                {
+                    const UINT32 slot = gPerObjectParamDef.gObjectIdx.Get(rendererRenderable->PerObjectParamBuffer);
+
+                    GpuSceneObjectData data;
+                    scene.GpuSceneElem->GetBuffer()->ReadData(slot * sizeof(GpuSceneObjectData),
+                        sizeof(GpuSceneObjectData), &data);
+
+                    matWorld = data.MatWorld;
+                }
+                else
+                    matWorld = gPerObjectParamDef.gMatWorld.Get(rendererRenderable->PerObjectParamBuffer);
+
+                for (UINT32 row = 0; row < 4; row++)
+                {
+                    for (UINT32 column = 0; column < 4; column++)
+                    {
+                        maxError = std::max(maxError,
+                            Math::Abs(matWorld[row][column] - rendererRenderable->WorldTfrm[row][column]));
+                    }
+                }
+            }
+
+            return maxError;
+        }
+
+        void ReportFrameStats(const String& name)
+        {
+            const GPUSample& sample = gProfilerGPU().GetSample();
+            Benchmark::ReportValue(name + ", object writes", sample.NumObjectDataWrites, "per frame");
+            Benchmark::ReportValue(name + ", uploads", sample.NumObjectDataUploads, "per frame");
+            Benchmark::ReportValue(name + ", uploaded", sample.ObjectDataUploadedBytes / 1024, "KB per frame");
+        }
+    }
+
+    void RunGpuSceneBenchmarks()
+    {
+        CoreObjectManager::StartUp();
+        ProfilerGPU::StartUp();
+        Time::StartUp();
+        RenderAPI::StartUp<BenchmarkRenderAPI>();
+        HardwareBufferManager::StartUp<BenchmarkHardwareBufferManager>();
+        ParamBlockManager::StartUp();
+
+        for (auto spreadMoving : { false, true })
+        {
+            Benchmark::ReportSection("Per-object data (" + ToString(NUM_STATIC_RENDERABLES) + " static, " +
+                ToString(NUM_MOVING_RENDERABLES) + " moving renderables " + (spreadMoving ? "spread between them" :
+                "added last") + ")");
+
+            SceneData perObjectScene;
+            CreateScene(perObjectScene, false, spreadMoving);
+
+            SceneData gpuScene;
+            CreateScene(gpuScene, true, spreadMoving);
+
+            BenchmarkResult perObjectResult = Benchmark::Run("Parameter block per renderable", NUM_FRAMES, NUM_RENDERABLES,
+                [&]() { RenderFrame(perObjectScene); });
+            ReportFrameStats("Parameter block per renderable");
+
+            BenchmarkResult gpuSceneResult = Benchmark::Run("GPU scene", NUM_FRAMES, NUM_RENDERABLES,
+                [&]() { RenderFrame(gpuScene); });
+            ReportFrameStats("GPU scene");
+
+            Benchmark::Report(perObjectResult);
+            Benchmark::Report(gpuSceneResult);
+            Benchmark::ReportSpeedup(perObjectResult, gpuSceneResult);
+
+            const float perObjectError = GetWorldMatrixError(perObjectScene);
+            const float gpuSceneError = GetWorldMatrixError(gpuScene);
+
+            Benchmark::ReportCheck("Parameter blocks hold the world matrices", perObjectError == 0.0f, perObjectError);
+            Benchmark::ReportCheck("GPU scene holds the world matrices", gpuSceneError == 0.0f, gpuSceneError);
+
+            DestroyScene(perObjectScene);
+            DestroyScene(gpuScene);
+        }
+
+        ParamBlockManager::ShutDown();
+        HardwareBufferManager::ShutDown();
+        RenderAPI::ShutDown();
+        Time::ShutDown();
+        ProfilerGPU::ShutDown();
+        CoreObjectManager::ShutDown();
+    }
+}
@@ -0,0 +1,108 @@
+#include "TeBenchmark.h"
+#include "TeObjectImporter.h"
+#include "Importer/TeMeshImportOptions.h"
+#include "Mesh/TeMeshData.h"
+#include "Threading/TeTaskScheduler.h"
+
+#include <filesystem>
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 NUM_ITERATIONS = 5;
+
+        const char* MESH_PATHS[] =
+        {
+            "Data/Meshes/FantasyInn/FantasyInn.obj",
+            "Data/Meshes/LightingScene/lighting-scene.obj",
+            "Data/Meshes/Mill/mill.obj",
+            "Data/Meshes/Ford/Ford.fbx",
+            "Data/Meshes/Monkey/monkey.obj"
+        };
+
+        /** Runs the CPU side of a mesh import, the part that doesn't need a render API. */
+        SPtr<MeshData> ImportMesh(ObjectImporter& importer, const String& path, bool parallel, Vector<SubMesh>& subMeshes)
+        {
+            MeshImportOptions options;
+            options.ImportAnimations = false;
+            options.ParallelImport = parallel;
+
+            Vector<AssimpAnimationClipData> animations;
+            SPtr<Skeleton> skeleton;
+            subMeshes.clear();
+
+            SPtr<RendererMeshData> meshData = importer.ImportMeshData(path, &options, subMeshes, animations, skeleton);
+            return meshData ? meshData->GetData() : nullptr;
+        }
+
+        /** Compares the index and vertex buffers of two imports of the same file, byte per byte. */
+        bool IsSameMeshData(const SPtr<MeshData>& a, const SPtr<MeshData>& b)
+        {
+            if (a->GetNumVertices() != b->GetNumVertices() || a->GetNumIndices() != b->GetNumIndices() ||
+                a->GetIndexType() != b->GetIndexType() || a->GetStreamSize() != b->GetStreamSize())
+                return false;
+
+            UINT32 indicesSize = a->GetNumIndices() * a->GetIndexElementSize();
+            const UINT8* indicesA = a->GetIndexType() == IT_32BIT ? (UINT8*)a->GetIndices32() : (UINT8*)a->GetIndices16();
+            const UINT8* indicesB = b->GetIndexType() == IT_32BIT ? (UINT8*)b->GetIndices32() : (UINT8*)b->GetIndices16();
+
+            return memcmp(indicesA, indicesB, indicesSize) == 0 &&
+                memcmp(a->GetStreamData(0), b->GetStreamData(0), a->GetStreamSize()) == 0;
+        }
+    }
+
+    void RunImportBenchmarks()
+    {
+        TaskScheduler::StartUp();
+
+        {
+            ObjectImporter importer;
+
+            for (auto& path : MESH_PATHS)
+            {
+                if (!std::filesystem::exists(path))
+                    continue;
+
+                Vector<SubMesh> serialSubMeshes;
+                Vector<SubMesh> parallelSubMeshes;
+                SPtr<MeshData> serialData = ImportMesh(importer, path, false, serialSubMeshes);
+                SPtr<MeshData> parallelData = ImportMesh(importer, path, true, parallelSubMeshes);
+
+                if (serialData == nullptr || parallelData == nullptr)
+                    continue;
+
+                Benchmark::ReportSection("Mesh import: " + std::filesystem::path(path).filename().generic_string() + " (" +
+                    ToString(serialData->GetNumVertices()) + " vertices, " + ToString((UINT32)serialSubMeshes.size()) +
+                    " sub-meshes)");
+
+                BenchmarkResult serialResult = Benchmark::Run("Single thread", NUM_ITERATIONS, serialData->GetNumVertices(), [&]()
+                {
+                    ImportMesh(importer, path, false, serialSubMeshes);
+                });
+
+                BenchmarkResult parallelResult = Benchmark::Run(ToString(gTaskScheduler().GetThreadCount() + 1) + " threads",
+                    NUM_ITERATIONS, serialData->GetNumVertices(), [&]()
+                {
+                    ImportMesh(importer, path, true, parallelSubMeshes);
+                });
+
+                Benchmark::Report(serialResult);
+                Benchmark::Report(parallelResult);
+                Benchmark::ReportSpeedup(serialResult, parallelResult);
+
+                bool sameSubMeshes = serialSubMeshes.size() == parallelSubMeshes.size();
+                for (UINT32 i = 0; sameSubMeshes && i < (UINT32)serialSubMeshes.size(); i++)
+                {
+                    sameSubMeshes = serialSubMeshes[i].IndexOffset == parallelSubMeshes[i].IndexOffset &&
+                        serialSubMeshes[i].IndexCount == parallelSubMeshes[i].IndexCount;
+                }
+
+                Benchmark::ReportCheck("Parallel import matches single thread import",
+                    sameSubMeshes && IsSameMeshData(serialData, parallelData), 0.0f);
+            }
+        }
+
+        TaskScheduler::ShutDown();
+    }
+}
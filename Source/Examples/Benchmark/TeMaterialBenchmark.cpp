@@ -0,0 +1,253 @@
+#include "TeBenchmark.h"
+#include "Material/TeMaterial.h"
+#include "RenderAPI/TeGpuParams.h"
+#include "RenderAPI/TeGpuParamDesc.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+#include "RenderAPI/TeGpuPipelineParamInfo.h"
+#include "CoreUtility/TeCoreObjectManager.h"
+#include "Profiling/TeProfilerGPU.h"
+#include "Math/TeVector4.h"
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 NUM_DRAWS = 4096;
+        constexpr UINT32 NUM_MATERIALS = 64;
+        constexpr UINT32 NUM_MATERIAL_PARAMS = 16;
+        constexpr UINT32 NUM_FRAMES = 100;
+
+        /** Parameter layout of a pipeline, built by hand instead of being reflected from compiled programs. */
+        class BenchmarkParamInfo : public GpuPipelineParamInfo
+        {
+        public:
+            BenchmarkParamInfo(const GPU_PIPELINE_PARAMS_DESC& desc)
+                : GpuPipelineParamInfo(desc, GDF_DEFAULT)
+            { }
+        };
+
+        /** Parameters of a draw, created without a render API. */
+        class BenchmarkGpuParams : public GpuParams
+        {
+        public:
+            BenchmarkGpuParams(const SPtr<GpuPipelineParamInfo>& paramInfo)
+                : GpuParams(paramInfo, GDF_DEFAULT)
+            { }
+        };
+
+        /** Parameter block without a GPU buffer, its values only live in its CPU copy. */
+        class BenchmarkParamBlock : public GpuParamBlockBuffer
+        {
+        public:
+            BenchmarkParamBlock(UINT32 size)
+                : GpuParamBlockBuffer(size, GBU_DYNAMIC, GDF_DEFAULT)
+            { }
+
+            using GpuParamBlockBuffer::Initialize;
+        };
+
+        /** Objects of a forward pass drawing NUM_DRAWS elements sharing a pipeline and NUM_MATERIALS materials. */
+        struct ForwardPassData
+        {
+            Vector<SPtr<GpuParams>> DrawParams;
+            Vector<SPtr<GpuParamBlockBuffer>> MaterialBlocks;
+            Vector<SPtr<Material>> Materials;
+            Vector<Vector<UINT32>> MaterialParamHandles;
+
+            SPtr<GpuParamBlockBuffer> PerLights;
+            SPtr<GpuParamBlockBuffer> PerCamera;
+            SPtr<GpuParamBlockBuffer> PerFrame;
+        };
+
+        SPtr<GpuParamBlockBuffer> CreateBlock(UINT32 size)
+        {
+            SPtr<BenchmarkParamBlock> block = te_core_ptr_new<BenchmarkParamBlock>(size);
+            block->Initialize();
+
+            return block;
+        }
+
+        String GetMaterialParamName(UINT32 idx)
+        {
+            return "gParam" + ToString(idx);
+        }
+
+        Vector4 GetMaterialParamValue(UINT32 materialIdx, UINT32 paramIdx, UINT32 frame)
+        {
+            return Vector4((float)materialIdx, (float)paramIdx, (float)frame, 1.0f);
+        }
+
+        ForwardPassData CreateForwardPass()
+        {
+            SPtr<GpuParamDesc> paramDesc = te_shared_ptr_new<GpuParamDesc>();
+
+            auto addBlock = [&](const String& name, UINT32 slot, UINT32 numFloats)
+            {
+                GpuParamBlockDesc& block = paramDesc->ParamBlocks[name];
+                block.Name = name;
+                block.Set = 0;
+                block.Slot = slot;
+                block.BlockSize = numFloats;
+                block.IsShareable = true;
+            };
+
+            addBlock("PerCameraBuffer", 0, 64);
+            addBlock("PerFrameBuffer", 1, 16);
+            addBlock("PerLightsBuffer", 2, 256);
+            addBlock("PerMaterialBuffer", 3, NUM_MATERIAL_PARAMS * 4);
+
+            for (UINT32 i = 0; i < NUM_MATERIAL_PARAMS; i++)
+            {
+                GpuParamDataDesc& param = paramDesc->Params[GetMaterialParamName(i)];
+                param.Name = GetMaterialParamName(i);
+                param.Type = GPDT_FLOAT4;
+                param.ElementSize = 4;
+                param.ArraySize = 1;
+                param.ArrayElementStride = 4;
+                param.ParamBlockSet = 0;
+                param.ParamBlockSlot = 3;
+                param.GpuMemOffset = i * 4;
+                param.CpuMemOffset = i * 4;
+            }
+
+            GPU_PIPELINE_PARAMS_DESC pipelineDesc;
+            pipelineDesc.VertexParams = paramDesc;
+            pipelineDesc.PixelParams = paramDesc;
+
+            SPtr<GpuPipelineParamInfo> paramInfo = te_core_ptr_new<BenchmarkParamInfo>(pipelineDesc);
+            paramInfo->Initialize();
+
+            ForwardPassData data;
+            data.PerLights = CreateBlock(256 * sizeof(float));
+            data.PerCamera = CreateBlock(64 * sizeof(float));
+            data.PerFrame = CreateBlock(16 * sizeof(float));
+
+            for (UINT32 i = 0; i < NUM_MATERIALS; i++)
+            {
+                SPtr<Material> material = Material::CreateEmpty();
+
+                Vector<UINT32> handles;
+                for (UINT32 j = 0; j < NUM_MATERIAL_PARAMS; j++)
+                {
+                    handles.push_back(material->GetParamHandle(GetMaterialParamName(j), sizeof(Vector4)));
+                    material->SetParam(handles.back(), GetMaterialParamValue(i, j, 0));
+                }
+
+                data.Materials.push_back(material);
+                data.MaterialParamHandles.push_back(handles);
+            }
+
+            for (UINT32 i = 0; i < NUM_DRAWS; i++)
+            {
+                SPtr<GpuParams> params = te_core_ptr_new<BenchmarkGpuParams>(paramInfo);
+                params->Initialize();
+
+                SPtr<GpuParamBlockBuffer> materialBlock = CreateBlock(NUM_MATERIAL_PARAMS * sizeof(Vector4));
+                params->SetParamBlockBuffer("PerMaterialBuffer", materialBlock);
+
+                data.DrawParams.push_back(params);
+                data.MaterialBlocks.push_back(materialBlock);
+            }
+
+            return data;
+        }
+    }
+
+    void RunMaterialBenchmarks()
+    {
+        CoreObjectManager::StartUp();
+        ProfilerGPU::StartUp();
+
+        {
+            Benchmark::ReportSection("Forward pass parameters (" + ToString(NUM_DRAWS) + " draws, " +
+                ToString(NUM_MATERIALS) + " materials of " + ToString(NUM_MATERIAL_PARAMS) + " parameters)");
+
+            ForwardPassData data = CreateForwardPass();
+            UINT32 frame = 0;
+
+            // What every draw did before: blocks found by name, and every material parameter written again
+            BenchmarkResult nameResult = Benchmark::Run("By name, every parameter written", NUM_FRAMES, NUM_DRAWS, [&]()
+            {
+                for (UINT32 i = 0; i < NUM_MATERIALS; i++)
+                {
+                    for (UINT32 j = 0; j < NUM_MATERIAL_PARAMS; j++)
+                        data.Materials[i]->SetParam(data.MaterialParamHandles[i][j], GetMaterialParamValue(i, j, 0));
+                }
+
+                for (UINT32 i = 0; i < NUM_DRAWS; i++)
+                {
+                    const SPtr<GpuParams>& params = data.DrawParams[i];
+                    params->SetParamBlockBuffer("PerLightsBuffer", data.PerLights);
+                    params->SetParamBlockBuffer("PerCameraBuffer", data.PerCamera);
+                    params->SetParamBlockBuffer("PerFrameBuffer", data.PerFrame);
+
+                    data.Materials[i % NUM_MATERIALS]->SetGpuParam(params);
+                }
+            });
+
+            GpuParams::ParamBlockHandle perLights = data.DrawParams[0]->GetParamBlockHandle("PerLightsBuffer");
+            GpuParams::ParamBlockHandle perCamera = data.DrawParams[0]->GetParamBlockHandle("PerCameraBuffer");
+            GpuParams::ParamBlockHandle perFrame = data.DrawParams[0]->GetParamBlockHandle("PerFrameBuffer");
+
+            auto drawWithHandles = [&]()
+            {
+                for (UINT32 i = 0; i < NUM_DRAWS; i++)
+                {
+                    const SPtr<GpuParams>& params = data.DrawParams[i];
+                    params->SetParamBlockBuffer(perLights, data.PerLights);
+                    params->SetParamBlockBuffer(perCamera, data.PerCamera);
+                    params->SetParamBlockBuffer(perFrame, data.PerFrame);
+
+                    data.Materials[i % NUM_MATERIALS]->SetGpuParam(params);
+                }
+            };
+
+            BenchmarkResult staticResult = Benchmark::Run("By handle, no parameter set", NUM_FRAMES, NUM_DRAWS,
+                drawWithHandles);
+
+            // A single animated parameter per material, the others stay untouched
+            BenchmarkResult animatedResult = Benchmark::Run("By handle, one parameter set per material", NUM_FRAMES,
+                NUM_DRAWS, [&]()
+            {
+                frame++;
+                for (UINT32 i = 0; i < NUM_MATERIALS; i++)
+                    data.Materials[i]->SetParam(data.MaterialParamHandles[i][0], GetMaterialParamValue(i, 0, frame));
+
+                drawWithHandles();
+            });
+
+            Benchmark::Report(nameResult);
+            Benchmark::Report(staticResult);
+            Benchmark::Report(animatedResult);
+            Benchmark::ReportSpeedup(nameResult, staticResult);
+            Benchmark::ReportSpeedup(nameResult, animatedResult);
+
+            // Every draw must see the values of its material, and the blocks must point where they were assigned
+            bool sameBlocks = true;
+            float maxError = 0.0f;
+            for (UINT32 i = 0; i < NUM_DRAWS; i++)
+            {
+                const SPtr<GpuParams>& params = data.DrawParams[i];
+                sameBlocks &= params->GetParamBlockBuffer(0, 0) == data.PerCamera;
+                sameBlocks &= params->GetParamBlockBuffer(0, 1) == data.PerFrame;
+                sameBlocks &= params->GetParamBlockBuffer(0, 2) == data.PerLights;
+
+                for (UINT32 j = 0; j < NUM_MATERIAL_PARAMS; j++)
+                {
+                    Vector4 value;
+                    data.MaterialBlocks[i]->Read(j * sizeof(Vector4), &value, sizeof(Vector4));
+
+                    Vector4 expected = GetMaterialParamValue(i % NUM_MATERIALS, j, j == 0 ? frame : 0);
+                    for (UINT32 k = 0; k < 4; k++)
+                        maxError = std::max(maxError, Math::Abs(value[k] - expected[k]));
+                }
+            }
+
+            Benchmark::ReportCheck("Blocks hold the values of their material", sameBlocks && maxError == 0.0f,
+                maxError);
+        }
+
+        ProfilerGPU::ShutDown();
+        CoreObjectManager::ShutDown();
+    }
+}
@@ -0,0 +1,311 @@
+#include "TeBenchmark.h"
+#include "Math/TeAABox.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeQuaternion.h"
+
+#include <random>
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 NUM_ELEMENTS = 1024;
+        constexpr UINT32 NUM_ITERATIONS = 2000;
+
+        /** Scalar implementations the math types used before they moved to SIMD registers. */
+        namespace Reference
+        {
+            Matrix4 Multiply(const Matrix4& a, const Matrix4& b)
+            {
+                Matrix4 r;
+                for (UINT32 i = 0; i < 4; i++)
+                {
+                    for (UINT32 j = 0; j < 4; j++)
+                        r[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j] + a[i][3] * b[3][j];
+                }
+
+                return r;
+            }
+
+            Matrix4 Inverse(const Matrix4& mat)
+            {
+                float m00 = mat[0][0], m01 = mat[0][1], m02 = mat[0][2], m03 = mat[0][3];
+                float m10 = mat[1][0], m11 = mat[1][1], m12 = mat[1][2], m13 = mat[1][3];
+                float m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2], m23 = mat[2][3];
+                float m30 = mat[3][0], m31 = mat[3][1], m32 = mat[3][2], m33 = mat[3][3];
+
+                float v0 = m20 * m31 - m21 * m30;
+                float v1 = m20 * m32 - m22 * m30;
+                float v2 = m20 * m33 - m23 * m30;
+                float v3 = m21 * m32 - m22 * m31;
+                float v4 = m21 * m33 - m23 * m31;
+                float v5 = m22 * m33 - m23 * m32;
+
+                float t00 = +(v5 * m11 - v4 * m12 + v3 * m13);
+                float t10 = -(v5 * m10 - v2 * m12 + v1 * m13);
+                float t20 = +(v4 * m10 - v2 * m11 + v0 * m13);
+                float t30 = -(v3 * m10 - v1 * m11 + v0 * m12);
+
+                float invDet = 1 / (t00 * m00 + t10 * m01 + t20 * m02 + t30 * m03);
+
+                float d00 = t00 * invDet;
+                float d10 = t10 * invDet;
+                float d20 = t20 * invDet;
+                float d30 = t30 * invDet;
+
+                float d01 = -(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
+                float d11 = +(v5 * m00 - v2 * m02 + v1 * m03) * invDet;
+                float d21 = -(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
+                float d31 = +(v3 * m00 - v1 * m01 + v0 * m02) * invDet;
+
+                v0 = m10 * m31 - m11 * m30;
+                v1 = m10 * m32 - m12 * m30;
+                v2 = m10 * m33 - m13 * m30;
+                v3 = m11 * m32 - m12 * m31;
+                v4 = m11 * m33 - m13 * m31;
+                v5 = m12 * m33 - m13 * m32;
+
+                float d02 = +(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
+                float d12 = -(v5 * m00 - v2 * m02 + v1 * m03) * invDet;
+                float d22 = +(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
+                float d32 = -(v3 * m00 - v1 * m01 + v0 * m02) * invDet;
+
+                v0 = m21 * m10 - m20 * m11;
+                v1 = m22 * m10 - m20 * m12;
+                v2 = m23 * m10 - m20 * m13;
+                v3 = m22 * m11 - m21 * m12;
+                v4 = m23 * m11 - m21 * m13;
+                v5 = m23 * m12 - m22 * m13;
+
+                float d03 = -(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
+                float d13 = +(v5 * m00 - v2 * m02 + v1 * m03) * invDet;
+                float d23 = -(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
+                float d33 = +(v3 * m00 - v1 * m01 + v0 * m02) * invDet;
+
+                return Matrix4(
+                    d00, d01, d02, d03,
+                    d10, d11, d12, d13,
+                    d20, d21, d22, d23,
+                    d30, d31, d32, d33);
+            }
+
+            Matrix4 InverseAffine(const Matrix4& mat)
+            {
+                float m10 = mat[1][0], m11 = mat[1][1], m12 = mat[1][2];
+                float m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2];
+
+                float t00 = m22 * m11 - m21 * m12;
+                float t10 = m20 * m12 - m22 * m10;
+                float t20 = m21 * m10 - m20 * m11;
+
+                float m00 = mat[0][0], m01 = mat[0][1], m02 = mat[0][2];
+
+                float invDet = 1 / (m00 * t00 + m01 * t10 + m02 * t20);
+
+                t00 *= invDet; t10 *= invDet; t20 *= invDet;
+                m00 *= invDet; m01 *= invDet; m02 *= invDet;
+
+                float r01 = m02 * m21 - m01 * m22;
+                float r02 = m01 * m12 - m02 * m11;
+                float r11 = m00 * m22 - m02 * m20;
+                float r12 = m02 * m10 - m00 * m12;
+                float r21 = m01 * m20 - m00 * m21;
+                float r22 = m00 * m11 - m01 * m10;
+
+                float m03 = mat[0][3], m13 = mat[1][3], m23 = mat[2][3];
+
+                return Matrix4(
+                    t00, r01, r02, -(t00 * m03 + r01 * m13 + r02 * m23),
+                    t10, r11, r12, -(t10 * m03 + r11 * m13 + r12 * m23),
+                    t20, r21, r22, -(t20 * m03 + r21 * m13 + r22 * m23),
+                    0, 0, 0, 1);
+            }
+
+            Vector3 MultiplyAffine(const Matrix4& m, const Vector3& v)
+            {
+                return Vector3(
+                    m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3],
+                    m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3],
+                    m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3]);
+            }
+
+            AABox TransformAffine(const AABox& box, const Matrix4& m)
+            {
+                Vector3 min = m.GetTranslation();
+                Vector3 max = m.GetTranslation();
+                for (UINT32 i = 0; i < 3; i++)
+                {
+                    for (UINT32 j = 0; j < 3; j++)
+                    {
+                        float e = m[i][j] * box.GetMin()[j];
+                        float f = m[i][j] * box.GetMax()[j];
+
+                        min[i] += std::min(e, f);
+                        max[i] += std::max(e, f);
+                    }
+                }
+
+                return AABox(min, max);
+            }
+
+            Quaternion Multiply(const Quaternion& a, const Quaternion& b)
+            {
+                return Quaternion(
+                    a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                    a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                    a.w * b.y + a.y * b.w + a.z * b.x - a.x * b.z,
+                    a.w * b.z + a.z * b.w + a.x * b.y - a.y * b.x);
+            }
+
+            Vector3 Rotate(const Quaternion& q, const Vector3& v)
+            {
+                Matrix3 rot;
+                q.ToRotationMatrix(rot);
+                return rot.Multiply(v);
+            }
+        }
+
+        /** Random affine transforms, rotations, points and boxes shared by both paths. */
+        struct MathBenchmarkData
+        {
+            Vector<Matrix4> Matrices;
+            Vector<Quaternion> Rotations;
+            Vector<Vector3> Points;
+            Vector<AABox> Boxes;
+        };
+
+        MathBenchmarkData CreateData()
+        {
+            std::mt19937 rng(1234);
+            std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+            MathBenchmarkData data;
+            for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+            {
+                Quaternion rotation(dist(rng), dist(rng), dist(rng), dist(rng));
+                rotation.Normalize();
+
+                Vector3 position(dist(rng) * 10.0f, dist(rng) * 10.0f, dist(rng) * 10.0f);
+                Vector3 scale(1.5f + dist(rng), 1.5f + dist(rng), 1.5f + dist(rng));
+                Vector3 point(dist(rng), dist(rng), dist(rng));
+                Vector3 extents(0.1f + Math::Abs(dist(rng)), 0.1f + Math::Abs(dist(rng)), 0.1f + Math::Abs(dist(rng)));
+
+                data.Matrices.push_back(Matrix4::TRS(position, rotation, scale));
+                data.Rotations.push_back(rotation);
+                data.Points.push_back(point);
+                data.Boxes.push_back(AABox(point - extents, point + extents));
+            }
+
+            return data;
+        }
+
+        float MaxError(const Matrix4& a, const Matrix4& b)
+        {
+            float maxError = 0.0f;
+            for (UINT32 row = 0; row < 4; row++)
+            {
+                for (UINT32 col = 0; col < 4; col++)
+                    maxError = std::max(maxError, Math::Abs(a[row][col] - b[row][col]));
+            }
+
+            return maxError;
+        }
+
+        float MaxError(const Vector3& a, const Vector3& b)
+        {
+            return std::max(std::max(Math::Abs(a.x - b.x), Math::Abs(a.y - b.y)), Math::Abs(a.z - b.z));
+        }
+
+        float MaxError(const Quaternion& a, const Quaternion& b)
+        {
+            return std::max(std::max(Math::Abs(a.x - b.x), Math::Abs(a.y - b.y)),
+                std::max(Math::Abs(a.z - b.z), Math::Abs(a.w - b.w)));
+        }
+
+        float MaxError(const AABox& a, const AABox& b)
+        {
+            return std::max(MaxError(a.GetMin(), b.GetMin()), MaxError(a.GetMax(), b.GetMax()));
+        }
+
+        /**
+         * Measures @p reference against @p optimized, both mapping element i of the data to output i, then checks the
+         * outputs match.
+         */
+        template<class T, class REFERENCE, class OPTIMIZED>
+        void Compare(const String& name, REFERENCE reference, OPTIMIZED optimized, float tolerance)
+        {
+            Vector<T> referenceOutput(NUM_ELEMENTS);
+            Vector<T> optimizedOutput(NUM_ELEMENTS);
+
+            BenchmarkResult referenceResult = Benchmark::Run(name + " (scalar)", NUM_ITERATIONS, NUM_ELEMENTS, [&]()
+            {
+                for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+                    referenceOutput[i] = reference(i);
+            });
+
+            BenchmarkResult optimizedResult = Benchmark::Run(name + " (SIMD)", NUM_ITERATIONS, NUM_ELEMENTS, [&]()
+            {
+                for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+                    optimizedOutput[i] = optimized(i);
+            });
+
+            Benchmark::Report(referenceResult);
+            Benchmark::Report(optimizedResult);
+            Benchmark::ReportSpeedup(referenceResult, optimizedResult);
+
+            float maxError = 0.0f;
+            for (UINT32 i = 0; i < NUM_ELEMENTS; i++)
+                maxError = std::max(maxError, MaxError(referenceOutput[i], optimizedOutput[i]));
+
+            Benchmark::ReportCheck("Results match scalar path", maxError < tolerance, maxError);
+        }
+    }
+
+    void RunMathBenchmarks()
+    {
+        Benchmark::ReportSection("Math (" + ToString(NUM_ELEMENTS) + " elements)");
+
+        MathBenchmarkData data = CreateData();
+        const Vector<Matrix4>& matrices = data.Matrices;
+        const Vector<Quaternion>& rotations = data.Rotations;
+        const Vector<Vector3>& points = data.Points;
+        const Vector<AABox>& boxes = data.Boxes;
+
+        auto next = [](UINT32 i) { return (i + 1) % NUM_ELEMENTS; };
+
+        Compare<Matrix4>("Matrix4 multiply",
+            [&](UINT32 i) { return Reference::Multiply(matrices[i], matrices[next(i)]); },
+            [&](UINT32 i) { return matrices[i] * matrices[next(i)]; },
+            1e-3f);
+
+        Compare<Matrix4>("Matrix4 inverse",
+            [&](UINT32 i) { return Reference::Inverse(matrices[i]); },
+            [&](UINT32 i) { return matrices[i].Inverse(); },
+            1e-3f);
+
+        Compare<Matrix4>("Matrix4 affine inverse",
+            [&](UINT32 i) { return Reference::InverseAffine(matrices[i]); },
+            [&](UINT32 i) { return matrices[i].InverseAffine(); },
+            1e-3f);
+
+        Compare<Vector3>("Matrix4 point transform",
+            [&](UINT32 i) { return Reference::MultiplyAffine(matrices[i], points[i]); },
+            [&](UINT32 i) { return matrices[i].MultiplyAffine(points[i]); },
+            1e-3f);
+
+        Compare<AABox>("AABox affine transform",
+            [&](UINT32 i) { return Reference::TransformAffine(boxes[i], matrices[i]); },
+            [&](UINT32 i) { AABox box = boxes[i]; box.TransformAffine(matrices[i]); return box; },
+            1e-3f);
+
+        Compare<Quaternion>("Quaternion multiply",
+            [&](UINT32 i) { return Reference::Multiply(rotations[i], rotations[next(i)]); },
+            [&](UINT32 i) { return rotations[i] * rotations[next(i)]; },
+            1e-5f);
+
+        Compare<Vector3>("Quaternion rotate",
+            [&](UINT32 i) { return Reference::Rotate(rotations[i], points[i]); },
+            [&](UINT32 i) { return rotations[i].Rotate(points[i]); },
+            1e-5f);
+    }
+}
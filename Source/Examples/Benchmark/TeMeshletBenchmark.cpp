@@ -0,0 +1,163 @@
+#include "TeBenchmark.h"
+#include "Mesh/TeMeshlet.h"
+#include "Math/TeConvexVolume.h"
+#include "Math/TeMath.h"
+#include "Math/TeMatrix4.h"
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 NUM_RINGS = 128;
+        constexpr UINT32 NUM_SEGMENTS = 256;
+        constexpr UINT32 NUM_BUILD_ITERATIONS = 10;
+        constexpr UINT32 NUM_CULL_ITERATIONS = 2000;
+        constexpr float SPHERE_RADIUS = 2.5f;
+
+        /** UV sphere centered on the origin, with triangles wound so their normals point outwards. */
+        struct SphereMesh
+        {
+            Vector<float> Positions;
+            Vector<UINT32> Indices;
+
+            UINT32 GetNumVertices() const { return (UINT32)Positions.size() / 3; }
+            UINT32 GetNumTriangles() const { return (UINT32)Indices.size() / 3; }
+
+            Vector3 GetPosition(UINT32 index) const
+            {
+                return Vector3(Positions[index * 3 + 0], Positions[index * 3 + 1], Positions[index * 3 + 2]);
+            }
+        };
+
+        SphereMesh CreateSphere()
+        {
+            SphereMesh mesh;
+            mesh.Positions.reserve((NUM_RINGS + 1) * (NUM_SEGMENTS + 1) * 3);
+            mesh.Indices.reserve(NUM_RINGS * NUM_SEGMENTS * 6);
+
+            for (UINT32 ring = 0; ring <= NUM_RINGS; ring++)
+            {
+                float theta = Math::PI * ring / (float)NUM_RINGS;
+                for (UINT32 segment = 0; segment <= NUM_SEGMENTS; segment++)
+                {
+                    float phi = Math::TWO_PI * segment / (float)NUM_SEGMENTS;
+
+                    mesh.Positions.push_back(SPHERE_RADIUS * std::sin(theta) * std::cos(phi));
+                    mesh.Positions.push_back(SPHERE_RADIUS * std::cos(theta));
+                    mesh.Positions.push_back(SPHERE_RADIUS * std::sin(theta) * std::sin(phi));
+                }
+            }
+
+            auto addTriangle = [&mesh](UINT32 i0, UINT32 i1, UINT32 i2)
+            {
+                Vector3 v0 = mesh.GetPosition(i0);
+                Vector3 v1 = mesh.GetPosition(i1);
+                Vector3 v2 = mesh.GetPosition(i2);
+
+                // Degenerate triangles at the poles
+                Vector3 normal = (v1 - v0).Cross(v2 - v0);
+                if (normal.SquaredLength() < 1e-12f)
+                    return;
+
+                if (normal.Dot(v0 + v1 + v2) < 0.0f)
+                    std::swap(i1, i2);
+
+                mesh.Indices.push_back(i0);
+                mesh.Indices.push_back(i1);
+                mesh.Indices.push_back(i2);
+            };
+
+            UINT32 rowSize = NUM_SEGMENTS + 1;
+            for (UINT32 ring = 0; ring < NUM_RINGS; ring++)
+            {
+                for (UINT32 segment = 0; segment < NUM_SEGMENTS; segment++)
+                {
+                    UINT32 i00 = ring * rowSize + segment;
+                    UINT32 i01 = i00 + 1;
+                    UINT32 i10 = i00 + rowSize;
+                    UINT32 i11 = i10 + 1;
+
+                    addTriangle(i00, i10, i11);
+                    addTriangle(i00, i11, i01);
+                }
+            }
+
+            return mesh;
+        }
+    }
+
+    void RunMeshletBenchmarks()
+    {
+        SphereMesh mesh = CreateSphere();
+        UINT32 numTriangles = mesh.GetNumTriangles();
+
+        Benchmark::ReportSection("Meshlet culling (" + ToString(numTriangles) + " triangles)");
+
+        const UINT8* positions = (const UINT8*)mesh.Positions.data();
+        const UINT32 stride = sizeof(float) * 3;
+
+        Vector<Meshlet> meshlets;
+        BenchmarkResult buildResult = Benchmark::Run("Build meshlets", NUM_BUILD_ITERATIONS, numTriangles, [&]()
+        {
+            meshlets.clear();
+            MeshletUtility::Build(mesh.Indices.data(), 0, (UINT32)mesh.Indices.size(), positions,
+                mesh.GetNumVertices(), stride, meshlets);
+        });
+
+        // View at the origin looking down -Z, so the view space frustum is also the world space one. The sphere sits
+        // across the right plane of the frustum: part of it is outside the view and half of it faces away.
+        Matrix4 projection = Matrix4::ProjectionPerspective(Degree(30.0f), 1.0f, 0.1f, 100.0f);
+        ConvexVolume frustum(projection);
+        Matrix4 worldTfrm = Matrix4::Translation(Vector3(2.0f, 0.0f, -8.0f));
+        Vector3 viewOrigin = Vector3::ZERO;
+
+        Vector<MeshletRange> ranges;
+        UINT32 numVisibleTriangles = 0;
+        BenchmarkResult cullResult = Benchmark::Run("Cull meshlets", NUM_CULL_ITERATIONS, numTriangles, [&]()
+        {
+            ranges.clear();
+            numVisibleTriangles = MeshletUtility::Cull(meshlets, worldTfrm, frustum, viewOrigin, 1.0f, 0, ranges);
+        });
+
+        Benchmark::Report(buildResult);
+        Benchmark::Report(cullResult);
+
+        // Every triangle that is front facing and intersects the frustum must be in one of the output ranges
+        Vector<bool> drawn(numTriangles, false);
+        for (auto& range : ranges)
+        {
+            for (UINT32 i = range.IndexOffset / 3; i < (range.IndexOffset + range.IndexCount) / 3; i++)
+                drawn[i] = true;
+        }
+
+        UINT32 numExpectedTriangles = 0;
+        UINT32 numMissingTriangles = 0;
+        for (UINT32 i = 0; i < numTriangles; i++)
+        {
+            Vector3 v0 = worldTfrm.MultiplyAffine(mesh.GetPosition(mesh.Indices[i * 3 + 0]));
+            Vector3 v1 = worldTfrm.MultiplyAffine(mesh.GetPosition(mesh.Indices[i * 3 + 1]));
+            Vector3 v2 = worldTfrm.MultiplyAffine(mesh.GetPosition(mesh.Indices[i * 3 + 2]));
+
+            Vector3 normal = (v1 - v0).Cross(v2 - v0);
+            if (normal.Dot(v0 - viewOrigin) >= 0.0f)
+                continue;
+
+            Vector3 center = (v0 + v1 + v2) / 3.0f;
+            float radius = std::max({ center.Distance(v0), center.Distance(v1), center.Distance(v2) });
+            if (!frustum.Intersects(Sphere(center, radius)))
+                continue;
+
+            numExpectedTriangles++;
+            if (!drawn[i])
+                numMissingTriangles++;
+        }
+
+        Benchmark::ReportCheck("Visible triangles kept (" + ToString(numExpectedTriangles) + ")",
+            numMissingTriangles == 0, (float)numMissingTriangles);
+
+        // Back facing and off-screen meshlets must be culled, the sphere is more than half hidden
+        Benchmark::ReportCheck("Hidden triangles culled (" + ToString(numVisibleTriangles) + "/" +
+            ToString(numTriangles) + " drawn)", numVisibleTriangles < numTriangles / 2,
+            (float)numVisibleTriangles / (float)numTriangles);
+    }
+}
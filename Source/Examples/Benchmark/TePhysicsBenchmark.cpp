@@ -0,0 +1,374 @@
+#include "TeBenchmark.h"
+#include "TeBulletSceneQuery.h"
+#include "TeBulletTaskScheduler.h"
+#include "TeBulletRayCallback.h"
+#include "Physics/TePhysicsCommon.h"
+#include "Threading/TeTaskScheduler.h"
+
+#include <random>
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 GRID_SIZE = 64;
+        constexpr UINT32 NUM_RAYS = 10000;
+        constexpr UINT32 NUM_ITERATIONS = 50;
+        constexpr float MAX_RAY_DIST = 200.0f;
+
+        constexpr UINT32 PILE_SIZE = 12;
+        constexpr UINT32 NUM_PILE_STEPS = 120;
+        constexpr UINT32 NUM_PILE_ITERATIONS = 3;
+
+        /**
+         * Static collision world filled with a grid of boxes of random heights. Each box lives in its own compound shape,
+         * the same way bodies hold their colliders.
+         */
+        class QueryBenchmarkWorld
+        {
+        public:
+            QueryBenchmarkWorld()
+            {
+                _configuration = te_new<btDefaultCollisionConfiguration>();
+                _dispatcher = te_new<btCollisionDispatcher>(_configuration);
+                _broadphase = te_new<btDbvtBroadphase>();
+                World = te_new<btCollisionWorld>(_dispatcher, _broadphase, _configuration);
+
+                std::mt19937 rng(1234);
+                std::uniform_real_distribution<float> heightDist(0.5f, 10.0f);
+
+                for (UINT32 x = 0; x < GRID_SIZE; x++)
+                {
+                    for (UINT32 z = 0; z < GRID_SIZE; z++)
+                    {
+                        float height = heightDist(rng);
+
+                        btBoxShape* box = te_new<btBoxShape>(btVector3(0.4f, height * 0.5f, 0.4f));
+                        btCompoundShape* compound = te_new<btCompoundShape>();
+                        compound->addChildShape(btTransform::getIdentity(), box);
+
+                        btCollisionObject* object = te_new<btCollisionObject>();
+                        object->setCollisionShape(compound);
+                        object->setWorldTransform(btTransform(btQuaternion::getIdentity(),
+                            btVector3((btScalar)x, height * 0.5f, (btScalar)z)));
+
+                        World->addCollisionObject(object, btBroadphaseProxy::StaticFilter);
+
+                        _shapes.push_back(box);
+                        _shapes.push_back(compound);
+                        _objects.push_back(object);
+                    }
+                }
+
+                World->updateAabbs();
+            }
+
+            ~QueryBenchmarkWorld()
+            {
+                for (auto& object : _objects)
+                {
+                    World->removeCollisionObject(object);
+                    te_delete(object);
+                }
+
+                for (auto& shape : _shapes)
+                    te_delete(shape);
+
+                te_delete(World);
+                te_delete(_broadphase);
+                te_delete(_dispatcher);
+                te_delete(_configuration);
+            }
+
+            btCollisionWorld* World = nullptr;
+
+        private:
+            btDefaultCollisionConfiguration* _configuration = nullptr;
+            btCollisionDispatcher* _dispatcher = nullptr;
+            btBroadphaseInterface* _broadphase = nullptr;
+
+            Vector<btCollisionShape*> _shapes;
+            Vector<btCollisionObject*> _objects;
+        };
+
+        /**
+         * Cube of PILE_SIZE^3 boxes dropped on a ground plane, simulated with the single threaded Bullet pipeline or the
+         * multithreaded one. The multithreaded pipeline runs on the task scheduler installed when the world is created.
+         */
+        class PileBenchmarkWorld
+        {
+        public:
+            PileBenchmarkWorld(bool multiThreaded)
+            {
+                _configuration = te_new<btDefaultCollisionConfiguration>();
+                _broadphase = te_new<btDbvtBroadphase>();
+
+                if (multiThreaded)
+                {
+                    _dispatcher = te_new<btCollisionDispatcherMt>(_configuration);
+                    _solver = te_new<btSequentialImpulseConstraintSolverMt>();
+                    _solverPool = te_new<btConstraintSolverPoolMt>(btGetTaskScheduler()->getNumThreads());
+                    World = te_new<btDiscreteDynamicsWorldMt>(_dispatcher, _broadphase, _solverPool, _solver,
+                        _configuration);
+                }
+                else
+                {
+                    _dispatcher = te_new<btCollisionDispatcher>(_configuration);
+                    _solver = te_new<btSequentialImpulseConstraintSolver>();
+                    World = te_new<btDiscreteDynamicsWorld>(_dispatcher, _broadphase, _solver, _configuration);
+                }
+
+                World->setGravity(btVector3(0.0f, -9.81f, 0.0f));
+
+                _groundShape = te_new<btStaticPlaneShape>(btVector3(0.0f, 1.0f, 0.0f), 0.0f);
+                AddBody(_groundShape, 0.0f, btVector3(0.0f, 0.0f, 0.0f));
+
+                // Boxes are slightly shifted so the pile collapses instead of staying stacked
+                std::mt19937 rng(2468);
+                std::uniform_real_distribution<float> offsetDist(-0.15f, 0.15f);
+
+                _boxShape = te_new<btBoxShape>(btVector3(0.5f, 0.5f, 0.5f));
+                for (UINT32 y = 0; y < PILE_SIZE; y++)
+                {
+                    for (UINT32 x = 0; x < PILE_SIZE; x++)
+                    {
+                        for (UINT32 z = 0; z < PILE_SIZE; z++)
+                        {
+                            btVector3 position(x * 1.1f + offsetDist(rng), 0.6f + y * 1.1f, z * 1.1f + offsetDist(rng));
+                            AddBody(_boxShape, 1.0f, position);
+                        }
+                    }
+                }
+            }
+
+            ~PileBenchmarkWorld()
+            {
+                for (auto& body : _bodies)
+                {
+                    World->removeRigidBody(body);
+                    te_delete(body);
+                }
+
+                te_delete(World);
+                te_delete(_boxShape);
+                te_delete(_groundShape);
+                te_safe_delete(_solverPool);
+                te_delete(_solver);
+                te_delete(_dispatcher);
+                te_delete(_broadphase);
+                te_delete(_configuration);
+            }
+
+            /** Returns how far the lowest box sinks into the ground. */
+            float GetGroundPenetration() const
+            {
+                float penetration = 0.0f;
+                for (auto& body : _bodies)
+                {
+                    if (body->getInvMass() == 0.0f)
+                        continue;
+
+                    btVector3 aabbMin, aabbMax;
+                    body->getAabb(aabbMin, aabbMax);
+
+                    // The AABB includes the collision margin
+                    float bottom = (float)aabbMin.y() + (float)_boxShape->getMargin();
+                    penetration = std::max(penetration, -bottom);
+                }
+
+                return penetration;
+            }
+
+            btDiscreteDynamicsWorld* World = nullptr;
+
+        private:
+            void AddBody(btCollisionShape* shape, float mass, const btVector3& position)
+            {
+                btVector3 inertia(0.0f, 0.0f, 0.0f);
+                if (mass > 0.0f)
+                    shape->calculateLocalInertia(mass, inertia);
+
+                btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+                info.m_startWorldTransform = btTransform(btQuaternion::getIdentity(), position);
+
+                btRigidBody* body = te_new<btRigidBody>(info);
+                World->addRigidBody(body);
+                _bodies.push_back(body);
+            }
+
+            btDefaultCollisionConfiguration* _configuration = nullptr;
+            btCollisionDispatcher* _dispatcher = nullptr;
+            btBroadphaseInterface* _broadphase = nullptr;
+            btConstraintSolver* _solver = nullptr;
+            btConstraintSolverPoolMt* _solverPool = nullptr;
+
+            btCollisionShape* _groundShape = nullptr;
+            btBoxShape* _boxShape = nullptr;
+            Vector<btRigidBody*> _bodies;
+        };
+
+        /** Drops a new pile and simulates it for NUM_PILE_STEPS steps. Returns the ground penetration it ends with. */
+        float SimulatePile(bool multiThreaded)
+        {
+            PileBenchmarkWorld pile(multiThreaded);
+            for (UINT32 i = 0; i < NUM_PILE_STEPS; i++)
+                pile.World->stepSimulation(1.0f / 60.0f, 0, 1.0f / 60.0f);
+
+            return pile.GetGroundPenetration();
+        }
+
+        /** Steps a rigid body pile with the single threaded pipeline, then with the multithreaded one on more and more threads. */
+        void RunPileBenchmarks()
+        {
+            const UINT32 numBoxes = PILE_SIZE * PILE_SIZE * PILE_SIZE;
+            const UINT32 numBodySteps = numBoxes * NUM_PILE_STEPS;
+
+            Benchmark::ReportSection("Rigid body pile (" + ToString(numBoxes) + " boxes, " + ToString(NUM_PILE_STEPS) +
+                " steps)");
+
+            float singlePenetration = 0.0f;
+            BenchmarkResult singleResult = Benchmark::Run("btDiscreteDynamicsWorld", NUM_PILE_ITERATIONS, numBodySteps,
+                [&]()
+            {
+                singlePenetration = SimulatePile(false);
+            });
+
+            Benchmark::Report(singleResult);
+            Benchmark::ReportCheck("Boxes rest on the ground", singlePenetration < 0.1f, singlePenetration);
+
+#if BT_THREADSAFE
+            TaskScheduler::StartUp();
+            {
+                BulletTaskScheduler scheduler;
+                btSetTaskScheduler(&scheduler);
+
+                const int maxThreads = scheduler.getMaxNumThreads();
+                for (int numThreads = 1; ; numThreads = std::min(numThreads * 2, maxThreads))
+                {
+                    scheduler.setNumThreads(numThreads);
+
+                    float penetration = 0.0f;
+                    BenchmarkResult result = Benchmark::Run("btDiscreteDynamicsWorldMt, " + ToString(numThreads) +
+                        " threads", NUM_PILE_ITERATIONS, numBodySteps, [&]()
+                    {
+                        penetration = SimulatePile(true);
+                    });
+
+                    Benchmark::Report(result);
+                    Benchmark::ReportSpeedup(singleResult, result);
+                    Benchmark::ReportCheck("Boxes rest on the ground", penetration < 0.1f, penetration);
+
+                    if (numThreads == maxThreads)
+                        break;
+                }
+
+                btSetTaskScheduler(btGetSequentialTaskScheduler());
+            }
+            TaskScheduler::ShutDown();
+#else
+            // btParallelFor ignores the task scheduler, the multithreaded pipeline would run on this thread only
+            Benchmark::ReportSection("Multithreaded rigid body pile skipped, Bullet is built without BT_THREADSAFE");
+#endif
+        }
+
+        Vector<PhysicsRayQuery> CreateRays()
+        {
+            std::mt19937 rng(5678);
+            std::uniform_real_distribution<float> posDist(0.0f, (float)GRID_SIZE);
+            std::uniform_real_distribution<float> tiltDist(-0.5f, 0.5f);
+
+            Vector<PhysicsRayQuery> rays(NUM_RAYS);
+            for (auto& ray : rays)
+            {
+                ray.Origin = Vector3(posDist(rng), 30.0f, posDist(rng));
+                ray.UnitDir = Vector3(tiltDist(rng), -1.0f, tiltDist(rng));
+                ray.UnitDir.Normalize();
+                ray.MaxDist = MAX_RAY_DIST;
+            }
+
+            return rays;
+        }
+
+        /** One rayTest per ray, with the per-hit work BulletScene::RayCast() used to do. */
+        UINT32 CastRaysOneByOne(const btCollisionWorld* world, const Vector<PhysicsRayQuery>& rays,
+            Vector<PhysicsQueryHit>& hits)
+        {
+            UINT32 numHits = 0;
+            for (UINT32 i = 0; i < NUM_RAYS; i++)
+            {
+                const PhysicsRayQuery& ray = rays[i];
+                btVector3 from = ToBtVector3(ray.Origin);
+                btVector3 to = ToBtVector3(ray.Origin + ray.UnitDir * ray.MaxDist);
+
+                BulletClosestRayResultCallback callback(from, to);
+                callback.m_flags |= btTriangleRaycastCallback::kF_FilterBackfaces;
+                world->rayTest(from, to, callback);
+
+                PhysicsQueryHit hit;
+                if (callback.hasHit())
+                {
+                    hit.Normal = ToVector3(callback.m_hitNormalWorld);
+                    hit.Point = ToVector3(callback.m_hitPointWorld);
+                    hit.Distance = ray.Origin.Distance(hit.Point);
+                    hit.HitBodyRaw = static_cast<Body*>(callback.m_collisionObject->getUserPointer());
+
+                    const btCompoundShape* shape = static_cast<const btCompoundShape*>(callback.m_collisionObject->getCollisionShape());
+                    for (int j = 0; j < shape->getNumChildShapes(); j++)
+                        hit.HitCollidersRaw.push_back(static_cast<Collider*>(shape->getChildShape(j)->getUserPointer()));
+
+                    numHits++;
+                }
+
+                hits[i] = hit;
+            }
+
+            return numHits;
+        }
+    }
+
+    void RunPhysicsBenchmarks()
+    {
+        Benchmark::ReportSection("Scene ray casts (" + ToString(NUM_RAYS) + " rays, " +
+            ToString(GRID_SIZE * GRID_SIZE) + " bodies)");
+
+        QueryBenchmarkWorld world;
+        Vector<PhysicsRayQuery> rays = CreateRays();
+
+        Vector<PhysicsQueryHit> singleHits(NUM_RAYS);
+        Vector<PhysicsBatchHit> batchHits(NUM_RAYS);
+
+        BenchmarkResult singleResult = Benchmark::Run("One rayTest per RayCast call", NUM_ITERATIONS, NUM_RAYS, [&]()
+        {
+            CastRaysOneByOne(world.World, rays, singleHits);
+        });
+
+        // Batches run on the calling thread, see BulletSceneQuery
+        BenchmarkResult batchResult = Benchmark::Run("RayCastBatch", NUM_ITERATIONS, NUM_RAYS, [&]()
+        {
+            BulletSceneQuery::RayCastBatch(world.World, rays.data(), NUM_RAYS, batchHits.data());
+        });
+
+        Benchmark::Report(singleResult);
+        Benchmark::Report(batchResult);
+        Benchmark::ReportSpeedup(singleResult, batchResult);
+
+        bool sameHits = true;
+        float maxError = 0.0f;
+        for (UINT32 i = 0; i < NUM_RAYS; i++)
+        {
+            // Every body has a single collider, which is listed for every hit
+            bool singleHit = !singleHits[i].HitCollidersRaw.empty();
+            sameHits &= singleHit == batchHits[i].HasHit;
+
+            if (singleHit && batchHits[i].HasHit)
+            {
+                maxError = std::max(maxError, singleHits[i].Point.Distance(batchHits[i].Point));
+                maxError = std::max(maxError, Math::Abs(singleHits[i].Distance - batchHits[i].Distance));
+            }
+        }
+
+        Benchmark::ReportCheck("Hits match one by one ray casts", sameHits && maxError < 1e-3f, maxError);
+
+        RunPileBenchmarks();
+    }
+}
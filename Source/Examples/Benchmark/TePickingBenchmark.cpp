@@ -0,0 +1,174 @@
+#include "TeBenchmark.h"
+#include "Mesh/TeMeshBvh.h"
+#include "Mesh/TeMeshData.h"
+#include "RenderAPI/TeSubMesh.h"
+#include "RenderAPI/TeVertexDataDesc.h"
+#include "Math/TeRay.h"
+
+#include <random>
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 GRID_SIZE = 128;
+        constexpr UINT32 NUM_RAYS = 1000;
+        constexpr UINT32 NUM_BRUTE_FORCE_ITERATIONS = 2;
+        constexpr UINT32 NUM_BVH_ITERATIONS = 200;
+
+        /** Noisy height field, split in two sub-meshes along its rows. */
+        SPtr<MeshData> CreateTerrain(Vector<SubMesh>& subMeshes)
+        {
+            SPtr<VertexDataDesc> vertexDesc = VertexDataDesc::Create();
+            vertexDesc->AddVertElem(VET_FLOAT3, VES_POSITION);
+
+            const UINT32 rowSize = GRID_SIZE + 1;
+            const UINT32 numIndices = GRID_SIZE * GRID_SIZE * 6;
+            SPtr<MeshData> meshData = te_shared_ptr_new<MeshData>(rowSize * rowSize, numIndices, vertexDesc);
+
+            std::mt19937 rng(4321);
+            std::uniform_real_distribution<float> heightDist(0.0f, 2.0f);
+
+            Vector3* positions = (Vector3*)meshData->GetElementData(VES_POSITION);
+            for (UINT32 z = 0; z < rowSize; z++)
+            {
+                for (UINT32 x = 0; x < rowSize; x++)
+                    positions[z * rowSize + x] = Vector3((float)x, heightDist(rng), (float)z);
+            }
+
+            UINT32* indices = meshData->GetIndices32();
+            for (UINT32 z = 0; z < GRID_SIZE; z++)
+            {
+                for (UINT32 x = 0; x < GRID_SIZE; x++)
+                {
+                    UINT32 i00 = z * rowSize + x;
+                    UINT32 i10 = i00 + rowSize;
+
+                    *indices++ = i00;
+                    *indices++ = i10;
+                    *indices++ = i10 + 1;
+                    *indices++ = i00;
+                    *indices++ = i10 + 1;
+                    *indices++ = i00 + 1;
+                }
+            }
+
+            subMeshes.clear();
+            subMeshes.push_back(SubMesh(0, numIndices / 2, DOT_TRIANGLE_LIST));
+            subMeshes.push_back(SubMesh(numIndices / 2, numIndices / 2, DOT_TRIANGLE_LIST));
+
+            return meshData;
+        }
+
+        /** Rays cast down at the terrain from above, some of them missing it. */
+        Vector<Ray> CreateRays()
+        {
+            std::mt19937 rng(8765);
+            std::uniform_real_distribution<float> posDist(-8.0f, (float)GRID_SIZE + 8.0f);
+            std::uniform_real_distribution<float> tiltDist(-0.5f, 0.5f);
+
+            Vector<Ray> rays(NUM_RAYS);
+            for (auto& ray : rays)
+            {
+                Vector3 origin(posDist(rng), 10.0f, posDist(rng));
+                Vector3 direction = Vector3::Normalize(Vector3(tiltDist(rng), -1.0f, tiltDist(rng)));
+                ray = Ray(origin, direction);
+            }
+
+            return rays;
+        }
+
+        /** Closest hit of a ray, found by testing every triangle of the mesh. */
+        bool RayCastBruteForce(const MeshData& meshData, const Vector<SubMesh>& subMeshes, const Ray& ray,
+            MeshRayHit& hit)
+        {
+            const Vector3* positions = (const Vector3*)meshData.GetElementData(VES_POSITION);
+            const UINT32* indices = meshData.GetIndices32();
+
+            bool found = false;
+            for (UINT32 subMeshIdx = 0; subMeshIdx < (UINT32)subMeshes.size(); subMeshIdx++)
+            {
+                const SubMesh& subMesh = subMeshes[subMeshIdx];
+                for (UINT32 i = subMesh.IndexOffset; i < subMesh.IndexOffset + subMesh.IndexCount; i += 3)
+                {
+                    const Vector3& a = positions[indices[i + 0]];
+                    const Vector3& b = positions[indices[i + 1]];
+                    const Vector3& c = positions[indices[i + 2]];
+
+                    std::pair<bool, float> result = ray.Intersects(a, b, c, (b - a).Cross(c - a));
+                    if (!result.first || (found && result.second >= hit.Distance))
+                        continue;
+
+                    found = true;
+                    hit.IndexOffset = i;
+                    hit.SubMeshIdx = subMeshIdx;
+                    hit.Distance = result.second;
+                }
+            }
+
+            return found;
+        }
+    }
+
+    void RunPickingBenchmarks()
+    {
+        Vector<SubMesh> subMeshes;
+        SPtr<MeshData> meshData = CreateTerrain(subMeshes);
+        const UINT32 numTriangles = meshData->GetNumIndices() / 3;
+
+        Benchmark::ReportSection("Mesh ray casts (" + ToString(NUM_RAYS) + " rays, " + ToString(numTriangles) +
+            " triangles)");
+
+        Vector<Ray> rays = CreateRays();
+
+        Vector<MeshRayHit> bruteForceHits(NUM_RAYS);
+        Vector<bool> bruteForceFound(NUM_RAYS);
+        BenchmarkResult bruteForceResult = Benchmark::Run("Every triangle per ray", NUM_BRUTE_FORCE_ITERATIONS, NUM_RAYS,
+            [&]()
+        {
+            for (UINT32 i = 0; i < NUM_RAYS; i++)
+                bruteForceFound[i] = RayCastBruteForce(*meshData, subMeshes, rays[i], bruteForceHits[i]);
+        });
+
+        SPtr<MeshBvh> bvh;
+        BenchmarkResult buildResult = Benchmark::Run("Build mesh BVH", 1, numTriangles, [&]()
+        {
+            bvh = te_shared_ptr_new<MeshBvh>(*meshData, subMeshes);
+        });
+
+        Vector<MeshRayHit> bvhHits(NUM_RAYS);
+        Vector<bool> bvhFound(NUM_RAYS);
+        BenchmarkResult bvhResult = Benchmark::Run("MeshBvh::RayCast", NUM_BVH_ITERATIONS, NUM_RAYS, [&]()
+        {
+            for (UINT32 i = 0; i < NUM_RAYS; i++)
+                bvhFound[i] = bvh->RayCast(rays[i], bvhHits[i]);
+        });
+
+        Benchmark::Report(bruteForceResult);
+        Benchmark::Report(buildResult);
+        Benchmark::Report(bvhResult);
+        Benchmark::ReportSpeedup(bruteForceResult, bvhResult);
+
+        // Rays hitting an edge shared by two triangles may report either, only the distance has to match
+        bool sameHits = bvh->GetNumTriangles() == numTriangles;
+        UINT32 numHits = 0;
+        float maxError = 0.0f;
+        for (UINT32 i = 0; i < NUM_RAYS; i++)
+        {
+            if (bruteForceFound[i] != bvhFound[i])
+            {
+                sameHits = false;
+                continue;
+            }
+
+            if (!bvhFound[i])
+                continue;
+
+            numHits++;
+            maxError = std::max(maxError, Math::Abs(bruteForceHits[i].Distance - bvhHits[i].Distance));
+        }
+
+        Benchmark::ReportCheck("Hits match every triangle (" + ToString(numHits) + " hits)",
+            sameHits && maxError < 1e-3f, maxError);
+    }
+}
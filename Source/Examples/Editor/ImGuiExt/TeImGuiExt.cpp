@@ -432,6 +432,13 @@ namespace te
         }
         ImGui::Separator();
 
+        // ClusterCulling
+        {
+            if (ImGuiExt::RenderOptionBool(cameraSettings->ClusterCulling, "##cluster_culling_option", "Cluster culling"))
+                hasChanged = true;
+        }
+        ImGui::Separator();
+
         // Skybox
         {
             if (ImGuiExt::RenderOptionBool(cameraSettings->EnableSkybox, "##skybox_option", "Enable skybox"))
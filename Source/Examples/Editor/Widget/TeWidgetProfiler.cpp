@@ -34,7 +34,7 @@ namespace te
 
             ImGui::PushID("Renderer Profiling ID");
             {
-                ImGui::BeginChild("Renderer Profiling Fields", ImVec2(ImGui::GetContentRegionAvail().x, 418.0f), true);
+                ImGui::BeginChild("Renderer Profiling Fields", ImVec2(ImGui::GetContentRegionAvail().x, 566.0f), true);
                 ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2{ 5.0f, 5.0f });
 
                 ImGui::Columns(2);
@@ -143,6 +143,54 @@ namespace te
 
                 ImGui::Separator();
 
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("Object Data Writes");
+                ImGui::NextColumn();
+                ImGui::Text("%s", ToString(sample.NumObjectDataWrites).c_str());
+                ImGui::NextColumn();
+
+                ImGui::Separator();
+
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("Object Data Uploads");
+                ImGui::NextColumn();
+                ImGui::Text("%s", ToString(sample.NumObjectDataUploads).c_str());
+                ImGui::NextColumn();
+
+                ImGui::Separator();
+
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("Object Data Uploaded");
+                ImGui::NextColumn();
+                ImGui::Text("%s", (ToString(sample.ObjectDataUploadedBytes / 1024) + " KB").c_str());
+                ImGui::NextColumn();
+
+                ImGui::Separator();
+
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("Transient Textures");
+                ImGui::NextColumn();
+                ImGui::Text("%s", ToString(sample.NumTransientTextures).c_str());
+                ImGui::NextColumn();
+
+                ImGui::Separator();
+
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("Transient Textures Memory");
+                ImGui::NextColumn();
+                ImGui::Text("%s", (ToString(sample.TransientTexturesMemory / (1024 * 1024)) + " MB").c_str());
+                ImGui::NextColumn();
+
+                ImGui::Separator();
+
+                ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
+                ImGui::Text("Transient Textures Unaliased");
+                ImGui::NextColumn();
+                ImGui::Text("%s", (ToString(sample.TransientTexturesDeclaredMemory / (1024 * 1024)) + " MB").c_str());
+                ImGui::NextColumn();
+
+                ImGui::Separator();
+
                 ImGui::SetColumnWidth(-1, ImGui::GetWindowContentRegionWidth() - 75.0f);
                 ImGui::Text("Num Res Created");
                 ImGui::NextColumn();
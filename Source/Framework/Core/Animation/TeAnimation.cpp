@@ -64,6 +64,10 @@ namespace te
     void AnimationProxy::Rebuild(const SPtr<Skeleton>& skeleton, const SkeletonMask& mask,
         Vector<AnimationClipInfo>& clipInfos, const Vector<AnimatedSceneObject>& sceneObjects)
     {
+        // Previously evaluated poses can't be interpolated with poses of a different skeleton
+        if (skeleton != _skeleton)
+            _numLODPoses = 0;
+
         _skeleton = skeleton;
         _skeletonMask = mask;
 
@@ -204,7 +208,12 @@ namespace te
             UINT32 sceneObjectIdsSize = _numSceneObjects * sizeof(AnimatedSceneObjectInfo);
             UINT32 sceneObjectTransformsSize = numBoneMappedSOs * sizeof(Matrix4);
 
-            UINT8* data = (UINT8*)te_allocate(layersSize + clipsSize + boneMappingSize + genericCurveOutputSize + sceneObjectIdsSize + sceneObjectTransformsSize);
+            // Matrix4 needs 16 byte alignment, so the transforms start on a 16 byte boundary
+            UINT32 sceneObjectTransformsOffset = layersSize + clipsSize + boneMappingSize + sceneObjectIdsSize;
+            sceneObjectTransformsOffset = (sceneObjectTransformsOffset + 15) & ~15u;
+
+            UINT8* data = (UINT8*)te_allocate(sceneObjectTransformsOffset + sceneObjectTransformsSize + genericCurveOutputSize);
+            UINT8* dataStart = data;
 
             _layers = (AnimationStateLayer*)data;
             memcpy(_layers, tempLayers.data(), layersSize);
@@ -222,11 +231,8 @@ namespace te
 
             data += boneMappingSize;
 
-            _genericCurveOutputs = (float*)data;
-            data += genericCurveOutputSize;
-
             _sceneObjectInfos = reinterpret_cast<AnimatedSceneObjectInfo*>(data);
-            data += sceneObjectIdsSize;
+            data = dataStart + sceneObjectTransformsOffset;
 
             _sceneObjectTransforms = (Matrix4*)data;
             for (UINT32 i = 0; i < numBoneMappedSOs; i++)
@@ -234,6 +240,9 @@ namespace te
 
             data += sceneObjectTransformsSize;
 
+            _genericCurveOutputs = (float*)data;
+            data += genericCurveOutputSize;
+
             UINT32 curLayerIdx = 0;
             UINT32 curStateIdx = 0;
 
@@ -460,6 +469,24 @@ namespace te
         }
     }
 
+    void AnimationProxy::UpdateLODs(const Vector<AnimationLOD>& lods, const SkeletonMask& mask)
+    {
+        _lods.resize(lods.size());
+        _lodNumBones.resize(lods.size());
+
+        UINT32 numBones = _skeleton != nullptr ? _skeleton->GetNumBones() : 0;
+        for (UINT32 i = 0; i < (UINT32)lods.size(); i++)
+        {
+            _lods[i].Distance = lods[i].Distance;
+            _lods[i].UpdateInterval = std::max(lods[i].UpdateInterval, 1U);
+            _lods[i].Mask = mask.Combine(lods[i].Mask);
+            _lodNumBones[i] = _lods[i].Mask.GetNumEnabled(numBones);
+        }
+
+        if (_lodIdx >= (UINT32)_lods.size())
+            _lodIdx = 0;
+    }
+
     void AnimationProxy::UpdateTime(const Vector<AnimationClipInfo>& clipInfos)
     {
         for (auto& clipInfo : clipInfos)
@@ -535,6 +562,17 @@ namespace te
         _dirty |= (UINT32)AnimDirtyStateFlag::Culling;
     }
 
+    void Animation::SetLODs(const Vector<AnimationLOD>& lods)
+    {
+        _lods = lods;
+        _dirty |= (UINT32)AnimDirtyStateFlag::LOD;
+    }
+
+    UINT32 Animation::GetCurrentLOD() const
+    {
+        return _animProxy->_lodIdx;
+    }
+
     void Animation::Play(const HAnimationClip& clip)
     {
         AnimationClipInfo* clipInfo = AddClip(clip, (UINT32)-1);
@@ -1126,6 +1164,11 @@ namespace te
             }
         }
 
+        // Masks of levels of detail depend on the skeleton and on the animation mask, so they are updated once the proxy
+        // has been rebuilt
+        if (_dirty & ((UINT32)AnimDirtyStateFlag::LOD | (UINT32)AnimDirtyStateFlag::All))
+            _animProxy->UpdateLODs(_lods, _skeletonMask);
+
         // Check if there are dirty transforms
         if (!didFullRebuild)
         {
@@ -1172,6 +1215,10 @@ namespace te
         if (_animProxy->_wasCulled)
             return;
 
+        // Animations evaluated at a reduced rate only have new data on updates they were evaluated on
+        if (!_animProxy->_lods.empty() && !_animProxy->_evaluateThisUpdate)
+            return;
+
         HSceneObject rootSO;
 
         // Write TRS animation results to relevant SceneObjects
@@ -1195,9 +1242,9 @@ namespace te
                 if (_animProxy->_skeletonPose.HasOverride[soInfo.BoneIdx])
                     continue;
 
-                Vector3 position = _animProxy->_skeletonPose.Positions[soInfo.BoneIdx];
-                Quaternion rotation = _animProxy->_skeletonPose.Rotations[soInfo.BoneIdx];
-                Vector3 scale = _animProxy->_skeletonPose.Scales[soInfo.BoneIdx];
+                Vector3 position = _animProxy->_skeletonPose.GetPosition(soInfo.BoneIdx);
+                Quaternion rotation = _animProxy->_skeletonPose.GetRotation(soInfo.BoneIdx);
+                Vector3 scale = _animProxy->_skeletonPose.GetScale(soInfo.BoneIdx);
 
                 const SPtr<Skeleton>& skeleton = _animProxy->_skeleton;
 
@@ -1213,16 +1260,16 @@ namespace te
                     while (parentBoneIdx != (UINT32)-1)
                     {
                         // Update rotation
-                        const Quaternion& parentOrientation = _animProxy->_skeletonPose.Rotations[parentBoneIdx];
+                        const Quaternion parentOrientation = _animProxy->_skeletonPose.GetRotation(parentBoneIdx);
                         rotation = parentOrientation * rotation;
 
                         // Update scale
-                        const Vector3& parentScale = _animProxy->_skeletonPose.Scales[parentBoneIdx];
+                        const Vector3 parentScale = _animProxy->_skeletonPose.GetScale(parentBoneIdx);
                         scale = parentScale * scale;
 
                         // Update position
                         position = parentOrientation.Rotate(parentScale * position);
-                        position += _animProxy->_skeletonPose.Positions[parentBoneIdx];
+                        position += _animProxy->_skeletonPose.GetPosition(parentBoneIdx);
 
                         parentBoneIdx = skeleton->GetBoneInfo(parentBoneIdx).Parent;
                     }
@@ -1268,13 +1315,13 @@ namespace te
             else
             {
                 if (!_animProxy->_sceneObjectPose.HasOverride[i * 3 + 0])
-                    so->SetPosition(_animProxy->_sceneObjectPose.Positions[i]);
+                    so->SetPosition(_animProxy->_sceneObjectPose.GetPosition(i));
 
                 if (!_animProxy->_sceneObjectPose.HasOverride[i * 3 + 1])
-                    so->SetRotation(_animProxy->_sceneObjectPose.Rotations[i]);
+                    so->SetRotation(_animProxy->_sceneObjectPose.GetRotation(i));
 
                 if (!_animProxy->_sceneObjectPose.HasOverride[i * 3 + 2])
-                    so->SetScale(_animProxy->_sceneObjectPose.Scales[i]);
+                    so->SetScale(_animProxy->_sceneObjectPose.GetScale(i));
             }
         }
 
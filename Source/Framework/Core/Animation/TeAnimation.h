@@ -45,7 +45,8 @@ namespace te
         Value = 1 << 0,
         Layout = 1 << 1,
         All = 1 << 2,
-        Culling = 1 << 3
+        Culling = 1 << 3,
+        LOD = 1 << 4
     };
 
     typedef UINT32 AnimDirtyState;
@@ -126,6 +127,31 @@ namespace te
         UINT32 Hash; /**< Hash value of the scene object's transform. */
     };
 
+    /**
+     * Describes a single level of detail of an Animation. Levels of detail are selected depending on the distance between
+     * the animation bounds and the closest camera, and allow distant animations to be evaluated less often and with fewer
+     * bones.
+     */
+    struct TE_CORE_EXPORT AnimationLOD
+    {
+        AnimationLOD() = default;
+
+        /** Distance from the closest camera at which this level of detail starts being used, in world units. */
+        float Distance = 0.0f;
+
+        /**
+         * Number of animation updates between two evaluations of the animation. 1 means the animation is evaluated on
+         * every update. Updates in between evaluations interpolate between the two last evaluated poses.
+         */
+        UINT32 UpdateInterval = 1;
+
+        /**
+         * Bones to skip when evaluating this level of detail (see SkeletonMaskBuilder::DisableLeafBones()). Skipped bones
+         * use their bind pose. Combined with the mask set through Animation::SetMask().
+         */
+        SkeletonMask Mask;
+    };
+
     /** Represents a copy of the Animation data for use specifically during animation update. */
     struct AnimationProxy
     {
@@ -188,6 +214,16 @@ namespace te
          */
         void UpdateTime(const Vector<AnimationClipInfo>& clipInfos);
 
+        /**
+         * Updates the levels of detail used by the proxy.
+         *
+         * @param[in]	lods	Levels of detail, sorted by increasing distance.
+         * @param[in]	mask	Mask set on the animation, combined with the mask of each level of detail.
+         *
+         * @note	Should be called from the sim thread when the caller is sure the animation thread is not using it.
+         */
+        void UpdateLODs(const Vector<AnimationLOD>& lods, const SkeletonMask& mask);
+
         /** Destroys all dynamically allocated objects. */
         void Clear();
 
@@ -206,6 +242,19 @@ namespace te
         AABox _bounds;
         bool _cullEnabled = true;
 
+        // Level of detail
+        Vector<AnimationLOD> _lods; /**< Masks include the animation mask. */
+        Vector<UINT32> _lodNumBones; /**< Number of bones evaluated by each level of detail. */
+        UINT32 _lodIdx = 0;
+        UINT32 _updatesSinceEvaluation = 0;
+        bool _evaluateThisUpdate = false;
+        /**
+         * Two last evaluated poses, decomposed in translation, rotation and scale per bone. Interpolated between when
+         * evaluations are skipped.
+         */
+        LocalSkeletonPose _lodPoses[2];
+        UINT32 _numLODPoses = 0;
+
         // Single frame sample
         AnimSampleStep _sampleStep = AnimSampleStep::None;
 
@@ -263,6 +312,19 @@ namespace te
         /** @copydoc SetCulling */
         bool GetCulling() const { return _cull; }
 
+        /**
+         * Sets levels of detail used for evaluating the animation, sorted by increasing distance. The distance is
+         * measured from the bounds provided in SetBounds() to the closest camera. Without levels of detail the animation
+         * is evaluated on every animation update, with all of its bones.
+         */
+        void SetLODs(const Vector<AnimationLOD>& lods);
+
+        /** @copydoc SetLODs */
+        const Vector<AnimationLOD>& GetLODs() const { return _lods; }
+
+        /** Returns the index of the level of detail the animation was last evaluated with. */
+        UINT32 GetCurrentLOD() const;
+
         /**
          * Plays the specified animation clip.
          *
@@ -450,6 +512,7 @@ namespace te
         float _defaultSpeed = 1.0f;
         AABox _bounds;
         bool _cull = true;
+        Vector<AnimationLOD> _lods;
 
         SPtr<Skeleton> _skeleton;
         SkeletonMask _skeletonMask;
@@ -10,6 +10,67 @@
 
 namespace te
 {
+    namespace
+    {
+        /**
+         * Interpolates between the two last evaluated poses of an animation evaluated at a reduced rate. Poses lag one
+         * evaluation behind, so that the interpolation always happens between two known poses and updates on which the
+         * animation is evaluated don't pop.
+         */
+        void InterpolateLODPoses(const AnimationProxy* anim, Matrix4* output)
+        {
+            UINT32 numBones = anim->_skeleton->GetNumBones();
+            const LocalSkeletonPose& prevPose = anim->_lodPoses[0];
+            const LocalSkeletonPose& curPose = anim->_lodPoses[1];
+
+            if (anim->_numLODPoses < 2)
+            {
+                for (UINT32 i = 0; i < numBones; i++)
+                    output[i] = Matrix4::TRS(curPose.GetPosition(i), curPose.GetRotation(i), curPose.GetScale(i));
+
+                return;
+            }
+
+            UINT32 interval = anim->_lods[anim->_lodIdx].UpdateInterval;
+            float t = Math::Min(anim->_updatesSinceEvaluation / (float)interval, 1.0f);
+
+            // Blending the matrices directly would shear and shrink rotated bones
+            for (UINT32 i = 0; i < numBones; i++)
+            {
+                Vector3 position = Vector3::Lerp(t, prevPose.GetPosition(i), curPose.GetPosition(i));
+                Quaternion rotation = Quaternion::Lerp(t, prevPose.GetRotation(i), curPose.GetRotation(i));
+                Vector3 scale = Vector3::Lerp(t, prevPose.GetScale(i), curPose.GetScale(i));
+
+                output[i] = Matrix4::TRS(position, rotation, scale);
+            }
+        }
+
+        /** Stores the pose evaluated for an animation with levels of detail as the most recent of its two last poses. */
+        void StoreLODPose(AnimationProxy* anim, const Matrix4* pose)
+        {
+            UINT32 numBones = anim->_skeleton->GetNumBones();
+
+            std::swap(anim->_lodPoses[0], anim->_lodPoses[1]);
+            if (anim->_lodPoses[1].NumBones != numBones)
+                anim->_lodPoses[1] = LocalSkeletonPose(numBones);
+
+            LocalSkeletonPose& curPose = anim->_lodPoses[1];
+            for (UINT32 i = 0; i < numBones; i++)
+            {
+                Vector3 position;
+                Quaternion rotation;
+                Vector3 scale;
+                pose[i].Decomposition(position, rotation, scale);
+
+                curPose.SetPosition(i, position);
+                curPose.SetRotation(i, rotation);
+                curPose.SetScale(i, scale);
+            }
+
+            anim->_numLODPoses = std::min(anim->_numLODPoses + 1, 2U);
+        }
+    }
+
     TE_MODULE_STATIC_MEMBER(AnimationManager)
 
     AnimationManager::AnimationManager()
@@ -74,8 +135,9 @@ namespace te
             _proxies.push_back(anim.second->_animProxy);
         }
 
-        // Build frustums for culling
+        // Build frustums for culling, and view origins for picking levels of detail
         _cullFrustums.clear();
+        _viewOrigins.clear();
 
         auto& allCameras = gSceneManager().GetAllCameras();
         for (auto& entry : allCameras)
@@ -97,6 +159,7 @@ namespace te
             }
 
             _cullFrustums.push_back(entry.second->GetWorldFrustum());
+            _viewOrigins.push_back(entry.second->GetTransform().GetPosition());
         }
 
         // Prepare the write buffer
@@ -111,11 +174,16 @@ namespace te
         _animData.Transforms.resize(totalNumBones);
         _animData.Infos.clear();
 
+        ScheduleEvaluations();
+
         UINT32 curBoneIdx = 0;
         for (auto& anim : _proxies)
         {
             UINT32 boneIdx = curBoneIdx;
-            EvaluateAnimation(anim.get(), boneIdx);
+            if (anim->_evaluateThisUpdate)
+                EvaluateAnimation(anim.get(), boneIdx);
+            else if (!anim->_wasCulled)
+                InterpolateAnimation(anim.get(), boneIdx);
 
             if (anim->_skeleton != nullptr)
                 curBoneIdx += anim->_skeleton->GetNumBones();
@@ -134,28 +202,6 @@ namespace te
 
     void AnimationManager::EvaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
     {
-        // Culling
-        if (anim->_cullEnabled)
-        {
-            bool isVisible = false;
-            for (auto& frustum : _cullFrustums)
-            {
-                if (frustum.Intersects(anim->_bounds))
-                {
-                    isVisible = true;
-                    break;
-                }
-            }
-
-            if (!isVisible)
-            {
-                anim->_wasCulled = true;
-                return;
-            }
-        }
-
-        anim->_wasCulled = false;
-
         EvaluatedAnimationData::AnimInfo animInfo;
         bool hasAnimInfo = false;
 
@@ -187,7 +233,17 @@ namespace te
             }
 
             // Animate bones
-            anim->_skeleton->GetPose(boneDst, anim->_skeletonPose, anim->_skeletonMask, anim->_layers, anim->_numLayers);
+            const SkeletonMask& mask = anim->_lods.empty() ? anim->_skeletonMask : anim->_lods[anim->_lodIdx].Mask;
+            anim->_skeleton->GetPose(boneDst, anim->_skeletonPose, mask, anim->_layers, anim->_numLayers);
+
+            // Keep the two last poses around, so updates on which the evaluation is skipped can interpolate between them
+            if (!anim->_lods.empty())
+            {
+                StoreLODPose(anim, boneDst);
+
+                if (anim->_lods[anim->_lodIdx].UpdateInterval > 1)
+                    InterpolateLODPoses(anim, boneDst);
+            }
 
             curBoneIdx += numBones;
             hasAnimInfo = true;
@@ -203,9 +259,9 @@ namespace te
         // Reset mapped SO transform
         for (UINT32 i = 0; i < anim->_sceneObjectPose.NumBones; i++)
         {
-            anim->_sceneObjectPose.Positions[i] = Vector3::ZERO;
-            anim->_sceneObjectPose.Rotations[i] = Quaternion::IDENTITY;
-            anim->_sceneObjectPose.Scales[i] = Vector3::ONE;
+            anim->_sceneObjectPose.SetPosition(i, Vector3::ZERO);
+            anim->_sceneObjectPose.SetRotation(i, Quaternion::IDENTITY);
+            anim->_sceneObjectPose.SetScale(i, Vector3::ONE);
         }
 
         // Update mapped scene objects
@@ -232,7 +288,7 @@ namespace te
                 if (curveIdx != (UINT32)-1)
                 {
                     const TAnimationCurve<Vector3>& curve = state.Curves->Position[curveIdx].Curve;
-                    anim->_sceneObjectPose.Positions[curveIdx] = curve.Evaluate(state.Time, false);
+                    anim->_sceneObjectPose.SetPosition(curveIdx, curve.Evaluate(state.Time, false));
                     anim->_sceneObjectPose.HasOverride[i * 3 + 0] = false;
                 }
             }
@@ -242,8 +298,10 @@ namespace te
                 if (curveIdx != (UINT32)-1)
                 {
                     const TAnimationCurve<Quaternion>& curve = state.Curves->Rotation[curveIdx].Curve;
-                    anim->_sceneObjectPose.Rotations[curveIdx] = curve.Evaluate(state.Time, false);
-                    anim->_sceneObjectPose.Rotations[curveIdx].Normalize();
+                    Quaternion rotation = curve.Evaluate(state.Time, false);
+                    rotation.Normalize();
+
+                    anim->_sceneObjectPose.SetRotation(curveIdx, rotation);
                     anim->_sceneObjectPose.HasOverride[i * 3 + 1] = false;
                 }
             }
@@ -253,7 +311,7 @@ namespace te
                 if (curveIdx != (UINT32)-1)
                 {
                     const TAnimationCurve<Vector3>& curve = state.Curves->Scale[curveIdx].Curve;
-                    anim->_sceneObjectPose.Scales[curveIdx] = curve.Evaluate(state.Time, false);
+                    anim->_sceneObjectPose.SetScale(curveIdx, curve.Evaluate(state.Time, false));
                     anim->_sceneObjectPose.HasOverride[i * 3 + 2] = false;
                 }
             }
@@ -279,6 +337,137 @@ namespace te
             _animData.Infos[anim->Id] = animInfo;
     }
 
+    bool AnimationManager::IsCulled(AnimationProxy* anim) const
+    {
+        if (!anim->_cullEnabled)
+            return false;
+
+        for (auto& frustum : _cullFrustums)
+        {
+            if (frustum.Intersects(anim->_bounds))
+                return false;
+        }
+
+        return true;
+    }
+
+    void AnimationManager::UpdateLOD(AnimationProxy* anim) const
+    {
+        float distance = 0.0f;
+        if (!_viewOrigins.empty())
+        {
+            Vector3 center = anim->_bounds.GetCenter();
+
+            distance = std::numeric_limits<float>::infinity();
+            for (auto& origin : _viewOrigins)
+                distance = std::min(distance, origin.Distance(center));
+
+            distance = std::max(0.0f, distance - anim->_bounds.GetRadius());
+        }
+
+        UINT32 lodIdx = 0;
+        for (UINT32 i = 1; i < (UINT32)anim->_lods.size(); i++)
+        {
+            if (distance >= anim->_lods[i].Distance)
+                lodIdx = i;
+        }
+
+        anim->_lodIdx = lodIdx;
+    }
+
+    void AnimationManager::ScheduleEvaluations()
+    {
+        _evaluationQueue.clear();
+
+        UINT32 numScheduledBones = 0;
+        for (auto& entry : _proxies)
+        {
+            AnimationProxy* anim = entry.get();
+            anim->_evaluateThisUpdate = false;
+            anim->_wasCulled = IsCulled(anim);
+
+            if (anim->_wasCulled)
+                continue;
+
+            // Animations without levels of detail are evaluated on every update
+            if (anim->_lods.empty() || anim->_skeleton == nullptr)
+            {
+                anim->_evaluateThisUpdate = true;
+
+                if (anim->_skeleton != nullptr)
+                    numScheduledBones += anim->_skeleton->GetNumBones();
+
+                continue;
+            }
+
+            UpdateLOD(anim);
+            anim->_updatesSinceEvaluation++;
+
+            bool isDue = anim->_numLODPoses == 0 || anim->_sampleStep != AnimSampleStep::None ||
+                anim->_updatesSinceEvaluation >= anim->_lods[anim->_lodIdx].UpdateInterval;
+
+            if (isDue)
+                _evaluationQueue.push_back(anim);
+        }
+
+        if (_boneBudget > 0)
+        {
+            // Animations that never had a pose evaluated come first, followed by the ones that are the most late
+            // relative to their update interval
+            auto getLateness = [](const AnimationProxy* anim)
+            {
+                if (anim->_numLODPoses == 0)
+                    return std::numeric_limits<float>::infinity();
+
+                return anim->_updatesSinceEvaluation / (float)anim->_lods[anim->_lodIdx].UpdateInterval;
+            };
+
+            std::stable_sort(_evaluationQueue.begin(), _evaluationQueue.end(),
+                [&getLateness](const AnimationProxy* lhs, const AnimationProxy* rhs)
+                {
+                    float lhsLateness = getLateness(lhs);
+                    float rhsLateness = getLateness(rhs);
+
+                    if (lhsLateness != rhsLateness)
+                        return lhsLateness > rhsLateness;
+
+                    return lhs->_lodIdx < rhs->_lodIdx;
+                });
+        }
+
+        for (auto& anim : _evaluationQueue)
+        {
+            UINT32 numBones = anim->_lodNumBones[anim->_lodIdx];
+
+            // Animations without a pose to show yet are always evaluated, only the ones that can fall back on their
+            // cached poses wait for the budget
+            bool withinBudget = anim->_numLODPoses == 0 || _boneBudget == 0 || numScheduledBones == 0 ||
+                numScheduledBones + numBones <= _boneBudget;
+            if (!withinBudget)
+                continue;
+
+            anim->_evaluateThisUpdate = true;
+            anim->_updatesSinceEvaluation = 0;
+            numScheduledBones += numBones;
+        }
+    }
+
+    void AnimationManager::InterpolateAnimation(AnimationProxy* anim, UINT32 boneIdx)
+    {
+        // Nothing to show until the animation was evaluated at least once
+        if (anim->_skeleton == nullptr || anim->_numLODPoses == 0)
+            return;
+
+        InterpolateLODPoses(anim, _animData.Transforms.data() + boneIdx);
+
+        EvaluatedAnimationData::AnimInfo animInfo;
+        animInfo.PoseInfos.AnimId = anim->Id;
+        animInfo.PoseInfos.StartIdx = boneIdx;
+        animInfo.PoseInfos.NumBones = anim->_skeleton->GetNumBones();
+
+        _animData.Infos[anim->Id] = animInfo;
+    }
+
     AnimationManager& gAnimationManager()
     {
         return AnimationManager::Instance();
@@ -75,6 +75,20 @@ namespace te
          */
         void SetUpdateRate(UINT32 fps);
 
+        /**
+         * Limits the number of bones evaluated during a single animation update. When more animations are due for
+         * evaluation than the budget allows, the ones that waited the longest relative to their update interval (see
+         * AnimationLOD) are evaluated first and the others keep interpolating their last poses until a later update.
+         *
+         * @param[in]	maxBones	Maximum number of bones to evaluate per update. 0 means no limit (default). At least
+         *							one animation is always evaluated per update, even if it exceeds the budget.
+         *							Animations that were never evaluated yet are evaluated regardless of the budget.
+         */
+        void SetBoneBudget(UINT32 maxBones) { _boneBudget = maxBones; }
+
+        /** @copydoc SetBoneBudget */
+        UINT32 GetBoneBudget() const { return _boneBudget; }
+
     private:
         friend class Animation;
 
@@ -95,6 +109,27 @@ namespace te
          */
         void EvaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
 
+        /** Checks if the animation is outside of all camera frustums and can be skipped. */
+        bool IsCulled(AnimationProxy* anim) const;
+
+        /** Picks the level of detail to evaluate the animation with, depending on its distance to the closest camera. */
+        void UpdateLOD(AnimationProxy* anim) const;
+
+        /**
+         * Marks which animations will be evaluated during this update, according to their level of detail and the bone
+         * budget.
+         */
+        void ScheduleEvaluations();
+
+        /**
+         * Writes the pose of an animation that is evaluated at a reduced rate, by interpolating between its two last
+         * evaluated poses.
+         *
+         * @param[in]	anim		Proxy representing the animation to write the pose for.
+         * @param[in]	boneIdx		Index in the output buffer in which to write bone transforms.
+         */
+        void InterpolateAnimation(AnimationProxy* anim, UINT32 boneIdx);
+
     private:
         UINT64 _nextId = 1;
         UnorderedMap<UINT64, Animation*> _animations;
@@ -106,8 +141,12 @@ namespace te
         float _lastAnimationDeltaTime = 0.0f;
         bool  _paused = false;
 
+        UINT32 _boneBudget = 0;
+
         Vector<SPtr<AnimationProxy>> _proxies;
         Vector<ConvexVolume> _cullFrustums;
+        Vector<Vector3> _viewOrigins;
+        Vector<AnimationProxy*> _evaluationQueue;
 
         // If we change a mesh (so a skeleton, animData info might be deprecated, we must update them)
         bool _animDataDirty = true;
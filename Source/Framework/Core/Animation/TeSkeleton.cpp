@@ -1,9 +1,9 @@
 #include "TeSkeleton.h"
 
 #include "Animation/TeAnimationClip.h"
+#include "Animation/TeSkeletonPoseKernels.h"
 #include "Utility/TeFrameAllocator.h"
-
-#include <functional>
+#include "Math/TeSIMD.h"
 
 namespace te
 { 
@@ -11,67 +11,87 @@ namespace te
         : NumBones(numBones)
     {
         const UINT32 overridesPerBone = individualOverride ? 3 : 1;
-
-        UINT32 elementSize = sizeof(Vector3) * 2 + sizeof(Quaternion) + sizeof(bool) * overridesPerBone;
-        UINT8* buffer = (UINT8*)te_allocate(elementSize * numBones);
-
-        Positions = (Vector3*)buffer;
-        buffer += sizeof(Vector3) * numBones;
-
-        Rotations = (Quaternion*)buffer;
-        buffer += sizeof(Quaternion) * numBones;
-
-        Scales = (Vector3*)buffer;
-        buffer += sizeof(Vector3) * numBones;
-
-        HasOverride = (bool*)buffer;
+        HasOverride = (bool*)Allocate(numBones, numBones, numBones, sizeof(bool) * overridesPerBone * numBones);
     }
 
     LocalSkeletonPose::LocalSkeletonPose(UINT32 numPos, UINT32 numRot, UINT32 numScale)
     {
-        UINT32 bufferSize = sizeof(Vector3) * numPos + sizeof(Quaternion) * numRot + sizeof(Vector3) * numScale;
-        UINT8* buffer = (UINT8*)te_allocate(bufferSize);
-
-        Positions = (Vector3*)buffer;
-        buffer += sizeof(Vector3) * numPos;
-
-        Rotations = (Quaternion*)buffer;
-        buffer += sizeof(Quaternion) * numRot;
-
-        Scales = (Vector3*)buffer;
+        Allocate(numPos, numRot, numScale, 0);
     }
 
     LocalSkeletonPose::LocalSkeletonPose(LocalSkeletonPose&& other) noexcept
-        : Positions{ std::exchange(other.Positions, nullptr) }
-        , Rotations{ std::exchange(other.Rotations, nullptr) }
-        , Scales{ std::exchange(other.Scales, nullptr) }
+        : Positions{ other.Positions[0], other.Positions[1], other.Positions[2] }
+        , Rotations{ other.Rotations[0], other.Rotations[1], other.Rotations[2], other.Rotations[3] }
+        , Scales{ other.Scales[0], other.Scales[1], other.Scales[2] }
         , HasOverride{ std::exchange(other.HasOverride, nullptr) }
         , NumBones(std::exchange(other.NumBones, 0))
-    { }
+        , Stride(std::exchange(other.Stride, 0))
+        , _buffer(std::exchange(other._buffer, nullptr))
+    {
+        for (auto& component : other.Positions) component = nullptr;
+        for (auto& component : other.Rotations) component = nullptr;
+        for (auto& component : other.Scales) component = nullptr;
+    }
 
     LocalSkeletonPose::~LocalSkeletonPose()
     {
-        if (Positions != nullptr)
-            te_free(Positions);
+        if (_buffer != nullptr)
+            te_free_aligned16(_buffer);
     }
 
     LocalSkeletonPose& LocalSkeletonPose::operator=(LocalSkeletonPose&& other) noexcept
     {
         if (this != &other)
         {
-            if (Positions != nullptr)
-                te_free(Positions);
+            if (_buffer != nullptr)
+                te_free_aligned16(_buffer);
+
+            for (UINT32 i = 0; i < 3; i++)
+            {
+                Positions[i] = std::exchange(other.Positions[i], nullptr);
+                Scales[i] = std::exchange(other.Scales[i], nullptr);
+            }
+
+            for (UINT32 i = 0; i < 4; i++)
+                Rotations[i] = std::exchange(other.Rotations[i], nullptr);
 
-            Positions = std::exchange(other.Positions, nullptr);
-            Rotations = std::exchange(other.Rotations, nullptr);
-            Scales = std::exchange(other.Scales, nullptr);
             HasOverride = std::exchange(other.HasOverride, nullptr);
             NumBones = std::exchange(other.NumBones, 0);
+            Stride = std::exchange(other.Stride, 0);
+            _buffer = std::exchange(other._buffer, nullptr);
         }
 
         return *this;
     }
 
+    UINT8* LocalSkeletonPose::Allocate(UINT32 numPos, UINT32 numRot, UINT32 numScale, UINT32 numExtraBytes)
+    {
+        // Every component array is padded to the SIMD width so kernels never need to handle a remainder, and so that
+        // each array starts on a 16 byte boundary
+        const UINT32 posStride = SIMD::AlignCount(numPos);
+        const UINT32 rotStride = SIMD::AlignCount(numRot);
+        const UINT32 scaleStride = SIMD::AlignCount(numScale);
+        Stride = std::max(posStride, std::max(rotStride, scaleStride));
+
+        UINT32 bufferSize = sizeof(float) * (posStride * 3 + rotStride * 4 + scaleStride * 3) + numExtraBytes;
+        if (bufferSize == 0)
+            return nullptr;
+
+        float* buffer = (float*)te_allocate_aligned16(bufferSize);
+        _buffer = buffer;
+
+        for (UINT32 i = 0; i < 3; i++, buffer += posStride)
+            Positions[i] = buffer;
+
+        for (UINT32 i = 0; i < 4; i++, buffer += rotStride)
+            Rotations[i] = buffer;
+
+        for (UINT32 i = 0; i < 3; i++, buffer += scaleStride)
+            Scales[i] = buffer;
+
+        return (UINT8*)buffer;
+    }
+
     Skeleton::Skeleton()
         : Serializable(TypeID_Core::TID_Skeleton)
     { }
@@ -82,6 +102,8 @@ namespace te
         , _boneTransforms(te_newN<Transform>(numBones))
         , _invBindPoses(te_newN<Matrix4>(numBones))
         , _bonesInfo(te_newN<SkeletonBoneInfo>(numBones))
+        , _sortedBones(te_newN<UINT32>(numBones))
+        , _sortedParents(te_newN<UINT32>(numBones))
     {
         bones[0].LocalTfrm.SetRotation(Quaternion::ZERO);
         //bones[1].LocalTfrm.SetRotation(Quaternion::ZERO);
@@ -93,6 +115,8 @@ namespace te
             _bonesInfo[i].Name = bones[i].Name;
             _bonesInfo[i].Parent = bones[i].Parent;
         }
+
+        SortBones();
     }
 
     Skeleton::~Skeleton()
@@ -105,6 +129,21 @@ namespace te
 
         if (_bonesInfo != nullptr)
             te_deleteN(_bonesInfo, _numBones);
+
+        if (_sortedBones != nullptr)
+            te_deleteN(_sortedBones, _numBones);
+
+        if (_sortedParents != nullptr)
+            te_deleteN(_sortedParents, _numBones);
+    }
+
+    void Skeleton::SortBones()
+    {
+        Vector<UINT32> parents(_numBones);
+        for (UINT32 i = 0; i < _numBones; i++)
+            parents[i] = _bonesInfo[i].Parent;
+
+        SkeletonPoseKernels::SortHierarchy(parents.data(), _numBones, _sortedBones, _sortedParents);
     }
 
     void Skeleton::GetPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask,
@@ -141,13 +180,35 @@ namespace te
     {
         assert(localPose.NumBones == _numBones);
 
-        for (UINT32 i = 0; i < _numBones; i++)
+        const UINT32 stride = localPose.Stride;
+        for (UINT32 i = 0; i < 3; i++)
         {
-            localPose.Positions[i] = Vector3::ZERO;
-            localPose.Rotations[i] = Quaternion::ZERO;
-            localPose.Scales[i] = Vector3::ONE;
+            std::fill(localPose.Positions[i], localPose.Positions[i] + stride, 0.0f);
+            std::fill(localPose.Scales[i], localPose.Scales[i] + stride, 1.0f);
         }
 
+        for (UINT32 i = 0; i < 4; i++)
+            std::fill(localPose.Rotations[i], localPose.Rotations[i] + stride, 0.0f);
+
+        // Curves are sampled one bone at a time (keyframe lookup can't be batched) into these arrays, which use the same
+        // layout as the pose, and are then blended into the pose by the SIMD kernels. Padding lanes keep a zero weight.
+        const UINT32 numScratchArrays = 3 + 4 + 3 + 3;
+        float* scratch = (float*)te_allocate_aligned16(sizeof(float) * stride * numScratchArrays);
+        memset(scratch, 0, sizeof(float) * stride * numScratchArrays);
+
+        float* samplePositions[3];
+        float* sampleRotations[4];
+        float* sampleScales[3];
+
+        float* scratchIter = scratch;
+        for (UINT32 i = 0; i < 3; i++, scratchIter += stride) samplePositions[i] = scratchIter;
+        for (UINT32 i = 0; i < 4; i++, scratchIter += stride) sampleRotations[i] = scratchIter;
+        for (UINT32 i = 0; i < 3; i++, scratchIter += stride) sampleScales[i] = scratchIter;
+
+        float* positionWeights = scratchIter; scratchIter += stride;
+        float* rotationWeights = scratchIter; scratchIter += stride;
+        float* scaleWeights = scratchIter;
+
         bool* hasAnimCurve = te_newN<bool>(_numBones);
         te_zero_out(hasAnimCurve, _numBones);
 
@@ -181,6 +242,10 @@ namespace te
 
                 for (UINT32 k = 0; k < _numBones; k++)
                 {
+                    positionWeights[k] = 0.0f;
+                    rotationWeights[k] = 0.0f;
+                    scaleWeights[k] = 0.0f;
+
                     if (!mask.IsEnabled(k))
                         continue;
 
@@ -189,7 +254,12 @@ namespace te
                     if (curveIdx != (UINT32)-1)
                     {
                         const TAnimationCurve<Vector3>& curve = state.Curves->Position[curveIdx].Curve;
-                        localPose.Positions[k] += curve.Evaluate(state.Time, false) * normWeight;
+                        Vector3 value = curve.Evaluate(state.Time, false);
+
+                        samplePositions[0][k] = value.x;
+                        samplePositions[1][k] = value.y;
+                        samplePositions[2][k] = value.z;
+                        positionWeights[k] = normWeight;
 
                         localPose.HasOverride[k] = false;
                         hasAnimCurve[k] = true;
@@ -199,48 +269,41 @@ namespace te
                     if (curveIdx != (UINT32)-1)
                     {
                         const TAnimationCurve<Vector3>& curve = state.Curves->Scale[curveIdx].Curve;
-                        localPose.Scales[k] *= curve.Evaluate(state.Time, false) * normWeight;
+                        Vector3 value = curve.Evaluate(state.Time, false);
+
+                        sampleScales[0][k] = value.x;
+                        sampleScales[1][k] = value.y;
+                        sampleScales[2][k] = value.z;
+                        scaleWeights[k] = normWeight;
 
                         localPose.HasOverride[k] = false;
                         hasAnimCurve[k] = true;
                     }
 
-                    if (layer.Additive)
-                    {
-                        curveIdx = mapping.Rotation;
-                        if (curveIdx != (UINT32)-1)
-                        {
-                            bool isAssigned = localPose.Rotations[k].w != 0.0f;
-                            if (!isAssigned)
-                                localPose.Rotations[k] = Quaternion::IDENTITY;
-
-                            const TAnimationCurve<Quaternion>& curve = state.Curves->Rotation[curveIdx].Curve;
-
-                            Quaternion value = curve.Evaluate(state.Time, false);
-                            value = Quaternion::Lerp(normWeight, Quaternion::IDENTITY, value);
-
-                            localPose.Rotations[k] *= value;
-                            localPose.HasOverride[k] = false;
-                            hasAnimCurve[k] = true;
-                        }
-                    }
-                    else
+                    curveIdx = mapping.Rotation;
+                    if (curveIdx != (UINT32)-1)
                     {
-                        curveIdx = mapping.Rotation;
-                        if (curveIdx != (UINT32)-1)
-                        {
-                            const TAnimationCurve<Quaternion>& curve = state.Curves->Rotation[curveIdx].Curve;
-                            Quaternion value = curve.Evaluate(state.Time, false) * normWeight;
-
-                            if (value.Dot(localPose.Rotations[k]) < 0.0f)
-                                value = -value;
-
-                            localPose.Rotations[k] += value;
-                            localPose.HasOverride[k] = false;
-                            hasAnimCurve[k] = true;
-                        }
+                        const TAnimationCurve<Quaternion>& curve = state.Curves->Rotation[curveIdx].Curve;
+                        Quaternion value = curve.Evaluate(state.Time, false);
+
+                        sampleRotations[0][k] = value.x;
+                        sampleRotations[1][k] = value.y;
+                        sampleRotations[2][k] = value.z;
+                        sampleRotations[3][k] = value.w;
+                        rotationWeights[k] = normWeight;
+
+                        localPose.HasOverride[k] = false;
+                        hasAnimCurve[k] = true;
                     }
                 }
+
+                SkeletonPoseKernels::BlendPositions(localPose.Positions, samplePositions, positionWeights, stride);
+                SkeletonPoseKernels::BlendScales(localPose.Scales, sampleScales, scaleWeights, stride);
+
+                if (layer.Additive)
+                    SkeletonPoseKernels::BlendRotationsAdditive(localPose.Rotations, sampleRotations, rotationWeights, stride);
+                else
+                    SkeletonPoseKernels::BlendRotations(localPose.Rotations, sampleRotations, rotationWeights, stride);
             }
         }
 
@@ -252,63 +315,22 @@ namespace te
                 if (hasAnimCurve[i])
                     continue;
 
-                localPose.Positions[i] = _boneTransforms[i].GetPosition();
-                localPose.Rotations[i] = _boneTransforms[i].GetRotation();
-                localPose.Scales[i] = _boneTransforms[i].GetScale();
+                localPose.SetPosition(i, _boneTransforms[i].GetPosition());
+                localPose.SetRotation(i, _boneTransforms[i].GetRotation());
+                localPose.SetScale(i, _boneTransforms[i].GetScale());
             }
         }
 
         // Calculate local pose matrices
-        UINT32 isGlobalBytes = sizeof(bool) * _numBones;
-        bool* isGlobal = (bool*)te_allocate(isGlobalBytes);
-        memset(isGlobal, 0, isGlobalBytes);
+        SkeletonPoseKernels::NormalizeRotations(localPose.Rotations, stride);
+        SkeletonPoseKernels::ComputeLocalTransforms(pose, localPose);
 
-        for (UINT32 i = 0; i < _numBones; i++)
-        {
-            bool isAssigned = localPose.Rotations[i].w != 0.0f;
-            if (!isAssigned)
-                localPose.Rotations[i] = Quaternion::IDENTITY;
-            else
-                localPose.Rotations[i].Normalize();
+        // Calculate global poses, bones are sorted so that parents (and overrides) always come before children
+        SkeletonPoseKernels::ComputeModelTransforms(pose, _sortedBones, _sortedParents, localPose.HasOverride, _numBones);
 
-            if (localPose.HasOverride[i])
-            {
-                isGlobal[i] = true;
-                continue;
-            }
-
-            pose[i] = Matrix4::TRS(localPose.Positions[i], localPose.Rotations[i], localPose.Scales[i]);
-        }
-
-        // Calculate global poses
-        // Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-        // always come before children, we no isGlobal check is needed.
-        std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
-        {
-            UINT32 parentBoneIdx = _bonesInfo[boneIdx].Parent;
-            if (parentBoneIdx == (UINT32)-1)
-            {
-                isGlobal[boneIdx] = true;
-                return;
-            }
-
-            if (!isGlobal[parentBoneIdx])
-                calcGlobal(parentBoneIdx);
-
-            pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-            isGlobal[boneIdx] = true;
-        };
-
-        for (UINT32 i = 0; i < _numBones; i++)
-        {
-            if (!isGlobal[i])
-                calcGlobal(i);
-        }
-
-        for (UINT32 i = 0; i < _numBones; i++)
-            pose[i] = pose[i] * _invBindPoses[i];
+        SkeletonPoseKernels::ApplyInvBindPoses(pose, _invBindPoses, _numBones);
 
-        te_delete(isGlobal);
+        te_free_aligned16(scratch);
         te_deleteN<bool>(hasAnimCurve, _numBones);
     }
 
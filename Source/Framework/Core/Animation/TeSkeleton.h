@@ -68,8 +68,11 @@ namespace te
      * Contains local translation, rotation and scale values for each bone in a skeleton, after being evaluated at a
      * specific time of an animation.  All values are stored in the same order as the bones in the skeleton they were
      * created by.
+     *
+     * Values are stored as structure of arrays: each component (e.g. position x) lives in its own contiguous array, padded
+     * to the SIMD width and 16 byte aligned, so poses can be blended several bones at a time.
      */
-    struct LocalSkeletonPose
+    struct TE_CORE_EXPORT LocalSkeletonPose
     {
         LocalSkeletonPose() = default;
         LocalSkeletonPose(UINT32 numBones, bool individualOverride = false);
@@ -81,11 +84,54 @@ namespace te
         LocalSkeletonPose& operator=(const LocalSkeletonPose& other) = delete;
         LocalSkeletonPose& operator=(LocalSkeletonPose&& other) noexcept;
 
-        Vector3* Positions = nullptr; /**< Local bone positions at specific animation time. */
-        Quaternion* Rotations = nullptr; /**< Local bone rotations at specific animation time. */
-        Vector3* Scales = nullptr; /**< Local bone scales at specific animation time. */
+        /** Returns the local position of the bone at the specified index. */
+        Vector3 GetPosition(UINT32 idx) const
+        {
+            return Vector3(Positions[0][idx], Positions[1][idx], Positions[2][idx]);
+        }
+
+        /** Sets the local position of the bone at the specified index. */
+        void SetPosition(UINT32 idx, const Vector3& value)
+        {
+            Positions[0][idx] = value.x; Positions[1][idx] = value.y; Positions[2][idx] = value.z;
+        }
+
+        /** Returns the local rotation of the bone at the specified index. */
+        Quaternion GetRotation(UINT32 idx) const
+        {
+            return Quaternion(Rotations[3][idx], Rotations[0][idx], Rotations[1][idx], Rotations[2][idx]);
+        }
+
+        /** Sets the local rotation of the bone at the specified index. */
+        void SetRotation(UINT32 idx, const Quaternion& value)
+        {
+            Rotations[0][idx] = value.x; Rotations[1][idx] = value.y; Rotations[2][idx] = value.z; Rotations[3][idx] = value.w;
+        }
+
+        /** Returns the local scale of the bone at the specified index. */
+        Vector3 GetScale(UINT32 idx) const
+        {
+            return Vector3(Scales[0][idx], Scales[1][idx], Scales[2][idx]);
+        }
+
+        /** Sets the local scale of the bone at the specified index. */
+        void SetScale(UINT32 idx, const Vector3& value)
+        {
+            Scales[0][idx] = value.x; Scales[1][idx] = value.y; Scales[2][idx] = value.z;
+        }
+
+        float* Positions[3] = { nullptr, nullptr, nullptr }; /**< Local bone positions at specific animation time, one array per component (x, y, z). */
+        float* Rotations[4] = { nullptr, nullptr, nullptr, nullptr }; /**< Local bone rotations at specific animation time, one array per component (x, y, z, w). */
+        float* Scales[3] = { nullptr, nullptr, nullptr }; /**< Local bone scales at specific animation time, one array per component (x, y, z). */
         bool* HasOverride = nullptr; /**< True if the bone transform was overriden externally (local pose was ignored). */
         UINT32 NumBones = 0; /**< Number of bones in the pose. */
+        UINT32 Stride = 0; /**< Number of elements allocated for each component array, padded to the SIMD width. */
+
+    private:
+        /** Allocates the component arrays. Returns the first byte after the component arrays. */
+        UINT8* Allocate(UINT32 numPos, UINT32 numRot, UINT32 numScale, UINT32 numExtraBytes);
+
+        void* _buffer = nullptr;
     };
 
     /** Contains internal information about a single bone in a Skeleton. */
@@ -171,9 +217,15 @@ namespace te
         Skeleton();
         Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+        /** Builds the bone evaluation order so that parents always come before their children. */
+        void SortBones();
+
         UINT32 _numBones = 0;
         Transform* _boneTransforms = nullptr;
         Matrix4* _invBindPoses = nullptr;
         SkeletonBoneInfo* _bonesInfo = nullptr;
+
+        UINT32* _sortedBones = nullptr; /**< Bone indices, sorted so that parents come before their children. */
+        UINT32* _sortedParents = nullptr; /**< Parent index of each bone in _sortedBones. */
     };
 }
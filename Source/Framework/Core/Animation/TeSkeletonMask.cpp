@@ -15,6 +15,29 @@ namespace te
         return !_isDisabled[boneIdx];
     }
 
+    UINT32 SkeletonMask::GetNumEnabled(UINT32 numBones) const
+    {
+        UINT32 numEnabled = 0;
+        for (UINT32 i = 0; i < numBones; i++)
+        {
+            if (IsEnabled(i))
+                numEnabled++;
+        }
+
+        return numEnabled;
+    }
+
+    SkeletonMask SkeletonMask::Combine(const SkeletonMask& other) const
+    {
+        SkeletonMask output;
+        output._isDisabled.resize(std::max(_isDisabled.size(), other._isDisabled.size()));
+
+        for (UINT32 i = 0; i < (UINT32)output._isDisabled.size(); i++)
+            output._isDisabled[i] = !IsEnabled(i) || !other.IsEnabled(i);
+
+        return output;
+    }
+
     SkeletonMaskBuilder::SkeletonMaskBuilder(const SPtr<Skeleton>& skeleton)
         : _skeleton(skeleton)
         , _mask(skeleton->GetNumBones())
@@ -32,4 +55,37 @@ namespace te
             }
         }
     }
+
+    void SkeletonMaskBuilder::DisableLeafBones(UINT32 numLevels)
+    {
+        UINT32 numBones = _skeleton->GetNumBones();
+
+        // Height of a bone is the length of the longest path from it to one of its leaf bones. Heights are propagated
+        // from children to parents until nothing changes, which takes as many passes as the skeleton is deep.
+        Vector<UINT32> heights(numBones, 0);
+
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (UINT32 i = 0; i < numBones; i++)
+            {
+                UINT32 parent = _skeleton->GetBoneInfo(i).Parent;
+                if (parent == (UINT32)-1 || heights[parent] > heights[i])
+                    continue;
+
+                heights[parent] = heights[i] + 1;
+                changed = true;
+            }
+        }
+
+        for (UINT32 i = 0; i < numBones; i++)
+        {
+            if (_skeleton->GetBoneInfo(i).Parent == (UINT32)-1)
+                continue;
+
+            if (heights[i] < numLevels)
+                _mask._isDisabled[i] = true;
+        }
+    }
 }
@@ -20,6 +20,15 @@ namespace te
          */
         bool IsEnabled(UINT32 boneIdx) const;
 
+        /** Returns the number of enabled bones, out of the first @p numBones bones. */
+        UINT32 GetNumEnabled(UINT32 numBones) const;
+
+        /**
+         * Returns a mask in which a bone is disabled if it is disabled in either this mask or @p other. Both masks must
+         * be tied to the same skeleton.
+         */
+        SkeletonMask Combine(const SkeletonMask& other) const;
+
     private:
         friend class SkeletonMaskBuilder;
 
@@ -35,7 +44,17 @@ namespace te
         /** Enables or disables a bone with the specified name. */
         void SetBoneState(const String& name, bool enabled);
 
-        /** Teturns the built skeleton mask. */
+        /**
+         * Disables bones close to the extremities of the skeleton (e.g. fingers or facial bones), which is useful for
+         * reducing the evaluation cost of distant animations.
+         *
+         * @param[in]	numLevels	Number of levels to disable, starting from the leaves. A bone is disabled if the
+         *							longest path from it to a leaf bone is shorter than this number. Root bones are never
+         *							disabled.
+         */
+        void DisableLeafBones(UINT32 numLevels);
+
+        /** Returns the built skeleton mask. */
         SkeletonMask GetMask() const { return _mask; }
 
     private:
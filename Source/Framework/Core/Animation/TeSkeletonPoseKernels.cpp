@@ -0,0 +1,281 @@
+#include "Animation/TeSkeletonPoseKernels.h"
+#include "Animation/TeSkeleton.h"
+#include "Math/TeSIMD.h"
+
+namespace te
+{
+    void SkeletonPoseKernels::BlendPositions(float* const* dst, const float* const* src, const float* weights, UINT32 count)
+    {
+        for (UINT32 i = 0; i < count; i += TE_SIMD_WIDTH)
+        {
+            SIMDFloat4 weight = SIMD::Load(weights + i);
+
+            for (UINT32 c = 0; c < 3; c++)
+            {
+                SIMDFloat4 value = SIMD::Mul(SIMD::Load(src[c] + i), weight);
+                SIMD::Store(dst[c] + i, SIMD::Add(SIMD::Load(dst[c] + i), value));
+            }
+        }
+    }
+
+    void SkeletonPoseKernels::BlendScales(float* const* dst, const float* const* src, const float* weights, UINT32 count)
+    {
+        const SIMDFloat4 zero = SIMD::Zero();
+
+        for (UINT32 i = 0; i < count; i += TE_SIMD_WIDTH)
+        {
+            SIMDFloat4 weight = SIMD::Load(weights + i);
+            SIMDFloat4 isAnimated = SIMD::CmpNeq(weight, zero);
+
+            for (UINT32 c = 0; c < 3; c++)
+            {
+                SIMDFloat4 current = SIMD::Load(dst[c] + i);
+                SIMDFloat4 value = SIMD::Mul(current, SIMD::Mul(SIMD::Load(src[c] + i), weight));
+
+                SIMD::Store(dst[c] + i, SIMD::Select(isAnimated, value, current));
+            }
+        }
+    }
+
+    void SkeletonPoseKernels::BlendRotations(float* const* dst, const float* const* src, const float* weights, UINT32 count)
+    {
+        const SIMDFloat4 zero = SIMD::Zero();
+
+        for (UINT32 i = 0; i < count; i += TE_SIMD_WIDTH)
+        {
+            SIMDFloat4 weight = SIMD::Load(weights + i);
+
+            SIMDFloat4 value[4];
+            SIMDFloat4 current[4];
+            SIMDFloat4 dot = zero;
+            for (UINT32 c = 0; c < 4; c++)
+            {
+                value[c] = SIMD::Mul(SIMD::Load(src[c] + i), weight);
+                current[c] = SIMD::Load(dst[c] + i);
+                dot = SIMD::Add(dot, SIMD::Mul(value[c], current[c]));
+            }
+
+            // Make sure we blend along the shortest path
+            SIMDFloat4 flip = SIMD::CmpLt(dot, zero);
+            for (UINT32 c = 0; c < 4; c++)
+            {
+                SIMDFloat4 oriented = SIMD::Select(flip, SIMD::Neg(value[c]), value[c]);
+                SIMD::Store(dst[c] + i, SIMD::Add(current[c], oriented));
+            }
+        }
+    }
+
+    void SkeletonPoseKernels::BlendRotationsAdditive(float* const* dst, const float* const* src, const float* weights,
+        UINT32 count)
+    {
+        const SIMDFloat4 zero = SIMD::Zero();
+        const SIMDFloat4 one = SIMD::Set(1.0f);
+        const SIMDFloat4 minusOne = SIMD::Set(-1.0f);
+        const SIMDFloat4 tolerance = SIMD::Set(1e-04f);
+
+        for (UINT32 i = 0; i < count; i += TE_SIMD_WIDTH)
+        {
+            SIMDFloat4 weight = SIMD::Load(weights + i);
+            SIMDFloat4 isAnimated = SIMD::CmpNeq(weight, zero);
+
+            // Rotations that were never assigned start from identity
+            SIMDFloat4 ax = SIMD::Load(dst[0] + i);
+            SIMDFloat4 ay = SIMD::Load(dst[1] + i);
+            SIMDFloat4 az = SIMD::Load(dst[2] + i);
+            SIMDFloat4 aw = SIMD::Load(dst[3] + i);
+
+            SIMDFloat4 isAssigned = SIMD::CmpNeq(aw, zero);
+            ax = SIMD::Select(isAssigned, ax, zero);
+            ay = SIMD::Select(isAssigned, ay, zero);
+            az = SIMD::Select(isAssigned, az, zero);
+            aw = SIMD::Select(isAssigned, aw, one);
+
+            // Lerp(weight, identity, value), see Quaternion::Lerp
+            SIMDFloat4 sx = SIMD::Load(src[0] + i);
+            SIMDFloat4 sy = SIMD::Load(src[1] + i);
+            SIMDFloat4 sz = SIMD::Load(src[2] + i);
+            SIMDFloat4 sw = SIMD::Load(src[3] + i);
+
+            SIMDFloat4 flip = SIMD::Select(SIMD::CmpGe(sw, zero), one, minusOne);
+            SIMDFloat4 invWeight = SIMD::Mul(flip, SIMD::Sub(one, weight));
+
+            SIMDFloat4 bx = SIMD::Mul(weight, sx);
+            SIMDFloat4 by = SIMD::Mul(weight, sy);
+            SIMDFloat4 bz = SIMD::Mul(weight, sz);
+            SIMDFloat4 bw = SIMD::Add(invWeight, SIMD::Mul(weight, sw));
+
+            SIMDFloat4 sqrdLen = SIMD::Add(SIMD::Add(SIMD::Mul(bx, bx), SIMD::Mul(by, by)),
+                SIMD::Add(SIMD::Mul(bz, bz), SIMD::Mul(bw, bw)));
+            SIMDFloat4 invLen = SIMD::Div(one, SIMD::Sqrt(sqrdLen));
+            invLen = SIMD::Select(SIMD::CmpGt(sqrdLen, tolerance), invLen, one);
+
+            bx = SIMD::Mul(bx, invLen);
+            by = SIMD::Mul(by, invLen);
+            bz = SIMD::Mul(bz, invLen);
+            bw = SIMD::Mul(bw, invLen);
+
+            // dst * lerped, see Quaternion::operator*=
+            SIMDFloat4 rw = SIMD::Sub(SIMD::Sub(SIMD::Mul(aw, bw), SIMD::Mul(ax, bx)), SIMD::Add(SIMD::Mul(ay, by), SIMD::Mul(az, bz)));
+            SIMDFloat4 rx = SIMD::Sub(SIMD::Add(SIMD::Add(SIMD::Mul(aw, bx), SIMD::Mul(ax, bw)), SIMD::Mul(ay, bz)), SIMD::Mul(az, by));
+            SIMDFloat4 ry = SIMD::Sub(SIMD::Add(SIMD::Add(SIMD::Mul(aw, by), SIMD::Mul(ay, bw)), SIMD::Mul(az, bx)), SIMD::Mul(ax, bz));
+            SIMDFloat4 rz = SIMD::Sub(SIMD::Add(SIMD::Add(SIMD::Mul(aw, bz), SIMD::Mul(az, bw)), SIMD::Mul(ax, by)), SIMD::Mul(ay, bx));
+
+            SIMD::Store(dst[0] + i, SIMD::Select(isAnimated, rx, SIMD::Load(dst[0] + i)));
+            SIMD::Store(dst[1] + i, SIMD::Select(isAnimated, ry, SIMD::Load(dst[1] + i)));
+            SIMD::Store(dst[2] + i, SIMD::Select(isAnimated, rz, SIMD::Load(dst[2] + i)));
+            SIMD::Store(dst[3] + i, SIMD::Select(isAnimated, rw, SIMD::Load(dst[3] + i)));
+        }
+    }
+
+    void SkeletonPoseKernels::NormalizeRotations(float* const* rotations, UINT32 count)
+    {
+        const SIMDFloat4 zero = SIMD::Zero();
+        const SIMDFloat4 one = SIMD::Set(1.0f);
+        const SIMDFloat4 tolerance = SIMD::Set(1e-04f * 1e-04f);
+
+        for (UINT32 i = 0; i < count; i += TE_SIMD_WIDTH)
+        {
+            SIMDFloat4 x = SIMD::Load(rotations[0] + i);
+            SIMDFloat4 y = SIMD::Load(rotations[1] + i);
+            SIMDFloat4 z = SIMD::Load(rotations[2] + i);
+            SIMDFloat4 w = SIMD::Load(rotations[3] + i);
+
+            SIMDFloat4 isAssigned = SIMD::CmpNeq(w, zero);
+
+            // See Quaternion::Normalize()
+            SIMDFloat4 len = SIMD::Sqrt(SIMD::Add(SIMD::Add(SIMD::Mul(x, x), SIMD::Mul(y, y)),
+                SIMD::Add(SIMD::Mul(z, z), SIMD::Mul(w, w))));
+            SIMDFloat4 invLen = SIMD::Select(SIMD::CmpGt(len, tolerance), SIMD::Div(one, len), one);
+
+            SIMD::Store(rotations[0] + i, SIMD::Select(isAssigned, SIMD::Mul(x, invLen), zero));
+            SIMD::Store(rotations[1] + i, SIMD::Select(isAssigned, SIMD::Mul(y, invLen), zero));
+            SIMD::Store(rotations[2] + i, SIMD::Select(isAssigned, SIMD::Mul(z, invLen), zero));
+            SIMD::Store(rotations[3] + i, SIMD::Select(isAssigned, SIMD::Mul(w, invLen), one));
+        }
+    }
+
+    void SkeletonPoseKernels::ComputeLocalTransforms(Matrix4* output, const LocalSkeletonPose& pose)
+    {
+        const SIMDFloat4 one = SIMD::Set(1.0f);
+
+        alignas(16) float rows[12][TE_SIMD_WIDTH];
+        for (UINT32 i = 0; i < pose.NumBones; i += TE_SIMD_WIDTH)
+        {
+            SIMDFloat4 x = SIMD::Load(pose.Rotations[0] + i);
+            SIMDFloat4 y = SIMD::Load(pose.Rotations[1] + i);
+            SIMDFloat4 z = SIMD::Load(pose.Rotations[2] + i);
+            SIMDFloat4 w = SIMD::Load(pose.Rotations[3] + i);
+
+            SIMDFloat4 sx = SIMD::Load(pose.Scales[0] + i);
+            SIMDFloat4 sy = SIMD::Load(pose.Scales[1] + i);
+            SIMDFloat4 sz = SIMD::Load(pose.Scales[2] + i);
+
+            // See Quaternion::ToRotationMatrix() and Matrix4::SetTRS()
+            SIMDFloat4 tx = SIMD::Add(x, x);
+            SIMDFloat4 ty = SIMD::Add(y, y);
+            SIMDFloat4 tz = SIMD::Add(z, z);
+            SIMDFloat4 twx = SIMD::Mul(tx, w);
+            SIMDFloat4 twy = SIMD::Mul(ty, w);
+            SIMDFloat4 twz = SIMD::Mul(tz, w);
+            SIMDFloat4 txx = SIMD::Mul(tx, x);
+            SIMDFloat4 txy = SIMD::Mul(ty, x);
+            SIMDFloat4 txz = SIMD::Mul(tz, x);
+            SIMDFloat4 tyy = SIMD::Mul(ty, y);
+            SIMDFloat4 tyz = SIMD::Mul(tz, y);
+            SIMDFloat4 tzz = SIMD::Mul(tz, z);
+
+            SIMD::Store(rows[0], SIMD::Mul(sx, SIMD::Sub(one, SIMD::Add(tyy, tzz))));
+            SIMD::Store(rows[1], SIMD::Mul(sy, SIMD::Sub(txy, twz)));
+            SIMD::Store(rows[2], SIMD::Mul(sz, SIMD::Add(txz, twy)));
+            SIMD::Store(rows[3], SIMD::Load(pose.Positions[0] + i));
+
+            SIMD::Store(rows[4], SIMD::Mul(sx, SIMD::Add(txy, twz)));
+            SIMD::Store(rows[5], SIMD::Mul(sy, SIMD::Sub(one, SIMD::Add(txx, tzz))));
+            SIMD::Store(rows[6], SIMD::Mul(sz, SIMD::Sub(tyz, twx)));
+            SIMD::Store(rows[7], SIMD::Load(pose.Positions[1] + i));
+
+            SIMD::Store(rows[8], SIMD::Mul(sx, SIMD::Sub(txz, twy)));
+            SIMD::Store(rows[9], SIMD::Mul(sy, SIMD::Add(tyz, twx)));
+            SIMD::Store(rows[10], SIMD::Mul(sz, SIMD::Sub(one, SIMD::Add(txx, tyy))));
+            SIMD::Store(rows[11], SIMD::Load(pose.Positions[2] + i));
+
+            UINT32 numLanes = std::min((UINT32)TE_SIMD_WIDTH, pose.NumBones - i);
+            for (UINT32 lane = 0; lane < numLanes; lane++)
+            {
+                if (pose.HasOverride[i + lane])
+                    continue;
+
+                output[i + lane] = Matrix4(
+                    rows[0][lane], rows[1][lane], rows[2][lane], rows[3][lane],
+                    rows[4][lane], rows[5][lane], rows[6][lane], rows[7][lane],
+                    rows[8][lane], rows[9][lane], rows[10][lane], rows[11][lane],
+                    0.0f, 0.0f, 0.0f, 1.0f);
+            }
+        }
+    }
+
+    void SkeletonPoseKernels::ComputeModelTransforms(Matrix4* transforms, const UINT32* order, const UINT32* parents,
+        const bool* hasOverride, UINT32 count)
+    {
+        for (UINT32 i = 0; i < count; i++)
+        {
+            UINT32 parentIdx = parents[i];
+            if (parentIdx == (UINT32)-1)
+                continue;
+
+            UINT32 boneIdx = order[i];
+            if (hasOverride != nullptr && hasOverride[boneIdx])
+                continue;
+
+            transforms[boneIdx] = transforms[parentIdx].ConcatenateAffine(transforms[boneIdx]);
+        }
+    }
+
+    void SkeletonPoseKernels::ApplyInvBindPoses(Matrix4* transforms, const Matrix4* invBindPoses, UINT32 count)
+    {
+        for (UINT32 i = 0; i < count; i++)
+            transforms[i] = transforms[i].ConcatenateAffine(invBindPoses[i]);
+    }
+
+    void SkeletonPoseKernels::SortHierarchy(const UINT32* parents, UINT32 count, UINT32* order, UINT32* sortedParents)
+    {
+        // Depth of each bone in the hierarchy. Sorting by depth guarantees parents always come before their children.
+        Vector<UINT32> depths(count, (UINT32)-1);
+        UINT32 maxDepth = 0;
+
+        for (UINT32 i = 0; i < count; i++)
+        {
+            UINT32 depth = 0;
+            UINT32 parentIdx = parents[i];
+            while (parentIdx != (UINT32)-1 && depth < count)
+            {
+                if (depths[parentIdx] != (UINT32)-1)
+                {
+                    depth += depths[parentIdx] + 1;
+                    break;
+                }
+
+                parentIdx = parents[parentIdx];
+                depth++;
+            }
+
+            depths[i] = depth;
+            maxDepth = std::max(maxDepth, depth);
+        }
+
+        // Counting sort, stable so siblings keep their original (memory) order
+        Vector<UINT32> offsets(maxDepth + 2, 0);
+        for (UINT32 i = 0; i < count; i++)
+            offsets[depths[i] + 1]++;
+
+        for (UINT32 i = 1; i < (UINT32)offsets.size(); i++)
+            offsets[i] += offsets[i - 1];
+
+        for (UINT32 i = 0; i < count; i++)
+        {
+            UINT32 dstIdx = offsets[depths[i]]++;
+            order[dstIdx] = i;
+            sortedParents[dstIdx] = parents[i];
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeMatrix4.h"
+
+namespace te
+{
+    struct LocalSkeletonPose;
+
+    /**
+     * Batched kernels used by Skeleton when evaluating poses. They operate on structure of arrays data (see
+     * LocalSkeletonPose) and process TE_SIMD_WIDTH bones at a time.
+     *
+     * @note	Unless specified otherwise, component arrays must be 16 byte aligned and @p count must be a multiple of
+     *			TE_SIMD_WIDTH (use LocalSkeletonPose::Stride).
+     */
+    class TE_CORE_EXPORT SkeletonPoseKernels
+    {
+    public:
+        /**
+         * Adds weighted positions to the accumulated ones: dst += src * weight.
+         *
+         * @param[in, out]	dst		Accumulated positions, one array per component (x, y, z).
+         * @param[in]		src		Sampled positions, one array per component (x, y, z).
+         * @param[in]		weights	Per bone weights. Bones with a zero weight are left untouched.
+         * @param[in]		count	Number of elements in each array.
+         */
+        static void BlendPositions(float* const* dst, const float* const* src, const float* weights, UINT32 count);
+
+        /** Multiplies the accumulated scales with weighted ones: dst *= src * weight. Bones with a zero weight are skipped. */
+        static void BlendScales(float* const* dst, const float* const* src, const float* weights, UINT32 count);
+
+        /**
+         * Accumulates weighted rotations for normalized lerp blending: each weighted rotation is flipped to the same
+         * hemisphere as the accumulated rotation before being added. Call NormalizeRotations() once all states have been
+         * accumulated. Arrays contain one entry per component (x, y, z, w).
+         */
+        static void BlendRotations(float* const* dst, const float* const* src, const float* weights, UINT32 count);
+
+        /**
+         * Applies rotations additively: dst = dst * lerp(weight, identity, src). Bones with a zero weight are skipped, and
+         * bones that were not assigned a rotation yet start from identity. Arrays contain one entry per component (x, y,
+         * z, w).
+         */
+        static void BlendRotationsAdditive(float* const* dst, const float* const* src, const float* weights, UINT32 count);
+
+        /** Normalizes accumulated rotations. Rotations that were never assigned (w is zero) are set to identity. */
+        static void NormalizeRotations(float* const* rotations, UINT32 count);
+
+        /**
+         * Builds a local TRS matrix for every bone in the pose, except for bones that have an override.
+         *
+         * @param[out]	output	Array of at least LocalSkeletonPose::NumBones matrices.
+         * @param[in]	pose	Pose to build the matrices from. Rotations must be normalized.
+         */
+        static void ComputeLocalTransforms(Matrix4* output, const LocalSkeletonPose& pose);
+
+        /**
+         * Transforms local bone matrices into model space by concatenating them with their parent's, in a single pass.
+         *
+         * @param[in, out]	transforms	Bone matrices, local on input and model space on output.
+         * @param[in]		order		Bone indices sorted so that parents always come before their children.
+         * @param[in]		parents		Parent index of each bone in @p order (-1 for root bones).
+         * @param[in]		hasOverride	Optional per bone flags. Overriden bones are considered to already be in model space.
+         * @param[in]		count		Number of bones. Doesn't have to be a multiple of the SIMD width.
+         */
+        static void ComputeModelTransforms(Matrix4* transforms, const UINT32* order, const UINT32* parents,
+            const bool* hasOverride, UINT32 count);
+
+        /**
+         * Transforms model space bone matrices into skinning matrices by appending the inverse bind pose of each bone.
+         * All matrices must be affine. @p count doesn't have to be a multiple of the SIMD width.
+         */
+        static void ApplyInvBindPoses(Matrix4* transforms, const Matrix4* invBindPoses, UINT32 count);
+
+        /**
+         * Sorts a bone hierarchy so that parents always come before their children, as required by
+         * ComputeModelTransforms(). Bones at the same depth keep their original order.
+         *
+         * @param[in]	parents			Parent index of each bone (-1 for root bones).
+         * @param[in]	count			Number of bones.
+         * @param[out]	order			Sorted bone indices. Must be able to hold @p count elements.
+         * @param[out]	sortedParents	Parent index of each bone in @p order. Must be able to hold @p count elements.
+         */
+        static void SortHierarchy(const UINT32* parents, UINT32 count, UINT32* order, UINT32* sortedParents);
+    };
+}
@@ -75,6 +75,7 @@ set (TE_CORE_INC_RENDERER
     "Core/Renderer/TeSkybox.h"
     "Core/Renderer/TeRendererUtility.h"
     "Core/Renderer/TeGpuResourcePool.h"
+    "Core/Renderer/TeBoneMatrixPalette.h"
     "Core/Renderer/TeRendererMaterialManager.h"
     "Core/Renderer/TeRendererMaterial.h"
     "Core/Renderer/TeDecal.h"
@@ -96,6 +97,7 @@ set (TE_CORE_SRC_RENDERER
     "Core/Renderer/TeSkybox.cpp"
     "Core/Renderer/TeRendererUtility.cpp"
     "Core/Renderer/TeGpuResourcePool.cpp"
+    "Core/Renderer/TeBoneMatrixPalette.cpp"
     "Core/Renderer/TeRendererMaterialManager.cpp"
     "Core/Renderer/TeDecal.cpp"
     "Core/Renderer/TeIBLUtility.cpp"
@@ -122,6 +124,7 @@ set (TE_CORE_INC_SCENE
     "Core/Scene/TeGameObjectHandle.h"
     "Core/Scene/TeGameObjectManager.h"
     "Core/Scene/TeSceneObject.h"
+    "Core/Scene/TeTransformHierarchy.h"
 )
 set (TE_CORE_SRC_SCENE
     "Core/Scene/TeSceneActor.cpp"
@@ -132,6 +135,7 @@ set (TE_CORE_SRC_SCENE
     "Core/Scene/TeGameObjectHandle.cpp"
     "Core/Scene/TeGameObjectManager.cpp"
     "Core/Scene/TeSceneObject.cpp"
+    "Core/Scene/TeTransformHierarchy.cpp"
 )
 
 set(TE_CORE_INC_PLATFORM
@@ -279,13 +283,21 @@ set (TE_CORE_SRC_IMAGE
 
 set (TE_CORE_INC_MESH
     "Core/Mesh/TeMesh.h"
+    "Core/Mesh/TeMeshBvh.h"
     "Core/Mesh/TeMeshData.h"
+    "Core/Mesh/TeMeshlet.h"
+    "Core/Mesh/TeMeshOptimizer.h"
+    "Core/Mesh/TeMeshSimplifier.h"
     "Core/Mesh/TeMeshUtility.h"
     "Core/Mesh/TeShapeMeshes3D.h"
 )
 set (TE_CORE_SRC_MESH
     "Core/Mesh/TeMesh.cpp"
+    "Core/Mesh/TeMeshBvh.cpp"
     "Core/Mesh/TeMeshData.cpp"
+    "Core/Mesh/TeMeshlet.cpp"
+    "Core/Mesh/TeMeshOptimizer.cpp"
+    "Core/Mesh/TeMeshSimplifier.cpp"
     "Core/Mesh/TeMeshUtility.cpp"
     "Core/Mesh/TeShapeMeshes3D.cpp"
 )
@@ -434,6 +446,7 @@ set (TE_CORE_INC_ANIMATION
     "Core/Animation/TeAnimationCurve.h"
     "Core/Animation/TeAnimationClip.h"
     "Core/Animation/TeAnimationUtility.h"
+    "Core/Animation/TeSkeletonPoseKernels.h"
 )
 set (TE_CORE_SRC_ANIMATION
     "Core/Animation/TeAnimation.cpp"
@@ -443,6 +456,7 @@ set (TE_CORE_SRC_ANIMATION
     "Core/Animation/TeAnimationCurve.cpp"
     "Core/Animation/TeAnimationClip.cpp"
     "Core/Animation/TeAnimationUtility.cpp"
+    "Core/Animation/TeSkeletonPoseKernels.cpp"
 )
 
 set (TE_CORE_INC_GUI
@@ -544,11 +558,13 @@ set (TE_CORE_SRC_PROFILING
 )
 
 set (TE_CORE_INC_PICKING
+    "Core/Picking/TeCpuPicking.h"
     "Core/Picking/TePicking.h"
     "Core/Picking/TePickingMat.h"
     "Core/Picking/TePickingUtils.h"
 )
 set (TE_CORE_SRC_PICKING
+    "Core/Picking/TeCpuPicking.cpp"
     "Core/Picking/TePicking.cpp"
     "Core/Picking/TePickingMat.cpp"
     "Core/Picking/TePickingUtils.cpp"
@@ -46,6 +46,16 @@ namespace te
         _lastPosition = worldPos;
     }
 
+    ComponentBatchUpdate CAudioListener::GetBatchUpdate() const
+    {
+        // The velocity only depends on the world position of the listener
+        ComponentBatchUpdate batchUpdate;
+        batchUpdate.UpdateAll = &Component::UpdateAll<CAudioListener>;
+        batchUpdate.Parallel = true;
+
+        return batchUpdate;
+    }
+
     void CAudioListener::OnEnabled()
     {
         RestoreInternal();
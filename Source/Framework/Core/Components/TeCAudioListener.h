@@ -33,6 +33,9 @@ namespace te
         /** @copydoc Component::Update */
         void Update() override;
 
+        /** @copydoc Component::GetBatchUpdate */
+        ComponentBatchUpdate GetBatchUpdate() const override;
+
         /** Returns the AudioListener implementation wrapped by this component. */
         AudioListener* GetInternal() const { return _internal.get(); }
 
@@ -208,6 +208,16 @@ namespace te
         _lastPosition = worldPos;
     }
 
+    ComponentBatchUpdate CAudioSource::GetBatchUpdate() const
+    {
+        // Only reads the world position of the scene object and writes the velocity
+        ComponentBatchUpdate batchUpdate;
+        batchUpdate.UpdateAll = &Component::UpdateAll<CAudioSource>;
+        batchUpdate.Parallel = true;
+
+        return batchUpdate;
+    }
+
     bool CAudioSource::Clone(const HComponent& c, const String& suffix)
     {
         if (c.Empty())
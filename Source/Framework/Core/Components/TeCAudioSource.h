@@ -33,6 +33,9 @@ namespace te
         /** @copydoc Component::Update */
         void Update() override;
 
+        /** @copydoc Component::GetBatchUpdate */
+        ComponentBatchUpdate GetBatchUpdate() const override;
+
         /** @copydoc AudioSource::SetClip */
         void SetClip(const HAudioClip& clip);
 
@@ -130,6 +130,16 @@ namespace te
         }
     }
 
+    ComponentBatchUpdate CCameraFlyer::GetBatchUpdate() const
+    {
+        // Reads input and moves its own scene object, which notifies other components, so stays on the main thread
+        ComponentBatchUpdate batchUpdate;
+        batchUpdate.UpdateAll = &Component::UpdateAll<CCameraFlyer>;
+        batchUpdate.Parallel = false;
+
+        return batchUpdate;
+    }
+
     bool CCameraFlyer::Clone(const HComponent& c, const String& suffix)
     {
         if (c.Empty())
@@ -23,6 +23,9 @@ namespace te
         /** Triggered once per frame. Allows the component to handle input and move. */
         void Update() override;
 
+        /** @copydoc Component::GetBatchUpdate */
+        ComponentBatchUpdate GetBatchUpdate() const override;
+
         /** Returns current pitch angle (for editor) */
         const Degree& GetPitch() const { return _pitch; }
 
@@ -261,6 +261,16 @@ namespace te
         _needsRedraw = needsRedraw;
     }
 
+    ComponentBatchUpdate CCameraUI::GetBatchUpdate() const
+    {
+        // Orbits the camera from input and toggles the cursor, which only works from the main thread
+        ComponentBatchUpdate batchUpdate;
+        batchUpdate.UpdateAll = &Component::UpdateAll<CCameraUI>;
+        batchUpdate.Parallel = false;
+
+        return batchUpdate;
+    }
+
     void CCameraUI::EnableInput(bool enable)
     {
         _inputEnabled = enable;
@@ -24,6 +24,9 @@ namespace te
         /** Triggered once per frame. Allows the component to handle input and move. */
         void Update() override;
 
+        /** @copydoc Component::GetBatchUpdate */
+        ComponentBatchUpdate GetBatchUpdate() const override;
+
         /** Enables or disables camera controls. */
         void EnableInput(bool enable);
 
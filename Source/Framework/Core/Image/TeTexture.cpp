@@ -88,6 +88,7 @@ namespace te
             }
         }
 
+        _contentVersion++;
         Resource::Initialize();
     }
 
@@ -111,6 +112,7 @@ namespace te
     void Texture::Unlock()
     {
         UnlockImpl();
+        _contentVersion++;
     }
 
     void Texture::Copy(const SPtr<Texture>& target, const TEXTURE_COPY_DESC& desc)
@@ -220,6 +222,7 @@ namespace te
         }
 
         CopyImpl(target, desc);
+        target->_contentVersion++;
     }
 
     void Texture::Clear(const Color& value, UINT32 mipLevel, UINT32 face, UINT32 queueIdx)
@@ -237,6 +240,7 @@ namespace te
         }
 
         ClearImpl(value, mipLevel, face, queueIdx);
+        _contentVersion++;
     }
 
     void Texture::ClearImpl(const Color& value, UINT32 mipLevel, UINT32 face, UINT32 queueIdx)
@@ -318,6 +322,7 @@ namespace te
         }
 
         WriteDataImpl(src, mipLevel, face, discardWholeBuffer, queueIdx);
+        _contentVersion++;
     }
 
     UINT32 Texture::CalculateSize() const
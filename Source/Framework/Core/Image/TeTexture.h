@@ -295,6 +295,12 @@ namespace te
         /** Calculates the size of the texture, in bytes. */
         UINT32 CalculateSize() const;
 
+        /**
+         * Returns a value incremented whenever the contents of the texture are written from the CPU, or copied to. Writes
+         * from the GPU (render targets, load-store textures) are not tracked.
+         */
+        UINT32 GetContentVersion() const { return _contentVersion; }
+
         /** Creates a new empty texture. */
         static HTexture Create(const TEXTURE_DESC& desc);
 
@@ -376,5 +382,6 @@ namespace te
         TextureProperties _properties;
         mutable SPtr<PixelData> _initData;
         Vector<SPtr<PixelData>> _CPUSubresourceData;
+        UINT32 _contentVersion = 0;
     };
 }
@@ -39,6 +39,13 @@ namespace te
         Vector<AnimationEvent> Events;
     };
 
+    /** Determines how the vertex attributes of an imported mesh are stored. */
+    enum class VertexPrecision
+    {
+        Full, /**< Every attribute is stored as 32-bit floats. */
+        Compact /**< Attributes are quantized to the compact layout of RendererMeshData::Compress(). */
+    };
+
     /** Contains import options you may use to control how is a Mesh imported. */
     class TE_CORE_EXPORT MeshImportOptions : public ImportOptions
     {
@@ -134,6 +141,57 @@ namespace te
          */
         bool ImportZPrepassMesh = false;
 
+        /**
+         * Number of levels of detail of the imported mesh, including the full detail mesh. Lower levels are generated by
+         * simplifying the previous level, and are stored in the index buffer of the mesh.
+         */
+        UINT32 LodCount = 1;
+
+        /** Fraction of the triangles of the previous level of detail each generated level tries to keep. */
+        float LodReduction = 0.5f;
+
+        /**
+         * Largest geometric error a generated level of detail may introduce, relative to the size of the mesh. A level
+         * stops simplifying before reaching LodReduction when it would go past this error.
+         */
+        float LodMaxError = 0.05f;
+
+        /**
+         * Screen size, relative to the height of the view, under which the first generated level of detail is used. The
+         * screen size is halved for each following level.
+         */
+        float LodScreenSize = 0.5f;
+
+        /**
+         * Reorders the triangles of each sub-mesh for the post-transform vertex cache and to reduce overdraw, and the
+         * vertices in the order the triangles use them.
+         */
+        bool OptimizeMesh = true;
+
+        /**
+         * Largest increase of the vertex cache miss ratio the overdraw optimization may cause in exchange for less
+         * overdraw. 1 only reorders triangles when it doesn't affect the vertex cache.
+         */
+        float OverdrawThreshold = 1.05f;
+
+        /**
+         * Splits every triangle list sub-mesh and level of detail into meshlets, small clusters of triangles the renderer
+         * can cull one by one against the view frustum and by their facing. See RenderSettings::ClusterCulling.
+         */
+        bool GenerateMeshlets = false;
+
+        /**
+         * Storage of the vertex attributes. Compact vertices take about a third of the memory and bandwidth of full
+         * precision ones, positions keep a precision of 1/65535th of the size of the mesh.
+         */
+        VertexPrecision Precision = VertexPrecision::Full;
+
+        /**
+         * Converts the meshes of the file, generates their tangents and transforms their instances on the worker threads
+         * of the task scheduler. The imported data is the same either way.
+         */
+        bool ParallelImport = true;
+
         /** Creates a new import options object that allows you to customize how are Meshs imported. */
         static SPtr<MeshImportOptions> Create();
     };
@@ -6,6 +6,7 @@
 #include "Renderer/TeIBLUtility.h"
 #include "Renderer/TeRendererUtility.h"
 #include "Renderer/TeGpuResourcePool.h"
+#include "Renderer/TeBoneMatrixPalette.h"
 
 namespace te
 {
@@ -15,6 +16,7 @@ namespace te
     {
         RendererUtility::StartUp();
         GpuResourcePool::StartUp();
+        BoneMatrixPalette::StartUp();
     }
 
     void RendererManager::OnShutDown()
@@ -24,6 +26,7 @@ namespace te
             renderer.second->Destroy();
         }
 
+        BoneMatrixPalette::ShutDown();
         GpuResourcePool::ShutDown();
         RendererUtility::ShutDown();
     }
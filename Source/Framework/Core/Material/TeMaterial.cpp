@@ -5,6 +5,9 @@
 #include "TeShaderVariation.h"
 #include "Image/TeTexture.h"
 #include "RenderAPI/TeSamplerState.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+#include "RenderAPI/TeGpuParamDesc.h"
+#include "RenderAPI/TeGpuPipelineParamInfo.h"
 #include "Resources/TeResourceHandle.h"
 #include "Resources/TeResourceManager.h"
 #include "Resources/TeBuiltinResources.h"
@@ -30,13 +33,7 @@ namespace te
     { }
 
     Material::~Material()
-    {
-        for (auto& param : _params)
-        {
-            if(param.second.Param)
-                te_deallocate(param.second.Param); //I's sure that types here are primitive or very simple type sush as Vector3
-        }
-    }
+    { }
 
     Material::Material(const HShader& shader, const ShaderVariation& variation, UINT32 id)
         : Material(id, variation)
@@ -96,30 +93,198 @@ namespace te
             for (auto& buffer : _buffers)
                 outputParams[idx]->SetBuffer(buffer.first, buffer.second);
 
-            for (auto& param : _params)
-            {
-                if(param.second.ProgramType == GpuProgramType::GPT_COUNT)
-                    outputParams[idx]->SetParam(param.first, param.second.Param, (UINT32)param.second.Size);
-                else
-                    outputParams[idx]->SetParam(param.second.ProgramType, param.first, param.second.Param, (UINT32)param.second.Size);
-            }  
+            WriteParams(*outputParams[idx]);
         }
     }
 
     void Material::SetGpuParam(SPtr<GpuParams> outparams)
     {
-        for (auto& param : _params)
+        WriteParams(*outparams);
+    }
+
+    UINT32 Material::GetParamHandle(const String& name, UINT32 size, GpuProgramType programType)
+    {
+        auto it = _paramHandles.find(name);
+        if (it == _paramHandles.end())
+        {
+            ParamData param;
+            param.Name = name;
+            param.Offset = (UINT32)_paramData.size();
+            param.Size = size;
+            param.Capacity = size;
+            param.ProgramType = programType;
+            param.WriteStamp = ++_paramWriteStamp;
+
+            _paramData.resize(_paramData.size() + size, 0);
+            _params.push_back(param);
+            _paramLayoutVersion++;
+
+            UINT32 handle = (UINT32)_params.size() - 1;
+            _paramHandles[name] = handle;
+
+            return handle;
+        }
+
+        ParamData& param = _params[it->second];
+        if (size > param.Capacity)
+        {
+            // The old space is left unused, parameters don't usually change type
+            param.Offset = (UINT32)_paramData.size();
+            param.Capacity = size;
+            _paramData.resize(_paramData.size() + size, 0);
+        }
+
+        if (param.Size != size)
+        {
+            param.Size = size;
+            param.WriteStamp = ++_paramWriteStamp;
+        }
+
+        if (param.ProgramType != programType)
+        {
+            param.ProgramType = programType;
+            _paramLayoutVersion++;
+        }
+
+        return it->second;
+    }
+
+    void Material::WriteParams(GpuParams& params)
+    {
+        if (_params.empty())
+            return;
+
+        const SPtr<GpuPipelineParamInfo>& paramInfo = params.GetParamInfo();
+        ParamBindings& bindings = _paramBindings[paramInfo.get()];
+
+        // A new pipeline info might have been allocated where a destroyed one used to be
+        if (bindings.ParamInfo.lock() != paramInfo || bindings.LayoutVersion != _paramLayoutVersion)
+        {
+            bindings.ParamInfo = paramInfo;
+            bindings.LayoutVersion = _paramLayoutVersion;
+            bindings.Locations.clear();
+            bindings.WrittenBlocks.clear();
+
+            for (UINT32 i = 0; i < (UINT32)_params.size(); i++)
+            {
+                const ParamData& param = _params[i];
+
+                for (UINT32 j = 0; j < GPT_COUNT; j++)
+                {
+                    if (param.ProgramType != GpuProgramType::GPT_COUNT && param.ProgramType != (GpuProgramType)j)
+                        continue;
+
+                    const SPtr<GpuParamDesc>& paramDescs = paramInfo->GetParamDesc((GpuProgramType)j);
+                    if (paramDescs == nullptr)
+                        continue;
+
+                    auto iterFind = paramDescs->Params.find(param.Name);
+                    if (iterFind == paramDescs->Params.end())
+                    {
+                        if (param.ProgramType != GpuProgramType::GPT_COUNT)
+                            TE_PRINT("GpuProgram {" + ToString(j) + "} does not have {" + param.Name + "} parameter");
+
+                        continue;
+                    }
+
+                    const GpuParamDataDesc& desc = iterFind->second;
+
+                    ParamLocation location;
+                    location.ParamIdx = i;
+                    location.Set = desc.ParamBlockSet;
+                    location.Slot = desc.ParamBlockSlot;
+                    location.Offset = desc.CpuMemOffset * sizeof(UINT32);
+                    location.ElementSize = desc.ElementSize * sizeof(UINT32);
+
+                    bindings.Locations.push_back(location);
+                }
+            }
+
+            std::sort(bindings.Locations.begin(), bindings.Locations.end(),
+                [](const ParamLocation& a, const ParamLocation& b) { return a.Set != b.Set ? a.Set < b.Set : a.Slot < b.Slot; });
+
+            // Forget the pipelines that don't exist anymore
+            for (auto it = _paramBindings.begin(); it != _paramBindings.end();)
+            {
+                if (it->second.ParamInfo.expired())
+                    it = _paramBindings.erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        // Values land in the CPU copy of the parameter blocks, which are uploaded once when bound. A block only receives
+        // the parameters set since it was last written
+        const Vector<ParamLocation>& locations = bindings.Locations;
+        for (size_t first = 0, last = 0; first < locations.size(); first = last)
         {
-            if (param.second.ProgramType == GpuProgramType::GPT_COUNT)
-                outparams->SetParam(param.first, param.second.Param, (UINT32)param.second.Size);
-            else
-                outparams->SetParam(param.second.ProgramType, param.first, param.second.Param, (UINT32)param.second.Size);
+            while (last < locations.size() && locations[last].Set == locations[first].Set &&
+                locations[last].Slot == locations[first].Slot)
+            {
+                last++;
+            }
+
+            SPtr<GpuParamBlockBuffer> paramBlock = params.GetParamBlockBuffer(locations[first].Set, locations[first].Slot);
+            if (paramBlock == nullptr)
+                continue;
+
+            auto iterFind = bindings.WrittenBlocks.find(paramBlock.get());
+            if (iterFind == bindings.WrittenBlocks.end())
+            {
+                // Forget the blocks that don't exist anymore, each time the number of blocks doubled
+                if (bindings.WrittenBlocks.size() >= bindings.WrittenBlocksPruneSize)
+                {
+                    for (auto it = bindings.WrittenBlocks.begin(); it != bindings.WrittenBlocks.end();)
+                    {
+                        if (it->second.Block.expired())
+                            it = bindings.WrittenBlocks.erase(it);
+                        else
+                            ++it;
+                    }
+
+                    bindings.WrittenBlocksPruneSize = std::max(bindings.WrittenBlocksPruneSize, bindings.WrittenBlocks.size() * 2);
+                }
+
+                iterFind = bindings.WrittenBlocks.emplace(paramBlock.get(), WrittenBlock()).first;
+            }
+
+            // A new block might have been allocated where a destroyed one used to be, and shared blocks might have been
+            // written by someone else since, in which case every parameter is written again
+            WrittenBlock& written = iterFind->second;
+            if (written.Block.lock() != paramBlock || written.BlockVersion != paramBlock->GetContentVersion())
+            {
+                written.Block = paramBlock;
+                written.WriteStamp = 0;
+            }
+            else if (written.WriteStamp == _paramWriteStamp)
+            {
+                continue;
+            }
+
+            for (size_t i = first; i < last; i++)
+            {
+                const ParamLocation& location = locations[i];
+                const ParamData& param = _params[location.ParamIdx];
+                if (param.WriteStamp <= written.WriteStamp)
+                    continue;
+
+                UINT32 size = std::min(location.ElementSize, param.Size);
+                paramBlock->Write(location.Offset, _paramData.data() + param.Offset, size);
+
+                // Set unused bytes to 0
+                if (size < location.ElementSize)
+                    paramBlock->ZeroOut(location.Offset + size, location.ElementSize - size);
+            }
+
+            written.WriteStamp = _paramWriteStamp;
+            written.BlockVersion = paramBlock->GetContentVersion();
         }
     }
 
     void Material::SetShader(const SPtr<Shader>& shader)
     {
         _shader = shader;
+        _contentVersion++;
 
         if(_shader)
             InitializeTechniques();
@@ -134,6 +299,7 @@ namespace te
     void Material::SetVariation(const ShaderVariation& variation)
     {
         _variation = variation;
+        _contentVersion++;
     }
 
     UINT32 Material::GetNumTechniques() const
@@ -485,6 +651,27 @@ namespace te
         return _samplerStates[name];
     }
 
+    bool Material::HashTextureContents(size_t& hash) const
+    {
+        if (!_loadStoreTextures.empty())
+            return false;
+
+        for (auto& entry : _textures)
+        {
+            const SPtr<Texture>& texture = entry.second->TextureElem;
+            if (!texture)
+                continue;
+
+            if (texture->GetProperties().GetUsage() & (TU_RENDERTARGET | TU_DEPTHSTENCIL | TU_LOADSTORE))
+                return false;
+
+            te_hash_combine(hash, texture.get());
+            te_hash_combine(hash, texture->GetContentVersion());
+        }
+
+        return true;
+    }
+
     void Material::SetTexture(const String& name, const HTexture& value, const TextureSurface& surface)
     {
         SetTexture(name, value.GetInternalPtr(), surface);
@@ -561,6 +748,7 @@ namespace te
 
     void Material::_markCoreDirty(MaterialDirtyFlags flags)
     {
+        _contentVersion++;
         MarkCoreDirty((UINT32)flags);
     }
 }
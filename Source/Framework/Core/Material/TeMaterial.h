@@ -545,22 +545,36 @@ namespace te
         /** @copydoc Material::SetLoadStoreTexture */
         void SetLoadStoreTexture(const String& name, const HTexture& value, const TextureSurface& surface = GpuParams::COMPLETE);
 
-        /** Assigns a value to an arbitrary constant buffer parameter. */
+        /**
+         * Returns a handle to the constant buffer parameter @p name, registering it if it is new. Setting a parameter
+         * through its handle is a plain copy into the parameter data of the material, without any lookup.
+         *
+         * @param[in]	name		Name of the parameter in the shader.
+         * @param[in]	size		Size of the values the parameter will be set with, in bytes.
+         * @param[in]	programType	GPU program the parameter belongs to, or GPT_COUNT for all the programs that have it.
+         */
+        UINT32 GetParamHandle(const String& name, UINT32 size, GpuProgramType programType = GpuProgramType::GPT_COUNT);
+
+        /** Assigns a value to the constant buffer parameter @p handle, returned by GetParamHandle(). */
         template <typename T>
-        void SetParam(const String& name, T& data, GpuProgramType programType = GpuProgramType::GPT_COUNT)
+        void SetParam(UINT32 handle, const T& data)
         {
-            ParamData param;
-            auto it = _params.find(name);
-
-            if (it != _params.end())
-                te_deallocate(it->second.Param);
+            ParamData& param = _params[handle];
+            assert(sizeof(T) <= param.Size && "Value larger than the size the parameter has been registered with.");
 
-            param.Param = te_allocate<T>(sizeof(T));
-            param.Size = sizeof(T);
-            param.ProgramType = programType;
-            memcpy(param.Param, &data, param.Size);
+            memcpy(_paramData.data() + param.Offset, &data, sizeof(T));
+            param.WriteStamp = ++_paramWriteStamp;
+            _contentVersion++;
+        }
 
-            _params[name] = param;
+        /**
+         * Assigns a value to an arbitrary constant buffer parameter. Looks the parameter up by name, use a handle for
+         * parameters set every frame.
+         */
+        template <typename T>
+        void SetParam(const String& name, const T& data, GpuProgramType programType = GpuProgramType::GPT_COUNT)
+        {
+            SetParam(GetParamHandle(name, sizeof(T), programType), data);
         }
 
         /* Create all gpu params for a set of passes related to the current technique */
@@ -569,7 +583,11 @@ namespace te
         /** Here you can set all properties for a given material */
         const MaterialProperties& GetProperties() { return _properties; }
 
-        /** ParamBlockBuffer are sometimes not currently set when creating gpuparams. So we give the ability to set manually gpu params */
+        /**
+         * ParamBlockBuffer are sometimes not currently set when creating gpuparams. So we give the ability to set manually
+         * gpu params. The parameters are only resolved by name the first time a given pipeline is seen, and a parameter
+         * block only receives the parameters set since it was last written.
+         */
         void SetGpuParam(SPtr<GpuParams> outparams);
 
         void SetProperties(const MaterialProperties& properties) 
@@ -600,6 +618,19 @@ namespace te
         /** Marks the contents of the sim thread object as dirty, causing it to sync with its core thread counterpart. */
         virtual void _markCoreDirty(MaterialDirtyFlags flags = MaterialDirtyFlags::Param);
 
+        /**
+         * Returns a value incremented whenever the material changes in a way that affects what it renders: shader,
+         * parameters, resources or properties.
+         */
+        UINT32 GetContentVersion() const { return _contentVersion; }
+
+        /**
+         * Combines the content versions of the textures bound to the material into @p hash. Returns false if one of them
+         * is written by the GPU (render target, depth buffer or load-store texture), its contents then changing without
+         * its version changing.
+         */
+        bool HashTextureContents(size_t& hash) const;
+
     protected:
         Material();
         Material(UINT32 id, const ShaderVariation& variation);
@@ -612,6 +643,12 @@ namespace te
          */
         void InitializeTechniques();
 
+        /**
+         * Writes the constant buffer parameters set since a parameter block bound to @p params was last written into that
+         * block. Blocks none of the parameters changed for are left untouched.
+         */
+        void WriteParams(GpuParams& params);
+
     protected:
         struct TextureData
         {
@@ -629,11 +666,46 @@ namespace te
             TextureSurface TextureSurfaceElem;
         };
 
+        /** Constant buffer parameter of the material, its value is stored in _paramData. */
         struct ParamData
         {
-            void* Param;
-            size_t Size;
+            String Name;
+            UINT32 Offset; /**< In bytes, in _paramData. */
+            UINT32 Size; /**< In bytes. */
+            UINT32 Capacity; /**< In bytes, space reserved in _paramData. */
             GpuProgramType ProgramType;
+            UINT64 WriteStamp = 0; /**< Value of _paramWriteStamp when the parameter was last set. */
+        };
+
+        /** Location of a constant buffer parameter of the material in the parameter blocks of a pipeline. */
+        struct ParamLocation
+        {
+            UINT32 ParamIdx;
+            UINT32 Set;
+            UINT32 Slot;
+            UINT32 Offset; /**< In bytes, in the parameter block. */
+            UINT32 ElementSize; /**< In bytes. */
+        };
+
+        /** Parameter block the constant buffer parameters of the material have been written into. */
+        struct WrittenBlock
+        {
+            WPtr<GpuParamBlockBuffer> Block;
+            UINT64 WriteStamp = 0; /**< Value of _paramWriteStamp when the block was last written. */
+            UINT32 BlockVersion = 0; /**< Content version of the block right after it was last written. */
+        };
+
+        /**
+         * Locations of all constant buffer parameters of the material in the parameter blocks of a pipeline, sorted by
+         * block, and the blocks they have been written into.
+         */
+        struct ParamBindings
+        {
+            WPtr<GpuPipelineParamInfo> ParamInfo;
+            UINT32 LayoutVersion = 0;
+            Vector<ParamLocation> Locations;
+            UnorderedMap<const GpuParamBlockBuffer*, WrittenBlock> WrittenBlocks;
+            size_t WrittenBlocksPruneSize = 16;
         };
 
     protected:
@@ -646,7 +718,18 @@ namespace te
         UnorderedMap<String, SPtr<TextureData>> _loadStoreTextures;
         UnorderedMap<String, SPtr<GpuBuffer>> _buffers;
         UnorderedMap<String, SPtr<SamplerState>> _samplerStates;
-        UnorderedMap<String, ParamData> _params;
+        Vector<ParamData> _params;
+        UnorderedMap<String, UINT32> _paramHandles;
+        Vector<UINT8> _paramData;
+
+        /** Incremented whenever a parameter is added or changes program, making the bindings resolve names again. */
+        UINT32 _paramLayoutVersion = 0;
+
+        /** Incremented whenever a parameter is set, tells which parameters a parameter block is missing. */
+        UINT64 _paramWriteStamp = 0;
+        UnorderedMap<const GpuPipelineParamInfo*, ParamBindings> _paramBindings;
+
+        UINT32 _contentVersion = 0;
 
         MaterialProperties _properties;
 
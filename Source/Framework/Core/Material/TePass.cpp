@@ -4,9 +4,31 @@
 #include "Resources/TeResourceHandle.h"
 #include "Resources/TeResourceManager.h"
 #include "Utility/TeDataStream.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
+    /** GPU programs of a pass compiled to bytecode for one variation, on the task scheduler or on the render thread. */
+    struct Pass::CompileJob
+    {
+        enum State
+        {
+            Queued,
+            Running,
+            Done
+        };
+
+        std::atomic<UINT32> JobState{ Queued };
+        ShaderVariation Variation;
+
+        /** Notified once JobState is Done. */
+        Mutex DoneMutex;
+        Signal DoneVar;
+
+        /** Program descriptors indexed by GpuProgramType. Programs without source are left empty. */
+        GPU_PROGRAM_DESC ProgramDescs[GPT_COUNT];
+    };
+
     Pass::Pass()
         : Serializable(TID_Pass)
     {
@@ -60,45 +82,38 @@ namespace te
 
     void Pass::CreatePipelineState(const ShaderVariation& variation)
     {
+        if (!_compileJob || !(_compileJob->Variation == variation))
+            _compileJob = CreateCompileJob(variation);
+
+        WaitCompileJob(*_compileJob);
+
+        // Programs are created from the bytecode compiled by the job, which is then no longer needed
+        SPtr<CompileJob> job = _compileJob;
+        _compileJob = nullptr;
+
         if (IsCompute())
         {
-            _data.ComputeProgramDesc.Variation = variation;
-            SPtr<GpuProgram> program = GpuProgram::Create(_data.ComputeProgramDesc);
+            SPtr<GpuProgram> program = GpuProgram::Create(job->ProgramDescs[GPT_COMPUTE_PROGRAM]);
             _computePipelineState = ComputePipelineState::Create(program);
         }
         else
         {
             GpuPipelineStateTypes::StateDescType desc;
 
-            if (!_data.VertexProgramDesc.Source.empty() && !desc.vertexProgram)
-            {
-                _data.VertexProgramDesc.Variation = variation;
-                desc.vertexProgram = GpuProgram::Create(_data.VertexProgramDesc);
-            }
+            if (!_data.VertexProgramDesc.Source.empty())
+                desc.vertexProgram = GpuProgram::Create(job->ProgramDescs[GPT_VERTEX_PROGRAM]);
 
-            if (!_data.PixelProgramDesc.Source.empty() && !desc.pixelProgram)
-            {
-                _data.PixelProgramDesc.Variation = variation;
-                desc.pixelProgram = GpuProgram::Create(_data.PixelProgramDesc);
-            }
+            if (!_data.PixelProgramDesc.Source.empty())
+                desc.pixelProgram = GpuProgram::Create(job->ProgramDescs[GPT_PIXEL_PROGRAM]);
 
-            if (!_data.GeometryProgramDesc.Source.empty() && !desc.geometryProgram)
-            {
-                _data.GeometryProgramDesc.Variation = variation;
-                desc.geometryProgram = GpuProgram::Create(_data.GeometryProgramDesc);
-            }
+            if (!_data.GeometryProgramDesc.Source.empty())
+                desc.geometryProgram = GpuProgram::Create(job->ProgramDescs[GPT_GEOMETRY_PROGRAM]);
 
-            if (!_data.HullProgramDesc.Source.empty() && !desc.hullProgram)
-            {
-                _data.HullProgramDesc.Variation = variation;
-                desc.hullProgram = GpuProgram::Create(_data.HullProgramDesc);
-            }
+            if (!_data.HullProgramDesc.Source.empty())
+                desc.hullProgram = GpuProgram::Create(job->ProgramDescs[GPT_HULL_PROGRAM]);
 
-            if (!_data.DomainProgramDesc.Source.empty() && !desc.domainProgram)
-            {
-                _data.DomainProgramDesc.Variation = variation;
-                desc.domainProgram = GpuProgram::Create(_data.DomainProgramDesc);
-            }
+            if (!_data.DomainProgramDesc.Source.empty())
+                desc.domainProgram = GpuProgram::Create(job->ProgramDescs[GPT_DOMAIN_PROGRAM]);
 
             desc.blendState = BlendState::Create(_data.BlendStateDesc);
             desc.rasterizerState = RasterizerState::Create(_data.RasterizerStateDesc);
@@ -111,11 +126,14 @@ namespace te
 
     void Pass::Compile(const ShaderVariation& variation, bool force)
     {
-        if ((_computePipelineState || _graphicsPipelineState) && !force)
+        if (IsCompiled() && !force)
             return; // Already compiled
 
         if (force) // if force is true, we update all GPU_PROGRAM_DESC source code
         {
+            // A job still compiling the previous sources is left to finish on its own
+            _compileJob = nullptr;
+
             UpdateGpuProgramDesc(_data.VertexProgramDesc);
             UpdateGpuProgramDesc(_data.PixelProgramDesc);
             UpdateGpuProgramDesc(_data.GeometryProgramDesc);
@@ -128,6 +146,90 @@ namespace te
         MarkCoreDirty();
     }
 
+    void Pass::CompileAsync(const ShaderVariation& variation)
+    {
+        if (IsCompiled())
+            return;
+
+        if (_compileJob && _compileJob->Variation == variation)
+            return;
+
+        SPtr<CompileJob> job = CreateCompileJob(variation);
+        _compileJob = job;
+
+        // The task only holds the job, the pass can go away while it runs
+        gTaskScheduler().AddTask(Task::Create("CompilePass", [job]() { TryRunCompileJob(*job); }));
+    }
+
+    bool Pass::IsCompiling() const
+    {
+        return _compileJob != nullptr && _compileJob->JobState.load(std::memory_order_acquire) != CompileJob::Done;
+    }
+
+    SPtr<Pass::CompileJob> Pass::CreateCompileJob(const ShaderVariation& variation)
+    {
+        GPU_PROGRAM_DESC* programDescs[GPT_COUNT] = {
+            &_data.VertexProgramDesc,
+            &_data.PixelProgramDesc,
+            &_data.GeometryProgramDesc,
+            &_data.DomainProgramDesc,
+            &_data.HullProgramDesc,
+            &_data.ComputeProgramDesc
+        };
+
+        SPtr<CompileJob> job = te_shared_ptr_new<CompileJob>();
+        job->Variation = variation;
+
+        for (UINT32 i = 0; i < GPT_COUNT; i++)
+        {
+            if (programDescs[i]->Source.empty())
+                continue;
+
+            if (IsCompute() != (i == GPT_COMPUTE_PROGRAM))
+                continue;
+
+            programDescs[i]->Variation = variation;
+            job->ProgramDescs[i] = *programDescs[i];
+        }
+
+        return job;
+    }
+
+    bool Pass::TryRunCompileJob(CompileJob& job)
+    {
+        UINT32 expected = CompileJob::Queued;
+        if (!job.JobState.compare_exchange_strong(expected, CompileJob::Running, std::memory_order_acq_rel))
+            return false;
+
+        gTaskScheduler().ParallelFor(0, GPT_COUNT, 1, [&job](UINT32 begin, UINT32 end)
+        {
+            for (UINT32 i = begin; i < end; i++)
+            {
+                GPU_PROGRAM_DESC& desc = job.ProgramDescs[i];
+                if (!desc.Source.empty())
+                    desc.Bytecode = GpuProgram::CompileBytecode(desc);
+            }
+        });
+
+        {
+            Lock lock(job.DoneMutex);
+            job.JobState.store(CompileJob::Done, std::memory_order_release);
+        }
+
+        job.DoneVar.notify_all();
+        return true;
+    }
+
+    void Pass::WaitCompileJob(CompileJob& job)
+    {
+        if (TryRunCompileJob(job))
+            return;
+
+        // Another thread compiles the programs, block until it is done instead of burning a core
+        Lock lock(job.DoneMutex);
+        job.DoneVar.wait(lock, [&job]() { return job.JobState.load(std::memory_order_acquire) == CompileJob::Done; });
+    }
+
     SPtr<Pass> Pass::Create(const PASS_DESC& desc)
     {
         Pass* newPass = new (te_allocate<Pass>()) Pass(desc);
@@ -85,6 +85,22 @@ namespace te
          */
         void Compile(const ShaderVariation& variation, bool force = false);
 
+        /**
+         * Queues the compilation of the GPU programs of the pass to the task scheduler and returns right away. Nothing is
+         * done if the pass is already compiled, or already compiling @p variation. The pipeline state is only created by
+         * the next call to Compile(), which picks up the compiled programs, or waits for them if they aren't done yet.
+         */
+        void CompileAsync(const ShaderVariation& variation);
+
+        /** Returns true once the pipeline state of the pass has been created. */
+        bool IsCompiled() const { return _graphicsPipelineState != nullptr || _computePipelineState != nullptr; }
+
+        /**
+         * Returns true while the GPU programs queued by CompileAsync() are still compiling. Once it returns false, Compile()
+         * only has to create the pipeline state from the compiled programs.
+         */
+        bool IsCompiling() const;
+
         /**	Creates a new empty pass. */
         static SPtr<Pass> Create(const PASS_DESC& desc);
 
@@ -97,10 +113,28 @@ namespace te
 
         void UpdateGpuProgramDesc(GPU_PROGRAM_DESC& desc);
 
+    private:
+        struct CompileJob;
+
+        /** Creates the job compiling the GPU programs of the pass for @p variation. */
+        SPtr<CompileJob> CreateCompileJob(const ShaderVariation& variation);
+
+        /**
+         * Compiles the GPU programs of @p job, one task per program, unless another thread already started it. Returns false
+         * in this case.
+         */
+        static bool TryRunCompileJob(CompileJob& job);
+
+        /** Returns once the GPU programs of @p job are compiled, compiling them on the calling thread if nobody did yet. */
+        static void WaitCompileJob(CompileJob& job);
+
     protected:
         PASS_DESC _data;
         SPtr<GraphicsPipelineState> _graphicsPipelineState;
         SPtr<ComputePipelineState> _computePipelineState;
         SPtr<GpuParams> _gpuParams;
+
+    private:
+        SPtr<CompileJob> _compileJob;
     };
 }
@@ -56,6 +56,34 @@ namespace te
             pass->Compile(_variation, force);
     }
 
+    void Technique::CompileAsync()
+    {
+        for (auto& pass : _passes)
+            pass->CompileAsync(_variation);
+    }
+
+    bool Technique::IsCompiled() const
+    {
+        for (auto& pass : _passes)
+        {
+            if (!pass->IsCompiled())
+                return false;
+        }
+
+        return true;
+    }
+
+    bool Technique::IsCompiling() const
+    {
+        for (auto& pass : _passes)
+        {
+            if (pass->IsCompiling())
+                return true;
+        }
+
+        return false;
+    }
+
     const SPtr<Pass> Technique::GetPass(UINT32 idx) const
     {
         if (idx >= (UINT32)_passes.size())
@@ -53,6 +53,15 @@ namespace te
         /** Compiles all the passes in a technique. @see Pass::compile. */
         void Compile(bool force = false);
 
+        /** Queues the compilation of all the passes in a technique to the task scheduler. @see Pass::CompileAsync. */
+        void CompileAsync();
+
+        /** Returns true once all the passes in the technique are compiled. */
+        bool IsCompiled() const;
+
+        /** Returns true while some passes in the technique are compiling in the background. @see Pass::IsCompiling. */
+        bool IsCompiling() const;
+
         /** Get shader language used by this technique */
         const String& GetLanguage() const { return _language; }
 
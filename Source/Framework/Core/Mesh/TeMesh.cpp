@@ -1,10 +1,12 @@
 #include "Mesh/TeMesh.h"
 #include "TeMeshData.h"
+#include "Mesh/TeMeshBvh.h"
 #include "RenderAPI/TeVertexData.h"
 #include "RenderAPI/TeIndexBuffer.h"
 #include "RenderAPI/TeVertexBuffer.h"
 #include "RenderAPI/TeVertexDataDesc.h"
 #include "Resources/TeResourceManager.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
@@ -31,6 +33,25 @@ namespace te
         _subMeshes = subMeshes;
     }
 
+    MeshProperties::MeshProperties(UINT32 numVertices, UINT32 numIndices, const Vector<SubMesh>& subMeshes,
+        const Vector<MeshLod>& lods)
+        : _numVertices(numVertices)
+        , _numIndices(numIndices)
+    {
+        _subMeshes = subMeshes;
+
+        for (auto& lod : lods)
+        {
+            if (lod.SubMeshes.size() != _subMeshes.size())
+            {
+                TE_DEBUG("Mesh level of detail ignored, its number of sub-meshes doesn't match the mesh");
+                continue;
+            }
+
+            _lods.push_back(lod);
+        }
+    }
+
     SubMesh* MeshProperties::GetSubMeshPtr(UINT32 subMeshIdx)
     {
         if (subMeshIdx >= _subMeshes.size())
@@ -52,6 +73,41 @@ namespace te
         return (UINT32)_subMeshes.size();
     }
 
+    SubMesh* MeshProperties::GetLodSubMeshPtr(UINT32 lod, UINT32 subMeshIdx)
+    {
+        if (lod == 0)
+            return GetSubMeshPtr(subMeshIdx);
+
+        if (lod > _lods.size() || subMeshIdx >= _lods[lod - 1].SubMeshes.size())
+            TE_ASSERT_ERROR(false, "Invalid level of detail (" + ToString(lod) + ") or sub-mesh index (" + ToString(subMeshIdx) + ")");
+
+        return &(_lods[lod - 1].SubMeshes[subMeshIdx]);
+    }
+
+    float MeshProperties::GetLodScreenSize(UINT32 lod) const
+    {
+        if (lod == 0 || lod > _lods.size())
+            return std::numeric_limits<float>::max();
+
+        return _lods[lod - 1].ScreenSize;
+    }
+
+    UINT32 MeshProperties::SelectLod(float screenSize, UINT32 currentLod, float hysteresis) const
+    {
+        UINT32 selectedLod = 0;
+
+        // Thresholds of the levels up to the current one are widened, and the others narrowed, so that the screen size
+        // needs to move away from a threshold before the level changes again
+        for (UINT32 i = 1; i <= (UINT32)_lods.size(); i++)
+        {
+            float threshold = _lods[i - 1].ScreenSize * (i <= currentLod ? 1.0f + hysteresis : 1.0f - hysteresis);
+            if (screenSize < threshold)
+                selectedLod = i;
+        }
+
+        return selectedLod;
+    }
+
     Mesh::Mesh()
         : Resource(TID_Mesh)
         , _properties(0, 0, DOT_TRIANGLE_LIST)
@@ -67,7 +123,7 @@ namespace te
 
     Mesh::Mesh(const MESH_DESC& desc, GpuDeviceFlags deviceMask)
         : Resource(TID_Mesh)
-        , _properties(desc.NumVertices, desc.NumIndices, desc.SubMeshes)
+        , _properties(desc.NumVertices, desc.NumIndices, desc.SubMeshes, desc.Lods)
         , _CPUData(nullptr)
         , _vertexData(nullptr)
         , _indexBuffer(nullptr)
@@ -81,7 +137,7 @@ namespace te
 
     Mesh::Mesh(const SPtr<MeshData>& initialMeshData, const MESH_DESC& desc, GpuDeviceFlags deviceMask)
         : Resource(TID_Mesh)
-        , _properties(initialMeshData->GetNumVertices(), initialMeshData->GetNumIndices(), desc.SubMeshes)
+        , _properties(initialMeshData->GetNumVertices(), initialMeshData->GetNumIndices(), desc.SubMeshes, desc.Lods)
         , _CPUData(initialMeshData)
         , _vertexData(nullptr)
         , _indexBuffer(nullptr)
@@ -164,6 +220,11 @@ namespace te
     {
         UINT32 numSubMeshes = _properties.GetNumSubMeshes();
         _properties._bounds = meshData.CalculateBounds();
+        _properties._positionScale = meshData.GetPositionScale();
+        _properties._positionBias = meshData.GetPositionBias();
+
+        const VertexElement* positionElement = meshData.GetVertexDesc()->GetElement(VES_POSITION);
+        _properties._compactVertices = positionElement != nullptr && positionElement->GetType() == VET_SHORT4_NORM;
 
         if (numSubMeshes == 1)
         {
@@ -172,11 +233,21 @@ namespace te
         }
         else
         {
-            for (UINT32 i = 0; i < numSubMeshes; i++)
+            // Each sub-mesh walks the whole vertex range, meshes with many of them are worth splitting across threads
+            gTaskScheduler().ParallelFor(0, numSubMeshes, 1, [&](UINT32 begin, UINT32 end)
             {
-                SubMesh* subMesh = _properties.GetSubMeshPtr(i);
-                subMesh->SubMeshBounds = meshData.CalculateBounds(subMesh->IndexOffset, subMesh->IndexCount);
-            }
+                for (UINT32 i = begin; i < end; i++)
+                {
+                    SubMesh* subMesh = _properties.GetSubMeshPtr(i);
+                    subMesh->SubMeshBounds = meshData.CalculateBounds(subMesh->IndexOffset, subMesh->IndexCount);
+                }
+            });
+        }
+
+        for (auto& lod : _properties._lods)
+        {
+            for (UINT32 i = 0; i < (UINT32)lod.SubMeshes.size(); i++)
+                lod.SubMeshes[i].SubMeshBounds = _properties.GetSubMeshPtr(i)->SubMeshBounds;
         }
     }
 
@@ -211,6 +282,9 @@ namespace te
         UINT8* src = meshData.GetData();
 
         memcpy(dest, src, meshData.GetSize());
+
+        Lock lock(_bvhMutex);
+        _bvh = nullptr;
     }
 
     void Mesh::CreateCPUBuffer()
@@ -226,6 +300,16 @@ namespace te
         return meshData;
     }
 
+    SPtr<MeshBvh> Mesh::GetBvh() const
+    {
+        Lock lock(_bvhMutex);
+
+        if (_bvh == nullptr && _CPUData != nullptr)
+            _bvh = te_shared_ptr_new<MeshBvh>(*_CPUData, _properties._subMeshes);
+
+        return _bvh;
+    }
+
     SPtr<VertexDataDesc> Mesh::GetVertexDesc() const
     {
         return _vertexDesc;
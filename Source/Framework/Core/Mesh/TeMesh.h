@@ -5,6 +5,7 @@
 #include "RenderAPI/TeCommonTypes.h"
 #include "RenderAPI/TeSubMesh.h"
 #include "Math/TeBounds.h"
+#include "Threading/TeThreading.h"
 
 namespace te
 {
@@ -26,6 +27,25 @@ namespace te
         MU_CPUCACHED = 0x1000
     };
 
+    /**
+     * Lower level of detail of a mesh. Levels of detail share the vertex buffer of the mesh and only use their own ranges
+     * of its index buffer.
+     */
+    struct TE_CORE_EXPORT MeshLod
+    {
+        /**
+         * Sub-meshes of this level of detail. Sub-mesh at index i replaces sub-mesh i of the full detail mesh and is
+         * rendered with its material, so both lists must have the same size.
+         */
+        Vector<SubMesh> SubMeshes;
+
+        /**
+         * Projected size of the mesh bounding sphere, relative to the height of the view, under which this level of detail
+         * is used.
+         */
+        float ScreenSize = 0.0f;
+    };
+
     /** Descriptor object used for creation of a new Mesh object. */
     struct TE_CORE_EXPORT MESH_DESC
     {
@@ -50,6 +70,9 @@ namespace te
          */
         Vector<SubMesh> SubMeshes;
 
+        /** Lower levels of detail of the mesh, from the most to the least detailed. Their indices must be in the mesh. */
+        Vector<MeshLod> Lods;
+
         /** Optimizes performance depending on planned usage of the mesh. */
         INT32 Usage = MU_STATIC;
 
@@ -75,6 +98,7 @@ namespace te
         MeshProperties();
         MeshProperties(UINT32 numVertices, UINT32 numIndices, DrawOperationType drawOp);
         MeshProperties(UINT32 numVertices, UINT32 numIndices, const Vector<SubMesh>& subMeshes);
+        MeshProperties(UINT32 numVertices, UINT32 numIndices, const Vector<SubMesh>& subMeshes, const Vector<MeshLod>& lods);
 
         /**
          * Retrieves a sub-mesh containing data used for rendering a certain portion of this mesh. If no sub-meshes are
@@ -88,6 +112,26 @@ namespace te
         /** Retrieves a total number of sub-meshes in this mesh. */
         UINT32 GetNumSubMeshes() const;
 
+        /** Returns the number of levels of detail of the mesh, including the full detail level 0. */
+        UINT32 GetNumLods() const { return 1 + (UINT32)_lods.size(); }
+
+        /** Retrieves a sub-mesh of a level of detail. Level 0 returns the sub-meshes of the mesh itself. */
+        SubMesh* GetLodSubMeshPtr(UINT32 lod, UINT32 subMeshIdx);
+
+        /** Returns the screen size under which a level of detail is used. Level 0 is always used above the others. */
+        float GetLodScreenSize(UINT32 lod) const;
+
+        /**
+         * Picks the level of detail to render the mesh with.
+         *
+         * @param[in]	screenSize		Projected size of the mesh bounding sphere, relative to the height of the view.
+         * @param[in]	currentLod		Level of detail the mesh was rendered with previously.
+         * @param[in]	hysteresis		Fraction of a threshold the screen size must go past before the level of detail
+         *								changes, which avoids switching back and forth around a threshold.
+         * @return						Level of detail in [0, GetNumLods()).
+         */
+        UINT32 SelectLod(float screenSize, UINT32 currentLod = 0, float hysteresis = 0.1f) const;
+
         /** Returns maximum number of vertices the mesh may store. */
         UINT32 GetNumVertices() const { return _numVertices; }
 
@@ -97,13 +141,29 @@ namespace te
         /** Returns bounds of the geometry contained in the vertex buffers for all sub-meshes. */
         const Bounds& GetBounds() const { return _bounds; }
 
+        /**
+         * Returns true if the vertices use the compact layout output by RendererMeshData::Compress(), which the vertex
+         * shaders need to decode.
+         */
+        bool HasCompactVertices() const { return _compactVertices; }
+
+        /** Returns the scale mapping quantized positions back to object space. @see MeshData::SetPositionQuantization */
+        const Vector3& GetPositionScale() const { return _positionScale; }
+
+        /** Returns the bias mapping quantized positions back to object space. @see MeshData::SetPositionQuantization */
+        const Vector3& GetPositionBias() const { return _positionBias; }
+
     protected:
         friend class Mesh;
 
         Vector<SubMesh> _subMeshes;
+        Vector<MeshLod> _lods;
         UINT32 _numVertices;
         UINT32 _numIndices;
         Bounds _bounds;
+        bool _compactVertices = false;
+        Vector3 _positionScale = Vector3::ONE;
+        Vector3 _positionBias = Vector3::ZERO;
     };
 
     /**
@@ -167,6 +227,16 @@ namespace te
          */
         SPtr<MeshData> GetCachedData() const { return _CPUData; }
 
+        /**
+         * Returns a bounding volume hierarchy over the triangles of the mesh, used for ray casts on the CPU. It is built
+         * from the data in system memory on first use and kept until that data changes. Meshes created from mesh data,
+         * as imported meshes are, keep that data. Returns null if the mesh was created empty without the MU_CPUCACHED
+         * usage.
+         *
+         * @note Thread safe.
+         */
+        SPtr<MeshBvh> GetBvh() const;
+
         /**
          * Called whenever this mesh starts being used on the GPU.
          * 
@@ -309,6 +379,8 @@ namespace te
         MeshProperties _properties;
 
         mutable SPtr<MeshData> _CPUData;
+        mutable SPtr<MeshBvh> _bvh;
+        mutable Mutex _bvhMutex;
 
         SPtr<VertexData> _vertexData;
         SPtr<IndexBuffer> _indexBuffer;
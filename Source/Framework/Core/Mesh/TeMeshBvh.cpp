@@ -0,0 +1,210 @@
+#include "Mesh/TeMeshBvh.h"
+#include "Mesh/TeMeshData.h"
+#include "Math/TeRay.h"
+#include "RenderAPI/TeSubMesh.h"
+#include "RenderAPI/TeVertexDataDesc.h"
+
+namespace te
+{
+    MeshBvh::MeshBvh(const MeshData& meshData, const Vector<SubMesh>& subMeshes)
+    {
+        const SPtr<VertexDataDesc>& vertexDesc = meshData.GetVertexDesc();
+        const VertexElement* positionElement = vertexDesc->GetElement(VES_POSITION);
+        if (positionElement == nullptr)
+            return;
+
+        const VertexElementType positionType = positionElement->GetType();
+        if (positionType != VET_FLOAT3 && positionType != VET_FLOAT4 && positionType != VET_SHORT4_NORM)
+            return;
+
+        const UINT8* positions = meshData.GetElementData(VES_POSITION, 0, positionElement->GetStreamIdx());
+        const UINT32 stride = vertexDesc->GetVertexStride(positionElement->GetStreamIdx());
+        const UINT32 numVertices = meshData.GetNumVertices();
+        const bool indices32 = meshData.GetIndexType() == IT_32BIT;
+        const UINT8* indices = indices32 ? (UINT8*)meshData.GetIndices32() : (UINT8*)meshData.GetIndices16();
+
+        auto ReadIndex = [&](UINT32 i)
+        {
+            return indices32 ? ((const UINT32*)indices)[i] : (UINT32)((const UINT16*)indices)[i];
+        };
+
+        Vector<Vector3> vertices;
+        Vector<UINT32> indexOffsets;
+        Vector<UINT32> triangleSubMeshes;
+        Vector<AABox> boxes;
+
+        for (UINT32 subMeshIdx = 0; subMeshIdx < (UINT32)subMeshes.size(); subMeshIdx++)
+        {
+            const SubMesh& subMesh = subMeshes[subMeshIdx];
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST)
+                continue;
+
+            const UINT32 indexEnd = std::min(subMesh.IndexOffset + subMesh.IndexCount, meshData.GetNumIndices());
+            for (UINT32 i = subMesh.IndexOffset; i + 2 < indexEnd; i += 3)
+            {
+                const UINT32 i0 = ReadIndex(i + 0);
+                const UINT32 i1 = ReadIndex(i + 1);
+                const UINT32 i2 = ReadIndex(i + 2);
+
+                if (i0 >= numVertices || i1 >= numVertices || i2 >= numVertices)
+                    continue;
+
+                const Vector3 p0 = meshData.ReadPosition(positions + i0 * stride, positionType);
+                const Vector3 p1 = meshData.ReadPosition(positions + i1 * stride, positionType);
+                const Vector3 p2 = meshData.ReadPosition(positions + i2 * stride, positionType);
+
+                vertices.push_back(p0);
+                vertices.push_back(p1);
+                vertices.push_back(p2);
+                indexOffsets.push_back(i);
+                triangleSubMeshes.push_back(subMeshIdx);
+                boxes.push_back(AABox(Vector3::Min(p0, Vector3::Min(p1, p2)), Vector3::Max(p0, Vector3::Max(p1, p2))));
+            }
+        }
+
+        Vector<UINT32> order;
+        _depth = Bvh::Build(boxes, MAX_LEAF_TRIANGLES, _nodes, order);
+
+        const UINT32 numTriangles = (UINT32)order.size();
+        _positions.resize(numTriangles * 3);
+        _indexOffsets.resize(numTriangles);
+        _subMeshes.resize(numTriangles);
+
+        for (UINT32 i = 0; i < numTriangles; i++)
+        {
+            const UINT32 triangle = order[i];
+
+            _positions[i * 3 + 0] = vertices[triangle * 3 + 0];
+            _positions[i * 3 + 1] = vertices[triangle * 3 + 1];
+            _positions[i * 3 + 2] = vertices[triangle * 3 + 2];
+            _indexOffsets[i] = indexOffsets[triangle];
+            _subMeshes[i] = triangleSubMeshes[triangle];
+        }
+    }
+
+    bool MeshBvh::RayCast(const Ray& ray, MeshRayHit& hit, float maxDistance) const
+    {
+        if (_indexOffsets.empty())
+            return false;
+
+        const Vector3& origin = ray.GetOrigin();
+        const Vector3& direction = ray.GetDirection();
+        const Vector3 invDir = Bvh::InverseDirection(direction);
+
+        float closest = maxDistance;
+        UINT32 closestTriangle = (UINT32)-1;
+        Vector2 closestBarycentrics = Vector2::ZERO;
+
+        // The nearest child is visited first, so at most one node per level waits on the stack
+        UINT32 localStack[64];
+        Vector<UINT32> heapStack;
+        UINT32* stack = localStack;
+        if (_depth >= 64)
+        {
+            heapStack.resize(_depth + 1);
+            stack = heapStack.data();
+        }
+
+        UINT32 stackSize = 0;
+        UINT32 nodeIdx = 0;
+
+        float rootDistance;
+        if (!Bvh::Intersects(_nodes[0], origin, invDir, closest, rootDistance))
+            return false;
+
+        while (true)
+        {
+            const BvhNode& node = _nodes[nodeIdx];
+
+            if (node.Count > 0)
+            {
+                for (UINT32 i = node.First; i < node.First + node.Count; i++)
+                {
+                    // Moller-Trumbore, both faces
+                    const Vector3& p0 = _positions[i * 3 + 0];
+                    const Vector3 edge1 = _positions[i * 3 + 1] - p0;
+                    const Vector3 edge2 = _positions[i * 3 + 2] - p0;
+
+                    const Vector3 p = direction.Cross(edge2);
+                    const float det = edge1.Dot(p);
+                    if (std::fabs(det) < 1e-20f)
+                        continue;
+
+                    const float invDet = 1.0f / det;
+                    const Vector3 s = origin - p0;
+                    const float u = s.Dot(p) * invDet;
+                    if (u < 0.0f || u > 1.0f)
+                        continue;
+
+                    const Vector3 q = s.Cross(edge1);
+                    const float v = direction.Dot(q) * invDet;
+                    if (v < 0.0f || u + v > 1.0f)
+                        continue;
+
+                    const float t = edge2.Dot(q) * invDet;
+                    if (t < 0.0f || t >= closest)
+                        continue;
+
+                    closest = t;
+                    closestTriangle = i;
+                    closestBarycentrics = Vector2(u, v);
+                }
+            }
+            else
+            {
+                float leftDistance, rightDistance;
+                const bool hitLeft = Bvh::Intersects(_nodes[node.First], origin, invDir, closest, leftDistance);
+                const bool hitRight = Bvh::Intersects(_nodes[node.First + 1], origin, invDir, closest, rightDistance);
+
+                if (hitLeft && hitRight)
+                {
+                    const bool leftFirst = leftDistance <= rightDistance;
+                    stack[stackSize++] = leftFirst ? node.First + 1 : node.First;
+                    nodeIdx = leftFirst ? node.First : node.First + 1;
+                    continue;
+                }
+
+                if (hitLeft || hitRight)
+                {
+                    nodeIdx = hitLeft ? node.First : node.First + 1;
+                    continue;
+                }
+            }
+
+            // Nodes waiting on the stack might be further than the closest hit found since they were pushed
+            bool found = false;
+            while (stackSize > 0)
+            {
+                nodeIdx = stack[--stackSize];
+
+                float distance;
+                if (Bvh::Intersects(_nodes[nodeIdx], origin, invDir, closest, distance))
+                {
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+                break;
+        }
+
+        if (closestTriangle == (UINT32)-1)
+            return false;
+
+        hit.IndexOffset = _indexOffsets[closestTriangle];
+        hit.SubMeshIdx = _subMeshes[closestTriangle];
+        hit.Distance = closest;
+        hit.Barycentrics = closestBarycentrics;
+
+        return true;
+    }
+
+    AABox MeshBvh::GetBounds() const
+    {
+        if (_nodes.empty() || _indexOffsets.empty())
+            return AABox(Vector3::ZERO, Vector3::ZERO);
+
+        return AABox(_nodes[0].Min, _nodes[0].Max);
+    }
+}
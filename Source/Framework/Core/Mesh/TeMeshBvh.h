@@ -0,0 +1,78 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeAABox.h"
+#include "Math/TeBvh.h"
+#include "Math/TeVector2.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    class Ray;
+
+    /** Closest triangle of a mesh hit by a ray. */
+    struct TE_CORE_EXPORT MeshRayHit
+    {
+        /** Offset of the first index of the triangle in the index buffer of the mesh. */
+        UINT32 IndexOffset = 0;
+
+        /** Index of the sub-mesh containing the triangle. */
+        UINT32 SubMeshIdx = 0;
+
+        /** Distance along the ray, in units of the length of its direction. */
+        float Distance = 0.0f;
+
+        /**
+         * Weights of the second and third vertices of the triangle at the hit position. The first vertex weighs
+         * 1 - x - y.
+         */
+        Vector2 Barycentrics = Vector2::ZERO;
+    };
+
+    /**
+     * Bounding volume hierarchy over the triangles of a mesh, to find the triangle under a ray without testing all of
+     * them. Triangle positions are copied in the order of the leaves, so a traversal reads them linearly.
+     */
+    class TE_CORE_EXPORT MeshBvh
+    {
+    public:
+        /** Maximum number of triangles in a leaf. */
+        static constexpr UINT32 MAX_LEAF_TRIANGLES = 4;
+
+        /** Builds the hierarchy over the triangle list sub-meshes of @p meshData, the others are ignored. */
+        MeshBvh(const MeshData& meshData, const Vector<SubMesh>& subMeshes);
+
+        /**
+         * Finds the closest triangle hit by a ray. Triangles are hit from both sides.
+         *
+         * @param[in]	ray			Ray in the space of the mesh. Its direction doesn't need to be normalized, distances
+         *							are measured in units of its length.
+         * @param[out]	hit			Closest hit, only written when a triangle is hit.
+         * @param[in]	maxDistance	Triangles further than this are ignored.
+         * @return					True if a triangle is hit.
+         */
+        bool RayCast(const Ray& ray, MeshRayHit& hit, float maxDistance = std::numeric_limits<float>::max()) const;
+
+        /** Returns the bounds of every triangle of the hierarchy. */
+        AABox GetBounds() const;
+
+        /** Returns the number of triangles in the hierarchy. */
+        UINT32 GetNumTriangles() const { return (UINT32)_indexOffsets.size(); }
+
+        /** Returns the number of nodes of the hierarchy. */
+        UINT32 GetNumNodes() const { return (UINT32)_nodes.size(); }
+
+    private:
+        Vector<BvhNode> _nodes;
+        UINT32 _depth = 0;
+
+        /** Three positions per triangle, in leaf order. */
+        Vector<Vector3> _positions;
+
+        /** Offset of the first index of each triangle in the mesh index buffer, in leaf order. */
+        Vector<UINT32> _indexOffsets;
+
+        /** Sub-mesh of each triangle, in leaf order. */
+        Vector<UINT32> _subMeshes;
+    };
+}
@@ -290,6 +290,22 @@ namespace te
         return _vertexData->GetVertexStride() * _numVertices;
     }
 
+    Vector3 MeshData::ReadPosition(const UINT8* data, VertexElementType type) const
+    {
+        if (type == VET_SHORT4_NORM)
+        {
+            const INT16* value = (const INT16*)data;
+            Vector3 position(
+                std::max(value[0] / 32767.0f, -1.0f),
+                std::max(value[1] / 32767.0f, -1.0f),
+                std::max(value[2] / 32767.0f, -1.0f));
+
+            return position * _positionScale + _positionBias;
+        }
+
+        return *(const Vector3*)data;
+    }
+
     Bounds MeshData::CalculateBounds(UINT32 indexOffset, UINT32 indexCount) const
     {
         TE_ASSERT_ERROR((indexCount + indexOffset <= _numIndices), "Trying to access an indice which is out of indices buffer");
@@ -305,7 +321,9 @@ namespace te
         {
             const VertexElement& curElement = vertexDesc->GetElement(i);
 
-            if (curElement.GetSemantic() != VES_POSITION || (curElement.GetType() != VET_FLOAT3 && curElement.GetType() != VET_FLOAT4))
+            VertexElementType positionType = curElement.GetType();
+            if (curElement.GetSemantic() != VES_POSITION || (positionType != VET_FLOAT3 && positionType != VET_FLOAT4 &&
+                positionType != VET_SHORT4_NORM))
                 continue;
 
             UINT8* verticesData = GetElementData(curElement.GetSemantic(), curElement.GetSemanticIdx(), curElement.GetStreamIdx());
@@ -320,7 +338,7 @@ namespace te
                     : *(UINT16*)(indicesData + indexStride * indexOffset);
 
                 treatedVertices[verticesIndex] = verticesIndex;
-                Vector3 curPosition = *(Vector3*)(verticesData + vertexStride * verticesIndex);
+                Vector3 curPosition = ReadPosition(verticesData + vertexStride * verticesIndex, positionType);
                 Vector3 accum = curPosition;
                 Vector3 min = curPosition;
                 Vector3 max = curPosition;
@@ -335,7 +353,7 @@ namespace te
                         continue; // We do not process a vertice twice
 
                     treatedVertices[verticesIndex] = true;
-                    curPosition = *(Vector3*)(verticesData + vertexStride * verticesIndex);
+                    curPosition = ReadPosition(verticesData + vertexStride * verticesIndex, positionType);
                     accum += curPosition;
                     min = Vector3::Min(min, curPosition);
                     max = Vector3::Max(max, curPosition); 
@@ -349,7 +367,7 @@ namespace te
                     if (!treatedVertices[j])
                         continue;
 
-                    curPosition = *(Vector3*)(verticesData + vertexStride * j);
+                    curPosition = ReadPosition(verticesData + vertexStride * j, positionType);
                     float dist = center.SquaredDistance(curPosition);
 
                     if (dist > radiusSqrd)
@@ -376,7 +394,9 @@ namespace te
         {
             const VertexElement& curElement = vertexDesc->GetElement(i);
 
-            if (curElement.GetSemantic() != VES_POSITION || (curElement.GetType() != VET_FLOAT3 && curElement.GetType() != VET_FLOAT4))
+            VertexElementType positionType = curElement.GetType();
+            if (curElement.GetSemantic() != VES_POSITION || (positionType != VET_FLOAT3 && positionType != VET_FLOAT4 &&
+                positionType != VET_SHORT4_NORM))
                 continue;
 
             UINT8* data = GetElementData(curElement.GetSemantic(), curElement.GetSemanticIdx(), curElement.GetStreamIdx());
@@ -384,7 +404,7 @@ namespace te
 
             if (GetNumVertices() > 0)
             {
-                Vector3 curPosition = *(Vector3*)data;
+                Vector3 curPosition = ReadPosition(data, positionType);
                 Vector3 accum = curPosition;
                 Vector3 min = curPosition;
                 Vector3 max = curPosition;
@@ -392,7 +412,7 @@ namespace te
 
                 for (UINT32 j = 1; j < numVertices; j++)
                 {
-                    curPosition = *(Vector3*)(data + stride * j);
+                    curPosition = ReadPosition(data + stride * j, positionType);
                     accum += curPosition;
                     min = Vector3::Min(min, curPosition);
                     max = Vector3::Max(max, curPosition);
@@ -403,7 +423,7 @@ namespace te
 
                 for (UINT32 j = 0; j < numVertices; j++)
                 {
-                    curPosition = *(Vector3*)(data + stride * j);
+                    curPosition = ReadPosition(data + stride * j, positionType);
                     float dist = center.SquaredDistance(curPosition);
 
                     if (dist > radiusSqrd)
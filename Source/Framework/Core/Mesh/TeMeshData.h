@@ -121,6 +121,18 @@ namespace te
         /**	Return the size (in bytes) of the entire buffer. */
         UINT32 GetSize() const { return GetInternalBufferSize(); }
 
+        /**
+         * Sets how quantized positions (VET_SHORT4_NORM) map back to object space: position = value * scale + bias. Has
+         * no effect on positions stored as floats.
+         */
+        void SetPositionQuantization(const Vector3& scale, const Vector3& bias) { _positionScale = scale; _positionBias = bias; }
+
+        /** Returns the scale applied to quantized positions. @see SetPositionQuantization */
+        const Vector3& GetPositionScale() const { return _positionScale; }
+
+        /** Returns the bias applied to quantized positions. @see SetPositionQuantization */
+        const Vector3& GetPositionBias() const { return _positionBias; }
+
         /**	Calculates the bounds of all vertices corresponding to the range from indexOffset with indexCount elements */
         Bounds CalculateBounds(UINT32 indexOffset, UINT32 indexCount) const;
 
@@ -166,6 +178,9 @@ namespace te
         /**	Returns the size of the index buffer in bytes. */
         UINT32 GetIndexBufferSize() const;
 
+        /** Reads an object space position from a position element of type VET_FLOAT3, VET_FLOAT4 or VET_SHORT4_NORM. */
+        Vector3 ReadPosition(const UINT8* data, VertexElementType type) const;
+
     private:
         friend class Mesh;
 
@@ -174,5 +189,8 @@ namespace te
         IndexType _indexType;
 
         SPtr<VertexDataDesc> _vertexData;
+
+        Vector3 _positionScale = Vector3::ONE;
+        Vector3 _positionBias = Vector3::ZERO;
     };
 }
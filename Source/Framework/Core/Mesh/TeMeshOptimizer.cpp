@@ -0,0 +1,389 @@
+#include "Mesh/TeMeshOptimizer.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Size of the LRU cache Forsyth's scoring is tuned for. */
+        constexpr UINT32 SCORING_CACHE_SIZE = 32;
+        constexpr float CACHE_DECAY_POWER = 1.5f;
+        constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr float VALENCE_BOOST_SCALE = 2.0f;
+        constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+        float VertexScore(INT32 cachePosition, UINT32 remainingTriangles)
+        {
+            if (remainingTriangles == 0)
+                return -1.0f;
+
+            float score = 0.0f;
+            if (cachePosition >= 0)
+            {
+                // The vertices of the last triangle get a fixed score, whichever of them is used next they are all hits
+                if (cachePosition < 3)
+                    score = LAST_TRIANGLE_SCORE;
+                else
+                {
+                    const float scaler = 1.0f / (SCORING_CACHE_SIZE - 3);
+                    score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+                }
+            }
+
+            // Vertices with few triangles left are boosted, so they get done with instead of lingering
+            score += VALENCE_BOOST_SCALE * std::pow((float)remainingTriangles, -VALENCE_BOOST_POWER);
+
+            return score;
+        }
+
+        /** Vertex to triangles adjacency, stored as one array of triangles sliced by vertex. */
+        struct TriangleAdjacency
+        {
+            TriangleAdjacency(const UINT32* indices, UINT32 numIndices, UINT32 numVertices)
+                : Counts(numVertices, 0)
+                , Offsets(numVertices, 0)
+                , Triangles(numIndices)
+            {
+                for (UINT32 i = 0; i < numIndices; i++)
+                    Counts[indices[i]]++;
+
+                UINT32 offset = 0;
+                for (UINT32 i = 0; i < numVertices; i++)
+                {
+                    Offsets[i] = offset;
+                    offset += Counts[i];
+                }
+
+                Vector<UINT32> fill = Offsets;
+                for (UINT32 i = 0; i < numIndices; i++)
+                    Triangles[fill[indices[i]]++] = i / 3;
+            }
+
+            Vector<UINT32> Counts;
+            Vector<UINT32> Offsets;
+            Vector<UINT32> Triangles;
+        };
+
+        /** Simulated FIFO post-transform cache. Each vertex remembers when it was transformed. */
+        struct FifoCache
+        {
+            FifoCache(UINT32 numVertices)
+                : Timestamps(numVertices, 0)
+                , Time(MeshOptimizer::VERTEX_CACHE_SIZE + 1)
+            { }
+
+            /** Returns true if the vertex had to be transformed. */
+            bool Process(UINT32 vertex)
+            {
+                if (Time - Timestamps[vertex] <= MeshOptimizer::VERTEX_CACHE_SIZE)
+                    return false;
+
+                Timestamps[vertex] = Time++;
+                return true;
+            }
+
+            UINT32 ProcessTriangle(const UINT32* triangle)
+            {
+                return (UINT32)Process(triangle[0]) + (UINT32)Process(triangle[1]) + (UINT32)Process(triangle[2]);
+            }
+
+            void Flush()
+            {
+                Time += MeshOptimizer::VERTEX_CACHE_SIZE + 1;
+            }
+
+            Vector<UINT32> Timestamps;
+            UINT32 Time;
+        };
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(UINT32* output, const UINT32* indices, UINT32 numIndices, UINT32 numVertices)
+    {
+        const UINT32 numTriangles = numIndices / 3;
+        if (numTriangles == 0)
+            return;
+
+        TriangleAdjacency adjacency(indices, numIndices, numVertices);
+
+        // Remaining triangles of a vertex are kept at the start of its adjacency slice
+        Vector<UINT32>& remaining = adjacency.Counts;
+        Vector<INT32> cachePositions(numVertices, -1);
+        Vector<float> vertexScores(numVertices);
+        for (UINT32 i = 0; i < numVertices; i++)
+            vertexScores[i] = VertexScore(-1, remaining[i]);
+
+        Vector<float> triangleScores(numTriangles);
+        Vector<UINT8> emitted(numTriangles, 0);
+        for (UINT32 i = 0; i < numTriangles; i++)
+        {
+            const UINT32* triangle = &indices[i * 3];
+            triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+        }
+
+        UINT32 cache[SCORING_CACHE_SIZE + 3];
+        UINT32 newCache[SCORING_CACHE_SIZE + 3];
+        UINT32 cacheSize = 0;
+
+        UINT32 bestTriangle = (UINT32)(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+        UINT32 nextCandidate = 0;
+
+        for (UINT32 outputTriangle = 0; outputTriangle < numTriangles; outputTriangle++)
+        {
+            // No triangle left around the cached vertices, restart from the next triangle in input order
+            if (bestTriangle == (UINT32)-1)
+            {
+                while (emitted[nextCandidate])
+                    nextCandidate++;
+
+                bestTriangle = nextCandidate;
+            }
+
+            const UINT32* triangle = &indices[bestTriangle * 3];
+            memcpy(&output[outputTriangle * 3], triangle, 3 * sizeof(UINT32));
+            emitted[bestTriangle] = 1;
+
+            UINT32 newCacheSize = 0;
+            for (UINT32 k = 0; k < 3; k++)
+            {
+                const UINT32 vertex = triangle[k];
+
+                UINT32* vertexTriangles = &adjacency.Triangles[adjacency.Offsets[vertex]];
+                for (UINT32 t = 0; t < remaining[vertex]; t++)
+                {
+                    if (vertexTriangles[t] == bestTriangle)
+                    {
+                        std::swap(vertexTriangles[t], vertexTriangles[remaining[vertex] - 1]);
+                        break;
+                    }
+                }
+
+                remaining[vertex]--;
+                newCache[newCacheSize++] = vertex;
+            }
+
+            for (UINT32 i = 0; i < cacheSize; i++)
+            {
+                const UINT32 vertex = cache[i];
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                    newCache[newCacheSize++] = vertex;
+            }
+
+            // Vertices pushed out of the cache lose their cache score
+            for (UINT32 i = SCORING_CACHE_SIZE; i < newCacheSize; i++)
+            {
+                cachePositions[newCache[i]] = -1;
+                vertexScores[newCache[i]] = VertexScore(-1, remaining[newCache[i]]);
+            }
+
+            cacheSize = std::min(newCacheSize, SCORING_CACHE_SIZE);
+            memcpy(cache, newCache, cacheSize * sizeof(UINT32));
+
+            for (UINT32 i = 0; i < cacheSize; i++)
+            {
+                cachePositions[cache[i]] = (INT32)i;
+                vertexScores[cache[i]] = VertexScore((INT32)i, remaining[cache[i]]);
+            }
+
+            // Only the triangles around the cached vertices changed, the next best triangle is one of them
+            bestTriangle = (UINT32)-1;
+            float bestScore = -1.0f;
+
+            for (UINT32 i = 0; i < newCacheSize; i++)
+            {
+                const UINT32 vertex = newCache[i];
+                const UINT32* vertexTriangles = &adjacency.Triangles[adjacency.Offsets[vertex]];
+
+                for (UINT32 t = 0; t < remaining[vertex]; t++)
+                {
+                    const UINT32 triangleIdx = vertexTriangles[t];
+                    const UINT32* other = &indices[triangleIdx * 3];
+
+                    const float score = vertexScores[other[0]] + vertexScores[other[1]] + vertexScores[other[2]];
+                    triangleScores[triangleIdx] = score;
+
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = triangleIdx;
+                    }
+                }
+            }
+        }
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(UINT32* output, const UINT32* indices, UINT32 numIndices, const UINT8* positions,
+        UINT32 numVertices, UINT32 stride, float threshold)
+    {
+        auto GetPosition = [&](UINT32 vertex) -> const Vector3&
+        {
+            return *reinterpret_cast<const Vector3*>(positions + (size_t)vertex * stride);
+        };
+
+        const UINT32 numTriangles = numIndices / 3;
+        if (numTriangles == 0)
+            return;
+
+        // Hard boundaries are where every vertex of a triangle misses the cache, the order was already broken there
+        Vector<UINT32> hardBoundaries;
+        {
+            FifoCache cache(numVertices);
+            for (UINT32 i = 0; i < numTriangles; i++)
+            {
+                if (cache.ProcessTriangle(&indices[i * 3]) == 3)
+                    hardBoundaries.push_back(i);
+            }
+
+            if (hardBoundaries.empty() || hardBoundaries[0] != 0)
+                hardBoundaries.insert(hardBoundaries.begin(), 0);
+        }
+
+        // Soft boundaries split hard clusters wherever restarting with a cold cache keeps the miss ratio acceptable
+        Vector<UINT32> clusters;
+        {
+            FifoCache cache(numVertices);
+            for (size_t h = 0; h < hardBoundaries.size(); h++)
+            {
+                const UINT32 start = hardBoundaries[h];
+                const UINT32 end = h + 1 < hardBoundaries.size() ? hardBoundaries[h + 1] : numTriangles;
+
+                cache.Flush();
+                UINT32 clusterMisses = 0;
+                for (UINT32 i = start; i < end; i++)
+                    clusterMisses += cache.ProcessTriangle(&indices[i * 3]);
+
+                const float clusterAcmr = clusterMisses / (float)(end - start);
+
+                cache.Flush();
+                clusters.push_back(start);
+
+                UINT32 misses = 0;
+                UINT32 triangles = 0;
+                for (UINT32 i = start; i < end; i++)
+                {
+                    misses += cache.ProcessTriangle(&indices[i * 3]);
+                    triangles++;
+
+                    if (i + 1 < end && misses <= clusterAcmr * threshold * triangles)
+                    {
+                        clusters.push_back(i + 1);
+                        cache.Flush();
+                        misses = 0;
+                        triangles = 0;
+                    }
+                }
+            }
+        }
+
+        // Clusters facing away from the center of the mesh are drawn first, they are the most likely to be in front
+        Vector3 meshCentroid = Vector3::ZERO;
+        for (UINT32 i = 0; i < numIndices; i++)
+            meshCentroid += GetPosition(indices[i]);
+
+        meshCentroid /= (float)numIndices;
+
+        const UINT32 numClusters = (UINT32)clusters.size();
+        Vector<std::pair<float, UINT32>> sortKeys(numClusters);
+
+        for (UINT32 c = 0; c < numClusters; c++)
+        {
+            const UINT32 start = clusters[c];
+            const UINT32 end = c + 1 < numClusters ? clusters[c + 1] : numTriangles;
+
+            Vector3 centroid = Vector3::ZERO;
+            Vector3 normal = Vector3::ZERO;
+            float area = 0.0f;
+
+            for (UINT32 i = start; i < end; i++)
+            {
+                const Vector3& p0 = GetPosition(indices[i * 3 + 0]);
+                const Vector3& p1 = GetPosition(indices[i * 3 + 1]);
+                const Vector3& p2 = GetPosition(indices[i * 3 + 2]);
+
+                const Vector3 triangleNormal = Vector3::Cross(p1 - p0, p2 - p0);
+                const float triangleArea = triangleNormal.Length();
+
+                centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+                normal += triangleNormal;
+                area += triangleArea;
+            }
+
+            centroid = area > 0.0f ? centroid / area : GetPosition(indices[start * 3]);
+            const float normalLength = normal.Length();
+            if (normalLength > 0.0f)
+                normal /= normalLength;
+
+            sortKeys[c] = { (centroid - meshCentroid).Dot(normal), c };
+        }
+
+        std::stable_sort(sortKeys.begin(), sortKeys.end(),
+            [](const std::pair<float, UINT32>& a, const std::pair<float, UINT32>& b) { return a.first > b.first; });
+
+        UINT32 writeIdx = 0;
+        for (auto& entry : sortKeys)
+        {
+            const UINT32 start = clusters[entry.second];
+            const UINT32 end = entry.second + 1 < numClusters ? clusters[entry.second + 1] : numTriangles;
+
+            memcpy(&output[writeIdx], &indices[start * 3], (end - start) * 3 * sizeof(UINT32));
+            writeIdx += (end - start) * 3;
+        }
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(UINT32* remap, UINT32* indices, UINT32 numIndices, UINT32 numVertices)
+    {
+        std::fill(remap, remap + numVertices, (UINT32)-1);
+
+        UINT32 nextVertex = 0;
+        for (UINT32 i = 0; i < numIndices; i++)
+        {
+            if (remap[indices[i]] == (UINT32)-1)
+                remap[indices[i]] = nextVertex++;
+
+            indices[i] = remap[indices[i]];
+        }
+
+        for (UINT32 i = 0; i < numVertices; i++)
+        {
+            if (remap[i] == (UINT32)-1)
+                remap[i] = nextVertex++;
+        }
+    }
+
+    void MeshOptimizer::RemapVertices(UINT8* vertices, UINT32 numVertices, UINT32 stride, const UINT32* remap)
+    {
+        Vector<UINT8> source(vertices, vertices + (size_t)numVertices * stride);
+
+        for (UINT32 i = 0; i < numVertices; i++)
+            memcpy(vertices + (size_t)remap[i] * stride, source.data() + (size_t)i * stride, stride);
+    }
+
+    VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const UINT32* indices, UINT32 numIndices, UINT32 numVertices)
+    {
+        VertexCacheStatistics statistics;
+
+        const UINT32 numTriangles = numIndices / 3;
+        if (numTriangles == 0)
+            return statistics;
+
+        FifoCache cache(numVertices);
+        Vector<UINT8> referenced(numVertices, 0);
+        UINT32 misses = 0;
+        UINT32 numReferenced = 0;
+
+        for (UINT32 i = 0; i < numTriangles * 3; i++)
+        {
+            misses += (UINT32)cache.Process(indices[i]);
+
+            if (!referenced[indices[i]])
+            {
+                referenced[indices[i]] = 1;
+                numReferenced++;
+            }
+        }
+
+        statistics.ACMR = misses / (float)numTriangles;
+        statistics.ATVR = misses / (float)numReferenced;
+
+        return statistics;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+namespace te
+{
+    /** Statistics of a triangle list going through a simulated post-transform vertex cache. */
+    struct VertexCacheStatistics
+    {
+        /** Average cache miss ratio, number of transformed vertices per triangle. 0.5 is ideal, 3 is the worst. */
+        float ACMR = 0.0f;
+
+        /** Average transform to vertex ratio, number of transformed vertices per referenced vertex. 1 is ideal. */
+        float ATVR = 0.0f;
+    };
+
+    /**
+     * Reorders triangle lists and vertices so the GPU transforms and fetches vertices as few times as possible, and draws
+     * less hidden pixels. Every function works on a triangle list indexing 32-bit indices and keeps the triangles and
+     * their winding as they are, only their order changes.
+     */
+    class TE_CORE_EXPORT MeshOptimizer
+    {
+    public:
+        /** Size of the FIFO post-transform cache used by the optimizations and the statistics. */
+        static constexpr UINT32 VERTEX_CACHE_SIZE = 16;
+
+        /**
+         * Reorders the triangles to reuse the vertices transformed by recent triangles, using the scoring of Tom Forsyth's
+         * linear-speed vertex cache optimization.
+         *
+         * @param[out]	output		Reordered triangle list, must hold @p numIndices indices. Can't be @p indices.
+         * @param[in]	indices		Triangle list to reorder.
+         * @param[in]	numIndices	Number of indices in the triangle list, a multiple of three.
+         * @param[in]	numVertices	Number of vertices indexed by the triangle list.
+         */
+        static void OptimizeVertexCache(UINT32* output, const UINT32* indices, UINT32 numIndices, UINT32 numVertices);
+
+        /**
+         * Reorders clusters of triangles, as output by OptimizeVertexCache(), so the ones most likely to occlude the others
+         * are drawn first (Sander et al., Tipsify). Clusters are split where the vertex cache would be flushed anyway and
+         * where splitting doesn't raise the cache miss ratio above @p threshold times its current value.
+         *
+         * @param[out]	output		Reordered triangle list, must hold @p numIndices indices. Can't be @p indices.
+         * @param[in]	indices		Triangle list to reorder, optimized for the vertex cache.
+         * @param[in]	numIndices	Number of indices in the triangle list, a multiple of three.
+         * @param[in]	positions	Vertex positions, as three floats per vertex.
+         * @param[in]	numVertices	Number of vertices in @p positions.
+         * @param[in]	stride		Number of bytes between two positions in @p positions.
+         * @param[in]	threshold	Largest increase of the cache miss ratio allowed to get smaller clusters. 1 keeps the
+         *							cache efficiency, larger values reduce overdraw more.
+         */
+        static void OptimizeOverdraw(UINT32* output, const UINT32* indices, UINT32 numIndices, const UINT8* positions,
+            UINT32 numVertices, UINT32 stride, float threshold = 1.05f);
+
+        /**
+         * Computes a vertex order following the first use of each vertex by the triangle list, so vertex fetches move
+         * linearly through memory, and remaps the triangle list to it. Vertices not used by the triangle list are moved at
+         * the end.
+         *
+         * @param[out]	remap		New index of each vertex, must hold @p numVertices entries.
+         * @param[in]	indices		Triangle list, remapped to the new vertex order in place.
+         * @param[in]	numIndices	Number of indices in the triangle list.
+         * @param[in]	numVertices	Number of vertices indexed by the triangle list.
+         */
+        static void OptimizeVertexFetch(UINT32* remap, UINT32* indices, UINT32 numIndices, UINT32 numVertices);
+
+        /**
+         * Moves vertices to the position given by a remap table, as output by OptimizeVertexFetch().
+         *
+         * @param[in]	vertices	Vertex data, reordered in place.
+         * @param[in]	numVertices	Number of vertices in @p vertices.
+         * @param[in]	stride		Size of a vertex in bytes.
+         * @param[in]	remap		New index of each vertex.
+         */
+        static void RemapVertices(UINT8* vertices, UINT32 numVertices, UINT32 stride, const UINT32* remap);
+
+        /** Runs a triangle list through a FIFO post-transform cache of VERTEX_CACHE_SIZE entries. */
+        static VertexCacheStatistics AnalyzeVertexCache(const UINT32* indices, UINT32 numIndices, UINT32 numVertices);
+    };
+}
@@ -0,0 +1,388 @@
+#include "Mesh/TeMeshSimplifier.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Weight of the planes keeping border vertices on the border, relative to the planes of the triangles. */
+        constexpr double BORDER_WEIGHT = 10.0;
+
+        /** Triangles whose normal turns by more than ~75 degrees when collapsing an edge block the collapse. */
+        constexpr float MIN_NORMAL_COS = 0.25f;
+
+        enum class VertexKind : UINT8
+        {
+            Manifold, /**< Can collapse along any edge. */
+            Border, /**< Can only collapse along a border edge. */
+            Locked /**< Never moves. */
+        };
+
+        /** Symmetric 4x4 matrix of a quadric error metric, stored as its 10 unique coefficients. */
+        struct Quadric
+        {
+            void AddPlane(double a, double b, double c, double d, double weight)
+            {
+                XX += weight * a * a; XY += weight * a * b; XZ += weight * a * c; XW += weight * a * d;
+                YY += weight * b * b; YZ += weight * b * c; YW += weight * b * d;
+                ZZ += weight * c * c; ZW += weight * c * d;
+                WW += weight * d * d;
+                Weight += weight;
+            }
+
+            void Add(const Quadric& other)
+            {
+                XX += other.XX; XY += other.XY; XZ += other.XZ; XW += other.XW;
+                YY += other.YY; YZ += other.YZ; YW += other.YW;
+                ZZ += other.ZZ; ZW += other.ZW;
+                WW += other.WW;
+                Weight += other.Weight;
+            }
+
+            /** Returns the weighted sum of squared distances from @p p to the planes of the quadric. */
+            double Evaluate(const Vector3& p) const
+            {
+                const double x = p.x, y = p.y, z = p.z;
+                return XX * x * x + 2.0 * XY * x * y + 2.0 * XZ * x * z + 2.0 * XW * x
+                    + YY * y * y + 2.0 * YZ * y * z + 2.0 * YW * y
+                    + ZZ * z * z + 2.0 * ZW * z
+                    + WW;
+            }
+
+            double XX = 0.0, XY = 0.0, XZ = 0.0, XW = 0.0;
+            double YY = 0.0, YZ = 0.0, YW = 0.0;
+            double ZZ = 0.0, ZW = 0.0;
+            double WW = 0.0;
+            double Weight = 0.0;
+        };
+
+        struct Collapse
+        {
+            UINT32 Source;
+            UINT32 Target;
+            float Error;
+        };
+
+        UINT64 EdgeKey(UINT32 a, UINT32 b)
+        {
+            return ((UINT64)a << 32) | (UINT64)b;
+        }
+
+        /** Mean squared distance of @p position to the planes of both quadrics. */
+        float CollapseError(const Quadric& a, const Quadric& b, const Vector3& position)
+        {
+            Quadric quadric = a;
+            quadric.Add(b);
+
+            if (quadric.Weight <= 0.0)
+                return 0.0f;
+
+            return (float)(std::max(quadric.Evaluate(position), 0.0) / quadric.Weight);
+        }
+    }
+
+    UINT32 MeshSimplifier::Simplify(const UINT8* positions, UINT32 numVertices, UINT32 stride, const UINT32* indices,
+        UINT32 numIndices, UINT32 targetNumIndices, float maxError, UINT32* output, float* outError)
+    {
+        auto GetPosition = [&](UINT32 vertex) -> const Vector3&
+        {
+            return *reinterpret_cast<const Vector3*>(positions + (size_t)vertex * stride);
+        };
+
+        memcpy(output, indices, numIndices * sizeof(UINT32));
+        if (outError)
+            *outError = 0.0f;
+
+        UINT32 indexCount = numIndices - numIndices % 3;
+        if (indexCount <= targetNumIndices)
+            return indexCount;
+
+        // Gather the referenced vertices, the triangles may only use a small range of a larger vertex buffer
+        Vector<UINT32> vertices(output, output + indexCount);
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+        Vector3 boundsMin = GetPosition(vertices[0]);
+        Vector3 boundsMax = boundsMin;
+        for (auto& vertex : vertices)
+        {
+            boundsMin = Vector3::Min(boundsMin, GetPosition(vertex));
+            boundsMax = Vector3::Max(boundsMax, GetPosition(vertex));
+        }
+
+        const Vector3 extents = boundsMax - boundsMin;
+        const float scale = std::max(extents.x, std::max(extents.y, extents.z));
+        if (scale <= 0.0f)
+            return indexCount;
+
+        const float maxErrorSq = (maxError * scale) * (maxError * scale);
+
+        // Vertices sharing a position are collapsed as one position, so both sides of a seam use the same topology
+        Vector<UINT32> canonical(numVertices);
+        Vector<VertexKind> kinds(numVertices, VertexKind::Manifold);
+        {
+            Vector<UINT32> sorted = vertices;
+            std::sort(sorted.begin(), sorted.end(), [&](UINT32 a, UINT32 b)
+            {
+                const Vector3& pa = GetPosition(a);
+                const Vector3& pb = GetPosition(b);
+                if (pa.x != pb.x) return pa.x < pb.x;
+                if (pa.y != pb.y) return pa.y < pb.y;
+                return pa.z < pb.z;
+            });
+
+            for (size_t i = 0; i < sorted.size();)
+            {
+                size_t end = i + 1;
+                while (end < sorted.size() && GetPosition(sorted[end]) == GetPosition(sorted[i]))
+                    end++;
+
+                for (size_t j = i; j < end; j++)
+                {
+                    canonical[sorted[j]] = sorted[i];
+                    if (end - i > 1)
+                        kinds[sorted[j]] = VertexKind::Locked;
+                }
+
+                i = end;
+            }
+        }
+
+        // Classify border and non-manifold vertices from the directed edges of the triangles
+        UnorderedMap<UINT64, UINT32> edgeCounts;
+        edgeCounts.reserve(indexCount);
+        for (UINT32 i = 0; i < indexCount; i += 3)
+        {
+            for (UINT32 e = 0; e < 3; e++)
+            {
+                const UINT32 a = canonical[output[i + e]];
+                const UINT32 b = canonical[output[i + (e + 1) % 3]];
+                edgeCounts[EdgeKey(a, b)]++;
+            }
+        }
+
+        Quadric* quadrics = te_newN<Quadric>(numVertices);
+
+        for (UINT32 i = 0; i < indexCount; i += 3)
+        {
+            const Vector3& p0 = GetPosition(output[i + 0]);
+            const Vector3& p1 = GetPosition(output[i + 1]);
+            const Vector3& p2 = GetPosition(output[i + 2]);
+
+            Vector3 normal = Vector3::Cross(p1 - p0, p2 - p0);
+            const float doubleArea = normal.Length();
+            if (doubleArea <= 0.0f)
+                continue;
+
+            normal /= doubleArea;
+            const double d = -(double)normal.Dot(p0);
+
+            for (UINT32 e = 0; e < 3; e++)
+                quadrics[output[i + e]].AddPlane(normal.x, normal.y, normal.z, d, doubleArea * 0.5);
+
+            for (UINT32 e = 0; e < 3; e++)
+            {
+                const UINT32 a = output[i + e];
+                const UINT32 b = output[i + (e + 1) % 3];
+                const UINT32 count = edgeCounts[EdgeKey(canonical[a], canonical[b])];
+                auto iterReverse = edgeCounts.find(EdgeKey(canonical[b], canonical[a]));
+                const UINT32 reverseCount = iterReverse != edgeCounts.end() ? iterReverse->second : 0;
+
+                if (count > 1 || reverseCount > 1)
+                {
+                    kinds[a] = kinds[b] = VertexKind::Locked;
+                    continue;
+                }
+
+                if (reverseCount > 0)
+                    continue;
+
+                // Open edge, keep its vertices on the plane going through the edge and perpendicular to the triangle
+                for (UINT32 vertex : { a, b })
+                {
+                    if (kinds[vertex] == VertexKind::Manifold)
+                        kinds[vertex] = VertexKind::Border;
+                }
+
+                const Vector3 edge = GetPosition(b) - GetPosition(a);
+                Vector3 borderNormal = Vector3::Cross(edge, normal);
+                const float length = borderNormal.Length();
+                if (length <= 0.0f)
+                    continue;
+
+                borderNormal /= length;
+                const double borderD = -(double)borderNormal.Dot(GetPosition(a));
+                const double weight = (double)edge.SquaredLength() * BORDER_WEIGHT;
+
+                quadrics[a].AddPlane(borderNormal.x, borderNormal.y, borderNormal.z, borderD, weight);
+                quadrics[b].AddPlane(borderNormal.x, borderNormal.y, borderNormal.z, borderD, weight);
+            }
+        }
+
+        Vector<UINT32> collapseTarget(numVertices);
+        Vector<UINT8> touched(numVertices);
+        Vector<UINT32> triangleOffsets(numVertices + 1);
+        Vector<UINT32> vertexTriangles;
+        Vector<Collapse> collapses;
+        UnorderedSet<UINT64> edges;
+        float resultError = 0.0f;
+
+        // Collapse edges in passes. Each pass picks the cheapest collapses that don't touch each other, which keeps the
+        // cost of the remaining candidates valid without maintaining a priority queue.
+        while (indexCount > targetNumIndices)
+        {
+            const UINT32 numTriangles = indexCount / 3;
+
+            // Triangles around each vertex
+            std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+            for (UINT32 i = 0; i < indexCount; i++)
+                triangleOffsets[output[i] + 1]++;
+
+            for (UINT32 i = 0; i < numVertices; i++)
+                triangleOffsets[i + 1] += triangleOffsets[i];
+
+            vertexTriangles.resize(indexCount);
+            {
+                Vector<UINT32> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+                for (UINT32 i = 0; i < indexCount; i++)
+                    vertexTriangles[fill[output[i]]++] = i / 3;
+            }
+
+            edges.clear();
+            for (UINT32 i = 0; i < indexCount; i += 3)
+            {
+                for (UINT32 e = 0; e < 3; e++)
+                    edges.insert(EdgeKey(canonical[output[i + e]], canonical[output[i + (e + 1) % 3]]));
+            }
+
+            // Evaluate every edge once, in the cheapest valid direction
+            collapses.clear();
+            for (UINT32 i = 0; i < indexCount; i += 3)
+            {
+                for (UINT32 e = 0; e < 3; e++)
+                {
+                    const UINT32 a = output[i + e];
+                    const UINT32 b = output[i + (e + 1) % 3];
+                    const bool border = edges.find(EdgeKey(canonical[b], canonical[a])) == edges.end();
+
+                    if (!border && canonical[a] > canonical[b])
+                        continue;
+
+                    Collapse collapse = { a, b, std::numeric_limits<float>::max() };
+
+                    for (UINT32 direction = 0; direction < 2; direction++)
+                    {
+                        const UINT32 source = direction == 0 ? a : b;
+                        const UINT32 target = direction == 0 ? b : a;
+                        const VertexKind kind = kinds[source];
+
+                        if (kind == VertexKind::Locked || (kind == VertexKind::Border && !border))
+                            continue;
+
+                        const float error = CollapseError(quadrics[source], quadrics[target], GetPosition(target));
+                        if (error < collapse.Error)
+                            collapse = { source, target, error };
+                    }
+
+                    if (collapse.Error <= maxErrorSq)
+                        collapses.push_back(collapse);
+                }
+            }
+
+            std::sort(collapses.begin(), collapses.end(),
+                [](const Collapse& a, const Collapse& b) { return a.Error < b.Error; });
+
+            for (UINT32 i = 0; i < numVertices; i++)
+                collapseTarget[i] = i;
+
+            std::fill(touched.begin(), touched.end(), 0);
+
+            const UINT32 trianglesToRemove = (indexCount - targetNumIndices + 2) / 3;
+            UINT32 removedTriangles = 0;
+            UINT32 numCollapses = 0;
+
+            for (auto& collapse : collapses)
+            {
+                const UINT32 source = collapse.Source;
+                const UINT32 target = collapse.Target;
+
+                if (touched[source] || touched[target])
+                    continue;
+
+                // Reject collapses flipping or squashing the triangles that remain around the source vertex
+                const Vector3& targetPosition = GetPosition(target);
+                bool valid = true;
+                UINT32 removed = 0;
+
+                for (UINT32 t = triangleOffsets[source]; t < triangleOffsets[source + 1] && valid; t++)
+                {
+                    const UINT32* triangle = &output[vertexTriangles[t] * 3];
+                    if (triangle[0] == target || triangle[1] == target || triangle[2] == target)
+                    {
+                        removed++;
+                        continue;
+                    }
+
+                    Vector3 before[3], after[3];
+                    for (UINT32 k = 0; k < 3; k++)
+                    {
+                        before[k] = GetPosition(triangle[k]);
+                        after[k] = triangle[k] == source ? targetPosition : before[k];
+                    }
+
+                    const Vector3 normalBefore = Vector3::Cross(before[1] - before[0], before[2] - before[0]);
+                    const Vector3 normalAfter = Vector3::Cross(after[1] - after[0], after[2] - after[0]);
+
+                    valid = normalBefore.Dot(normalAfter) > MIN_NORMAL_COS * normalBefore.Length() * normalAfter.Length();
+                }
+
+                if (!valid)
+                    continue;
+
+                collapseTarget[source] = target;
+                quadrics[target].Add(quadrics[source]);
+                resultError = std::max(resultError, collapse.Error);
+
+                // Neighbours of the source vertex see their triangles change, their candidates are re-evaluated next pass
+                for (UINT32 t = triangleOffsets[source]; t < triangleOffsets[source + 1]; t++)
+                {
+                    const UINT32* triangle = &output[vertexTriangles[t] * 3];
+                    touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+                }
+
+                numCollapses++;
+                removedTriangles += removed;
+                if (removedTriangles >= trianglesToRemove)
+                    break;
+            }
+
+            if (numCollapses == 0)
+                break;
+
+            // Apply the collapses and drop the triangles they made degenerate
+            UINT32 writeIdx = 0;
+            for (UINT32 i = 0; i < numTriangles; i++)
+            {
+                const UINT32 v0 = collapseTarget[output[i * 3 + 0]];
+                const UINT32 v1 = collapseTarget[output[i * 3 + 1]];
+                const UINT32 v2 = collapseTarget[output[i * 3 + 2]];
+
+                if (v0 == v1 || v1 == v2 || v2 == v0)
+                    continue;
+
+                output[writeIdx++] = v0;
+                output[writeIdx++] = v1;
+                output[writeIdx++] = v2;
+            }
+
+            indexCount = writeIdx;
+        }
+
+        te_deleteN(quadrics, numVertices);
+
+        if (outError)
+            *outError = std::sqrt(resultError) / scale;
+
+        return indexCount;
+    }
+}
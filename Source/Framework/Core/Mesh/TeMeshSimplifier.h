@@ -0,0 +1,39 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+namespace te
+{
+    /**
+     * Reduces the number of triangles of a mesh by collapsing its edges in order of their quadric error metric (Garland &
+     * Heckbert). Vertices are only collapsed onto other existing vertices, so a simplified triangle list still indexes the
+     * original vertices and a level of detail only needs its own indices.
+     *
+     * Vertices sharing their position with other vertices (attribute seams, like UV or hard normal splits) and vertices on
+     * non-manifold edges are never moved. Vertices on open borders only move along the border. This keeps the outline and
+     * the texture mapping of the mesh intact.
+     */
+    class TE_CORE_EXPORT MeshSimplifier
+    {
+    public:
+        /**
+         * Simplifies a triangle list.
+         *
+         * @param[in]	positions			Vertex positions, as three floats per vertex.
+         * @param[in]	numVertices			Number of vertices in @p positions.
+         * @param[in]	stride				Number of bytes between two positions in @p positions.
+         * @param[in]	indices				Triangle list to simplify.
+         * @param[in]	numIndices			Number of indices in @p indices. Must be a multiple of three.
+         * @param[in]	targetNumIndices	Number of indices to reduce the triangle list to.
+         * @param[in]	maxError			Largest error allowed, relative to the size of the bounds of the triangles.
+         *									Simplification stops before reaching @p targetNumIndices if every collapse
+         *									left would introduce a larger error.
+         * @param[out]	output				Simplified triangle list. Must be able to hold @p numIndices indices.
+         * @param[out]	outError			Optional. Largest error introduced, relative to the size of the bounds of the
+         *									triangles.
+         * @return							Number of indices written to @p output.
+         */
+        static UINT32 Simplify(const UINT8* positions, UINT32 numVertices, UINT32 stride, const UINT32* indices,
+            UINT32 numIndices, UINT32 targetNumIndices, float maxError, UINT32* output, float* outError = nullptr);
+    };
+}
@@ -10,38 +10,29 @@ namespace te
     {
         UINT32 numFaces = numIndices / 3;
 
-        Vector3* faceNormals = te_newN<Vector3>(numFaces);
+        // Face normals are added straight to their vertices, in the same order a per-vertex face list would visit them
+        std::fill(normals, normals + numVertices, Vector3::ZERO);
         for (UINT32 i = 0; i < numFaces; i++)
         {
-            UINT32 triangle[3];
+            UINT32 triangle[3] = { 0, 0, 0 };
             memcpy(&triangle[0], indices + (i * 3 + 0) * indexSize, indexSize);
             memcpy(&triangle[1], indices + (i * 3 + 1) * indexSize, indexSize);
             memcpy(&triangle[2], indices + (i * 3 + 2) * indexSize, indexSize);
 
             Vector3 edgeA = vertices[triangle[1]] - vertices[triangle[0]];
             Vector3 edgeB = vertices[triangle[2]] - vertices[triangle[0]];
-            faceNormals[i] = Vector3::Normalize(Vector3::Cross(edgeA, edgeB));
+            Vector3 faceNormal = Vector3::Normalize(Vector3::Cross(edgeA, edgeB));
 
             // Note: Potentially don't normalize here in order to weigh the normals
             // by triangle size
+
+            normals[triangle[0]] += faceNormal;
+            normals[triangle[1]] += faceNormal;
+            normals[triangle[2]] += faceNormal;
         }
 
-        VertexConnectivity connectivity(indices, numVertices, numFaces, indexSize);
         for (UINT32 i = 0; i < numVertices; i++)
-        {
-            VertexFaces& faces = connectivity.vertexFaces[i];
-
-            normals[i] = Vector3::ZERO;
-            for (UINT32 j = 0; j < faces.NumFaces; j++)
-            {
-                UINT32 faceIdx = faces.Faces[j];
-                normals[i] += faceNormals[faceIdx];
-            }
-
             normals[i].Normalize();
-        }
-
-        te_deleteN(faceNormals, numFaces);
     }
 
     void MeshUtility::CalculateTangents(Vector3* vertices, Vector3* normals, Vector2* uv, UINT8* indices, UINT32 numVertices,
@@ -55,11 +46,12 @@ namespace te
         UINT8* normalBytes = (UINT8*)normals;
         UINT8* uvBytes = (UINT8*)uv;
 
-        Vector3* faceTangents = te_newN<Vector3>(numFaces);
-        Vector3* faceBitangents = te_newN<Vector3>(numFaces);
+        // Face tangents are added straight to their vertices, in the same order a per-vertex face list would visit them
+        std::fill(tangents, tangents + numVertices, Vector3::ZERO);
+        std::fill(bitangents, bitangents + numVertices, Vector3::ZERO);
         for (UINT32 i = 0; i < numFaces; i++)
         {
-            UINT32 triangle[3];
+            UINT32 triangle[3] = { 0, 0, 0 };
             memcpy(&triangle[0], indices + (i * 3 + 0) * indexSize, indexSize);
             memcpy(&triangle[1], indices + (i * 3 + 1) * indexSize, indexSize);
             memcpy(&triangle[2], indices + (i * 3 + 2) * indexSize, indexSize);
@@ -78,36 +70,30 @@ namespace te
             Vector2 st1 = uv1 - uv0;
             Vector2 st2 = uv2 - uv0;
 
+            // Faces without a UV mapping don't have a tangent frame to contribute
             float denom = st1.x * st2.y - st2.x * st1.y;
-            if (fabs(denom) >= 0e-8f)
-            {
-                float r = 1.0f / denom;
-
-                faceTangents[i] = (st2.y * q0 - st1.y * q1) * r;
-                faceBitangents[i] = (st1.x * q1 - st2.x * q0) * r;
+            if (fabs(denom) < 1e-8f)
+                continue;
 
-                faceTangents[i].Normalize();
-                faceBitangents[i].Normalize();
-            }
+            float r = 1.0f / denom;
 
-            // Note: Potentially don't normalize here in order to weight the normals by triangle size
-        }
+            Vector3 faceTangent = (st2.y * q0 - st1.y * q1) * r;
+            Vector3 faceBitangent = (st1.x * q1 - st2.x * q0) * r;
 
-        VertexConnectivity connectivity(indices, numVertices, numFaces, indexSize);
-        for (UINT32 i = 0; i < numVertices; i++)
-        {
-            VertexFaces& faces = connectivity.vertexFaces[i];
+            faceTangent.Normalize();
+            faceBitangent.Normalize();
 
-            tangents[i] = Vector3::ZERO;
-            bitangents[i] = Vector3::ZERO;
+            // Note: Potentially don't normalize here in order to weight the normals by triangle size
 
-            for (UINT32 j = 0; j < faces.NumFaces; j++)
+            for (UINT32 j = 0; j < 3; j++)
             {
-                UINT32 faceIdx = faces.Faces[j];
-                tangents[i] += faceTangents[faceIdx];
-                bitangents[i] += faceBitangents[faceIdx];
+                tangents[triangle[j]] += faceTangent;
+                bitangents[triangle[j]] += faceBitangent;
             }
+        }
 
+        for (UINT32 i = 0; i < numVertices; i++)
+        {
             tangents[i].Normalize();
             bitangents[i].Normalize();
 
@@ -124,9 +110,6 @@ namespace te
             bitangents[i].Normalize();
         }
 
-        te_deleteN(faceTangents, numFaces);
-        te_deleteN(faceBitangents, numFaces);
-
         // TODO - Consider weighing tangents by triangle size and/or edge angles
     }
 
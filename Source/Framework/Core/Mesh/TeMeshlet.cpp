@@ -0,0 +1,312 @@
+#include "Mesh/TeMeshlet.h"
+#include "Math/TeMath.h"
+#include "Math/TeAABox.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeConvexVolume.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Number of unused triangles following the seed looked at when a meshlet has no neighbour left to grow to. */
+        constexpr UINT32 DISCONNECTED_LOOKAHEAD = 64;
+
+        /** Meshlets whose triangle normals deviate more than this from their average are never back face culled. */
+        constexpr float MIN_CONE_DOT = 0.1f;
+
+        const Vector3& ReadPosition(const UINT8* positions, UINT32 stride, UINT32 vertex)
+        {
+            return *(const Vector3*)(positions + (size_t)stride * vertex);
+        }
+
+        Vector3 TriangleCentroid(const UINT8* positions, UINT32 stride, const UINT32* triangle)
+        {
+            return (ReadPosition(positions, stride, triangle[0]) + ReadPosition(positions, stride, triangle[1]) +
+                ReadPosition(positions, stride, triangle[2])) / 3.0f;
+        }
+
+        /** Computes the bounding sphere and the normal cone of a meshlet from its triangles. */
+        void ComputeMeshletBounds(Meshlet& meshlet, const UINT32* triangles, const UINT8* positions, UINT32 stride,
+            const Vector<UINT32>& vertices)
+        {
+            AABox box(ReadPosition(positions, stride, vertices[0]), ReadPosition(positions, stride, vertices[0]));
+            for (auto vertex : vertices)
+                box.Merge(ReadPosition(positions, stride, vertex));
+
+            const Vector3 center = box.GetCenter();
+            float radiusSqrd = 0.0f;
+            for (auto vertex : vertices)
+                radiusSqrd = std::max(radiusSqrd, center.SquaredDistance(ReadPosition(positions, stride, vertex)));
+
+            meshlet.Bounds = Sphere(center, Math::Sqrt(radiusSqrd));
+            meshlet.VertexCount = (UINT32)vertices.size();
+
+            // Average of the unit normals, degenerate triangles don't face anywhere and are skipped
+            const UINT32 numTriangles = meshlet.IndexCount / 3;
+            Vector3 axis = Vector3::ZERO;
+            for (UINT32 i = 0; i < numTriangles; i++)
+            {
+                const UINT32* triangle = triangles + i * 3;
+                const Vector3& p0 = ReadPosition(positions, stride, triangle[0]);
+                Vector3 normal = (ReadPosition(positions, stride, triangle[1]) - p0).Cross(
+                    ReadPosition(positions, stride, triangle[2]) - p0);
+
+                if (normal.Normalize() > 0.0f)
+                    axis += normal;
+            }
+
+            meshlet.ConeAxis = Vector3::ZERO;
+            meshlet.ConeCutoff = 1.0f;
+            if (axis.Normalize() <= 0.0f)
+                return;
+
+            float minDot = 1.0f;
+            for (UINT32 i = 0; i < numTriangles; i++)
+            {
+                const UINT32* triangle = triangles + i * 3;
+                const Vector3& p0 = ReadPosition(positions, stride, triangle[0]);
+                Vector3 normal = (ReadPosition(positions, stride, triangle[1]) - p0).Cross(
+                    ReadPosition(positions, stride, triangle[2]) - p0);
+
+                if (normal.Normalize() > 0.0f)
+                    minDot = std::min(minDot, normal.Dot(axis));
+            }
+
+            meshlet.ConeAxis = axis;
+            if (minDot > MIN_CONE_DOT)
+                meshlet.ConeCutoff = Math::Sqrt(1.0f - minDot * minDot);
+        }
+    }
+
+    void MeshletUtility::Build(UINT32* indices, UINT32 indexOffset, UINT32 indexCount, const UINT8* positions,
+        UINT32 numVertices, UINT32 stride, Vector<Meshlet>& meshlets)
+    {
+        const UINT32 numTriangles = indexCount / 3;
+        if (numTriangles == 0)
+            return;
+
+        const Vector<UINT32> source(indices + indexOffset, indices + indexOffset + numTriangles * 3);
+        UINT32* output = indices + indexOffset;
+
+        // Vertex to triangles adjacency, stored as one array of triangles sliced by vertex
+        Vector<UINT32> adjacencyOffsets(numVertices + 1, 0);
+        Vector<UINT32> adjacency(numTriangles * 3);
+        for (auto vertex : source)
+            adjacencyOffsets[vertex + 1]++;
+        for (UINT32 i = 0; i < numVertices; i++)
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+
+        Vector<UINT32> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (UINT32 i = 0; i < numTriangles * 3; i++)
+            adjacency[fill[source[i]]++] = i / 3;
+
+        Vector<bool> emitted(numTriangles, false);
+        Vector<bool> inMeshlet(numVertices, false);
+        Vector<UINT32> meshletVertices;
+        meshletVertices.reserve(MAX_VERTICES);
+
+        UINT32 written = 0;
+        UINT32 seed = 0;
+
+        while (written < numTriangles * 3)
+        {
+            Meshlet meshlet;
+            meshlet.IndexOffset = indexOffset + written;
+            meshletVertices.clear();
+
+            while (emitted[seed])
+                seed++;
+
+            UINT32 triangle = seed;
+            Vector3 centroidSum = Vector3::ZERO;
+            AABox box;
+
+            for (;;)
+            {
+                const UINT32* vertices = &source[triangle * 3];
+                for (UINT32 i = 0; i < 3; i++)
+                {
+                    output[written++] = vertices[i];
+                    if (!inMeshlet[vertices[i]])
+                    {
+                        inMeshlet[vertices[i]] = true;
+                        meshletVertices.push_back(vertices[i]);
+                    }
+                }
+
+                emitted[triangle] = true;
+                meshlet.IndexCount += 3;
+
+                centroidSum += TriangleCentroid(positions, stride, vertices);
+                for (UINT32 i = 0; i < 3; i++)
+                {
+                    if (meshlet.IndexCount == 3 && i == 0)
+                        box = AABox(ReadPosition(positions, stride, vertices[0]), ReadPosition(positions, stride, vertices[0]));
+                    else
+                        box.Merge(ReadPosition(positions, stride, vertices[i]));
+                }
+
+                if (meshlet.IndexCount / 3 == MAX_TRIANGLES)
+                    break;
+
+                // Grow to the neighbouring triangle adding the fewest vertices, the closest to the meshlet on ties
+                const Vector3 center = centroidSum / (float)(meshlet.IndexCount / 3);
+                UINT32 best = (UINT32)-1;
+                UINT32 bestNewVertices = 4;
+                float bestDistance = std::numeric_limits<float>::max();
+
+                for (auto vertex : meshletVertices)
+                {
+                    for (UINT32 i = adjacencyOffsets[vertex]; i < adjacencyOffsets[vertex + 1]; i++)
+                    {
+                        UINT32 candidate = adjacency[i];
+                        if (emitted[candidate])
+                            continue;
+
+                        const UINT32* candidateVertices = &source[candidate * 3];
+                        UINT32 newVertices = (inMeshlet[candidateVertices[0]] ? 0 : 1) +
+                            (inMeshlet[candidateVertices[1]] ? 0 : 1) + (inMeshlet[candidateVertices[2]] ? 0 : 1);
+
+                        if (meshletVertices.size() + newVertices > MAX_VERTICES || newVertices > bestNewVertices)
+                            continue;
+
+                        float distance = center.SquaredDistance(TriangleCentroid(positions, stride, candidateVertices));
+                        if (newVertices < bestNewVertices || distance < bestDistance)
+                        {
+                            best = candidate;
+                            bestNewVertices = newVertices;
+                            bestDistance = distance;
+                        }
+                    }
+                }
+
+                // Disconnected pieces (flat shaded faces, foliage cards) go with the closest of the following triangles,
+                // as long as they are within the current size of the meshlet from its center
+                if (best == (UINT32)-1 && meshletVertices.size() + 3 <= MAX_VERTICES)
+                {
+                    const Vector3 extent = box.GetSize();
+                    const float maxDistance = std::max(extent.Dot(extent), 1e-12f);
+
+                    UINT32 looked = 0;
+                    for (UINT32 i = seed; i < numTriangles && looked < DISCONNECTED_LOOKAHEAD; i++)
+                    {
+                        if (emitted[i])
+                            continue;
+
+                        looked++;
+                        float distance = center.SquaredDistance(TriangleCentroid(positions, stride, &source[i * 3]));
+                        if (distance <= maxDistance && distance < bestDistance)
+                        {
+                            best = i;
+                            bestDistance = distance;
+                        }
+                    }
+                }
+
+                if (best == (UINT32)-1)
+                    break;
+
+                triangle = best;
+            }
+
+            ComputeMeshletBounds(meshlet, output + (meshlet.IndexOffset - indexOffset), positions, stride, meshletVertices);
+            meshlets.push_back(meshlet);
+
+            for (auto vertex : meshletVertices)
+                inMeshlet[vertex] = false;
+        }
+    }
+
+    UINT32 MeshletUtility::Cull(const Vector<Meshlet>& meshlets, const Matrix4& worldTfrm, const ConvexVolume& frustum,
+        const Vector3& viewOrigin, float backfaceSign, UINT32 maxRanges, Vector<MeshletRange>& ranges,
+        const std::function<bool(const Sphere&)>& occlusionTest)
+    {
+        ranges.clear();
+
+        const Vector3 axisX = worldTfrm.GetColumn(0);
+        const Vector3 axisY = worldTfrm.GetColumn(1);
+        const Vector3 axisZ = worldTfrm.GetColumn(2);
+        const float scaleX = axisX.Length();
+        const float scaleY = axisY.Length();
+        const float scaleZ = axisZ.Length();
+        const float maxScale = std::max(scaleX, std::max(scaleY, scaleZ));
+        const float minScale = std::min(scaleX, std::min(scaleY, scaleZ));
+
+        // Normal cones only survive rotations and uniform scales. Mirroring transforms flip the winding of triangles.
+        if (minScale < maxScale * 0.99f)
+            backfaceSign = 0.0f;
+        else if (axisX.Cross(axisY).Dot(axisZ) < 0.0f)
+            backfaceSign = -backfaceSign;
+
+        for (const auto& meshlet : meshlets)
+        {
+            const Sphere bounds(worldTfrm.MultiplyAffine(meshlet.Bounds.GetCenter()), meshlet.Bounds.GetRadius() * maxScale);
+            if (!frustum.Intersects(bounds))
+                continue;
+
+            if (backfaceSign != 0.0f && meshlet.ConeCutoff < 1.0f)
+            {
+                const Vector3 axis = Vector3::Normalize(worldTfrm.MultiplyDirection(meshlet.ConeAxis)) * backfaceSign;
+                const Vector3 toCenter = bounds.GetCenter() - viewOrigin;
+
+                // Every point of the bounds sees the meshlet from inside the cone in which all its triangles face away
+                if (toCenter.Dot(axis) >= meshlet.ConeCutoff * toCenter.Length() + bounds.GetRadius())
+                    continue;
+            }
+
+            if (occlusionTest && !occlusionTest(bounds))
+                continue;
+
+            if (!ranges.empty() && ranges.back().IndexOffset + ranges.back().IndexCount == meshlet.IndexOffset)
+                ranges.back().IndexCount += meshlet.IndexCount;
+            else
+                ranges.push_back({ meshlet.IndexOffset, meshlet.IndexCount });
+        }
+
+        // Merge the ranges separated by the smallest gaps, drawing a few hidden triangles costs less than a draw call
+        if (maxRanges > 0 && ranges.size() > maxRanges)
+        {
+            Vector<UINT32> gaps(ranges.size() - 1);
+            for (UINT32 i = 0; i < (UINT32)gaps.size(); i++)
+                gaps[i] = ranges[i + 1].IndexOffset - (ranges[i].IndexOffset + ranges[i].IndexCount);
+
+            const UINT32 numMerges = (UINT32)ranges.size() - maxRanges;
+            Vector<UINT32> sortedGaps = gaps;
+            std::nth_element(sortedGaps.begin(), sortedGaps.begin() + (numMerges - 1), sortedGaps.end());
+            const UINT32 maxGap = sortedGaps[numMerges - 1];
+
+            // Gaps equal to the threshold are only merged until the budget of merges is spent
+            UINT32 thresholdMerges = numMerges;
+            for (auto gap : gaps)
+            {
+                if (gap < maxGap)
+                    thresholdMerges--;
+            }
+
+            UINT32 output = 0;
+            for (UINT32 i = 1; i < (UINT32)ranges.size(); i++)
+            {
+                const UINT32 gap = gaps[i - 1];
+                bool merge = gap < maxGap;
+                if (!merge && gap == maxGap && thresholdMerges > 0)
+                {
+                    merge = true;
+                    thresholdMerges--;
+                }
+
+                if (merge)
+                    ranges[output].IndexCount = ranges[i].IndexOffset + ranges[i].IndexCount - ranges[output].IndexOffset;
+                else
+                    ranges[++output] = ranges[i];
+            }
+
+            ranges.resize(output + 1);
+        }
+
+        UINT32 numTriangles = 0;
+        for (const auto& range : ranges)
+            numTriangles += range.IndexCount / 3;
+
+        return numTriangles;
+    }
+}
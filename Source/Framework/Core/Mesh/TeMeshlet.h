@@ -0,0 +1,97 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeSphere.h"
+#include "Math/TeVector3.h"
+
+#include <functional>
+
+namespace te
+{
+    class ConvexVolume;
+
+    /**
+     * Cluster of neighbouring triangles of a sub-mesh, stored as a contiguous range of its index buffer. A sub-mesh split
+     * into meshlets can be culled per meshlet instead of as a whole.
+     */
+    struct TE_CORE_EXPORT Meshlet
+    {
+        /** Offset of the first index of the meshlet in the index buffer of the mesh. */
+        UINT32 IndexOffset = 0;
+
+        /** Number of indices of the meshlet, three per triangle. */
+        UINT32 IndexCount = 0;
+
+        /** Number of unique vertices used by the meshlet. */
+        UINT32 VertexCount = 0;
+
+        /** Object space sphere containing every vertex of the meshlet. */
+        Sphere Bounds;
+
+        /**
+         * Axis of the cone containing the normals of every triangle of the meshlet. Normals follow the winding of the
+         * triangles: cross(v1 - v0, v2 - v0).
+         */
+        Vector3 ConeAxis = Vector3::ZERO;
+
+        /**
+         * Cosine of the half angle of the view cone under which every triangle of the meshlet faces away from the viewer.
+         * 1 or more if the normals are too spread out for the meshlet to ever be entirely back facing.
+         */
+        float ConeCutoff = 1.0f;
+    };
+
+    /** Contiguous range of the index buffer of a mesh. */
+    struct TE_CORE_EXPORT MeshletRange
+    {
+        UINT32 IndexOffset = 0;
+        UINT32 IndexCount = 0;
+    };
+
+    /** Builds and culls meshlets. */
+    class TE_CORE_EXPORT MeshletUtility
+    {
+    public:
+        /** Maximum number of unique vertices in a meshlet. */
+        static constexpr UINT32 MAX_VERTICES = 64;
+
+        /** Maximum number of triangles in a meshlet. */
+        static constexpr UINT32 MAX_TRIANGLES = 124;
+
+        /**
+         * Splits a triangle list into meshlets, growing each meshlet from the triangles sharing the most vertices with it.
+         * Triangles are reordered in place so each meshlet is a contiguous range of the list, their winding is kept.
+         *
+         * @param[in]	indices			Index buffer of the mesh, reordered in place in the range of the triangle list.
+         * @param[in]	indexOffset		Offset of the first index of the triangle list in @p indices.
+         * @param[in]	indexCount		Number of indices in the triangle list, a multiple of three.
+         * @param[in]	positions		Vertex positions, as three floats per vertex.
+         * @param[in]	numVertices		Number of vertices in @p positions.
+         * @param[in]	stride			Number of bytes between two positions in @p positions.
+         * @param[out]	meshlets		Meshlets of the triangle list, appended in the order of the index buffer.
+         */
+        static void Build(UINT32* indices, UINT32 indexOffset, UINT32 indexCount, const UINT8* positions,
+            UINT32 numVertices, UINT32 stride, Vector<Meshlet>& meshlets);
+
+        /**
+         * Culls meshlets against a view, and outputs the index ranges of the ones left visible. Consecutive visible
+         * meshlets are merged in a single range.
+         *
+         * @param[in]	meshlets		Meshlets to cull, in the order of the index buffer.
+         * @param[in]	worldTfrm		Transform from object space to world space.
+         * @param[in]	frustum			World space frustum of the view.
+         * @param[in]	viewOrigin		World space position of the view.
+         * @param[in]	backfaceSign	1 to cull meshlets whose normals all face away from the view, -1 to cull meshlets
+         *								whose normals all face the view (meshes rendered with the opposite winding), 0
+         *								to disable back face culling, for meshes rendered two-sided.
+         * @param[in]	maxRanges		Maximum number of ranges to output. Ranges separated by the smallest gaps are
+         *								merged until there are no more than @p maxRanges, 0 for no limit.
+         * @param[out]	ranges			Index ranges of the visible meshlets.
+         * @param[in]	occlusionTest	Optional. Returns false for world space spheres that are hidden from the view.
+         * @return						Number of triangles in the output ranges.
+         */
+        static UINT32 Cull(const Vector<Meshlet>& meshlets, const Matrix4& worldTfrm, const ConvexVolume& frustum,
+            const Vector3& viewOrigin, float backfaceSign, UINT32 maxRanges, Vector<MeshletRange>& ranges,
+            const std::function<bool(const Sphere&)>& occlusionTest = nullptr);
+    };
+}
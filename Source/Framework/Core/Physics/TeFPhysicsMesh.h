@@ -15,6 +15,12 @@ namespace te
         /** @copydoc PhysicsMesh::GetMeshData */
         SPtr<MeshData> GetMeshData() const { return _meshData;  }
 
+        /** @copydoc PhysicsMesh::GetCookedData */
+        virtual Vector<UINT8> GetCookedData() { return Vector<UINT8>(); }
+
+        /** @copydoc PhysicsMesh::SetCookedData */
+        virtual bool SetCookedData(const Vector<UINT8>& data) { return false; }
+
     protected:
         friend class PhysicsMesh;
 
@@ -18,6 +18,28 @@ namespace te
         float WaterOffset = 0.0f;
         Vector3 WaterNormal = Vector3(0.0f, 1.0f, 0.0f);
         bool SoftBody = true;
+        /**
+         * Runs the simulation pipeline on the task scheduler threads, and steps independent scenes concurrently.
+         * Scenes supporting soft bodies still use a single thread for their own simulation. Ignored if the physics
+         * library isn't built thread safe (see the BULLET_THREADSAFE CMake option).
+         */
+        bool MultiThreaded = false;
+        /**
+         * Steps the simulation with a constant time step, accumulating frame time until a whole step is available.
+         * Otherwise each frame is simulated using its own duration.
+         */
+        bool FixedTimeStep = false;
+        float FixedStepRate = 60.0f; /**< Number of simulation steps per second when using a fixed time step. */
+        /**
+         * Maximum number of fixed steps simulated in a single frame. Time the simulation can't catch up with is dropped,
+         * slowing it down instead of making slow frames even slower.
+         */
+        UINT32 MaxStepsPerFrame = 4;
+        /**
+         * Scene objects are placed between the two last simulation steps according to the time left in the accumulator,
+         * so motion stays smooth when the step rate is lower than the frame rate. Only used with a fixed time step.
+         */
+        bool Interpolate = false;
     };
 
     /** Provides global physics settings, factory methods for physics objects and scene queries. */
@@ -228,6 +250,45 @@ namespace te
         virtual bool RayCast(const Vector3& origin, const Vector3& unitDir, Vector<PhysicsQueryHit>& hits,
             float maxDist = FLT_MAX) const = 0;
 
+        /**
+         * Casts many rays at once. Prefer this over multiple calls to RayCast() when many rays are needed during the same
+         * frame, the rays share the same setup and nothing is allocated per ray.
+         *
+         * @param[in]	queries		Rays to cast.
+         * @param[in]	count		Number of rays in @p queries.
+         * @param[out]	hits		Array of at least @p count elements, receiving the closest hit of each ray.
+         * @return					Number of rays that hit something.
+         *
+         * @note	Must not be called while the simulation is being updated.
+         */
+        virtual UINT32 RayCastBatch(const PhysicsRayQuery* queries, UINT32 count, PhysicsBatchHit* hits) const = 0;
+
+        /**
+         * Sweeps many shapes at once along their direction, and reports the closest hit of each one. Works the same as
+         * RayCastBatch().
+         *
+         * @param[in]	queries		Shapes to sweep.
+         * @param[in]	count		Number of shapes in @p queries.
+         * @param[out]	hits		Array of at least @p count elements, receiving the closest hit of each shape.
+         * @return					Number of shapes that hit something.
+         */
+        virtual UINT32 SweepBatch(const PhysicsSweepQuery* queries, UINT32 count, PhysicsBatchHit* hits) const = 0;
+
+        /**
+         * Finds the colliders overlapping each of the provided shapes. Works the same as RayCastBatch().
+         *
+         * @param[in]	queries			Shapes to test.
+         * @param[in]	count			Number of shapes in @p queries.
+         * @param[out]	hits			Array of at least @p count * @p maxHitsPerQuery elements. Colliders found by the
+         *								query i are written starting at index i * @p maxHitsPerQuery.
+         * @param[in]	maxHitsPerQuery	Maximum number of colliders reported for a single query. Others are ignored.
+         * @param[out]	numHits			Array of at least @p count elements, receiving the number of colliders found
+         *								by each query.
+         * @return						Total number of colliders found.
+         */
+        virtual UINT32 OverlapBatch(const PhysicsOverlapQuery* queries, UINT32 count, PhysicsOverlapHit* hits,
+            UINT32 maxHitsPerQuery, UINT32* numHits) const = 0;
+
     protected:
         PhysicsScene() = default;
         virtual ~PhysicsScene() = default;
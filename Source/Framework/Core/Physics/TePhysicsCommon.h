@@ -2,6 +2,9 @@
 
 #include "TeCorePrerequisites.h"
 #include "Math/TeVector3.h"
+#include "Math/TeQuaternion.h"
+
+#include <cfloat>
 
 namespace te
 { 
@@ -81,4 +84,76 @@ namespace te
         HBody HitBody;
         Body* HitBodyRaw = nullptr;
     };
+
+    /** Layers physics objects are assigned to depending on their type. Used to filter scene queries. */
+    enum class PhysicsQueryLayer : UINT32
+    {
+        Dynamic = 1 << 0, /**< Dynamic bodies. */
+        Static = 1 << 1, /**< Static and kinematic bodies. */
+        All = 0xFFFFFFFF
+    };
+
+    /** Type of geometry used by sweep and overlap scene queries. */
+    enum class PhysicsQueryShapeType
+    {
+        Sphere, /**< Sphere of radius Extents.x. */
+        Capsule, /**< Capsule aligned on the Y axis, of radius Extents.x. Extents.y is the distance between the cap centers. */
+        Box /**< Box of half size Extents. */
+    };
+
+    /** Geometry used by sweep and overlap scene queries. */
+    struct PhysicsQueryShape
+    {
+        PhysicsQueryShapeType Type = PhysicsQueryShapeType::Sphere;
+        Vector3 Extents = Vector3(0.5f, 0.5f, 0.5f); /**< Size of the shape, see PhysicsQueryShapeType. */
+        Quaternion Rotation = Quaternion::IDENTITY; /**< Orientation of the shape in world space. */
+    };
+
+    /** Single ray of a batched ray cast. */
+    struct PhysicsRayQuery
+    {
+        Vector3 Origin = Vector3::ZERO; /**< Origin of the ray. */
+        Vector3 UnitDir = Vector3::UNIT_Z; /**< Unit direction of the ray. */
+        float MaxDist = FLT_MAX; /**< Maximum distance from the origin to search for hits. */
+        UINT32 LayerMask = (UINT32)PhysicsQueryLayer::All; /**< Combination of PhysicsQueryLayer to consider. */
+    };
+
+    /** Single shape of a batched sweep. */
+    struct PhysicsSweepQuery
+    {
+        PhysicsQueryShape Shape; /**< Shape to sweep. */
+        Vector3 Origin = Vector3::ZERO; /**< Starting position of the shape center. */
+        Vector3 UnitDir = Vector3::UNIT_Z; /**< Unit direction to sweep the shape along. */
+        float MaxDist = FLT_MAX; /**< Maximum distance to sweep the shape along the direction. */
+        UINT32 LayerMask = (UINT32)PhysicsQueryLayer::All; /**< Combination of PhysicsQueryLayer to consider. */
+    };
+
+    /** Single shape of a batched overlap test. */
+    struct PhysicsOverlapQuery
+    {
+        PhysicsQueryShape Shape; /**< Shape to test. */
+        Vector3 Position = Vector3::ZERO; /**< Position of the shape center. */
+        UINT32 LayerMask = (UINT32)PhysicsQueryLayer::All; /**< Combination of PhysicsQueryLayer to consider. */
+    };
+
+    /**
+     * Closest hit of a batched ray cast or sweep. Unlike PhysicsQueryHit, components are not resolved so results can be
+     * written without any allocation.
+     */
+    struct PhysicsBatchHit
+    {
+        Vector3 Point = Vector3::ZERO; /**< Position of the hit in world space. */
+        Vector3 Normal = Vector3::ZERO; /**< Normal to the surface that was hit. */
+        float Distance = 0.0f; /**< Distance travelled by the query until the hit. */
+        Body* HitBodyRaw = nullptr; /**< Body that was hit. */
+        Collider* HitColliderRaw = nullptr; /**< Collider that was hit, null if it couldn't be determined. */
+        bool HasHit = false; /**< False if nothing was hit, in which case other fields are not valid. */
+    };
+
+    /** Object found by a batched overlap test. */
+    struct PhysicsOverlapHit
+    {
+        Body* HitBodyRaw = nullptr; /**< Body overlapping the query shape. */
+        Collider* HitColliderRaw = nullptr; /**< Collider of the body overlapping the query shape. */
+    };
 }
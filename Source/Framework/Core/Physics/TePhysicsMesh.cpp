@@ -20,6 +20,16 @@ namespace te
         return _internal->GetMeshData();
     }
 
+    Vector<UINT8> PhysicsMesh::GetCookedData() const
+    {
+        return _internal->GetCookedData();
+    }
+
+    bool PhysicsMesh::SetCookedData(const Vector<UINT8>& data)
+    {
+        return _internal->SetCookedData(data);
+    }
+
     HPhysicsMesh PhysicsMesh::Create(const SPtr<MeshData>& meshData)
     {
         if (meshData)
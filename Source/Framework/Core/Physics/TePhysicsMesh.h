@@ -24,6 +24,19 @@ namespace te
         /** Returns the mesh's indices and vertices. */
         SPtr<MeshData> GetMeshData() const;
 
+        /**
+         * Returns the collision data cooked from the mesh by the physics implementation, such as its acceleration
+         * structure and convex hull. It can be stored along the mesh and restored with SetCookedData() so the mesh isn't
+         * cooked again when loaded. Empty if the implementation doesn't cook meshes.
+         */
+        Vector<UINT8> GetCookedData() const;
+
+        /**
+         * Restores collision data returned by GetCookedData() for the same mesh data. Must be called before any collider
+         * uses the mesh. Returns false if the data doesn't match the mesh, in which case it is cooked on first use.
+         */
+        bool SetCookedData(const Vector<UINT8>& data);
+
         /**
          * Creates a new physics mesh.
          *
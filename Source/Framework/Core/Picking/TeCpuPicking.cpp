@@ -0,0 +1,193 @@
+#include "Picking/TeCpuPicking.h"
+
+#include "Mesh/TeMesh.h"
+#include "Mesh/TeMeshBvh.h"
+#include "Math/TeRay.h"
+#include "Scene/TeSceneObject.h"
+#include "Components/TeCCamera.h"
+#include "Components/TeCRenderable.h"
+
+namespace te
+{
+    void CpuPicking::Build(const HSceneObject& root)
+    {
+        Clear();
+
+        if (root.IsDestroyed())
+            return;
+
+        Vector<AABox> bounds;
+        CollectInstances(root, bounds);
+
+        Vector<UINT32> order;
+        _depth = Bvh::Build(bounds, MAX_LEAF_INSTANCES, _nodes, order);
+
+        // Instances are stored in leaf order, leaves then reference them directly
+        Vector<Instance> instances(order.size());
+        for (UINT32 i = 0; i < (UINT32)order.size(); i++)
+            instances[i] = std::move(_instances[order[i]]);
+
+        _instances = std::move(instances);
+    }
+
+    void CpuPicking::Clear()
+    {
+        _instances.clear();
+        _nodes.clear();
+        _depth = 0;
+    }
+
+    void CpuPicking::CollectInstances(const HSceneObject& sceneObject, Vector<AABox>& bounds)
+    {
+        for (const auto& component : sceneObject->GetComponents())
+        {
+            if (component->GetCoreType() != TypeID_Core::TID_CRenderable)
+                continue;
+
+            HRenderable renderable = static_object_cast<CRenderable>(component);
+            if (!renderable->GetActive())
+                continue;
+
+            SPtr<Mesh> mesh = renderable->GetMesh();
+            if (mesh == nullptr)
+                continue;
+
+            SPtr<MeshBvh> meshHierarchy = mesh->GetBvh();
+            if (meshHierarchy == nullptr)
+            {
+                TE_DEBUG("Mesh \"" + mesh->GetName() + "\" has no data in system memory and can't be picked on the CPU. "
+                    "Create it from mesh data, or with the MU_CPUCACHED usage.");
+                continue;
+            }
+
+            if (meshHierarchy->GetNumTriangles() == 0)
+                continue;
+
+            bounds.push_back(renderable->GetBounds().GetBox());
+            _instances.push_back({ renderable, meshHierarchy, renderable->GetMatrix().InverseAffine() });
+        }
+
+        for (const auto& childSO : sceneObject->GetChildren())
+            CollectInstances(childSO, bounds);
+    }
+
+    bool CpuPicking::RayCast(const Ray& ray, PickingHit& hit, float maxDistance) const
+    {
+        if (_instances.empty())
+            return false;
+
+        const Vector3& origin = ray.GetOrigin();
+        const Vector3 invDir = Bvh::InverseDirection(ray.GetDirection());
+
+        float closest = maxDistance;
+        UINT32 closestInstance = (UINT32)-1;
+        MeshRayHit closestHit;
+
+        UINT32 localStack[64];
+        Vector<UINT32> heapStack;
+        UINT32* stack = localStack;
+        if (_depth >= 64)
+        {
+            heapStack.resize(_depth + 1);
+            stack = heapStack.data();
+        }
+
+        UINT32 stackSize = 0;
+        UINT32 nodeIdx = 0;
+
+        float rootDistance;
+        if (!Bvh::Intersects(_nodes[0], origin, invDir, closest, rootDistance))
+            return false;
+
+        while (true)
+        {
+            const BvhNode& node = _nodes[nodeIdx];
+
+            if (node.Count > 0)
+            {
+                for (UINT32 i = node.First; i < node.First + node.Count; i++)
+                {
+                    const Instance& instance = _instances[i];
+
+                    // The direction isn't normalized after the transform, so distances along the local ray are the
+                    // same as along the world ray, even with a scale
+                    const Matrix4& worldToLocal = instance.WorldToLocal;
+                    const Ray localRay(worldToLocal.MultiplyAffine(origin), worldToLocal.MultiplyDirection(ray.GetDirection()));
+
+                    MeshRayHit meshHit;
+                    if (instance.MeshHierarchy->RayCast(localRay, meshHit, closest))
+                    {
+                        closest = meshHit.Distance;
+                        closestInstance = i;
+                        closestHit = meshHit;
+                    }
+                }
+            }
+            else
+            {
+                float leftDistance, rightDistance;
+                const bool hitLeft = Bvh::Intersects(_nodes[node.First], origin, invDir, closest, leftDistance);
+                const bool hitRight = Bvh::Intersects(_nodes[node.First + 1], origin, invDir, closest, rightDistance);
+
+                if (hitLeft && hitRight)
+                {
+                    const bool leftFirst = leftDistance <= rightDistance;
+                    stack[stackSize++] = leftFirst ? node.First + 1 : node.First;
+                    nodeIdx = leftFirst ? node.First : node.First + 1;
+                    continue;
+                }
+
+                if (hitLeft || hitRight)
+                {
+                    nodeIdx = hitLeft ? node.First : node.First + 1;
+                    continue;
+                }
+            }
+
+            bool found = false;
+            while (stackSize > 0)
+            {
+                nodeIdx = stack[--stackSize];
+
+                float distance;
+                if (Bvh::Intersects(_nodes[nodeIdx], origin, invDir, closest, distance))
+                {
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+                break;
+        }
+
+        if (closestInstance == (UINT32)-1)
+            return false;
+
+        hit.Renderable = _instances[closestInstance].Renderable;
+        hit.SubMeshIdx = closestHit.SubMeshIdx;
+        hit.IndexOffset = closestHit.IndexOffset;
+        hit.Distance = closest;
+        hit.Position = ray.GetPoint(closest);
+        hit.Barycentrics = closestHit.Barycentrics;
+
+        return true;
+    }
+
+    bool CpuPicking::Pick(const HCamera& camera, const Vector2I& pixel, PickingHit& hit) const
+    {
+        if (camera.IsDestroyed())
+            return false;
+
+        return RayCast(camera->ScreenPointToRay(pixel), hit);
+    }
+
+    SPtr<GameObject> CpuPicking::GetGameObjectAt(const HCamera& camera, const Vector2I& pixel) const
+    {
+        PickingHit hit;
+        if (!Pick(camera, pixel, hit) || hit.Renderable.IsDestroyed())
+            return nullptr;
+
+        return hit.Renderable.GetInternalPtr();
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Math/TeBvh.h"
+#include "Math/TeMatrix4.h"
+#include "Math/TeVector2.h"
+#include "Math/TeVector2I.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    class Ray;
+
+    /** Closest renderable hit by a picking ray. */
+    struct TE_CORE_EXPORT PickingHit
+    {
+        /** Renderable whose mesh is hit. */
+        HRenderable Renderable;
+
+        /** Index of the hit sub-mesh. */
+        UINT32 SubMeshIdx = 0;
+
+        /** Offset of the first index of the hit triangle in the index buffer of the mesh. */
+        UINT32 IndexOffset = 0;
+
+        /** Distance from the ray origin, in world units if the ray direction is normalized. */
+        float Distance = 0.0f;
+
+        /** World space position of the hit. */
+        Vector3 Position = Vector3::ZERO;
+
+        /**
+         * Weights of the second and third vertices of the triangle at the hit position. The first vertex weighs
+         * 1 - x - y.
+         */
+        Vector2 Barycentrics = Vector2::ZERO;
+    };
+
+    /**
+     * Picks renderables on the CPU by casting rays through a two-level bounding volume hierarchy, instead of rendering
+     * and reading back an id buffer like Picking does. The top level is built over the world bounds of the renderables
+     * of a scene, the bottom level is the triangle hierarchy each mesh caches (Mesh::GetBvh()). Only needs meshes with
+     * CPU data, so it works without a render API too. Skinned and morphed meshes are picked in their bind pose.
+     */
+    class TE_CORE_EXPORT CpuPicking
+    {
+    public:
+        /** Maximum number of renderables in a leaf of the top level hierarchy. */
+        static constexpr UINT32 MAX_LEAF_INSTANCES = 2;
+
+        CpuPicking() = default;
+        ~CpuPicking() = default;
+
+        /**
+         * Collects the active renderables under @p root and builds the top level hierarchy over their world bounds. Needs
+         * to be called again once renderables move, are added or removed. Renderables whose mesh has no data in system
+         * memory are skipped with a warning.
+         */
+        void Build(const HSceneObject& root);
+
+        /** Forgets every renderable collected by the last Build(). */
+        void Clear();
+
+        /**
+         * Finds the closest renderable triangle hit by a world space ray.
+         *
+         * @param[in]	ray			World space ray.
+         * @param[out]	hit			Closest hit, only written when a triangle is hit.
+         * @param[in]	maxDistance	Triangles further than this are ignored.
+         * @return					True if a triangle is hit.
+         */
+        bool RayCast(const Ray& ray, PickingHit& hit, float maxDistance = std::numeric_limits<float>::max()) const;
+
+        /** Finds the closest renderable triangle under a pixel of the viewport of @p camera. */
+        bool Pick(const HCamera& camera, const Vector2I& pixel, PickingHit& hit) const;
+
+        /** Returns the renderable under a pixel of the viewport of @p camera, or null if there is none. */
+        SPtr<GameObject> GetGameObjectAt(const HCamera& camera, const Vector2I& pixel) const;
+
+        /** Returns the number of renderables collected by the last Build(). */
+        UINT32 GetNumInstances() const { return (UINT32)_instances.size(); }
+
+    private:
+        /** Renderable collected in the top level hierarchy. */
+        struct Instance
+        {
+            HRenderable Renderable;
+            SPtr<MeshBvh> MeshHierarchy;
+            Matrix4 WorldToLocal;
+        };
+
+        /** Adds the active renderables of @p sceneObject and of its children to the instances. */
+        void CollectInstances(const HSceneObject& sceneObject, Vector<AABox>& bounds);
+
+    private:
+        Vector<Instance> _instances;
+        Vector<BvhNode> _nodes;
+        UINT32 _depth = 0;
+    };
+}
@@ -2,6 +2,7 @@
 
 #include "Components/TeCRenderable.h"
 #include "Components/TeCCamera.h"
+#include "Mesh/TeMesh.h"
 
 namespace te
 {
@@ -32,6 +33,15 @@ namespace te
         _perObjectParamDef.gMatWorld.Set(_perObjectParamBuffer, renderable->GetMatrix());
         _perObjectParamDef.gColor.Set(_perObjectParamBuffer, renderable->GetGameObjectColor().GetAsVector4());
         _perObjectParamDef.gHasAnimation.Set(_perObjectParamBuffer, renderable->IsAnimated() ? 1 : 0);
+        _perObjectParamDef.gBoneOffset.Set(_perObjectParamBuffer, renderable->GetInternal()->GetBoneMatrixOffset());
+
+        SPtr<Mesh> mesh = renderable->GetMesh();
+        bool compactVertices = mesh != nullptr && mesh->GetProperties().HasCompactVertices();
+        _perObjectParamDef.gCompactVertices.Set(_perObjectParamBuffer, compactVertices ? 1 : 0);
+        _perObjectParamDef.gPositionScale.Set(_perObjectParamBuffer,
+            Vector4(compactVertices ? mesh->GetProperties().GetPositionScale() : Vector3::ONE, 0.0f));
+        _perObjectParamDef.gPositionBias.Set(_perObjectParamBuffer,
+            Vector4(compactVertices ? mesh->GetProperties().GetPositionBias() : Vector3::ZERO, 0.0f));
 
         if (renderable->GetMobility() != ObjectMobility::Static)
         {
@@ -71,6 +71,14 @@ namespace te
         _sample.NumResourceWrites = 0;
         _sample.NumResourceReads = 0;
 
+        _sample.NumObjectDataWrites = 0;
+        _sample.NumObjectDataUploads = 0;
+        _sample.ObjectDataUploadedBytes = 0;
+
+        _sample.NumTransientTextures = 0;
+        _sample.TransientTexturesMemory = 0;
+        _sample.TransientTexturesDeclaredMemory = 0;
+
         _sample.NumObjectsCreated = 0;
         _sample.NumObjectsDestroyed = 0;
 
@@ -207,6 +215,54 @@ namespace te
         _sample.NumResourceWrites++;
     }
 
+    void ProfilerGPU::AddNumObjectDataWrites(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumObjectDataWrites += count;
+    }
+
+    void ProfilerGPU::AddNumObjectDataUploads(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumObjectDataUploads += count;
+    }
+
+    void ProfilerGPU::AddObjectDataUploadedBytes(UINT64 size)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.ObjectDataUploadedBytes += size;
+    }
+
+    void ProfilerGPU::AddNumTransientTextures(UINT32 count)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.NumTransientTextures += count;
+    }
+
+    void ProfilerGPU::AddTransientTexturesMemory(UINT64 size)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.TransientTexturesMemory += size;
+    }
+
+    void ProfilerGPU::AddTransientTexturesDeclaredMemory(UINT64 size)
+    {
+        if (!_frameBegan)
+            return;
+
+        _sample.TransientTexturesDeclaredMemory += size;
+    }
+
     ProfilerGPU& gProfilerGPU()
     {
         return ProfilerGPU::Instance();
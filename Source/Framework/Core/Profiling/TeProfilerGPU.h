@@ -38,6 +38,14 @@ namespace te
         UINT32 NumResourceWrites = 0; /**< How many times were GPU resources written to. */
         UINT32 NumResourceReads = 0; /**< How many times were GPU resources read from. */
 
+        UINT32 NumObjectDataWrites = 0; /**< How many times was the per-object data of a renderable written. */
+        UINT32 NumObjectDataUploads = 0; /**< How many separate writes sent per-object data to the GPU. */
+        UINT64 ObjectDataUploadedBytes = 0; /**< How many bytes of per-object data were sent to the GPU. */
+
+        UINT32 NumTransientTextures = 0; /**< How many pooled textures the compositor transient textures used. */
+        UINT64 TransientTexturesMemory = 0; /**< Memory, in bytes, of the pooled textures used by transient textures. */
+        UINT64 TransientTexturesDeclaredMemory = 0; /**< Memory, in bytes, they would use without aliasing. */
+
         UINT32 NumObjectsCreated = 0; /**< How many GPU objects were created. */
         UINT32 NumObjectsDestroyed = 0; /**< How many GPU objects were destroyed. */
 
@@ -127,6 +135,24 @@ namespace te
         /** Increments GPU resource write counter. */
         void IncResWrite();
 
+        /** Increments the counter of per-object data writes, in per-object buffers or in the GPU scene. */
+        void AddNumObjectDataWrites(UINT32 count);
+
+        /** Increments the counter of writes sending per-object data to the GPU. */
+        void AddNumObjectDataUploads(UINT32 count);
+
+        /** Increments the amount of per-object data sent to the GPU, in bytes. */
+        void AddObjectDataUploadedBytes(UINT64 size);
+
+        /** Increments the counter of pooled textures used by the transient textures of the render compositor. */
+        void AddNumTransientTextures(UINT32 count);
+
+        /** Increments the memory used by the transient textures of the render compositor, in bytes. */
+        void AddTransientTexturesMemory(UINT64 size);
+
+        /** Increments the memory the compositor transient textures would use without aliasing, in bytes. */
+        void AddTransientTexturesDeclaredMemory(UINT64 size);
+
     private:
         /*
          * Reset all metric from previous frame 
@@ -144,6 +144,11 @@ namespace te
     enum class ShaderFlag
     {
         Transparent = 0x1, /**< Signifies that the shader is rendering a transparent object. */
+        /**
+         * Signifies that what the shader renders changes over time even if its inputs don't, for instance because it
+         * animates with gTime. Views drawing it are rendered every frame.
+         */
+        Animated = 0x2,
     };
 
     /** These values represent a hint to the driver when locking a hardware buffer. */
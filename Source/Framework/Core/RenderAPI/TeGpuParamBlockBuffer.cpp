@@ -47,6 +47,7 @@ namespace te
 
         memcpy(_cachedData + offset, data, size);
         _GPUBufferDirty = true;
+        _contentVersion++;
     }
 
     void GpuParamBlockBuffer::Read(UINT32 offset, void* data, UINT32 size)
@@ -75,6 +76,7 @@ namespace te
 
         memset(_cachedData + offset, 0, size);
         _GPUBufferDirty = true;
+        _contentVersion++;
     }
 
     void GpuParamBlockBuffer::FlushToGPU(UINT32 queueIdx)
@@ -90,6 +92,9 @@ namespace te
     {
         _buffer->WriteData(0, _size, data, BWT_DISCARD, queueIdx);
         TE_INC_PROFILER_GPU(ResWrite);
+
+        if (data != _cachedData)
+            _contentVersion++;
     }
 
     SPtr<GpuParamBlockBuffer> GpuParamBlockBuffer::Create(UINT32 size, GpuBufferUsage usage, GpuDeviceFlags deviceMask)
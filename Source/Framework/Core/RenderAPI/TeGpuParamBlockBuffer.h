@@ -59,6 +59,9 @@ namespace te
         /**	Returns the size of the buffer in bytes. */
         UINT32 GetSize() const { return _size; }
 
+        /** Returns a value incremented whenever the contents of the buffer are written. Flushes don't change it. */
+        UINT32 GetContentVersion() const { return _contentVersion; }
+
         /** @copydoc HardwareBufferManager::CreateGpuParamBlockBuffer */
         static SPtr<GpuParamBlockBuffer> Create(UINT32 size, GpuBufferUsage usage = GBU_DYNAMIC,
             GpuDeviceFlags deviceMask = GDF_DEFAULT);
@@ -75,5 +78,6 @@ namespace te
         UINT32 _size;
         UINT8* _cachedData;
         bool _GPUBufferDirty = false;
+        UINT32 _contentVersion = 0;
     };
 }
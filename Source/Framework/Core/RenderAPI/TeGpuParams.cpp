@@ -454,6 +454,43 @@ namespace te
         }
     }
 
+    GpuParams::ParamBlockHandle GpuParams::GetParamBlockHandle(const String& name) const
+    {
+        ParamBlockHandle handle;
+
+        for (UINT32 i = 0; i < GPT_COUNT; i++)
+        {
+            const SPtr<GpuParamDesc>& paramDescs = _paramInfo->GetParamDesc((GpuProgramType)i);
+            if (paramDescs == nullptr)
+                continue;
+
+            auto iterFind = paramDescs->ParamBlocks.find(name);
+            if (iterFind == paramDescs->ParamBlocks.end())
+                continue;
+
+            UINT32 globalSlot = _paramInfo->GetSequentialSlot(GpuPipelineParamInfo::ParamType::ParamBlock,
+                iterFind->second.Set, iterFind->second.Slot);
+            if (globalSlot == (UINT32)-1)
+                continue;
+
+            // Stages sharing the block use the same slot
+            UINT32* slotsEnd = handle.SequentialSlots + handle.NumSlots;
+            if (std::find(handle.SequentialSlots, slotsEnd, globalSlot) == slotsEnd)
+                handle.SequentialSlots[handle.NumSlots++] = globalSlot;
+        }
+
+        return handle;
+    }
+
+    void GpuParams::SetParamBlockBuffer(const ParamBlockHandle& handle, const SPtr<GpuParamBlockBuffer>& paramBlockBuffer)
+    {
+        for (UINT32 i = 0; i < handle.NumSlots; i++)
+            _paramBlockBuffers[handle.SequentialSlots[i]] = paramBlockBuffer;
+
+        if (handle.NumSlots > 0)
+            _hasChanged = true;
+    }
+
     void GpuParams::SetTexture(GpuProgramType type, const String& name, const SPtr<Texture>& texture, const TextureSurface& surface)
     {
         const SPtr<GpuParamDesc>& paramDescs = _paramInfo->GetParamDesc(type);
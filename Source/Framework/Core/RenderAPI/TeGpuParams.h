@@ -36,6 +36,13 @@ namespace te
         /** Surface that covers all texture sub-resources. */
         static const TextureSurface COMPLETE;
 
+        /** Parameter block found in the stages of a pipeline, see GetParamBlockHandle(). */
+        struct ParamBlockHandle
+        {
+            UINT32 SequentialSlots[GPT_COUNT];
+            UINT32 NumSlots = 0;
+        };
+
         virtual ~GpuParams();
 
         /** Allow to know if a parameter has changed */
@@ -127,6 +134,19 @@ namespace te
          */
         void SetParamBlockBuffer(UINT32 set, UINT32 slot, const SPtr<GpuParamBlockBuffer>& paramBlockBuffer);
 
+        /**
+         * Finds the parameter block with the specified name in every stage that references it. The handle is valid for
+         * all GpuParams created from the same pipeline, use it to assign blocks set for every draw without name lookups.
+         */
+        ParamBlockHandle GetParamBlockHandle(const String& name) const;
+
+        /**
+         * Assigns the provided parameter block buffer to the block @p handle refers to, returned by GetParamBlockHandle().
+         *
+         * It is up to the caller to guarantee the provided buffer matches parameter block descriptor for this slot.
+         */
+        void SetParamBlockBuffer(const ParamBlockHandle& handle, const SPtr<GpuParamBlockBuffer>& paramBlockBuffer);
+
         /**
          * Assigns the provided texture to a buffer with the specified name, for the specified GPU program
          * It is up to the caller to guarantee the provided buffer matches parameter block descriptor for this slot.
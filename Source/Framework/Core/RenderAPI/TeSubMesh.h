@@ -3,6 +3,7 @@
 #include "TeCorePrerequisites.h"
 #include "Material/TeMaterial.h"
 #include "Math/TeBounds.h"
+#include "Mesh/TeMeshlet.h"
 
 namespace te
 {
@@ -42,5 +43,11 @@ namespace te
 
         /** During mesh initialization, we also want to know bounds of a single subMesh below a mesh */
         Bounds SubMeshBounds;
+
+        /**
+         * Clusters of triangles of the sub-mesh, covering its whole index range, in the order of the index buffer. Empty
+         * if the sub-mesh wasn't split into meshlets during import, in which case it can only be culled as a whole.
+         */
+        Vector<Meshlet> Meshlets;
     };
 }
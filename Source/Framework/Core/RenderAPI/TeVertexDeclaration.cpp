@@ -49,9 +49,15 @@ namespace te
         case VET_SHORT1:
             return sizeof(INT16);
         case VET_SHORT2:
+        case VET_SHORT2_NORM:
             return sizeof(INT16) * 2;
         case VET_SHORT4:
+        case VET_SHORT4_NORM:
             return sizeof(INT16) * 4;
+        case VET_HALF2:
+            return sizeof(UINT16) * 2;
+        case VET_HALF4:
+            return sizeof(UINT16) * 4;
         case VET_UINT1:
             return sizeof(UINT32);
         case VET_UINT2:
@@ -92,7 +98,9 @@ namespace te
         case VET_UINT1:
             return 1;
         case VET_FLOAT2:
+        case VET_HALF2:
         case VET_SHORT2:
+        case VET_SHORT2_NORM:
         case VET_USHORT2:
         case VET_INT2:
         case VET_UINT2:
@@ -102,7 +110,9 @@ namespace te
         case VET_UINT3:
             return 3;
         case VET_FLOAT4:
+        case VET_HALF4:
         case VET_SHORT4:
+        case VET_SHORT4_NORM:
         case VET_USHORT4:
         case VET_INT4:
         case VET_UINT4:
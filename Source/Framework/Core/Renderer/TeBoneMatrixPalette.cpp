@@ -0,0 +1,79 @@
+#include "Renderer/TeBoneMatrixPalette.h"
+#include "Animation/TeAnimationManager.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "Utility/TeTime.h"
+
+namespace te
+{
+    TE_MODULE_STATIC_MEMBER(BoneMatrixPalette)
+
+    namespace
+    {
+        /** Smallest number of bones a segment is created with, to avoid re-creating the buffer for the first few meshes. */
+        constexpr UINT32 MIN_SEGMENT_SIZE = 256;
+    }
+
+    void BoneMatrixPalette::Update(const EvaluatedAnimationData& animData)
+    {
+        UINT64 frameIdx = gTime().GetFrameIdx();
+        if (frameIdx == _lastUpdateFrame)
+            return;
+
+        _lastUpdateFrame = frameIdx;
+
+        UINT32 numBones = (UINT32)animData.Transforms.size();
+        if (numBones == 0)
+            return;
+
+        // Grow with some headroom, since the number of animated bones tends to increase as more characters are spawned
+        if (numBones > _segmentSize)
+            Resize(_identitySize, std::max(MIN_SEGMENT_SIZE, numBones + numBones / 2));
+
+        _segmentIdx = (_segmentIdx + 1) % NUM_SEGMENTS;
+        _frameOffset = _identitySize + _segmentIdx * _segmentSize;
+
+        // Segments of the two previous frames are left untouched, so there's no need to discard the buffer
+        const UINT32 size = numBones * sizeof(Matrix4);
+        void* dest = _buffer->Lock(_frameOffset * sizeof(Matrix4), size, GBL_WRITE_ONLY_NO_OVERWRITE);
+        memcpy(dest, animData.Transforms.data(), size); // Assuming row-major format
+        _buffer->Unlock();
+    }
+
+    void BoneMatrixPalette::ReserveIdentity(UINT32 numBones)
+    {
+        if (numBones > _identitySize || _buffer == nullptr)
+            Resize(std::max(numBones, _identitySize), std::max(MIN_SEGMENT_SIZE, _segmentSize));
+    }
+
+    void BoneMatrixPalette::Resize(UINT32 identitySize, UINT32 segmentSize)
+    {
+        _identitySize = identitySize;
+        _segmentSize = segmentSize;
+        _frameOffset = _identitySize;
+        _segmentIdx = 0;
+
+        const UINT32 numMatrices = _identitySize + _segmentSize * NUM_SEGMENTS;
+
+        GPU_BUFFER_DESC desc;
+        desc.ElementCount = numMatrices * 4;
+        desc.ElementSize = 0;
+        desc.Type = GBT_STANDARD;
+        desc.Format = BF_32X4F;
+        desc.Usage = GBU_DYNAMIC;
+
+        _buffer = GpuBuffer::Create(desc);
+        _version++;
+
+        // Initialize every matrix to identity, so renderables render properly even if nothing animates them
+        Matrix4* dest = (Matrix4*)_buffer->Lock(0, numMatrices * sizeof(Matrix4), GBL_WRITE_ONLY_DISCARD);
+        for (UINT32 i = 0; i < numMatrices; i++)
+            dest[i] = Matrix4::IDENTITY;
+
+        _buffer->Unlock();
+    }
+
+    BoneMatrixPalette& gBoneMatrixPalette()
+    {
+        return BoneMatrixPalette::Instance();
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+#include "Utility/TeModule.h"
+
+namespace te
+{
+    struct EvaluatedAnimationData;
+
+    /**
+     * Single GPU buffer holding the bone matrices of every skinned renderable. Matrices evaluated by the
+     * AnimationManager are uploaded once per frame with a single map, and each renderable indexes into the buffer using
+     * the offset of its pose.
+     *
+     * The buffer starts with a block of identity matrices, used by renderables that don't have an evaluated pose yet,
+     * followed by NUM_SEGMENTS segments used as a ring buffer: every frame writes to its own segment without overwriting
+     * data the GPU might still be reading, and the previous frame's matrices stay available for velocity.
+     */
+    class TE_CORE_EXPORT BoneMatrixPalette : public Module<BoneMatrixPalette>
+    {
+    public:
+        TE_MODULE_STATIC_HEADER_MEMBER(BoneMatrixPalette)
+
+        /** Number of frames whose matrices are kept in the buffer at the same time. */
+        static constexpr UINT32 NUM_SEGMENTS = 3;
+
+        /**
+         * Uploads all the bone matrices of @p animData to the next segment of the buffer, growing the buffer if
+         * required. Only the first call on a given frame does anything.
+         */
+        void Update(const EvaluatedAnimationData& animData);
+
+        /**
+         * Makes sure the identity block holds at least @p numBones matrices. Must be called before Update() on the frame
+         * the bones are used on, since growing the buffer discards its contents.
+         */
+        void ReserveIdentity(UINT32 numBones);
+
+        /** Returns the buffer containing the matrices. Null until bones were reserved or uploaded. */
+        const SPtr<GpuBuffer>& GetBuffer() const { return _buffer; }
+
+        /**
+         * Returns the index of the first matrix uploaded by the last call to Update(). Matrices of a pose start at this
+         * offset plus EvaluatedAnimationData::PoseInfo::StartIdx.
+         */
+        UINT32 GetFrameOffset() const { return _frameOffset; }
+
+        /** Returns the index of the first matrix of the identity block. */
+        UINT32 GetIdentityOffset() const { return 0; }
+
+        /**
+         * Returns a value that changes whenever the buffer is re-created. Offsets retrieved with an older version don't
+         * point to valid data anymore.
+         */
+        UINT32 GetVersion() const { return _version; }
+
+    private:
+        /** Re-creates the buffer with the provided capacities, and fills the identity block. */
+        void Resize(UINT32 identitySize, UINT32 segmentSize);
+
+        SPtr<GpuBuffer> _buffer;
+        UINT32 _identitySize = 0;
+        UINT32 _segmentSize = 0;
+        UINT32 _segmentIdx = 0;
+        UINT32 _frameOffset = 0;
+        UINT32 _version = 0;
+        UINT64 _lastUpdateFrame = (UINT64)-1;
+    };
+
+    /** Provides easier access to BoneMatrixPalette. */
+    TE_CORE_EXPORT BoneMatrixPalette& gBoneMatrixPalette();
+}
@@ -2,6 +2,7 @@
 #include "RenderAPI/TeRenderTexture.h"
 #include "Image/TeTexture.h"
 #include "RenderAPI/TeGpuBuffer.h"
+#include "Image/TePixelUtil.h"
 
 namespace te
 {
@@ -9,7 +10,8 @@ namespace te
 
     SPtr<PooledRenderTexture> GpuResourcePool::Get(const POOLED_RENDER_TEXTURE_DESC& desc)
     {
-        for (auto& entry : _textures)
+        Vector<SPtr<PooledRenderTexture>>& bucket = _textures[desc.GetHash()];
+        for (auto& entry : bucket)
         {
             bool isFree = entry.use_count() == 1;
             if (!isFree)
@@ -26,7 +28,7 @@ namespace te
         }
 
         SPtr<PooledRenderTexture> newTexture = te_shared_ptr_new<PooledRenderTexture>(_currentFrame);
-        _textures.push_back(newTexture);
+        bucket.push_back(newTexture);
 
         _allocationsCountSinceLastPrune++;
 
@@ -83,7 +85,8 @@ namespace te
 
     SPtr<PooledStorageBuffer> GpuResourcePool::Get(const POOLED_STORAGE_BUFFER_DESC& desc)
     { 
-        for (auto& entry : _buffers)
+        Vector<SPtr<PooledStorageBuffer>>& bucket = _buffers[desc.GetHash()];
+        for (auto& entry : bucket)
         {
             bool isFree = entry.use_count() == 1;
             if (!isFree)
@@ -100,7 +103,7 @@ namespace te
         }
 
         SPtr<PooledStorageBuffer> newBuffer = te_shared_ptr_new<PooledStorageBuffer>(_currentFrame);
-        _buffers.push_back(newBuffer);
+        bucket.push_back(newBuffer);
 
         GPU_BUFFER_DESC bufferDesc;
         bufferDesc.Type = desc.Type;
@@ -139,41 +142,38 @@ namespace te
         if (pruneAge < age)
             return;
 
-        for (auto iter = _textures.begin(); iter != _textures.end();)
+        auto PruneBuckets = [this, age](auto& buckets)
         {
-            auto& entry = *iter;
-
-            bool isFree = entry.use_count() == 1;
-            if (!isFree)
-            {
-                ++iter;
-                continue;
-            }
-
-            UINT32 entryAge = _currentFrame - entry->_lastUsedFrame;
-            if (entryAge >= age)
-                iter = _textures.erase(iter);
-            else
-                ++iter;
-        }
-
-        for (auto iter = _buffers.begin(); iter != _buffers.end();)
-        {
-            auto& entry = *iter;
-
-            bool isFree = entry.use_count() == 1;
-            if (!isFree)
+            for (auto bucketIter = buckets.begin(); bucketIter != buckets.end();)
             {
-                ++iter;
-                continue;
+                auto& bucket = bucketIter->second;
+                for (auto iter = bucket.begin(); iter != bucket.end();)
+                {
+                    auto& entry = *iter;
+
+                    bool isFree = entry.use_count() == 1;
+                    if (!isFree)
+                    {
+                        ++iter;
+                        continue;
+                    }
+
+                    UINT32 entryAge = _currentFrame - entry->_lastUsedFrame;
+                    if (entryAge >= age)
+                        iter = bucket.erase(iter);
+                    else
+                        ++iter;
+                }
+
+                if (bucket.empty())
+                    bucketIter = buckets.erase(bucketIter);
+                else
+                    ++bucketIter;
             }
+        };
 
-            UINT32 entryAge = _currentFrame - entry->_lastUsedFrame;
-            if (entryAge >= age)
-                iter = _buffers.erase(iter);
-            else
-                ++iter;
-        }
+        PruneBuckets(_textures);
+        PruneBuckets(_buffers);
 
         _lastPruneFrame = _currentFrame;
         _allocationsCountSinceLastPrune = 0;
@@ -279,6 +279,64 @@ namespace te
         return desc;
     }
 
+    size_t POOLED_RENDER_TEXTURE_DESC::GetHash() const
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, Type);
+        te_hash_combine(hash, Format);
+        te_hash_combine(hash, Width);
+        te_hash_combine(hash, Height);
+        te_hash_combine(hash, Flag);
+        te_hash_combine(hash, ArraySize);
+        te_hash_combine(hash, NumMipLevels);
+
+        if (Type == TEX_TYPE_2D)
+        {
+            te_hash_combine(hash, HwGamma);
+            te_hash_combine(hash, NumSamples);
+        }
+        else if (Type == TEX_TYPE_3D)
+        {
+            te_hash_combine(hash, Depth);
+        }
+
+        return hash;
+    }
+
+    UINT64 POOLED_RENDER_TEXTURE_DESC::GetMemorySize() const
+    {
+        UINT64 size = 0;
+        for (UINT32 mip = 0; mip <= NumMipLevels; mip++)
+        {
+            const UINT32 mipWidth = std::max(1U, Width >> mip);
+            const UINT32 mipHeight = std::max(1U, Height >> mip);
+            const UINT32 mipDepth = Type == TEX_TYPE_3D ? std::max(1U, Depth >> mip) : 1;
+
+            size += PixelUtil::GetMemorySize(mipWidth, mipHeight, mipDepth, Format);
+        }
+
+        const UINT32 numFaces = Type == TEX_TYPE_CUBE_MAP ? 6 : 1;
+        const UINT32 numSamples = Type == TEX_TYPE_2D ? std::max(1U, NumSamples) : 1;
+
+        return size * numFaces * std::max(1U, ArraySize) * numSamples;
+    }
+
+    bool POOLED_RENDER_TEXTURE_DESC::operator== (const POOLED_RENDER_TEXTURE_DESC& rhs) const
+    {
+        if (Type != rhs.Type || Format != rhs.Format || Width != rhs.Width || Height != rhs.Height || Flag != rhs.Flag ||
+            ArraySize != rhs.ArraySize || NumMipLevels != rhs.NumMipLevels)
+        {
+            return false;
+        }
+
+        if (Type == TEX_TYPE_2D)
+            return HwGamma == rhs.HwGamma && NumSamples == rhs.NumSamples;
+        else if (Type == TEX_TYPE_3D)
+            return Depth == rhs.Depth;
+
+        return true;
+    }
+
     POOLED_STORAGE_BUFFER_DESC POOLED_STORAGE_BUFFER_DESC::CreateStandard(GpuBufferFormat format, UINT32 numElements,
         GpuBufferUsage usage)
     {
@@ -305,6 +363,21 @@ namespace te
         return desc;
     }
 
+    size_t POOLED_STORAGE_BUFFER_DESC::GetHash() const
+    {
+        size_t hash = 0;
+        te_hash_combine(hash, Type);
+        te_hash_combine(hash, NumElements);
+        te_hash_combine(hash, Usage);
+
+        if (Type == GBT_STANDARD)
+            te_hash_combine(hash, Format);
+        else // Structured
+            te_hash_combine(hash, ElementSize);
+
+        return hash;
+    }
+
     GpuResourcePool& gGpuResourcePool()
     {
         return GpuResourcePool::Instance();
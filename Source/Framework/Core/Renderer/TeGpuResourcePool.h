@@ -121,8 +121,10 @@ namespace te
         static bool Matches(const SPtr<GpuBuffer>& buffer, const POOLED_STORAGE_BUFFER_DESC& desc);
 
     private:
-        Vector<SPtr<PooledRenderTexture>> _textures;
-        Vector<SPtr<PooledStorageBuffer>> _buffers;
+        // Resources are grouped by the hash of the descriptor they were created from, so that a lookup only goes
+        // through the resources that can possibly match
+        UnorderedMap<size_t, Vector<SPtr<PooledRenderTexture>>> _textures;
+        UnorderedMap<size_t, Vector<SPtr<PooledStorageBuffer>>> _buffers;
 
         UINT32 _currentFrame = 0;
         UINT32 _lastPruneFrame = 0;
@@ -177,6 +179,16 @@ namespace te
         static POOLED_RENDER_TEXTURE_DESC CreateCube(PixelFormat format, UINT32 width, UINT32 height,
             INT32 usage = TU_STATIC, UINT32 arraySize = 1);
 
+        /** Returns a hash of the properties a pooled texture is matched against. The debug name is ignored. */
+        size_t GetHash() const;
+
+        /** Returns the amount of GPU memory, in bytes, taken by a texture created from this descriptor. */
+        UINT64 GetMemorySize() const;
+
+        /** Compares the properties a pooled texture is matched against. The debug name is ignored. */
+        bool operator== (const POOLED_RENDER_TEXTURE_DESC& rhs) const;
+        bool operator!= (const POOLED_RENDER_TEXTURE_DESC& rhs) const { return !(*this == rhs); }
+
     private:
         friend class GpuResourcePool;
 
@@ -219,6 +231,9 @@ namespace te
         static POOLED_STORAGE_BUFFER_DESC CreateStructured(UINT32 elementSize, UINT32 numElements,
             GpuBufferUsage usage = GBU_LOADSTORE);
 
+        /** Returns a hash of the properties a pooled buffer is matched against. */
+        size_t GetHash() const;
+
     private:
         friend class GpuResourcePool;
 
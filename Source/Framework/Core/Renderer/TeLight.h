@@ -13,7 +13,7 @@ namespace te
     enum class LightDirtyFlag
     {
         // First few bits reserved by ActorDirtyFlag
-        RedrawShadow = 1 << 5 // Only valid if CastShadowsType == Static
+        RedrawShadow = 1 << 5 // Only valid if CastShadowsType == Static or Both
     };
 
     /** Illuminates a portion of the scene covered by the light. */
@@ -65,7 +65,7 @@ namespace te
 
         /**
         * A light can cast shadows for static geometry, dynamic geometry or both.
-        * In case the light cast only shadows for static geometry, drawing will be on demand
+        * Shadows of static geometry are drawn on demand, when the light or the static geometry around it changes
         */
         void SetCastShadowsType(CastShadowsType castShadowsType) 
         {
@@ -74,10 +74,10 @@ namespace te
 
         CastShadowsType GetCastShadowsType() const { return _castShadowsType; }
 
-        /** Ask to the renderer to redraw the shadow for this light */
+        /** Ask to the renderer to redraw the shadow of static geometry for this light */
         void ForceShadowRedraw()
         {
-            if (_castShadowsType == CastShadowsType::Static)
+            if (_castShadowsType != CastShadowsType::Dynamic)
                 _markCoreDirty((ActorDirtyFlag)LightDirtyFlag::RedrawShadow);
         }
 
@@ -575,5 +575,18 @@ namespace te
          * to avoid overdraw
          */
         bool UseZPrepass = true;
+
+        /**
+         * Multiplies the screen size of renderables when picking the level of detail of their mesh. Values above 1 keep
+         * more detailed levels for longer, values below 1 switch to simpler levels sooner.
+         */
+        float LodBias = 1.0f;
+
+        /**
+         * Culls the meshlets of opaque and transparent sub-meshes one by one against the view frustum and by their facing,
+         * and only draws the index ranges of the visible ones. Depth pre-pass and shadows still draw whole sub-meshes. Only
+         * has an effect on meshes imported with meshlets.
+         */
+        bool ClusterCulling = false;
     };
 }
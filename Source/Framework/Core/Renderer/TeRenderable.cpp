@@ -6,33 +6,10 @@
 #include "Animation/TeAnimation.h"
 #include "Animation/TeAnimationManager.h"
 #include "RenderAPI/TeGpuBuffer.h"
+#include "Renderer/TeBoneMatrixPalette.h"
 
 namespace te
 {
-    SPtr<GpuBuffer> CreateBoneMatrixBuffer(UINT32 numBones)
-    {
-        GPU_BUFFER_DESC desc;
-        desc.ElementCount = numBones * 4;
-        desc.ElementSize = 0;
-        desc.Type = GBT_STANDARD;
-        desc.Format = BF_32X4F;
-        desc.Usage = GBU_DYNAMIC;
-
-        SPtr<GpuBuffer> buffer = GpuBuffer::Create(desc);
-        UINT8* dest = (UINT8*)buffer->Lock(0, numBones * 4 * sizeof(Vector4), GBL_WRITE_ONLY_DISCARD);
-
-        // Initialize bone transforms to identity, so the object renders properly even if no animation is animating it
-        for (UINT32 i = 0; i < numBones; i++)
-        {
-            memcpy(dest, &Matrix4::IDENTITY, 16 * sizeof(float)); // Assuming row-major format
-            dest += 16 * sizeof(float);
-        }
-
-        buffer->Unlock();
-
-        return buffer;
-    }
-
     Renderable::Renderable()
         : Serializable(TID_Renderable)
     { }
@@ -75,8 +52,6 @@ namespace te
             return;
 
         _mesh = mesh;
-        _boneMatrixBuffer = nullptr;
-        _bonePrevMatrixBuffer = nullptr;
 
         if (_mesh)
         {
@@ -344,45 +319,48 @@ namespace te
 
     void Renderable::UpdateAnimationBuffers(const EvaluatedAnimationData& animData)
     {
-        if (_animationId == (UINT64)-1)
+        if (_animType != RenderableAnimType::Skinned)
             return;
 
-        const EvaluatedAnimationData::AnimInfo* animInfo = nullptr;
+        const BoneMatrixPalette& palette = gBoneMatrixPalette();
 
-        auto iterFind = animData.Infos.find(_animationId);
-        if (iterFind != animData.Infos.end())
-            animInfo = &iterFind->second;
+        // Without an evaluated pose (e.g. the animation was culled) the mesh falls back to its bind pose
+        UINT32 boneMatrixOffset = palette.GetIdentityOffset();
 
-        if (animInfo == nullptr)
-            return;
-
-        if (_animType == RenderableAnimType::Skinned)
+        if (_animationId != (UINT64)-1)
         {
-            AnimationManager::Instance().SetAnimDataDirty();
-            const EvaluatedAnimationData::PoseInfo& poseInfo = animInfo->PoseInfos;
-
-            if (_properties.WriteVelocity)
-                std::swap(_boneMatrixBuffer, _bonePrevMatrixBuffer);
-
-            // Note: If multiple elements are using the same animation (not possible atm), this buffer should be shared by
-            // all such elements
-            UINT8* dest = (UINT8*)_boneMatrixBuffer->Lock(0, poseInfo.NumBones * 4 * sizeof(Vector4), GBL_WRITE_ONLY_DISCARD);
-            for (UINT32 j = 0; j < poseInfo.NumBones; j++)
+            auto iterFind = animData.Infos.find(_animationId);
+            if (iterFind != animData.Infos.end())
             {
-                const Matrix4& transform = animData.Transforms[poseInfo.StartIdx + j];
-                memcpy(dest, &transform, 16 * sizeof(float)); // Assuming row-major format
-
-                dest += 16 * sizeof(float);
+                AnimationManager::Instance().SetAnimDataDirty();
+                boneMatrixOffset = palette.GetFrameOffset() + iterFind->second.PoseInfos.StartIdx;
             }
+        }
 
-            _boneMatrixBuffer->Unlock();
+        // Offsets of the previous frame don't point to valid data anymore if the palette was re-created
+        if (_bonePaletteVersion != palette.GetVersion())
+        {
+            _bonePrevMatrixOffset = boneMatrixOffset;
+            _bonePaletteVersion = palette.GetVersion();
         }
+
+        _boneMatrixOffset = boneMatrixOffset;
     }
 
     void Renderable::UpdatePrevFrameAnimationBuffers()
     {
         if (_animType == RenderableAnimType::Skinned)
-            std::swap(_boneMatrixBuffer, _bonePrevMatrixBuffer);
+            _bonePrevMatrixOffset = _boneMatrixOffset;
+    }
+
+    const SPtr<GpuBuffer>& Renderable::GetBoneMatrixBuffer() const
+    {
+        static const SPtr<GpuBuffer> NullBuffer;
+
+        if (_animType != RenderableAnimType::Skinned)
+            return NullBuffer;
+
+        return gBoneMatrixPalette().GetBuffer();
     }
 
     void Renderable::OnMeshChanged()
@@ -488,30 +466,14 @@ namespace te
             SPtr<Skeleton> skeleton = _mesh->GetSkeleton();
             UINT32 numBones = skeleton != nullptr ? skeleton->GetNumBones() : 0;
 
+            // Bone matrices live in the shared palette, only make sure there's a bind pose to fall back to
             if (numBones > 0)
-            {
-                // If matrix buffer already exists, we don't want to destory it
-                if(!_boneMatrixBuffer) 
-                {
-                    _boneMatrixBuffer = CreateBoneMatrixBuffer(numBones);
-
-                    if (_properties.WriteVelocity)
-                        _bonePrevMatrixBuffer = CreateBoneMatrixBuffer(numBones);
-                    else
-                        _bonePrevMatrixBuffer = nullptr;
-                }
-            }
-            else
-            {
-                _boneMatrixBuffer = nullptr;
-                _bonePrevMatrixBuffer = nullptr;
-            }
-        }
-        else
-        {
-            _boneMatrixBuffer = nullptr;
-            _bonePrevMatrixBuffer = nullptr;
+                gBoneMatrixPalette().ReserveIdentity(numBones);
         }
+
+        _boneMatrixOffset = gBoneMatrixPalette().GetIdentityOffset();
+        _bonePrevMatrixOffset = _boneMatrixOffset;
+        _bonePaletteVersion = gBoneMatrixPalette().GetVersion();
     }
 
     void Renderable::_markCoreDirty(ActorDirtyFlag flag)
@@ -216,8 +216,9 @@ namespace te
         UINT64 GetAnimationId() const { return _animationId; }
 
         /**
-         * Updates internal animation buffers from the contents of the provided animation data object. Does nothing if
-         * renderable is not affected by animation.
+         * Updates the offsets of the renderable's bone matrices from the contents of the provided animation data object.
+         * Matrices themselves are uploaded by BoneMatrixPalette::Update(), which must be called first on the same frame.
+         * Does nothing if renderable is not affected by animation.
          */
         void UpdateAnimationBuffers(const EvaluatedAnimationData& animData);
 
@@ -227,11 +228,20 @@ namespace te
          */
         void UpdatePrevFrameAnimationBuffers();
 
-        /** Returns the GPU buffer containing element's bone matrices, if it has any. */
-        const SPtr<GpuBuffer>& GetBoneMatrixBuffer() const { return _boneMatrixBuffer; }
+        /**
+         * Returns the GPU buffer containing element's bone matrices, if it has any. The buffer is shared by all skinned
+         * renderables, use GetBoneMatrixOffset() to find the element's matrices.
+         */
+        const SPtr<GpuBuffer>& GetBoneMatrixBuffer() const;
 
         /** Returns the GPU buffer containing element's bone matrices for the previous frame, if it has any. */
-        const SPtr<GpuBuffer>& GetBonePrevMatrixBuffer() const { return _bonePrevMatrixBuffer; }
+        const SPtr<GpuBuffer>& GetBonePrevMatrixBuffer() const { return GetBoneMatrixBuffer(); }
+
+        /** Returns the index of the element's first bone matrix in GetBoneMatrixBuffer(). */
+        UINT32 GetBoneMatrixOffset() const { return _boneMatrixOffset; }
+
+        /** Returns the index of the element's first bone matrix of the previous frame in GetBonePrevMatrixBuffer(). */
+        UINT32 GetBonePrevMatrixOffset() const { return _bonePrevMatrixOffset; }
 
         /** Triggered whenever the renderable's mesh changes. */
         void OnMeshChanged();
@@ -289,8 +299,9 @@ namespace te
         RenderableAnimType _animType = RenderableAnimType::None;
         SPtr<Animation> _animation;
         UINT64 _animationId = (UINT64)-1;
-        SPtr<GpuBuffer> _boneMatrixBuffer;
-        SPtr<GpuBuffer> _bonePrevMatrixBuffer;
+        UINT32 _boneMatrixOffset = 0;
+        UINT32 _bonePrevMatrixOffset = 0;
+        UINT32 _bonePaletteVersion = 0;
 
         // Bounds must updated if we change _mesh or _tfrmMatrix
         Bounds _cachedBounds;
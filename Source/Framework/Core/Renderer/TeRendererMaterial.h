@@ -184,6 +184,9 @@ namespace te
          */
         static T* Get()
         {
+            if(_metaData.ShaderElem == nullptr)
+                RendererMaterialManager::LoadMaterial(&_metaData);
+
             if(_metaData.Instances[0] == nullptr)
             {
                 RendererMaterialBase* mat = te_allocate<T>();
@@ -192,6 +195,7 @@ namespace te
                 mat->Initialize();
 
                 _metaData.Instances[0] = mat;
+                RendererMaterialManager::Instance().RecordMaterialVariation(&_metaData, 0);
             }
 
             return (T*)_metaData.Instances[0];
@@ -200,6 +204,9 @@ namespace te
         /** Retrieves an instance of a particular variation of this renderer material. */
         static T* Get(const ShaderVariation& variation)
         {
+            if(_metaData.ShaderElem == nullptr)
+                RendererMaterialManager::LoadMaterial(&_metaData);
+
             if(variation.GetIdx() == (UINT32)-1)
                 variation.SetIdx(_metaData.Variations.Find(variation));
 
@@ -215,6 +222,7 @@ namespace te
                 mat->Initialize();
 
                 _metaData.Instances[varIdx] = mat;
+                RendererMaterialManager::Instance().RecordMaterialVariation(&_metaData, varIdx);
             }
 
             return (T*)_metaData.Instances[varIdx];
@@ -3,6 +3,10 @@
 #include "Importer/TeShaderImportOptions.h"
 #include "Resources/TeResourceManager.h"
 #include "Material/TeShader.h"
+#include "Material/TeTechnique.h"
+#include "Utility/TeDataStream.h"
+
+#include <filesystem>
 
 namespace te
 {
@@ -11,40 +15,15 @@ namespace te
     RendererMaterialManager::RendererMaterialManager()
     {
 #if TE_PLATFORM == TE_PLATFORM_WIN32 // TODO to remove when OpenGL will be done
-        BuiltinResources& br = BuiltinResources::Instance();
-
-        // Note: Ideally I want to avoid loading all materials, and instead just load those that are used.
-        Vector<RendererMaterialData>& materials = GetMaterials();
-        Vector<SPtr<Shader>> shaders;
-
-        for (auto& material : materials)
-        {
-            if (material.ShaderPath.type() == typeid(BuiltinShader))
-            {
-                HShader shader = br.GetBuiltinShader(std::any_cast<BuiltinShader>(material.ShaderPath));
-                TE_ASSERT_ERROR(shader.IsLoaded(), "Shader not found")
-                shaders.push_back(shader.GetInternalPtr());
-            }
-            else if (material.ShaderPath.type() == typeid(String))
-            {
-                auto shaderImportOptions = ShaderImportOptions::Create();
-                HShader shader = gResourceManager().Load<Shader>(
-                    std::any_cast<String>(material.ShaderPath), shaderImportOptions);
-            }
-            else
-            {
-                auto shaderImportOptions = ShaderImportOptions::Create();
-                HShader shader = gResourceManager().Load<Shader>(
-                    std::any_cast<const char*>(material.ShaderPath), shaderImportOptions);
-            }
-        }
-
-        InitMaterials(shaders);
+        // Materials are loaded when first used, only the variations used during the last session are compiled up front,
+        // in the background
+        PrecompileVariations();
 #endif
     }
 
     RendererMaterialManager::~RendererMaterialManager()
     {
+        SaveVariations();
         DestroyMaterials();
     }
 
@@ -66,38 +45,49 @@ namespace te
 #endif
     }
 
-    void RendererMaterialManager::InitMaterials(const Vector<SPtr<Shader>>& shaders)
+    void RendererMaterialManager::LoadMaterial(RendererMaterialMetaData* metaData)
     {
         Vector<RendererMaterialData>& materials = GetMaterials();
-        for (UINT32 i = 0; i < materials.size(); i++)
-        {
-#if TE_PLATFORM == TE_PLATFORM_WIN32 // TODO to remove when OpenGL will be done
-            materials[i].ShaderPath = materials[i].ShaderPath;
-            materials[i].MetaData->ShaderElem = shaders[i];
+        auto iterFind = std::find_if(materials.begin(), materials.end(),
+            [metaData](const RendererMaterialData& material) { return material.MetaData == metaData; });
 
-            if (!shaders[i])
-            {
-                if (materials[i].ShaderPath.type() == typeid(String))
-                {
-                    TE_DEBUG("Failed to load renderer material: {" + std::any_cast<String>(materials[i].ShaderPath) + "}");
-                }
-                else
-                {
-                    TE_DEBUG("Failed to load renderer material: {" + ToString(std::any_cast<UINT32>(materials[i].ShaderPath)) + "}");
-                }
+        if (iterFind == materials.end())
+            return;
 
-                continue;
-            }
+        RendererMaterialData& material = *iterFind;
+        HShader shader;
 
-            // Note: Making the assumption here that all the techniques are generated due to shader variations
-            Map<UINT32, SPtr<Technique>> techniques;
-            shaders[i]->GetCompatibleTechniques(techniques);
-            materials[i].MetaData->Instances.resize((UINT32)techniques.size());
+        if (material.ShaderPath.type() == typeid(BuiltinShader))
+        {
+            shader = gBuiltinResources().GetBuiltinShader(std::any_cast<BuiltinShader>(material.ShaderPath));
+            TE_ASSERT_ERROR(shader.IsLoaded(), "Shader not found")
+        }
+        else if (material.ShaderPath.type() == typeid(String))
+        {
+            auto shaderImportOptions = ShaderImportOptions::Create();
+            shader = gResourceManager().Load<Shader>(std::any_cast<String>(material.ShaderPath), shaderImportOptions);
+        }
+        else
+        {
+            auto shaderImportOptions = ShaderImportOptions::Create();
+            shader = gResourceManager().Load<Shader>(std::any_cast<const char*>(material.ShaderPath), shaderImportOptions);
+        }
 
-            for (auto& entry : techniques)
-                materials[i].MetaData->Variations.Add(entry.second->GetVariation());
-#endif
+        if (!shader.IsLoaded())
+        {
+            TE_DEBUG("Failed to load renderer material: {" + GetShaderPathKey(material.ShaderPath) + "}");
+            return;
         }
+
+        metaData->ShaderElem = shader.GetInternalPtr();
+
+        // Note: Making the assumption here that all the techniques are generated due to shader variations
+        Map<UINT32, SPtr<Technique>> techniques;
+        metaData->ShaderElem->GetCompatibleTechniques(techniques);
+        metaData->Instances.resize((UINT32)techniques.size());
+
+        for (auto& entry : techniques)
+            metaData->Variations.Add(entry.second->GetVariation());
     }
 
     void RendererMaterialManager::DestroyMaterials()
@@ -124,4 +114,164 @@ namespace te
         static Vector<RendererMaterialData> materials;
         return materials;
     }
+
+    void RendererMaterialManager::RecordVariation(const SPtr<Shader>& shader, const ShaderVariation& variation)
+    {
+        _usedVariations.insert("S|" + shader->GetName() + "|" + SerializeVariation(variation));
+    }
+
+    void RendererMaterialManager::RecordMaterialVariation(RendererMaterialMetaData* metaData, UINT32 varIdx)
+    {
+        if (!metaData->Variations.Exist(varIdx))
+            return;
+
+        Vector<RendererMaterialData>& materials = GetMaterials();
+        auto iterFind = std::find_if(materials.begin(), materials.end(),
+            [metaData](const RendererMaterialData& material) { return material.MetaData == metaData; });
+
+        if (iterFind == materials.end())
+            return;
+
+        _usedVariations.insert("M|" + GetShaderPathKey(iterFind->ShaderPath) + "|" +
+            SerializeVariation(metaData->Variations.Get(varIdx)));
+    }
+
+    void RendererMaterialManager::PrecompileVariations()
+    {
+        if (!std::filesystem::exists(VARIATION_MANIFEST_PATH))
+            return;
+
+        FileStream file(VARIATION_MANIFEST_PATH);
+        Vector<String> lines = Split(file.GetAsString(), '\n');
+        file.Close();
+
+        UnorderedMap<String, SPtr<Shader>> shaders;
+        bool shadersListed = false;
+
+        for (auto& line : lines)
+        {
+            // An empty variation leaves no trailing field
+            Vector<String> fields = Split(line, '|');
+            if (fields.size() < 2)
+                continue;
+
+            const ShaderVariation variation = DeserializeVariation(fields.size() > 2 ? fields[2] : String());
+            SPtr<Technique> technique;
+
+            if (fields[0] == "M")
+            {
+                for (auto& material : GetMaterials())
+                {
+                    if (GetShaderPathKey(material.ShaderPath) != fields[1])
+                        continue;
+
+                    if (!material.MetaData->ShaderElem)
+                        LoadMaterial(material.MetaData);
+
+                    if (material.MetaData->ShaderElem)
+                    {
+                        for (auto& entry : material.MetaData->ShaderElem->GetTechniques())
+                        {
+                            if (entry->IsSupported() && entry->GetVariation() == variation)
+                                technique = entry;
+                        }
+                    }
+
+                    break;
+                }
+            }
+            else if (fields[0] == "S")
+            {
+                if (!shadersListed)
+                {
+                    for (auto& resource : gResourceManager().FindByType(TID_Shader))
+                    {
+                        HShader shader = static_resource_cast<Shader>(resource);
+                        shaders[shader->GetName()] = shader.GetInternalPtr();
+                    }
+
+                    shadersListed = true;
+                }
+
+                // Shaders that aren't loaded yet are compiled on demand, the variation being recorded again then
+                auto iterFind = shaders.find(fields[1]);
+                if (iterFind != shaders.end())
+                    technique = iterFind->second->CreateTechnique(variation, {});
+            }
+
+            if (technique && technique->IsSupported())
+                technique->CompileAsync();
+        }
+    }
+
+    void RendererMaterialManager::SaveVariations() const
+    {
+        if (_usedVariations.empty())
+            return;
+
+        Vector<String> lines(_usedVariations.begin(), _usedVariations.end());
+        std::sort(lines.begin(), lines.end());
+
+        String content;
+        for (auto& line : lines)
+            content += line + "\n";
+
+        FileStream file(VARIATION_MANIFEST_PATH, FileStream::WRITE);
+        if (file.Fail())
+            return;
+
+        file.Write(content.data(), content.size());
+        file.Close();
+    }
+
+    String RendererMaterialManager::GetShaderPathKey(const std::any& shaderPath)
+    {
+        if (shaderPath.type() == typeid(BuiltinShader))
+            return "Builtin" + ToString((UINT32)std::any_cast<BuiltinShader>(shaderPath));
+        else if (shaderPath.type() == typeid(String))
+            return std::any_cast<String>(shaderPath);
+        else
+            return String(std::any_cast<const char*>(shaderPath));
+    }
+
+    String RendererMaterialManager::SerializeVariation(const ShaderVariation& variation)
+    {
+        Vector<String> names = variation.GetParamNames();
+        std::sort(names.begin(), names.end());
+
+        // Values are stored as raw bits whatever their type, for them to be read back exactly
+        String data;
+        for (auto& name : names)
+        {
+            const ShaderVariation::Param& param = variation.GetParams().at(name);
+
+            if (!data.empty())
+                data += ";";
+
+            data += name + ":" + ToString((UINT32)param.Type) + ":" + ToString(param.Ui);
+        }
+
+        return data;
+    }
+
+    ShaderVariation RendererMaterialManager::DeserializeVariation(const String& data)
+    {
+        ShaderVariation variation;
+
+        for (auto& entry : Split(data, ';'))
+        {
+            Vector<String> fields = Split(entry, ':');
+            if (fields.size() != 3)
+                continue;
+
+            ShaderVariation::Param param;
+            param.Name = fields[0];
+            param.Type = (ShaderVariation::ParamType)ParseUINT32(fields[1]);
+            param.Ui = ParseUINT32(fields[2]);
+
+            variation.AddParam(param);
+        }
+
+        return variation;
+    }
 }
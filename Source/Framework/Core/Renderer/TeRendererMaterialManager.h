@@ -17,29 +17,65 @@ namespace te
         std::any ShaderPath;
     };
 
-    /**	Initializes and handles all renderer materials. */
+    /**
+     * Initializes and handles all renderer materials. A material loads its shader the first time it is used. The shader
+     * variations used during a session are written to a manifest on shut-down, and compiled in the background on the next
+     * start-up before anything asks for them.
+     */
     class TE_CORE_EXPORT RendererMaterialManager : public Module<RendererMaterialManager>
     {
     public:
+        /** File, relative to the working directory, listing the shader variations used during the last session. */
+        static constexpr const char* VARIATION_MANIFEST_PATH = "ShaderVariations.manifest";
+
         RendererMaterialManager();
         virtual ~RendererMaterialManager();
 
         TE_MODULE_STATIC_HEADER_MEMBER(RendererMaterialManager)
 
-        /**	Registers a new material that should be initialized on module start-up. */
+        /**	Registers a new material, initialized the first time it is used. */
         static void RegisterMaterial(RendererMaterialMetaData* metaData, const std::any& shaderPath);
 
         /**	Returns a list in which are all materials managed by this module. */
         static Vector<RendererMaterialData>& GetMaterials();
+
+        /**
+         * Records a variation of a shader that isn't owned by a renderer material as used, for it to be compiled at the
+         * next start-up. The shader is looked up by its name among the loaded shaders then.
+         */
+        void RecordVariation(const SPtr<Shader>& shader, const ShaderVariation& variation);
+
     private:
         template<class T>
         friend class RendererMaterial;
         friend class RendererMaterialBase;
 
-        /**	Initializes all materials on the core thread. */
-        static void InitMaterials(const Vector<SPtr<Shader>>& shaders);
-
         /**	Destroys all materials */
         static void DestroyMaterials();
+
+        /** Loads the shader of a renderer material and lists its variations. Called the first time a material is used. */
+        static void LoadMaterial(RendererMaterialMetaData* metaData);
+
+        /** Records a variation of a renderer material as used, for it to be compiled at the next start-up. */
+        void RecordMaterialVariation(RendererMaterialMetaData* metaData, UINT32 varIdx);
+
+        /** Queues the compilation of every variation listed in the manifest of the last session. */
+        void PrecompileVariations();
+
+        /** Writes the variations used during the session to the manifest. */
+        void SaveVariations() const;
+
+        /** Returns a string identifying the shader of a renderer material across sessions. */
+        static String GetShaderPathKey(const std::any& shaderPath);
+
+        /** Writes the parameters of a variation in the format of the manifest, sorted by name. */
+        static String SerializeVariation(const ShaderVariation& variation);
+
+        /** Reads parameters written by SerializeVariation(). */
+        static ShaderVariation DeserializeVariation(const String& data);
+
+    private:
+        /** Lines of the manifest of the current session, one per variation used. */
+        UnorderedSet<String> _usedVariations;
     };
 }
@@ -9,9 +9,38 @@
 #include "Manager/TeRendererManager.h"
 #include "Renderer/TeRenderer.h"
 #include "Mesh/TeMeshUtility.h"
+#include "Math/TeAABox.h"
+#include "Utility/TeBitwise.h"
 
 namespace te
 {
+    namespace
+    {
+        /** Converts a value in [-1, 1] to a 16-bit signed normalized integer. */
+        INT16 ToSnorm16(float value)
+        {
+            return (INT16)Math::RoundToInt(Math::Clamp(value, -1.0f, 1.0f) * 32767.0f);
+        }
+
+        /** Maps a unit vector to the octahedron unfolded over the [-1, 1] square. */
+        Vector2 OctahedronEncode(const Vector3& vec)
+        {
+            float l1Norm = Math::Abs(vec.x) + Math::Abs(vec.y) + Math::Abs(vec.z);
+            if (l1Norm <= 0.0f)
+                return Vector2(0.0f, 0.0f);
+
+            Vector2 output(vec.x / l1Norm, vec.y / l1Norm);
+            if (vec.z < 0.0f)
+            {
+                output = Vector2(
+                    (1.0f - Math::Abs(output.y)) * (output.x >= 0.0f ? 1.0f : -1.0f),
+                    (1.0f - Math::Abs(output.x)) * (output.y >= 0.0f ? 1.0f : -1.0f));
+            }
+
+            return output;
+        }
+    }
+
     RendererMeshData::RendererMeshData(UINT32 numVertices, UINT32 numIndices, VertexLayout layout, IndexType indexType)
     {
         SPtr<VertexDataDesc> vertexDesc = VertexLayoutVertexDesc(layout);
@@ -393,4 +422,171 @@ namespace te
 
         return vertexDesc;
     }
+
+    SPtr<MeshData> RendererMeshData::Compress(const SPtr<MeshData>& meshData, const AABox* positionBounds)
+    {
+        const SPtr<VertexDataDesc>& srcDesc = meshData->GetVertexDesc();
+        const VertexElement* positionElem = srcDesc->GetElement(VES_POSITION);
+        if (positionElem == nullptr || (positionElem->GetType() != VET_FLOAT3 && positionElem->GetType() != VET_FLOAT4))
+            return meshData;
+
+        const VertexElement* normalElem = srcDesc->GetElement(VES_NORMAL);
+        if (normalElem != nullptr && normalElem->GetType() != VET_FLOAT3 && normalElem->GetType() != VET_FLOAT4)
+            normalElem = nullptr;
+
+        // Tangents and bitangents can only be rebuilt from the encoded normal
+        const VertexElement* tangentElem = normalElem ? srcDesc->GetElement(VES_TANGENT) : nullptr;
+        if (tangentElem != nullptr && tangentElem->GetType() != VET_FLOAT3 && tangentElem->GetType() != VET_FLOAT4)
+            tangentElem = nullptr;
+
+        const VertexElement* biTangentElem = tangentElem ? srcDesc->GetElement(VES_BITANGENT) : nullptr;
+        if (biTangentElem != nullptr && biTangentElem->GetType() != VET_FLOAT3 && biTangentElem->GetType() != VET_FLOAT4)
+            biTangentElem = nullptr;
+
+        SPtr<VertexDataDesc> dstDesc = VertexDataDesc::Create();
+        for (UINT32 i = 0; i < srcDesc->GetNumElements(); i++)
+        {
+            const VertexElement& elem = srcDesc->GetElement(i);
+            VertexElementType type = elem.GetType();
+
+            switch (elem.GetSemantic())
+            {
+            case VES_POSITION:
+                if (&elem == positionElem)
+                    type = VET_SHORT4_NORM;
+                break;
+            case VES_NORMAL:
+                if (&elem == normalElem)
+                    type = tangentElem ? VET_SHORT4_NORM : VET_SHORT2_NORM;
+                break;
+            case VES_TANGENT:
+            case VES_BITANGENT:
+                if (&elem == tangentElem || &elem == biTangentElem)
+                    continue;
+                break;
+            case VES_TEXCOORD:
+                if (type == VET_FLOAT2)
+                    type = VET_HALF2;
+                break;
+            case VES_BLEND_WEIGHTS:
+                if (type == VET_FLOAT4)
+                    type = VET_UBYTE4_NORM;
+                break;
+            default:
+                break;
+            }
+
+            dstDesc->AddVertElem(type, elem.GetSemantic(), elem.GetSemanticIdx(), elem.GetStreamIdx());
+        }
+
+        UINT32 numVertices = meshData->GetNumVertices();
+        SPtr<MeshData> output = MeshData::Create(numVertices, meshData->GetNumIndices(), dstDesc, meshData->GetIndexType());
+        memcpy(output->GetIndexData(), meshData->GetIndexData(), meshData->GetIndexBufferSize());
+
+        // Positions are quantized over the box, centered on its center and scaled by its half extents
+        AABox bounds = positionBounds ? *positionBounds : meshData->CalculateBounds().GetBox();
+        Vector3 bias = bounds.GetCenter();
+        Vector3 scale = bounds.GetHalfSize();
+        scale.x = scale.x > 0.0f ? scale.x : 1.0f;
+        scale.y = scale.y > 0.0f ? scale.y : 1.0f;
+        scale.z = scale.z > 0.0f ? scale.z : 1.0f;
+        output->SetPositionQuantization(scale, bias);
+
+        auto readVector3 = [&meshData, &srcDesc](const VertexElement* elem, UINT32 vertexIdx)
+        {
+            const UINT8* data = meshData->GetElementData(elem->GetSemantic(), elem->GetSemanticIdx(), elem->GetStreamIdx());
+            return *(const Vector3*)(data + srcDesc->GetVertexStride(elem->GetStreamIdx()) * vertexIdx);
+        };
+
+        for (UINT32 i = 0; i < srcDesc->GetNumElements(); i++)
+        {
+            const VertexElement& elem = srcDesc->GetElement(i);
+            if (&elem == tangentElem || &elem == biTangentElem)
+                continue;
+
+            const UINT8* src = meshData->GetElementData(elem.GetSemantic(), elem.GetSemanticIdx(), elem.GetStreamIdx());
+            UINT32 srcStride = srcDesc->GetVertexStride(elem.GetStreamIdx());
+
+            const VertexElement* dstElem = dstDesc->GetElement(elem.GetSemantic(), elem.GetSemanticIdx(), elem.GetStreamIdx());
+            UINT8* dst = output->GetElementData(elem.GetSemantic(), elem.GetSemanticIdx(), elem.GetStreamIdx());
+            UINT32 dstStride = dstDesc->GetVertexStride(elem.GetStreamIdx());
+
+            for (UINT32 j = 0; j < numVertices; j++)
+            {
+                const UINT8* srcVertex = src + srcStride * j;
+                UINT8* dstVertex = dst + dstStride * j;
+
+                if (&elem == positionElem)
+                {
+                    Vector3 position = (*(const Vector3*)srcVertex - bias) / scale;
+
+                    // Bitangent handedness, relative to cross(normal, tangent)
+                    float sign = 1.0f;
+                    if (biTangentElem != nullptr)
+                    {
+                        Vector3 normal = readVector3(normalElem, j);
+                        Vector3 tangent = readVector3(tangentElem, j);
+                        Vector3 biTangent = readVector3(biTangentElem, j);
+                        sign = normal.Cross(tangent).Dot(biTangent) < 0.0f ? -1.0f : 1.0f;
+                    }
+
+                    INT16* value = (INT16*)dstVertex;
+                    value[0] = ToSnorm16(position.x);
+                    value[1] = ToSnorm16(position.y);
+                    value[2] = ToSnorm16(position.z);
+                    value[3] = ToSnorm16(sign);
+                }
+                else if (&elem == normalElem)
+                {
+                    Vector2 normal = OctahedronEncode(*(const Vector3*)srcVertex);
+
+                    INT16* value = (INT16*)dstVertex;
+                    value[0] = ToSnorm16(normal.x);
+                    value[1] = ToSnorm16(normal.y);
+
+                    if (tangentElem != nullptr)
+                    {
+                        Vector2 tangent = OctahedronEncode(readVector3(tangentElem, j));
+                        value[2] = ToSnorm16(tangent.x);
+                        value[3] = ToSnorm16(tangent.y);
+                    }
+                }
+                else if (dstElem->GetType() == VET_HALF2 && elem.GetType() == VET_FLOAT2)
+                {
+                    const float* uv = (const float*)srcVertex;
+
+                    UINT16* value = (UINT16*)dstVertex;
+                    value[0] = Bitwise::FloatToHalf(uv[0]);
+                    value[1] = Bitwise::FloatToHalf(uv[1]);
+                }
+                else if (dstElem->GetType() == VET_UBYTE4_NORM && elem.GetType() == VET_FLOAT4)
+                {
+                    // Rounding can make the weights sum to a bit more or less than one, which scales skinned vertices.
+                    // The difference goes to the largest weight, where it matters the least.
+                    const float* weights = (const float*)srcVertex;
+                    UINT8* value = dstVertex;
+
+                    INT32 sum = 0;
+                    UINT32 largest = 0;
+                    for (UINT32 k = 0; k < 4; k++)
+                    {
+                        value[k] = (UINT8)Math::RoundToInt(Math::Clamp01(weights[k]) * 255.0f);
+                        sum += value[k];
+
+                        if (value[k] > value[largest])
+                            largest = k;
+                    }
+
+                    if (sum > 0)
+                        value[largest] = (UINT8)Math::Clamp(value[largest] + 255 - sum, 0, 255);
+                }
+                else
+                {
+                    memcpy(dstVertex, srcVertex, elem.GetSize());
+                }
+            }
+        }
+
+        return output;
+    }
 }
@@ -232,6 +232,25 @@ namespace te
         /**	Creates a vertex descriptor from a vertex layout enum. */
         static SPtr<VertexDataDesc> VertexLayoutVertexDesc(VertexLayout type);
 
+        /**
+         * Converts mesh data using full precision vertex layouts to a compact layout, decoded by the vertex shaders:
+         *  - Positions become VET_SHORT4_NORM, quantized over the position bounds (see
+         *    MeshData::SetPositionQuantization). w holds the sign of the bitangent.
+         *  - Normals and tangents are octahedral encoded into a single VET_SHORT4_NORM normal, normal in xy and tangent in
+         *    zw. Bitangents are not stored, shaders rebuild them from the normal, the tangent and the sign.
+         *  - Texture coordinates become VET_HALF2.
+         *  - Bone weights become VET_UBYTE4_NORM.
+         *
+         * Other elements are copied as they are. Index data and vertex order are kept.
+         *
+         * @param[in]	meshData		Mesh data to convert. Positions must be VET_FLOAT3 or VET_FLOAT4.
+         * @param[in]	positionBounds	Optional. Box the positions are quantized over. Meshes drawn with the same
+         *								per-object data, like a mesh and its z pre pass mesh, must be quantized over the
+         *								same box. Uses the bounds of the positions if not provided.
+         * @return						Compact mesh data, or @p meshData if it can't be converted.
+         */
+        static SPtr<MeshData> Compress(const SPtr<MeshData>& meshData, const AABox* positionBounds = nullptr);
+
     private:
         friend class Renderer;
 
@@ -192,7 +192,7 @@ namespace te
     void RendererUtility::SetPassParams(const SPtr<GpuParams> gpuParams, UINT32 gpuParamsBindFlags, bool isInstanced)
     {
         static const Vector<String> PerInstancedBuffer = { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer" };
-        static const Vector<String> PerNonInstancedBuffer = { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer", "PerInstanceBuffer"};
+        static const Vector<String> PerNonInstancedBuffer = { "PerCameraBuffer", "PerLightsBuffer", "PerFrameBuffer", "PerInstanceBuffer", "PerInstanceObjectBuffer" };
 
         if (gpuParams == nullptr)
             return;
@@ -211,6 +211,16 @@ namespace te
     }
 
     void RendererUtility::Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances)
+    {
+        MeshletRange range;
+        range.IndexOffset = subMesh.IndexOffset;
+        range.IndexCount = subMesh.IndexCount;
+
+        Draw(mesh, subMesh, &range, 1, numInstances);
+    }
+
+    void RendererUtility::Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, const MeshletRange* ranges,
+        UINT32 numRanges, UINT32 numInstances)
     {
         RenderAPI& rapi = RenderAPI::Instance();
         SPtr<VertexData> vertexData = mesh->GetVertexData();
@@ -246,17 +256,20 @@ namespace te
 
         rapi.SetDrawOperation(subMesh.DrawOp);
 
-        UINT32 indexCount = subMesh.IndexCount;
-
-        if (numInstances > 1)
-        {
-            rapi.DrawIndexed(subMesh.IndexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
-                vertexData->vertexCount, numInstances);
-        }
-        else
+        for (UINT32 i = 0; i < numRanges; i++)
         {
-            rapi.DrawIndexed(subMesh.IndexOffset + mesh->GetIndexOffset(), indexCount, mesh->GetVertexOffset(),
-                vertexData->vertexCount, 0);
+            const MeshletRange& range = ranges[i];
+
+            if (numInstances > 1)
+            {
+                rapi.DrawIndexed(range.IndexOffset + mesh->GetIndexOffset(), range.IndexCount, mesh->GetVertexOffset(),
+                    vertexData->vertexCount, numInstances);
+            }
+            else
+            {
+                rapi.DrawIndexed(range.IndexOffset + mesh->GetIndexOffset(), range.IndexCount, mesh->GetVertexOffset(),
+                    vertexData->vertexCount, 0);
+            }
         }
 
         mesh->NotifyUsedOnGPU();
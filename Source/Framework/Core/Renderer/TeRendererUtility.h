@@ -78,6 +78,18 @@ namespace te
          */
         void Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, UINT32 numInstances = 1);
 
+        /**
+         * Draws index ranges of a sub-mesh, such as its meshlets left visible after culling, with a draw call per range.
+         *
+         * @param[in]	mesh			Mesh to draw.
+         * @param[in]	subMesh			Sub-mesh the ranges belong to, provides the draw operation.
+         * @param[in]	ranges			Ranges of the index buffer of the mesh to draw.
+         * @param[in]	numRanges		Number of entries in @p ranges.
+         * @param[in]	numInstances	Number of times to draw the ranges using instanced rendering.
+         */
+        void Draw(const SPtr<Mesh>& mesh, const SubMesh& subMesh, const MeshletRange* ranges, UINT32 numRanges,
+            UINT32 numInstances = 1);
+
         /**
          * Draws a quad over the entire viewport in normalized device coordinates.
          *
@@ -9,6 +9,26 @@ namespace te
 {
     typedef UINT32 ComponentFlags;
 
+    /**
+     * Lets a component type opt in for batched updates. The scene manager keeps the components of such a type in a
+     * contiguous array and updates them all with a single call per frame, instead of calling Component::Update() through
+     * the handle of each one.
+     */
+    struct ComponentBatchUpdate
+    {
+        /** Updates the @p count components stored at @p components, all of the same type. */
+        typedef void(*UpdateAllFunc)(Component* const* components, UINT32 count);
+
+        /** Function updating the components of the type, null if the type doesn't opt in. */
+        UpdateAllFunc UpdateAll = nullptr;
+
+        /**
+         * True if the update of a component only writes to the component itself and reads the scene, in which case the
+         * array is split across threads. World transforms of the scene are up to date when parallel batches run.
+         */
+        bool Parallel = false;
+    };
+
     /**
      * Components represent primary logic elements in the scene. They are attached to scene objects.
      *
@@ -43,6 +63,12 @@ namespace te
         /** Called once per frame. Only called if the component is in Running state. */
         virtual void Update() { }
 
+        /**
+         * Returns how the components of this type are updated. By default they aren't batched and Update() is called on
+         * each of them.
+         */
+        virtual ComponentBatchUpdate GetBatchUpdate() const { return ComponentBatchUpdate(); }
+
         /**
          * Calculates bounds of the visible contents represented by this component (for example a mesh for Renderable).
          *
@@ -163,6 +189,17 @@ namespace te
          */
         virtual void OnTransformChanged(TransformChangedFlags flags) { }
 
+        /**
+         * Updates components of type @p T in a tight loop, calling T::Update() directly instead of through the virtual
+         * table. Meant to be returned by GetBatchUpdate() overrides.
+         */
+        template<class T>
+        static void UpdateAll(Component* const* components, UINT32 count)
+        {
+            for (UINT32 i = 0; i < count; i++)
+                static_cast<T*>(components[i])->T::Update();
+        }
+
         /** Checks whether the component wants to received the specified transform changed message. */
         bool SupportsNotify(TransformChangedFlags flags) const { return ( _notifyFlags & flags) != 0; }
 
@@ -3,6 +3,7 @@
 #include "TeCoreApplication.h"
 #include "Physics/TePhysics.h"
 #include "Utility/TeFrameAllocator.h"
+#include "Threading/TeTaskScheduler.h"
 
 namespace te
 {
@@ -74,6 +75,9 @@ namespace te
         _mainCameras.clear();
         _cameras.clear();
         _components.clear();
+        _unbatchedComponents.clear();
+        _pendingBatchedComponents.clear();
+        _componentBatches.clear();
         _mainRTResizedConn.Disconnect();
     }
 
@@ -124,6 +128,7 @@ namespace te
         te_frame_clear();
 
         _mainScene->_root = root;
+        _transformHierarchy.MarkStructureDirty();
         _mainScene->_root->_setParent(HSceneObject());
         _mainScene->_root->SetScene(_mainScene);
 
@@ -243,6 +248,33 @@ namespace te
     {
         component->OnCreated();
         _components.push_back(component);
+
+        const ComponentBatchUpdate batchUpdate = component->GetBatchUpdate();
+        if (batchUpdate.UpdateAll == nullptr)
+            _unbatchedComponents.push_back(component);
+        else if (_updatingBatches)
+            _pendingBatchedComponents.push_back(component);
+        else
+            AddToBatch(component.Get(), batchUpdate);
+    }
+
+    void SceneManager::AddToBatch(Component* component, const ComponentBatchUpdate& batchUpdate)
+    {
+        auto iterFind = std::find_if(_componentBatches.begin(), _componentBatches.end(),
+        [&](const ComponentBatch& batch)
+        {
+            return batch.Update.UpdateAll == batchUpdate.UpdateAll;
+        });
+
+        if (iterFind == _componentBatches.end())
+        {
+            _componentBatches.push_back({ batchUpdate, {} });
+            iterFind = _componentBatches.end() - 1;
+        }
+
+        // The id is the position in the batch, so the component can be swapped out of it when destroyed
+        component->SetSceneManagerId((UINT32)iterFind->Components.size());
+        iterFind->Components.push_back(component);
     }
 
     void SceneManager::NotifyComponentActivated(const HComponent& component, bool triggerEvent)
@@ -275,6 +307,40 @@ namespace te
         {
             _components.erase(co);
         }
+
+        const ComponentBatchUpdate batchUpdate = component->GetBatchUpdate();
+        if (batchUpdate.UpdateAll == nullptr)
+        {
+            auto iterFind = std::find(_unbatchedComponents.begin(), _unbatchedComponents.end(), component);
+            if (iterFind != _unbatchedComponents.end())
+                _unbatchedComponents.erase(iterFind);
+
+            return;
+        }
+
+        auto iterPending = std::find(_pendingBatchedComponents.begin(), _pendingBatchedComponents.end(), component);
+        if (iterPending != _pendingBatchedComponents.end())
+        {
+            _pendingBatchedComponents.erase(iterPending);
+            return;
+        }
+
+        for (auto& batch : _componentBatches)
+        {
+            if (batch.Update.UpdateAll != batchUpdate.UpdateAll)
+                continue;
+
+            Component* rawComponent = component.Get();
+            const UINT32 idx = rawComponent->GetSceneManagerId();
+            if (idx < (UINT32)batch.Components.size() && batch.Components[idx] == rawComponent)
+            {
+                batch.Components[idx] = batch.Components.back();
+                batch.Components[idx]->SetSceneManagerId(idx);
+                batch.Components.pop_back();
+            }
+
+            break;
+        }
     }
 
     bool SceneManager::IsComponentOfType(const HComponent& component, UINT32 id)
@@ -284,12 +350,48 @@ namespace te
 
     void SceneManager::Update()
     {
-        for (auto& entry : _components)
+        // Components created by an update land at the end of the array and get updated this frame as well
+        for (size_t i = 0; i < _unbatchedComponents.size(); i++)
         {
-            entry->Update();
+            _unbatchedComponents[i]->Update();
         }
 
+        // Batched components created by an update only join their batch once every batch is done, the arrays are
+        // walked through raw pointers
+        _updatingBatches = true;
+        for (auto& batch : _componentBatches)
+        {
+            const UINT32 numComponents = (UINT32)batch.Components.size();
+            if (numComponents == 0)
+                continue;
+
+            Component* const* components = batch.Components.data();
+            if (!batch.Update.Parallel || numComponents < PARALLEL_BATCH_GRAIN_SIZE * 2)
+            {
+                batch.Update.UpdateAll(components, numComponents);
+                continue;
+            }
+
+            // Lazily refreshing a world transform writes to the scene object, which isn't safe from several threads
+            _transformHierarchy.Update(_mainScene->GetRoot());
+
+            const ComponentBatchUpdate::UpdateAllFunc updateAll = batch.Update.UpdateAll;
+            gTaskScheduler().ParallelFor(0, numComponents, PARALLEL_BATCH_GRAIN_SIZE,
+            [updateAll, components](UINT32 begin, UINT32 end)
+            {
+                updateAll(components + begin, end - begin);
+            });
+        }
+        _updatingBatches = false;
+
+        for (auto& entry : _pendingBatchedComponents)
+            AddToBatch(entry.Get(), entry->GetBatchUpdate());
+
+        _pendingBatchedComponents.clear();
+
         GameObjectManager::Instance().DestroyQueuedObjects();
+
+        _transformHierarchy.Update(_mainScene->GetRoot());
     }
 
     void SceneManager::OnMainRenderTargetResized()
@@ -3,6 +3,7 @@
 #include "TeCorePrerequisites.h"
 #include "Utility/TeEvent.h"
 #include "TeSceneObject.h"
+#include "TeTransformHierarchy.h"
 #include "Physics/TePhysicsCommon.h"
 
 #include <cfloat>
@@ -167,9 +168,16 @@ namespace te
         /**	Notifies the scene manager that a camera either became the main camera, or has stopped being main camera. */
         void _notifyMainCameraStateChanged(const SPtr<Camera>& camera);
 
-        /** Called every frame. Calls update methods on all scene objects and their components. */
+        /**
+         * Called every frame. Calls update methods on all scene objects and their components, then refreshes the world
+         * transforms invalidated during the frame in a single pass. Components that aren't batched are updated first, in
+         * creation order, then each batch of components updated together (see Component::GetBatchUpdate()).
+         */
         void Update();
 
+        /** Returns the depth-first ordered view of the main scene used to propagate and update transforms. */
+        const TransformHierarchy& GetTransformHierarchy() const { return _transformHierarchy; }
+
         /** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
         void NotifyComponentCreated(const HComponent& component);
 
@@ -210,6 +218,19 @@ namespace te
         /** Checks does the specified component type match the provided id. */
         static bool IsComponentOfType(const HComponent& component, UINT32 id);
 
+        /** Components of all the types sharing the same batch update function. */
+        struct ComponentBatch
+        {
+            ComponentBatchUpdate Update;
+            Vector<Component*> Components;
+        };
+
+        /** Adds a component to the batch of components sharing its update function, creating the batch if needed. */
+        void AddToBatch(Component* component, const ComponentBatchUpdate& batchUpdate);
+
+        /** Number of components per task when a batch is updated in parallel. */
+        static constexpr UINT32 PARALLEL_BATCH_GRAIN_SIZE = 64;
+
     protected:
         SPtr<SceneInstance> _mainScene;
 
@@ -218,6 +239,11 @@ namespace te
         Vector<SPtr<Camera>> _mainCameras;
 
         Vector<HComponent> _components;
+        Vector<HComponent> _unbatchedComponents;
+        Vector<ComponentBatch> _componentBatches;
+        Vector<HComponent> _pendingBatchedComponents;
+        bool _updatingBatches = false;
+        TransformHierarchy _transformHierarchy;
 
         SPtr<RenderTarget> _mainRenderTarget;
         HEvent _mainRTResizedConn;
@@ -442,6 +442,7 @@ namespace te
                 child->DestroyInternal(child, true);
 
             _children.clear();
+            NotifyHierarchyChanged();
 
             // It's important to remove the elements from the array as soon as they're destroyed, as OnDestroy callbacks
             // for components might query the SO's components, and we want to only return live ones
@@ -729,6 +730,37 @@ namespace te
     }
 
     void SceneObject::NotifyTransformChanged(TransformChangedFlags flags) const
+    {
+        NotifyTransformChangedLocal(flags);
+
+        // Mobility flag is only relevant for this scene object
+        flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
+        if (flags == 0)
+            return;
+
+        // Descendants directly follow this object in the transform hierarchy, so they can be walked as a flat range
+        // instead of recursing through the children
+        UINT32 begin, end;
+        if (SceneManager::IsStarted())
+        {
+            TransformHierarchy& hierarchy = gSceneManager()._transformHierarchy;
+            if (hierarchy.GetRange(*this, begin, end))
+            {
+                if ((flags & TCF_Transform) != 0)
+                    hierarchy.MarkTransformsDirty(begin, end);
+
+                for (UINT32 i = begin + 1; i < end; i++)
+                    hierarchy.GetSceneObject(i)->NotifyTransformChangedLocal(flags);
+
+                return;
+            }
+        }
+
+        for (auto& entry : _children)
+            entry->NotifyTransformChanged(flags);
+    }
+
+    void SceneObject::NotifyTransformChangedLocal(TransformChangedFlags flags) const
     {
         // If object is immovable, don't send transform changed events nor mark the transform dirty
         TransformChangedFlags componentFlags = flags;
@@ -755,24 +787,28 @@ namespace te
                 }
             }
         }
+    }
 
-        // Mobility flag is only relevant for this scene object
-        flags = (TransformChangedFlags)(flags & ~TCF_Mobility);
-        if (flags != 0)
+    void SceneObject::UpdateWorldTfrm() const
+    {
+        if (_parent != nullptr && _mobility == ObjectMobility::Movable)
         {
-            for (auto& entry : _children)
-                entry->NotifyTransformChanged(flags);
+            // Makes sure the parent is up to date
+            _parent->GetTransform();
+            UpdateWorldTfrm(_parent.Get());
         }
+        else
+            UpdateWorldTfrm(nullptr);
     }
 
-    void SceneObject::UpdateWorldTfrm() const
+    void SceneObject::UpdateWorldTfrm(const SceneObject* parent) const
     {
         _worldTfrm = _localTfrm;
 
         // Don't allow movement from parent when not movable
-        if (_parent != nullptr && _mobility == ObjectMobility::Movable)
+        if (parent != nullptr && _mobility == ObjectMobility::Movable)
         {
-            _worldTfrm.MakeWorld(_parent->GetTransform());
+            _worldTfrm.MakeWorld(parent->_worldTfrm);
 
             _cachedWorldTfrm = _worldTfrm.GetMatrix();
         }
@@ -944,9 +980,16 @@ namespace te
         }
     }
 
+    void SceneObject::NotifyHierarchyChanged()
+    {
+        if (SceneManager::IsStarted())
+            gSceneManager()._transformHierarchy.MarkStructureDirty();
+    }
+
     void SceneObject::AddChild(const HSceneObject& object)
     {
         _children.push_back(object);
+        NotifyHierarchyChanged();
 
         object->SetFlags(_flags);
     }
@@ -956,7 +999,10 @@ namespace te
         auto result = find(_children.begin(), _children.end(), object);
 
         if (result != _children.end())
+        {
             _children.erase(result);
+            NotifyHierarchyChanged();
+        }
         else
         {
             TE_ASSERT_ERROR(false, "Trying to remove a child but it's not a child of the transform.");
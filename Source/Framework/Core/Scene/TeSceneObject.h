@@ -45,6 +45,7 @@ namespace te
         };
 
         friend class SceneManager;
+        friend class TransformHierarchy;
 
     public:
         virtual ~SceneObject();
@@ -268,6 +269,12 @@ namespace te
          */
         void NotifyTransformChanged(TransformChangedFlags flags) const;
 
+        /**
+         * Marks the transform of this object dirty and notifies its components, but not its children.
+         * @param	flags		Specifies in what way was the transform changed.
+         */
+        void NotifyTransformChangedLocal(TransformChangedFlags flags) const;
+
         /** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
         void UpdateLocalTfrm() const;
 
@@ -277,6 +284,12 @@ namespace te
          */
         void UpdateWorldTfrm() const;
 
+        /**
+         * Updates the world transform from the world transform of @p parent, which must be up to date. Null if the object
+         * has no parent.
+         */
+        void UpdateWorldTfrm(const SceneObject* parent) const;
+
         /**	Checks if cached local transform needs updating. */
         bool IsCachedLocalTfrmUpToDate() const { return (_dirtyFlags & DirtyFlags::LocalTfrmDirty) == 0; }
 
@@ -380,6 +393,9 @@ namespace te
          */
         void RemoveChild(const HSceneObject& object);
 
+        /** Invalidates the transform hierarchy of the scene manager after the children of this object changed. */
+        void NotifyHierarchyChanged();
+
     public: // ***** COMPONENT ******
         /** Constructs a new component of the specified type and adds it to the internal component list. */
         template<class T, class... Args>
@@ -694,6 +710,9 @@ namespace te
         mutable UINT32 _dirtyFlags = 0xFFFFFFFF;
         mutable UINT32 _dirtyHash = 0;
 
+        /** Index in the TransformHierarchy of the scene manager, only valid while the object is part of it. */
+        UINT32 _hierarchyIdx = (UINT32)-1;
+
         HSceneObject _thisHandle;
         UINT32 _flags;
 
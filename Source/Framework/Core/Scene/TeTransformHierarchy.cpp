@@ -0,0 +1,165 @@
+#include "Scene/TeTransformHierarchy.h"
+#include "Scene/TeSceneObject.h"
+#include "Threading/TeTaskScheduler.h"
+
+namespace te
+{
+    bool TransformHierarchy::GetRange(const SceneObject& sceneObject, UINT32& begin, UINT32& end) const
+    {
+        if (_structureDirty)
+            return false;
+
+        // Objects removed from the graph keep their last index, which now belongs to someone else
+        const UINT32 idx = sceneObject._hierarchyIdx;
+        if (idx >= (UINT32)_objects.size() || _objects[idx] != &sceneObject)
+            return false;
+
+        begin = idx;
+        end = _ends[idx];
+        return true;
+    }
+
+    void TransformHierarchy::MarkTransformsDirty(UINT32 begin, UINT32 end)
+    {
+        memset(_dirty.data() + begin, 1, end - begin);
+        _anyDirty = true;
+    }
+
+    void TransformHierarchy::Update(const HSceneObject& root)
+    {
+        if (_structureDirty)
+            Rebuild(root);
+
+        if (!_anyDirty)
+            return;
+
+        const UINT32 numLevels = (UINT32)_levelOffsets.size() - 1;
+        for (UINT32 level = 0; level < numLevels; level++)
+        {
+            // Parents live in the previous levels, which are done by now
+            const UINT32 begin = _levelOffsets[level];
+            const UINT32 end = _levelOffsets[level + 1];
+
+            if (end - begin < MIN_PARALLEL_LEVEL_SIZE)
+                UpdateWorldTransforms(begin, end);
+            else
+            {
+                gTaskScheduler().ParallelFor(begin, end, PARALLEL_GRAIN_SIZE, [this](UINT32 chunkBegin, UINT32 chunkEnd)
+                {
+                    UpdateWorldTransforms(chunkBegin, chunkEnd);
+                });
+            }
+        }
+
+        _anyDirty = false;
+    }
+
+    void TransformHierarchy::Rebuild(const HSceneObject& root)
+    {
+        _objects.clear();
+        _parents.clear();
+        _ends.clear();
+        _levelOrder.clear();
+        _levelOffsets.clear();
+
+        _structureDirty = false;
+
+        if (root.IsDestroyed())
+        {
+            _dirty.clear();
+            _levelOffsets.push_back(0);
+            _anyDirty = false;
+            return;
+        }
+
+        Vector<UINT32> depths;
+
+        struct StackEntry
+        {
+            SceneObject* Object;
+            UINT32 Parent;
+            UINT32 Depth;
+        };
+
+        // Children are pushed in reverse so they come out of the stack, and the order, in the same order as in the
+        // graph, which keeps the transform notifications in the order the recursive version sends them
+        Vector<StackEntry> stack;
+        stack.push_back({ root.Get(), (UINT32)-1, 0 });
+
+        UINT32 numLevels = 0;
+        while (!stack.empty())
+        {
+            const StackEntry entry = stack.back();
+            stack.pop_back();
+
+            const UINT32 idx = (UINT32)_objects.size();
+            entry.Object->_hierarchyIdx = idx;
+
+            _objects.push_back(entry.Object);
+            _parents.push_back(entry.Parent);
+            depths.push_back(entry.Depth);
+            numLevels = std::max(numLevels, entry.Depth + 1);
+
+            const Vector<HSceneObject>& children = entry.Object->_children;
+            for (auto iter = children.rbegin(); iter != children.rend(); ++iter)
+            {
+                if (!iter->IsDestroyed())
+                    stack.push_back({ iter->Get(), idx, entry.Depth + 1 });
+            }
+        }
+
+        // Descendants directly follow their ancestor, so a subtree ends where the next object of the same depth or
+        // shallower starts
+        const UINT32 numObjects = (UINT32)_objects.size();
+        _ends.resize(numObjects, numObjects);
+
+        Vector<UINT32> openPerDepth;
+        for (UINT32 i = 0; i < numObjects; i++)
+        {
+            const UINT32 depth = depths[i];
+            while ((UINT32)openPerDepth.size() > depth)
+            {
+                _ends[openPerDepth.back()] = i;
+                openPerDepth.pop_back();
+            }
+
+            openPerDepth.push_back(i);
+        }
+
+        // Counting sort of the indices per depth level, keeping the depth-first order inside a level
+        _levelOffsets.resize(numLevels + 1, 0);
+        for (UINT32 i = 0; i < numObjects; i++)
+            _levelOffsets[depths[i] + 1]++;
+
+        for (UINT32 level = 0; level < numLevels; level++)
+            _levelOffsets[level + 1] += _levelOffsets[level];
+
+        Vector<UINT32> levelCursors(_levelOffsets.begin(), _levelOffsets.end() - 1);
+        _levelOrder.resize(numObjects);
+        for (UINT32 i = 0; i < numObjects; i++)
+            _levelOrder[levelCursors[depths[i]]++] = i;
+
+        // Objects dirtied while the order was invalid didn't flag themselves here
+        _dirty.assign(numObjects, 1);
+        _anyDirty = numObjects > 0;
+    }
+
+    void TransformHierarchy::UpdateWorldTransforms(UINT32 begin, UINT32 end)
+    {
+        for (UINT32 i = begin; i < end; i++)
+        {
+            const UINT32 idx = _levelOrder[i];
+            if (!_dirty[idx])
+                continue;
+
+            _dirty[idx] = 0;
+
+            const SceneObject* sceneObject = _objects[idx];
+            if (sceneObject->IsCachedWorldTfrmUpToDate())
+                continue;
+
+            const UINT32 parentIdx = _parents[idx];
+            sceneObject->UpdateWorldTfrm(parentIdx != (UINT32)-1 ? _objects[parentIdx] : nullptr);
+        }
+    }
+}
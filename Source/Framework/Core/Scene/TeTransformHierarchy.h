@@ -0,0 +1,88 @@
+#pragma once
+
+#include "TeCorePrerequisites.h"
+
+namespace te
+{
+    /**
+     * Flat, depth-first ordered view of the scene graph used to update transforms without walking the SceneObject tree.
+     * Parents always come before their children and the descendants of an object form a contiguous index range, so
+     * propagating a transform change to a subtree is a loop over that range, and world transforms can be refreshed in
+     * one pass over the array, one depth level after the other.
+     *
+     * The order is rebuilt lazily: any change to the structure of the scene graph invalidates it, and it is only built
+     * again by Update(). While it is invalid, scene objects fall back to the recursive code paths.
+     */
+    class TE_CORE_EXPORT TransformHierarchy
+    {
+    public:
+        /** Number of objects of a depth level under which the world transform pass doesn't go wide. */
+        static constexpr UINT32 MIN_PARALLEL_LEVEL_SIZE = 1024;
+
+        /** Number of objects per task of the world transform pass. */
+        static constexpr UINT32 PARALLEL_GRAIN_SIZE = 256;
+
+        TransformHierarchy() = default;
+        ~TransformHierarchy() = default;
+
+        /** Invalidates the order. Must be called whenever a scene object gains or loses a child or is destroyed. */
+        void MarkStructureDirty() { _structureDirty = true; }
+
+        /** Returns true if the order matches the current scene graph. */
+        bool IsValid() const { return !_structureDirty; }
+
+        /**
+         * Finds the range of indices covering @p sceneObject and all of its descendants, the object itself being the first
+         * one.
+         *
+         * @return	False if the order is invalid or the object isn't part of it. The range is not written then.
+         */
+        bool GetRange(const SceneObject& sceneObject, UINT32& begin, UINT32& end) const;
+
+        /** Returns the scene object at an index of the order. */
+        SceneObject* GetSceneObject(UINT32 idx) const { return _objects[idx]; }
+
+        /**
+         * Flags the world transforms of the objects in [@p begin, @p end) as needing to be refreshed by the next Update().
+         */
+        void MarkTransformsDirty(UINT32 begin, UINT32 end);
+
+        /**
+         * Rebuilds the order from @p root if the scene graph changed, then refreshes every world transform that has
+         * been invalidated since the last call.
+         */
+        void Update(const HSceneObject& root);
+
+        /** Returns the number of objects in the order. */
+        UINT32 GetNumObjects() const { return (UINT32)_objects.size(); }
+
+    private:
+        /** Lists the objects under @p root in depth-first order and groups their indices per depth level. */
+        void Rebuild(const HSceneObject& root);
+
+        /** Refreshes the world transforms of the dirty objects in [@p begin, @p end) of the per level order. */
+        void UpdateWorldTransforms(UINT32 begin, UINT32 end);
+
+    private:
+        /** Scene objects, in depth-first order. */
+        Vector<SceneObject*> _objects;
+
+        /** Index of the parent of each object, (UINT32)-1 for the root. */
+        Vector<UINT32> _parents;
+
+        /** Index past the last descendant of each object. */
+        Vector<UINT32> _ends;
+
+        /** Set when the world transform of an object might need to be refreshed. */
+        Vector<UINT8> _dirty;
+
+        /** Indices of the objects sorted by depth level. */
+        Vector<UINT32> _levelOrder;
+
+        /** Start of each depth level in _levelOrder, followed by the total number of objects. */
+        Vector<UINT32> _levelOffsets;
+
+        bool _structureDirty = true;
+        bool _anyDirty = false;
+    };
+}
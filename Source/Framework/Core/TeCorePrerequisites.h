@@ -206,6 +206,10 @@ namespace te
     class VertexDeclaration;
     class VertexDataDesc;
     struct SubMesh;
+    struct MeshLod;
+    struct Meshlet;
+    struct MeshletRange;
+    class MeshBvh;
     class ShapeMeshes3D;
     class TextureView;
     class HardwareBuffer;
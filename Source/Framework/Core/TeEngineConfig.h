@@ -0,0 +1,47 @@
+#pragma once
+
+#define TE_RENDERER_MODULE "TeRenderMan"
+#define TE_RENDER_API_MODULE "TeGLRenderAPI"
+#define TE_AUDIO_MODULE "TeOpenAudio"
+#define TE_PHYSICS_MODULE "TeBulletPhysics"
+#define TE_GUI_MODULE "TeGLImGuiAPI"
+
+#define TE_RENDER_API_MODULE_D3D11 "TeD3D11RenderAPI"
+#define TE_RENDER_API_MODULE_OPENGL "TeGLRenderAPI"
+
+#define TE_GUI_API_MODULE_D3D11 "TeD3D11GuiAPI"
+#define TE_GUI_API_MODULE_OPENGL "TeGLGuiAPI"
+
+#define TE_VERSION "0.1"
+
+#define TE_PLATFORM_TARGET "x64"
+#define TE_PLATFORM_COMPILER "GNU"
+#define TE_PLATFORM_OS "Linux"
+
+/** Path to the framework root when files haven't been packaged yet (e.g. running from debugger). */
+static constexpr const char* RAW_APP_ROOT = "/root/repo/";
+
+/** When compiling Framework, we need to know where is C++ compiler */
+static constexpr const char* CXX_COMPILER_PATH = "/usr/bin/c++";
+
+/** When compiling Framework, we need to know where is vcvarsall.bat (on Windows) */
+static constexpr const char* MSVC_VCVARS = "";
+
+/** Path to render doc DLL (without extension) */
+static constexpr const char* RENDERDOC_PATH = "C:/Program Files/RenderDoc/renderdoc";
+
+/** Path to the binaries when files haven't been packaged yet (e.g. running from debugger). */
+#if TE_CONFIG == TE_CONFIG_DEBUG
+#   define TE_BINARIES_PATH = "/root/repo/bin/GNU.Debug.x64"
+#elif TE_CONFIG == TE_CONFIG_RELWITHDEBINFO
+#   define TE_BINARIES_PATH = "/root/repo/bin/GNU.RelWithDebInfo.x64"
+#elif TE_CONFIG == TE_CONFIG_MINSIZEREL
+#   define TE_BINARIES_PATH = "/root/repo/bin/GNU.MinSizeRel.x64"
+#elif TE_CONFIG == TE_CONFIG_RELEASE
+#   define TE_BINARIES_PATH = "/root/repo/bin/GNU.Release.x64"
+#endif
+
+/** Is D3D9 available */
+#if 0 == 1
+#   define TE_D3D9
+#endif
@@ -69,6 +69,8 @@ set(TE_UTILITY_INC_MATH
     "Utility/Math/TeLine2.h"
     "Utility/Math/TeMatrixNxM.h"
     "Utility/Math/TeConvexVolume.h"
+    "Utility/Math/TeSIMD.h"
+    "Utility/Math/TeBvh.h"
 )
 set(TE_UTILITY_SRC_MATH
     "Utility/Math/TeAABox.cpp"
@@ -94,6 +96,7 @@ set(TE_UTILITY_SRC_MATH
     "Utility/Math/TeLineSegment3.cpp"
     "Utility/Math/TeLine2.cpp"
     "Utility/Math/TeConvexVolume.cpp"
+    "Utility/Math/TeBvh.cpp"
 )
 
 set(TE_UTILITY_INC_PREPREQUISITES
@@ -3,6 +3,7 @@
 #include "Math/TePlane.h"
 #include "Math/TeSphere.h"
 #include "Math/TeMath.h"
+#include "Math/TeSIMD.h"
 
 namespace te
 {
@@ -163,30 +164,32 @@ namespace te
 
     void AABox::TransformAffine(const Matrix4& m)
     {
-        Vector3 min = m.GetTranslation();
-        Vector3 max = m.GetTranslation();
+        // Each axis of the box contributes its smallest and largest projection on every column of the matrix
+        SIMDFloat4 c0 = SIMD::Load(&m[0].x);
+        SIMDFloat4 c1 = SIMD::Load(&m[1].x);
+        SIMDFloat4 c2 = SIMD::Load(&m[2].x);
+        SIMDFloat4 translation = SIMD::Load(&m[3].x);
+        SIMD::Transpose(c0, c1, c2, translation);
+
+        const SIMDFloat4 columns[3] = { c0, c1, c2 };
+
+        SIMDFloat4 min = translation;
+        SIMDFloat4 max = translation;
         for (UINT32 i = 0; i < 3; i++)
         {
-            for (UINT32 j = 0; j < 3; j++)
-            {
-                float e = m[i][j] * _minimum[j];
-                float f = m[i][j] * _maximum[j];
-
-                if (e < f)
-                {
-                    min[i] += e;
-                    max[i] += f;
-                }
-                else
-                {
-                    min[i] += f;
-                    max[i] += e;
-                }
-            }
+            const SIMDFloat4 e = SIMD::Mul(columns[i], SIMD::Set(_minimum[i]));
+            const SIMDFloat4 f = SIMD::Mul(columns[i], SIMD::Set(_maximum[i]));
 
+            min = SIMD::Add(min, SIMD::Min(e, f));
+            max = SIMD::Add(max, SIMD::Max(e, f));
         }
 
-        SetExtents(min, max);
+        alignas(16) float newMin[4];
+        alignas(16) float newMax[4];
+        SIMD::Store(newMin, min);
+        SIMD::Store(newMax, max);
+
+        SetExtents(Vector3(newMin[0], newMin[1], newMin[2]), Vector3(newMax[0], newMax[1], newMax[2]));
     }
 
     bool AABox::Intersects(const AABox& b2) const
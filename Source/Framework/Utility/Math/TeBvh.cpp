@@ -0,0 +1,186 @@
+#include "Math/TeBvh.h"
+
+namespace te
+{
+    namespace
+    {
+        constexpr UINT32 NUM_BINS = 16;
+
+        /** Bounds containing nothing, any merged point replaces them. */
+        constexpr Vector3 EMPTY_MIN(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+        constexpr Vector3 EMPTY_MAX(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+
+        /** Half of the surface area of a box, enough to compare split costs. */
+        float HalfArea(const Vector3& min, const Vector3& max)
+        {
+            Vector3 size = Vector3::Max(max - min, Vector3::ZERO);
+            return size.x * size.y + size.y * size.z + size.z * size.x;
+        }
+
+        /** Range of primitives still to be turned into a node. */
+        struct BuildRange
+        {
+            UINT32 Node;
+            UINT32 Begin;
+            UINT32 End;
+            UINT32 Depth;
+        };
+
+        struct Bin
+        {
+            Vector3 Min = EMPTY_MIN;
+            Vector3 Max = EMPTY_MAX;
+            UINT32 Count = 0;
+        };
+    }
+
+    UINT32 Bvh::Build(const Vector<AABox>& boxes, UINT32 maxLeafSize, Vector<BvhNode>& nodes, Vector<UINT32>& order)
+    {
+        const UINT32 numPrimitives = (UINT32)boxes.size();
+        maxLeafSize = std::max(maxLeafSize, 1u);
+
+        nodes.clear();
+        order.resize(numPrimitives);
+        for (UINT32 i = 0; i < numPrimitives; i++)
+            order[i] = i;
+
+        Vector<Vector3> centers(numPrimitives);
+        for (UINT32 i = 0; i < numPrimitives; i++)
+            centers[i] = (boxes[i].GetMin() + boxes[i].GetMax()) * 0.5f;
+
+        nodes.reserve(numPrimitives > 0 ? 2 * ((numPrimitives + maxLeafSize - 1) / maxLeafSize) : 1);
+        nodes.push_back(BvhNode());
+
+        UINT32 depth = 1;
+        Vector<BuildRange> todo;
+        todo.push_back({ 0, 0, numPrimitives, 1 });
+
+        while (!todo.empty())
+        {
+            BuildRange range = todo.back();
+            todo.pop_back();
+
+            depth = std::max(depth, range.Depth);
+
+            Vector3 min = EMPTY_MIN;
+            Vector3 max = EMPTY_MAX;
+            Vector3 centerMin = min;
+            Vector3 centerMax = max;
+
+            for (UINT32 i = range.Begin; i < range.End; i++)
+            {
+                const AABox& box = boxes[order[i]];
+                min = Vector3::Min(min, box.GetMin());
+                max = Vector3::Max(max, box.GetMax());
+                centerMin = Vector3::Min(centerMin, centers[order[i]]);
+                centerMax = Vector3::Max(centerMax, centers[order[i]]);
+            }
+
+            BvhNode& node = nodes[range.Node];
+            node.Min = range.End > range.Begin ? min : Vector3::ZERO;
+            node.Max = range.End > range.Begin ? max : Vector3::ZERO;
+            node.First = range.Begin;
+            node.Count = range.End - range.Begin;
+
+            const UINT32 count = range.End - range.Begin;
+            if (count <= maxLeafSize)
+                continue;
+
+            // Best split over the bins of every axis, a split after bin i puts bins [0, i] on the left
+            float bestCost = std::numeric_limits<float>::max();
+            UINT32 bestAxis = 0;
+            UINT32 bestSplit = 0;
+
+            for (UINT32 axis = 0; axis < 3; axis++)
+            {
+                const float extent = centerMax[axis] - centerMin[axis];
+                if (extent <= 0.0f)
+                    continue;
+
+                const float binScale = NUM_BINS / extent;
+
+                Bin bins[NUM_BINS];
+                for (UINT32 i = range.Begin; i < range.End; i++)
+                {
+                    const UINT32 primitive = order[i];
+                    const UINT32 binIdx = std::min((UINT32)((centers[primitive][axis] - centerMin[axis]) * binScale), NUM_BINS - 1);
+
+                    Bin& bin = bins[binIdx];
+                    bin.Min = Vector3::Min(bin.Min, boxes[primitive].GetMin());
+                    bin.Max = Vector3::Max(bin.Max, boxes[primitive].GetMax());
+                    bin.Count++;
+                }
+
+                float rightCosts[NUM_BINS];
+                Vector3 rightMin = EMPTY_MIN;
+                Vector3 rightMax = EMPTY_MAX;
+                UINT32 rightCount = 0;
+
+                for (UINT32 i = NUM_BINS - 1; i > 0; i--)
+                {
+                    rightMin = Vector3::Min(rightMin, bins[i].Min);
+                    rightMax = Vector3::Max(rightMax, bins[i].Max);
+                    rightCount += bins[i].Count;
+                    rightCosts[i - 1] = rightCount > 0 ? HalfArea(rightMin, rightMax) * rightCount : 0.0f;
+                }
+
+                Vector3 leftMin = EMPTY_MIN;
+                Vector3 leftMax = EMPTY_MAX;
+                UINT32 leftCount = 0;
+
+                for (UINT32 i = 0; i < NUM_BINS - 1; i++)
+                {
+                    leftMin = Vector3::Min(leftMin, bins[i].Min);
+                    leftMax = Vector3::Max(leftMax, bins[i].Max);
+                    leftCount += bins[i].Count;
+
+                    if (leftCount == 0 || leftCount == count)
+                        continue;
+
+                    const float cost = HalfArea(leftMin, leftMax) * leftCount + rightCosts[i];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = i;
+                    }
+                }
+            }
+
+            UINT32 middle;
+            if (bestCost < std::numeric_limits<float>::max())
+            {
+                const float extent = centerMax[bestAxis] - centerMin[bestAxis];
+                const float binScale = NUM_BINS / extent;
+
+                UINT32* splitPoint = std::partition(order.data() + range.Begin, order.data() + range.End, [&](UINT32 primitive)
+                {
+                    const UINT32 binIdx = std::min((UINT32)((centers[primitive][bestAxis] - centerMin[bestAxis]) * binScale), NUM_BINS - 1);
+                    return binIdx <= bestSplit;
+                });
+
+                middle = (UINT32)(splitPoint - order.data());
+            }
+            else
+            {
+                // Every center is at the same position, any split is as good as another
+                middle = range.Begin + count / 2;
+            }
+
+            if (middle == range.Begin || middle == range.End)
+                middle = range.Begin + count / 2;
+
+            const UINT32 firstChild = (UINT32)nodes.size();
+            nodes[range.Node].First = firstChild;
+            nodes[range.Node].Count = 0;
+
+            nodes.push_back(BvhNode());
+            nodes.push_back(BvhNode());
+
+            todo.push_back({ firstChild + 1, middle, range.End, range.Depth + 1 });
+            todo.push_back({ firstChild, range.Begin, middle, range.Depth + 1 });
+        }
+
+        return depth;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+#include "Math/TeAABox.h"
+#include "Math/TeVector3.h"
+
+namespace te
+{
+    /**
+     * Node of a bounding volume hierarchy. Children of an interior node are stored next to each other, leaves reference
+     * a contiguous range of primitives.
+     */
+    struct BvhNode
+    {
+        Vector3 Min;
+
+        /** Index of the first child for interior nodes, of the first primitive in the leaf order for leaves. */
+        UINT32 First = 0;
+
+        Vector3 Max;
+
+        /** Number of primitives of a leaf, 0 for interior nodes. */
+        UINT32 Count = 0;
+    };
+
+    /** Builds and traverses bounding volume hierarchies over sets of boxes. */
+    class TE_UTILITY_EXPORT Bvh
+    {
+    public:
+        /**
+         * Builds a hierarchy over a set of primitives, splitting nodes along the axis and position minimizing the surface
+         * area heuristic, evaluated on bins of primitive centers.
+         *
+         * @param[in]	boxes		Bounds of every primitive.
+         * @param[in]	maxLeafSize	Maximum number of primitives in a leaf.
+         * @param[out]	nodes		Nodes of the hierarchy, the root first.
+         * @param[out]	order		Primitive indices in the order leaves reference them.
+         * @return					Depth of the hierarchy, 1 for a single leaf.
+         */
+        static UINT32 Build(const Vector<AABox>& boxes, UINT32 maxLeafSize, Vector<BvhNode>& nodes, Vector<UINT32>& order);
+
+        /**
+         * Ray / node box intersection.
+         *
+         * @param[in]	node		Node to test.
+         * @param[in]	origin		Ray origin.
+         * @param[in]	invDir		Inverse of each component of the ray direction, see InverseDirection().
+         * @param[in]	maxDistance	Intersections further than this are ignored.
+         * @param[out]	distance	Distance at which the ray enters the box, 0 if the origin is inside.
+         * @return					True if the ray intersects the box before @p maxDistance.
+         */
+        static bool Intersects(const BvhNode& node, const Vector3& origin, const Vector3& invDir, float maxDistance,
+            float& distance)
+        {
+            float tx0 = (node.Min.x - origin.x) * invDir.x;
+            float tx1 = (node.Max.x - origin.x) * invDir.x;
+            float ty0 = (node.Min.y - origin.y) * invDir.y;
+            float ty1 = (node.Max.y - origin.y) * invDir.y;
+            float tz0 = (node.Min.z - origin.z) * invDir.z;
+            float tz1 = (node.Max.z - origin.z) * invDir.z;
+
+            float tMin = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+            float tMax = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::min(std::max(tz0, tz1), maxDistance));
+
+            distance = tMin;
+            return tMin <= tMax;
+        }
+
+        /** Returns the inverse of each component of a ray direction, with zero components mapped to a huge value. */
+        static Vector3 InverseDirection(const Vector3& direction)
+        {
+            auto Inverse = [](float value)
+            {
+                return std::fabs(value) > 1e-20f ? 1.0f / value : std::copysign(1e30f, value);
+            };
+
+            return Vector3(Inverse(direction.x), Inverse(direction.y), Inverse(direction.z));
+        }
+    };
+}
@@ -59,108 +59,122 @@ namespace te
         return det;
     }
 
-    Matrix4 Matrix4::Inverse() const
-    {
-        float m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
-        float m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
-        float m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
-        float m30 = m[3][0], m31 = m[3][1], m32 = m[3][2], m33 = m[3][3];
-
-        float v0 = m20 * m31 - m21 * m30;
-        float v1 = m20 * m32 - m22 * m30;
-        float v2 = m20 * m33 - m23 * m30;
-        float v3 = m21 * m32 - m22 * m31;
-        float v4 = m21 * m33 - m23 * m31;
-        float v5 = m22 * m33 - m23 * m32;
-
-        float t00 = +(v5 * m11 - v4 * m12 + v3 * m13);
-        float t10 = -(v5 * m10 - v2 * m12 + v1 * m13);
-        float t20 = +(v4 * m10 - v2 * m11 + v0 * m13);
-        float t30 = -(v3 * m10 - v1 * m11 + v0 * m12);
-
-        float invDet = 1 / (t00 * m00 + t10 * m01 + t20 * m02 + t30 * m03);
-
-        float d00 = t00 * invDet;
-        float d10 = t10 * invDet;
-        float d20 = t20 * invDet;
-        float d30 = t30 * invDet;
-
-        float d01 = -(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
-        float d11 = +(v5 * m00 - v2 * m02 + v1 * m03) * invDet;
-        float d21 = -(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
-        float d31 = +(v3 * m00 - v1 * m01 + v0 * m02) * invDet;
-
-        v0 = m10 * m31 - m11 * m30;
-        v1 = m10 * m32 - m12 * m30;
-        v2 = m10 * m33 - m13 * m30;
-        v3 = m11 * m32 - m12 * m31;
-        v4 = m11 * m33 - m13 * m31;
-        v5 = m12 * m33 - m13 * m32;
-
-        float d02 = +(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
-        float d12 = -(v5 * m00 - v2 * m02 + v1 * m03) * invDet;
-        float d22 = +(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
-        float d32 = -(v3 * m00 - v1 * m01 + v0 * m02) * invDet;
-
-        v0 = m21 * m10 - m20 * m11;
-        v1 = m22 * m10 - m20 * m12;
-        v2 = m23 * m10 - m20 * m13;
-        v3 = m22 * m11 - m21 * m12;
-        v4 = m23 * m11 - m21 * m13;
-        v5 = m23 * m12 - m22 * m13;
-
-        float d03 = -(v5 * m01 - v4 * m02 + v3 * m03) * invDet;
-        float d13 = +(v5 * m00 - v2 * m02 + v1 * m03) * invDet;
-        float d23 = -(v4 * m00 - v2 * m01 + v0 * m03) * invDet;
-        float d33 = +(v3 * m00 - v1 * m01 + v0 * m02) * invDet;
-
-        return Matrix4(
-            d00, d01, d02, d03,
-            d10, d11, d12, d13,
-            d20, d21, d22, d23,
-            d30, d31, d32, d33);
-    }
-
-    Matrix4 Matrix4::InverseAffine() const
+    namespace
     {
-        float m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
-        float m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
-
-        float t00 = m22 * m11 - m21 * m12;
-        float t10 = m20 * m12 - m22 * m10;
-        float t20 = m21 * m10 - m20 * m11;
+        // 2x2 matrices packed in a register as [m00 m01 m10 m11], used by the block-wise inverse below
 
-        float m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
-
-        float invDet = 1 / (m00 * t00 + m01 * t10 + m02 * t20);
-
-        t00 *= invDet; t10 *= invDet; t20 *= invDet;
-
-        m00 *= invDet; m01 *= invDet; m02 *= invDet;
-
-        float r00 = t00;
-        float r01 = m02 * m21 - m01 * m22;
-        float r02 = m01 * m12 - m02 * m11;
-
-        float r10 = t10;
-        float r11 = m00 * m22 - m02 * m20;
-        float r12 = m02 * m10 - m00 * m12;
+        /** Returns a * b. */
+        SIMDFloat4 Mat2Mul(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            return SIMD::Add(SIMD::Mul(a, SIMD::Shuffle<0, 3, 0, 3>(b, b)),
+                SIMD::Mul(SIMD::Shuffle<1, 0, 3, 2>(a, a), SIMD::Shuffle<2, 1, 2, 1>(b, b)));
+        }
 
-        float r20 = t20;
-        float r21 = m01 * m20 - m00 * m21;
-        float r22 = m00 * m11 - m01 * m10;
+        /** Returns adjugate(a) * b. */
+        SIMDFloat4 Mat2AdjMul(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            return SIMD::Sub(SIMD::Mul(SIMD::Shuffle<3, 3, 0, 0>(a, a), b),
+                SIMD::Mul(SIMD::Shuffle<1, 1, 2, 2>(a, a), SIMD::Shuffle<2, 3, 0, 1>(b, b)));
+        }
 
-        float m03 = m[0][3], m13 = m[1][3], m23 = m[2][3];
+        /** Returns a * adjugate(b). */
+        SIMDFloat4 Mat2MulAdj(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            return SIMD::Sub(SIMD::Mul(a, SIMD::Shuffle<3, 0, 3, 0>(b, b)),
+                SIMD::Mul(SIMD::Shuffle<1, 0, 3, 2>(a, a), SIMD::Shuffle<2, 1, 2, 1>(b, b)));
+        }
+    }
 
-        float r03 = -(r00 * m03 + r01 * m13 + r02 * m23);
-        float r13 = -(r10 * m03 + r11 * m13 + r12 * m23);
-        float r23 = -(r20 * m03 + r21 * m13 + r22 * m23);
+    Matrix4 Matrix4::Inverse() const
+    {
+        // Block-wise inverse, the matrix is split in four 2x2 matrices:
+        // | A B |
+        // | C D |
+        const SIMDFloat4 r0 = SIMD::Load(m[0]);
+        const SIMDFloat4 r1 = SIMD::Load(m[1]);
+        const SIMDFloat4 r2 = SIMD::Load(m[2]);
+        const SIMDFloat4 r3 = SIMD::Load(m[3]);
+
+        const SIMDFloat4 a = SIMD::Shuffle<0, 1, 0, 1>(r0, r1);
+        const SIMDFloat4 b = SIMD::Shuffle<2, 3, 2, 3>(r0, r1);
+        const SIMDFloat4 c = SIMD::Shuffle<0, 1, 0, 1>(r2, r3);
+        const SIMDFloat4 d = SIMD::Shuffle<2, 3, 2, 3>(r2, r3);
+
+        // Determinants of A, B, C and D
+        const SIMDFloat4 detSub = SIMD::Sub(
+            SIMD::Mul(SIMD::Shuffle<0, 2, 0, 2>(r0, r2), SIMD::Shuffle<1, 3, 1, 3>(r1, r3)),
+            SIMD::Mul(SIMD::Shuffle<1, 3, 1, 3>(r0, r2), SIMD::Shuffle<0, 2, 0, 2>(r1, r3)));
+
+        const SIMDFloat4 detA = SIMD::Splat<0>(detSub);
+        const SIMDFloat4 detB = SIMD::Splat<1>(detSub);
+        const SIMDFloat4 detC = SIMD::Splat<2>(detSub);
+        const SIMDFloat4 detD = SIMD::Splat<3>(detSub);
+
+        const SIMDFloat4 dc = Mat2AdjMul(d, c);
+        const SIMDFloat4 ab = Mat2AdjMul(a, b);
+
+        SIMDFloat4 x = SIMD::Sub(SIMD::Mul(detD, a), Mat2Mul(b, dc));
+        SIMDFloat4 w = SIMD::Sub(SIMD::Mul(detA, d), Mat2Mul(c, ab));
+        SIMDFloat4 y = SIMD::Sub(SIMD::Mul(detB, c), Mat2MulAdj(d, ab));
+        SIMDFloat4 z = SIMD::Sub(SIMD::Mul(detC, b), Mat2MulAdj(a, dc));
+
+        // det(M) = det(A) * det(D) + det(B) * det(C) - trace(adj(A) * B * adj(D) * C)
+        SIMDFloat4 trace = SIMD::Mul(ab, SIMD::Shuffle<0, 2, 1, 3>(dc, dc));
+        trace = SIMD::Add(trace, SIMD::Shuffle<2, 3, 0, 1>(trace, trace));
+        trace = SIMD::Add(trace, SIMD::Shuffle<1, 0, 3, 2>(trace, trace));
+
+        const SIMDFloat4 det = SIMD::Sub(SIMD::Add(SIMD::Mul(detA, detD), SIMD::Mul(detB, detC)), trace);
+        const SIMDFloat4 invDet = SIMD::Div(SIMD::Set(1.0f, -1.0f, -1.0f, 1.0f), det);
+
+        x = SIMD::Mul(x, invDet);
+        y = SIMD::Mul(y, invDet);
+        z = SIMD::Mul(z, invDet);
+        w = SIMD::Mul(w, invDet);
+
+        Matrix4 r;
+        SIMD::Store(r.m[0], SIMD::Shuffle<3, 1, 3, 1>(x, y));
+        SIMD::Store(r.m[1], SIMD::Shuffle<2, 0, 2, 0>(x, y));
+        SIMD::Store(r.m[2], SIMD::Shuffle<3, 1, 3, 1>(z, w));
+        SIMD::Store(r.m[3], SIMD::Shuffle<2, 0, 2, 0>(z, w));
+
+        return r;
+    }
 
-        return Matrix4(
-            r00, r01, r02, r03,
-            r10, r11, r12, r13,
-            r20, r21, r22, r23,
-            0, 0, 0, 1);
+    Matrix4 Matrix4::InverseAffine() const
+    {
+        const SIMDFloat4 r0 = SIMD::Load(m[0]);
+        const SIMDFloat4 r1 = SIMD::Load(m[1]);
+        const SIMDFloat4 r2 = SIMD::Load(m[2]);
+
+        // Rows of the adjugate of the 3x3 part, which are the columns of its inverse once divided by the determinant
+        SIMDFloat4 c0 = SIMD::Cross3(r1, r2);
+        SIMDFloat4 c1 = SIMD::Cross3(r2, r0);
+        SIMDFloat4 c2 = SIMD::Cross3(r0, r1);
+
+        SIMDFloat4 det = SIMD::Mul(r0, c0);
+        det = SIMD::Add(det, SIMD::Shuffle<2, 3, 0, 1>(det, det));
+        det = SIMD::Add(det, SIMD::Shuffle<1, 0, 3, 2>(det, det));
+
+        const SIMDFloat4 invDet = SIMD::Div(SIMD::Set(1.0f), det);
+        c0 = SIMD::Mul(c0, invDet);
+        c1 = SIMD::Mul(c1, invDet);
+        c2 = SIMD::Mul(c2, invDet);
+
+        // Inverse translation, -inverse(3x3) * translation, with the 1 of the last row in the last lane
+        SIMDFloat4 c3 = SIMD::Mul(c0, SIMD::Splat<3>(r0));
+        c3 = SIMD::MulAdd(c1, SIMD::Splat<3>(r1), c3);
+        c3 = SIMD::MulAdd(c2, SIMD::Splat<3>(r2), c3);
+        c3 = SIMD::Sub(SIMD::Set(0.0f, 0.0f, 0.0f, 1.0f), c3);
+
+        SIMD::Transpose(c0, c1, c2, c3);
+
+        Matrix4 r;
+        SIMD::Store(r.m[0], c0);
+        SIMD::Store(r.m[1], c1);
+        SIMD::Store(r.m[2], c2);
+        SIMD::Store(r.m[3], c3);
+
+        return r;
     }
 
     void Matrix4::SetTRS(const Vector3& translation, const Quaternion& rotation, const Vector3& scale)
@@ -6,6 +6,7 @@
 #include "Math/TeMatrix3.h"
 #include "Math/TeVector4.h"
 #include "Math/TePlane.h"
+#include "Math/TeSIMD.h"
 
 #if TE_PLATFORM == TE_PLATFORM_WIN32
 #   undef near
@@ -14,7 +15,10 @@
 
 namespace te
 {
-     /** Class representing a 4x4 matrix, in row major format. */
+     /**
+      * Class representing a 4x4 matrix, in row major format. Rows are 16 byte aligned so products, inverses and
+      * transforms run on SIMD registers (see SIMD).
+      */
     class TE_UTILITY_EXPORT Matrix4
     {
     public:
@@ -94,27 +98,23 @@ namespace te
 
         Matrix4 operator* (const Matrix4 &rhs) const
         {
-            Matrix4 r;
-
-            r.m[0][0] = m[0][0] * rhs.m[0][0] + m[0][1] * rhs.m[1][0] + m[0][2] * rhs.m[2][0] + m[0][3] * rhs.m[3][0];
-            r.m[0][1] = m[0][0] * rhs.m[0][1] + m[0][1] * rhs.m[1][1] + m[0][2] * rhs.m[2][1] + m[0][3] * rhs.m[3][1];
-            r.m[0][2] = m[0][0] * rhs.m[0][2] + m[0][1] * rhs.m[1][2] + m[0][2] * rhs.m[2][2] + m[0][3] * rhs.m[3][2];
-            r.m[0][3] = m[0][0] * rhs.m[0][3] + m[0][1] * rhs.m[1][3] + m[0][2] * rhs.m[2][3] + m[0][3] * rhs.m[3][3];
+            const SIMDFloat4 rhs0 = SIMD::Load(rhs.m[0]);
+            const SIMDFloat4 rhs1 = SIMD::Load(rhs.m[1]);
+            const SIMDFloat4 rhs2 = SIMD::Load(rhs.m[2]);
+            const SIMDFloat4 rhs3 = SIMD::Load(rhs.m[3]);
 
-            r.m[1][0] = m[1][0] * rhs.m[0][0] + m[1][1] * rhs.m[1][0] + m[1][2] * rhs.m[2][0] + m[1][3] * rhs.m[3][0];
-            r.m[1][1] = m[1][0] * rhs.m[0][1] + m[1][1] * rhs.m[1][1] + m[1][2] * rhs.m[2][1] + m[1][3] * rhs.m[3][1];
-            r.m[1][2] = m[1][0] * rhs.m[0][2] + m[1][1] * rhs.m[1][2] + m[1][2] * rhs.m[2][2] + m[1][3] * rhs.m[3][2];
-            r.m[1][3] = m[1][0] * rhs.m[0][3] + m[1][1] * rhs.m[1][3] + m[1][2] * rhs.m[2][3] + m[1][3] * rhs.m[3][3];
+            Matrix4 r;
+            for (UINT32 i = 0; i < 4; i++)
+            {
+                const SIMDFloat4 row = SIMD::Load(m[i]);
 
-            r.m[2][0] = m[2][0] * rhs.m[0][0] + m[2][1] * rhs.m[1][0] + m[2][2] * rhs.m[2][0] + m[2][3] * rhs.m[3][0];
-            r.m[2][1] = m[2][0] * rhs.m[0][1] + m[2][1] * rhs.m[1][1] + m[2][2] * rhs.m[2][1] + m[2][3] * rhs.m[3][1];
-            r.m[2][2] = m[2][0] * rhs.m[0][2] + m[2][1] * rhs.m[1][2] + m[2][2] * rhs.m[2][2] + m[2][3] * rhs.m[3][2];
-            r.m[2][3] = m[2][0] * rhs.m[0][3] + m[2][1] * rhs.m[1][3] + m[2][2] * rhs.m[2][3] + m[2][3] * rhs.m[3][3];
+                SIMDFloat4 result = SIMD::Mul(SIMD::Splat<0>(row), rhs0);
+                result = SIMD::MulAdd(SIMD::Splat<1>(row), rhs1, result);
+                result = SIMD::MulAdd(SIMD::Splat<2>(row), rhs2, result);
+                result = SIMD::MulAdd(SIMD::Splat<3>(row), rhs3, result);
 
-            r.m[3][0] = m[3][0] * rhs.m[0][0] + m[3][1] * rhs.m[1][0] + m[3][2] * rhs.m[2][0] + m[3][3] * rhs.m[3][0];
-            r.m[3][1] = m[3][0] * rhs.m[0][1] + m[3][1] * rhs.m[1][1] + m[3][2] * rhs.m[2][1] + m[3][3] * rhs.m[3][1];
-            r.m[3][2] = m[3][0] * rhs.m[0][2] + m[3][1] * rhs.m[1][2] + m[3][2] * rhs.m[2][2] + m[3][3] * rhs.m[3][2];
-            r.m[3][3] = m[3][0] * rhs.m[0][3] + m[3][1] * rhs.m[1][3] + m[3][2] * rhs.m[2][3] + m[3][3] * rhs.m[3][3];
+                SIMD::Store(r.m[i], result);
+            }
 
             return r;
         }
@@ -217,10 +217,19 @@ namespace te
         /** Returns a transpose of the matrix (switched columns and rows). */
         Matrix4 Transpose() const
         {
-            return Matrix4(m[0][0], m[1][0], m[2][0], m[3][0],
-                m[0][1], m[1][1], m[2][1], m[3][1],
-                m[0][2], m[1][2], m[2][2], m[3][2],
-                m[0][3], m[1][3], m[2][3], m[3][3]);
+            SIMDFloat4 r0 = SIMD::Load(m[0]);
+            SIMDFloat4 r1 = SIMD::Load(m[1]);
+            SIMDFloat4 r2 = SIMD::Load(m[2]);
+            SIMDFloat4 r3 = SIMD::Load(m[3]);
+            SIMD::Transpose(r0, r1, r2, r3);
+
+            Matrix4 r;
+            SIMD::Store(r.m[0], r0);
+            SIMD::Store(r.m[1], r1);
+            SIMD::Store(r.m[2], r2);
+            SIMD::Store(r.m[3], r3);
+
+            return r;
         }
 
         /** Assigns the vector to a column of the matrix. */
@@ -322,23 +331,26 @@ namespace te
          */
         Matrix4 ConcatenateAffine(const Matrix4 &other) const
         {
-            return Matrix4(
-                m[0][0] * other.m[0][0] + m[0][1] * other.m[1][0] + m[0][2] * other.m[2][0],
-                m[0][0] * other.m[0][1] + m[0][1] * other.m[1][1] + m[0][2] * other.m[2][1],
-                m[0][0] * other.m[0][2] + m[0][1] * other.m[1][2] + m[0][2] * other.m[2][2],
-                m[0][0] * other.m[0][3] + m[0][1] * other.m[1][3] + m[0][2] * other.m[2][3] + m[0][3],
-
-                m[1][0] * other.m[0][0] + m[1][1] * other.m[1][0] + m[1][2] * other.m[2][0],
-                m[1][0] * other.m[0][1] + m[1][1] * other.m[1][1] + m[1][2] * other.m[2][1],
-                m[1][0] * other.m[0][2] + m[1][1] * other.m[1][2] + m[1][2] * other.m[2][2],
-                m[1][0] * other.m[0][3] + m[1][1] * other.m[1][3] + m[1][2] * other.m[2][3] + m[1][3],
-
-                m[2][0] * other.m[0][0] + m[2][1] * other.m[1][0] + m[2][2] * other.m[2][0],
-                m[2][0] * other.m[0][1] + m[2][1] * other.m[1][1] + m[2][2] * other.m[2][1],
-                m[2][0] * other.m[0][2] + m[2][1] * other.m[1][2] + m[2][2] * other.m[2][2],
-                m[2][0] * other.m[0][3] + m[2][1] * other.m[1][3] + m[2][2] * other.m[2][3] + m[2][3],
-
-                0, 0, 0, 1);
+            const SIMDFloat4 other0 = SIMD::Load(other.m[0]);
+            const SIMDFloat4 other1 = SIMD::Load(other.m[1]);
+            const SIMDFloat4 other2 = SIMD::Load(other.m[2]);
+            const SIMDFloat4 other3 = SIMD::Set(0.0f, 0.0f, 0.0f, 1.0f);
+
+            Matrix4 r;
+            for (UINT32 i = 0; i < 3; i++)
+            {
+                const SIMDFloat4 row = SIMD::Load(m[i]);
+
+                SIMDFloat4 result = SIMD::Mul(SIMD::Splat<0>(row), other0);
+                result = SIMD::MulAdd(SIMD::Splat<1>(row), other1, result);
+                result = SIMD::MulAdd(SIMD::Splat<2>(row), other2, result);
+                result = SIMD::MulAdd(SIMD::Splat<3>(row), other3, result);
+
+                SIMD::Store(r.m[i], result);
+            }
+
+            SIMD::Store(r.m[3], other3);
+            return r;
         }
 
         /**
@@ -368,10 +380,10 @@ namespace te
          */
         Vector3 MultiplyAffine(const Vector3& v) const
         {
-            return Vector3(
-                m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3],
-                m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3],
-                m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3]);
+            alignas(16) float r[4];
+            SIMD::Store(r, DotRows(SIMD::Set(v.x, v.y, v.z, 1.0f)));
+
+            return Vector3(r[0], r[1], r[2]);
         }
 
         /**
@@ -381,20 +393,19 @@ namespace te
          */
         Vector4 MultiplyAffine(const Vector4& v) const
         {
-            return Vector4(
-                m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3] * v.w,
-                m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3] * v.w,
-                m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3] * v.w,
-                v.w);
+            alignas(16) float r[4];
+            SIMD::Store(r, DotRows(SIMD::LoadUnaligned(&v.x)));
+
+            return Vector4(r[0], r[1], r[2], v.w);
         }
 
         /** Transform a 3D direction by this matrix. */
         Vector3 MultiplyDirection(const Vector3& v) const
         {
-            return Vector3(
-                m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
-                m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
-                m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+            alignas(16) float r[4];
+            SIMD::Store(r, DotRows(SIMD::Set(v.x, v.y, v.z, 0.0f)));
+
+            return Vector3(r[0], r[1], r[2]);
         }
 
         /**
@@ -408,15 +419,12 @@ namespace te
          */
         Vector3 Multiply(const Vector3& v) const
         {
-            Vector3 r(TeZero);
-
-            float fInvW = 1.0f / (m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3]);
+            const SIMDFloat4 r = DotRows(SIMD::Set(v.x, v.y, v.z, 1.0f));
 
-            r.x = (m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3]) * fInvW;
-            r.y = (m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3]) * fInvW;
-            r.z = (m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3]) * fInvW;
+            alignas(16) float projected[4];
+            SIMD::Store(projected, SIMD::Div(r, SIMD::Splat<3>(r)));
 
-            return r;
+            return Vector3(projected[0], projected[1], projected[2]);
         }
 
         /**
@@ -426,12 +434,10 @@ namespace te
          */
         Vector4 Multiply(const Vector4& v) const
         {
-            return Vector4(
-                m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3] * v.w,
-                m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3] * v.w,
-                m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3] * v.w,
-                m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3] * v.w
-            );
+            Vector4 r;
+            SIMD::StoreUnaligned(&r.x, DotRows(SIMD::LoadUnaligned(&v.x)));
+
+            return r;
         }
 
         /** Creates a view matrix and applies optional reflection. */
@@ -498,6 +504,13 @@ namespace te
         static const Matrix4 IDENTITY;
 
     private:
-        float m[4][4];
+        /** Returns the dot product of every row with @p v, one per lane. */
+        SIMDFloat4 DotRows(SIMDFloat4 v) const
+        {
+            return SIMD::Dot4(SIMD::Load(m[0]), SIMD::Load(m[1]), SIMD::Load(m[2]), SIMD::Load(m[3]), v);
+        }
+
+    private:
+        alignas(16) float m[4][4];
     };
 }
@@ -268,11 +268,17 @@ namespace te
 
     Vector3 Quaternion::Rotate(const Vector3& v) const
     {
-        // Note: Does compiler generate fast code here? Perhaps its better to pull all code locally without constructing
-        //       an intermediate matrix.
-        Matrix3 rot;
-        ToRotationMatrix(rot);
-        return rot.Multiply(v);
+        // v + w * t + q.xyz x t with t = 2 * q.xyz x v, cheaper than going through a rotation matrix
+        const SIMDFloat4 q = SIMD::LoadUnaligned(&x);
+        const SIMDFloat4 vec = SIMD::Set(v.x, v.y, v.z, 0.0f);
+
+        const SIMDFloat4 t = SIMD::Mul(SIMD::Cross3(q, vec), SIMD::Set(2.0f));
+        const SIMDFloat4 result = SIMD::Add(SIMD::MulAdd(t, SIMD::Splat<3>(q), vec), SIMD::Cross3(q, t));
+
+        alignas(16) float output[4];
+        SIMD::Store(output, result);
+
+        return Vector3(output[0], output[1], output[2]);
     }
 
     void Quaternion::LookRotation(const Vector3& forwardDir)
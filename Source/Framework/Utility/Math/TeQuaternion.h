@@ -3,6 +3,7 @@
 #include "Prerequisites/TePrerequisitesUtility.h"
 #include "Math/TeMath.h"
 #include "Math/TeVector3.h"
+#include "Math/TeSIMD.h"
 
 namespace te
 {
@@ -193,13 +194,10 @@ namespace te
 
         Quaternion operator* (const Quaternion& rhs) const
         {
-            return Quaternion
-            (
-                w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z,
-                w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
-                w * rhs.y + y * rhs.w + z * rhs.x - x * rhs.z,
-                w * rhs.z + z * rhs.w + x * rhs.y - y * rhs.x
-            );
+            Quaternion r;
+            SIMD::StoreUnaligned(&r.x, Multiply(SIMD::LoadUnaligned(&x), SIMD::LoadUnaligned(&rhs.x)));
+
+            return r;
         }
 
         Quaternion operator* (float rhs) const
@@ -261,15 +259,7 @@ namespace te
 
         Quaternion& operator*= (const Quaternion& rhs)
         {
-            float newW = w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z;
-            float newX = w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y;
-            float newY = w * rhs.y + y * rhs.w + z * rhs.x - x * rhs.z;
-            float newZ = w * rhs.z + z * rhs.w + x * rhs.y - y * rhs.x;
-
-            w = newW;
-            x = newX;
-            y = newY;
-            z = newZ;
+            SIMD::StoreUnaligned(&x, Multiply(SIMD::LoadUnaligned(&x), SIMD::LoadUnaligned(&rhs.x)));
 
             return *this;
         }
@@ -385,6 +375,23 @@ namespace te
         static const Quaternion IDENTITY;
 
         float x, y, z, w; // Note: Order is relevant, don't break it
+
+    private:
+        /** Hamilton product of two quaternions stored as (x, y, z, w). */
+        static SIMDFloat4 Multiply(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            const SIMDFloat4 xTerm = SIMD::Mul(SIMD::Mul(SIMD::Splat<0>(a), SIMD::Shuffle<3, 2, 1, 0>(b, b)),
+                SIMD::Set(1.0f, -1.0f, 1.0f, -1.0f));
+            const SIMDFloat4 yTerm = SIMD::Mul(SIMD::Mul(SIMD::Splat<1>(a), SIMD::Shuffle<2, 3, 0, 1>(b, b)),
+                SIMD::Set(1.0f, 1.0f, -1.0f, -1.0f));
+            const SIMDFloat4 zTerm = SIMD::Mul(SIMD::Mul(SIMD::Splat<2>(a), SIMD::Shuffle<1, 0, 3, 2>(b, b)),
+                SIMD::Set(-1.0f, 1.0f, 1.0f, -1.0f));
+
+            SIMDFloat4 result = SIMD::Mul(SIMD::Splat<3>(a), b);
+            result = SIMD::Add(result, xTerm);
+            result = SIMD::Add(result, yTerm);
+            return SIMD::Add(result, zTerm);
+        }
     };
 }
 
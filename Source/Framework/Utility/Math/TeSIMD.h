@@ -0,0 +1,303 @@
+#pragma once
+
+#include "Prerequisites/TePrerequisitesUtility.h"
+
+#include <cmath>
+
+// Finds which SIMD instruction set can be used. SSE is part of the x86_64 baseline and SSE4.1 is enabled for GCC/Clang
+// builds, NEON is used on ARM targets. Everything else falls back to a plain scalar implementation.
+#if defined(__SSE4_1__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define TE_SIMD_SSE 1
+#   include <emmintrin.h>
+#   if defined(__FMA__) || defined(__AVX2__)
+#       define TE_SIMD_FMA 1
+#       include <immintrin.h>
+#   endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define TE_SIMD_NEON 1
+#   include <arm_neon.h>
+#else
+#   define TE_SIMD_SCALAR 1
+#endif
+
+/** Number of floats processed by a single SIMD register. */
+#define TE_SIMD_WIDTH 4
+
+namespace te
+{
+#if TE_SIMD_SSE
+    typedef __m128 SIMDFloat4;
+#elif TE_SIMD_NEON
+    typedef float32x4_t SIMDFloat4;
+#else
+    struct SIMDFloat4
+    {
+        float V[4];
+    };
+#endif
+
+    /**
+     * Thin wrapper over the native SIMD instruction set. All operations work on four packed floats. Comparison operations
+     * return a mask with all bits set for lanes where the comparison is true, which can then be fed to Select().
+     *
+     * @note	Load() and Store() expect 16 byte aligned addresses.
+     */
+    struct SIMD
+    {
+        /** Rounds up the provided element count to a multiple of the SIMD width. */
+        static constexpr UINT32 AlignCount(UINT32 count)
+        {
+            return (count + TE_SIMD_WIDTH - 1) & ~(UINT32)(TE_SIMD_WIDTH - 1);
+        }
+
+        /** Returns lane @p I of @p a in every lane. */
+        template<int I>
+        static SIMDFloat4 Splat(SIMDFloat4 a) { return Shuffle<I, I, I, I>(a, a); }
+
+        /** Transposes the 4x4 matrix whose rows are @p r0 to @p r3. */
+        static void Transpose(SIMDFloat4& r0, SIMDFloat4& r1, SIMDFloat4& r2, SIMDFloat4& r3)
+        {
+            const SIMDFloat4 t0 = Shuffle<0, 1, 0, 1>(r0, r1);
+            const SIMDFloat4 t1 = Shuffle<2, 3, 2, 3>(r0, r1);
+            const SIMDFloat4 t2 = Shuffle<0, 1, 0, 1>(r2, r3);
+            const SIMDFloat4 t3 = Shuffle<2, 3, 2, 3>(r2, r3);
+
+            r0 = Shuffle<0, 2, 0, 2>(t0, t2);
+            r1 = Shuffle<1, 3, 1, 3>(t0, t2);
+            r2 = Shuffle<0, 2, 0, 2>(t1, t3);
+            r3 = Shuffle<1, 3, 1, 3>(t1, t3);
+        }
+
+        /** Returns the cross product of the first three lanes of @p a and @p b, the last lane is 0. */
+        static SIMDFloat4 Cross3(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            const SIMDFloat4 aYZX = Shuffle<1, 2, 0, 3>(a, a);
+            const SIMDFloat4 bYZX = Shuffle<1, 2, 0, 3>(b, b);
+            const SIMDFloat4 aZXY = Shuffle<2, 0, 1, 3>(a, a);
+            const SIMDFloat4 bZXY = Shuffle<2, 0, 1, 3>(b, b);
+
+            return Sub(Mul(aYZX, bZXY), Mul(aZXY, bYZX));
+        }
+
+        /** Returns the dot products of @p r0 to @p r3 with @p v, one per lane. */
+        static SIMDFloat4 Dot4(const SIMDFloat4& r0, const SIMDFloat4& r1, const SIMDFloat4& r2, const SIMDFloat4& r3,
+            const SIMDFloat4& v)
+        {
+            const SIMDFloat4 p0 = Mul(r0, v);
+            const SIMDFloat4 p1 = Mul(r1, v);
+            const SIMDFloat4 p2 = Mul(r2, v);
+            const SIMDFloat4 p3 = Mul(r3, v);
+
+            const SIMDFloat4 s01 = Add(Shuffle<0, 1, 0, 1>(p0, p1), Shuffle<2, 3, 2, 3>(p0, p1));
+            const SIMDFloat4 s23 = Add(Shuffle<0, 1, 0, 1>(p2, p3), Shuffle<2, 3, 2, 3>(p2, p3));
+
+            return Add(Shuffle<0, 2, 0, 2>(s01, s23), Shuffle<1, 3, 1, 3>(s01, s23));
+        }
+
+#if TE_SIMD_SSE
+        static SIMDFloat4 Load(const float* src) { return _mm_load_ps(src); }
+        static SIMDFloat4 LoadUnaligned(const float* src) { return _mm_loadu_ps(src); }
+        static void Store(float* dst, SIMDFloat4 v) { _mm_store_ps(dst, v); }
+        static void StoreUnaligned(float* dst, SIMDFloat4 v) { _mm_storeu_ps(dst, v); }
+        static SIMDFloat4 Set(float v) { return _mm_set1_ps(v); }
+        static SIMDFloat4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+        static SIMDFloat4 Zero() { return _mm_setzero_ps(); }
+
+        static SIMDFloat4 Add(SIMDFloat4 a, SIMDFloat4 b) { return _mm_add_ps(a, b); }
+        static SIMDFloat4 Sub(SIMDFloat4 a, SIMDFloat4 b) { return _mm_sub_ps(a, b); }
+        static SIMDFloat4 Mul(SIMDFloat4 a, SIMDFloat4 b) { return _mm_mul_ps(a, b); }
+        static SIMDFloat4 Div(SIMDFloat4 a, SIMDFloat4 b) { return _mm_div_ps(a, b); }
+        static SIMDFloat4 Sqrt(SIMDFloat4 a) { return _mm_sqrt_ps(a); }
+        static SIMDFloat4 Min(SIMDFloat4 a, SIMDFloat4 b) { return _mm_min_ps(a, b); }
+        static SIMDFloat4 Max(SIMDFloat4 a, SIMDFloat4 b) { return _mm_max_ps(a, b); }
+        static SIMDFloat4 Neg(SIMDFloat4 a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+        static SIMDFloat4 CmpEq(SIMDFloat4 a, SIMDFloat4 b) { return _mm_cmpeq_ps(a, b); }
+        static SIMDFloat4 CmpNeq(SIMDFloat4 a, SIMDFloat4 b) { return _mm_cmpneq_ps(a, b); }
+        static SIMDFloat4 CmpLt(SIMDFloat4 a, SIMDFloat4 b) { return _mm_cmplt_ps(a, b); }
+        static SIMDFloat4 CmpLe(SIMDFloat4 a, SIMDFloat4 b) { return _mm_cmple_ps(a, b); }
+        static SIMDFloat4 CmpGt(SIMDFloat4 a, SIMDFloat4 b) { return _mm_cmpgt_ps(a, b); }
+        static SIMDFloat4 CmpGe(SIMDFloat4 a, SIMDFloat4 b) { return _mm_cmpge_ps(a, b); }
+
+        static SIMDFloat4 And(SIMDFloat4 a, SIMDFloat4 b) { return _mm_and_ps(a, b); }
+        static SIMDFloat4 Or(SIMDFloat4 a, SIMDFloat4 b) { return _mm_or_ps(a, b); }
+
+        /** Returns @p a for lanes where @p mask is set and @p b otherwise. */
+        static SIMDFloat4 Select(SIMDFloat4 mask, SIMDFloat4 a, SIMDFloat4 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        /** Returns a bitmask with one bit per lane, set if the lane of @p mask is set. */
+        static int MoveMask(SIMDFloat4 mask) { return _mm_movemask_ps(mask); }
+
+        /** Returns a * b + c, as a single fused operation when the target supports it. */
+        static SIMDFloat4 MulAdd(SIMDFloat4 a, SIMDFloat4 b, SIMDFloat4 c)
+        {
+#if TE_SIMD_FMA
+            return _mm_fmadd_ps(a, b, c);
+#else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+        }
+
+        /** Returns lanes @p I0 and @p I1 of @p a followed by lanes @p I2 and @p I3 of @p b. */
+        template<int I0, int I1, int I2, int I3>
+        static SIMDFloat4 Shuffle(SIMDFloat4 a, SIMDFloat4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(I3, I2, I1, I0)); }
+#elif TE_SIMD_NEON
+        static SIMDFloat4 Load(const float* src) { return vld1q_f32(src); }
+        static SIMDFloat4 LoadUnaligned(const float* src) { return vld1q_f32(src); }
+        static void Store(float* dst, SIMDFloat4 v) { vst1q_f32(dst, v); }
+        static void StoreUnaligned(float* dst, SIMDFloat4 v) { vst1q_f32(dst, v); }
+        static SIMDFloat4 Set(float v) { return vdupq_n_f32(v); }
+        static SIMDFloat4 Set(float x, float y, float z, float w) { const float v[4] = { x, y, z, w }; return vld1q_f32(v); }
+        static SIMDFloat4 Zero() { return vdupq_n_f32(0.0f); }
+
+        static SIMDFloat4 Add(SIMDFloat4 a, SIMDFloat4 b) { return vaddq_f32(a, b); }
+        static SIMDFloat4 Sub(SIMDFloat4 a, SIMDFloat4 b) { return vsubq_f32(a, b); }
+        static SIMDFloat4 Mul(SIMDFloat4 a, SIMDFloat4 b) { return vmulq_f32(a, b); }
+        static SIMDFloat4 Div(SIMDFloat4 a, SIMDFloat4 b) { return vdivq_f32(a, b); }
+        static SIMDFloat4 Sqrt(SIMDFloat4 a) { return vsqrtq_f32(a); }
+        static SIMDFloat4 Min(SIMDFloat4 a, SIMDFloat4 b) { return vminq_f32(a, b); }
+        static SIMDFloat4 Max(SIMDFloat4 a, SIMDFloat4 b) { return vmaxq_f32(a, b); }
+        static SIMDFloat4 Neg(SIMDFloat4 a) { return vnegq_f32(a); }
+
+        static SIMDFloat4 CmpEq(SIMDFloat4 a, SIMDFloat4 b) { return vreinterpretq_f32_u32(vceqq_f32(a, b)); }
+        static SIMDFloat4 CmpNeq(SIMDFloat4 a, SIMDFloat4 b) { return vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(a, b))); }
+        static SIMDFloat4 CmpLt(SIMDFloat4 a, SIMDFloat4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+        static SIMDFloat4 CmpLe(SIMDFloat4 a, SIMDFloat4 b) { return vreinterpretq_f32_u32(vcleq_f32(a, b)); }
+        static SIMDFloat4 CmpGt(SIMDFloat4 a, SIMDFloat4 b) { return vreinterpretq_f32_u32(vcgtq_f32(a, b)); }
+        static SIMDFloat4 CmpGe(SIMDFloat4 a, SIMDFloat4 b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+
+        static SIMDFloat4 And(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+        }
+
+        static SIMDFloat4 Or(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)));
+        }
+
+        /** Returns @p a for lanes where @p mask is set and @p b otherwise. */
+        static SIMDFloat4 Select(SIMDFloat4 mask, SIMDFloat4 a, SIMDFloat4 b)
+        {
+            return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+        }
+
+        /** Returns a bitmask with one bit per lane, set if the lane of @p mask is set. */
+        static int MoveMask(SIMDFloat4 mask)
+        {
+            uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+            return (int)(vgetq_lane_u32(bits, 0) | (vgetq_lane_u32(bits, 1) << 1) |
+                (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+        }
+
+        /** Returns a * b + c. */
+        static SIMDFloat4 MulAdd(SIMDFloat4 a, SIMDFloat4 b, SIMDFloat4 c) { return vmlaq_f32(c, a, b); }
+
+        /** Returns lanes @p I0 and @p I1 of @p a followed by lanes @p I2 and @p I3 of @p b. */
+        template<int I0, int I1, int I2, int I3>
+        static SIMDFloat4 Shuffle(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            float32x4_t output = vdupq_n_f32(vgetq_lane_f32(a, I0));
+            output = vsetq_lane_f32(vgetq_lane_f32(a, I1), output, 1);
+            output = vsetq_lane_f32(vgetq_lane_f32(b, I2), output, 2);
+            return vsetq_lane_f32(vgetq_lane_f32(b, I3), output, 3);
+        }
+#else
+        static SIMDFloat4 Load(const float* src) { return { { src[0], src[1], src[2], src[3] } }; }
+        static SIMDFloat4 LoadUnaligned(const float* src) { return Load(src); }
+        static void Store(float* dst, SIMDFloat4 v) { for (UINT32 i = 0; i < 4; i++) dst[i] = v.V[i]; }
+        static void StoreUnaligned(float* dst, SIMDFloat4 v) { Store(dst, v); }
+        static SIMDFloat4 Set(float v) { return { { v, v, v, v } }; }
+        static SIMDFloat4 Set(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+        static SIMDFloat4 Zero() { return Set(0.0f); }
+
+        static SIMDFloat4 Add(SIMDFloat4 a, SIMDFloat4 b) { return Apply(a, b, [](float x, float y) { return x + y; }); }
+        static SIMDFloat4 Sub(SIMDFloat4 a, SIMDFloat4 b) { return Apply(a, b, [](float x, float y) { return x - y; }); }
+        static SIMDFloat4 Mul(SIMDFloat4 a, SIMDFloat4 b) { return Apply(a, b, [](float x, float y) { return x * y; }); }
+        static SIMDFloat4 Div(SIMDFloat4 a, SIMDFloat4 b) { return Apply(a, b, [](float x, float y) { return x / y; }); }
+        static SIMDFloat4 Sqrt(SIMDFloat4 a) { return Apply(a, a, [](float x, float) { return std::sqrt(x); }); }
+        static SIMDFloat4 Min(SIMDFloat4 a, SIMDFloat4 b) { return Apply(a, b, [](float x, float y) { return x < y ? x : y; }); }
+        static SIMDFloat4 Max(SIMDFloat4 a, SIMDFloat4 b) { return Apply(a, b, [](float x, float y) { return x > y ? x : y; }); }
+        static SIMDFloat4 Neg(SIMDFloat4 a) { return Apply(a, a, [](float x, float) { return -x; }); }
+
+        static SIMDFloat4 CmpEq(SIMDFloat4 a, SIMDFloat4 b) { return Compare(a, b, [](float x, float y) { return x == y; }); }
+        static SIMDFloat4 CmpNeq(SIMDFloat4 a, SIMDFloat4 b) { return Compare(a, b, [](float x, float y) { return x != y; }); }
+        static SIMDFloat4 CmpLt(SIMDFloat4 a, SIMDFloat4 b) { return Compare(a, b, [](float x, float y) { return x < y; }); }
+        static SIMDFloat4 CmpLe(SIMDFloat4 a, SIMDFloat4 b) { return Compare(a, b, [](float x, float y) { return x <= y; }); }
+        static SIMDFloat4 CmpGt(SIMDFloat4 a, SIMDFloat4 b) { return Compare(a, b, [](float x, float y) { return x > y; }); }
+        static SIMDFloat4 CmpGe(SIMDFloat4 a, SIMDFloat4 b) { return Compare(a, b, [](float x, float y) { return x >= y; }); }
+
+        static SIMDFloat4 And(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            SIMDFloat4 output;
+            for (UINT32 i = 0; i < 4; i++)
+                output.V[i] = FromBits(ToBits(a.V[i]) & ToBits(b.V[i]));
+
+            return output;
+        }
+
+        static SIMDFloat4 Or(SIMDFloat4 a, SIMDFloat4 b)
+        {
+            SIMDFloat4 output;
+            for (UINT32 i = 0; i < 4; i++)
+                output.V[i] = FromBits(ToBits(a.V[i]) | ToBits(b.V[i]));
+
+            return output;
+        }
+
+        /** Returns @p a for lanes where @p mask is set and @p b otherwise. */
+        static SIMDFloat4 Select(SIMDFloat4 mask, SIMDFloat4 a, SIMDFloat4 b)
+        {
+            SIMDFloat4 output;
+            for (UINT32 i = 0; i < 4; i++)
+                output.V[i] = ToBits(mask.V[i]) != 0 ? a.V[i] : b.V[i];
+
+            return output;
+        }
+
+        /** Returns a bitmask with one bit per lane, set if the lane of @p mask is set. */
+        static int MoveMask(SIMDFloat4 mask)
+        {
+            int output = 0;
+            for (UINT32 i = 0; i < 4; i++)
+                output |= (ToBits(mask.V[i]) != 0 ? 1 : 0) << i;
+
+            return output;
+        }
+
+        /** Returns a * b + c. */
+        static SIMDFloat4 MulAdd(SIMDFloat4 a, SIMDFloat4 b, SIMDFloat4 c) { return Add(Mul(a, b), c); }
+
+        /** Returns lanes @p I0 and @p I1 of @p a followed by lanes @p I2 and @p I3 of @p b. */
+        template<int I0, int I1, int I2, int I3>
+        static SIMDFloat4 Shuffle(SIMDFloat4 a, SIMDFloat4 b) { return { { a.V[I0], a.V[I1], b.V[I2], b.V[I3] } }; }
+
+    private:
+        static UINT32 ToBits(float v) { UINT32 bits; memcpy(&bits, &v, sizeof(bits)); return bits; }
+        static float FromBits(UINT32 bits) { float v; memcpy(&v, &bits, sizeof(v)); return v; }
+
+        template<class OP>
+        static SIMDFloat4 Apply(SIMDFloat4 a, SIMDFloat4 b, OP op)
+        {
+            SIMDFloat4 output;
+            for (UINT32 i = 0; i < 4; i++)
+                output.V[i] = op(a.V[i], b.V[i]);
+
+            return output;
+        }
+
+        template<class OP>
+        static SIMDFloat4 Compare(SIMDFloat4 a, SIMDFloat4 b, OP op)
+        {
+            SIMDFloat4 output;
+            for (UINT32 i = 0; i < 4; i++)
+                output.V[i] = FromBits(op(a.V[i], b.V[i]) ? 0xFFFFFFFF : 0);
+
+            return output;
+        }
+#endif
+    };
+}
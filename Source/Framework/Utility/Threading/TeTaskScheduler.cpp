@@ -2,6 +2,46 @@
 
 namespace te
 {
+    namespace
+    {
+        /** State shared by the calling thread and the worker tasks of a single parallel loop. */
+        struct ParallelLoop
+        {
+            std::atomic<UINT32> NextChunk{ 0 };
+            std::atomic<UINT32> NumRemaining{ 0 };
+            Mutex MutexDone;
+            Signal DoneVar; /**< Notified once the last chunk is processed. */
+            UINT32 NumChunks = 0;
+            UINT32 Begin = 0;
+            UINT32 End = 0;
+            UINT32 GrainSize = 1;
+            const std::function<void(UINT32, UINT32)>* Func = nullptr;
+        };
+
+        /** Processes chunks of the loop until there are none left. */
+        void RunChunks(ParallelLoop& loop)
+        {
+            while (true)
+            {
+                const UINT32 chunk = loop.NextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= loop.NumChunks)
+                    break;
+
+                const UINT32 begin = loop.Begin + chunk * loop.GrainSize;
+                const UINT32 end = std::min(begin + loop.GrainSize, loop.End);
+                (*loop.Func)(begin, end);
+
+                if (loop.NumRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    // Taking the lock makes sure the thread waiting for the loop either hasn't checked the counter yet
+                    // or is already waiting for the notification
+                    { Lock lock(loop.MutexDone); }
+                    loop.DoneVar.notify_all();
+                }
+            }
+        }
+    }
+
     Task::Task(const String& name, std::function<void()> taskWorker, std::function<void()> callback)
         : _name(name)
         , _taskWorker(std::move(taskWorker))
@@ -31,6 +71,9 @@ namespace te
     void Task::Cancel()
     {
         _state = 3;
+
+        { Lock lock(_mutexDone); }
+        _doneVar.notify_all();
     }
 
     void Task::Execute()
@@ -41,6 +84,9 @@ namespace te
             _taskWorker();
             if (_callback) _callback();
             _state = 2;
+
+            { Lock lock(_mutexDone); }
+            _doneVar.notify_all();
         }
     }
 
@@ -99,6 +145,69 @@ namespace te
         _conditionVar.notify_one();
     }
 
+    void TaskScheduler::ParallelFor(UINT32 begin, UINT32 end, UINT32 grainSize,
+        const std::function<void(UINT32, UINT32)>& func, UINT32 maxThreads)
+    {
+        if (end <= begin)
+            return;
+
+        grainSize = std::max(grainSize, 1u);
+        const UINT32 numChunks = (end - begin + grainSize - 1) / grainSize;
+        const UINT32 numThreads = maxThreads == 0 ? _threadCount + 1 : std::min(maxThreads, _threadCount + 1);
+        const UINT32 numTasks = std::min(numChunks, numThreads) - 1;
+
+        if (numTasks == 0)
+        {
+            for (UINT32 chunkBegin = begin; chunkBegin < end; chunkBegin += grainSize)
+                func(chunkBegin, std::min(chunkBegin + grainSize, end));
+
+            return;
+        }
+
+        // Tasks might only start once the loop is done, so they keep the state alive by themselves. They won't touch
+        // func in that case since there are no chunks left.
+        SPtr<ParallelLoop> loop = te_shared_ptr_new<ParallelLoop>();
+        loop->NumChunks = numChunks;
+        loop->NumRemaining = numChunks;
+        loop->Begin = begin;
+        loop->End = end;
+        loop->GrainSize = grainSize;
+        loop->Func = &func;
+
+        for (UINT32 i = 0; i < numTasks; i++)
+            AddTask(Task::Create("ParallelFor", [loop]() { RunChunks(*loop); }));
+
+        RunChunks(*loop);
+
+        // Remaining chunks are being processed by worker threads, there is nothing left to help with
+        Lock lock(loop->MutexDone);
+        loop->DoneVar.wait(lock, [&loop] { return loop->NumRemaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    void TaskScheduler::Wait(const SPtr<Task>& task)
+    {
+        bool queued = false;
+        {
+            Lock lock(_mutexTasks);
+
+            auto iterFind = std::find(_tasks.begin(), _tasks.end(), task);
+            if (iterFind != _tasks.end())
+            {
+                _tasks.erase(iterFind);
+                queued = true;
+            }
+        }
+
+        if (queued)
+        {
+            task->Execute();
+            return;
+        }
+
+        Lock lock(task->_mutexDone);
+        task->_doneVar.wait(lock, [&task] { return task->IsComplete() || task->IsCanceled(); });
+    }
+
     void TaskScheduler::RunThread()
     {
         SPtr<Task> task;
@@ -45,6 +45,9 @@ namespace te
         std::function<void()> _taskWorker;
         std::function<void()> _callback;
         std::atomic<UINT32> _state{ 0 }; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
+
+        Mutex _mutexDone;
+        Signal _doneVar; /**< Notified once the task is completed. */
     };
 
     /**
@@ -73,6 +76,34 @@ namespace te
         /** Queues a new task. */
         void AddTask(SPtr<Task> task);
 
+        /** Get the number of threads used */
+        UINT32 GetThreadCount() const { return _threadCount; }
+
+        /**
+         * Splits [@p begin, @p end) in chunks of @p grainSize indices and calls @p func on each chunk, from the worker
+         * threads and from the calling thread. Returns once every chunk is processed. Chunks run in no particular order,
+         * @p func must only write data owned by its chunk for the result not to depend on the scheduling.
+         *
+         * @param[in]	begin		First index of the range.
+         * @param[in]	end			Index past the last index of the range.
+         * @param[in]	grainSize	Number of indices per chunk.
+         * @param[in]	func		Called with the first index of a chunk and the index past its last index.
+         * @param[in]	maxThreads	Maximum number of threads working on the range, including the calling thread. 0 to use
+         *							every worker thread.
+         *
+         * @note	The calling thread processes chunks as well, so it is safe to call from a task.
+         */
+        void ParallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, const std::function<void(UINT32, UINT32)>& func,
+            UINT32 maxThreads = 0);
+
+        /**
+         * Returns once @p task is completed or canceled. A task no worker thread has started yet is removed from the
+         * queue and executed by the calling thread, otherwise the calling thread sleeps until the task is done.
+         *
+         * @note	Safe to call from a task, it never waits for a task that isn't running.
+         */
+        void Wait(const SPtr<Task>& task);
+
     protected:
         friend class Task;
 
@@ -85,9 +116,6 @@ namespace te
         /** Returns true if at least one task is running */
         bool AreTasksRunning() const { return GetThreadsAvailable() != GetThreadCount(); }
 
-        /** Get the number of threads used */
-        UINT32 GetThreadCount() const { return _threadCount; }
-
         /** Get the number of threads which are not doing any work */
         uint32_t GetThreadsAvailable() const;
 
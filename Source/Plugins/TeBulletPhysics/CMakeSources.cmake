@@ -33,6 +33,8 @@ set (TE_BULLETPHYSICS_INC_NOFILTER
     "TeBulletMesh.h"
     "TeBulletHeightField.h"
     "TeBulletRayCallback.h"
+    "TeBulletTaskScheduler.h"
+    "TeBulletSceneQuery.h"
 )
 
 set (TE_BULLETPHYSICS_SRC_NOFILTER
@@ -69,6 +71,8 @@ set (TE_BULLETPHYSICS_SRC_NOFILTER
     "TeBulletDebugMat.cpp"
     "TeBulletMesh.cpp"
     "TeBulletHeightField.cpp"
+    "TeBulletTaskScheduler.cpp"
+    "TeBulletSceneQuery.cpp"
 )
 
 source_group ("" FILES ${TE_BULLETPHYSICS_SRC_NOFILTER} ${TE_BULLETPHYSICS_INC_NOFILTER})
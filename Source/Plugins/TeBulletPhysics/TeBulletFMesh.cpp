@@ -5,9 +5,36 @@
 #include "TeBulletPhysics.h"
 #include "TeBulletFMesh.h"
 #include "Math/TeAABox.h"
+#include "LinearMath/btConvexHullComputer.h"
 
 namespace te
 {
+    namespace
+    {
+        /** Identifies cooked data of a BulletFMesh, and the version of its layout. */
+        constexpr UINT32 COOKED_DATA_MAGIC = 0x4D434254;
+        constexpr UINT32 COOKED_DATA_VERSION = 1;
+
+        /**
+         * Header of cooked data. Followed by the hull points as three floats each, then by the BVH serialized in place,
+         * 16 bytes aligned from the start of the data.
+         */
+        struct CookedDataHeader
+        {
+            UINT32 Magic;
+            UINT32 Version;
+            UINT32 NumVertices;
+            UINT32 NumIndices;
+            UINT32 NumHullPoints;
+            UINT32 BvhSize;
+        };
+
+        UINT32 GetBvhOffset(UINT32 numHullPoints)
+        {
+            return ((UINT32)sizeof(CookedDataHeader) + numHullPoints * 3 * sizeof(float) + 15) & ~15u;
+        }
+    }
+
     BulletFMesh::BulletFMesh(const SPtr<MeshData>& meshData)
         : FPhysicsMesh(meshData)
     {
@@ -15,13 +42,7 @@ namespace te
     }
 
     BulletFMesh::~BulletFMesh()
-    {
-        if (_meshInfo)
-        {
-            te_deallocate(_meshInfo->Vertices);
-            te_deallocate(_meshInfo->Indices);
-        }
-    }
+    { }
 
     void BulletFMesh::Initialize()
     {
@@ -58,7 +79,7 @@ namespace te
 
             for (UINT32 i = 0; i < numVertices; i++)
             {
-                Vector3* currVertex = (Vector3*)(vertexReader + (UINT8)vertexStride * i);
+                Vector3* currVertex = (Vector3*)(vertexReader + vertexStride * i);
 
                 _meshInfo->Vertices[i * 3] = btScalar(currVertex->x);
                 _meshInfo->Vertices[i * 3 + 1] = btScalar(currVertex->y);
@@ -74,4 +95,146 @@ namespace te
             }            
         }
     }
+
+    void BulletFMesh::CreateCookedMesh()
+    {
+        if (_cookedMesh)
+            return;
+
+        _cookedMesh = te_shared_ptr_new<BulletMesh::CookedMesh>();
+        _cookedMesh->Info = _meshInfo;
+        _cookedMesh->MeshInterface = te_new<btTriangleIndexVertexArray>((int)_meshInfo->NumTriangles, _meshInfo->Indices,
+            (int)(3 * sizeof(int)), (int)_meshInfo->NumVertices, _meshInfo->Vertices, (int)(3 * sizeof(btScalar)));
+    }
+
+    SPtr<BulletMesh::CookedMesh> BulletFMesh::GetCookedTriangleMesh()
+    {
+        if (!_meshInfo || _meshInfo->NumTriangles == 0)
+            return nullptr;
+
+        CreateCookedMesh();
+
+        if (!_cookedMesh->TriangleShape)
+            _cookedMesh->TriangleShape = te_new<btBvhTriangleMeshShape>(_cookedMesh->MeshInterface, true, true);
+
+        return _cookedMesh;
+    }
+
+    SPtr<BulletMesh::CookedMesh> BulletFMesh::GetCookedConvexMesh()
+    {
+        if (!_meshInfo || _meshInfo->NumVertices == 0)
+            return nullptr;
+
+        CreateCookedMesh();
+
+        if (_cookedMesh->HullPoints.size() == 0)
+        {
+            // Only keeps the vertices of the hull, duplicated and inner vertices are dropped
+            btConvexHullComputer hull;
+            hull.compute(_meshInfo->Vertices, (int)(3 * sizeof(btScalar)), (int)_meshInfo->NumVertices, 0.0f, 0.0f);
+            _cookedMesh->HullPoints = hull.vertices;
+        }
+
+        if (!_cookedMesh->HullPolyhedron && _cookedMesh->HullPoints.size() > 0)
+        {
+            // Computing faces and edges is much more expensive than building the hull, it's only done once per mesh
+            btConvexHullShape hullShape(&_cookedMesh->HullPoints[0].getX(), _cookedMesh->HullPoints.size(),
+                (int)sizeof(btVector3));
+            if (hullShape.initializePolyhedralFeatures())
+                _cookedMesh->HullPolyhedron = te_new<btConvexPolyhedron>(*hullShape.getConvexPolyhedron());
+        }
+
+        return _cookedMesh;
+    }
+
+    Vector<UINT8> BulletFMesh::GetCookedData()
+    {
+        Vector<UINT8> data;
+
+        SPtr<BulletMesh::CookedMesh> cooked = GetCookedTriangleMesh();
+        if (!cooked || !GetCookedConvexMesh())
+            return data;
+
+        btOptimizedBvh* bvh = cooked->TriangleShape->getOptimizedBvh();
+
+        CookedDataHeader header;
+        header.Magic = COOKED_DATA_MAGIC;
+        header.Version = COOKED_DATA_VERSION;
+        header.NumVertices = _meshInfo->NumVertices;
+        header.NumIndices = _meshInfo->NumIndices;
+        header.NumHullPoints = (UINT32)cooked->HullPoints.size();
+        header.BvhSize = bvh->calculateSerializeBufferSize();
+
+        const UINT32 bvhOffset = GetBvhOffset(header.NumHullPoints);
+        data.resize(bvhOffset + header.BvhSize, 0);
+        memcpy(data.data(), &header, sizeof(header));
+
+        float* hullPoints = (float*)(data.data() + sizeof(header));
+        for (UINT32 i = 0; i < header.NumHullPoints; i++)
+        {
+            hullPoints[i * 3 + 0] = (float)cooked->HullPoints[i].getX();
+            hullPoints[i * 3 + 1] = (float)cooked->HullPoints[i].getY();
+            hullPoints[i * 3 + 2] = (float)cooked->HullPoints[i].getZ();
+        }
+
+        // Serialization needs an aligned buffer, which a vector doesn't guarantee
+        void* buffer = te_allocate_aligned16(header.BvhSize);
+        bvh->serializeInPlace(buffer, header.BvhSize, false);
+        memcpy(data.data() + bvhOffset, buffer, header.BvhSize);
+        te_free_aligned16(buffer);
+
+        return data;
+    }
+
+    bool BulletFMesh::SetCookedData(const Vector<UINT8>& data)
+    {
+        if (!_meshInfo)
+            return false;
+
+        // Colliders already reference the shapes cooked so far
+        if (_cookedMesh)
+        {
+            TE_DEBUG("Cooked data can only be restored before the PhysicsMesh is used by a collider.");
+            return false;
+        }
+
+        CookedDataHeader header;
+        if (data.size() < sizeof(header))
+            return false;
+
+        memcpy(&header, data.data(), sizeof(header));
+        if (header.Magic != COOKED_DATA_MAGIC || header.Version != COOKED_DATA_VERSION ||
+            header.NumVertices != _meshInfo->NumVertices || header.NumIndices != _meshInfo->NumIndices ||
+            header.NumHullPoints == 0 || header.BvhSize == 0)
+        {
+            TE_DEBUG("Cooked data doesn't match the PhysicsMesh, it will be cooked again.");
+            return false;
+        }
+
+        const UINT32 bvhOffset = GetBvhOffset(header.NumHullPoints);
+        if ((UINT64)data.size() < (UINT64)bvhOffset + header.BvhSize)
+            return false;
+
+        CreateCookedMesh();
+
+        const float* hullPoints = (const float*)(data.data() + sizeof(header));
+        _cookedMesh->HullPoints.resize((int)header.NumHullPoints);
+        for (UINT32 i = 0; i < header.NumHullPoints; i++)
+            _cookedMesh->HullPoints[i] = btVector3(hullPoints[i * 3 + 0], hullPoints[i * 3 + 1], hullPoints[i * 3 + 2]);
+
+        _cookedMesh->RestoredBvhBuffer = te_allocate_aligned16(header.BvhSize);
+        memcpy(_cookedMesh->RestoredBvhBuffer, data.data() + bvhOffset, header.BvhSize);
+
+        _cookedMesh->RestoredBvh = btOptimizedBvh::deSerializeInPlace(_cookedMesh->RestoredBvhBuffer, header.BvhSize, false);
+        if (!_cookedMesh->RestoredBvh)
+        {
+            _cookedMesh = nullptr;
+            return false;
+        }
+
+        _cookedMesh->TriangleShape = te_new<btBvhTriangleMeshShape>(_cookedMesh->MeshInterface, true, false);
+        _cookedMesh->TriangleShape->setOptimizedBvh(_cookedMesh->RestoredBvh);
+
+        return true;
+    }
 }
@@ -16,11 +16,27 @@ namespace te
         /** Returns mesh generated data */
         SPtr<BulletMesh::MeshInfo> GetMeshInfo() const { return _meshInfo; }
 
+        /** Returns the cooked data of the mesh with its triangle mesh shape, cooked on first use. */
+        SPtr<BulletMesh::CookedMesh> GetCookedTriangleMesh();
+
+        /** Returns the cooked data of the mesh with its convex hull points, cooked on first use. */
+        SPtr<BulletMesh::CookedMesh> GetCookedConvexMesh();
+
+        /** @copydoc FPhysicsMesh::GetCookedData */
+        Vector<UINT8> GetCookedData() override;
+
+        /** @copydoc FPhysicsMesh::SetCookedData */
+        bool SetCookedData(const Vector<UINT8>& data) override;
+
     private:
         /** Creates the internal triangle/convex mesh */
         void Initialize();
 
+        /** Creates the cooked data of the mesh, without any shape, if it doesn't exist yet. */
+        void CreateCookedMesh();
+
     private:
         SPtr<BulletMesh::MeshInfo> _meshInfo = nullptr;
+        SPtr<BulletMesh::CookedMesh> _cookedMesh = nullptr;
     };
 }
@@ -3,6 +3,26 @@
 
 namespace te
 {
+    BulletMesh::MeshInfo::~MeshInfo()
+    {
+        te_deallocate(Vertices);
+        te_deallocate(Indices);
+    }
+
+    BulletMesh::CookedMesh::~CookedMesh()
+    {
+        // A restored BVH isn't owned by the shape, it lives in its buffer
+        te_safe_delete(TriangleShape);
+        te_safe_delete(HullPolyhedron);
+
+        if (RestoredBvh)
+            RestoredBvh->~btOptimizedBvh();
+        if (RestoredBvhBuffer)
+            te_free_aligned16(RestoredBvhBuffer);
+
+        te_safe_delete(MeshInterface);
+    }
+
     BulletMesh::BulletMesh(const SPtr<MeshData>& meshData)
         : PhysicsMesh(meshData)
     { }
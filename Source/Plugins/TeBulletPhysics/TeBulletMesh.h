@@ -3,6 +3,7 @@
 #include "TeBulletPhysicsPrerequisites.h"
 #include "Physics/TeFPhysicsMesh.h"
 #include "Physics/TePhysicsMesh.h"
+#include "BulletCollision/CollisionShapes/btConvexPolyhedron.h"
 
 namespace te
 {
@@ -12,6 +13,10 @@ namespace te
     public:
         struct MeshInfo
         {
+            MeshInfo() = default;
+            MeshInfo(const MeshInfo&) = delete;
+            ~MeshInfo();
+
             btScalar* Vertices = nullptr;
             int* Indices = nullptr;
             UINT32 NumTriangles = 0;
@@ -19,6 +24,34 @@ namespace te
             UINT32 NumIndices = 0;
         };
 
+        /**
+         * Collision data cooked once from the mesh and shared by every MeshCollider using it. Colliders only hold a scaled
+         * wrapper of the triangle shape, or a copy of the hull points referencing the shared hull polyhedron.
+         */
+        struct CookedMesh
+        {
+            CookedMesh() = default;
+            CookedMesh(const CookedMesh&) = delete;
+            ~CookedMesh();
+
+            /** Triangles referenced by MeshInterface, kept alive as long as the cooked data. */
+            SPtr<MeshInfo> Info;
+            btTriangleIndexVertexArray* MeshInterface = nullptr;
+
+            /** Triangle mesh shape with a quantized BVH, nullptr until a triangle mesh collider needs it. */
+            btBvhTriangleMeshShape* TriangleShape = nullptr;
+
+            /** Vertices of the convex hull of the mesh, empty until a convex mesh collider needs them. */
+            btAlignedObjectArray<btVector3> HullPoints;
+
+            /** Faces and edges of the convex hull, used to generate contact points. nullptr until HullPoints is set. */
+            btConvexPolyhedron* HullPolyhedron = nullptr;
+
+            /** BVH restored in place from cooked data, and the 16 bytes aligned buffer it lives in. */
+            btOptimizedBvh* RestoredBvh = nullptr;
+            void* RestoredBvhBuffer = nullptr;
+        };
+
     public:
         explicit BulletMesh(const SPtr<MeshData>& meshData);
 
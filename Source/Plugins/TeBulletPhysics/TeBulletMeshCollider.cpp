@@ -3,9 +3,30 @@
 #include "TeBulletFCollider.h"
 #include "TeBulletMesh.h"
 #include "TeBulletFMesh.h"
+#include "BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h"
 
 namespace te
 {
+    namespace
+    {
+        /** Convex hull shape using the polyhedron cooked by its mesh instead of owning a copy of it. */
+        class BulletCookedHullShape : public btConvexHullShape
+        {
+        public:
+            BulletCookedHullShape(const btAlignedObjectArray<btVector3>& points, btConvexPolyhedron* polyhedron)
+                : btConvexHullShape(&points[0].getX(), points.size(), (int)sizeof(btVector3))
+            {
+                m_polyhedron = polyhedron;
+            }
+
+            ~BulletCookedHullShape()
+            {
+                // Owned by the cooked mesh
+                m_polyhedron = nullptr;
+            }
+        };
+    }
+
     BulletMeshCollider::BulletMeshCollider(BulletPhysics* physics, BulletScene* scene, const Vector3& position, const Quaternion& rotation)
         : BulletCollider(physics, scene)
     {
@@ -49,6 +70,8 @@ namespace te
             ((BulletFCollider*)_internal)->SetShape(_shape);
         }
 
+        _cookedMesh = nullptr;
+
         if (!_mesh.IsLoaded())
             return;
 
@@ -59,63 +82,43 @@ namespace te
             return;
         }
 
+        // Shapes are cooked once per PhysicsMesh, colliders only own a lightweight instance of them
         if(_collisionType == PhysicsMeshType::Convex)
         {
-            const SPtr<BulletMesh::MeshInfo> mesh = fMesh->GetMeshInfo();
+            _cookedMesh = fMesh->GetCookedConvexMesh();
 
-            if (!mesh)
+            if (!_cookedMesh)
             {
                 TE_DEBUG("PhysicsMesh does not have any Mesh Data");
                 return;
             }
-            
-            _shape = te_new<btConvexHullShape>();
-            btConvexHullShape* hullShape = (btConvexHullShape*)_shape;
-            btScalar* vertices = mesh->Vertices;
-            int* indices = mesh->Indices;
 
-            for (UINT32 i = 0; i < mesh->NumIndices; i++)
+            if (_cookedMesh->HullPoints.size() == 0)
             {
-                const btVector3 position(vertices[indices[i + 0] * 3], vertices[indices[i + 0] * 3 + 1], vertices[indices[i + 0] * 3 + 2]);
-                hullShape->addPoint(position, false);
+                TE_DEBUG("PhysicsMesh convex hull is empty, the mesh is degenerate");
+                _cookedMesh = nullptr;
+                return;
             }
 
-            _shape->setUserPointer(this);
-            hullShape->recalcLocalAabb();
-            hullShape->optimizeConvexHull();
-            hullShape->initializePolyhedralFeatures();
-
-            ((BulletFCollider*)_internal)->SetShape(_shape);
-            _shape->setLocalScaling(ToBtVector3(_internal ? _internal->GetScale() : Vector3::ONE));
+            _shape = te_new<BulletCookedHullShape>(_cookedMesh->HullPoints, _cookedMesh->HullPolyhedron);
         }
         else
         {
-            const SPtr<BulletMesh::MeshInfo> mesh = fMesh->GetMeshInfo();
+            _cookedMesh = fMesh->GetCookedTriangleMesh();
 
-            if (!mesh)
+            if (!_cookedMesh)
             {
                 TE_DEBUG("PhysicsMesh does not have any Mesh Data");
                 return;
             }
 
-            btTriangleMesh* meshInterface = new btTriangleMesh();
-            btScalar* vertices = mesh->Vertices;
-            int* indices = mesh->Indices;
-
-            for (UINT32 i = 0; i < mesh->NumIndices; i+=3)
-            {
-                const btVector3 v0(vertices[indices[i + 0] * 3], vertices[indices[i + 0] * 3 + 1], vertices[indices[i + 0] * 3 + 2]);
-                const btVector3 v1(vertices[indices[i + 1] * 3], vertices[indices[i + 1] * 3 + 1], vertices[indices[i + 1] * 3 + 2]);
-                const btVector3 v2(vertices[indices[i + 2] * 3], vertices[indices[i + 2] * 3 + 1], vertices[indices[i + 2] * 3 + 2]);
-                meshInterface->addTriangle(v0, v1, v2);
-            }
+            _shape = te_new<btScaledBvhTriangleMeshShape>(_cookedMesh->TriangleShape, btVector3(1.0f, 1.0f, 1.0f));
+        }
 
-            _shape = te_new<btBvhTriangleMeshShape>(meshInterface, true, true);
-            _shape->setUserPointer(this);
+        _shape->setUserPointer(this);
 
-            ((BulletFCollider*)_internal)->SetShape(_shape);
-            _shape->setLocalScaling(ToBtVector3(_internal ? _internal->GetScale() : Vector3::ONE));
-        }
+        ((BulletFCollider*)_internal)->SetShape(_shape);
+        _shape->setLocalScaling(ToBtVector3(_internal ? _internal->GetScale() : Vector3::ONE));
     }
 
     void BulletMeshCollider::OnMeshChanged()
@@ -4,6 +4,7 @@
 #include "Physics/TeMeshCollider.h"
 #include "TeBulletCollider.h"
 #include "TeBulletPhysics.h"
+#include "TeBulletMesh.h"
 
 namespace te
 {
@@ -32,5 +33,8 @@ namespace te
 
     private:
         btCollisionShape* _shape = nullptr;
+
+        /** Data cooked by the mesh, _shape references it. */
+        SPtr<BulletMesh::CookedMesh> _cookedMesh;
     };
 }
@@ -22,6 +22,9 @@
 #include "TeBulletMesh.h"
 #include "TeBulletHeightField.h"
 #include "TeBulletRayCallback.h"
+#include "TeBulletTaskScheduler.h"
+#include "TeBulletSceneQuery.h"
+#include "Threading/TeTaskScheduler.h"
 #include "Utility/TeTime.h"
 #include "RenderAPI/TeRenderAPI.h"
 #include "RenderAPI/TeRenderTexture.h"
@@ -39,22 +42,16 @@ namespace te
         , _paused(false)
         , _debug(true)
     {
-        _broadphase = te_new<btDbvtBroadphase>();
-        _constraintSolver = te_new<btSequentialImpulseConstraintSolver>();
-
-        if (_initDesc.SoftBody)
-        {
-            _collisionConfiguration = te_new<btSoftBodyRigidBodyCollisionConfiguration>();
-            _collisionDispatcher = te_new<btCollisionDispatcher>(_collisionConfiguration);
-
-            btGImpactCollisionAlgorithm::registerAlgorithm(_collisionDispatcher);
-        }
-        else
+        if (_initDesc.MultiThreaded)
         {
-            _collisionConfiguration = te_new<btDefaultCollisionConfiguration>();
-            _collisionDispatcher = te_new<btCollisionDispatcher>(_collisionConfiguration);
-
-            btGImpactCollisionAlgorithm::registerAlgorithm(_collisionDispatcher);
+#if BT_THREADSAFE
+            // Must be set before any of the multithreaded Bullet objects are created
+            _taskScheduler = te_new<BulletTaskScheduler>();
+            btSetTaskScheduler(_taskScheduler);
+#else
+            // Bullet would ignore the task scheduler, and isn't safe to step from several threads at once
+            TE_DEBUG("Bullet is built without BT_THREADSAFE, physics scenes are simulated on a single thread.");
+#endif
         }
     }
 
@@ -62,10 +59,11 @@ namespace te
     {
         assert(_scenes.empty() && "All scenes must be freed before physics system shutdown");
 
-        te_delete(_constraintSolver);
-        te_delete(_collisionDispatcher);
-        te_delete(_collisionConfiguration);
-        te_delete(_broadphase);
+        if (_taskScheduler)
+        {
+            btSetTaskScheduler(btGetSequentialTaskScheduler());
+            te_delete(_taskScheduler);
+        }
     }
 
     void BulletPhysics::SetPaused(bool paused)
@@ -131,37 +129,123 @@ namespace te
         if (IsPaused() || !isRunning)
             return;
 
+        float deltaTimeSec = gTime().GetFrameDelta();
+
+        if (_initDesc.FixedTimeStep)
+        {
+            const float fixedTimeStep = 1.0f / _initDesc.FixedStepRate;
+
+            _stepAccumulator += deltaTimeSec;
+            UINT32 numSteps = static_cast<UINT32>(_stepAccumulator / fixedTimeStep);
+            if (numSteps > _initDesc.MaxStepsPerFrame)
+            {
+                // Drop what can't be caught up with, keeping the fraction of a step so steps stay evenly spaced
+                numSteps = _initDesc.MaxStepsPerFrame;
+                _stepAccumulator = fixedTimeStep * numSteps + std::fmod(_stepAccumulator, fixedTimeStep);
+            }
+
+            // Each step is a single Bullet step of a constant length, so the simulation doesn't depend on the frame
+            // rate. Collisions are reported after every step, none of them is merged or delayed.
+            for (UINT32 i = 0; i < numSteps; i++)
+            {
+                StepScenes(fixedTimeStep, 0, fixedTimeStep);
+                ReportScenes();
+
+                _stepAccumulator -= fixedTimeStep;
+            }
+
+            const float alpha = _initDesc.Interpolate ? Math::Clamp01(_stepAccumulator / fixedTimeStep) : 1.0f;
+            SyncScenes(alpha);
+
+            return;
+        }
+
+        // This equation must be met: timeStep < maxSubSteps * fixedTimeStep
+        float internalTimeStep = 1.0f / _internalFps;
+        INT32 maxSubsteps = static_cast<INT32>(deltaTimeSec * _internalFps) + 1;
+        if (_maxSubSteps < 0)
+        {
+            internalTimeStep = deltaTimeSec;
+            maxSubsteps = 1;
+        }
+        else if (_maxSubSteps > 0)
+        {
+            maxSubsteps = std::min<INT32>(maxSubsteps, _maxSubSteps);
+        }
+
+        StepScenes(deltaTimeSec, maxSubsteps, internalTimeStep);
+        SyncScenes(1.0f);
+
+        _deltaTimeSec += deltaTimeSec;
+        if (_deltaTimeSec > 1.0f / _internalFps)
+        {
+            ReportScenes();
+            _deltaTimeSec = 0.0f;
+        }
+    }
+
+    void BulletPhysics::StepScenes(float deltaTimeSec, INT32 maxSubsteps, float internalTimeStep)
+    {
+        Vector<SPtr<Task>> stepTasks;
+        BulletScene* localScene = nullptr;
+
         for (auto& scene : _scenes)
         {
             if (!scene->_world)
                 continue;
 
-            // This equation must be met: timeStep < maxSubSteps * fixedTimeStep
-            float deltaTimeSec = gTime().GetFrameDelta();
-            float internalTimeStep = 1.0f / _internalFps;
-            INT32 maxSubsteps = static_cast<INT32>(deltaTimeSec * _internalFps) + 1;
-            if (_maxSubSteps < 0)
+            if (!_taskScheduler)
             {
-                internalTimeStep = deltaTimeSec;
-                maxSubsteps = 1;
+                scene->Step(deltaTimeSec, maxSubsteps, internalTimeStep);
+                continue;
             }
-            else if (_maxSubSteps > 0)
+
+            if (!localScene)
             {
-                maxSubsteps = std::min<INT32>(maxSubsteps, _maxSubSteps);
+                localScene = scene;
+                continue;
             }
 
-            // Step the physics world.
-            _updateInProgress = true;
-            scene->_world->stepSimulation(deltaTimeSec, maxSubsteps, internalTimeStep);
-            _updateInProgress = false;
-
-            _deltaTimeSec += deltaTimeSec;
-            if (_deltaTimeSec > 1.0f / _internalFps)
+            SPtr<Task> task = Task::Create("PhysicsSceneStep", [scene, deltaTimeSec, maxSubsteps, internalTimeStep]()
             {
-                scene->TriggerCollisions();
-                scene->ReportCollisions();
-                _deltaTimeSec = 0.0f;
-            }
+                scene->Step(deltaTimeSec, maxSubsteps, internalTimeStep);
+            });
+
+            gTaskScheduler().AddTask(task);
+            stepTasks.push_back(task);
+        }
+
+        if (localScene)
+            localScene->Step(deltaTimeSec, maxSubsteps, internalTimeStep);
+
+        for (auto& task : stepTasks)
+            gTaskScheduler().Wait(task);
+    }
+
+    void BulletPhysics::SyncScenes(float alpha)
+    {
+        // Scene objects are not thread safe, transforms are applied once all scenes are done. Moving them must not
+        // move the bodies back.
+        _updateInProgress = true;
+
+        for (auto& scene : _scenes)
+        {
+            if (scene->_world)
+                scene->SyncTransforms(alpha);
+        }
+
+        _updateInProgress = false;
+    }
+
+    void BulletPhysics::ReportScenes()
+    {
+        for (auto& scene : _scenes)
+        {
+            if (!scene->_world)
+                continue;
+
+            scene->TriggerCollisions();
+            scene->ReportCollisions();
         }
     }
 
@@ -249,17 +333,26 @@ namespace te
         , _initDesc(desc)
         , _physics(physics)
     {
+        _broadphase = te_new<btDbvtBroadphase>();
+
         if (_initDesc.SoftBody)
         {
-            _world = te_new<btSoftRigidDynamicsWorld>(_physics->_collisionDispatcher, _physics->_broadphase,
-                _physics->_constraintSolver, _physics->_collisionConfiguration);
+            // Soft bodies are not supported by the multithreaded pipeline
+            _collisionConfiguration = te_new<btSoftBodyRigidBodyCollisionConfiguration>();
+            _collisionDispatcher = te_new<btCollisionDispatcher>(_collisionConfiguration);
+            _constraintSolver = te_new<btSequentialImpulseConstraintSolver>();
+
+            btGImpactCollisionAlgorithm::registerAlgorithm(_collisionDispatcher);
+
+            _world = te_new<btSoftRigidDynamicsWorld>(_collisionDispatcher, _broadphase,
+                _constraintSolver, _collisionConfiguration);
 
             // Setup
             _worldInfo = te_new<btSoftBodyWorldInfo>();
             _worldInfo->m_sparsesdf.Initialize();
 
-            _worldInfo->m_dispatcher = _physics->_collisionDispatcher;
-            _worldInfo->m_broadphase = _physics->_broadphase;
+            _worldInfo->m_dispatcher = _collisionDispatcher;
+            _worldInfo->m_broadphase = _broadphase;
             _worldInfo->air_density = (btScalar)_initDesc.AirDensity;
             _worldInfo->water_density = (btScalar)_initDesc.WaterDensity;
             _worldInfo->water_offset = (btScalar)_initDesc.WaterOffset;
@@ -268,10 +361,29 @@ namespace te
             _worldInfo->m_maxDisplacement = 1000.0f;
             _worldInfo->m_sparsesdf.Initialize();
         }
+        else if (_physics->_taskScheduler)
+        {
+            _collisionConfiguration = te_new<btDefaultCollisionConfiguration>();
+            _collisionDispatcher = te_new<btCollisionDispatcherMt>(_collisionConfiguration);
+            _constraintSolver = te_new<btSequentialImpulseConstraintSolverMt>();
+            _constraintSolverPool = te_new<btConstraintSolverPoolMt>(_physics->_taskScheduler->getNumThreads());
+
+            btGImpactCollisionAlgorithm::registerAlgorithm(_collisionDispatcher);
+
+            // Islands are solved in parallel by the pool, large islands (piles of bodies) by the multithreaded solver
+            _world = te_new<btDiscreteDynamicsWorldMt>(_collisionDispatcher, _broadphase, _constraintSolverPool,
+                _constraintSolver, _collisionConfiguration);
+        }
         else
         {
-            _world = te_new<btDiscreteDynamicsWorld>(_physics->_collisionDispatcher, _physics->_broadphase,
-                _physics->_constraintSolver, _physics->_collisionConfiguration);
+            _collisionConfiguration = te_new<btDefaultCollisionConfiguration>();
+            _collisionDispatcher = te_new<btCollisionDispatcher>(_collisionConfiguration);
+            _constraintSolver = te_new<btSequentialImpulseConstraintSolver>();
+
+            btGImpactCollisionAlgorithm::registerAlgorithm(_collisionDispatcher);
+
+            _world = te_new<btDiscreteDynamicsWorld>(_collisionDispatcher, _broadphase,
+                _constraintSolver, _collisionConfiguration);
         }
          
         // Setup
@@ -288,9 +400,7 @@ namespace te
         _world->setDebugDrawer(static_cast<BulletDebug*>(_debug));
 #endif
 
-        _beginContactEvents = te_new<ContactEventsMap>();
-        _stayContactEvents = te_new<ContactEventsMap>();
-        _endContactEvents = te_new<ContactEventsMap>();
+        _world->setInternalTickCallback(&BulletScene::OnInternalTick, this);
     }
 
     BulletScene::~BulletScene()
@@ -299,127 +409,185 @@ namespace te
         te_safe_delete(_worldInfo);
         te_safe_delete((BulletDebug*)_debug);
 
-        for (auto& evt : *_beginContactEvents)
-            te_pool_delete(evt.second);
-
-        for (auto& evt : *_stayContactEvents)
-            te_pool_delete(evt.second);
-
-        for (auto& evt : *_endContactEvents)
-            te_pool_delete(evt.second);
-
-        _beginContactEvents->clear();
-        _stayContactEvents->clear();
-        _endContactEvents->clear();
-
-        te_delete(_beginContactEvents);
-        te_delete(_stayContactEvents);
-        te_delete(_endContactEvents);
+        te_safe_delete(_constraintSolverPool);
+        te_safe_delete(_constraintSolver);
+        te_safe_delete(_collisionDispatcher);
+        te_safe_delete(_collisionConfiguration);
+        te_safe_delete(_broadphase);
 
         gBulletPhysics().NotifySceneDestroyed(this);
     }
 
-    void BulletScene::TriggerCollisions()
+    void BulletScene::Step(float deltaTimeSec, INT32 maxSubsteps, float internalTimeStep)
     {
-        Body* bodyA = nullptr;
-        Body* bodyB = nullptr;
-        bp::ContactEvent* currContactEvent = nullptr;
-
-        if (_world)
-            _world->performDiscreteCollisionDetection();
+        _world->stepSimulation(deltaTimeSec, maxSubsteps, internalTimeStep);
+    }
 
-        for (auto& softBody : _softBodies)
+    void BulletScene::SyncTransforms(float alpha)
+    {
+        for (auto& body : _rigidBodies)
         {
-            int numRContacts = static_cast<btSoftBody*>(softBody)->m_rcontacts.size();
-            int numSContacts = static_cast<btSoftBody*>(softBody)->m_scontacts.size();
-            int numNodeRigidContacts = static_cast<btSoftBody*>(softBody)->m_nodeRigidContacts.size();
-            int numFaceNodeContacts = static_cast<btSoftBody*>(softBody)->m_faceNodeContacts.size();
-            int numFaceRigidContacts = static_cast<btSoftBody*>(softBody)->m_faceRigidContacts.size();
-
-            if (numRContacts > 0 || numSContacts > 0 || numNodeRigidContacts > 0 || numFaceNodeContacts > 0 || numFaceRigidContacts > 0)
-            {
-                TE_DEBUG(ToString(numRContacts) + " / " +
-                    ToString(numSContacts) + " / " +
-                    ToString(numNodeRigidContacts) + " / " +
-                    ToString(numFaceNodeContacts) + " / " +
-                    ToString(numFaceRigidContacts)
-                );
-            }
+            BulletRigidBody* rigidBody = static_cast<BulletRigidBody*>(body->getUserPointer());
+            if (rigidBody)
+                rigidBody->SyncTransform(alpha);
         }
+    }
+
+    void BulletScene::OnInternalTick(btDynamicsWorld* world, btScalar timeStep)
+    {
+        BulletScene* scene = static_cast<BulletScene*>(world->getWorldUserInfo());
+        scene->GatherContacts();
+    }
 
-        int numManifolds = _world->getDispatcher()->getNumManifolds();
+    void BulletScene::GatherContacts()
+    {
+        _simulationStep++;
+
+        btDispatcher* dispatcher = _world->getDispatcher();
+        int numManifolds = dispatcher->getNumManifolds();
         for (int i = 0; i < numManifolds; i++)
         {
-            btPersistentManifold* contactManifold = _world->getDispatcher()->getManifoldByIndexInternal(i);
-            const btCollisionObject* obA = contactManifold->getBody0();
-            const btCollisionObject* obB = contactManifold->getBody1();
-            bodyA = nullptr;
-            bodyB = nullptr;
-
-            auto stayContactEvent = _stayContactEvents->find(std::make_pair(obA, obB));
-            if (stayContactEvent != _stayContactEvents->end())
-            {
-                stayContactEvent->second->Type = bp::ContactEventType::ContactStay;
-                stayContactEvent->second->Points.clear();
+            btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
 
-                currContactEvent = stayContactEvent->second;
-            }
-            else
-            {
-                bodyA = (obA->getUserPointer()) ? static_cast<Body*>(obA->getUserPointer()) : nullptr;
-                bodyB = (obB->getUserPointer()) ? static_cast<Body*>(obB->getUserPointer()) : nullptr;
+            int numContacts = manifold->getNumContacts();
+            if (numContacts == 0)
+                continue;
 
-                if (!bodyA || !bodyB)
-                    continue;
+            const btCollisionObject* obA = manifold->getBody0();
+            const btCollisionObject* obB = manifold->getBody1();
 
-                if (bodyA->GetCollisionReportMode() == CollisionReportMode::None
-                    && bodyB->GetCollisionReportMode() == CollisionReportMode::None)
-                    continue;
+            Body* bodyA = static_cast<Body*>(obA->getUserPointer());
+            Body* bodyB = static_cast<Body*>(obB->getUserPointer());
 
-                bp::ContactEvent* beginEvent = te_pool_new<bp::ContactEvent>();
-                beginEvent->Type = bp::ContactEventType::ContactBegin;
-                beginEvent->BodyA = bodyA;
-                beginEvent->BodyB = bodyA;
+            if (!bodyA || !bodyB)
+                continue;
 
-                _beginContactEvents->insert(Pair<ContactEventKey, bp::ContactEvent*>(
-                    std::make_pair(obA, obB), beginEvent));
+            if (bodyA->GetCollisionReportMode() == CollisionReportMode::None
+                && bodyB->GetCollisionReportMode() == CollisionReportMode::None)
+                continue;
 
-                currContactEvent = beginEvent;
-            }
+            ContactPair& pair = _contactPairs[FindOrCreateContactPair(manifold, bodyA, bodyB)];
+            pair.LastStep = _simulationStep;
+            pair.Points.clear();
 
-            int numContacts = contactManifold->getNumContacts();
             for (int j = 0; j < numContacts; j++)
             {
-                btManifoldPoint& pt = contactManifold->getContactPoint(j);
-
-                if (currContactEvent)
-                {
-                    ContactPoint point;
+                btManifoldPoint& pt = manifold->getContactPoint(j);
 
-                    point.PositionA = ToVector3(pt.getPositionWorldOnA());
-                    point.PositionB = ToVector3(pt.getPositionWorldOnB());
-                    point.Normal = ToVector3(pt.m_normalWorldOnB);
-                    point.Impulse = (float)pt.getAppliedImpulse();
-                    point.Distance = (float)pt.getDistance();
+                ContactPoint point;
+                point.PositionA = ToVector3(pt.getPositionWorldOnA());
+                point.PositionB = ToVector3(pt.getPositionWorldOnB());
+                point.Normal = ToVector3(pt.m_normalWorldOnB);
+                point.Impulse = (float)pt.getAppliedImpulse();
+                point.Distance = (float)pt.getDistance();
 
-                    currContactEvent->Points.push_back(point);
-                }
+                pair.Points.push_back(point);
             }
         }
+    }
+
+    UINT32 BulletScene::FindOrCreateContactPair(btPersistentManifold* manifold, Body* bodyA, Body* bodyB)
+    {
+        // Bullet doesn't use the companion ids of manifolds, and resets them when a manifold is created, so they're used
+        // to store the index of the pair (plus one, so zero means no pair)
+        UINT32 idx = (UINT32)(manifold->m_companionIdA - 1);
+        if (idx < (UINT32)_contactPairs.size() && _contactPairs[idx].Manifold == manifold)
+            return idx;
+
+        if (!_freeContactPairs.empty())
+        {
+            idx = _freeContactPairs.back();
+            _freeContactPairs.pop_back();
+        }
+        else
+        {
+            idx = (UINT32)_contactPairs.size();
+            _contactPairs.push_back(ContactPair());
+        }
+
+        ContactPair& pair = _contactPairs[idx];
+        pair.Manifold = manifold;
+        pair.ObjectA = manifold->getBody0();
+        pair.ObjectB = manifold->getBody1();
+        pair.BodyA = bodyA;
+        pair.BodyB = bodyB;
+        pair.Reported = false;
+
+        manifold->m_companionIdA = (int)idx + 1;
+        return idx;
+    }
+
+    void BulletScene::FreeContactPair(UINT32 idx)
+    {
+        ContactPair& pair = _contactPairs[idx];
+        pair.Manifold = nullptr;
+        pair.ObjectA = nullptr;
+        pair.ObjectB = nullptr;
+        pair.BodyA = nullptr;
+        pair.BodyB = nullptr;
+        pair.Points.clear();
+
+        _freeContactPairs.push_back(idx);
+    }
+
+    void BulletScene::RemoveContactPairs(const btCollisionObject* object)
+    {
+        for (UINT32 i = 0; i < (UINT32)_contactPairs.size(); i++)
+        {
+            ContactPair& pair = _contactPairs[i];
+            if (pair.Manifold && (pair.ObjectA == object || pair.ObjectB == object))
+                FreeContactPair(i);
+        }
 
-        for (auto it = _stayContactEvents->begin(); it != _stayContactEvents->end(); )
+        // Bodies can be removed from a collision callback, while events are still pending
+        Body* body = static_cast<Body*>(object->getUserPointer());
+        for (auto& evt : _contactEvents)
         {
-            if (it->second->Type == bp::ContactEventType::ContactBegin)
+            if (evt.BodyA == body || evt.BodyB == body)
             {
-                _endContactEvents->insert(Pair<ContactEventKey, bp::ContactEvent*>(
-                    std::make_pair(it->first.first, it->first.second), it->second));
+                evt.BodyA = nullptr;
+                evt.BodyB = nullptr;
+            }
+        }
+    }
+
+    void BulletScene::TriggerCollisions()
+    {
+        // Contacts have already been gathered during the simulation steps, only events need to be generated
+        auto AddEvent = [&](const ContactPair& pair, bp::ContactEventType type)
+        {
+            _contactEvents.push_back(bp::ContactEvent());
 
-                it->second->Type = bp::ContactEventType::ContactEnd;
-                it = _stayContactEvents->erase(it);
+            bp::ContactEvent& evt = _contactEvents.back();
+            evt.BodyA = pair.BodyA;
+            evt.BodyB = pair.BodyB;
+            evt.Type = type;
+            evt.Points = pair.Points;
+        };
+
+        for (UINT32 i = 0; i < (UINT32)_contactPairs.size(); i++)
+        {
+            ContactPair& pair = _contactPairs[i];
+            if (!pair.Manifold)
                 continue;
+
+            bool isTouching = pair.LastStep == _simulationStep;
+
+            if (!pair.Reported)
+            {
+                AddEvent(pair, bp::ContactEventType::ContactBegin);
+                pair.Reported = true;
+            }
+            else if (isTouching)
+            {
+                AddEvent(pair, bp::ContactEventType::ContactStay);
             }
 
-            it++;
+            if (!isTouching)
+            {
+                AddEvent(pair, bp::ContactEventType::ContactEnd);
+                FreeContactPair(i);
+            }
         }
     }
 
@@ -427,24 +595,26 @@ namespace te
     {
         CollisionDataRaw data;
 
-        auto NotifyContact = [&](Body* body, bp::ContactEvent* evt)
+        auto NotifyContact = [&](Body* body, Body* other, const bp::ContactEvent& evt)
         {
             CollisionReportMode mode = body->GetCollisionReportMode();
             if (mode == CollisionReportMode::None)
                 return;
 
-            data.Bodies[0] = evt->BodyA;
-            data.Bodies[1] = evt->BodyB;
-            data.ContactPoints = evt->Points;
+            if (evt.Type == bp::ContactEventType::ContactStay && mode != CollisionReportMode::ReportPersistent)
+                return;
+
+            data.Bodies[0] = body;
+            data.Bodies[1] = other;
+            data.ContactPoints = evt.Points;
 
-            switch (evt->Type)
+            switch (evt.Type)
             {
             case bp::ContactEventType::ContactBegin:
                 body->OnCollisionBegin(data);
                 break;
             case bp::ContactEventType::ContactStay:
-                if(mode == CollisionReportMode::ReportPersistent)
-                    body->OnCollisionStay(data);
+                body->OnCollisionStay(data);
                 break;
             case bp::ContactEventType::ContactEnd:
                 body->OnCollisionEnd(data);
@@ -452,27 +622,19 @@ namespace te
             }
         };
 
-        for (auto& evt : *_stayContactEvents)
+        for (UINT32 i = 0; i < (UINT32)_contactEvents.size(); i++)
         {
-            NotifyContact(evt.second->BodyA, evt.second);
-            evt.second->Type = bp::ContactEventType::ContactBegin;
-        }
+            const bp::ContactEvent& evt = _contactEvents[i];
 
-        for (auto& evt : *_beginContactEvents)
-        {
-            NotifyContact(evt.second->BodyA, evt.second);
-            _stayContactEvents->insert(Pair<ContactEventKey, bp::ContactEvent*>(
-                std::make_pair(evt.first.first, evt.first.second), evt.second));
-        }
+            if (evt.BodyA && evt.BodyB)
+                NotifyContact(evt.BodyA, evt.BodyB, evt);
 
-        for (auto& evt : *_endContactEvents)
-        {
-            NotifyContact(evt.second->BodyA, evt.second);
-            te_pool_delete(evt.second);
+            // The first callback might have removed one of the bodies
+            if (evt.BodyA && evt.BodyB)
+                NotifyContact(evt.BodyB, evt.BodyA, evt);
         }
 
-        _endContactEvents->clear();
-        _beginContactEvents->clear();
+        _contactEvents.clear();
     }
 
     SPtr<RigidBody> BulletScene::CreateRigidBody(const HSceneObject& linkedSO)
@@ -638,20 +800,7 @@ namespace te
         if (!_world)
             return;
 
-        for (auto it = _stayContactEvents->begin(); it != _stayContactEvents->end();)
-        {
-            const btCollisionObject* objA = it->first.first;
-            const btCollisionObject* objB = it->first.second;
-
-            if (objA == body || objB == body)
-            {
-                te_pool_delete(it->second);
-                it = _stayContactEvents->erase(it);
-                continue;
-            }
-
-            it++;
-        }
+        RemoveContactPairs(body);
 
         auto it = std::find(_rigidBodies.begin(), _rigidBodies.end(), body);
         if (it != _rigidBodies.end())
@@ -674,20 +823,7 @@ namespace te
         if (!_world || !_initDesc.SoftBody)
             return;
 
-        for (auto it = _stayContactEvents->begin(); it != _stayContactEvents->end();)
-        {
-            const btCollisionObject* objA = it->first.first;
-            const btCollisionObject* objB = it->first.second;
-
-            if (objA == body || objB == body)
-            {
-                te_pool_delete(it->second);
-                it = _stayContactEvents->erase(it);
-                continue;
-            }
-
-            it++;
-        }
+        RemoveContactPairs(body);
 
         auto it = std::find(_softBodies.begin(), _softBodies.end(), body);
         if (it != _softBodies.end())
@@ -815,6 +951,22 @@ namespace te
         return hits.size() > 0;
     }
 
+    UINT32 BulletScene::RayCastBatch(const PhysicsRayQuery* queries, UINT32 count, PhysicsBatchHit* hits) const
+    {
+        return BulletSceneQuery::RayCastBatch(_world, queries, count, hits);
+    }
+
+    UINT32 BulletScene::SweepBatch(const PhysicsSweepQuery* queries, UINT32 count, PhysicsBatchHit* hits) const
+    {
+        return BulletSceneQuery::SweepBatch(_world, queries, count, hits);
+    }
+
+    UINT32 BulletScene::OverlapBatch(const PhysicsOverlapQuery* queries, UINT32 count, PhysicsOverlapHit* hits,
+        UINT32 maxHitsPerQuery, UINT32* numHits) const
+    {
+        return BulletSceneQuery::OverlapBatch(_world, queries, count, hits, maxHitsPerQuery, numHits);
+    }
+
     btSoftBody* BulletScene::CreateBtSoftBodyFromMesh(const SPtr<BulletMesh::MeshInfo>& mesh) const
     {
         if (!_worldInfo)
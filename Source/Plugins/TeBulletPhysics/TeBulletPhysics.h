@@ -3,7 +3,6 @@
 #include "TeBulletPhysicsPrerequisites.h"
 #include "Physics/TePhysics.h"
 #include "Physics/TePhysicsCommon.h"
-#include "Utility/TePoolAllocator.h"
 #include "TeBulletMesh.h"
 
 namespace te 
@@ -28,7 +27,6 @@ namespace te
             Body* BodyA = nullptr; /** First body. */
             Body* BodyB = nullptr; /** Second body. */
             ContactEventType Type = ContactEventType::ContactBegin; /** Exact type of the event. */
-            // Note: Not too happy this is heap allocated, use static allocator?
             Vector<ContactPoint> Points; /** Information about all contact points between the colliders. */
         };
 
@@ -92,13 +90,23 @@ namespace te
     private:
         friend class BulletScene;
 
+        /**
+         * Steps the worlds of all the scenes. Scenes are independent, so when using the multithreaded pipeline they are
+         * stepped concurrently: the first one on this thread, the others on worker threads. The multithreaded pipeline
+         * is only used if Bullet is built with BT_THREADSAFE (BULLET_THREADSAFE CMake option).
+         */
+        void StepScenes(float deltaTimeSec, INT32 maxSubsteps, float internalTimeStep);
+
+        /** Applies the simulation results of all the scenes to the scene objects. */
+        void SyncScenes(float alpha);
+
+        /** Triggers and reports the collision events of all the scenes. */
+        void ReportScenes();
+
         bool _paused; // is simulation paused
         bool _debug; // is debug enabled
 
-        btBroadphaseInterface* _broadphase = nullptr;
-        btCollisionDispatcher* _collisionDispatcher = nullptr;
-        btSequentialImpulseConstraintSolver* _constraintSolver = nullptr;
-        btDefaultCollisionConfiguration* _collisionConfiguration = nullptr;
+        BulletTaskScheduler* _taskScheduler = nullptr; // Only created if the multithreaded pipeline is enabled
 
         Vector<BulletScene*> _scenes;
 
@@ -106,23 +114,12 @@ namespace te
         UINT32 _maxSolveIterations = 256;
         float _internalFps = 60.0f;
         float _deltaTimeSec = 1.0f;
+        float _stepAccumulator = 0.0f; // Frame time not simulated yet when using a fixed time step
 
         UINT32 _debugMode = btIDebugDraw::DBG_DrawWireframe | btIDebugDraw::DBG_DrawContactPoints | 
             btIDebugDraw::DBG_DrawConstraints | btIDebugDraw::DBG_DrawConstraintLimits /* | btIDebugDraw::DBG_DrawAabb */;
     };
 
-    typedef Pair<const btCollisionObject*, const btCollisionObject*> ContactEventKey;
-
-    struct ContactEventKeyHash
-    {
-        template <class T1, class T2>
-        std::size_t operator() (const Pair<T1, T2>& pair) const {
-            return std::hash<T1>()(pair.first) ^ std::hash<T2>()(pair.second);
-        }
-    };
-
-    typedef UnorderedMap<ContactEventKey, BulletPhysics::ContactEvent*, ContactEventKeyHash> ContactEventsMap;
-
     /** Contains information about a single Bullet scene. */
     class BulletScene : public PhysicsScene
     {
@@ -136,6 +133,9 @@ namespace te
         /** PhysicsScene::TriggerCollisions */
         void ReportCollisions() override;
 
+        /** Returns the number of internal simulation steps the scene went through. */
+        UINT64 GetSimulationStep() const { return _simulationStep; }
+
         /** @copydoc PhysicsScene::CreateRigidBody */
         SPtr<RigidBody> CreateRigidBody(const HSceneObject& linkedSO) override;
 
@@ -222,6 +222,16 @@ namespace te
         bool RayCast(const Vector3& origin, const Vector3& unitDir, Vector<PhysicsQueryHit>& hits,
             float maxDist = FLT_MAX) const override;
 
+        /** @copydoc PhysicsScene::RayCastBatch */
+        UINT32 RayCastBatch(const PhysicsRayQuery* queries, UINT32 count, PhysicsBatchHit* hits) const override;
+
+        /** @copydoc PhysicsScene::SweepBatch */
+        UINT32 SweepBatch(const PhysicsSweepQuery* queries, UINT32 count, PhysicsBatchHit* hits) const override;
+
+        /** @copydoc PhysicsScene::OverlapBatch */
+        UINT32 OverlapBatch(const PhysicsOverlapQuery* queries, UINT32 count, PhysicsOverlapHit* hits,
+            UINT32 maxHitsPerQuery, UINT32* numHits) const override;
+
         /** Create a btSoftBody from a PhysicsMesh */
         btSoftBody* CreateBtSoftBodyFromMesh(const SPtr<BulletMesh::MeshInfo>& mesh) const;
 
@@ -238,21 +248,68 @@ namespace te
     private:
         friend class BulletPhysics;
 
+        /**
+         * State of a pair of objects whose contact manifold had contact points during a simulation step. Pairs are
+         * stored in a flat array, and the index of a pair is stored in its manifold so it can be found again without
+         * any lookup.
+         */
+        struct ContactPair
+        {
+            const btPersistentManifold* Manifold = nullptr; /** Manifold the pair was created for. Null if the slot is free. */
+            const btCollisionObject* ObjectA = nullptr;
+            const btCollisionObject* ObjectB = nullptr;
+            Body* BodyA = nullptr;
+            Body* BodyB = nullptr;
+            UINT64 LastStep = 0; /** Last simulation step the objects were touching on. */
+            bool Reported = false; /** True once the begin event has been emitted. */
+            Vector<ContactPoint> Points; /** Contact points found during the last step the objects were touching on. */
+        };
+
+        /** Advances the simulation of the scene. Can be called from any thread. */
+        void Step(float deltaTimeSec, INT32 maxSubsteps, float internalTimeStep);
+
+        /**
+         * Applies the transforms computed during the last steps to the scene objects of the bodies that moved.
+         *
+         * @param[in]	alpha	Position between the two last steps the bodies moved by the last step are placed at.
+         */
+        void SyncTransforms(float alpha);
+
+        /** Called by Bullet after each internal simulation step. */
+        static void OnInternalTick(btDynamicsWorld* world, btScalar timeStep);
+
+        /** Records contact points of all the manifolds that have some, for pairs that need to report them. */
+        void GatherContacts();
+
+        /** Returns the index of the contact pair for the provided manifold, creating it if needed. */
+        UINT32 FindOrCreateContactPair(btPersistentManifold* manifold, Body* bodyA, Body* bodyB);
+
+        /** Releases the contact pair slot at the provided index. */
+        void FreeContactPair(UINT32 idx);
+
+        /** Releases every contact pair referencing the provided object, without reporting them. */
+        void RemoveContactPairs(const btCollisionObject* object);
+
         PHYSICS_INIT_DESC _initDesc;
         BulletPhysics* _physics = nullptr;
 
+        btBroadphaseInterface* _broadphase = nullptr;
+        btCollisionDispatcher* _collisionDispatcher = nullptr;
+        btConstraintSolver* _constraintSolver = nullptr;
+        btConstraintSolverPoolMt* _constraintSolverPool = nullptr;
+        btDefaultCollisionConfiguration* _collisionConfiguration = nullptr;
+
         btDiscreteDynamicsWorld* _world = nullptr;
         btSoftBodyWorldInfo* _worldInfo = nullptr;
 
-        ContactEventsMap* _beginContactEvents = nullptr;
-        ContactEventsMap* _stayContactEvents = nullptr;
-        ContactEventsMap* _endContactEvents = nullptr;
+        Vector<ContactPair> _contactPairs;
+        Vector<UINT32> _freeContactPairs;
+        Vector<BulletPhysics::ContactEvent> _contactEvents;
+        UINT64 _simulationStep = 0;
 
         Vector<btCollisionObject*> _softBodies;
         Vector<btCollisionObject*> _rigidBodies;
     };
 
     BulletPhysics& gBulletPhysics();
-
-    IMPLEMENT_GLOBAL_POOL(BulletPhysics::ContactEvent, 64)
 }
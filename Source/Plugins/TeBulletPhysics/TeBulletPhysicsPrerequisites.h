@@ -8,6 +8,25 @@
 
 #define BT_USE_DOUBLE_PRECISION
 
+// DLL export, for the classes used outside of the plugin (e.g. by the benchmarks)
+#if TE_PLATFORM == TE_PLATFORM_WIN32 // Windows
+#  if TE_COMPILER == TE_COMPILER_MSVC
+#    if defined(TE_BULLET_PHYSICS_EXPORTS)
+#      define TE_BULLET_PHYSICS_EXPORT __declspec(dllexport)
+#    else
+#      define TE_BULLET_PHYSICS_EXPORT __declspec(dllimport)
+#    endif
+#  else
+#    if defined(TE_BULLET_PHYSICS_EXPORTS)
+#      define TE_BULLET_PHYSICS_EXPORT __attribute__ ((dllexport))
+#    else
+#      define TE_BULLET_PHYSICS_EXPORT __attribute__ ((dllimport))
+#    endif
+#  endif
+#else // Linux/Mac settings
+#  define TE_BULLET_PHYSICS_EXPORT __attribute__ ((visibility ("default")))
+#endif
+
 #if TE_COMPILER == TE_COMPILER_MSVC
 #   pragma warning(push, 0)
 #endif
@@ -20,6 +39,9 @@
 #include "BulletCollision/CollisionDispatch/btManifoldResult.h"
 #include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h"
 #include "BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
 #include "BulletDynamics/Dynamics/btRigidBody.h"
 #include "BulletCollision/CollisionShapes/btCollisionShape.h"
 #include "BulletSoftBody/btSoftBody.h"
@@ -69,6 +91,7 @@ namespace te
     class BulletRopeSoftBody;
     class BulletPatchSoftBody;
     class BulletHeightField;
+    class BulletTaskScheduler;
     class BulletJoint;
     class BulletConeTwistJoint;
     class BulletD6Joint;
@@ -39,10 +39,12 @@ namespace te
             const Quaternion newWorldRot = ToQuaternion(worldTrans.getRotation());
             const Vector3 newWorldPos = ToVector3(worldTrans.getOrigin()) - newWorldRot * _rigidBody->GetCenterOfMass();
 
-            _rigidBody->_setTransform(newWorldPos, newWorldRot);
-
+            _rigidBody->_previousPosition = _rigidBody->_position;
+            _rigidBody->_previousRotation = _rigidBody->_rotation;
             _rigidBody->_position = newWorldPos;
             _rigidBody->_rotation = newWorldRot;
+            _rigidBody->_transformStep = _rigidBody->_scene->GetSimulationStep();
+            _rigidBody->_isTransformPending = true;
         }
     private:
         BulletRigidBody* _rigidBody;
@@ -115,6 +117,10 @@ namespace te
         _position = position;
         _rotation = rotation;
 
+        // Teleported, don't interpolate from where the body was before
+        _previousPosition = position;
+        _previousRotation = rotation;
+
         if (_rigidBody)
         {
             // Set position and rotation to world transform
@@ -333,6 +339,22 @@ namespace te
         return _angularFactor;
     }
 
+    void BulletRigidBody::SyncTransform(float alpha)
+    {
+        if (!_isTransformPending)
+            return;
+
+        if (alpha < 1.0f && _transformStep == _scene->GetSimulationStep())
+        {
+            _setTransform(Vector3::Lerp(alpha, _previousPosition, _position),
+                Quaternion::Slerp(alpha, _previousRotation, _rotation));
+            return;
+        }
+
+        _setTransform(_position, _rotation);
+        _isTransformPending = false;
+    }
+
     void BulletRigidBody::AddCollider(Collider* collider)
     {
         BulletFCollider* fCollider = static_cast<BulletFCollider*>(collider->GetInternal());
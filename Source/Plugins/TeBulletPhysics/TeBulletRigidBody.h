@@ -146,6 +146,16 @@ namespace te
         /** @copydoc RigidBody::GetAngularFactor */
         const Vector3& GetAngularFactor() const override;
 
+        /**
+         * Applies the transform computed by the simulation to the linked scene object. Transforms are not applied while
+         * stepping, since scenes can be stepped from worker threads.
+         *
+         * @param[in]	alpha	If the body was moved by the last step, the scene object is placed between its transforms
+         *						before and after that step according to this factor. Bodies keep being synced until
+         *						they stop moving, so a frame without steps can still move them further along.
+         */
+        void SyncTransform(float alpha = 1.0f);
+
     private:
         /** Add RigidBody to world */
         void AddToWorld();
@@ -190,6 +200,8 @@ namespace te
         BulletScene* _scene;
 
         bool _isDirty = true; // A state has been modified
+        bool _isTransformPending = false; // Simulation moved the body since the last call to SyncTransform()
+        UINT64 _transformStep = 0; // Simulation step that last moved the body
 
         btCompoundShape* _shape;
         UnorderedMap<BulletFCollider*, ColliderData> _colliders;
@@ -212,6 +224,8 @@ namespace te
         Vector3 _angularVelocity = Vector3::ZERO;
         Vector3 _angularFactor = Vector3::ONE;
         Quaternion _rotation = Quaternion::IDENTITY;
+        Vector3 _previousPosition = Vector3::ZERO; // Transform before the step that last moved the body
+        Quaternion _previousRotation = Quaternion::IDENTITY;
 
         BodyFlag _flags = (BodyFlag)((UINT32)BodyFlag::None);
         CollisionReportMode _collisionReportMode = CollisionReportMode::None;
@@ -0,0 +1,244 @@
+#include "TeBulletSceneQuery.h"
+
+namespace te
+{
+    static_assert((UINT32)PhysicsQueryLayer::Dynamic == (UINT32)btBroadphaseProxy::DefaultFilter, "");
+    static_assert((UINT32)PhysicsQueryLayer::Static == (UINT32)btBroadphaseProxy::StaticFilter, "");
+
+    namespace
+    {
+        /** Convex shape built on the stack from a query shape description. */
+        class QueryShape
+        {
+        public:
+            QueryShape(const PhysicsQueryShape& desc)
+                : _sphere(desc.Extents.x)
+                , _capsule(desc.Extents.x, desc.Extents.y)
+                , _box(ToBtVector3(desc.Extents))
+            {
+                switch (desc.Type)
+                {
+                case PhysicsQueryShapeType::Capsule:
+                    _shape = &_capsule;
+                    break;
+                case PhysicsQueryShapeType::Box:
+                    _shape = &_box;
+                    break;
+                default:
+                    _shape = &_sphere;
+                    break;
+                }
+            }
+
+            btConvexShape* Get() { return _shape; }
+
+        private:
+            btSphereShape _sphere;
+            btCapsuleShape _capsule;
+            btBoxShape _box;
+            btConvexShape* _shape;
+        };
+
+        /** Closest ray hit, also keeping track of the compound child that was hit. */
+        struct ClosestRayCallback : public btCollisionWorld::ClosestRayResultCallback
+        {
+            ClosestRayCallback(const btVector3& from, const btVector3& to, UINT32 layerMask)
+                : btCollisionWorld::ClosestRayResultCallback(from, to)
+            {
+                m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
+                m_collisionFilterMask = (int)layerMask;
+                m_flags |= btTriangleRaycastCallback::kF_FilterBackfaces;
+            }
+
+            btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) override
+            {
+                HasShapeInfo = rayResult.m_localShapeInfo != nullptr;
+                if (HasShapeInfo)
+                    ShapeInfo = *rayResult.m_localShapeInfo;
+
+                return btCollisionWorld::ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+            }
+
+            btCollisionWorld::LocalShapeInfo ShapeInfo;
+            bool HasShapeInfo = false;
+        };
+
+        /** Closest sweep hit, also keeping track of the compound child that was hit. */
+        struct ClosestSweepCallback : public btCollisionWorld::ClosestConvexResultCallback
+        {
+            ClosestSweepCallback(const btVector3& from, const btVector3& to, UINT32 layerMask)
+                : btCollisionWorld::ClosestConvexResultCallback(from, to)
+            {
+                m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
+                m_collisionFilterMask = (int)layerMask;
+            }
+
+            btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace) override
+            {
+                HasShapeInfo = convexResult.m_localShapeInfo != nullptr;
+                if (HasShapeInfo)
+                    ShapeInfo = *convexResult.m_localShapeInfo;
+
+                return btCollisionWorld::ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+            }
+
+            btCollisionWorld::LocalShapeInfo ShapeInfo;
+            bool HasShapeInfo = false;
+        };
+
+        /** Collects unique colliders touching the query object. */
+        struct OverlapCallback : public btCollisionWorld::ContactResultCallback
+        {
+            OverlapCallback(const btCollisionObject* queryObject, UINT32 layerMask, PhysicsOverlapHit* hits, UINT32 maxHits)
+                : QueryObject(queryObject)
+                , Hits(hits)
+                , MaxHits(maxHits)
+            {
+                m_collisionFilterGroup = btBroadphaseProxy::AllFilter;
+                m_collisionFilterMask = (int)layerMask;
+            }
+
+            btScalar addSingleResult(btManifoldPoint& cp, const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0,
+                const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) override
+            {
+                if (cp.getDistance() > 0 || NumHits == MaxHits)
+                    return 0;
+
+                const btCollisionObjectWrapper* wrapper = colObj0Wrap->getCollisionObject() == QueryObject ? colObj1Wrap : colObj0Wrap;
+                const btCollisionObject* object = wrapper->getCollisionObject();
+
+                // Leaf wrappers can be triangles of a mesh collider, walk up to the first shape belonging to a collider
+                Collider* collider = nullptr;
+                for (; wrapper && !collider; wrapper = wrapper->m_parent)
+                    collider = static_cast<Collider*>(wrapper->getCollisionShape()->getUserPointer());
+
+                Body* body = static_cast<Body*>(object->getUserPointer());
+                for (UINT32 i = 0; i < NumHits; i++)
+                {
+                    if (Hits[i].HitBodyRaw == body && Hits[i].HitColliderRaw == collider)
+                        return 0;
+                }
+
+                Hits[NumHits].HitBodyRaw = body;
+                Hits[NumHits].HitColliderRaw = collider;
+                NumHits++;
+
+                return 0;
+            }
+
+            const btCollisionObject* QueryObject;
+            PhysicsOverlapHit* Hits;
+            UINT32 MaxHits;
+            UINT32 NumHits = 0;
+        };
+    }
+
+    UINT32 BulletSceneQuery::RayCastBatch(const btCollisionWorld* world, const PhysicsRayQuery* queries, UINT32 count,
+        PhysicsBatchHit* hits)
+    {
+        UINT32 numHits = 0;
+        for (UINT32 i = 0; i < count; i++)
+        {
+            const PhysicsRayQuery& query = queries[i];
+            PhysicsBatchHit& hit = hits[i];
+
+            btVector3 from = ToBtVector3(query.Origin);
+            btVector3 to = ToBtVector3(query.Origin + query.UnitDir * query.MaxDist);
+
+            ClosestRayCallback callback(from, to, query.LayerMask);
+            world->rayTest(from, to, callback);
+
+            hit = PhysicsBatchHit();
+            if (!callback.hasHit())
+                continue;
+
+            hit.Point = ToVector3(callback.m_hitPointWorld);
+            hit.Normal = ToVector3(callback.m_hitNormalWorld);
+            hit.Distance = (float)callback.m_closestHitFraction * query.MaxDist;
+            hit.HitBodyRaw = static_cast<Body*>(callback.m_collisionObject->getUserPointer());
+            hit.HitColliderRaw = ResolveCollider(callback.m_collisionObject, callback.HasShapeInfo ? &callback.ShapeInfo : nullptr);
+            hit.HasHit = true;
+            numHits++;
+        }
+
+        return numHits;
+    }
+
+    UINT32 BulletSceneQuery::SweepBatch(const btCollisionWorld* world, const PhysicsSweepQuery* queries, UINT32 count,
+        PhysicsBatchHit* hits)
+    {
+        UINT32 numHits = 0;
+        for (UINT32 i = 0; i < count; i++)
+        {
+            const PhysicsSweepQuery& query = queries[i];
+            PhysicsBatchHit& hit = hits[i];
+
+            QueryShape shape(query.Shape);
+            btQuaternion rotation = ToBtQuaternion(query.Shape.Rotation);
+            btTransform from(rotation, ToBtVector3(query.Origin));
+            btTransform to(rotation, ToBtVector3(query.Origin + query.UnitDir * query.MaxDist));
+
+            ClosestSweepCallback callback(from.getOrigin(), to.getOrigin(), query.LayerMask);
+            world->convexSweepTest(shape.Get(), from, to, callback);
+
+            hit = PhysicsBatchHit();
+            if (!callback.hasHit())
+                continue;
+
+            hit.Point = ToVector3(callback.m_hitPointWorld);
+            hit.Normal = ToVector3(callback.m_hitNormalWorld);
+            hit.Distance = (float)callback.m_closestHitFraction * query.MaxDist;
+            hit.HitBodyRaw = static_cast<Body*>(callback.m_hitCollisionObject->getUserPointer());
+            hit.HitColliderRaw = ResolveCollider(callback.m_hitCollisionObject, callback.HasShapeInfo ? &callback.ShapeInfo : nullptr);
+            hit.HasHit = true;
+            numHits++;
+        }
+
+        return numHits;
+    }
+
+    UINT32 BulletSceneQuery::OverlapBatch(btCollisionWorld* world, const PhysicsOverlapQuery* queries, UINT32 count,
+        PhysicsOverlapHit* hits, UINT32 maxHitsPerQuery, UINT32* numHits)
+    {
+        UINT32 totalHits = 0;
+        for (UINT32 i = 0; i < count; i++)
+        {
+            const PhysicsOverlapQuery& query = queries[i];
+
+            QueryShape shape(query.Shape);
+            btCollisionObject object;
+            object.setCollisionShape(shape.Get());
+            object.setWorldTransform(btTransform(ToBtQuaternion(query.Shape.Rotation), ToBtVector3(query.Position)));
+
+            OverlapCallback callback(&object, query.LayerMask, hits + i * maxHitsPerQuery, maxHitsPerQuery);
+            world->contactTest(&object, callback);
+
+            numHits[i] = callback.NumHits;
+            totalHits += callback.NumHits;
+        }
+
+        return totalHits;
+    }
+
+    Collider* BulletSceneQuery::ResolveCollider(const btCollisionObject* object,
+        const btCollisionWorld::LocalShapeInfo* shapeInfo)
+    {
+        const btCollisionShape* shape = object->getCollisionShape();
+        if (!shape->isCompound())
+            return static_cast<Collider*>(shape->getUserPointer());
+
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+        const int numChildShapes = compound->getNumChildShapes();
+
+        int childIdx = -1;
+        if (numChildShapes == 1)
+            childIdx = 0;
+        else if (shapeInfo && shapeInfo->m_shapePart == -1) // Convex children report their index as the triangle index
+            childIdx = shapeInfo->m_triangleIndex;
+
+        if (childIdx < 0 || childIdx >= numChildShapes)
+            return nullptr;
+
+        return static_cast<Collider*>(compound->getChildShape(childIdx)->getUserPointer());
+    }
+}
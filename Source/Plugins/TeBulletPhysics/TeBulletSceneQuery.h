@@ -0,0 +1,38 @@
+#pragma once
+
+#include "TeBulletPhysicsPrerequisites.h"
+#include "Physics/TePhysicsCommon.h"
+
+namespace te
+{
+    /**
+     * Batched scene queries against a Bullet collision world. Results are written to caller provided arrays and nothing is
+     * allocated per query.
+     *
+     * Queries of a batch run one after the other: the bundled Bullet is built without BT_THREADSAFE, and concurrent
+     * queries would share the ray test stack of the broadphase and the pool allocator of the dispatcher.
+     *
+     * @note	The world must not be modified or stepped while a batch is running.
+     */
+    class TE_BULLET_PHYSICS_EXPORT BulletSceneQuery
+    {
+    public:
+        /** @copydoc PhysicsScene::RayCastBatch */
+        static UINT32 RayCastBatch(const btCollisionWorld* world, const PhysicsRayQuery* queries, UINT32 count,
+            PhysicsBatchHit* hits);
+
+        /** @copydoc PhysicsScene::SweepBatch */
+        static UINT32 SweepBatch(const btCollisionWorld* world, const PhysicsSweepQuery* queries, UINT32 count,
+            PhysicsBatchHit* hits);
+
+        /** @copydoc PhysicsScene::OverlapBatch */
+        static UINT32 OverlapBatch(btCollisionWorld* world, const PhysicsOverlapQuery* queries, UINT32 count,
+            PhysicsOverlapHit* hits, UINT32 maxHitsPerQuery, UINT32* numHits);
+
+        /**
+         * Returns the collider a hit belongs to. Bodies use a compound shape whose children are the collider shapes, and
+         * Bullet reports the index of the child that was hit in @p shapeInfo when it is convex.
+         */
+        static Collider* ResolveCollider(const btCollisionObject* object, const btCollisionWorld::LocalShapeInfo* shapeInfo);
+    };
+}
@@ -0,0 +1,77 @@
+#include "TeBulletTaskScheduler.h"
+#include "Threading/TeTaskScheduler.h"
+
+namespace te
+{
+    BulletTaskScheduler::BulletTaskScheduler()
+        : btITaskScheduler("TeTaskScheduler")
+    {
+        setNumThreads(getMaxNumThreads());
+    }
+
+    int BulletTaskScheduler::getMaxNumThreads() const
+    {
+        // Worker threads, plus the thread stepping the simulation
+        const int numThreads = (int)gTaskScheduler().GetThreadCount() + 1;
+        return std::min(numThreads, (int)BT_MAX_THREAD_COUNT);
+    }
+
+    int BulletTaskScheduler::getNumThreads() const
+    {
+        return _numThreads;
+    }
+
+    void BulletTaskScheduler::setNumThreads(int numThreads)
+    {
+        _numThreads = std::max(1, std::min(numThreads, getMaxNumThreads()));
+    }
+
+    void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body)
+    {
+        Dispatch(iBegin, iEnd, grainSize, [&body](int begin, int end) { body.forLoop(begin, end); });
+    }
+
+    btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body)
+    {
+        if (iEnd <= iBegin)
+            return btScalar(0);
+
+        // Sum per chunk and add them up in order afterwards, so results don't depend on which thread ran what
+        grainSize = std::max(grainSize, 1);
+        const int numChunks = (iEnd - iBegin + grainSize - 1) / grainSize;
+
+        Vector<btScalar> sums(numChunks, btScalar(0));
+        Dispatch(iBegin, iEnd, grainSize, [&](int begin, int end)
+        {
+            sums[(begin - iBegin) / grainSize] = body.sumLoop(begin, end);
+        });
+
+        btScalar sum = btScalar(0);
+        for (auto& value : sums)
+            sum += value;
+
+        return sum;
+    }
+
+    void BulletTaskScheduler::Dispatch(int iBegin, int iEnd, int grainSize, const std::function<void(int, int)>& func)
+    {
+        if (iEnd <= iBegin)
+            return;
+
+        grainSize = std::max(grainSize, 1);
+        const int numChunks = (iEnd - iBegin + grainSize - 1) / grainSize;
+
+        if (std::min(numChunks, _numThreads) <= 1)
+        {
+            for (int begin = iBegin; begin < iEnd; begin += grainSize)
+                func(begin, std::min(begin + grainSize, iEnd));
+
+            return;
+        }
+
+        gTaskScheduler().ParallelFor(0, (UINT32)(iEnd - iBegin), (UINT32)grainSize, [&func, iBegin](UINT32 begin, UINT32 end)
+        {
+            func(iBegin + (int)begin, iBegin + (int)end);
+        }, (UINT32)_numThreads);
+    }
+}
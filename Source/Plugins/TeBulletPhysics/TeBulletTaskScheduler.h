@@ -0,0 +1,45 @@
+#pragma once
+
+#include "TeBulletPhysicsPrerequisites.h"
+#include "LinearMath/btThreads.h"
+
+namespace te
+{
+    /**
+     * Implementation of Bullet's task scheduler interface on top of the engine TaskScheduler. Used by the multithreaded
+     * Bullet pipeline (btDiscreteDynamicsWorldMt and friends) to run its parallel loops on engine worker threads.
+     *
+     * Loops are split in chunks of the requested grain size that are pulled by worker tasks and by the calling thread,
+     * which never waits idle while there is work left. This also makes nested loops safe, for example when several
+     * physics scenes are stepped in parallel from worker threads.
+     */
+    class TE_BULLET_PHYSICS_EXPORT BulletTaskScheduler : public btITaskScheduler
+    {
+    public:
+        BulletTaskScheduler();
+
+        /** @copydoc btITaskScheduler::getMaxNumThreads */
+        int getMaxNumThreads() const override;
+
+        /** @copydoc btITaskScheduler::getNumThreads */
+        int getNumThreads() const override;
+
+        /** @copydoc btITaskScheduler::setNumThreads */
+        void setNumThreads(int numThreads) override;
+
+        /** @copydoc btITaskScheduler::parallelFor */
+        void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+
+        /** @copydoc btITaskScheduler::parallelSum */
+        btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+    private:
+        /**
+         * Runs @p func over [iBegin, iEnd) in chunks of @p grainSize elements, using up to _numThreads threads including
+         * the calling one. Returns once all chunks have been processed.
+         */
+        void Dispatch(int iBegin, int iEnd, int grainSize, const std::function<void(int, int)>& func);
+
+        int _numThreads = 1;
+    };
+}
@@ -6,6 +6,7 @@
 #include "Utility/TeDataStream.h"
 #include "Utility/TeUtility.h"
 #include <regex>
+#include <thread>
 
 namespace te
 {
@@ -280,7 +281,20 @@ namespace te
             }
 
             if (microcode != nullptr)
-                D3DWriteBlobToFile(microcode, compiledShaderPath.generic_wstring().c_str(), true);
+            {
+                // Passes compile in parallel and may produce the same blob. It is written aside then moved in place, so
+                // no other compilation reads a partially written file
+                std::filesystem::path tempPath = compiledShaderPath;
+                tempPath += "." + ToString((UINT64)std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+
+                if (SUCCEEDED(D3DWriteBlobToFile(microcode, tempPath.generic_wstring().c_str(), true)))
+                {
+                    std::error_code error;
+                    std::filesystem::rename(tempPath, compiledShaderPath, error);
+                    if (error)
+                        std::filesystem::remove(tempPath, error);
+                }
+            }
 
             if (include)
                 te_delete(include);
@@ -2,12 +2,18 @@
 #include "Importer/TeMeshImportOptions.h"
 #include "Mesh/TeMesh.h"
 #include "Mesh/TeMeshData.h"
+#include "Mesh/TeMeshSimplifier.h"
+#include "Mesh/TeMeshOptimizer.h"
+#include "Mesh/TeMeshlet.h"
+#include "Mesh/TeMeshUtility.h"
+#include "RenderAPI/TeVertexDataDesc.h"
 #include "Image/TeColor.h"
 #include "Animation/TeSkeleton.h"
 #include "Animation/TeAnimationUtility.h"
 #include "Utility/TeFileSystem.h"
 #include "Physics/TePhysicsMesh.h"
 #include "Physics/TePhysics.h"
+#include "Threading/TeTaskScheduler.h"
 
 #include <cctype>
 #include <filesystem>
@@ -54,7 +60,15 @@ namespace te
         if (rendererMeshData)
         {
             auto path = std::filesystem::absolute(filePath);
-            SPtr<Mesh> mesh = Mesh::CreatePtr(rendererMeshData->GetData(), desc);
+            SPtr<MeshData> meshData = GenerateLods(rendererMeshData->GetData(), desc.SubMeshes, meshImportOptions, desc.Lods);
+            if (meshImportOptions->OptimizeMesh)
+                OptimizeMeshData(meshData, desc.SubMeshes, desc.Lods, meshImportOptions);
+            if (meshImportOptions->GenerateMeshlets)
+                GenerateMeshlets(meshData, desc.SubMeshes, desc.Lods);
+            if (meshImportOptions->Precision == VertexPrecision::Compact)
+                meshData = RendererMeshData::Compress(meshData);
+
+            SPtr<Mesh> mesh = Mesh::CreatePtr(meshData, desc);
             mesh->SetName(path.filename().generic_string());
             mesh->SetPath(path.generic_string());
 
@@ -81,7 +95,18 @@ namespace te
         if (rendererMeshData)
         {
             auto path = std::filesystem::absolute(filePath);
-            SPtr<Mesh> mesh = Mesh::CreatePtr(rendererMeshData->GetData(), desc);
+            SPtr<MeshData> meshData = GenerateLods(rendererMeshData->GetData(), desc.SubMeshes, meshImportOptions, desc.Lods);
+            if (meshImportOptions->OptimizeMesh)
+                OptimizeMeshData(meshData, desc.SubMeshes, desc.Lods, meshImportOptions);
+            if (meshImportOptions->GenerateMeshlets)
+                GenerateMeshlets(meshData, desc.SubMeshes, desc.Lods);
+
+            // The z pre pass mesh is drawn with the per-object data of the primary mesh, it must be quantized alike
+            AABox positionBounds = meshData->CalculateBounds().GetBox();
+            if (meshImportOptions->Precision == VertexPrecision::Compact)
+                meshData = RendererMeshData::Compress(meshData, &positionBounds);
+
+            SPtr<Mesh> mesh = Mesh::CreatePtr(meshData, desc);
             mesh->SetName(path.filename().generic_string());
             mesh->SetPath(path.generic_string());
 
@@ -144,7 +169,19 @@ namespace te
 
                         if (importZPrepassMesh)
                         {
-                            SPtr<ZPrepassMesh> zPrepassMesh = ZPrepassMesh::CreatePtr(simpleMeshData->GetData(), desc);
+                            // Levels of detail index the primary mesh only, z prepass uses its full detail sub-meshes
+                            MESH_DESC zPrepassDesc = desc;
+                            zPrepassDesc.Lods.clear();
+
+                            // Meshlets index the reordered triangles of the primary mesh, z prepass draws whole sub-meshes
+                            for (auto& subMesh : zPrepassDesc.SubMeshes)
+                                subMesh.Meshlets.clear();
+
+                            SPtr<MeshData> zPrepassData = simpleMeshData->GetData();
+                            if (meshImportOptions->Precision == VertexPrecision::Compact)
+                                zPrepassData = RendererMeshData::Compress(zPrepassData, &positionBounds);
+
+                            SPtr<ZPrepassMesh> zPrepassMesh = ZPrepassMesh::CreatePtr(zPrepassData, zPrepassDesc);
                             zPrepassMesh->SetName(path.filename().generic_string());
                             zPrepassMesh->SetPath(path.generic_string());
 
@@ -184,6 +221,187 @@ namespace te
         return output;
     }
 
+    SPtr<MeshData> ObjectImporter::GenerateLods(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+        const MeshImportOptions* importOptions, Vector<MeshLod>& lods)
+    {
+        lods.clear();
+
+        if (importOptions->LodCount <= 1 || meshData->GetIndexType() != IT_32BIT)
+            return meshData;
+
+        for (auto& subMesh : subMeshes)
+        {
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST)
+                return meshData;
+        }
+
+        const SPtr<VertexDataDesc>& vertexDesc = meshData->GetVertexDesc();
+        const VertexElement* positionElement = vertexDesc->GetElement(VES_POSITION);
+        if (positionElement == nullptr || positionElement->GetType() != VET_FLOAT3)
+            return meshData;
+
+        const UINT32 streamIdx = positionElement->GetStreamIdx();
+        const UINT8* positions = meshData->GetElementData(VES_POSITION, 0, streamIdx);
+        const UINT32 stride = vertexDesc->GetVertexStride(streamIdx);
+        const UINT32 numVertices = meshData->GetNumVertices();
+        const UINT32* indices = meshData->GetIndices32();
+
+        Vector<UINT32> lodIndices;
+        Vector<SubMesh> previousSubMeshes = subMeshes;
+        Vector<UINT32> simplified;
+        float screenSize = importOptions->LodScreenSize;
+
+        for (UINT32 lodIdx = 1; lodIdx < importOptions->LodCount; lodIdx++)
+        {
+            MeshLod lod;
+            lod.ScreenSize = screenSize;
+
+            UINT32 numNewIndices = 0;
+            for (auto& previousSubMesh : previousSubMeshes)
+            {
+                // Previous levels are either in the original index buffer or in the indices generated so far
+                const UINT32* source = previousSubMesh.IndexOffset < meshData->GetNumIndices()
+                    ? indices + previousSubMesh.IndexOffset
+                    : lodIndices.data() + (previousSubMesh.IndexOffset - meshData->GetNumIndices());
+
+                const UINT32 targetNumIndices = (UINT32)(previousSubMesh.IndexCount * importOptions->LodReduction) / 3 * 3;
+
+                simplified.resize(previousSubMesh.IndexCount);
+                const UINT32 numIndices = MeshSimplifier::Simplify(positions, numVertices, stride, source,
+                    previousSubMesh.IndexCount, targetNumIndices, importOptions->LodMaxError, simplified.data());
+
+                SubMesh subMesh = previousSubMesh;
+                subMesh.IndexOffset = meshData->GetNumIndices() + (UINT32)lodIndices.size();
+                subMesh.IndexCount = numIndices;
+                lod.SubMeshes.push_back(subMesh);
+
+                lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.begin() + numIndices);
+                numNewIndices += numIndices;
+            }
+
+            UINT32 numPreviousIndices = 0;
+            for (auto& previousSubMesh : previousSubMeshes)
+                numPreviousIndices += previousSubMesh.IndexCount;
+
+            // A level which barely removes anything isn't worth its indices, and the following ones would be the same
+            if (numNewIndices > numPreviousIndices * 0.95f)
+            {
+                lodIndices.resize(lodIndices.size() - numNewIndices);
+                break;
+            }
+
+            previousSubMeshes = lod.SubMeshes;
+            lods.push_back(lod);
+            screenSize *= 0.5f;
+        }
+
+        if (lods.empty())
+            return meshData;
+
+        SPtr<MeshData> output = te_shared_ptr_new<MeshData>(numVertices, meshData->GetNumIndices() + (UINT32)lodIndices.size(),
+            vertexDesc, IT_32BIT);
+
+        UINT32* outputIndices = output->GetIndices32();
+        memcpy(outputIndices, indices, meshData->GetNumIndices() * sizeof(UINT32));
+        memcpy(outputIndices + meshData->GetNumIndices(), lodIndices.data(), lodIndices.size() * sizeof(UINT32));
+
+        // Streams are stored one after the other, right after the indices
+        memcpy(output->GetStreamData(0), meshData->GetStreamData(0), meshData->GetStreamSize());
+
+        return output;
+    }
+
+    void ObjectImporter::OptimizeMeshData(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+        const Vector<MeshLod>& lods, const MeshImportOptions* importOptions)
+    {
+        if (meshData->GetIndexType() != IT_32BIT)
+            return;
+
+        const SPtr<VertexDataDesc>& vertexDesc = meshData->GetVertexDesc();
+        const VertexElement* positionElement = vertexDesc->GetElement(VES_POSITION);
+        if (positionElement == nullptr || positionElement->GetType() != VET_FLOAT3)
+            return;
+
+        const UINT8* positions = meshData->GetElementData(VES_POSITION, 0, positionElement->GetStreamIdx());
+        const UINT32 stride = vertexDesc->GetVertexStride(positionElement->GetStreamIdx());
+        const UINT32 numVertices = meshData->GetNumVertices();
+        const UINT32 numIndices = meshData->GetNumIndices();
+        UINT32* indices = meshData->GetIndices32();
+
+        // Triangles can only move within their sub-mesh
+        Vector<UINT32> optimized;
+        auto OptimizeSubMesh = [&](const SubMesh& subMesh)
+        {
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST || subMesh.IndexCount < 3)
+                return;
+
+            UINT32* subMeshIndices = indices + subMesh.IndexOffset;
+            optimized.resize(subMesh.IndexCount);
+
+            MeshOptimizer::OptimizeVertexCache(optimized.data(), subMeshIndices, subMesh.IndexCount, numVertices);
+            MeshOptimizer::OptimizeOverdraw(subMeshIndices, optimized.data(), subMesh.IndexCount, positions, numVertices,
+                stride, importOptions->OverdrawThreshold);
+        };
+
+        for (auto& subMesh : subMeshes)
+            OptimizeSubMesh(subMesh);
+
+        for (auto& lod : lods)
+        {
+            for (auto& subMesh : lod.SubMeshes)
+                OptimizeSubMesh(subMesh);
+        }
+
+        // Vertices follow the full detail triangles, every stream is moved the same way
+        Vector<UINT32> remap(numVertices);
+        MeshOptimizer::OptimizeVertexFetch(remap.data(), indices, numIndices, numVertices);
+
+        UnorderedSet<UINT32> streams;
+        for (UINT32 i = 0; i < vertexDesc->GetNumElements(); i++)
+            streams.insert(vertexDesc->GetElement(i).GetStreamIdx());
+
+        for (auto& streamIdx : streams)
+        {
+            MeshOptimizer::RemapVertices(meshData->GetStreamData(streamIdx), numVertices,
+                vertexDesc->GetVertexStride(streamIdx), remap.data());
+        }
+    }
+
+    void ObjectImporter::GenerateMeshlets(const SPtr<MeshData>& meshData, Vector<SubMesh>& subMeshes, Vector<MeshLod>& lods)
+    {
+        if (meshData->GetIndexType() != IT_32BIT)
+            return;
+
+        const SPtr<VertexDataDesc>& vertexDesc = meshData->GetVertexDesc();
+        const VertexElement* positionElement = vertexDesc->GetElement(VES_POSITION);
+        if (positionElement == nullptr || positionElement->GetType() != VET_FLOAT3)
+            return;
+
+        const UINT8* positions = meshData->GetElementData(VES_POSITION, 0, positionElement->GetStreamIdx());
+        const UINT32 stride = vertexDesc->GetVertexStride(positionElement->GetStreamIdx());
+        const UINT32 numVertices = meshData->GetNumVertices();
+        UINT32* indices = meshData->GetIndices32();
+
+        auto BuildSubMesh = [&](SubMesh& subMesh)
+        {
+            subMesh.Meshlets.clear();
+            if (subMesh.DrawOp != DOT_TRIANGLE_LIST || subMesh.IndexCount < 3)
+                return;
+
+            MeshletUtility::Build(indices, subMesh.IndexOffset, subMesh.IndexCount, positions, numVertices, stride,
+                subMesh.Meshlets);
+        };
+
+        for (auto& subMesh : subMeshes)
+            BuildSubMesh(subMesh);
+
+        for (auto& lod : lods)
+        {
+            for (auto& subMesh : lod.SubMeshes)
+                BuildSubMesh(subMesh);
+        }
+    }
+
     SPtr<RendererMeshData> ObjectImporter::ImportMeshData(const String& filePath, MeshImportOptions* importOptions, Vector<SubMesh>& subMeshes, 
         Vector<AssimpAnimationClipData>& animation, SPtr<Skeleton>& skeleton)
     {
@@ -200,7 +418,6 @@ namespace te
             aiProcess_SplitLargeMeshes |
             aiProcess_Triangulate |
             aiProcess_FixInfacingNormals |
-            aiProcess_CalcTangentSpace |
             aiProcess_SortByPType |
             aiProcess_JoinIdenticalVertices |
             aiProcess_RemoveRedundantMaterials |
@@ -281,6 +498,7 @@ namespace te
         assimpImportOptions.ImportTextures     = importOptions->ImportTextures;
         assimpImportOptions.ImportColors       = importOptions->ImportVertexColors;
         assimpImportOptions.ReduceKeyframes    = importOptions->ReduceKeyFrames;
+        assimpImportOptions.ParallelImport     = importOptions->ParallelImport;
         assimpImportOptions.FilePath           = filePath;
 
         if (importOptions->ImportZPrepassMesh)
@@ -339,6 +557,18 @@ namespace te
             }
         }
 
+        // Meshes are registered in traversal order above, their data doesn't depend on each other
+        auto ConvertMeshes = [&](UINT32 begin, UINT32 end)
+        {
+            for (UINT32 i = begin; i < end; i++)
+                ConvertMesh(*outputScene.Meshes[i], options);
+        };
+
+        if (options.ParallelImport)
+            gTaskScheduler().ParallelFor(0, (UINT32)outputScene.Meshes.size(), 1, ConvertMeshes);
+        else
+            ConvertMeshes(0, (UINT32)outputScene.Meshes.size());
+
         if (scene->HasMaterials())
         {
             MaterialProperties matProperties;
@@ -450,7 +680,6 @@ namespace te
     {
         unsigned int vertexCount = mesh->mNumVertices;
         unsigned int triangleCount = mesh->mNumFaces;
-        unsigned int indexCount = mesh->mNumFaces * 3;
 
         if (vertexCount == 0 || triangleCount == 0)
             return;
@@ -482,58 +711,55 @@ namespace te
             outputScene.MeshMap[mesh] = (UINT32)outputScene.Meshes.size() - 1;
         }
 
+        // Import Materials
+        importMesh->MaterialIndex = mesh->mMaterialIndex;
+    }
+
+    void ObjectImporter::ConvertMesh(AssimpImportMesh& importMesh, const AssimpImportOptions& options)
+    {
+        aiMesh* mesh = importMesh.AssimpMesh;
+        unsigned int vertexCount = mesh->mNumVertices;
+        unsigned int triangleCount = mesh->mNumFaces;
+        unsigned int indexCount = mesh->mNumFaces * 3;
+
         // Import colors
         if (options.ImportColors)
         {
-            importMesh->Colors.resize(vertexCount);
+            importMesh.Colors.resize(vertexCount);
         }
 
         // Import vertices
-        importMesh->Positions.resize(vertexCount);
+        importMesh.Positions.resize(vertexCount);
         for (UINT32 i = 0; i < vertexCount; i++)
         {
-            importMesh->Positions[i] = ConvertToNativeType(mesh->mVertices[i]);
+            importMesh.Positions[i] = ConvertToNativeType(mesh->mVertices[i]);
 
-            if (mesh->HasVertexColors(i) && options.ImportColors)
-                importMesh->Colors[i] = ConvertToNativeType(*mesh->mColors[i]);
+            if (mesh->HasVertexColors(0) && options.ImportColors)
+                importMesh.Colors[i] = ConvertToNativeType(mesh->mColors[0][i]);
         }
 
         // Import triangles
-        importMesh->Indices.resize(indexCount);
+        importMesh.Indices.resize(indexCount);
         for (UINT32 i = 0; i < triangleCount; i++)
         {
             aiFace* face = &mesh->mFaces[i];
             for (UINT32 j = 0; j < face->mNumIndices; j++)
             {
-                importMesh->Indices[(i * 3) + j] = face->mIndices[j]; 
+                importMesh.Indices[(i * 3) + j] = face->mIndices[j]; 
             }
         }
 
         // Import normals 
         if (mesh->HasNormals() && options.ImportNormals)
         {
-            importMesh->Normals.resize(vertexCount);
+            importMesh.Normals.resize(vertexCount);
 
             for (UINT32 i = 0; i < vertexCount; i++)
             {
-                importMesh->Normals[i] = ConvertToNativeType(mesh->mNormals[i]);
+                importMesh.Normals[i] = ConvertToNativeType(mesh->mNormals[i]);
             }
         }
         
-        // Import tangents and bitangents
-        if (mesh->HasTangentsAndBitangents() && options.ImportTangents)
-        {
-            importMesh->Tangents.resize(vertexCount);
-            importMesh->Bitangents.resize(vertexCount);
-
-            for (UINT32 i = 0; i < vertexCount; i++)
-            {
-                importMesh->Tangents[i] = ConvertToNativeType(mesh->mTangents[i]);
-                importMesh->Bitangents[i] = ConvertToNativeType(mesh->mBitangents[i]);
-                importMesh->Bitangents[i] *= -1.0f; // TODO BiTangent direction seems to be wrong
-            }
-        }
-
         // Import UVs
         if (options.ImportUVCoords)
         {
@@ -542,30 +768,61 @@ namespace te
                 if (!mesh->HasTextureCoords(i))
                     break;
 
-                importMesh->Textures[i].resize(vertexCount);
+                importMesh.Textures[i].resize(vertexCount);
                 for (UINT32 j = 0; j < vertexCount; j++)
                 {
                     Vector3 coord = ConvertToNativeType(mesh->mTextureCoords[i][j]);
-                    importMesh->Textures[i][j] = Vector2(coord.x, coord.y);
+                    importMesh.Textures[i][j] = Vector2(coord.x, coord.y);
                 }
             }
         }
 
-        // Import Materials
-        importMesh->MaterialIndex = mesh->mMaterialIndex;
+        // Import tangents and bitangents, or generate them from the normals and the first UV layer
+        if (mesh->HasTangentsAndBitangents() && options.ImportTangents)
+        {
+            importMesh.Tangents.resize(vertexCount);
+            importMesh.Bitangents.resize(vertexCount);
+
+            for (UINT32 i = 0; i < vertexCount; i++)
+            {
+                importMesh.Tangents[i] = ConvertToNativeType(mesh->mTangents[i]);
+                importMesh.Bitangents[i] = ConvertToNativeType(mesh->mBitangents[i]);
+                importMesh.Bitangents[i] *= -1.0f; // TODO BiTangent direction seems to be wrong
+            }
+        }
+        else if (options.ImportTangents && importMesh.Normals.size() == vertexCount &&
+            importMesh.Textures[0].size() == vertexCount)
+        {
+            importMesh.Tangents.resize(vertexCount);
+            importMesh.Bitangents.resize(vertexCount);
+
+            MeshUtility::CalculateTangents(importMesh.Positions.data(), importMesh.Normals.data(), importMesh.Textures[0].data(),
+                (UINT8*)importMesh.Indices.data(), vertexCount, indexCount, importMesh.Tangents.data(),
+                importMesh.Bitangents.data(), sizeof(UINT32));
+        }
     }
 
     void ObjectImporter::ImportSkin(AssimpImportScene& scene, const AssimpImportOptions& options)
     {
-        for (auto& mesh : scene.Meshes)
+        // Each mesh only writes its own bones and influences
+        auto ImportMeshSkins = [&](UINT32 begin, UINT32 end)
         {
-            aiMesh* assimpMesh = mesh->AssimpMesh;
+            for (UINT32 i = begin; i < end; i++)
+            {
+                AssimpImportMesh* mesh = scene.Meshes[i];
+                aiMesh* assimpMesh = mesh->AssimpMesh;
 
-            if (assimpMesh->mNumBones == 0)
-                continue;
+                if (assimpMesh->mNumBones == 0)
+                    continue;
 
-            ImportSkin(scene, assimpMesh, *mesh, options);
-        }
+                ImportSkin(scene, assimpMesh, *mesh, options);
+            }
+        };
+
+        if (options.ParallelImport)
+            gTaskScheduler().ParallelFor(0, (UINT32)scene.Meshes.size(), 1, ImportMeshSkins);
+        else
+            ImportMeshSkins(0, (UINT32)scene.Meshes.size());
     }
 
     void ObjectImporter::ImportSkin(AssimpImportScene& scene, aiMesh* assimpMesh, AssimpImportMesh& mesh, const AssimpImportOptions& options)
@@ -1090,7 +1347,6 @@ namespace te
         Vector<SPtr<MeshData>> allMeshData;
         Vector<Vector<SubMesh>> allSubMeshes;
         UINT32 currentIndex = 0;
-        UINT32 boneIndexOffset = 0;
 
         // Generate unique indices for all the bones. This is mirrored in createSkeleton().
         UnorderedMap<AssimpImportNode*, UINT32> boneMap;
@@ -1109,10 +1365,29 @@ namespace te
             }
         }
 
+        UINT32 vertexLayout = 0;
+        if (options.CustomVertexLayout != 0)
+        {
+            vertexLayout = options.CustomVertexLayout;
+        }
+        else
+        {
+            vertexLayout |= (UINT32)VertexLayout::Position;
+            vertexLayout |= (UINT32)VertexLayout::Normal;
+            vertexLayout |= (UINT32)VertexLayout::Tangent;
+            vertexLayout |= (UINT32)VertexLayout::BiTangent;
+            vertexLayout |= (UINT32)VertexLayout::UV0;
+            vertexLayout |= (UINT32)VertexLayout::UV1;
+            vertexLayout |= (UINT32)VertexLayout::BoneWeights;
+            vertexLayout |= (UINT32)VertexLayout::Color;
+        }
+
+        // Every node referencing a mesh gets its own copy of the mesh data, listed in the order they are combined
+        Vector<std::pair<AssimpImportMesh*, AssimpImportNode*>> instances;
+
         for (auto& mesh : scene.Meshes)
         {
             Vector<SubMesh> subMeshes;
-            UINT32 numIndices = (UINT32)mesh->Indices.size();
 
             Vector<UINT32> indicesPerMaterial;
 
@@ -1147,201 +1422,195 @@ namespace te
                 currentIndex += indexCount;
             }
 
-            UINT32 vertexLayout = 0;
-            if (options.CustomVertexLayout != 0)
-            {
-                vertexLayout = options.CustomVertexLayout;
-            }
-            else
+            for (auto& node : mesh->ReferencedBy)
             {
-                vertexLayout |= (UINT32)VertexLayout::Position;
-                vertexLayout |= (UINT32)VertexLayout::Normal;
-                vertexLayout |= (UINT32)VertexLayout::Tangent;
-                vertexLayout |= (UINT32)VertexLayout::BiTangent;
-                vertexLayout |= (UINT32)VertexLayout::UV0;
-                vertexLayout |= (UINT32)VertexLayout::UV1;
-                vertexLayout |= (UINT32)VertexLayout::BoneWeights;
-                vertexLayout |= (UINT32)VertexLayout::Color;
+                instances.push_back(std::make_pair(mesh, node));
+                allSubMeshes.push_back(subMeshes);
             }
+        }
 
-            size_t numVertices = mesh->Positions.size();
-            bool hasColors = mesh->Colors.size() == numVertices;
-            bool hasNormals = mesh->Normals.size() == numVertices;
-            bool hasBoneInfluences = mesh->BoneInfluences.size() == numVertices;
-            bool hasTangents = false;
+        allMeshData.resize(instances.size());
 
-            if (hasNormals)
-            {
-                if (mesh->Tangents.size() == numVertices &&
-                    mesh->Bitangents.size() == numVertices)
-                {
-                    hasTangents = true;
-                }
-            }
+        auto GenerateInstances = [&](UINT32 begin, UINT32 end)
+        {
+            for (UINT32 i = begin; i < end; i++)
+                allMeshData[i] = GenerateMeshData(*instances[i].first, *instances[i].second, vertexLayout, boneMap);
+        };
 
-            for (auto& node : mesh->ReferencedBy)
-            {
-                Matrix4 worldTransform = node->WorldTransform;
-                Matrix4 worldTransformIT = worldTransform.Inverse();
-                worldTransformIT = worldTransformIT.Transpose();
+        if (options.ParallelImport)
+            gTaskScheduler().ParallelFor(0, (UINT32)instances.size(), 1, GenerateInstances);
+        else
+            GenerateInstances(0, (UINT32)instances.size());
 
-                SPtr<RendererMeshData> meshData = RendererMeshData::Create((UINT32)numVertices, numIndices, (VertexLayout)vertexLayout);
+        if (allMeshData.size() > 1)
+        {
+            return RendererMeshData::Create(MeshData::Combine(allMeshData, allSubMeshes, outputSubMeshes));
+        }
+        else if (allMeshData.size() == 1)
+        {
+            outputSubMeshes = allSubMeshes[0];
+            return RendererMeshData::Create(allMeshData[0]);
+        }
 
-                // Copy indices
-                meshData->SetIndices(mesh->Indices.data(), numIndices * sizeof(UINT32));
+        return nullptr;
+    }
 
-                // Copy & transform positions
-                UINT32 positionsSize = sizeof(Vector3) * (UINT32)numVertices;
-                Vector3* transformedPositions = (Vector3*)te_allocate(positionsSize * sizeof(Vector3));
+    SPtr<MeshData> ObjectImporter::GenerateMeshData(const AssimpImportMesh& mesh, const AssimpImportNode& node, UINT32 vertexLayout,
+        const UnorderedMap<AssimpImportNode*, UINT32>& boneMap)
+    {
+        UINT32 numIndices = (UINT32)mesh.Indices.size();
+        size_t numVertices = mesh.Positions.size();
+        bool hasColors = mesh.Colors.size() == numVertices;
+        bool hasNormals = mesh.Normals.size() == numVertices;
+        bool hasBoneInfluences = mesh.BoneInfluences.size() == numVertices;
+        bool hasTangents = false;
+
+        if (hasNormals)
+        {
+            if (mesh.Tangents.size() == numVertices &&
+                mesh.Bitangents.size() == numVertices)
+            {
+                hasTangents = true;
+            }
+        }
 
-                for (UINT32 i = 0; i < (UINT32)numVertices; i++)
-                {
-                    transformedPositions[i] = worldTransform.MultiplyAffine((Vector3)mesh->Positions[i]);
-                }
+        Matrix4 worldTransform = node.WorldTransform;
+        Matrix4 worldTransformIT = worldTransform.Inverse();
+        worldTransformIT = worldTransformIT.Transpose();
 
-                meshData->SetPositions(transformedPositions, positionsSize);
-                te_delete(transformedPositions);
+        SPtr<RendererMeshData> meshData = RendererMeshData::Create((UINT32)numVertices, numIndices, (VertexLayout)vertexLayout);
 
-                // Copy & transform normals
-                if (hasNormals)
-                {
-                    UINT32 normalsSize = sizeof(Vector3) * (UINT32)numVertices;
-                    Vector3* transformedNormals = (Vector3*)te_allocate(normalsSize * sizeof(Vector3));
+        // Copy indices
+        meshData->SetIndices(const_cast<UINT32*>(mesh.Indices.data()), numIndices * sizeof(UINT32));
 
-                    // Copy, convert & transform tangents & bitangents
-                    if (hasTangents)
-                    {
-                        UINT32 tangentsSize = sizeof(Vector4) * (UINT32)numVertices;
-                        Vector4* transformedTangents = (Vector4*)te_allocate(tangentsSize * sizeof(Vector4));
-                        Vector4* transformedBiTangents = (Vector4*)te_allocate(tangentsSize * sizeof(Vector4));
+        // Copy & transform positions
+        UINT32 positionsSize = sizeof(Vector3) * (UINT32)numVertices;
+        Vector<Vector3> transformedPositions(numVertices);
 
-                        for (UINT32 i = 0; i < (UINT32)numVertices; i++)
-                        {
-                            Vector3 normal = (Vector3)mesh->Normals[i];
-                            normal = worldTransformIT.MultiplyDirection(normal);
-                            transformedNormals[i] = Vector3::Normalize(normal);
+        for (UINT32 i = 0; i < (UINT32)numVertices; i++)
+        {
+            transformedPositions[i] = worldTransform.MultiplyAffine((Vector3)mesh.Positions[i]);
+        }
 
-                            Vector3 tangent = (Vector3)mesh->Tangents[i];
-                            tangent = Vector3::Normalize(worldTransformIT.MultiplyDirection(tangent));
+        meshData->SetPositions(transformedPositions.data(), positionsSize);
 
-                            Vector3 bitangent = (Vector3)mesh->Bitangents[i];
-                            bitangent = worldTransformIT.MultiplyDirection(bitangent);
+        // Copy & transform normals
+        if (hasNormals)
+        {
+            UINT32 normalsSize = sizeof(Vector3) * (UINT32)numVertices;
+            Vector<Vector3> transformedNormals(numVertices);
 
-                            Vector3 engineBitangent = Vector3::Cross(normal, tangent);
-                            float sign = Vector3::Dot(engineBitangent, bitangent);
+            // Copy, convert & transform tangents & bitangents
+            if (hasTangents)
+            {
+                UINT32 tangentsSize = sizeof(Vector4) * (UINT32)numVertices;
+                Vector<Vector4> transformedTangents(numVertices);
+                Vector<Vector4> transformedBiTangents(numVertices);
 
-                            bitangent = Vector3::Normalize(bitangent);
+                for (UINT32 i = 0; i < (UINT32)numVertices; i++)
+                {
+                    Vector3 normal = (Vector3)mesh.Normals[i];
+                    normal = worldTransformIT.MultiplyDirection(normal);
+                    transformedNormals[i] = Vector3::Normalize(normal);
 
-                            transformedTangents[i] = Vector4(tangent.x, tangent.y, tangent.z, sign > 0 ? 1.0f : -1.0f);
-                            transformedBiTangents[i] = Vector4(bitangent.x, bitangent.y, bitangent.z, sign > 0 ? 1.0f : -1.0f);
-                        }
+                    Vector3 tangent = (Vector3)mesh.Tangents[i];
+                    tangent = Vector3::Normalize(worldTransformIT.MultiplyDirection(tangent));
 
-                        meshData->SetTangents(transformedTangents, tangentsSize);
-                        meshData->SetBiTangents(transformedBiTangents, tangentsSize);
-                        te_delete(transformedTangents);
-                        te_delete(transformedBiTangents);
-                    }
-                    else
-                    {
-                        for (UINT32 i = 0; i < (UINT32)numVertices; i++)
-                        {
-                            transformedNormals[i] = Vector3::Normalize(worldTransformIT.MultiplyDirection((Vector3)mesh->Normals[i]));
-                        }
-                    }
+                    Vector3 bitangent = (Vector3)mesh.Bitangents[i];
+                    bitangent = worldTransformIT.MultiplyDirection(bitangent);
 
-                    meshData->SetNormals(transformedNormals, normalsSize);
-                    te_delete(transformedNormals);
-                }
+                    Vector3 engineBitangent = Vector3::Cross(normal, tangent);
+                    float sign = Vector3::Dot(engineBitangent, bitangent);
 
-                // Copy colors
-                if (hasColors)
-                {
-                    meshData->SetColors(mesh->Colors.data(), sizeof(Vector4) * (UINT32)numVertices);
+                    bitangent = Vector3::Normalize(bitangent);
+
+                    transformedTangents[i] = Vector4(tangent.x, tangent.y, tangent.z, sign > 0 ? 1.0f : -1.0f);
+                    transformedBiTangents[i] = Vector4(bitangent.x, bitangent.y, bitangent.z, sign > 0 ? 1.0f : -1.0f);
                 }
 
-                // Copy UV
-                int writeUVIDx = 0;
-                for (auto& uvLayer : mesh->Textures)
+                meshData->SetTangents(transformedTangents.data(), tangentsSize);
+                meshData->SetBiTangents(transformedBiTangents.data(), tangentsSize);
+            }
+            else
+            {
+                for (UINT32 i = 0; i < (UINT32)numVertices; i++)
                 {
-                    if (uvLayer.size() == numVertices)
-                    {
-                        UINT32 size = sizeof(Vector2) * (UINT32)numVertices;
-                        Vector2* transformedUV = (Vector2*)te_allocate(size * sizeof(Vector2));
+                    transformedNormals[i] = Vector3::Normalize(worldTransformIT.MultiplyDirection((Vector3)mesh.Normals[i]));
+                }
+            }
 
-                        UINT32 i = 0;
-                        for (auto& uv : uvLayer)
-                        {
-                            transformedUV[i] = uv;
-                            transformedUV[i].y = 1.0f - uv.y;
-                            i++;
-                        }
+            meshData->SetNormals(transformedNormals.data(), normalsSize);
+        }
 
-                        if (writeUVIDx == 0)
-                            meshData->SetUV0(transformedUV, size);
-                        else if (writeUVIDx == 1)
-                            meshData->SetUV1(transformedUV, size);
+        // Copy colors
+        if (hasColors)
+        {
+            meshData->SetColors(const_cast<Vector4*>(mesh.Colors.data()), sizeof(Vector4) * (UINT32)numVertices);
+        }
 
-                        te_delete(transformedUV);
+        // Copy UV
+        int writeUVIDx = 0;
+        Vector<Vector2> transformedUV;
+        for (auto& uvLayer : mesh.Textures)
+        {
+            if (uvLayer.size() == numVertices)
+            {
+                UINT32 size = sizeof(Vector2) * (UINT32)numVertices;
+                transformedUV.resize(numVertices);
 
-                        writeUVIDx++;
-                    }
+                UINT32 i = 0;
+                for (auto& uv : uvLayer)
+                {
+                    transformedUV[i] = uv;
+                    transformedUV[i].y = 1.0f - uv.y;
+                    i++;
                 }
 
-                // Copy bone influences & remap bone indices
-                if (hasBoneInfluences)
-                {
-                    UINT32 bufferSize = sizeof(BoneWeight) * (UINT32)numVertices;
-                    BoneWeight* weights = (BoneWeight*)te_allocate(bufferSize * sizeof(BoneWeight));
-                    for (UINT32 i = 0; i < (UINT32)numVertices; i++)
-                    {
-                        int* indices[] = { &weights[i].Index0, &weights[i].Index1, &weights[i].Index2, &weights[i].Index3 };
-                        float* amounts[] = { &weights[i].Weight0, &weights[i].Weight1, &weights[i].Weight2, &weights[i].Weight3 };
+                if (writeUVIDx == 0)
+                    meshData->SetUV0(transformedUV.data(), size);
+                else if (writeUVIDx == 1)
+                    meshData->SetUV1(transformedUV.data(), size);
 
-                        for (UINT32 j = 0; j < 4; j++)
-                        {
-                            int boneIdx = mesh->BoneInfluences[i].Indices[j];
-                            if (boneIdx != -1)
-                            {
-                                AssimpImportNode* boneNode = mesh->Bones[boneIdx].Node;
+                writeUVIDx++;
+            }
+        }
 
-                                auto iterFind = boneMap.find(boneNode);
-                                if (iterFind != boneMap.end())
-                                    *indices[j] = iterFind->second;
-                                else
-                                    *indices[j] = -1;
-                            }
-                            else
-                            {
-                                *indices[j] = boneIdx;
-                            }
+        // Copy bone influences & remap bone indices
+        if (hasBoneInfluences)
+        {
+            UINT32 bufferSize = sizeof(BoneWeight) * (UINT32)numVertices;
+            Vector<BoneWeight> weights(numVertices);
+            for (UINT32 i = 0; i < (UINT32)numVertices; i++)
+            {
+                int* indices[] = { &weights[i].Index0, &weights[i].Index1, &weights[i].Index2, &weights[i].Index3 };
+                float* amounts[] = { &weights[i].Weight0, &weights[i].Weight1, &weights[i].Weight2, &weights[i].Weight3 };
 
-                            *amounts[j] = mesh->BoneInfluences[i].Weights[j];
-                        }
+                for (UINT32 j = 0; j < 4; j++)
+                {
+                    int boneIdx = mesh.BoneInfluences[i].Indices[j];
+                    if (boneIdx != -1)
+                    {
+                        AssimpImportNode* boneNode = mesh.Bones[boneIdx].Node;
+
+                        auto iterFind = boneMap.find(boneNode);
+                        if (iterFind != boneMap.end())
+                            *indices[j] = iterFind->second;
+                        else
+                            *indices[j] = -1;
+                    }
+                    else
+                    {
+                        *indices[j] = boneIdx;
                     }
 
-                    meshData->SetBoneWeights(weights, bufferSize);
-                    te_deallocate(weights);
+                    *amounts[j] = mesh.BoneInfluences[i].Weights[j];
                 }
-
-                allMeshData.push_back(meshData->GetData());
-                allSubMeshes.push_back(subMeshes);
             }
 
-            UINT32 numBones = (UINT32)mesh->Bones.size();
-            boneIndexOffset += numBones;
+            meshData->SetBoneWeights(weights.data(), bufferSize);
         }
 
-        if (allMeshData.size() > 1)
-        {
-            return RendererMeshData::Create(MeshData::Combine(allMeshData, allSubMeshes, outputSubMeshes));
-        }
-        else if (allMeshData.size() == 1)
-        {
-            outputSubMeshes = allSubMeshes[0];
-            return RendererMeshData::Create(allMeshData[0]);
-        }
-
-        return nullptr;
+        return meshData->GetData();
     }
 
     AssimpImportNode* ObjectImporter::CreateImportNode(const AssimpImportOptions& options, AssimpImportScene& scene, aiNode* assimpNode, AssimpImportNode* parent)
@@ -14,7 +14,7 @@ namespace te
     class Skeleton;
     struct AnimationSplitInfo;
 
-    class ObjectImporter : public BaseImporter
+    class TE_OBJECT_IMPORTER_EXPORT ObjectImporter : public BaseImporter
     {
     public:
         ObjectImporter();
@@ -32,11 +32,15 @@ namespace te
         /** @copydoc BaseImporter::CreateImportOptions */
         SPtr<ImportOptions> CreateImportOptions() const override;
 
-    private:
-        /** Reads the object file and outputs mesh data from the read file. Sub-mesh information will be output in @p subMeshes. */
+        /**
+         * Reads the object file and outputs mesh data from the read file. Sub-mesh information will be output in @p subMeshes.
+         * Only runs the CPU side of the import, no GPU resource is created.
+         */
         SPtr<RendererMeshData> ImportMeshData(const String& filePath, MeshImportOptions* importOptions, Vector<SubMesh>& subMeshes, 
             Vector<AssimpAnimationClipData>& animation, SPtr<Skeleton>& skeleton);
 
+    private:
+
         /**
          * Parses an FBX scene. Find all meshes in the scene and returns mesh data object containing all vertices, indexes
          * and other mesh information. Also outputs a sub-mesh array that allows you locate specific sub-meshes within the
@@ -44,9 +48,15 @@ namespace te
          */
         void ParseScene(aiScene* scene, const AssimpImportOptions& options, AssimpImportScene& outputScene);
 
-        /** Parses a mesh. Converts it from Assimp format into a mesh data object containing one or multiple sub-meshes. */
+        /** Parses a mesh. Registers it in the scene, or adds @p parentNode to its references if it is already registered. */
         void ParseMesh(aiMesh* mesh, AssimpImportNode* parentNode, const AssimpImportOptions& options, AssimpImportScene& outputScene);
 
+        /**
+         * Converts a registered mesh from Assimp format, and generates its tangents if the file doesn't provide them. Only
+         * writes to @p mesh, so meshes can be converted concurrently.
+         */
+        void ConvertMesh(AssimpImportMesh& mesh, const AssimpImportOptions& options);
+
         /**	Imports skinning information and bones for all meshes. */
         void ImportSkin(AssimpImportScene& scene, const AssimpImportOptions& options);
 
@@ -80,6 +90,34 @@ namespace te
         /** Converts the mesh data from the imported assimp scene into mesh data that can be used for initializing a mesh. */
         SPtr<RendererMeshData> GenerateMeshData(AssimpImportScene& scene, AssimpImportOptions& options, Vector<SubMesh>& subMeshes);
 
+        /**
+         * Converts the instance of @p mesh referenced by @p node into mesh data, with the node transform baked into the
+         * vertices. Doesn't modify anything, so instances can be converted concurrently.
+         */
+        SPtr<MeshData> GenerateMeshData(const AssimpImportMesh& mesh, const AssimpImportNode& node, UINT32 vertexLayout,
+            const UnorderedMap<AssimpImportNode*, UINT32>& boneMap);
+
+        /**
+         * Generates the lower levels of detail requested by the import options. The generated index ranges are appended
+         * to the index buffer, the returned mesh data replaces @p meshData, and @p lods receives the sub-meshes of each
+         * level. Returns @p meshData unchanged if no level of detail was generated.
+         */
+        SPtr<MeshData> GenerateLods(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes,
+            const MeshImportOptions* importOptions, Vector<MeshLod>& lods);
+
+        /**
+         * Reorders the triangles of every sub-mesh and level of detail for the vertex cache and overdraw, then reorders
+         * the vertices in the order the triangles use them. Mesh data is modified in place.
+         */
+        void OptimizeMeshData(const SPtr<MeshData>& meshData, const Vector<SubMesh>& subMeshes, const Vector<MeshLod>& lods,
+            const MeshImportOptions* importOptions);
+
+        /**
+         * Splits every triangle list sub-mesh and level of detail into meshlets. Triangles are reordered within their
+         * sub-mesh so each meshlet is a contiguous range of the index buffer. Must be done before vertices are compressed.
+         */
+        void GenerateMeshlets(const SPtr<MeshData>& meshData, Vector<SubMesh>& subMeshes, Vector<MeshLod>& lods);
+
         /**	Creates an internal representation of an assimp node from an aiNode object. */
         AssimpImportNode* CreateImportNode(const AssimpImportOptions& options, AssimpImportScene& scene, aiNode* assimpNode, AssimpImportNode* parent);
 
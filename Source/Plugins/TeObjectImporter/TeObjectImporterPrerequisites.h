@@ -2,6 +2,25 @@
 
 #include "Prerequisites/TePrerequisitesUtility.h"
 
+// DLL export, for the classes used outside of the plugin (e.g. by the benchmarks)
+#if TE_PLATFORM == TE_PLATFORM_WIN32 // Windows
+#  if TE_COMPILER == TE_COMPILER_MSVC
+#    if defined(TE_OBJECT_IMPORTER_EXPORTS)
+#      define TE_OBJECT_IMPORTER_EXPORT __declspec(dllexport)
+#    else
+#      define TE_OBJECT_IMPORTER_EXPORT __declspec(dllimport)
+#    endif
+#  else
+#    if defined(TE_OBJECT_IMPORTER_EXPORTS)
+#      define TE_OBJECT_IMPORTER_EXPORT __attribute__ ((dllexport))
+#    else
+#      define TE_OBJECT_IMPORTER_EXPORT __attribute__ ((dllimport))
+#    endif
+#  endif
+#else // Linux/Mac settings
+#  define TE_OBJECT_IMPORTER_EXPORT __attribute__ ((visibility ("default")))
+#endif
+
 namespace te
 {
     #define OBJECT_IMPORT_MAX_UV_LAYERS 2
@@ -12,6 +12,7 @@ set (TE_RENDERMAN_INC_NOFILTER
     "TeRenderManIBLUtility.h"
     "TeRendererTextures.h"
     "TeShadowRendering.h"
+    "TeGpuScene.h"
 )
 
 set (TE_RENDERERMAN_SRC_NOFILTER
@@ -27,6 +28,7 @@ set (TE_RENDERERMAN_SRC_NOFILTER
     "TeRenderManIBLUtility.cpp"
     "TeRendererTextures.cpp"
     "TeShadowRendering.cpp"
+    "TeGpuScene.cpp"
 )
 
 set (TE_RENDERMAN_INC_POSTPROCESSING
@@ -0,0 +1,192 @@
+#include "TeGpuScene.h"
+#include "TeRendererRenderable.h"
+#include "RenderAPI/TeGpuBuffer.h"
+#include "Utility/TeBitwise.h"
+#include "Mesh/TeMesh.h"
+
+namespace te
+{
+    namespace
+    {
+        /** Number of objects the buffer is first created with. */
+        constexpr UINT32 MIN_CAPACITY = 256;
+    }
+
+    GpuScene::GpuScene()
+    {
+        // Slot 0 is reserved, and never uploaded with anything else than identity transforms
+        _objects.push_back(GpuSceneObjectData());
+        memset(&_objects[0], 0, sizeof(GpuSceneObjectData));
+        _objects[0].MatWorld = Matrix4::IDENTITY;
+        _objects[0].MatInvWorld = Matrix4::IDENTITY;
+        _objects[0].MatWorldNoScale = Matrix4::IDENTITY;
+        _objects[0].MatInvWorldNoScale = Matrix4::IDENTITY;
+        _objects[0].MatPrevWorld = Matrix4::IDENTITY;
+        _dirty.push_back(false);
+    }
+
+    UINT32 GpuScene::Allocate()
+    {
+        if (!_freeSlots.empty())
+        {
+            UINT32 slot = _freeSlots.back();
+            _freeSlots.pop_back();
+
+            return slot;
+        }
+
+        _objects.push_back(_objects[NULL_SLOT]);
+        _dirty.push_back(false);
+
+        return (UINT32)_objects.size() - 1;
+    }
+
+    void GpuScene::Free(UINT32 slot)
+    {
+        if (slot == NULL_SLOT)
+            return;
+
+        _freeSlots.push_back(slot);
+    }
+
+    void GpuScene::Write(UINT32 slot, const RendererRenderable& renderable)
+    {
+        Renderable* renderablePtr = renderable.RenderablePtr;
+        GpuSceneObjectData& data = _objects[slot];
+
+        const Matrix4& tfrmNoScale = renderablePtr->GetMatrixNoScale();
+        const Sphere& bounds = renderablePtr->GetBounds().GetSphere();
+
+        data.MatWorld = renderable.WorldTfrm;
+        data.MatInvWorld = renderable.WorldTfrm.InverseAffine();
+        data.MatWorldNoScale = tfrmNoScale;
+        data.MatInvWorldNoScale = tfrmNoScale.InverseAffine();
+        data.MatPrevWorld = renderable.PrevWorldTfrm;
+        data.Layer = Bitwise::MostSignificantBit(renderablePtr->GetLayer());
+        data.HasAnimation = renderablePtr->IsAnimated() ? 1 : 0;
+        data.WriteVelocity = renderablePtr->GetWriteVelocity() ? 1 : 0;
+        data.CastLights = renderablePtr->GetCastLights() ? 1 : 0;
+        data.ReceiveShadows = renderablePtr->GetReceiveShadows() ? 1 : 0;
+        data.BoneOffset = renderablePtr->GetBoneMatrixOffset();
+        data.PrevBoneOffset = renderablePtr->GetBonePrevMatrixOffset();
+        data.Bounds = Vector4(bounds.GetCenter(), bounds.GetRadius());
+
+        SPtr<Mesh> mesh = renderablePtr->GetMesh();
+        if (mesh != nullptr && mesh->GetProperties().HasCompactVertices())
+        {
+            const MeshProperties& meshProps = mesh->GetProperties();
+            data.CompactVertices = 1;
+            data.PositionScale = Vector4(meshProps.GetPositionScale(), 0.0f);
+            data.PositionBias = Vector4(meshProps.GetPositionBias(), 0.0f);
+        }
+        else
+        {
+            data.CompactVertices = 0;
+            data.PositionScale = Vector4(Vector3::ONE, 0.0f);
+            data.PositionBias = Vector4::ZERO;
+        }
+
+        MarkDirty(slot);
+    }
+
+    void GpuScene::WriteBoneOffsets(UINT32 slot, const RendererRenderable& renderable)
+    {
+        GpuSceneObjectData& data = _objects[slot];
+        const UINT32 boneOffset = renderable.RenderablePtr->GetBoneMatrixOffset();
+        const UINT32 prevBoneOffset = renderable.RenderablePtr->GetBonePrevMatrixOffset();
+
+        if (data.BoneOffset == boneOffset && data.PrevBoneOffset == prevBoneOffset)
+            return;
+
+        data.BoneOffset = boneOffset;
+        data.PrevBoneOffset = prevBoneOffset;
+
+        MarkDirty(slot);
+    }
+
+    void GpuScene::Flush()
+    {
+        if ((UINT32)_objects.size() > _capacity)
+        {
+            // Every object is uploaded along with the new buffer
+            for (auto& slot : _dirtySlots)
+                _dirty[slot] = false;
+
+            _dirtySlots.clear();
+            Resize(std::max(MIN_CAPACITY, std::max(_capacity * 2, (UINT32)_objects.size())));
+        }
+
+        if (!_dirtySlots.empty())
+        {
+            std::sort(_dirtySlots.begin(), _dirtySlots.end());
+
+            // Clean objects between two close dirty ones are uploaded again rather than splitting the write in two
+            UINT32 rangeStart = _dirtySlots[0];
+            UINT32 rangeEnd = rangeStart + 1;
+
+            auto upload = [this](UINT32 start, UINT32 end)
+            {
+                const UINT32 size = (end - start) * sizeof(GpuSceneObjectData);
+                _buffer->WriteData(start * sizeof(GpuSceneObjectData), size, &_objects[start]);
+
+                _stats.NumUploads++;
+                _stats.UploadedBytes += size;
+            };
+
+            for (UINT32 i = 1; i < (UINT32)_dirtySlots.size(); i++)
+            {
+                const UINT32 slot = _dirtySlots[i];
+                if (slot > rangeEnd + MAX_RANGE_GAP)
+                {
+                    upload(rangeStart, rangeEnd);
+                    rangeStart = slot;
+                }
+
+                rangeEnd = slot + 1;
+            }
+
+            upload(rangeStart, rangeEnd);
+
+            for (auto& slot : _dirtySlots)
+                _dirty[slot] = false;
+
+            _dirtySlots.clear();
+        }
+
+        _lastStats = _stats;
+        _stats = GpuSceneStats();
+    }
+
+    void GpuScene::MarkDirty(UINT32 slot)
+    {
+        _stats.NumObjectWrites++;
+
+        if (_dirty[slot])
+            return;
+
+        _dirty[slot] = true;
+        _dirtySlots.push_back(slot);
+    }
+
+    void GpuScene::Resize(UINT32 capacity)
+    {
+        _capacity = capacity;
+
+        GPU_BUFFER_DESC desc;
+        desc.Type = GBT_STRUCTURED;
+        desc.ElementCount = _capacity;
+        desc.ElementSize = sizeof(GpuSceneObjectData);
+        desc.Format = BF_UNKNOWN;
+        desc.Usage = GBU_STATIC;
+        desc.DebugName = "GPU Scene Objects";
+
+        _buffer = GpuBuffer::Create(desc);
+        _version++;
+
+        const UINT32 size = (UINT32)_objects.size() * sizeof(GpuSceneObjectData);
+        _buffer->WriteData(0, size, _objects.data());
+
+        _stats.NumUploads++;
+        _stats.UploadedBytes += size;
+    }
+}
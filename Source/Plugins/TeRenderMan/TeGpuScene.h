@@ -0,0 +1,113 @@
+#pragma once
+
+#include "TeRenderManPrerequisites.h"
+#include "Math/TeVector4.h"
+
+namespace te
+{
+    /** Per-object data of a renderable as stored in the GPU scene. Must match ObjectData in GpuScene.hlsli. */
+    struct GpuSceneObjectData
+    {
+        Matrix4 MatWorld;
+        Matrix4 MatInvWorld;
+        Matrix4 MatWorldNoScale;
+        Matrix4 MatInvWorldNoScale;
+        Matrix4 MatPrevWorld;
+        UINT32  Layer;
+        UINT32  HasAnimation;
+        UINT32  WriteVelocity;
+        UINT32  CastLights;
+        UINT32  ReceiveShadows;
+        UINT32  BoneOffset;
+        UINT32  PrevBoneOffset;
+        UINT32  CompactVertices;
+        Vector4 PositionScale;
+        Vector4 PositionBias;
+        /** World space bounding sphere, center in xyz and radius in w. */
+        Vector4 Bounds;
+    };
+
+    /** Amount of per-object data sent to the GPU scene buffer during a frame. */
+    struct GpuSceneStats
+    {
+        /** Number of times the data of an object was written on the CPU side. */
+        UINT32 NumObjectWrites = 0;
+        /** Number of ranges uploaded to the GPU, each one a separate write to the buffer. */
+        UINT32 NumUploads = 0;
+        /** Number of bytes uploaded to the GPU. */
+        UINT32 UploadedBytes = 0;
+    };
+
+    /**
+     * Keeps the per-object data of every renderable of the scene in a single persistent structured buffer, instead of a
+     * constant buffer per renderable re-uploaded whole each time it changes. Draws only have to know the index of their
+     * object in it, and objects that don't change cost nothing from one frame to the next.
+     *
+     * Writes go to a copy of the buffer in system memory and only mark the object as dirty. Flush() then uploads the
+     * dirty objects once per frame, neighbouring ones being merged into a single range.
+     *
+     * Slot 0 is never given to an object: a zeroed per-object buffer refers to it, meaning the object isn't part of the
+     * GPU scene.
+     */
+    class GpuScene
+    {
+    public:
+        /** Slot of objects that aren't part of the GPU scene. */
+        static constexpr UINT32 NULL_SLOT = 0;
+
+        /** Number of clean objects between two dirty ones under which both are uploaded by a single write. */
+        static constexpr UINT32 MAX_RANGE_GAP = 4;
+
+        GpuScene();
+        ~GpuScene() = default;
+
+        /** Reserves a slot for a new object. Its data is undefined until it is written. */
+        UINT32 Allocate();
+
+        /** Makes @p slot available to new objects. */
+        void Free(UINT32 slot);
+
+        /** Writes all the per-object data of @p renderable to @p slot. */
+        void Write(UINT32 slot, const RendererRenderable& renderable);
+
+        /** Writes the bone matrix offsets of @p renderable to @p slot, which change every frame for skinned renderables. */
+        void WriteBoneOffsets(UINT32 slot, const RendererRenderable& renderable);
+
+        /**
+         * Uploads the objects written since the last call, growing the buffer beforehand if objects were allocated past
+         * its end. To be called once per frame, after all objects were updated and before anything is drawn.
+         */
+        void Flush();
+
+        /** Returns the buffer containing the objects, null until the first call to Flush(). */
+        const SPtr<GpuBuffer>& GetBuffer() const { return _buffer; }
+
+        /**
+         * Returns a value that changes whenever the buffer is re-created. Programs the buffer was bound to with an older
+         * version don't see the current objects anymore.
+         */
+        UINT32 GetVersion() const { return _version; }
+
+        /** Returns the amount of data uploaded by the last call to Flush(). */
+        const GpuSceneStats& GetStats() const { return _lastStats; }
+
+    private:
+        /** Flags @p slot for upload by the next Flush(). */
+        void MarkDirty(UINT32 slot);
+
+        /** Re-creates the buffer with room for @p capacity objects, and uploads all of them. */
+        void Resize(UINT32 capacity);
+
+        Vector<GpuSceneObjectData> _objects;
+        Vector<UINT32> _freeSlots;
+        Vector<UINT32> _dirtySlots;
+        Vector<bool> _dirty;
+
+        SPtr<GpuBuffer> _buffer;
+        UINT32 _capacity = 0;
+        UINT32 _version = 0;
+
+        GpuSceneStats _stats;
+        GpuSceneStats _lastStats;
+    };
+}
@@ -43,6 +43,44 @@ namespace te
 
     IMPLEMENT_GLOBAL_POOL(ZPrepassElem, 32)
 
+    /** Parameter blocks assigned before each draw of the forward passes, found once per pipeline. */
+    struct ForwardParamBlocks
+    {
+        WPtr<GpuPipelineParamInfo> ParamInfo;
+        GpuParams::ParamBlockHandle PerLights;
+        GpuParams::ParamBlockHandle PerCamera;
+        GpuParams::ParamBlockHandle PerFrame;
+    };
+
+    /** Returns the handles of the parameter blocks assigned before each draw, for the pipeline of @p params. */
+    const ForwardParamBlocks& GetForwardParamBlocks(const GpuParams& params)
+    {
+        static UnorderedMap<const GpuPipelineParamInfo*, ForwardParamBlocks> pipelineParamBlocks;
+
+        const SPtr<GpuPipelineParamInfo>& paramInfo = params.GetParamInfo();
+        ForwardParamBlocks& paramBlocks = pipelineParamBlocks[paramInfo.get()];
+
+        // A new pipeline info might have been allocated where a destroyed one used to be
+        if (paramBlocks.ParamInfo.lock() != paramInfo)
+        {
+            paramBlocks.ParamInfo = paramInfo;
+            paramBlocks.PerLights = params.GetParamBlockHandle("PerLightsBuffer");
+            paramBlocks.PerCamera = params.GetParamBlockHandle("PerCameraBuffer");
+            paramBlocks.PerFrame = params.GetParamBlockHandle("PerFrameBuffer");
+
+            // Forget the pipelines that don't exist anymore
+            for (auto it = pipelineParamBlocks.begin(); it != pipelineParamBlocks.end();)
+            {
+                if (it->second.ParamInfo.expired())
+                    it = pipelineParamBlocks.erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        return paramBlocks;
+    }
+
     /** Renders all elements for the Z Prepass. */
     UINT32 RenderQueueElementsForZPrepass(const Vector<RenderQueueElement>& elements, const RendererView& view, const SceneInfo& scene, const RendererViewGroup& viewGroup)
     {
@@ -99,7 +137,8 @@ namespace te
             rapi.SetGraphicsPipeline(pass->GetGraphicsPipelineState());
             rapi.SetStencilRef(pass->GetStencilRefValue());
 
-            (*zPrepassElem->GpuParamsElem)->SetParamBlockBuffer("PerCameraBuffer", view.GetPerViewBuffer());
+            const SPtr<GpuParams>& gpuParams = *zPrepassElem->GpuParamsElem;
+            gpuParams->SetParamBlockBuffer(GetForwardParamBlocks(*gpuParams).PerCamera, view.GetPerViewBuffer());
 
             if (zPrepassElem->InstanceCount > 0)
             {
@@ -111,6 +150,10 @@ namespace te
                 rapi.SetGpuParams((*zPrepassElem->GpuParamsElem), GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, ObjectBuffer);
             }
 
+            // Per-object data is only reachable through the GPU scene buffer
+            if (scene.GpuSceneElem)
+                rapi.SetGpuParams((*zPrepassElem->GpuParamsElem), GPU_BIND_BUFFER);
+
             gRendererUtility().Draw((*zPrepassElem->MeshElem), *zPrepassElem->SubMeshElem, zPrepassElem->InstanceCount);
             rapi.PopMarker();
 
@@ -210,25 +253,25 @@ namespace te
                 gpuParamsBindFlags = GPU_BIND_ALL;
                 lastMaterial = entry.RenderElem->MaterialElem;
 
-                entry.RenderElem->GpuParamsElem[entry.PassIdx]
-                    ->SetParamBlockBuffer("PerLightsBuffer", gPerLightsParamBuffer);
+                const SPtr<GpuParams>& gpuParams = entry.RenderElem->GpuParamsElem[entry.PassIdx];
+                const ForwardParamBlocks& paramBlocks = GetForwardParamBlocks(*gpuParams);
+
+                gpuParams->SetParamBlockBuffer(paramBlocks.PerLights, gPerLightsParamBuffer);
 
-                rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
+                rapi.SetGpuParams(gpuParams,
                     GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, PerLightBuffer);
 
-                entry.RenderElem->GpuParamsElem[entry.PassIdx]
-                    ->SetParamBlockBuffer("PerCameraBuffer", view.GetPerViewBuffer());
+                gpuParams->SetParamBlockBuffer(paramBlocks.PerCamera, view.GetPerViewBuffer());
 
-                rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
-                     GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, PerCameraBuffer);
+                rapi.SetGpuParams(gpuParams,
+                    GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, PerCameraBuffer);
 
-                entry.RenderElem->GpuParamsElem[entry.PassIdx]
-                    ->SetParamBlockBuffer("PerFrameBuffer", scene.PerFrameParamBuffer);
+                gpuParams->SetParamBlockBuffer(paramBlocks.PerFrame, scene.PerFrameParamBuffer);
 
-                rapi.SetGpuParams(entry.RenderElem->GpuParamsElem[entry.PassIdx],
+                rapi.SetGpuParams(gpuParams,
                     GPU_BIND_PARAM_BLOCK, GPU_BIND_PARAM_BLOCK_LISTED, PerFrameBuffer);
 
-                entry.RenderElem->MaterialElem->SetGpuParam(entry.RenderElem->GpuParamsElem[entry.PassIdx]);
+                entry.RenderElem->MaterialElem->SetGpuParam(gpuParams);
             }
             else
             {
@@ -363,6 +406,86 @@ namespace te
 
         if (!_isValid)
             Clear();
+
+        _transientsDirty = true;
+    }
+
+    void RenderCompositor::PlanTransients(const RendererView& view) const
+    {
+        for (auto& nodeInfo : _nodeInfos)
+        {
+            Vector<RenderCompositorTransient> transients = nodeInfo.Type->GetTransients(view);
+            if (transients != nodeInfo.Transients)
+            {
+                nodeInfo.Transients = std::move(transients);
+                _transientsDirty = true;
+            }
+        }
+
+        if (!_transientsDirty)
+            return;
+
+        _transientSlots.clear();
+        _transientStats = RenderCompositorTransientStats();
+
+        for (auto& nodeInfo : _nodeInfos)
+        {
+            nodeInfo.TransientSlots.clear();
+            nodeInfo.ReleasedSlots.clear();
+        }
+
+        const UINT32 numNodes = (UINT32)_nodeInfos.size();
+        Vector<UINT64> usedMemory(numNodes, 0);
+
+        for (UINT32 i = 0; i < numNodes; i++)
+        {
+            const NodeInfo& nodeInfo = _nodeInfos[i];
+
+            // The final node has no dependant, it is only cleared once every node has rendered
+            const UINT32 nodeLastUseIdx = nodeInfo.LastUseIdx == (UINT32)-1 ? numNodes - 1 : nodeInfo.LastUseIdx;
+
+            for (auto& transient : nodeInfo.Transients)
+            {
+                const UINT32 lastUseIdx = transient.Scratch ? i : nodeLastUseIdx;
+
+                // Nodes are visited in execution order, so any slot of the same kind released before this node is
+                // free. Taking the first one keeps the number of slots to the highest number of overlapping lifetimes.
+                UINT32 slotIdx = 0;
+                for (; slotIdx < (UINT32)_transientSlots.size(); slotIdx++)
+                {
+                    const TransientSlot& slot = _transientSlots[slotIdx];
+                    if (slot.LastUseIdx < i && slot.Desc == transient.Desc)
+                        break;
+                }
+
+                if (slotIdx == (UINT32)_transientSlots.size())
+                {
+                    _transientSlots.push_back(TransientSlot());
+                    _transientSlots.back().Desc = transient.Desc;
+                    _transientStats.AllocatedMemory += transient.Desc.GetMemorySize();
+                }
+
+                _transientSlots[slotIdx].LastUseIdx = lastUseIdx;
+                nodeInfo.TransientSlots.push_back(slotIdx);
+
+                const UINT64 memorySize = transient.Desc.GetMemorySize();
+                for (UINT32 j = i; j <= lastUseIdx; j++)
+                    usedMemory[j] += memorySize;
+
+                _transientStats.NumDeclared++;
+                _transientStats.DeclaredMemory += memorySize;
+            }
+        }
+
+        // A slot keeps its texture from its first lifetime to its last one, the other nodes never get it in between
+        for (UINT32 i = 0; i < (UINT32)_transientSlots.size(); i++)
+            _nodeInfos[_transientSlots[i].LastUseIdx].ReleasedSlots.push_back(i);
+
+        _transientStats.NumAllocated = (UINT32)_transientSlots.size();
+        for (auto& memory : usedMemory)
+            _transientStats.PeakMemory = std::max(_transientStats.PeakMemory, memory);
+
+        _transientsDirty = false;
     }
 
     void RenderCompositor::Execute(RenderCompositorNodeInputs& inputs) const
@@ -370,6 +493,8 @@ namespace te
         if (!_isValid)
             return;
 
+        PlanTransients(inputs.View);
+
         te_frame_mark();
         {
             FrameVector<const NodeInfo*> activeNodes;
@@ -377,7 +502,19 @@ namespace te
             UINT32 idx = 0;
             for (auto& entry : _nodeInfos)
             {
+                // A slot takes its texture from the pool at the start of its first lifetime, and hands the same
+                // texture to every transient texture aliased into it
                 inputs.InputNodes = entry.Inputs;
+                inputs.TransientTextures.clear();
+                for (auto& slotIdx : entry.TransientSlots)
+                {
+                    TransientSlot& slot = _transientSlots[slotIdx];
+                    if (!slot.Texture)
+                        slot.Texture = gGpuResourcePool().Get(slot.Desc);
+
+                    inputs.TransientTextures.push_back(slot.Texture);
+                }
+
                 entry.Node->Render(inputs);
 
                 activeNodes.push_back(&entry);
@@ -394,6 +531,10 @@ namespace te
                     }
                 }
 
+                // Slots past their last lifetime give their texture back to the pool, for other views to pick up
+                for (auto& slotIdx : entry.ReleasedSlots)
+                    _transientSlots[slotIdx].Texture = nullptr;
+
                 idx++;
             }
         }
@@ -401,11 +542,15 @@ namespace te
 
         if (!_nodeInfos.empty())
             _nodeInfos.back().Node->Clear();
+
+        inputs.TransientTextures.clear();
     }
 
     void RenderCompositor::Clear()
     {
         _nodeInfos.clear();
+        _transientSlots.clear();
+        _transientStats = RenderCompositorTransientStats();
         _isValid = false;
     }
 
@@ -413,31 +558,15 @@ namespace te
 
     void RCNodeGpuInitializationPass::Render(const RenderCompositorNodeInputs& inputs)
     {
-        // Allocate necessary textures & targets
-        GpuResourcePool& resPool = gGpuResourcePool();
-        const RendererViewProperties& viewProps = inputs.View.GetProperties();
-
-        const UINT32 width = viewProps.Target.ViewRect.width;
-        const UINT32 height = viewProps.Target.ViewRect.height;
-        const UINT32 numSamples = viewProps.Target.NumSamples;
-
         bool needsVelocity = inputs.View.RequiresVelocityWrites();
 
-        // Note: Consider customizable formats. e.g. for testing if quality can be improved with higher precision normals.
-        SceneTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET,
-            numSamples, false));
-        NormalTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height, TU_RENDERTARGET,
-            numSamples, false));
-        EmissiveTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height, TU_RENDERTARGET,
-            numSamples, false));
+        // Textures are allocated by the compositor, in the order of GetTransients()
+        SceneTex = inputs.TransientTextures[0];
+        NormalTex = inputs.TransientTextures[1];
+        EmissiveTex = inputs.TransientTextures[2];
+        DepthTex = inputs.TransientTextures[3];
         if (needsVelocity)
-        {
-            VelocityTex = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RG16S, width, height, TU_RENDERTARGET,
-                numSamples, false));
-        }
-
-        DepthTex = gGpuResourcePool().Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL,
-            numSamples, false));
+            VelocityTex = inputs.TransientTextures[4];
 
         bool rebuildRT = false;
         if (RenderTargetTex)
@@ -526,6 +655,31 @@ namespace te
         return { };
     }
 
+    Vector<RenderCompositorTransient> RCNodeGpuInitializationPass::GetTransients(const RendererView& view)
+    {
+        const RendererViewProperties& viewProps = view.GetProperties();
+
+        const UINT32 width = viewProps.Target.ViewRect.width;
+        const UINT32 height = viewProps.Target.ViewRect.height;
+        const UINT32 numSamples = viewProps.Target.NumSamples;
+
+        // Note: Consider customizable formats. e.g. for testing if quality can be improved with higher precision normals.
+        Vector<RenderCompositorTransient> transients = {
+            { POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET, numSamples, false) },
+            { POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height, TU_RENDERTARGET, numSamples, false) },
+            { POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA8, width, height, TU_RENDERTARGET, numSamples, false) },
+            { POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL, numSamples, false) }
+        };
+
+        if (view.RequiresVelocityWrites())
+        {
+            transients.push_back(
+                { POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RG16S, width, height, TU_RENDERTARGET, numSamples, false) });
+        }
+
+        return transients;
+    }
+
     void RCNodeZPrePass::Render(const RenderCompositorNodeInputs& inputs)
     {
         RenderQueue* opaqueElements = inputs.View.GetOpaqueQueue().get();
@@ -676,25 +830,10 @@ namespace te
 
         inputs.CurrRenderAPI.PushMarker("[DRAW] Half Scene Tex", Color(0.74f, 0.21f, 0.32f));
 
-        SPtr<Texture> input = gpuInitializationPassNode->SceneTex->Tex;
         TextureDownsampleMat* downsampleMat = TextureDownsampleMat::Get();
-        const TextureProperties& rtProps = input->GetProperties();
-
-        SceneTex = gGpuResourcePool().Get(
-            POOLED_RENDER_TEXTURE_DESC::Create2D(
-                rtProps.GetFormat(), 
-                rtProps.GetWidth() / 2, 
-                rtProps.GetHeight() / 2, 
-                TU_RENDERTARGET)
-        );
-
-        EmissiveTex = gGpuResourcePool().Get(
-            POOLED_RENDER_TEXTURE_DESC::Create2D(
-                rtProps.GetFormat(),
-                rtProps.GetWidth() / 2,
-                rtProps.GetHeight() / 2,
-                TU_RENDERTARGET)
-        );
+
+        SceneTex = inputs.TransientTextures[0];
+        EmissiveTex = inputs.TransientTextures[1];
 
         downsampleMat->Execute(gpuInitializationPassNode->SceneTex->Tex, 0, SceneTex->RenderTex);
         downsampleMat->Execute(gpuInitializationPassNode->EmissiveTex->Tex, 0, EmissiveTex->RenderTex);
@@ -717,6 +856,16 @@ namespace te
         };
     }
 
+    Vector<RenderCompositorTransient> RCNodeHalfSceneTex::GetTransients(const RendererView& view)
+    {
+        // Same format as the scene color texture of the GPU initialization pass
+        const RendererViewProperties& viewProps = view.GetProperties();
+        POOLED_RENDER_TEXTURE_DESC desc = POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F,
+            viewProps.Target.ViewRect.width / 2, viewProps.Target.ViewRect.height / 2, TU_RENDERTARGET);
+
+        return { { desc }, { desc } };
+    }
+
     constexpr UINT32 RCNodeSceneTexDownsamples::MAX_NUM_DOWNSAMPLES;
 
     void RCNodeSceneTexDownsamples::Render(const RenderCompositorNodeInputs& inputs)
@@ -727,33 +876,20 @@ namespace te
 
         inputs.CurrRenderAPI.PushMarker("[DRAW] Scene Tex Down Samples", Color(0.44f, 0.71f, 0.52f));
 
-        auto DownSample = [this](
+        AvailableDownsamples = GetNumDownsamples(inputs.View);
+
+        // Textures are allocated by the compositor, the scene color chain first, then the emissive one
+        UINT32 transientIdx = 0;
+        auto DownSample = [this, &inputs, &transientIdx](
             SPtr<PooledRenderTexture> renderTex,
             SPtr<PooledRenderTexture>* output)
         {
-            const TextureProperties& props = renderTex->Tex->GetProperties();
-            const UINT32 totalDownsampleLevels = PixelUtil::GetMaxMipmaps(
-                props.GetWidth(),
-                props.GetHeight(),
-                1) + 1;
-
-            AvailableDownsamples = Math::Min(MAX_NUM_DOWNSAMPLES, totalDownsampleLevels);
             output[0] = renderTex;
 
             TextureDownsampleMat* downsampleMat = TextureDownsampleMat::Get();
             for (UINT32 i = 1; i < AvailableDownsamples; i++)
             {
-                const TextureProperties& rtProps = output[i - 1]->Tex->GetProperties();
-
-                output[i] = gGpuResourcePool().Get(
-                    POOLED_RENDER_TEXTURE_DESC::Create2D(
-                        rtProps.GetFormat(),
-                        rtProps.GetWidth() / 2,
-                        rtProps.GetHeight() / 2,
-                        TU_RENDERTARGET
-                    )
-                );
-
+                output[i] = inputs.TransientTextures[transientIdx++];
                 downsampleMat->Execute(output[i - 1]->Tex, 0, output[i]->RenderTex);
             }
         };
@@ -785,6 +921,39 @@ namespace te
         };
     }
 
+    Vector<RenderCompositorTransient> RCNodeSceneTexDownsamples::GetTransients(const RendererView& view)
+    {
+        // Each level halves the previous one, starting from the half resolution textures of RCNodeHalfSceneTex
+        const RendererViewProperties& viewProps = view.GetProperties();
+        const UINT32 numDownsamples = GetNumDownsamples(view);
+
+        Vector<RenderCompositorTransient> sceneTransients;
+        UINT32 width = viewProps.Target.ViewRect.width / 2;
+        UINT32 height = viewProps.Target.ViewRect.height / 2;
+        for (UINT32 i = 1; i < numDownsamples; i++)
+        {
+            width /= 2;
+            height /= 2;
+            sceneTransients.push_back({ POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET) });
+        }
+
+        Vector<RenderCompositorTransient> transients = sceneTransients;
+        transients.insert(transients.end(), sceneTransients.begin(), sceneTransients.end());
+
+        return transients;
+    }
+
+    UINT32 RCNodeSceneTexDownsamples::GetNumDownsamples(const RendererView& view)
+    {
+        const RendererViewProperties& viewProps = view.GetProperties();
+        const UINT32 totalDownsampleLevels = PixelUtil::GetMaxMipmaps(
+            viewProps.Target.ViewRect.width / 2,
+            viewProps.Target.ViewRect.height / 2,
+            1) + 1;
+
+        return Math::Min(MAX_NUM_DOWNSAMPLES, totalDownsampleLevels);
+    }
+
     void RCNodeResolvedSceneDepth::Render(const RenderCompositorNodeInputs& inputs)
     {
         inputs.CurrRenderAPI.PushMarker("[DRAW] Resolve Scene Depth", Color(0.2f, 0.2f, 0.8f));
@@ -794,11 +963,7 @@ namespace te
 
         if (viewProps.Target.NumSamples > 1)
         {
-            UINT32 width = viewProps.Target.ViewRect.width;
-            UINT32 height = viewProps.Target.ViewRect.height;
-
-            Output = gGpuResourcePool().Get(
-                POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32_S8X24, width, height, TU_DEPTHSTENCIL, 1, false));
+            Output = inputs.TransientTextures[0];
 
             inputs.CurrRenderAPI.SetRenderTarget(Output->RenderTex);
             inputs.CurrRenderAPI.ClearRenderTarget(FBT_STENCIL);
@@ -826,19 +991,26 @@ namespace te
         };
     }
 
+    Vector<RenderCompositorTransient> RCNodeResolvedSceneDepth::GetTransients(const RendererView& view)
+    {
+        // Without MSAA the depth buffer of the GPU initialization pass is used as is
+        const RendererViewProperties& viewProps = view.GetProperties();
+        if (viewProps.Target.NumSamples <= 1)
+            return { };
+
+        return { { POOLED_RENDER_TEXTURE_DESC::Create2D(PF_D32_S8X24, viewProps.Target.ViewRect.width,
+            viewProps.Target.ViewRect.height, TU_DEPTHSTENCIL, 1, false) } };
+    }
+
     // ############# POST PROCESS
 
     void RCNodePostProcess::GetAndSwitch(const RendererView& view, SPtr<RenderTexture>& output, SPtr<Texture>& lastFrame) const
     {
-        const RendererViewProperties& viewProps = view.GetProperties();
-        UINT32 width = viewProps.Target.ViewRect.width;
-        UINT32 height = viewProps.Target.ViewRect.height;
-        UINT32 samples = viewProps.Target.NumSamples;
-
+        // An output only holds a last frame once it has been rendered to
         if (!_output[_currentIdx])
         {
-            _output[_currentIdx] = gGpuResourcePool().Get(
-                POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET, samples, false));
+            assert(_textures[_currentIdx] && "Effect not accounted for by RCNodePostProcess::GetTransients()");
+            _output[_currentIdx] = _textures[_currentIdx];
         }
 
         output = _output[_currentIdx]->RenderTex;
@@ -860,10 +1032,15 @@ namespace te
     }
 
     void RCNodePostProcess::Render(const RenderCompositorNodeInputs& inputs)
-    { }
+    {
+        for (UINT32 i = 0; i < 2; i++)
+            _textures[i] = i < (UINT32)inputs.TransientTextures.size() ? inputs.TransientTextures[i] : nullptr;
+    }
 
     void RCNodePostProcess::Clear()
     {
+        _textures[0] = nullptr;
+        _textures[1] = nullptr;
         _output[0] = nullptr;
         _output[1] = nullptr;
         _currentIdx = 0;
@@ -874,6 +1051,29 @@ namespace te
         return { RCNodeForwardTransparentPass::GetNodeId() };
     }
 
+    Vector<RenderCompositorTransient> RCNodePostProcess::GetTransients(const RendererView& view)
+    {
+        // Effects are only rendered along with the rest of the post processing chain, see RCNodeFinalResolve
+        const RendererViewProperties& viewProps = view.GetProperties();
+        if (!viewProps.RunPostProcessing || viewProps.Target.NumSamples != 1)
+            return { };
+
+        // Effects rendering through GetAndSwitch(). Some of them can still skip a frame, this is only an upper bound
+        const RenderSettings& settings = view.GetRenderSettings();
+        const UINT32 numEffects = (settings.EnableHDR ? 1 : 0) + (settings.MotionBlur.Enabled ? 1 : 0) +
+            (settings.AntialiasingAglorithm == AntiAliasingAlgorithm::FXAA ? 1 : 0) + (settings.Bloom.Enabled ? 1 : 0);
+
+        POOLED_RENDER_TEXTURE_DESC desc = POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, viewProps.Target.ViewRect.width,
+            viewProps.Target.ViewRect.height, TU_RENDERTARGET, viewProps.Target.NumSamples, false);
+
+        // Effects read the output of the previous one and render to the other texture, a single effect only needs one
+        Vector<RenderCompositorTransient> transients;
+        for (UINT32 i = 0; i < std::min(numEffects, 2U); i++)
+            transients.push_back({ desc });
+
+        return transients;
+    }
+
     // ############# TONE MAPPING
 
     void RCNodeTonemapping::Render(const RenderCompositorNodeInputs& inputs)
@@ -1250,9 +1450,7 @@ namespace te
                 downAOTex1 = nullptr;
         }*/
 
-        UINT32 width = viewProps.Target.ViewRect.width;
-        UINT32 height = viewProps.Target.ViewRect.height;
-        Output = resPool.Get(POOLED_RENDER_TEXTURE_DESC::Create2D(PF_R8, width, height, TU_RENDERTARGET));
+        Output = inputs.TransientTextures[0];
 
         {
             if (setupTex0)
@@ -1280,11 +1478,7 @@ namespace te
         // each frame, and averaging them out should yield blurred AO.
         if (quality > AmbientOcclusionQuality::Low) // On level 0 we don't blur at all, on level 1 we use the ad-hoc blur in shader
         {
-            const RenderTargetProperties& rtProps = Output->RenderTex->GetProperties();
-
-            POOLED_RENDER_TEXTURE_DESC desc = POOLED_RENDER_TEXTURE_DESC::Create2D(PF_R8, rtProps.Width,
-                rtProps.Height, TU_RENDERTARGET);
-            SPtr<PooledRenderTexture> blurIntermediateTex = resPool.Get(desc);
+            SPtr<PooledRenderTexture> blurIntermediateTex = inputs.TransientTextures[1];
 
             SSAOBlurMat* ssaoBlurMat = SSAOBlurMat::Get();
 
@@ -1314,11 +1508,32 @@ namespace te
         return deps;
     }
 
+    Vector<RenderCompositorTransient> RCNodeSSAO::GetTransients(const RendererView& view)
+    {
+        const AmbientOcclusionSettings& settings = view.GetRenderSettings().AmbientOcclusion;
+        if (!settings.Enabled)
+            return { };
+
+        const RendererViewProperties& viewProps = view.GetProperties();
+        POOLED_RENDER_TEXTURE_DESC desc = POOLED_RENDER_TEXTURE_DESC::Create2D(PF_R8, viewProps.Target.ViewRect.width,
+            viewProps.Target.ViewRect.height, TU_RENDERTARGET);
+
+        Vector<RenderCompositorTransient> transients = { { desc } };
+
+        // Intermediate target of the separable blur, only used while the node renders
+        if (settings.Quality > AmbientOcclusionQuality::Low)
+            transients.push_back({ desc, true });
+
+        return transients;
+    }
+
     // ############# BLOOM
 
+    /** Level of the emissive down sample chain blurred by bloom, per quality. Lower qualities blur smaller textures. */
+    static constexpr UINT32 OUTPUT_DOWN_SAMPLE_LEVEL_PER_QUALITY[] = { 4, 3, 2, 1 };
+
     void RCNodeBloom::Render(const RenderCompositorNodeInputs& inputs)
     {
-        const RendererViewProperties& viewProps = inputs.View.GetProperties();
         const RenderSettings& settings = inputs.View.GetRenderSettings();
         if (!settings.Bloom.Enabled)
             return;
@@ -1333,7 +1548,6 @@ namespace te
         RCNodeSceneTexDownsamples* sceneColorDownSampleNode = static_cast<RCNodeSceneTexDownsamples*>(inputs.InputNodes[2]);
 
         constexpr UINT32 NUM_STEPS_PER_QUALITY[] = { 1, 1, 2, 3 };
-        constexpr UINT32 OUTPUT_DOWN_SAMPLE_LEVEL_PER_QUALITY[] = { 4, 3, 2, 1 };
 
         // ### First, we get emissive texture from forward pass, use it as input for our GaussianBlur material
         // ### and create a new tex representing the blured result
@@ -1348,26 +1562,9 @@ namespace te
 
         SPtr<PooledRenderTexture> emissiveTex = sceneColorDownSampleNode->EmissiveTex[numDownsamples - 1];
 
-        const TextureProperties& inputProps = emissiveTex->Tex->GetProperties();
-        SPtr<PooledRenderTexture> tmpBlurOutput = gGpuResourcePool().Get(
-            POOLED_RENDER_TEXTURE_DESC::Create2D(
-                inputProps.GetFormat(),
-                inputProps.GetWidth(),
-                inputProps.GetHeight(),
-                TU_RENDERTARGET,
-                viewProps.Target.NumSamples
-            )
-        );
-
-        SPtr<PooledRenderTexture> blurOutput = gGpuResourcePool().Get(
-            POOLED_RENDER_TEXTURE_DESC::Create2D(
-                inputProps.GetFormat(),
-                inputProps.GetWidth(),
-                inputProps.GetHeight(),
-                TU_RENDERTARGET,
-                viewProps.Target.NumSamples
-            )
-        );
+        // Textures are allocated by the compositor, in the order of GetTransients()
+        SPtr<PooledRenderTexture> tmpBlurOutput = inputs.TransientTextures[0];
+        SPtr<PooledRenderTexture> blurOutput = inputs.TransientTextures[1];
 
         GaussianBlurMat* gaussianBlur = GaussianBlurMat::GetVariation(emissiveTex->Tex->GetProperties().GetNumSamples());
 
@@ -1414,6 +1611,32 @@ namespace te
         return deps;
     }
 
+    Vector<RenderCompositorTransient> RCNodeBloom::GetTransients(const RendererView& view)
+    {
+        const RenderSettings& settings = view.GetRenderSettings();
+        if (!settings.Bloom.Enabled)
+            return { };
+
+        // Blur targets have the size of the emissive down sample picked by Render(), they are only used while it runs
+        const UINT32 quality = Math::Clamp((UINT32)settings.Bloom.Quality, 0U, 3U);
+        const UINT32 numDownsamples = Math::Min(RCNodeSceneTexDownsamples::GetNumDownsamples(view),
+            OUTPUT_DOWN_SAMPLE_LEVEL_PER_QUALITY[quality]);
+
+        const RendererViewProperties& viewProps = view.GetProperties();
+        UINT32 width = viewProps.Target.ViewRect.width / 2;
+        UINT32 height = viewProps.Target.ViewRect.height / 2;
+        for (UINT32 i = 1; i < numDownsamples; i++)
+        {
+            width /= 2;
+            height /= 2;
+        }
+
+        POOLED_RENDER_TEXTURE_DESC desc = POOLED_RENDER_TEXTURE_DESC::Create2D(PF_RGBA16F, width, height, TU_RENDERTARGET,
+            viewProps.Target.NumSamples);
+
+        return { { desc, true }, { desc, true } };
+    }
+
     // ############# FINAL RENDER
 
     void RCNodeFinalResolve::Render(const RenderCompositorNodeInputs& inputs)
@@ -11,6 +11,35 @@ namespace te
     struct FrameInfo;
     class Renderer;
 
+    /**
+     * Render texture a node needs for a single frame, declared ahead of rendering so that the compositor knows how long
+     * it is used. Transient textures of the same kind whose lifetimes don't overlap are aliased into the same pooled
+     * texture.
+     */
+    struct RenderCompositorTransient
+    {
+        POOLED_RENDER_TEXTURE_DESC Desc;
+
+        /**
+         * If true the texture is only used while the node renders. Otherwise it is used until the last node depending
+         * on the node that declared it has rendered.
+         */
+        bool Scratch = false;
+
+        bool operator== (const RenderCompositorTransient& rhs) const { return Desc == rhs.Desc && Scratch == rhs.Scratch; }
+        bool operator!= (const RenderCompositorTransient& rhs) const { return !(*this == rhs); }
+    };
+
+    /** Describes how the transient textures of a view are aliased, and the GPU memory they need. */
+    struct RenderCompositorTransientStats
+    {
+        UINT32 NumDeclared = 0; /**< Number of transient textures declared by the nodes. */
+        UINT32 NumAllocated = 0; /**< Number of pooled textures they are aliased into. */
+        UINT64 DeclaredMemory = 0; /**< Memory, in bytes, the declared textures would need without aliasing. */
+        UINT64 AllocatedMemory = 0; /**< Memory, in bytes, of the pooled textures they are aliased into. */
+        UINT64 PeakMemory = 0; /**< Highest amount of memory, in bytes, used by transient textures at once. */
+    };
+
     /** Inputs provided to each node in the render compositor hierarchy */
     struct RenderCompositorNodeInputs
     {
@@ -35,6 +64,9 @@ namespace te
 
         // Callbacks to external systems can hook into the compositor
         Vector<RenderCompositorNode*> InputNodes;
+
+        /** Textures allocated for the transient textures the node declared, in the order they were declared. */
+        Vector<SPtr<PooledRenderTexture>> TransientTextures;
     };
 
     /**
@@ -42,13 +74,20 @@ namespace te
      * can depend on other nodes in the hierarchy.
      *
      * @note	Implementations must provide a GetNodeId() and GetDependencies() static method, which are expected to
-     *			return a unique name for the implemented node, as well as a set of nodes it depends on.
+     *			return a unique name for the implemented node, as well as a set of nodes it depends on. They can also
+     *			provide a GetTransients() static method, declaring the render textures the node needs.
      */
     class RenderCompositorNode
     {
         public:
         virtual ~RenderCompositorNode() = default;
 
+        /**
+         * Returns the transient textures a node renders to. The compositor allocates them before the node renders and
+         * provides them through RenderCompositorNodeInputs::TransientTextures.
+         */
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view) { return { }; }
+
     protected:
         friend class RenderCompositor;
 
@@ -80,6 +119,21 @@ namespace te
             NodeType* Type = nullptr;
             UINT32 LastUseIdx = 0;
             Vector<RenderCompositorNode*> Inputs;
+
+            // Transient textures declared by the node, and the slot each of them is assigned to
+            mutable Vector<RenderCompositorTransient> Transients;
+            mutable Vector<UINT32> TransientSlots;
+
+            /** Slots whose last lifetime of the frame ends with this node, their texture going back to the pool. */
+            mutable Vector<UINT32> ReleasedSlots;
+        };
+
+        /** Pooled texture shared by the transient textures of the same kind that are never used at the same time. */
+        struct TransientSlot
+        {
+            POOLED_RENDER_TEXTURE_DESC Desc;
+            UINT32 LastUseIdx = 0;
+            SPtr<PooledRenderTexture> Texture;
         };
 
     public:
@@ -99,13 +153,27 @@ namespace te
         /** Performs rendering using the current render node hierarchy. This is expected to be called once per frame. */
         void Execute(RenderCompositorNodeInputs& inputs) const;
 
+        /** Returns how the transient textures of the nodes were aliased during the last call to Execute(). */
+        const RenderCompositorTransientStats& GetTransientStats() const { return _transientStats; }
+
     private:
         /** Clears the render node hierarchy. */
         void Clear();
 
+        /**
+         * Assigns the transient textures declared by the nodes to slots, each slot being shared by textures with the
+         * same descriptor and disjoint lifetimes. Only plans again if the declarations changed since the last call
+         * (e.g. the view was resized).
+         */
+        void PlanTransients(const RendererView& view) const;
+
         Vector<NodeInfo> _nodeInfos;
         bool _isValid = false;
 
+        mutable Vector<TransientSlot> _transientSlots;
+        mutable RenderCompositorTransientStats _transientStats;
+        mutable bool _transientsDirty = true;
+
         // We don't want to always create new node (as they don't change), 
         // so we keep a list of each type of node already created
         UnorderedMap<NodeType*, RenderCompositorNode*> _nodeBackup;
@@ -125,6 +193,9 @@ namespace te
             /** Returns identifier for all the dependencies of a node of this type. */
             virtual Vector<String> GetDependencies(const RendererView& view) const = 0;
 
+            /** Returns the transient textures a node of this type renders to. */
+            virtual Vector<RenderCompositorTransient> GetTransients(const RendererView& view) const = 0;
+
             String id;
         };
         
@@ -145,6 +216,12 @@ namespace te
             {
                 return T::GetDependencies(view);
             }
+
+            /** @copydoc NodeType::GetTransients */
+            Vector<RenderCompositorTransient> GetTransients(const RendererView& view) const override
+            {
+                return T::GetTransients(view);
+            }
         };
 
         /**
@@ -195,6 +272,7 @@ namespace te
 
         static String GetNodeId() { return "GpuInitializationPass"; }
         static Vector<String> GetDependencies(const RendererView& view);
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view);
 
     protected:
         /** @copydoc RenderCompositorNode::Render */
@@ -286,6 +364,7 @@ namespace te
 
         static String GetNodeId() { return "HalfSceneTex"; }
         static Vector<String> GetDependencies(const RendererView& view);
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view);
     protected:
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
@@ -308,6 +387,10 @@ namespace te
 
         static String GetNodeId() { return "SceneTexDownsamples"; }
         static Vector<String> GetDependencies(const RendererView& view);
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view);
+
+        /** Returns the number of levels of the down sample chains of a view, the half resolution texture included. */
+        static UINT32 GetNumDownsamples(const RendererView& view);
     protected:
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
@@ -324,6 +407,7 @@ namespace te
 
         static String GetNodeId() { return "ResolvedSceneDepth"; }
         static Vector<String> GetDependencies(const RendererView& view);
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view);
     protected:
         /** @copydoc RenderCompositorNode::Render */
         void Render(const RenderCompositorNodeInputs& inputs) override;
@@ -354,6 +438,7 @@ namespace te
 
         static String GetNodeId() { return "PostProcess"; }
         static Vector<String> GetDependencies(const RendererView& view);
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view);
 
     protected:
         /** @copydoc RenderCompositorNode::Render */
@@ -363,6 +448,9 @@ namespace te
         void Clear() override;
 
     protected:
+        /** Textures allocated by the compositor for the node, handed out as outputs by GetAndSwitch(). */
+        SPtr<PooledRenderTexture> _textures[2];
+
         mutable SPtr<PooledRenderTexture> _output[2];
         mutable UINT32 _currentIdx = 0;
     };
@@ -457,6 +545,7 @@ namespace te
 
         static String GetNodeId() { return "SSAO"; }
         static Vector<String> GetDependencies(const RendererView& view);
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view);
 
     protected:
         /** @copydoc RenderCompositorNode::Render */
@@ -472,6 +561,7 @@ namespace te
     public:
         static String GetNodeId() { return "Bloom"; }
         static Vector<String> GetDependencies(const RendererView& view);
+        static Vector<RenderCompositorTransient> GetTransients(const RendererView& view);
 
     protected:
         /** @copydoc RenderCompositorNode::Render */
@@ -9,6 +9,7 @@
 #include "Renderer/TeCamera.h"
 #include "Renderer/TeRendererUtility.h"
 #include "Renderer/TeGpuResourcePool.h"
+#include "Renderer/TeBoneMatrixPalette.h"
 #include "RenderAPI/TeRenderAPI.h"
 #include "Manager/TeRendererManager.h"
 #include "CoreUtility/TeCoreObjectManager.h"
@@ -20,6 +21,7 @@
 namespace te
 {
     SPtr<GpuParamBlockBuffer> gPerInstanceParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER] = { nullptr };
+    SPtr<GpuParamBlockBuffer> gPerInstanceObjectParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER] = { nullptr };
 
     RenderMan::RenderMan()
         : _renderAPI(RenderAPI::Instance())
@@ -69,6 +71,12 @@ namespace te
                 gPerInstanceParamBuffer[i]->Destroy();
                 gPerInstanceParamBuffer[i] = nullptr;
             }
+
+            if (gPerInstanceObjectParamBuffer[i])
+            {
+                gPerInstanceObjectParamBuffer[i]->Destroy();
+                gPerInstanceObjectParamBuffer[i] = nullptr;
+            }
         }
 
         if (gPerLightsParamBuffer)
@@ -116,10 +124,16 @@ namespace te
 
         FrameInfo frameInfo(timings, frameData);
 
+        // Upload bone matrices of all skinned renderables at once
+        if (frameData.Animation != nullptr)
+            gBoneMatrixPalette().Update(*frameData.Animation);
+
         // Update per-frame data for all renderable objects
         for (UINT32 i = 0; i < sceneInfo.Renderables.size(); i++)
             _scene->PrepareRenderable(i, frameInfo);
 
+        _scene->UpdateGpuScene();
+
         // Gather all views
         for (auto& rtInfo : sceneInfo.RenderTargets)
         {
@@ -153,6 +167,8 @@ namespace te
             _renderAPI.PopMarker();
         }
 
+        _scene->ClearStaticCasterChanges();
+
         GpuResourcePool::Instance().Update();
 
         gProfilerGPU().EndFrame();
@@ -179,8 +195,9 @@ namespace te
 
         if (needs3DRender)
         {
-            // Update ShadowMap size
+            // Update ShadowMap size and budget
             viewGroup.GetShadowRenderer()->SetShadowMapSize(_options->ShadowMapSize);
+            viewGroup.GetShadowRenderer()->SetShadowUpdateBudget(_options->ShadowUpdateBudget);
 
             // Find all visible renderables
             {
@@ -251,6 +268,14 @@ namespace te
         {
             viewGroup.GenerateRenderQueue(sceneInfo, view, _options->InstancingMode);
 
+            // The target still holds what was rendered for the view the last time nothing it depends on changed
+            const bool shadowsSettled = viewGroup.GetShadowRenderer()->AreShadowsSettled(frameInfo.Timings.FrameIdx);
+            if (_options->CacheViewOutputs && view.IsOutputUpToDate(sceneInfo, shadowsSettled))
+            {
+                view.SkipFrame(frameInfo);
+                return anythingDrawn;
+            }
+
             const auto& settings = view.GetSceneCamera()->GetRenderSettings();
             _scene->SetParamCameraParams(settings->SceneLightColor);
             _scene->SetParamSkyboxParams(view.GetSceneCamera()->GetRenderSettings()->EnableSkybox);
@@ -308,6 +333,11 @@ namespace te
         const RenderCompositor& compositor = view.GetCompositor();
         compositor.Execute(inputs);
 
+        const RenderCompositorTransientStats& transientStats = compositor.GetTransientStats();
+        TE_ADD_PROFILER_GPU(NumTransientTextures, transientStats.NumAllocated);
+        TE_ADD_PROFILER_GPU(TransientTexturesMemory, transientStats.AllocatedMemory);
+        TE_ADD_PROFILER_GPU(TransientTexturesDeclaredMemory, transientStats.DeclaredMemory);
+
         view.EndFrame();
     }
 
@@ -24,5 +24,33 @@ namespace te
          * By default, we will try to batch objects which share same geometry and same material
         */
         RenderManInstancing InstancingMode = RenderManInstancing::Manual;
+
+        /**
+         * Maximum number of shadow map texels rendered per frame, cubemap faces and cascades included. Once it is spent,
+         * the remaining spot and radial light shadows are sampled as they were last rendered, unless they never were.
+         * 0 for no limit.
+         */
+        UINT64 ShadowUpdateBudget = 0;
+
+        /**
+         * If true, the material variations renderables need are compiled in the background when they aren't compiled yet,
+         * the renderables being drawn with a simpler variation of their material in the meantime. Otherwise they are
+         * compiled right away, stalling the frame.
+         */
+        bool AsyncShaderCompilation = true;
+
+        /**
+         * If true, views rendering to a texture are only rendered again when something they depend on changed (camera,
+         * settings, lights, the transforms, meshes, materials and textures of the renderables they see, or the shadow
+         * casters of the scene and the shadow maps still being updated). Otherwise they are rendered every frame.
+         */
+        bool CacheViewOutputs = true;
+
+        /**
+         * If true, the per-object data of all renderables (transforms, flags, bounds) lives in a single GPU buffer, only
+         * updated where objects changed, and draws only provide the index of their object. Otherwise each renderable has
+         * its own constant buffer, and instanced draws upload the data of all their instances every frame.
+         */
+        bool GpuScene = false;
     };
 }
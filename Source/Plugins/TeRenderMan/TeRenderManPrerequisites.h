@@ -4,6 +4,7 @@
 #include "Renderer/TeParamBlocks.h"
 #include "Math/TeMatrix4.h"
 #include "Math/TeVector2.h"
+#include "Math/TeVector4I.h"
 
 #define STANDARD_FORWARD_MIN_INSTANCED_BLOCK_SIZE 2
 #define STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE 128
@@ -12,6 +13,8 @@
 
 #define STANDARD_FORWARD_MAX_NUM_LIGHTS 24
 
+#define STANDARD_FORWARD_MAX_CLUSTER_RANGES 16
+
 namespace te
 {
     struct PerCameraData
@@ -107,6 +110,14 @@ namespace te
     extern PerInstanceParamDef gPerInstanceParamDef;
     extern SPtr<GpuParamBlockBuffer> gPerInstanceParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER];
 
+    /** Used instead of PerInstanceParamDef when per-object data lives in the GPU scene: 4 object indices per entry. */
+    TE_PARAM_BLOCK_BEGIN(PerInstanceObjectParamDef)
+        TE_PARAM_BLOCK_ENTRY_ARRAY(Vector4I, gInstanceObjects, STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE / 4)
+    TE_PARAM_BLOCK_END
+
+    extern PerInstanceObjectParamDef gPerInstanceObjectParamDef;
+    extern SPtr<GpuParamBlockBuffer> gPerInstanceObjectParamBuffer[STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER];
+
     // ############ Per Material
 
     TE_PARAM_BLOCK_BEGIN(PerMaterialParamDef)
@@ -162,7 +173,12 @@ namespace te
         TE_PARAM_BLOCK_ENTRY(UINT32, gWriteVelocity)
         TE_PARAM_BLOCK_ENTRY(UINT32, gCastLights)
         TE_PARAM_BLOCK_ENTRY(UINT32, gReceiveShadows)
-        TE_PARAM_BLOCK_ENTRY(Vector3, gPadding)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gBoneOffset)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gPrevBoneOffset)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gCompactVertices)
+        TE_PARAM_BLOCK_ENTRY(Vector4, gPositionScale)
+        TE_PARAM_BLOCK_ENTRY(Vector4, gPositionBias)
+        TE_PARAM_BLOCK_ENTRY(UINT32, gObjectIdx)
     TE_PARAM_BLOCK_END
 
     extern PerObjectParamDef gPerObjectParamDef;
@@ -264,6 +280,7 @@ namespace te
     class RendererLight;
     class RenderableElement;
     class DecalRenderElement;
+    class GpuScene;
 
     class ShadowRendering;
 }
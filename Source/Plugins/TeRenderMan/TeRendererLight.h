@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TeRenderManPrerequisites.h"
+#include "TeRendererRenderable.h"
 #include "Renderer/TeLight.h"
 
 namespace te
@@ -40,9 +41,15 @@ namespace te
 
         Light* _internal;
 
-        // Ask the renderer to update a shadow when the light CastShadowsType is equal to Static
-        // Updated (false) by ShadowRendering API
-        bool RedrawStaticShadow = false;
+        // Ask the renderer to update the cached static shadow of the light (CastShadowsType Static or Both)
+        // Set for new lights, updated (false) by ShadowRendering API
+        bool RedrawStaticShadow = true;
+
+        /**
+         * Levels of detail picked for the casters of the shadow of a spot or radial light. Directional lights keep theirs
+         * per cascade, in ShadowCascadedMap. Picked while rendering shadow maps, which otherwise only read the light.
+         */
+        mutable RenderableLods ShadowCasterLods;
     };
 
     /**
@@ -1,11 +1,15 @@
 #include "TeRendererRenderable.h"
+#include "TeGpuScene.h"
 #include "Renderer/TeRendererUtility.h"
 #include "Utility/TeBitwise.h"
 #include "Mesh/TeMesh.h"
+#include "RenderAPI/TeGpuParamBlockBuffer.h"
+#include "Profiling/TeProfilerGPU.h"
 
 namespace te
 { 
     PerInstanceParamDef gPerInstanceParamDef;
+    PerInstanceObjectParamDef gPerInstanceObjectParamDef;
     PerMaterialParamDef gPerMaterialParamDef;
     PerObjectParamDef gPerObjectParamDef;
 
@@ -25,6 +29,38 @@ namespace te
         gPerObjectParamDef.gWriteVelocity.Set(buffer, (UINT32)renderable->GetWriteVelocity() ? 1 : 0);
         gPerObjectParamDef.gCastLights.Set(buffer, (UINT32)renderable->GetCastLights() ? 1 : 0);
         gPerObjectParamDef.gReceiveShadows.Set(buffer, (UINT32)renderable->GetReceiveShadows() ? 1 : 0);
+        gPerObjectParamDef.gBoneOffset.Set(buffer, renderable->GetBoneMatrixOffset());
+        gPerObjectParamDef.gPrevBoneOffset.Set(buffer, renderable->GetBonePrevMatrixOffset());
+
+        SPtr<Mesh> mesh = renderable->GetMesh();
+        if (mesh != nullptr && mesh->GetProperties().HasCompactVertices())
+        {
+            const MeshProperties& meshProps = mesh->GetProperties();
+            gPerObjectParamDef.gCompactVertices.Set(buffer, 1);
+            gPerObjectParamDef.gPositionScale.Set(buffer, Vector4(meshProps.GetPositionScale(), 0.0f));
+            gPerObjectParamDef.gPositionBias.Set(buffer, Vector4(meshProps.GetPositionBias(), 0.0f));
+        }
+        else
+        {
+            gPerObjectParamDef.gCompactVertices.Set(buffer, 0);
+            gPerObjectParamDef.gPositionScale.Set(buffer, Vector4(Vector3::ONE, 0.0f));
+            gPerObjectParamDef.gPositionBias.Set(buffer, Vector4::ZERO);
+        }
+
+        // The whole block is uploaded again the next time it is bound
+        TE_ADD_PROFILER_GPU(NumObjectDataWrites, 1);
+        TE_ADD_PROFILER_GPU(NumObjectDataUploads, 1);
+        TE_ADD_PROFILER_GPU(ObjectDataUploadedBytes, buffer->GetSize());
+    }
+
+    void PerObjectBuffer::UpdateBoneOffsets(SPtr<GpuParamBlockBuffer>& buffer, Renderable* renderable)
+    {
+        gPerObjectParamDef.gBoneOffset.Set(buffer, renderable->GetBoneMatrixOffset());
+        gPerObjectParamDef.gPrevBoneOffset.Set(buffer, renderable->GetBonePrevMatrixOffset());
+
+        TE_ADD_PROFILER_GPU(NumObjectDataWrites, 1);
+        TE_ADD_PROFILER_GPU(NumObjectDataUploads, 1);
+        TE_ADD_PROFILER_GPU(ObjectDataUploadedBytes, buffer->GetSize());
     }
 
     void PerObjectBuffer::UpdatePerInstance(SPtr<GpuParamBlockBuffer>& perObjectBuffer, 
@@ -32,6 +68,10 @@ namespace te
     {
         for (size_t i = 0; i < instanceCounter; i++)
             gPerInstanceParamDef.gInstances.Set(perInstanceBuffer, instanceData[i], (UINT32)i);
+
+        TE_ADD_PROFILER_GPU(NumObjectDataWrites, instanceCounter);
+        TE_ADD_PROFILER_GPU(NumObjectDataUploads, 1);
+        TE_ADD_PROFILER_GPU(ObjectDataUploadedBytes, perInstanceBuffer->GetSize());
     }
 
     void PerObjectBuffer::UpdatePerMaterial(SPtr<GpuParamBlockBuffer>& perMaterialBuffer, const MaterialProperties& properties)
@@ -80,7 +120,10 @@ namespace te
 
     void RenderableElement::Draw() const
     {
-        gRendererUtility().Draw(MeshElem, *SubMeshElem, InstanceCount);
+        if (UseClusterRanges)
+            gRendererUtility().Draw(MeshElem, *SubMeshElem, ClusterRanges.data(), (UINT32)ClusterRanges.size(), InstanceCount);
+        else
+            gRendererUtility().Draw(MeshElem, *SubMeshElem, InstanceCount);
     }
 
     RendererRenderable::RendererRenderable()
@@ -89,15 +132,104 @@ namespace te
     }
 
     RendererRenderable::~RendererRenderable()
-    { }
+    {
+        if (GpuSceneElem)
+            GpuSceneElem->Free(GpuSceneSlot);
+    }
 
     void RendererRenderable::UpdatePerObjectBuffer()
     {
-        PerObjectBuffer::UpdatePerObject(PerObjectParamBuffer, WorldTfrm, PrevWorldTfrm, RenderablePtr);
+        if (GpuSceneElem)
+            GpuSceneElem->Write(GpuSceneSlot, *this);
+        else
+            PerObjectBuffer::UpdatePerObject(PerObjectParamBuffer, WorldTfrm, PrevWorldTfrm, RenderablePtr);
+    }
+
+    void RendererRenderable::UpdateBoneMatrices()
+    {
+        if (GpuSceneElem)
+            GpuSceneElem->WriteBoneOffsets(GpuSceneSlot, *this);
+        else
+            PerObjectBuffer::UpdateBoneOffsets(PerObjectParamBuffer, RenderablePtr);
+
+        const SPtr<GpuBuffer>& boneMatrixBuffer = RenderablePtr->GetBoneMatrixBuffer();
+        for (auto& element : Elements)
+        {
+            if (element.BoneMatrixBuffer == boneMatrixBuffer)
+                continue;
+
+            element.BoneMatrixBuffer = boneMatrixBuffer;
+            element.BonePrevMatrixBuffer = RenderablePtr->GetBonePrevMatrixBuffer();
+
+            for (auto& gpuParams : element.GpuParamsElem)
+            {
+                if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices"))
+                    gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "BoneMatrices", element.BoneMatrixBuffer);
+
+                if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "PrevBoneMatrices"))
+                    gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "PrevBoneMatrices", element.BonePrevMatrixBuffer);
+            }
+        }
+
+        // Parameters are shared with the lower levels of detail, only their own references need updating
+        for (auto& lodElements : LodElements)
+        {
+            for (UINT32 i = 0; i < (UINT32)lodElements.size(); i++)
+            {
+                lodElements[i].BoneMatrixBuffer = Elements[i].BoneMatrixBuffer;
+                lodElements[i].BonePrevMatrixBuffer = Elements[i].BonePrevMatrixBuffer;
+            }
+        }
+    }
+
+    void RendererRenderable::SetGpuScene(GpuScene* gpuScene)
+    {
+        if (GpuSceneElem == gpuScene)
+            return;
+
+        if (GpuSceneElem)
+            GpuSceneElem->Free(GpuSceneSlot);
+
+        GpuSceneElem = gpuScene;
+        GpuSceneSlot = gpuScene ? gpuScene->Allocate() : GpuScene::NULL_SLOT;
+
+        gPerObjectParamDef.gObjectIdx.Set(PerObjectParamBuffer, GpuSceneSlot);
+    }
+
+    void RendererRenderable::BindGpuScene()
+    {
+        if (!GpuSceneElem)
+            return;
+
+        // Parameters are shared with the lower levels of detail
+        for (auto& element : Elements)
+        {
+            for (auto& gpuParams : element.GpuParamsElem)
+            {
+                if (gpuParams->HasBuffer(GPT_VERTEX_PROGRAM, "SceneObjects"))
+                    gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "SceneObjects", GpuSceneElem->GetBuffer());
+            }
+        }
     }
 
     void RendererRenderable::UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId)
     {
         PerObjectBuffer::UpdatePerInstance(PerObjectParamBuffer, gPerInstanceParamBuffer[blockId], instanceData, instanceCounter);
     }
+
+    UINT32 RenderableLods::Select(const RendererRenderable& renderable, UINT32 renderableIdx, float screenSize)
+    {
+        if (renderable.LodElements.empty())
+            return 0;
+
+        // Renderables removed from the scene hand their index over to another one, which at worst starts from the
+        // level they left
+        if (renderableIdx >= (UINT32)_lods.size())
+            _lods.resize(renderableIdx + 1, 0);
+
+        UINT32& lod = _lods[renderableIdx];
+        lod = renderable.RenderablePtr->GetMesh()->GetProperties().SelectLod(screenSize, lod);
+
+        return lod;
+    }
 }
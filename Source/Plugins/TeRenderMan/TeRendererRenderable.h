@@ -21,6 +21,14 @@ namespace te
         static void UpdatePerObject(SPtr<GpuParamBlockBuffer>& buffer, const Matrix4& tfrm,
             const Matrix4& prevTfrm, Renderable* RenderablePtr);
 
+        /**
+         * Updates only the bone matrix offsets of the provided buffer, which change every frame for skinned renderables.
+         *
+         *  @param[in]	buffer	      Buffer which will be filled with data
+         *  @param[in]	RenderablePtr Pointer to the current Renderable we want to update
+         */
+        static void UpdateBoneOffsets(SPtr<GpuParamBlockBuffer>& buffer, Renderable* RenderablePtr);
+
         /** 
          * Update the provided instance buffer
          * 
@@ -64,6 +72,13 @@ namespace te
         RenderableAnimType AnimType = RenderableAnimType::None;
         SPtr<GpuBuffer> BoneMatrixBuffer;
         SPtr<GpuBuffer> BonePrevMatrixBuffer;
+
+        /**
+         * Index ranges of the meshlets of the sub-mesh left visible by the view the element is queued for. Only used if
+         * UseClusterRanges is true, otherwise the whole sub-mesh is drawn.
+         */
+        Vector<MeshletRange> ClusterRanges;
+        bool UseClusterRanges = false;
     };
 
     /** Contains information about a Renderable, used by the Renderer. */
@@ -72,9 +87,28 @@ namespace te
         RendererRenderable();
         ~RendererRenderable();
 
-        /** Updates the per-object GPU buffer according to the currently set properties. */
+        /**
+         * Updates the per-object data according to the currently set properties, in the GPU scene if the renderable is
+         * part of it, in the per-object GPU buffer otherwise.
+         */
         void UpdatePerObjectBuffer();
 
+        /**
+         * Updates bone matrix offsets in the per-object data, and binds the shared bone matrix buffer to all elements if
+         * it was re-created. Must be called every frame for skinned renderables.
+         */
+        void UpdateBoneMatrices();
+
+        /**
+         * Moves the per-object data of the renderable to @p gpuScene, or back to the per-object GPU buffer if null. The
+         * per-object GPU buffer then only holds the slot of the renderable in the GPU scene. The data itself is written by
+         * the next call to UpdatePerObjectBuffer().
+         */
+        void SetGpuScene(GpuScene* gpuScene);
+
+        /** Binds the buffer of the GPU scene to the parameters of all elements, if the renderable is part of it. */
+        void BindGpuScene();
+
         /** 
          * Updates the per-instance GPU buffer according to the currently set properties. 
          *
@@ -84,6 +118,12 @@ namespace te
          */
         void UpdatePerInstanceBuffer(PerInstanceData* instanceData, UINT32 instanceCounter, UINT32 blockId);
 
+        /** Returns the elements to render at the provided level of detail of the mesh. */
+        Vector<RenderableElement>& GetElements(UINT32 lod)
+        {
+            return (lod == 0 || lod > (UINT32)LodElements.size()) ? Elements : LodElements[lod - 1];
+        }
+
         Matrix4 WorldTfrm = Matrix4::IDENTITY;
         Matrix4 PrevWorldTfrm = Matrix4::IDENTITY;
         PrevFrameDirtyState PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
@@ -91,6 +131,55 @@ namespace te
         Renderable* RenderablePtr;
         Vector<RenderableElement> Elements;
 
+        /**
+         * Elements of the lower levels of detail of the mesh, LodElements[i] being level i + 1. They only differ from
+         * Elements by their sub-mesh, and share their materials and GPU parameters.
+         */
+        Vector<Vector<RenderableElement>> LodElements;
+
+        /** True if the renderable is drawn in the shadow maps of the lights around it. */
+        bool ShadowCaster = false;
+
+        /** True if the shadow of the renderable is cached with the static casters of the lights around it. */
+        bool StaticShadowCaster = false;
+
+        /**
+         * Techniques of the elements still compiling in the background. Until they are all done, the elements are drawn
+         * with a fallback variation of their material.
+         */
+        Vector<SPtr<Technique>> PendingTechniques;
+
         SPtr<GpuParamBlockBuffer> PerObjectParamBuffer;
+
+        /** GPU scene holding the per-object data of the renderable, if any, and the slot of the renderable in it. */
+        GpuScene* GpuSceneElem = nullptr;
+        UINT32 GpuSceneSlot = 0;
+    };
+
+    /**
+     * Levels of detail last picked for the renderables of the scene by a single observer: a view, a cascade of a
+     * directional light shadow, or the shadow of a spot or radial light. Levels switch with hysteresis, which only holds
+     * if the level compared against is the one the same observer picked on the previous frame.
+     */
+    class RenderableLods
+    {
+    public:
+        /**
+         * Picks the level of detail of @p renderable, whose index in the scene is @p renderableIdx, for an observer it
+         * covers @p screenSize of.
+         */
+        UINT32 Select(const RendererRenderable& renderable, UINT32 renderableIdx, float screenSize);
+
+        /** Returns the level of detail last picked for the renderable at index @p renderableIdx in the scene. */
+        UINT32 Get(UINT32 renderableIdx) const
+        {
+            return renderableIdx < (UINT32)_lods.size() ? _lods[renderableIdx] : 0;
+        }
+
+        /** Forgets the levels picked so far, when the observer doesn't look at the same thing anymore. */
+        void Clear() { _lods.clear(); }
+
+    private:
+        Vector<UINT32> _lods;
     };
 }
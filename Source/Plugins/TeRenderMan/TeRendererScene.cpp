@@ -2,6 +2,7 @@
 
 #include "TeRenderMan.h"
 #include "TeRenderManOptions.h"
+#include "TeGpuScene.h"
 #include "Renderer/TeCamera.h"
 #include "Renderer/TeSkybox.h"
 #include "Material/TeMaterial.h"
@@ -14,11 +15,16 @@
 #include "Mesh/TeMesh.h"
 #include "Renderer/TeDecal.h"
 #include "Renderer/TeRendererUtility.h"
+#include "Renderer/TeRendererMaterialManager.h"
+#include "Profiling/TeProfilerGPU.h"
 
 namespace te
 {
     PerFrameParamDef gPerFrameParamDef;
 
+    /** Static caster changes kept while no shadows are rendered. Past it, every cached shadow map is redrawn. */
+    static constexpr UINT32 MAX_PENDING_STATIC_CASTER_CHANGES = 4096;
+
     /** Returns a specific base pass shader variation. */
     template<bool WRITE_VELOCITY>
     static const ShaderVariation* GetBasePassVariation(bool shaderCanWriteVelocity, RenderableAnimType animType)
@@ -30,8 +36,14 @@ namespace te
         return VAR_LOOKUP[(int)animType];
     }
 
-    /** Initializes a specific base pass technique on the provided material and returns the technique index. */
-    static UINT32 InitAndRetrieveBasePassTechnique(Material& material, bool shaderCanWriteVelocity, bool writeVelocity, RenderableAnimType animType)
+    /**
+     * Initializes a specific base pass technique on the provided material and returns the technique index. If
+     * @p pendingTechniques is provided and the technique isn't compiled yet, it is compiled in the background and added to
+     * the list, and the index of a fallback technique is returned in the meantime: the same variation without any of the
+     * optional maps and features of the material.
+     */
+    static UINT32 InitAndRetrieveBasePassTechnique(Material& material, bool shaderCanWriteVelocity, bool writeVelocity,
+        RenderableAnimType animType, Vector<SPtr<Technique>>* pendingTechniques = nullptr)
     {
         const MaterialProperties& properties = material.GetProperties();
         static const Vector3 Black(0.f, 0.f, 0.f);
@@ -78,6 +90,34 @@ namespace te
 
         TE_ASSERT_ERROR(technique, "No technique has been found");
 
+        if (material.GetShader())
+            RendererMaterialManager::Instance().RecordVariation(material.GetShader(), technique->GetVariation());
+
+        if (pendingTechniques && !technique->IsCompiled())
+        {
+            technique->CompileAsync();
+
+            if (technique->IsCompiling())
+            {
+                pendingTechniques->push_back(technique);
+
+                FIND_TECHNIQUE_DESC fallbackDesc = findDesc;
+                for (auto& paramName : findDesc.Variation.GetParamNames())
+                {
+                    if (StartsWith(paramName, "USE_", false))
+                        fallbackDesc.Variation.AddParam(ShaderVariation::Param(paramName, false));
+                }
+
+                const UINT32 fallbackIdx = material.FindTechnique(fallbackDesc, true);
+                if (fallbackIdx != (UINT32)-1)
+                {
+                    // Shared by all the materials using the shader, so it is only compiled once, right away
+                    material.GetTechnique(fallbackIdx)->Compile();
+                    return fallbackIdx;
+                }
+            }
+        }
+
         technique->Compile();
 
         UINT32 numPasses = technique->GetNumPasses();
@@ -119,6 +159,9 @@ namespace te
         : _options(options)
     { 
         _info.PerFrameParamBuffer = gPerFrameParamDef.CreateBuffer();
+
+        if (_options->GpuScene)
+            _info.GpuSceneElem = te_shared_ptr_new<GpuScene>();
     }
 
     RendererScene::~RendererScene()
@@ -232,6 +275,8 @@ namespace te
 
     void RendererScene::RegisterLight(Light* light)
     {
+        _info.LightsVersion++;
+
         if (light->GetType() == Light::Type::Directional)
         {
             UINT32 lightId = (UINT32)_info.DirectionalLights.size();
@@ -263,6 +308,7 @@ namespace te
     void RendererScene::UpdateLight(Light* light, UINT32 updateFlag)
     {
         UINT32 lightId = light->GetRendererId();
+        _info.LightsVersion++;
 
         if (light->GetType() == Light::Type::Radial)
             _info.RadialLightWorldBounds[lightId] = light->GetBounds();
@@ -270,7 +316,7 @@ namespace te
             _info.SpotLightWorldBounds[lightId] = light->GetBounds();
 
         if ((updateFlag & (UINT32)LightDirtyFlag::RedrawShadow) != 0 
-            && light->GetCastShadowsType() == Light::CastShadowsType::Static 
+            && light->GetCastShadowsType() != Light::CastShadowsType::Dynamic 
             && light->GetCastShadows())
         {
             if (light->GetType() == Light::Type::Directional)
@@ -285,6 +331,8 @@ namespace te
     void RendererScene::UnregisterLight(Light* light)
     {
         UINT32 lightId = light->GetRendererId();
+        _info.LightsVersion++;
+
         if (light->GetType() == Light::Type::Directional)
         {
             if (_info.DirectionalLights.size() <= lightId)
@@ -358,6 +406,7 @@ namespace te
 
     void RendererScene::ClearLights()
     {
+        _info.LightsVersion++;
         _info.DirectionalLights.clear();
         _info.RadialLights.clear();
         _info.RadialLightWorldBounds.clear();
@@ -378,10 +427,19 @@ namespace te
         rendererRenderable->WorldTfrm = renderable->GetMatrix();
         rendererRenderable->PrevWorldTfrm = rendererRenderable->WorldTfrm;
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Clean;
+        rendererRenderable->SetGpuScene(_info.GpuSceneElem.get());
         rendererRenderable->UpdatePerObjectBuffer();
 
         SetMeshData(rendererRenderable, renderable);
 
+        rendererRenderable->ShadowCaster = renderable->GetCastShadows();
+        if (rendererRenderable->ShadowCaster)
+            _info.ShadowCastersVersion++;
+
+        rendererRenderable->StaticShadowCaster = IsStaticShadowCaster(*renderable);
+        if (rendererRenderable->StaticShadowCaster)
+            _info.StaticCasterChanges.push_back(_info.RenderableCullInfos.back().Boundaries.GetSphere());
+
         if (_options->InstancingMode == RenderManInstancing::Manual)
         {
             auto iter = std::find(_info.RenderablesInstanced.begin(), _info.RenderablesInstanced.end(), rendererRenderable);
@@ -413,6 +471,19 @@ namespace te
         rendererRenderable->WorldTfrm = renderable->GetMatrix();
         rendererRenderable->PreviousFrameDirtyState = PrevFrameDirtyState::Updated;
 
+        if (rendererRenderable->ShadowCaster || renderable->GetCastShadows())
+            _info.ShadowCastersVersion++;
+
+        rendererRenderable->ShadowCaster = renderable->GetCastShadows();
+
+        // The shadow is cleared where the renderable was and drawn where it now is
+        if (rendererRenderable->StaticShadowCaster)
+            _info.StaticCasterChanges.push_back(_info.RenderableCullInfos[renderableId].Boundaries.GetSphere());
+
+        rendererRenderable->StaticShadowCaster = IsStaticShadowCaster(*renderable);
+        if (rendererRenderable->StaticShadowCaster)
+            _info.StaticCasterChanges.push_back(renderable->GetBounds().GetSphere());
+
         _info.Renderables[renderableId]->UpdatePerObjectBuffer();
         _info.RenderableCullInfos[renderableId].Layer = renderable->GetLayer();
         _info.RenderableCullInfos[renderableId].Boundaries = renderable->GetBounds();
@@ -452,6 +523,12 @@ namespace te
         UINT32 lastRenderableId = lastRenderable->GetRendererId();
 
         RendererRenderable* rendererRenderable = _info.Renderables[renderableId];
+
+        if (rendererRenderable->ShadowCaster)
+            _info.ShadowCastersVersion++;
+
+        if (rendererRenderable->StaticShadowCaster)
+            _info.StaticCasterChanges.push_back(_info.RenderableCullInfos[renderableId].Boundaries.GetSphere());
         
         if (renderableId != lastRenderableId)
         {
@@ -478,6 +555,15 @@ namespace te
 
     void RendererScene::ClearRenderables()
     {
+        for (UINT32 i = 0; i < (UINT32)_info.Renderables.size(); i++)
+        {
+            if (_info.Renderables[i]->ShadowCaster)
+                _info.ShadowCastersVersion++;
+
+            if (_info.Renderables[i]->StaticShadowCaster)
+                _info.StaticCasterChanges.push_back(_info.RenderableCullInfos[i].Boundaries.GetSphere());
+        }
+
         for (auto& rendererRenderable : _info.Renderables)
         {
             te_delete(rendererRenderable);
@@ -569,6 +655,12 @@ namespace te
 
     void RendererScene::SetMeshData(RendererRenderable* rendererRenderable, Renderable* renderable)
     {
+        rendererRenderable->LodElements.clear();
+        rendererRenderable->PendingTechniques.clear();
+
+        Vector<SPtr<Technique>>* pendingTechniques =
+            _options->AsyncShaderCompilation ? &rendererRenderable->PendingTechniques : nullptr;
+
         SPtr<Mesh> mesh = renderable->GetMesh();
         if (mesh != nullptr)
         {
@@ -618,11 +710,11 @@ namespace te
 
 #if TE_DEBUG_MODE == TE_DEBUG_ENABLED
                 // Determine which technique to use
-                renElement->DefaultTechniqueIdx = InitAndRetrieveBasePassTechnique(*renElement->MaterialElem, shaderCanWriteVelocity, true, animType);
+                renElement->DefaultTechniqueIdx = InitAndRetrieveBasePassTechnique(*renElement->MaterialElem, shaderCanWriteVelocity, true, animType, pendingTechniques);
                 ValidateBasePassMaterial(*renElement->MaterialElem, animType, renElement->DefaultTechniqueIdx, *vertexDecl);
 
 #else
-                renElement->DefaultTechniqueIdx = InitAndRetrieveBasePassTechnique(*renElement->MaterialElem, shaderCanWriteVelocity, false, animType);
+                renElement->DefaultTechniqueIdx = InitAndRetrieveBasePassTechnique(*renElement->MaterialElem, shaderCanWriteVelocity, false, animType, pendingTechniques);
 #endif
 
                 // Generate or assigned renderer specific data for the material
@@ -633,7 +725,7 @@ namespace te
 #if TE_DEBUG_MODE == TE_DEBUG_ENABLED
                     renElement->WriteVelocityTechniqueIdx = renElement->DefaultTechniqueIdx;
 #else
-                    renElement->WriteVelocityTechniqueIdx = InitAndRetrieveBasePassTechnique(*renElement->MaterialElem, shaderCanWriteVelocity, true, animType);
+                    renElement->WriteVelocityTechniqueIdx = InitAndRetrieveBasePassTechnique(*renElement->MaterialElem, shaderCanWriteVelocity, true, animType, pendingTechniques);
                     ValidateBasePassMaterial(*renElement->MaterialElem, animType, renElement->WriteVelocityTechniqueIdx, *vertexDecl);
 #endif
 
@@ -673,6 +765,23 @@ namespace te
                         gpuParams->SetBuffer(GPT_VERTEX_PROGRAM, "PrevBoneMatrices", element.BonePrevMatrixBuffer);
                 }
             }
+
+            rendererRenderable->BindGpuScene();
+
+            // Lower levels of detail draw another range of the same index buffer with the same materials. Z prepass meshes
+            // only have the full detail sub-meshes, so they are not used by these elements.
+            for (UINT32 lod = 1; lod < meshProps.GetNumLods(); lod++)
+            {
+                rendererRenderable->LodElements.push_back(Vector<RenderableElement>(rendererRenderable->Elements.begin(),
+                    rendererRenderable->Elements.begin() + meshProps.GetNumSubMeshes()));
+
+                Vector<RenderableElement>& lodElements = rendererRenderable->LodElements.back();
+                for (UINT32 i = 0; i < (UINT32)lodElements.size(); i++)
+                {
+                    lodElements[i].SubMeshElem = meshProps.GetLodSubMeshPtr(lod, i);
+                    lodElements[i].ZPrepassMeshElem = nullptr;
+                }
+            }
         }
     }
 
@@ -698,6 +807,20 @@ namespace te
 
         for (auto& entry : _info.Views)
             entry->SetStateReductionMode(_options->ReductionMode);
+
+        if (_options->GpuScene != (_info.GpuSceneElem != nullptr))
+        {
+            SPtr<GpuScene> gpuScene = _options->GpuScene ? te_shared_ptr_new<GpuScene>() : nullptr;
+
+            for (auto& entry : _info.Renderables)
+            {
+                entry->SetGpuScene(gpuScene.get());
+                entry->UpdatePerObjectBuffer();
+            }
+
+            // Elements are bound to the buffer once it's created, by UpdateGpuScene()
+            _info.GpuSceneElem = gpuScene;
+        }
     }
 
     void RendererScene::SetParamFrameParams(const float& time, const float& delta)
@@ -755,8 +878,17 @@ namespace te
     {
         RendererRenderable* rendererRenderable = _info.Renderables[idx];
 
+        // Bone matrices were already uploaded to the shared palette, renderables only need to know where theirs are. This
+        // is done for all renderables, since shadow casters might not be visible from any view.
         if (frameInfo.FrameDatas.Animation != nullptr)
-            rendererRenderable->RenderablePtr->UpdatePrevFrameAnimationBuffers();
+        {
+            Renderable* renderable = rendererRenderable->RenderablePtr;
+            renderable->UpdatePrevFrameAnimationBuffers();
+            renderable->UpdateAnimationBuffers(*frameInfo.FrameDatas.Animation);
+
+            if (renderable->GetAnimType() == RenderableAnimType::Skinned)
+                rendererRenderable->UpdateBoneMatrices();
+        }
 
         if (rendererRenderable->PreviousFrameDirtyState != PrevFrameDirtyState::Clean)
         {
@@ -769,6 +901,16 @@ namespace te
                 rendererRenderable->UpdatePerObjectBuffer();
             }
         }
+
+        // Elements drawn with fallback techniques switch to theirs once they are compiled
+        if (!rendererRenderable->PendingTechniques.empty())
+        {
+            const bool compiling = std::any_of(rendererRenderable->PendingTechniques.begin(),
+                rendererRenderable->PendingTechniques.end(), [](const SPtr<Technique>& x) { return x->IsCompiling(); });
+
+            if (!compiling)
+                SetMeshData(rendererRenderable, rendererRenderable->RenderablePtr);
+        }
     }
 
     void RendererScene::PrepareVisibleRenderable(UINT32 idx, const FrameInfo& frameInfo)
@@ -776,12 +918,49 @@ namespace te
         if (_info.RenderableReady[idx])
             return;
 
-        RendererRenderable* rendererRenderable = _info.Renderables[idx];
+        _info.RenderableReady[idx] = true;
+    }
 
-        if(frameInfo.FrameDatas.Animation != nullptr)
-            rendererRenderable->RenderablePtr->UpdateAnimationBuffers(*frameInfo.FrameDatas.Animation);
+    void RendererScene::UpdateGpuScene()
+    {
+        GpuScene* gpuScene = _info.GpuSceneElem.get();
+        if (!gpuScene)
+            return;
 
-        _info.RenderableReady[idx] = true;
+        const UINT32 version = gpuScene->GetVersion();
+        gpuScene->Flush();
+
+        const GpuSceneStats& stats = gpuScene->GetStats();
+        TE_ADD_PROFILER_GPU(NumObjectDataWrites, stats.NumObjectWrites);
+        TE_ADD_PROFILER_GPU(NumObjectDataUploads, stats.NumUploads);
+        TE_ADD_PROFILER_GPU(ObjectDataUploadedBytes, stats.UploadedBytes);
+
+        // Growing the buffer re-creates it, elements still refer to the previous one
+        if (gpuScene->GetVersion() != version)
+        {
+            for (auto& entry : _info.Renderables)
+                entry->BindGpuScene();
+        }
+    }
+
+    void RendererScene::ClearStaticCasterChanges()
+    {
+        // Frames rendering no shadows keep the changes for the next one that does, up to a point
+        if (!_info.StaticCasterChangesChecked)
+        {
+            if (_info.StaticCasterChanges.size() <= MAX_PENDING_STATIC_CASTER_CHANGES)
+                return;
+
+            _info.StaticCasterChangesOverflow = true;
+        }
+
+        _info.StaticCasterChanges.clear();
+        _info.StaticCasterChangesChecked = false;
+    }
+
+    bool RendererScene::IsStaticShadowCaster(const Renderable& renderable)
+    {
+        return renderable.GetCastShadows() && renderable.GetMobility() == ObjectMobility::Static && !renderable.IsAnimated();
     }
 
     RENDERER_VIEW_DESC RendererScene::CreateViewDesc(Camera* camera) const
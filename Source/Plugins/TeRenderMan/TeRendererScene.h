@@ -27,6 +27,28 @@ namespace te
         Vector<Sphere> RadialLightWorldBounds;
         Vector<Sphere> SpotLightWorldBounds;
 
+        /** Incremented each time a light is added, modified or removed. */
+        UINT64 LightsVersion = 0;
+
+        /** Incremented each time a renderable casting shadows is added, modified or removed. */
+        UINT64 ShadowCastersVersion = 0;
+
+        // Static shadow casters
+        /**
+         * Bounds of the static shadow casters added, modified or removed during the frame, before and after the change.
+         * Shadow maps caching the static casters of a light are invalidated when one of them overlaps the light.
+         */
+        Vector<Sphere> StaticCasterChanges;
+
+        /**
+         * Set once the cached shadow maps have been checked against StaticCasterChanges. Changes are only cleared at the
+         * end of a frame that checked them, so frames rendering no shadows don't lose them.
+         */
+        bool StaticCasterChangesChecked = false;
+
+        /** Set when more static casters changed without shadows being rendered than StaticCasterChanges keeps. */
+        bool StaticCasterChangesOverflow = false;
+
         // Decals
         Vector<RendererDecal> Decals;
         Vector<CullInfo> DecalCullInfos;
@@ -37,6 +59,9 @@ namespace te
         // FrameBuffer data
         SPtr<GpuParamBlockBuffer> PerFrameParamBuffer;
 
+        /** Per-object data of all renderables, if RenderManOptions::GpuScene is enabled. */
+        SPtr<GpuScene> GpuSceneElem;
+
         // Buffers for various transient data that gets rebuilt every frame
         //// Rebuilt every frame
         mutable Vector<bool> RenderableReady;
@@ -151,10 +176,28 @@ namespace te
          */
         void PrepareVisibleRenderable(UINT32 idx, const FrameInfo& frameInfo);
 
+        /**
+         * Uploads the per-object data changed during the frame to the GPU scene, if enabled. To be called once all
+         * renderables are prepared, before any of them is drawn.
+         */
+        void UpdateGpuScene();
+
+        /**
+         * Forgets the static shadow casters changes once shadows have been checked against them. To be called once all
+         * views have been rendered.
+         */
+        void ClearStaticCasterChanges();
+
     private:
         /** Creates a renderer view descriptor for the particular camera. */
         RENDERER_VIEW_DESC CreateViewDesc(Camera* camera) const;
 
+        /**
+         * Returns true if the shadow @p renderable casts can be cached: it doesn't move and its geometry doesn't change
+         * from one frame to the next.
+         */
+        static bool IsStaticShadowCaster(const Renderable& renderable);
+
         /**
          * Find the render target the camera belongs to and adds it to the relevant list. If the camera was previously
          * registered with some other render target it will be removed from it and added to the new target.
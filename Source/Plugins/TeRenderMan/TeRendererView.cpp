@@ -8,9 +8,13 @@
 #include "Renderer/TeCamera.h"
 #include "Renderer/TeRenderable.h"
 #include "Renderer/TeRenderSettings.h"
+#include "Renderer/TeSkybox.h"
+#include "RenderAPI/TeRenderTarget.h"
 #include "Material/TeMaterial.h"
 #include "Material/TeShader.h"
+#include "Material/TePass.h"
 #include "Mesh/TeMesh.h"
+#include "Mesh/TeMeshlet.h"
 
 namespace te
 {
@@ -104,6 +108,8 @@ namespace te
         if (settings != nullptr)
             *_renderSettings = *settings;
 
+        _renderSettingsVersion++;
+
         _compositor->Build(*this, RCNodeFinalResolve::GetNodeId());
     }
 
@@ -218,6 +224,12 @@ namespace te
         _redrawThisFrame = false;
     }
 
+    void RendererView::SkipFrame(const FrameInfo& frameInfo)
+    {
+        _frameTimings = frameInfo.Timings;
+        EndFrame();
+    }
+
     const RenderCompositor& RendererView::GetCompositor() const 
     { 
         return *(_compositor.get()); 
@@ -365,6 +377,7 @@ namespace te
     void RendererView::QueueRenderElements(const SceneInfo& sceneInfo)
     {
         const ConvexVolume& worldFrustum = _properties.CullFrustum;
+        _clusterStats = ClusterCullingStats();
 
         // Queue renderables
         for (UINT32 i = 0; i < (UINT32)sceneInfo.Renderables.size(); i++)
@@ -372,14 +385,26 @@ namespace te
             if (!_visibility.Renderables[i].Visible)
                 continue;
 
+            RendererRenderable* renderable = sceneInfo.Renderables[i];
+            UINT32 lod = 0;
+            if (!renderable->LodElements.empty())
+            {
+                const float screenSize = GetScreenSize(renderable->RenderablePtr->GetBounds().GetSphere()) * _renderSettings->LodBias;
+                lod = _lods.Select(*renderable, i, screenSize);
+            }
+
             UINT32 j = 0;
             bool needsVelocity = RequiresVelocityWrites();
-            for (auto& renderElem : sceneInfo.Renderables[i]->Elements)
+            for (auto& renderElem : renderable->GetElements(lod))
             {
-                Bounds bounds = sceneInfo.Renderables[i]->RenderablePtr->GetSubMeshBounds(j);
+                Bounds bounds = renderable->RenderablePtr->GetSubMeshBounds(j);
                 const float distanceToCamera = (_properties.ViewOrigin - bounds.GetSphere().GetCenter()).Length();
                 j++;
 
+                // Sub-meshes can be simplified away entirely in lower levels of detail
+                if (renderElem.SubMeshElem->IndexCount == 0)
+                    continue;
+
                 // Renderable are culled in a previous step. However, it could be a good idea
                 // to do a small distance filtering on subMeshes for renderable which have more
                 // than a certain amount of submeshes. This way, we could reduce draw calls
@@ -402,6 +427,9 @@ namespace te
                 else
                     techniqueIdx = renderElem.DefaultTechniqueIdx;
 
+                if (!CullClusters(renderable, renderElem, techniqueIdx))
+                    continue;
+
                 // Note: I could keep renderables in multiple separate arrays, so I don't need to do the check here
                 if (shaderFlags & (UINT32)ShaderFlag::Transparent)
                     _forwardTransparentQueue->Add(&renderElem, distanceToCamera, techniqueIdx);
@@ -414,6 +442,69 @@ namespace te
         _forwardTransparentQueue->Sort();
     }
 
+    bool RendererView::CullClusters(const RendererRenderable* renderable, RenderableElement& renderElem, UINT32 techniqueIdx)
+    {
+        renderElem.UseClusterRanges = false;
+
+        // Bounds of the meshlets of skinned meshes don't follow their animation
+        const Vector<Meshlet>& meshlets = renderElem.SubMeshElem->Meshlets;
+        if (!_renderSettings->ClusterCulling || meshlets.size() < 2 || renderElem.InstanceCount > 1 ||
+            renderElem.AnimType != RenderableAnimType::None)
+        {
+            return true;
+        }
+
+        // Meshlets facing away can only be culled when the pass culls the faces they are made of
+        float backfaceSign = 0.0f;
+        const SPtr<Pass> pass = renderElem.MaterialElem->GetPass(0, techniqueIdx);
+        if (pass != nullptr)
+        {
+            switch (pass->GetDesc().RasterizerStateDesc.cullMode)
+            {
+            case CULL_CLOCKWISE: backfaceSign = 1.0f; break;
+            case CULL_COUNTERCLOCKWISE: backfaceSign = -1.0f; break;
+            default: break;
+            }
+        }
+
+        const UINT32 numTriangles = MeshletUtility::Cull(meshlets, renderable->WorldTfrm, _properties.CullFrustum,
+            _properties.ViewOrigin, backfaceSign, STANDARD_FORWARD_MAX_CLUSTER_RANGES, renderElem.ClusterRanges);
+
+        _clusterStats.NumClusters += (UINT32)meshlets.size();
+        _clusterStats.NumTriangles += renderElem.SubMeshElem->IndexCount / 3;
+        _clusterStats.NumVisibleTriangles += numTriangles;
+        for (auto& meshlet : meshlets)
+        {
+            for (auto& range : renderElem.ClusterRanges)
+            {
+                if (meshlet.IndexOffset >= range.IndexOffset && meshlet.IndexOffset < range.IndexOffset + range.IndexCount)
+                {
+                    _clusterStats.NumVisibleClusters++;
+                    break;
+                }
+            }
+        }
+
+        if (numTriangles == 0)
+            return false;
+
+        renderElem.UseClusterRanges = numTriangles < renderElem.SubMeshElem->IndexCount / 3;
+        return true;
+    }
+
+    float RendererView::GetScreenSize(const Sphere& sphere) const
+    {
+        // Projection scale of the y axis is cot(fov / 2) in perspective, and 2 / height in orthographic
+        const float projScale = Math::Abs(_properties.ProjTransform[1][1]);
+        const float radius = sphere.GetRadius();
+
+        if (_properties.ProjType == ProjectionType::PT_ORTHOGRAPHIC)
+            return radius * projScale;
+
+        const float distance = (_properties.ViewOrigin - sphere.GetCenter()).Length();
+        return radius * projScale / std::max(distance, radius);
+    }
+
     void RendererView::QueueRenderInstancedElements(const SceneInfo& sceneInfo, InstancedBuffer& instancedBuffer)
     {
         // We now have a list of similar objects to render
@@ -428,12 +519,19 @@ namespace te
             TE_DEBUG("Maximum number of instanced block reached : " + ToString(instBlockCount));
         }
 
+        // With a GPU scene, instances only need the slots of their objects, their data is already on the GPU
+        const bool useGpuScene = sceneInfo.GpuSceneElem != nullptr;
+
         // For each instance block we retrieve all necessary data
         for (UINT32 currInstBlock = 0; currInstBlock < instBlockCount; currInstBlock++)
         {
+            // Programs expect both buffers to be bound whichever they read from, the unused one is never written to
             if (!gPerInstanceParamBuffer[currInstBlock])
                 gPerInstanceParamBuffer[currInstBlock] = gPerInstanceParamDef.CreateBuffer();
 
+            if (!gPerInstanceObjectParamBuffer[currInstBlock])
+                gPerInstanceObjectParamBuffer[currInstBlock] = gPerInstanceObjectParamDef.CreateBuffer();
+
             // We need to know start and end of element for this instance block
             UINT32 lowerBlockBound = currInstBlock * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
             UINT32 upperBlockBound = (currInstBlock + 1) * STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE;
@@ -451,10 +549,24 @@ namespace te
             const float distanceToCamera = (_properties.ViewOrigin - boundingBox.GetCenter()).Length();
 
             PerInstanceData data;
+            Vector4I instanceObjects[STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE / 4];
 
             for (auto subElemIdx = lowerBlockBound; subElemIdx < upperBlockBound; subElemIdx++)
             {
                 UINT32 elemId = instancedBuffer.Idx[subElemIdx];
+
+                if (useGpuScene)
+                {
+                    const UINT32 instanceIdx = subElemIdx - lowerBlockBound;
+                    instanceObjects[instanceIdx / 4][instanceIdx % 4] = (INT32)sceneInfo.Renderables[elemId]->GpuSceneSlot;
+                    instancedObjectCounter++;
+
+                    if (instancedObjectCounter > STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE * STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
+                        break;
+
+                    continue;
+                }
+
                 const Renderable* renderable = sceneInfo.Renderables[elemId]->RenderablePtr;
                 const Matrix4& tfrmNoScale = renderable->GetMatrixNoScale();
 
@@ -478,7 +590,16 @@ namespace te
             }
 
             // We update per object and per instance buffer
-            sceneInfo.Renderables[idx]->UpdatePerInstanceBuffer(_instanceDataPool[currInstBlock], upperBlockBound - lowerBlockBound, currInstBlock);
+            if (useGpuScene)
+            {
+                const UINT32 numEntries = Math::DivideAndRoundUp(upperBlockBound - lowerBlockBound, 4U);
+                for (UINT32 i = 0; i < numEntries; i++)
+                    gPerInstanceObjectParamDef.gInstanceObjects.Set(gPerInstanceObjectParamBuffer[currInstBlock], instanceObjects[i], i);
+            }
+            else
+            {
+                sceneInfo.Renderables[idx]->UpdatePerInstanceBuffer(_instanceDataPool[currInstBlock], upperBlockBound - lowerBlockBound, currInstBlock);
+            }
 
             // We create all instanced render element using first RendererRenderable data
             for (auto& renderElem : sceneInfo.Renderables[idx]->Elements)
@@ -510,7 +631,10 @@ namespace te
                     _forwardOpaqueQueue->Add(elem, distanceToCamera, techniqueIdx);
 
                 for (auto& gpuParams : renderElem.GpuParamsElem)
+                {
                     gpuParams->SetParamBlockBuffer("PerInstanceBuffer", gPerInstanceParamBuffer[currInstBlock]);
+                    gpuParams->SetParamBlockBuffer("PerInstanceObjectBuffer", gPerInstanceObjectParamBuffer[currInstBlock]);
+                }
             }
 
             if (instancedObjectCounter > STANDARD_FORWARD_MAX_INSTANCED_BLOCK_SIZE* STANDARD_FORWARD_MAX_INSTANCED_BLOCKS_NUMBER)
@@ -658,6 +782,122 @@ namespace te
         _redrawForSeconds = 0.0f;
     }
 
+    bool RendererView::IsOutputUpToDate(const SceneInfo& sceneInfo, bool shadowsSettled)
+    {
+        const SPtr<RenderTarget>& target = _properties.Target.Target;
+
+        // Temporal effects and eye adaptation change the output from one frame to the next
+        const bool cacheable = target && !target->GetProperties().IsWindow && !_redrawThisFrame
+            && _renderSettings->AntialiasingAglorithm != AntiAliasingAlgorithm::TAA
+            && !(_renderSettings->EnableHDR && _renderSettings->AutoExposure.Enabled)
+            && !RequiresVelocityWrites() && shadowsSettled;
+
+        if (!cacheable)
+        {
+            _outputValid = false;
+            return false;
+        }
+
+        auto HashMemory = [](size_t& hash, const void* data, size_t size)
+        {
+            te_hash_combine(hash, std::string_view((const char*)data, size));
+        };
+
+        size_t hash = 0;
+        HashMemory(hash, &_properties.ViewTransform, sizeof(Matrix4));
+        HashMemory(hash, &_properties.ProjTransformNoAA, sizeof(Matrix4));
+        te_hash_combine(hash, target.get());
+        te_hash_combine(hash, _properties.Target.ViewRect.x);
+        te_hash_combine(hash, _properties.Target.ViewRect.y);
+        te_hash_combine(hash, _properties.Target.ViewRect.width);
+        te_hash_combine(hash, _properties.Target.ViewRect.height);
+        te_hash_combine(hash, _properties.Target.ClearFlags);
+        HashMemory(hash, &_properties.Target.ClearColor, sizeof(Color));
+        te_hash_combine(hash, _renderSettingsVersion);
+        te_hash_combine(hash, sceneInfo.LightsVersion);
+
+        auto CastShadows = [](const Vector<RendererLight>& lights)
+        {
+            return std::any_of(lights.begin(), lights.end(), [](const RendererLight& light)
+            {
+                return light._internal->GetCastShadows();
+            });
+        };
+
+        if (CastShadows(sceneInfo.DirectionalLights) || CastShadows(sceneInfo.SpotLights) ||
+            CastShadows(sceneInfo.RadialLights))
+        {
+            // Skinned casters are posed again every frame, seen by the view or not
+            for (auto& renderable : sceneInfo.Renderables)
+            {
+                if (renderable->ShadowCaster && renderable->RenderablePtr->GetAnimType() != RenderableAnimType::None)
+                {
+                    _outputValid = false;
+                    return false;
+                }
+            }
+
+            te_hash_combine(hash, sceneInfo.ShadowCastersVersion);
+        }
+
+        if (sceneInfo.SkyboxElem)
+        {
+            SPtr<Texture> skyboxTexture = sceneInfo.SkyboxElem->GetTexture();
+            te_hash_combine(hash, skyboxTexture.get());
+            te_hash_combine(hash, skyboxTexture ? skyboxTexture->GetContentVersion() : 0);
+            te_hash_combine(hash, sceneInfo.SkyboxElem->GetBrightness());
+            te_hash_combine(hash, sceneInfo.SkyboxElem->GetIBLIntensity());
+        }
+
+        for (UINT32 i = 0; i < (UINT32)sceneInfo.Renderables.size(); i++)
+        {
+            if (!_visibility.Renderables[i].Visible && !_visibility.Renderables[i].Instanced)
+                continue;
+
+            RendererRenderable* renderable = sceneInfo.Renderables[i];
+            te_hash_combine(hash, i);
+            te_hash_combine(hash, _lods.Get(i));
+            HashMemory(hash, &renderable->WorldTfrm, sizeof(Matrix4));
+
+            for (auto& element : renderable->GetElements(_lods.Get(i)))
+            {
+                // Skinned elements are posed again every frame
+                if (element.AnimType != RenderableAnimType::None)
+                {
+                    _outputValid = false;
+                    return false;
+                }
+
+                te_hash_combine(hash, element.MeshElem.get());
+                te_hash_combine(hash, element.SubMeshElem ? element.SubMeshElem->IndexOffset : 0);
+                te_hash_combine(hash, element.SubMeshElem ? element.SubMeshElem->IndexCount : 0);
+                te_hash_combine(hash, element.MaterialElem.get());
+                te_hash_combine(hash, element.DefaultTechniqueIdx);
+
+                if (!element.MaterialElem)
+                    continue;
+
+                // Shaders animating on their own, and textures rendered to by the GPU, change without any version
+                SPtr<Shader> shader = element.MaterialElem->GetShader();
+                if ((shader && shader->GetFlags() & (UINT32)ShaderFlag::Animated) ||
+                    !element.MaterialElem->HashTextureContents(hash))
+                {
+                    _outputValid = false;
+                    return false;
+                }
+
+                te_hash_combine(hash, element.MaterialElem->GetContentVersion());
+            }
+        }
+
+        const bool upToDate = _outputValid && hash == _outputHash;
+
+        _outputHash = hash;
+        _outputValid = true;
+
+        return upToDate;
+    }
+
     RendererViewGroup::RendererViewGroup(RendererView** views, UINT32 numViews, SPtr<RenderManOptions> options)
         : _options(options)
     {
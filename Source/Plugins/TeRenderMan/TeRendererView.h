@@ -137,6 +137,18 @@ namespace te
         float CullDistanceFactor;
     };
 
+    /**
+     * Number of meshlets and triangles of the sub-meshes queued by a view, and how many of them are drawn once meshlets
+     * are culled one by one. Hidden meshlets between two visible ranges are drawn when ranges are merged.
+     */
+    struct ClusterCullingStats
+    {
+        UINT32 NumClusters = 0;
+        UINT32 NumVisibleClusters = 0;
+        UINT32 NumTriangles = 0;
+        UINT32 NumVisibleTriangles = 0;
+    };
+
     /** Contains information about a single view into the scene, used by the renderer. */
     class RendererView
     {
@@ -173,6 +185,9 @@ namespace te
         /** Ends rendering and frees any acquired resources. */
         void EndFrame();
 
+        /** Ends a frame during which the view wasn't rendered, its output being up to date. See IsOutputUpToDate(). */
+        void SkipFrame(const FrameInfo& frameInfo);
+
         /**
          * Returns a render queue containing all opaque objects for the specified pipeline. Make sure to call
          * determineVisible() beforehand if view or object transforms changed since the last time it was called. If @p
@@ -257,6 +272,9 @@ namespace te
         /** Returns the visibility mask calculated with the last call to determineVisible(). */
         const VisibilityInfo& GetVisibilityInfo() const { return _visibility; }
 
+        /** Returns the meshlet culling statistics of the last call to QueueRenderElements(). */
+        const ClusterCullingStats& GetClusterCullingStats() const { return _clusterStats; }
+
         /** Updates the GPU buffer containing per-view information, with the latest internal data. */
         void UpdatePerViewBuffer();
 
@@ -286,9 +304,29 @@ namespace te
         /** Lets an on-demand view know that it should be redrawn this frame. */
         void NotifyNeedsRedraw();
 
+        /**
+         * Checks if the output rendered to the view's target the last time is still up to date, in which case rendering
+         * the view can be skipped. Hashes the camera, the settings, the lights and the renderables visible to the view
+         * (meshes, materials and the contents of their textures), so it must be called once the render queues have been
+         * generated. Only views rendering to a texture are cached, a window back buffer doesn't keep its contents once
+         * presented. Views drawing materials with a ShaderFlag::Animated shader, or sampling textures rendered to by the
+         * GPU, are never cached.
+         *
+         * Shadow casters out of the view change the shadows it receives: when a light casts shadows, any change to the
+         * casters of the scene makes the output out of date, and so does @p shadowsSettled being false, the shadow maps
+         * the view samples still catching up with the casters or the camera.
+         */
+        bool IsOutputUpToDate(const SceneInfo& sceneInfo, bool shadowsSettled);
+
         /** Returns true if the view should write to the velocity buffer. */
         bool RequiresVelocityWrites() const;
 
+        /**
+         * Returns the size of a sphere once projected by the view, relative to the height of the view. Used for picking
+         * the level of detail of renderables.
+         */
+        float GetScreenSize(const Sphere& sphere) const;
+
         /**
          * Gets the current exposure of the view, used for transforming scene light values from HDR in a range that can be
          * displayed on a display device.
@@ -322,6 +360,12 @@ namespace te
         static Vector2 GetNDCZToDeviceZ();
 
     private:
+        /**
+         * Culls the meshlets of the sub-mesh of a render element against the view, and stores the index ranges of the
+         * visible ones in the element. Returns false if no meshlet is visible and the element doesn't need to be queued.
+         */
+        bool CullClusters(const RendererRenderable* renderable, RenderableElement& renderElem, UINT32 techniqueIdx);
+
         friend class RendererViewGroup;
         friend class Renderable;
 
@@ -333,6 +377,8 @@ namespace te
         SPtr<GpuParamBlockBuffer> _paramBuffer;
 
         VisibilityInfo _visibility;
+        RenderableLods _lods; /**< Levels of detail picked for the renderables queued by the view. */
+        ClusterCullingStats _clusterStats;
         UINT32 _viewIdx = 0;
 
         // On-demand drawing 
@@ -343,6 +389,11 @@ namespace te
         bool _redrawThisFrame = false;
         UINT64 _waitingOnAutoExposureFrame = std::numeric_limits<UINT64>::max();
 
+        // Output caching
+        UINT32 _renderSettingsVersion = 0;
+        size_t _outputHash = 0;
+        bool _outputValid = false;
+
         // Current frame info
         FrameTimings _frameTimings;
 
@@ -1,7 +1,10 @@
 #include "TeShadowRendering.h"
 
 #include "TeRendererScene.h"
+#include "TeGpuScene.h"
+#include "TeRenderMan.h"
 #include "Renderer/TeRendererUtility.h"
+#include "Mesh/TeMesh.h"
 #include "RenderAPI/TeRenderTexture.h"
 #include "Utility/TeBitwise.h"
 #include "Utility/TeFrameAllocator.h"
@@ -9,11 +12,15 @@
 namespace te
 {
     ShadowParamsDef gShadowParamsDef;
+    ShadowInstancesDef gShadowInstancesDef;
 
-    void ShadowDepthNormalMat::Bind(const SPtr<GpuParamBlockBuffer>& shadowParams)
+    void ShadowDepthNormalMat::Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<te::GpuBuffer>& sceneObjects)
     {
         _params->SetParamBlockBuffer("PerShadowBuffer", shadowParams);
 
+        if (_params->HasBuffer(GPT_VERTEX_PROGRAM, "SceneObjects"))
+            _params->SetBuffer(GPT_VERTEX_PROGRAM, "SceneObjects", sceneObjects);
+
         RenderAPI::Instance().SetGraphicsPipeline(_graphicsPipeline);
         RenderAPI::Instance().SetStencilRef(_stencilRef);
     }
@@ -28,6 +35,15 @@ namespace te
         RenderAPI::Instance().SetGpuParams(_params);
     }
 
+    void ShadowDepthNormalMat::SetPerInstanceBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
+        const SPtr<GpuParamBlockBuffer>& perInstanceParams)
+    {
+        _params->SetParamBlockBuffer("PerObjectBuffer", perObjectParams);
+        _params->SetParamBlockBuffer("PerShadowInstanceBuffer", perInstanceParams);
+
+        RenderAPI::Instance().SetGpuParams(_params);
+    }
+
     ShadowDepthNormalMat* ShadowDepthNormalMat::GetVariation(bool skinned)
     {
         if (skinned)
@@ -36,10 +52,13 @@ namespace te
             return Get(GetVariation<false>());
     }
 
-    void ShadowDepthDirectionalMat::Bind(const SPtr<GpuParamBlockBuffer>& shadowParams)
+    void ShadowDepthDirectionalMat::Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<te::GpuBuffer>& sceneObjects)
     {
         _params->SetParamBlockBuffer("PerShadowBuffer", shadowParams);
 
+        if (_params->HasBuffer(GPT_VERTEX_PROGRAM, "SceneObjects"))
+            _params->SetBuffer(GPT_VERTEX_PROGRAM, "SceneObjects", sceneObjects);
+
         RenderAPI::Instance().SetGraphicsPipeline(_graphicsPipeline);
         RenderAPI::Instance().SetStencilRef(_stencilRef);
     }
@@ -54,6 +73,15 @@ namespace te
         RenderAPI::Instance().SetGpuParams(_params);
     }
 
+    void ShadowDepthDirectionalMat::SetPerInstanceBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
+        const SPtr<GpuParamBlockBuffer>& perInstanceParams)
+    {
+        _params->SetParamBlockBuffer("PerObjectBuffer", perObjectParams);
+        _params->SetParamBlockBuffer("PerShadowInstanceBuffer", perInstanceParams);
+
+        RenderAPI::Instance().SetGpuParams(_params);
+    }
+
     ShadowDepthDirectionalMat* ShadowDepthDirectionalMat::GetVariation(bool skinned)
     {
         if (skinned)
@@ -65,11 +93,15 @@ namespace te
     ShadowCubeMatricesDef gShadowCubeMatricesDef;
     ShadowCubeMasksDef gShadowCubeMasksDef;
 
-    void ShadowDepthCubeMat::Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<GpuParamBlockBuffer>& shadowCubeParams)
+    void ShadowDepthCubeMat::Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<GpuParamBlockBuffer>& shadowCubeParams,
+        const SPtr<te::GpuBuffer>& sceneObjects)
     {
         _params->SetParamBlockBuffer("PerShadowBuffer", shadowParams);
         _params->SetParamBlockBuffer("PerShadowCubeMatrices", shadowCubeParams);
 
+        if (_params->HasBuffer(GPT_VERTEX_PROGRAM, "SceneObjects"))
+            _params->SetBuffer(GPT_VERTEX_PROGRAM, "SceneObjects", sceneObjects);
+
         RenderAPI::Instance().SetGraphicsPipeline(_graphicsPipeline);
         RenderAPI::Instance().SetStencilRef(_stencilRef);
     }
@@ -86,6 +118,15 @@ namespace te
         RenderAPI::Instance().SetGpuParams(_params);
     }
 
+    void ShadowDepthCubeMat::SetPerInstanceBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
+        const SPtr<GpuParamBlockBuffer>& perInstanceParams)
+    {
+        _params->SetParamBlockBuffer("PerObjectBuffer", perObjectParams);
+        _params->SetParamBlockBuffer("PerShadowInstanceBuffer", perInstanceParams);
+
+        RenderAPI::Instance().SetGpuParams(_params);
+    }
+
     ShadowDepthCubeMat* ShadowDepthCubeMat::GetVariation(bool skinned)
     {
         if (skinned)
@@ -175,6 +216,7 @@ namespace te
         , _numCascades(numCascades)
         , _targets(numCascades)
         , _shadowInfos(numCascades)
+        , _casterLods(numCascades)
     {
         _shadowMap = gGpuResourcePool().Get(POOLED_RENDER_TEXTURE_DESC::Create2D(SHADOW_MAP_FORMAT, size, size,
             TU_DEPTHSTENCIL, 0, false, numCascades));
@@ -195,120 +237,320 @@ namespace te
         return _targets[cascadeIdx];
     }
 
+    void ShadowCascadedMap::SetShadowInfo(UINT32 cascadeIdx, const ShadowInfo& info)
+    {
+        _shadowInfos[cascadeIdx] = info;
+        _validCascades |= 1 << cascadeIdx;
+    }
+
+    void ShadowCascadedMap::SetOwner(const Light* light, const RendererView* view, const Quaternion& lightRotation)
+    {
+        if (_light != light || _view != view || _lightRotation != lightRotation)
+            _validCascades = 0;
+
+        if (_light != light || _view != view)
+        {
+            for (auto& lods : _casterLods)
+                lods.Clear();
+        }
+
+        _light = light;
+        _view = view;
+        _lightRotation = lightRotation;
+    }
+
+    bool ShadowCachedMap::LightState::operator== (const LightState& rhs) const
+    {
+        return Position == rhs.Position && Rotation == rhs.Rotation &&
+            Bounds.GetCenter() == rhs.Bounds.GetCenter() && Bounds.GetRadius() == rhs.Bounds.GetRadius() &&
+            SpotAngle == rhs.SpotAngle && DepthBias == rhs.DepthBias && Layer == rhs.Layer;
+    }
+
+    /** Returns the description of a single 2D or cube shadow map texture. */
+    static POOLED_RENDER_TEXTURE_DESC GetShadowMapDesc(UINT32 size, bool cube)
+    {
+        return cube
+            ? POOLED_RENDER_TEXTURE_DESC::CreateCube(SHADOW_MAP_FORMAT, size, size, TU_DEPTHSTENCIL)
+            : POOLED_RENDER_TEXTURE_DESC::Create2D(SHADOW_MAP_FORMAT, size, size, TU_DEPTHSTENCIL);
+    }
+
+    ShadowCachedMap::ShadowCachedMap(const Light* light, UINT32 size, bool cube)
+        : ShadowMapBase(size)
+        , _light(light)
+        , _cube(cube)
+    {
+        _shadowMap = gGpuResourcePool().Get(GetShadowMapDesc(size, cube));
+    }
+
+    SPtr<RenderTexture> ShadowCachedMap::GetTarget() const
+    {
+        return _shadowMap->RenderTex;
+    }
+
+    SPtr<RenderTexture> ShadowCachedMap::GetStaticTarget()
+    {
+        // Lights without static casters only keep their map to skip updates, they never need this one
+        if (!_staticMap)
+            _staticMap = gGpuResourcePool().Get(GetShadowMapDesc(_size, _cube));
+
+        return _staticMap->RenderTex;
+    }
+
+    void ShadowCachedMap::SetContent(const LightState& state, UINT64 frameIdx, const ShadowInfo& info)
+    {
+        _contentState = state;
+        _shadowInfo = info;
+        _lastUpdateFrame = frameIdx;
+        _hasContent = true;
+    }
+
+    void ShadowCachedMap::RestoreStaticDepth()
+    {
+        if (_matchesStatic)
+            return;
+
+        // Depth textures can only be copied whole, one face at a time
+        const UINT32 numFaces = _cube ? 6 : 1;
+        for (UINT32 face = 0; face < numFaces; face++)
+        {
+            TEXTURE_COPY_DESC copyDesc;
+            copyDesc.SrcFace = face;
+            copyDesc.DstFace = face;
+
+            _staticMap->Tex->Copy(_shadowMap->Tex, copyDesc);
+        }
+
+        _matchesStatic = true;
+    }
+
+    /** Shadow casters of a light drawn by ShadowRenderQueue. */
+    enum class ShadowCasterFilter
+    {
+        All, /**< Every caster of the light. */
+        Static, /**< Only the casters whose shadow can be cached. */
+        Dynamic /**< Only the casters whose shadow must be drawn every frame. */
+    };
+
     /**
      * Provides a common way for all types of shadow depth rendering to render the relevant objects into the depth map.
      * Iterates over all relevant objects in the scene, binds the relevant materials and renders the objects into the depth
-     * map.
+     * map. Casters without skinning are grouped per mesh and level of detail, and drawn instanced.
      */
     class ShadowRenderQueue
     {
     public:
-        struct Command
+        /** Renderable casting a shadow in the map being rendered. */
+        struct Caster
         {
-            Command ()
-                : Element(nullptr)
-                , IsElement(false)
-            { }
+            RendererRenderable* Renderable = nullptr;
+            const Mesh* CasterMesh = nullptr;
+            UINT32 RenderableIdx = 0;
+            UINT32 Lod = 0;
+            UINT32 Mask = 0;
+            bool Skinned = false;
+        };
 
-            Command (RenderableElement* element, bool isElement)
-                : Element(element)
-                , IsElement(isElement)
-            { }
+        /**
+         * Renders the casters of the spot or radial light @p light selected by @p filter, and returns how many have been
+         * drawn.
+         */
+        template<class Options>
+        static UINT32 Execute(RendererScene& scene, const FrameInfo& frameInfo, const Options& opt,
+            const RendererLight& light, ShadowCasterFilter filter = ShadowCasterFilter::All)
+        {
+            UINT32 numCasters = 0;
 
-            union
+            te_frame_mark();
             {
-                RenderableElement* Element;
-                RendererRenderable* Renderable;
-            };
+                FrameVector<Caster> casters;
+                Gather(scene, opt, *light._internal, filter, casters);
 
-            UINT32 Mask = 0;
-            bool IsElement = false;
-        };
+                for (auto& caster : casters)
+                    SelectLod(scene, opt, light.ShadowCasterLods, caster);
 
+                Draw(scene, opt, casters);
+                numCasters = (UINT32)casters.size();
+            }
+            te_frame_clear();
+
+            return numCasters;
+        }
+
+        /** Lists the casters of @p light selected by @p filter that intersect the volume of @p opt. */
         template<class Options>
-        static void Execute(RendererScene& scene, const FrameInfo& frameInfo, const Options& opt, const Light& light)
+        static void Gather(RendererScene& scene, const Options& opt, const Light& light, ShadowCasterFilter filter,
+            FrameVector<Caster>& casters)
         {
-            static_assert((UINT32)RenderableAnimType::Count == 2, "RenderableAnimType is expected to have two sequential entries.");
-
             const SceneInfo& sceneInfo = scene.GetSceneInfo();
 
-            te_frame_mark();
+            for (UINT32 i = 0; i < sceneInfo.Renderables.size(); i++)
             {
-                FrameVector<Command> commands[2];
+                Renderable* renderable = sceneInfo.Renderables[i]->RenderablePtr;
 
-                // Make a list of relevant renderables and prepare them for rendering
-                for (UINT32 i = 0; i < sceneInfo.Renderables.size(); i++)
-                {
-                    Renderable* renderable = sceneInfo.Renderables[i]->RenderablePtr;
+                if (!renderable->GetCastShadows())
+                    continue;
 
-                    if (!renderable->GetCastShadows())
-                        continue;
+                if (renderable->GetLayer() != light.GetLayer())
+                    continue;
 
-                    if (renderable->GetLayer() != light.GetLayer())
-                        continue;
+                if (light.GetCastShadowsType() == Light::CastShadowsType::Static && renderable->GetMobility() != ObjectMobility::Static)
+                    continue;
 
-                    if (light.GetCastShadowsType() == Light::CastShadowsType::Static && renderable->GetMobility() != ObjectMobility::Static)
-                        continue;
+                if (light.GetCastShadowsType() == Light::CastShadowsType::Dynamic && renderable->GetMobility() == ObjectMobility::Static)
+                    continue;
 
-                    if (light.GetCastShadowsType() == Light::CastShadowsType::Dynamic && renderable->GetMobility() == ObjectMobility::Static)
-                        continue;
+                if (filter != ShadowCasterFilter::All &&
+                    (filter == ShadowCasterFilter::Static) != sceneInfo.Renderables[i]->StaticShadowCaster)
+                    continue;
 
-                    const Sphere& bounds = sceneInfo.RenderableCullInfos[i].Boundaries.GetSphere();
-                    if (!opt.Intersects(bounds))
-                        continue;
+                const Sphere& bounds = sceneInfo.RenderableCullInfos[i].Boundaries.GetSphere();
+                if (!opt.Intersects(bounds))
+                    continue;
 
-                    {
-                        Command renderableCommand;
-                        renderableCommand.Mask = 0;
-                        renderableCommand.Renderable = sceneInfo.Renderables[i];
-                        renderableCommand.IsElement = false;
+                Caster caster;
+                caster.Renderable = sceneInfo.Renderables[i];
+                caster.CasterMesh = renderable->GetMesh().get();
+                caster.RenderableIdx = i;
+                caster.Skinned = renderable->GetAnimType() == RenderableAnimType::Skinned;
 
-                        opt.Prepare(renderableCommand, bounds);
+                opt.Prepare(caster, bounds);
+                casters.push_back(caster);
+            }
+        }
 
-                        bool renderableBound[2];
-                        te_zero_out(renderableBound);
+        /**
+         * Picks the level of detail of the mesh of @p caster, for the shadow map described by @p opt. @p lods holds the
+         * levels previously picked for the same shadow map.
+         */
+        template<class Options>
+        static void SelectLod(RendererScene& scene, const Options& opt, RenderableLods& lods, Caster& caster)
+        {
+            RendererRenderable* rendererRenderable = caster.Renderable;
+            if (rendererRenderable->LodElements.empty())
+            {
+                caster.Lod = 0;
+                return;
+            }
 
-                        for (auto& element : renderableCommand.Renderable->Elements)
-                        {
-                            UINT32 arrayIdx = (int)element.AnimType;
+            const Sphere& bounds = scene.GetSceneInfo().RenderableCullInfos[caster.RenderableIdx].Boundaries.GetSphere();
+            caster.Lod = lods.Select(*rendererRenderable, caster.RenderableIdx, opt.GetScreenSize(bounds));
+        }
 
-                            if (!renderableBound[arrayIdx])
-                            {
-                                commands[arrayIdx].push_back(renderableCommand);
-                                renderableBound[arrayIdx] = true;
-                            }
+        /**
+         * Draws @p casters in the shadow map described by @p opt. Skinned casters each have their own bones and are
+         * drawn one by one. The others are reordered so the ones sharing a mesh and a level of detail follow each other,
+         * and are drawn together with an instanced draw call per sub-mesh.
+         */
+        template<class Options>
+        static void Draw(RendererScene& scene, const Options& opt, FrameVector<Caster>& casters)
+        {
+            static_assert((UINT32)RenderableAnimType::Count == 2, "RenderableAnimType is expected to have two sequential entries.");
 
-                            commands[arrayIdx].push_back(Command(&element, true));
-                        }
+            const SPtr<GpuScene>& gpuScene = scene.GetSceneInfo().GpuSceneElem;
+            const SPtr<GpuBuffer> sceneObjects = gpuScene ? gpuScene->GetBuffer() : nullptr;
+
+            auto skinnedBegin = std::partition(casters.begin(), casters.end(),
+                [](const Caster& caster) { return !caster.Skinned; });
+
+            std::sort(casters.begin(), skinnedBegin, [](const Caster& a, const Caster& b)
+            {
+                if (a.CasterMesh != b.CasterMesh)
+                    return a.CasterMesh < b.CasterMesh;
+
+                return a.Lod < b.Lod;
+            });
+
+            const UINT32 numInstanced = (UINT32)(skinnedBegin - casters.begin());
+            if (numInstanced > 0)
+            {
+                opt.BindMaterial(GetVertexInputVariation<false, false>(false), sceneObjects);
+
+                for (UINT32 first = 0; first < numInstanced;)
+                {
+                    const Caster& firstCaster = casters[first];
+
+                    UINT32 numInstances = 0;
+                    while (first + numInstances < numInstanced && numInstances < SHADOW_MAX_INSTANCED_BLOCK_SIZE)
+                    {
+                        const Caster& caster = casters[first + numInstances];
+                        if (caster.CasterMesh != firstCaster.CasterMesh || caster.Lod != firstCaster.Lod)
+                            break;
+
+                        gShadowInstancesDef.gInstanceWorld.Set(opt.InstanceBuffer, caster.Renderable->WorldTfrm, numInstances);
+                        numInstances++;
+                    }
+
+                    opt.BindInstances(firstCaster);
+
+                    for (auto& element : firstCaster.Renderable->GetElements(firstCaster.Lod))
+                    {
+                        if (element.SubMeshElem->IndexCount == 0)
+                            continue;
+
+                        gRendererUtility().Draw(element.MeshElem, *element.SubMeshElem, numInstances);
                     }
+
+                    first += numInstances;
                 }
+            }
 
-                static const ShaderVariation* VAR_LOOKUP[2];
-                VAR_LOOKUP[0] = &GetVertexInputVariation<false, false>(false);
-                VAR_LOOKUP[1] = &GetVertexInputVariation<true, false>(false);
+            if (skinnedBegin != casters.end())
+            {
+                opt.BindMaterial(GetVertexInputVariation<true, false>(false), sceneObjects);
 
-                for (UINT32 i = 0; i < (UINT32)RenderableAnimType::Count; i++)
+                for (auto iter = skinnedBegin; iter != casters.end(); ++iter)
                 {
-                    opt.BindMaterial(*VAR_LOOKUP[i]);
+                    opt.BindRenderable(*iter);
 
-                    for (auto& command : commands[i])
+                    for (auto& element : iter->Renderable->GetElements(iter->Lod))
                     {
-                        if (command.IsElement)
-                        {
-                            const RenderableElement& element = *command.Element;
-                            gRendererUtility().Draw(element.MeshElem, *element.SubMeshElem, 0);
-                        }
-                        else
-                        {
-                            opt.BindRenderable(command);
-                        }
+                        if (element.SubMeshElem->IndexCount == 0)
+                            continue;
+
+                        gRendererUtility().Draw(element.MeshElem, *element.SubMeshElem, 0);
                     }
                 }
             }
-            te_frame_clear();
         }
     };
 
+    /**
+     * Renders the casters of a light into its persistent @p shadowMap. If @p cacheStatic is set, the static casters are
+     * only rendered when the cache doesn't match @p state anymore, the dynamic ones are rendered every time on top of a
+     * copy of them. Otherwise all of them are rendered.
+     */
+    template<class Options>
+    static void RenderCachedShadowCasters(ShadowCachedMap& shadowMap, const ShadowCachedMap::LightState& state,
+        bool cacheStatic, RendererScene& scene, const FrameInfo& frameInfo, const Options& opt, const RendererLight& light)
+    {
+        RenderAPI& rapi = RenderAPI::Instance();
+
+        if (!cacheStatic)
+        {
+            rapi.SetRenderTarget(shadowMap.GetTarget());
+            rapi.ClearRenderTarget(FBT_DEPTH);
+
+            ShadowRenderQueue::Execute(scene, frameInfo, opt, light);
+            shadowMap.NotifyDynamicDrawn();
+            return;
+        }
+
+        if (!shadowMap.IsStaticValid(state))
+        {
+            rapi.SetRenderTarget(shadowMap.GetStaticTarget());
+            rapi.ClearRenderTarget(FBT_DEPTH);
+
+            ShadowRenderQueue::Execute(scene, frameInfo, opt, light, ShadowCasterFilter::Static);
+            shadowMap.SetStaticValid(state);
+        }
+
+        shadowMap.RestoreStaticDepth();
+
+        rapi.SetRenderTarget(shadowMap.GetTarget());
+        if (ShadowRenderQueue::Execute(scene, frameInfo, opt, light, ShadowCasterFilter::Dynamic) > 0)
+            shadowMap.NotifyDynamicDrawn();
+    }
+
     /** Specialization used for ShadowRenderQueue when rendering cube (omnidirectional) shadow maps (all faces at once). */
     struct ShadowRenderQueueCubeOptions
     {
@@ -317,12 +559,16 @@ namespace te
             const ConvexVolume& boundingVolume,
             const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer,
             const SPtr<GpuParamBlockBuffer>& shadowCubeMatricesBuffer,
-            const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer)
+            const SPtr<GpuParamBlockBuffer>& shadowCubeMasksBuffer,
+            const SPtr<GpuParamBlockBuffer>& instanceBuffer,
+            const Vector3& lightPosition)
                 : Frustums(frustums)
                 , BoundingVolume(boundingVolume)
                 , ShadowParamsBuffer(shadowParamsBuffer)
                 , ShadowCubeMatricesBuffer(shadowCubeMatricesBuffer)
                 , ShadowCubeMasksBuffer(shadowCubeMasksBuffer)
+                , InstanceBuffer(instanceBuffer)
+                , LightPosition(lightPosition)
         { }
 
         bool Intersects(const Sphere& bounds) const
@@ -330,34 +576,48 @@ namespace te
             return BoundingVolume.Intersects(bounds);
         }
 
-        void Prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
+        void Prepare(ShadowRenderQueue::Caster& caster, const Sphere& bounds) const
         {
             for (UINT32 j = 0; j < 6; j++)
-                command.Mask |= (Frustums[j].Intersects(bounds) ? 1 : 0) << j;
+                caster.Mask |= (Frustums[j].Intersects(bounds) ? 1 : 0) << j;
+        }
+
+        /** Each face has a 90 degrees field of view, so the projection scale is 1. */
+        float GetScreenSize(const Sphere& bounds) const
+        {
+            return bounds.GetRadius() / std::max(LightPosition.Distance(bounds.GetCenter()), bounds.GetRadius());
         }
 
-        void BindMaterial(const ShaderVariation& variation) const
+        void BindMaterial(const ShaderVariation& variation, const SPtr<GpuBuffer>& sceneObjects) const
         {
             Mat = ShadowDepthCubeMat::Get(variation);
-            Mat->Bind(ShadowParamsBuffer, ShadowCubeMatricesBuffer);
+            Mat->Bind(ShadowParamsBuffer, ShadowCubeMatricesBuffer, sceneObjects);
         }
 
-        void BindRenderable(ShadowRenderQueue::Command& command) const
+        void BindRenderable(const ShadowRenderQueue::Caster& caster) const
         {
-            RendererRenderable* renderable = command.Renderable;
+            RendererRenderable* renderable = caster.Renderable;
 
             for (UINT32 j = 0; j < 6; j++)
-                gShadowCubeMasksDef.gFaceMasks.Set(ShadowCubeMasksBuffer, (command.Mask & (1 << j)), j);
+                gShadowCubeMasksDef.gFaceMasks.Set(ShadowCubeMasksBuffer, (caster.Mask & (1 << j)), j);
 
             Mat->SetPerObjectBuffer(renderable->PerObjectParamBuffer, 
                 ShadowCubeMasksBuffer, renderable->RenderablePtr->GetBoneMatrixBuffer());
         }
 
+        /** Instanced casters have no face mask, they are drawn in every face and clipped by the ones they miss. */
+        void BindInstances(const ShadowRenderQueue::Caster& first) const
+        {
+            Mat->SetPerInstanceBuffer(first.Renderable->PerObjectParamBuffer, InstanceBuffer);
+        }
+
         const ConvexVolume(&Frustums)[6];
         const ConvexVolume& BoundingVolume;
         const SPtr<GpuParamBlockBuffer>& ShadowParamsBuffer;
         const SPtr<GpuParamBlockBuffer>& ShadowCubeMatricesBuffer;
         const SPtr<GpuParamBlockBuffer>& ShadowCubeMasksBuffer;
+        const SPtr<GpuParamBlockBuffer>& InstanceBuffer;
+        Vector3 LightPosition;
 
         mutable ShadowDepthCubeMat* Mat = nullptr;
     };
@@ -367,9 +627,15 @@ namespace te
     {
         ShadowRenderQueueSpotOptions(
             const ConvexVolume& boundingVolume,
-            const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
+            const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer,
+            const SPtr<GpuParamBlockBuffer>& instanceBuffer,
+            const Vector3& lightPosition,
+            const Degree& spotAngle)
                 : BoundingVolume(boundingVolume)
                 , ShadowParamsBuffer(shadowParamsBuffer)
+                , InstanceBuffer(instanceBuffer)
+                , LightPosition(lightPosition)
+                , TanHalfAngle(Math::Tan(Radian(spotAngle) * 0.5f))
         { }
 
         bool Intersects(const Sphere& bounds) const
@@ -377,37 +643,56 @@ namespace te
             return BoundingVolume.Intersects(bounds);
         }
 
-        void Prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
+        void Prepare(ShadowRenderQueue::Caster& caster, const Sphere& bounds) const
+        {
+        }
+
+        float GetScreenSize(const Sphere& bounds) const
         {
+            const float distance = std::max(LightPosition.Distance(bounds.GetCenter()), bounds.GetRadius());
+            return bounds.GetRadius() / (distance * TanHalfAngle);
         }
 
-        void BindMaterial(const ShaderVariation& variation) const
+        void BindMaterial(const ShaderVariation& variation, const SPtr<GpuBuffer>& sceneObjects) const
         {
             Mat = ShadowDepthNormalMat::Get(variation);
-            Mat->Bind(ShadowParamsBuffer);
+            Mat->Bind(ShadowParamsBuffer, sceneObjects);
         }
 
-        void BindRenderable(ShadowRenderQueue::Command& command) const
+        void BindRenderable(const ShadowRenderQueue::Caster& caster) const
         {
-            RendererRenderable* renderable = command.Renderable;
+            RendererRenderable* renderable = caster.Renderable;
 
             Mat->SetPerObjectBuffer(renderable->PerObjectParamBuffer, 
                 renderable->RenderablePtr->GetBoneMatrixBuffer());
         }
 
+        void BindInstances(const ShadowRenderQueue::Caster& first) const
+        {
+            Mat->SetPerInstanceBuffer(first.Renderable->PerObjectParamBuffer, InstanceBuffer);
+        }
+
         const ConvexVolume& BoundingVolume;
         const SPtr<GpuParamBlockBuffer>& ShadowParamsBuffer;
+        const SPtr<GpuParamBlockBuffer>& InstanceBuffer;
+        Vector3 LightPosition;
+        float TanHalfAngle;
 
         mutable ShadowDepthNormalMat* Mat = nullptr;
     };
 
+    /** Specialization used for ShadowRenderQueue when rendering a single cascade of a cascaded shadow map. */
     struct ShadowRenderQueueDirOptions
     {
         ShadowRenderQueueDirOptions(
             const ConvexVolume& boundingVolume,
-            const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer)
+            const SPtr<GpuParamBlockBuffer>& shadowParamsBuffer,
+            const SPtr<GpuParamBlockBuffer>& instanceBuffer,
+            float orthoSize)
                 : BoundingVolume(boundingVolume)
                 , ShadowParamsBuffer(shadowParamsBuffer)
+                , InstanceBuffer(instanceBuffer)
+                , OrthoSize(orthoSize)
         { }
 
         bool Intersects(const Sphere& bounds) const
@@ -415,36 +700,83 @@ namespace te
             return BoundingVolume.Intersects(bounds);
         }
 
-        void Prepare(ShadowRenderQueue::Command& command, const Sphere& bounds) const
+        void Prepare(ShadowRenderQueue::Caster& caster, const Sphere& bounds) const
+        {
+        }
+
+        /** The cascade projection covers 2 * OrthoSize world units. */
+        float GetScreenSize(const Sphere& bounds) const
         {
+            return bounds.GetRadius() / OrthoSize;
         }
 
-        void BindMaterial(const ShaderVariation& variation) const
+        void BindMaterial(const ShaderVariation& variation, const SPtr<GpuBuffer>& sceneObjects) const
         {
             Mat = ShadowDepthDirectionalMat::Get(variation);
-            Mat->Bind(ShadowParamsBuffer);
+            Mat->Bind(ShadowParamsBuffer, sceneObjects);
         }
 
-        void BindRenderable(ShadowRenderQueue::Command& command) const
+        void BindRenderable(const ShadowRenderQueue::Caster& caster) const
         {
-            RendererRenderable* renderable = command.Renderable;
+            RendererRenderable* renderable = caster.Renderable;
 
             Mat->SetPerObjectBuffer(renderable->PerObjectParamBuffer,
                 renderable->RenderablePtr->GetBoneMatrixBuffer());
         }
 
+        void BindInstances(const ShadowRenderQueue::Caster& first) const
+        {
+            Mat->SetPerInstanceBuffer(first.Renderable->PerObjectParamBuffer, InstanceBuffer);
+        }
+
         const ConvexVolume& BoundingVolume;
         const SPtr<GpuParamBlockBuffer>& ShadowParamsBuffer;
+        const SPtr<GpuParamBlockBuffer>& InstanceBuffer;
+        float OrthoSize;
 
         mutable ShadowDepthDirectionalMat* Mat = nullptr;
     };
 
+    /**
+     * Used for gathering the casters of every cascade of a cascaded shadow map at once. The mask of a caster has a bit
+     * set for each cascade it overlaps.
+     */
+    struct ShadowRenderQueueCascadesOptions
+    {
+        ShadowRenderQueueCascadesOptions(const ConvexVolume* cascadeVolumes, UINT32 numCascades)
+            : CascadeVolumes(cascadeVolumes)
+            , NumCascades(numCascades)
+        { }
+
+        bool Intersects(const Sphere& bounds) const
+        {
+            for (UINT32 i = 0; i < NumCascades; i++)
+            {
+                if (CascadeVolumes[i].Intersects(bounds))
+                    return true;
+            }
+
+            return false;
+        }
+
+        void Prepare(ShadowRenderQueue::Caster& caster, const Sphere& bounds) const
+        {
+            for (UINT32 i = 0; i < NumCascades; i++)
+                caster.Mask |= (CascadeVolumes[i].Intersects(bounds) ? 1 : 0) << i;
+        }
+
+        const ConvexVolume* CascadeVolumes;
+        UINT32 NumCascades;
+    };
+
     const UINT32 ShadowRendering::MAX_ATLAS_SIZE = 4096;
     const UINT32 ShadowRendering::MAX_UNUSED_FRAMES = 60;
     const UINT32 ShadowRendering::MIN_SHADOW_MAP_SIZE = 32;
     const UINT32 ShadowRendering::SHADOW_MAP_FADE_SIZE = 64;
     const UINT32 ShadowRendering::SHADOW_MAP_BORDER = 4;
     const float ShadowRendering::CASCADE_FRACTION_FADE = 0.1f;
+    const UINT32 ShadowRendering::MAX_UPDATE_INTERVAL = 8;
+    const UINT32 ShadowRendering::FULL_RATE_CASCADES = 2;
 
     ShadowRendering::ShadowRendering(UINT32 shadowMapSize)
         : _shadowMapSize(shadowMapSize)
@@ -453,6 +785,7 @@ namespace te
     ShadowRendering::~ShadowRendering()
     {
         _shadowParamsBuffer = nullptr;
+        _shadowInstancesBuffer = nullptr;
     }
 
     void ShadowRendering::RenderShadowMaps(RendererScene& scene, const RendererViewGroup& viewGroup, const FrameInfo& frameInfo)
@@ -463,6 +796,22 @@ namespace te
         // Clear all transient data from last frame
         _shadowInfos.clear();
 
+        // Shadow maps are rendered once per render target, they all share the budget of the frame
+        if (_budgetFrame != frameInfo.Timings.FrameIdx)
+        {
+            _budgetFrame = frameInfo.Timings.FrameIdx;
+            _spentTexels = 0;
+        }
+
+        if (_castersVersion != sceneInfo.ShadowCastersVersion)
+        {
+            _castersVersion = sceneInfo.ShadowCastersVersion;
+            _castersChangedFrame = frameInfo.Timings.FrameIdx;
+        }
+
+        if (!_shadowInstancesBuffer)
+            _shadowInstancesBuffer = gShadowInstancesDef.CreateBuffer();
+
         _spotLightShadows.resize(sceneInfo.SpotLights.size());
         _radialLightShadows.resize(sceneInfo.RadialLights.size());
         _directionalLightShadows.resize(sceneInfo.DirectionalLights.size());
@@ -480,6 +829,9 @@ namespace te
         for (auto& entry : _shadowCubemaps)
             entry.Clear();
 
+        for (auto& entry : _cachedShadowMaps)
+            entry.Clear();
+
         // Determine shadow map sizes and sort them
         UINT32 shadowInfoCount = 0;
         for (UINT32 i = 0; i < (UINT32)sceneInfo.SpotLights.size(); ++i)
@@ -497,7 +849,8 @@ namespace te
             options.LightIdx = i;
 
             float maxFadePercent;
-            CalcShadowMapProperties(light, viewGroup, SHADOW_MAP_BORDER, options.MapSize, options.FadePercents, maxFadePercent);
+            CalcShadowMapProperties(light, viewGroup, SHADOW_MAP_BORDER, options.MapSize, options.FadePercents, maxFadePercent,
+                options.Coverage);
 
             // Don't render shadow maps that will end up nearly completely faded out
             if (maxFadePercent < 0.005f)
@@ -522,7 +875,8 @@ namespace te
             options.LightIdx = i;
 
             float maxFadePercent;
-            CalcShadowMapProperties(light, viewGroup, 0, options.MapSize, options.FadePercents, maxFadePercent);
+            CalcShadowMapProperties(light, viewGroup, 0, options.MapSize, options.FadePercents, maxFadePercent,
+                options.Coverage);
 
             // Don't render shadow maps that will end up nearly completely faded out
             if (maxFadePercent < 0.005f)
@@ -567,6 +921,16 @@ namespace te
                 ++iter;
         }
 
+        for (auto iter = _cachedShadowMaps.begin(); iter != _cachedShadowMaps.end();)
+        {
+            if (iter->GetLastUsedCounter() >= MAX_UNUSED_FRAMES)
+                iter = _cachedShadowMaps.erase(iter);
+            else
+                ++iter;
+        }
+
+        InvalidateCachedShadowMaps(scene.GetSceneInfo());
+
         // Render shadow maps
         for (UINT32 i = 0; i < (UINT32)sceneInfo.DirectionalLights.size(); ++i)
         {
@@ -582,6 +946,9 @@ namespace te
                 RenderCascadedShadowMaps(*viewGroup.GetView(j), i, scene, frameInfo);
         }
 
+        // Cascades are rendered first, the other lights get what is left of the budget
+        ScheduleShadowUpdates(sceneInfo, frameInfo.Timings.FrameIdx);
+
         for (auto& entry : _spotLightShadowOptions)
         {
             UINT32 lightIdx = entry.LightIdx;
@@ -590,7 +957,10 @@ namespace te
             if (!light._internal->GetCastShadows())
                 continue;
 
-            RenderSpotShadowMap(sceneInfo.SpotLights[lightIdx], entry, scene, frameInfo);
+            if (entry.Update)
+                RenderSpotShadowMap(sceneInfo.SpotLights[lightIdx], entry, scene, frameInfo);
+            else
+                ReuseShadowMap(sceneInfo.SpotLights[lightIdx], entry, false);
         }
 
         for (auto& entry : _radialLightShadowOptions)
@@ -601,7 +971,10 @@ namespace te
             if (!light._internal->GetCastShadows())
                 continue;
             
-            RenderRadialShadowMap(sceneInfo.RadialLights[lightIdx], entry, scene, frameInfo);
+            if (entry.Update)
+                RenderRadialShadowMap(sceneInfo.RadialLights[lightIdx], entry, scene, frameInfo);
+            else
+                ReuseShadowMap(sceneInfo.RadialLights[lightIdx], entry, true);
         }
     }
 
@@ -613,10 +986,228 @@ namespace te
         _cascadedShadowMaps.clear();
         _dynamicShadowMaps.clear();
         _shadowCubemaps.clear();
+        _cachedShadowMaps.clear();
 
         _shadowMapSize = size;
     }
 
+    UINT32 ShadowRendering::GetCachedShadowMap(const RendererLight& light, UINT32 size, bool cube)
+    {
+        UINT32 idx = FindCachedShadowMap(light, size, cube);
+        if (idx == (UINT32)-1)
+        {
+            idx = (UINT32)_cachedShadowMaps.size();
+            _cachedShadowMaps.push_back(ShadowCachedMap(light._internal, size, cube));
+        }
+
+        _cachedShadowMaps[idx].MarkAsUsed();
+        return idx;
+    }
+
+    UINT32 ShadowRendering::FindCachedShadowMap(const RendererLight& light, UINT32 size, bool cube) const
+    {
+        for (UINT32 i = 0; i < (UINT32)_cachedShadowMaps.size(); i++)
+        {
+            const ShadowCachedMap& shadowMap = _cachedShadowMaps[i];
+
+            if (shadowMap.GetLight() == light._internal && shadowMap.GetSize() == size && shadowMap.IsCube() == cube)
+                return i;
+        }
+
+        return (UINT32)-1;
+    }
+
+    void ShadowRendering::ReuseShadowMap(const RendererLight& rendererLight, const ShadowMapOptions& options, bool cube)
+    {
+        UINT32 textureIdx = GetCachedShadowMap(rendererLight, options.MapSize, cube);
+
+        ShadowInfo mapInfo = _cachedShadowMaps[textureIdx].GetShadowInfo();
+        mapInfo.LightIdx = options.LightIdx;
+        mapInfo.TextureIdx = textureIdx;
+        mapInfo.FadePerView = options.FadePercents;
+
+        LightShadows& lightShadows = cube ? _radialLightShadows[options.LightIdx] : _spotLightShadows[options.LightIdx];
+
+        _shadowInfos[lightShadows.StartIdx + lightShadows.NumShadows] = mapInfo;
+        lightShadows.NumShadows++;
+    }
+
+    void ShadowRendering::ScheduleShadowUpdates(const SceneInfo& sceneInfo, UINT64 frameIdx)
+    {
+        struct ScheduledShadow
+        {
+            ShadowMapOptions* Options;
+            UINT64 Cost;
+            float Overdue;
+            bool MustUpdate;
+        };
+
+        te_frame_mark();
+        {
+            FrameVector<ScheduledShadow> scheduled;
+            scheduled.reserve(_spotLightShadowOptions.size() + _radialLightShadowOptions.size());
+
+            auto addLights = [&](Vector<ShadowMapOptions>& lightOptions, const Vector<RendererLight>& lights, bool cube)
+            {
+                for (auto& options : lightOptions)
+                {
+                    const RendererLight& light = lights[options.LightIdx];
+
+                    // A map half the maximum size or more is updated every frame, and every halving of the size doubles
+                    // the interval
+                    options.UpdateInterval = Math::Clamp(_shadowMapSize / std::max(options.MapSize * 2, 1u), 1u,
+                        MAX_UPDATE_INTERVAL);
+                    options.Persistent = options.UpdateInterval > 1 ||
+                        light._internal->GetCastShadowsType() != Light::CastShadowsType::Dynamic;
+                    options.Update = true;
+
+                    ScheduledShadow entry;
+                    entry.Options = &options;
+                    entry.Cost = (UINT64)options.MapSize * options.MapSize * (cube ? 6 : 1);
+                    entry.Overdue = 0.0f;
+                    entry.MustUpdate = true;
+
+                    UINT32 mapIdx = options.Persistent ? FindCachedShadowMap(light, options.MapSize, cube) : (UINT32)-1;
+                    if (mapIdx != (UINT32)-1)
+                    {
+                        const ShadowCachedMap& shadowMap = _cachedShadowMaps[mapIdx];
+                        if (shadowMap.HasContent(GetShadowLightState(light, options.MapSize, cube)))
+                        {
+                            // Already rendered for a previous render target this frame
+                            UINT64 age = frameIdx - shadowMap.GetLastUpdateFrame();
+                            if (age == 0)
+                            {
+                                options.Update = false;
+                                continue;
+                            }
+
+                            entry.MustUpdate = false;
+                            entry.Overdue = (float)age / options.UpdateInterval;
+
+                            // Whether or not it is updated now, the map doesn't show the casters as they were last frame
+                            if (shadowMap.GetLastUpdateFrame() < _castersChangedFrame)
+                                _settledFrame = std::max(_settledFrame, frameIdx + 1);
+                        }
+                    }
+
+                    scheduled.push_back(entry);
+                }
+            };
+
+            addLights(_spotLightShadowOptions, sceneInfo.SpotLights, false);
+            addLights(_radialLightShadowOptions, sceneInfo.RadialLights, true);
+
+            // Shadows with nothing to sample from come first, then the ones that are due, the most overdue first. A
+            // shadow skipped for lack of budget gets more overdue every frame, so it is eventually updated.
+            std::sort(scheduled.begin(), scheduled.end(), [](const ScheduledShadow& a, const ScheduledShadow& b)
+            {
+                if (a.MustUpdate != b.MustUpdate)
+                    return a.MustUpdate;
+
+                if (a.Overdue != b.Overdue)
+                    return a.Overdue > b.Overdue;
+
+                return a.Options->Coverage > b.Options->Coverage;
+            });
+
+            for (auto& entry : scheduled)
+            {
+                if (!entry.MustUpdate)
+                {
+                    bool isDue = entry.Overdue >= 1.0f;
+                    bool fitsBudget = _updateBudget == 0 || _spentTexels + entry.Cost <= _updateBudget;
+
+                    if (!isDue || !fitsBudget)
+                    {
+                        entry.Options->Update = false;
+                        continue;
+                    }
+                }
+
+                _spentTexels += entry.Cost;
+            }
+        }
+        te_frame_clear();
+    }
+
+    ShadowCachedMap::LightState ShadowRendering::GetShadowLightState(const RendererLight& light, UINT32 mapSize, bool cube)
+    {
+        const Light& lightInternal = *light._internal;
+        const float radius = lightInternal.GetBounds().GetRadius();
+
+        // Must match the depth ranges RenderSpotShadowMap() and RenderRadialShadowMap() render with
+        ShadowCachedMap::LightState state;
+        state.Bounds = lightInternal.GetBounds();
+        state.Layer = lightInternal.GetLayer();
+
+        if (cube)
+        {
+            // Faces look along the world axes, the rotation of the light doesn't matter
+            state.Position = lightInternal.GetTransform().GetPosition();
+            state.DepthBias = GetDepthBias(lightInternal, radius, 1.0f - 0.05f, mapSize);
+        }
+        else
+        {
+            state.Position = light.GetShiftedLightPosition();
+            state.Rotation = lightInternal.GetTransform().GetRotation();
+            state.SpotAngle = lightInternal.GetSpotAngle();
+            state.DepthBias = GetDepthBias(lightInternal, radius, radius - 0.05f, mapSize);
+        }
+
+        return state;
+    }
+
+    void ShadowRendering::InvalidateCachedShadowMaps(SceneInfo& sceneInfo)
+    {
+        // Lights are only used as keys here, a cached map can outlive its light until it is evicted
+        auto invalidateFlaggedLights = [this](Vector<RendererLight>& lights)
+        {
+            for (auto& light : lights)
+            {
+                if (!light.RedrawStaticShadow)
+                    continue;
+
+                for (auto& shadowMap : _cachedShadowMaps)
+                {
+                    if (shadowMap.GetLight() == light._internal)
+                        shadowMap.InvalidateStatic();
+                }
+
+                light.RedrawStaticShadow = false;
+            }
+        };
+
+        invalidateFlaggedLights(sceneInfo.SpotLights);
+        invalidateFlaggedLights(sceneInfo.RadialLights);
+
+        // Shadow maps are rendered once per render target, the changes only need to be checked once
+        if (sceneInfo.StaticCasterChangesChecked)
+            return;
+
+        // Changes pile up while no shadows are rendered, past a point they aren't kept and nothing cached can be trusted
+        const bool missedChanges = sceneInfo.StaticCasterChangesOverflow;
+        sceneInfo.StaticCasterChangesChecked = true;
+        sceneInfo.StaticCasterChangesOverflow = false;
+
+        for (auto& shadowMap : _cachedShadowMaps)
+        {
+            if (missedChanges)
+            {
+                shadowMap.InvalidateStatic();
+                continue;
+            }
+
+            for (auto& bounds : sceneInfo.StaticCasterChanges)
+            {
+                if (shadowMap.GetBounds().Intersects(bounds))
+                {
+                    shadowMap.InvalidateStatic();
+                    break;
+                }
+            }
+        }
+    }
+
     void ShadowRendering::RenderCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, RendererScene& scene,
         const FrameInfo& frameInfo)
     {
@@ -654,16 +1245,24 @@ namespace te
         shadowInfo.UpdateNormArea(mapSize);
 
         UINT32 numCascades = view.GetRenderSettings().ShadowSettings.NumCascades;
-        for (UINT32 i = 0; i < (UINT32)_cascadedShadowMaps.size(); i++)
-        {
-            ShadowCascadedMap& shadowMap = _cascadedShadowMaps[i];
 
-            if (!shadowMap.IsUsed() && shadowMap.GetSize() == mapSize && shadowMap.GetNumCascades() == numCascades)
+        // Prefer the map rendered for this light and view last time, so its far cascades can be sampled again
+        for (UINT32 pass = 0; pass < 2 && shadowInfo.TextureIdx == (UINT32)-1; pass++)
+        {
+            for (UINT32 i = 0; i < (UINT32)_cascadedShadowMaps.size(); i++)
             {
-                shadowInfo.TextureIdx = i;
-                shadowMap.MarkAsUsed();
+                ShadowCascadedMap& shadowMap = _cascadedShadowMaps[i];
 
-                break;
+                if (pass == 0 && !shadowMap.IsOwnedBy(light, &view))
+                    continue;
+
+                if (!shadowMap.IsUsed() && shadowMap.GetSize() == mapSize && shadowMap.GetNumCascades() == numCascades)
+                {
+                    shadowInfo.TextureIdx = i;
+                    shadowMap.MarkAsUsed();
+
+                    break;
+                }
             }
         }
 
@@ -681,85 +1280,148 @@ namespace te
         Quaternion lightRotation(TeIdentity);
         lightRotation.LookRotation(lightDir, Vector3::UNIT_Y);
 
+        shadowMap.SetOwner(light, &view, lightRotation);
+
+        // The cascades past the first ones are updated one per frame in turn
+        UINT32 numFarCascades = numCascades > FULL_RATE_CASCADES ? numCascades - FULL_RATE_CASCADES : 0;
+        UINT32 updatedFarCascade = numFarCascades > 0
+            ? FULL_RATE_CASCADES + (UINT32)(frameInfo.Timings.FrameIdx % numFarCascades)
+            : (UINT32)-1;
+
+        // Every far cascade is rendered again within numFarCascades frames of the casters changing
+        if (numFarCascades > 0)
+            _settledFrame = std::max(_settledFrame, _castersChangedFrame + numFarCascades);
+
         rapi.PushMarker("[DRAW] Project Directional Shadow", Color(0.85f, 0.43f, 0.25f));
 
-        for (UINT32 i = 0; i < numCascades; ++i)
+        te_frame_mark();
         {
-            rapi.PushMarker("[DRAW] Project Directional Shadow Cascade", Color(0.7f, 0.47f, 0.25f));
+            FrameVector<ConvexVolume> cascadeCullVolumes(numCascades);
+            FrameVector<Sphere> cascadeBounds(numCascades);
 
-            Sphere frustumBounds;
-            ConvexVolume cascadeCullVolume = GetCSMSplitFrustum(view, lightDir, i, numCascades, frustumBounds);
+            for (UINT32 i = 0; i < numCascades; ++i)
+                cascadeCullVolumes[i] = GetCSMSplitFrustum(view, lightDir, i, numCascades, cascadeBounds[i]);
 
-            // Make sure the size of the projected area is in multiples of shadow map pixel size (for stability)
-            float worldUnitsPerTexel = frustumBounds.GetRadius() * 2.0f / shadowMap.GetSize();
+            // The scene is only walked once for all cascades, each cascade then goes through the casters overlapping it
+            FrameVector<ShadowRenderQueue::Caster> casters;
+            ShadowRenderQueueCascadesOptions cascadesOptions(cascadeCullVolumes.data(), numCascades);
+            ShadowRenderQueue::Gather(scene, cascadesOptions, *light, ShadowCasterFilter::All, casters);
 
-            float orthoSize = floor(frustumBounds.GetRadius() * 2.0f / worldUnitsPerTexel) * worldUnitsPerTexel * 0.5f;
-            worldUnitsPerTexel = orthoSize * 2.0f / shadowMap.GetSize();
+            FrameVector<ShadowRenderQueue::Caster> cascadeCasters;
+            cascadeCasters.reserve(casters.size());
 
-            // Snap caster origin to the shadow map pixel grid, to ensure shadow map stability
-            Vector3 casterOrigin = frustumBounds.GetCenter();
-            Matrix4 shadowView = Matrix4::View(Vector3::ZERO, lightRotation);
-            Vector3 shadowSpaceOrigin = shadowView.MultiplyAffine(casterOrigin);
+            for (UINT32 i = 0; i < numCascades; ++i)
+            {
+                const Sphere& frustumBounds = cascadeBounds[i];
+                const ConvexVolume& cascadeCullVolume = cascadeCullVolumes[i];
 
-            Vector2 snapOffset(fmod(shadowSpaceOrigin.x, worldUnitsPerTexel), fmod(shadowSpaceOrigin.y, worldUnitsPerTexel));
-            shadowSpaceOrigin.x -= snapOffset.x;
-            shadowSpaceOrigin.y -= snapOffset.y;
+                // A far cascade waiting for its turn is sampled as it was rendered, as long as what it covers still
+                // contains the split of the view, give or take the fade band
+                if (i >= FULL_RATE_CASCADES && i != updatedFarCascade && shadowMap.IsCascadeValid(i))
+                {
+                    ShadowInfo renderedInfo = shadowMap.GetShadowInfo(i);
+                    const Sphere& renderedBounds = renderedInfo.SubjectBounds;
 
-            Matrix4 shadowViewInv = shadowView.InverseAffine();
-            casterOrigin = shadowViewInv.MultiplyAffine(shadowSpaceOrigin);
+                    float drift = frustumBounds.GetCenter().Distance(renderedBounds.GetCenter());
+                    if (drift + frustumBounds.GetRadius() <= renderedBounds.GetRadius() * (1.0f + CASCADE_FRACTION_FADE))
+                    {
+                        // Rendered for where the view was, until its turn comes
+                        if (drift > 0.0f || frustumBounds.GetRadius() != renderedBounds.GetRadius())
+                            _settledFrame = std::max(_settledFrame, frameInfo.Timings.FrameIdx + 1);
 
-            // Move the light so it is centered at the subject frustum, with depth range covering the frustum bounds
-            shadowInfo.DepthRange = frustumBounds.GetRadius() * 2.0f;
+                        renderedInfo.TextureIdx = shadowInfo.TextureIdx;
+                        shadowMap.SetShadowInfo(i, renderedInfo);
+                        continue;
+                    }
+                }
 
-            Vector3 offsetLightPos = casterOrigin - lightDir * frustumBounds.GetRadius();
-            Matrix4 offsetViewMat = Matrix4::View(offsetLightPos, lightRotation);
+                rapi.PushMarker("[DRAW] Project Directional Shadow Cascade", Color(0.7f, 0.47f, 0.25f));
 
-            Matrix4 proj = Matrix4::ProjectionOrthographic(-orthoSize, orthoSize, orthoSize, -orthoSize, 0.0f,
-                shadowInfo.DepthRange);
+                // Make sure the size of the projected area is in multiples of shadow map pixel size (for stability)
+                float worldUnitsPerTexel = frustumBounds.GetRadius() * 2.0f / shadowMap.GetSize();
 
-            RenderAPI::Instance().ConvertProjectionMatrix(proj, proj);
+                float orthoSize = floor(frustumBounds.GetRadius() * 2.0f / worldUnitsPerTexel) * worldUnitsPerTexel * 0.5f;
+                worldUnitsPerTexel = orthoSize * 2.0f / shadowMap.GetSize();
 
-            shadowInfo.CascadeIdx = i;
-            shadowInfo.ShadowVPTransform = proj * offsetViewMat;
+                // Snap caster origin to the shadow map pixel grid, to ensure shadow map stability
+                Vector3 casterOrigin = frustumBounds.GetCenter();
+                Matrix4 shadowView = Matrix4::View(Vector3::ZERO, lightRotation);
+                Vector3 shadowSpaceOrigin = shadowView.MultiplyAffine(casterOrigin);
 
-            // Determine split range
-            float splitNear = GetCSMSplitDistance(view, i, numCascades);
-            float splitFar = GetCSMSplitDistance(view, i + 1, numCascades);
+                Vector2 snapOffset(fmod(shadowSpaceOrigin.x, worldUnitsPerTexel), fmod(shadowSpaceOrigin.y, worldUnitsPerTexel));
+                shadowSpaceOrigin.x -= snapOffset.x;
+                shadowSpaceOrigin.y -= snapOffset.y;
 
-            shadowInfo.DepthNear = splitNear;
-            shadowInfo.DepthFade = splitFar;
-            shadowInfo.SubjectBounds = frustumBounds;
+                Matrix4 shadowViewInv = shadowView.InverseAffine();
+                casterOrigin = shadowViewInv.MultiplyAffine(shadowSpaceOrigin);
 
-            if ((UINT32)(i + 1) < numCascades)
-                shadowInfo.FadeRange = CASCADE_FRACTION_FADE * (shadowInfo.DepthFade - shadowInfo.DepthNear);
-            else
-                shadowInfo.FadeRange = 0.0f;
+                // Move the light so it is centered at the subject frustum, with depth range covering the frustum bounds
+                shadowInfo.DepthRange = frustumBounds.GetRadius() * 2.0f;
 
-            shadowInfo.DepthFar = shadowInfo.DepthFade + shadowInfo.FadeRange;
-            shadowInfo.DepthBias = GetDepthBias(*light, frustumBounds.GetRadius(), shadowInfo.DepthRange, mapSize);
+                Vector3 offsetLightPos = casterOrigin - lightDir * frustumBounds.GetRadius();
+                Matrix4 offsetViewMat = Matrix4::View(offsetLightPos, lightRotation);
 
-            gShadowParamsDef.gDepthBias.Set(shadowParamsBuffer, shadowInfo.DepthBias);
-            gShadowParamsDef.gInvDepthRange.Set(shadowParamsBuffer, 1.0f / shadowInfo.DepthRange);
-            gShadowParamsDef.gMatViewProj.Set(shadowParamsBuffer, shadowInfo.ShadowVPTransform);
-            gShadowParamsDef.gNDCZToDeviceZ.Set(shadowParamsBuffer, RendererView::GetNDCZToDeviceZ());
+                Matrix4 proj = Matrix4::ProjectionOrthographic(-orthoSize, orthoSize, orthoSize, -orthoSize, 0.0f,
+                    shadowInfo.DepthRange);
 
-            rapi.SetRenderTarget(shadowMap.GetTarget(i));
-            rapi.ClearRenderTarget(FBT_DEPTH);
+                RenderAPI::Instance().ConvertProjectionMatrix(proj, proj);
 
-            ShadowDepthDirectionalMat* depthDirMat = ShadowDepthDirectionalMat::Get();
-            depthDirMat->Bind(shadowParamsBuffer);
+                shadowInfo.CascadeIdx = i;
+                shadowInfo.ShadowVPTransform = proj * offsetViewMat;
 
-            // Render all renderables into the shadow map
-            ShadowRenderQueueDirOptions dirOptions(
-                cascadeCullVolume,
-                shadowParamsBuffer);
+                // Determine split range
+                float splitNear = GetCSMSplitDistance(view, i, numCascades);
+                float splitFar = GetCSMSplitDistance(view, i + 1, numCascades);
 
-            ShadowRenderQueue::Execute(scene, frameInfo, dirOptions, *light);
+                shadowInfo.DepthNear = splitNear;
+                shadowInfo.DepthFade = splitFar;
+                shadowInfo.SubjectBounds = frustumBounds;
 
-            shadowMap.SetShadowInfo(i, shadowInfo);
+                if ((UINT32)(i + 1) < numCascades)
+                    shadowInfo.FadeRange = CASCADE_FRACTION_FADE * (shadowInfo.DepthFade - shadowInfo.DepthNear);
+                else
+                    shadowInfo.FadeRange = 0.0f;
 
-            rapi.PopMarker();
+                shadowInfo.DepthFar = shadowInfo.DepthFade + shadowInfo.FadeRange;
+                shadowInfo.DepthBias = GetDepthBias(*light, frustumBounds.GetRadius(), shadowInfo.DepthRange, mapSize);
+
+                gShadowParamsDef.gDepthBias.Set(shadowParamsBuffer, shadowInfo.DepthBias);
+                gShadowParamsDef.gInvDepthRange.Set(shadowParamsBuffer, 1.0f / shadowInfo.DepthRange);
+                gShadowParamsDef.gMatViewProj.Set(shadowParamsBuffer, shadowInfo.ShadowVPTransform);
+                gShadowParamsDef.gNDCZToDeviceZ.Set(shadowParamsBuffer, RendererView::GetNDCZToDeviceZ());
+
+                rapi.SetRenderTarget(shadowMap.GetTarget(i));
+                rapi.ClearRenderTarget(FBT_DEPTH);
+
+                ShadowDepthDirectionalMat* depthDirMat = ShadowDepthDirectionalMat::Get();
+                depthDirMat->Bind(shadowParamsBuffer);
+
+                // Render all renderables into the shadow map
+                ShadowRenderQueueDirOptions dirOptions(
+                    cascadeCullVolume,
+                    shadowParamsBuffer,
+                    _shadowInstancesBuffer,
+                    orthoSize);
+
+                cascadeCasters.clear();
+                for (auto& caster : casters)
+                {
+                    if ((caster.Mask & (1 << i)) == 0)
+                        continue;
+
+                    cascadeCasters.push_back(caster);
+                    ShadowRenderQueue::SelectLod(scene, dirOptions, shadowMap.GetCasterLods(i), cascadeCasters.back());
+                }
+
+                ShadowRenderQueue::Draw(scene, dirOptions, cascadeCasters);
+
+                shadowMap.SetShadowInfo(i, shadowInfo);
+                _spentTexels += (UINT64)mapSize * mapSize;
+
+                rapi.PopMarker();
+            }
         }
+        te_frame_clear();
 
         rapi.PopMarker();
 
@@ -782,38 +1444,45 @@ namespace te
         if (!_shadowParamsBuffer)
             _shadowParamsBuffer = gShadowParamsDef.CreateBuffer();
 
-        bool foundSpace = false;
-        for (UINT32 i = 0; i < (UINT32)_dynamicShadowMaps.size(); i++)
+        // Lights with static casters or not updated every frame get a map of their own to keep them in, the others share
+        // atlases rebuilt every frame
+        mapInfo.IsCached = options.Persistent;
+        if (mapInfo.IsCached)
         {
-            ShadowMapAtlas& atlas = _dynamicShadowMaps[i];
-
-            if (atlas.AddMap(options.MapSize, mapInfo.Area, SHADOW_MAP_BORDER))
+            mapInfo.TextureIdx = GetCachedShadowMap(rendererLight, options.MapSize, false);
+            mapInfo.Area = Rect2I(0, 0, options.MapSize, options.MapSize);
+            mapInfo.UpdateNormArea(options.MapSize);
+        }
+        else
+        {
+            bool foundSpace = false;
+            for (UINT32 i = 0; i < (UINT32)_dynamicShadowMaps.size(); i++)
             {
-                mapInfo.TextureIdx = i;
+                ShadowMapAtlas& atlas = _dynamicShadowMaps[i];
 
-                foundSpace = true;
-                break;
+                if (atlas.AddMap(options.MapSize, mapInfo.Area, SHADOW_MAP_BORDER))
+                {
+                    mapInfo.TextureIdx = i;
+
+                    foundSpace = true;
+                    break;
+                }
             }
-        }
 
-        if (!foundSpace)
-        {
-            mapInfo.TextureIdx = (UINT32)_dynamicShadowMaps.size();
-            _dynamicShadowMaps.push_back(ShadowMapAtlas(MAX_ATLAS_SIZE));
+            if (!foundSpace)
+            {
+                mapInfo.TextureIdx = (UINT32)_dynamicShadowMaps.size();
+                _dynamicShadowMaps.push_back(ShadowMapAtlas(MAX_ATLAS_SIZE));
 
-            ShadowMapAtlas& atlas = _dynamicShadowMaps.back();
-            atlas.AddMap(options.MapSize, mapInfo.Area, SHADOW_MAP_BORDER);
-        }
+                ShadowMapAtlas& atlas = _dynamicShadowMaps.back();
+                atlas.AddMap(options.MapSize, mapInfo.Area, SHADOW_MAP_BORDER);
+            }
 
-        mapInfo.UpdateNormArea(MAX_ATLAS_SIZE);
-        ShadowMapAtlas& atlas = _dynamicShadowMaps[mapInfo.TextureIdx];
+            mapInfo.UpdateNormArea(MAX_ATLAS_SIZE);
+        }
 
         rapi.PushMarker("[DRAW] Project Spot Shadow", Color(0.85f, 0.43f, 0.25f));
 
-        rapi.SetRenderTarget(atlas.GetTarget());
-        rapi.SetViewport(mapInfo.NormArea);
-        rapi.ClearViewport(FBT_DEPTH);
-
         //float maxAttenuationRadius = Math::Sqrt(1.f / (4 * Math::PI * 0.0001f));
 
         mapInfo.DepthNear = 0.05f;
@@ -855,12 +1524,31 @@ namespace te
         // Render all renderables into the shadow map
         ShadowRenderQueueSpotOptions spotOptions(
             worldFrustum,
-            _shadowParamsBuffer);
+            _shadowParamsBuffer,
+            _shadowInstancesBuffer,
+            light->GetTransform().GetPosition(),
+            light->GetSpotAngle());
+
+        if (mapInfo.IsCached)
+        {
+            ShadowCachedMap& shadowMap = _cachedShadowMaps[mapInfo.TextureIdx];
+            ShadowCachedMap::LightState state = GetShadowLightState(rendererLight, options.MapSize, false);
+            bool cacheStatic = light->GetCastShadowsType() != Light::CastShadowsType::Dynamic;
+
+            RenderCachedShadowCasters(shadowMap, state, cacheStatic, scene, frameInfo, spotOptions, rendererLight);
+            shadowMap.SetContent(state, frameInfo.Timings.FrameIdx, mapInfo);
+        }
+        else
+        {
+            rapi.SetRenderTarget(_dynamicShadowMaps[mapInfo.TextureIdx].GetTarget());
+            rapi.SetViewport(mapInfo.NormArea);
+            rapi.ClearViewport(FBT_DEPTH);
 
-        ShadowRenderQueue::Execute(scene, frameInfo, spotOptions, *light);
+            ShadowRenderQueue::Execute(scene, frameInfo, spotOptions, rendererLight);
 
-        // Restore viewport
-        rapi.SetViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
+            // Restore viewport
+            rapi.SetViewport(Rect2(0.0f, 0.0f, 1.0f, 1.0f));
+        }
 
         LightShadows& lightShadows = _spotLightShadows[options.LightIdx];
 
@@ -891,31 +1579,35 @@ namespace te
         mapInfo.CascadeIdx = (UINT32)-1;
         mapInfo.Area = Rect2I(0, 0, options.MapSize, options.MapSize);
         mapInfo.UpdateNormArea(options.MapSize);
+        mapInfo.IsCached = options.Persistent;
 
-        for (UINT32 i = 0; i < (UINT32)_shadowCubemaps.size(); i++)
+        if (mapInfo.IsCached)
+            mapInfo.TextureIdx = GetCachedShadowMap(rendererLight, options.MapSize, true);
+        else
         {
-            ShadowCubemap& cubemap = _shadowCubemaps[i];
-
-            if (!cubemap.IsUsed() && cubemap.GetSize() == options.MapSize)
+            for (UINT32 i = 0; i < (UINT32)_shadowCubemaps.size(); i++)
             {
-                mapInfo.TextureIdx = i;
-                cubemap.MarkAsUsed();
+                ShadowCubemap& cubemap = _shadowCubemaps[i];
 
-                break;
+                if (!cubemap.IsUsed() && cubemap.GetSize() == options.MapSize)
+                {
+                    mapInfo.TextureIdx = i;
+                    cubemap.MarkAsUsed();
+
+                    break;
+                }
             }
-        }
 
-        if (mapInfo.TextureIdx == (UINT32)-1)
-        {
-            mapInfo.TextureIdx = (UINT32)_shadowCubemaps.size();
-            _shadowCubemaps.push_back(ShadowCubemap(options.MapSize));
+            if (mapInfo.TextureIdx == (UINT32)-1)
+            {
+                mapInfo.TextureIdx = (UINT32)_shadowCubemaps.size();
+                _shadowCubemaps.push_back(ShadowCubemap(options.MapSize));
 
-            ShadowCubemap& cubemap = _shadowCubemaps.back();
-            cubemap.MarkAsUsed();
+                ShadowCubemap& cubemap = _shadowCubemaps.back();
+                cubemap.MarkAsUsed();
+            }
         }
 
-        ShadowCubemap& cubemap = _shadowCubemaps[mapInfo.TextureIdx];
-
         mapInfo.DepthNear = 0.05f;
         mapInfo.DepthFar = 1.f;
         mapInfo.DepthFade = mapInfo.DepthFar;
@@ -1020,9 +1712,6 @@ namespace te
         {
             rapi.PushMarker("[DRAW] Project Radial Shadow", Color(0.85f, 0.43f, 0.25f));
 
-            rapi.SetRenderTarget(cubemap.GetTarget());
-            rapi.ClearRenderTarget(FBT_DEPTH);
-
             // Render all renderables into the shadow map
             ConvexVolume boundingVolume(boundingPlanes);
             ShadowRenderQueueCubeOptions cubeOptions(
@@ -1030,10 +1719,27 @@ namespace te
                 boundingVolume,
                 shadowParamsBuffer,
                 shadowCubeMatricesBuffer,
-                shadowCubeMasksBuffer
+                shadowCubeMasksBuffer,
+                _shadowInstancesBuffer,
+                light->GetTransform().GetPosition()
             );
 
-            ShadowRenderQueue::Execute(scene, frameInfo, cubeOptions, *light);
+            if (mapInfo.IsCached)
+            {
+                ShadowCachedMap& shadowMap = _cachedShadowMaps[mapInfo.TextureIdx];
+                ShadowCachedMap::LightState state = GetShadowLightState(rendererLight, options.MapSize, true);
+                bool cacheStatic = light->GetCastShadowsType() != Light::CastShadowsType::Dynamic;
+
+                RenderCachedShadowCasters(shadowMap, state, cacheStatic, scene, frameInfo, cubeOptions, rendererLight);
+                shadowMap.SetContent(state, frameInfo.Timings.FrameIdx, mapInfo);
+            }
+            else
+            {
+                rapi.SetRenderTarget(_shadowCubemaps[mapInfo.TextureIdx].GetTarget());
+                rapi.ClearRenderTarget(FBT_DEPTH);
+
+                ShadowRenderQueue::Execute(scene, frameInfo, cubeOptions, rendererLight);
+            }
 
             rapi.PopMarker();
         }
@@ -1045,7 +1751,7 @@ namespace te
     }
 
     void ShadowRendering::CalcShadowMapProperties(const RendererLight& light, const RendererViewGroup& viewGroup,
-        UINT32 border, UINT32& size, Vector<float>& fadePercents, float& maxFadePercent) const
+        UINT32 border, UINT32& size, Vector<float>& fadePercents, float& maxFadePercent, float& coverage) const
     {
         const static float SHADOW_TEXELS_PER_PIXEL = 1.0f;
 
@@ -1093,6 +1799,8 @@ namespace te
             }
         }
 
+        coverage = maxMapSize;
+
         // If light fully (or nearly fully) covers the screen, use full shadow map resolution, otherwise
         // scale it down to smaller power of two, while clamping to minimal allowed resolution
         UINT32 effectiveMapSize = Bitwise::NextPow2((UINT32)maxMapSize);
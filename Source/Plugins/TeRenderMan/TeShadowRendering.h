@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TeRenderManPrerequisites.h"
+#include "TeRendererLight.h"
 #include "Resources/TeBuiltinResources.h"
 #include "Renderer/TeRendererMaterial.h"
 #include "Renderer/TeGpuResourcePool.h"
@@ -24,6 +25,15 @@ namespace te
 
     extern ShadowParamsDef gShadowParamsDef;
 
+    /** Maximum number of shadow casters drawn by a single instanced draw call. */
+    #define SHADOW_MAX_INSTANCED_BLOCK_SIZE 128
+
+    TE_PARAM_BLOCK_BEGIN(ShadowInstancesDef)
+        TE_PARAM_BLOCK_ENTRY_ARRAY(Matrix4, gInstanceWorld, SHADOW_MAX_INSTANCED_BLOCK_SIZE)
+    TE_PARAM_BLOCK_END
+
+    extern ShadowInstancesDef gShadowInstancesDef;
+
     /** Material used for rendering a single face of a shadow map, while applying bias in the pixel shader. */
     class ShadowDepthNormalMat : public RendererMaterial<ShadowDepthNormalMat>
     {
@@ -44,12 +54,22 @@ namespace te
     public:
         ShadowDepthNormalMat() = default;
 
-        /** Binds the material to the pipeline, ready to be used on subsequent draw calls. */
-        void Bind(const SPtr<GpuParamBlockBuffer>& shadowParams);
+        /**
+         * Binds the material to the pipeline, ready to be used on subsequent draw calls. @p sceneObjects is the buffer of
+         * the GPU scene, if the per-object data of the casters lives there.
+         */
+        void Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<te::GpuBuffer>& sceneObjects = nullptr);
 
         /** Sets a new buffer that determines per-object properties. */
         void SetPerObjectBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams, const SPtr<te::GpuBuffer>& boneMatrices);
 
+        /**
+         * Sets the buffers of an instanced draw: the world transforms of the instances, and the per-object properties of
+         * one of them for the vertex decoding parameters they share.
+         */
+        void SetPerInstanceBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
+            const SPtr<GpuParamBlockBuffer>& perInstanceParams);
+
         /**
          * Returns the material variation matching the provided parameters.
          *
@@ -78,12 +98,19 @@ namespace te
     public:
         ShadowDepthDirectionalMat() = default;
 
-        /** Binds the material to the pipeline, ready to be used on subsequent draw calls. */
-        void Bind(const SPtr<GpuParamBlockBuffer>& shadowParams);
+        /** @copydoc ShadowDepthNormalMat::Bind */
+        void Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<te::GpuBuffer>& sceneObjects = nullptr);
 
         /** Sets a new buffer that determines per-object properties. */
         void SetPerObjectBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams, const SPtr<te::GpuBuffer>& boneMatrices);
 
+        /**
+         * Sets the buffers of an instanced draw: the world transforms of the instances, and the per-object properties of
+         * one of them for the vertex decoding parameters they share.
+         */
+        void SetPerInstanceBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
+            const SPtr<GpuParamBlockBuffer>& perInstanceParams);
+
         /**
          * Returns the material variation matching the provided parameters.
          *
@@ -123,13 +150,18 @@ namespace te
     public:
         ShadowDepthCubeMat() = default;
 
-        /** Binds the material to the pipeline, ready to be used on subsequent draw calls. */
-        void Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<GpuParamBlockBuffer>& shadowCubeParams);
+        /** @copydoc ShadowDepthNormalMat::Bind */
+        void Bind(const SPtr<GpuParamBlockBuffer>& shadowParams, const SPtr<GpuParamBlockBuffer>& shadowCubeParams,
+            const SPtr<te::GpuBuffer>& sceneObjects = nullptr);
 
         /** Sets a new buffer that determines per-object properties. */
         void SetPerObjectBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
             const SPtr<GpuParamBlockBuffer>& shadowCubeMasks, const SPtr<te::GpuBuffer>& boneMatrices);
 
+        /** @copydoc ShadowDepthNormalMat::SetPerInstanceBuffer */
+        void SetPerInstanceBuffer(const SPtr<GpuParamBlockBuffer>& perObjectParams,
+            const SPtr<GpuParamBlockBuffer>& perInstanceParams);
+
         /**
          * Returns the material variation matching the provided parameters.
          *
@@ -162,6 +194,9 @@ namespace te
 
         UINT32 CascadeIdx = (UINT32)-1; /**< Index of a cascade. Only relevant for CSM. */
 
+        /** True if TextureIdx refers to a persistent map of the light (ShadowCachedMap) instead of an atlas or a cubemap. */
+        bool IsCached = false;
+
         /** View-projection matrix from the shadow casters point of view. */
         Matrix4 ShadowVPTransform;
 
@@ -274,16 +309,123 @@ namespace te
         /** Returns a render target that allows rendering into a specific cascade of the cascaded shadow map. */
         SPtr<RenderTexture> GetTarget(UINT32 cascadeIdx) const;
 
-        /** Provides information about a shadow for the specified cascade. */
-        void SetShadowInfo(UINT32 cascadeIdx, const ShadowInfo& info) { _shadowInfos[cascadeIdx] = info; }
+        /** Provides information about a shadow for the specified cascade. Marks the cascade as valid. */
+        void SetShadowInfo(UINT32 cascadeIdx, const ShadowInfo& info);
 
         /** @copydoc setShadowInfo */
         const ShadowInfo& GetShadowInfo(UINT32 cascadeIdx) const { return _shadowInfos[cascadeIdx]; }
 
+        /** Returns true if the map has last been rendered for @p light seen from @p view. */
+        bool IsOwnedBy(const Light* light, const RendererView* view) const { return _light == light && _view == view; }
+
+        /**
+         * Assigns the map to @p light seen from @p view, the light looking along @p lightRotation. Invalidates all
+         * cascades if any of them changed.
+         */
+        void SetOwner(const Light* light, const RendererView* view, const Quaternion& lightRotation);
+
+        /** Returns true if the cascade holds a shadow rendered for the current owner of the map. */
+        bool IsCascadeValid(UINT32 cascadeIdx) const { return (_validCascades & (1 << cascadeIdx)) != 0; }
+
+        /** Returns the levels of detail picked for the casters of a cascade, while rendered for the current owner. */
+        RenderableLods& GetCasterLods(UINT32 cascadeIdx) { return _casterLods[cascadeIdx]; }
+
     private:
         UINT32 _numCascades;
         Vector<SPtr<RenderTexture>> _targets;
         Vector<ShadowInfo> _shadowInfos;
+        Vector<RenderableLods> _casterLods;
+
+        const Light* _light = nullptr;
+        const RendererView* _view = nullptr;
+        Quaternion _lightRotation = Quaternion::IDENTITY;
+        UINT32 _validCascades = 0;
+    };
+
+    /**
+     * Shadow map of a spot or radial light kept from one frame to the next, so it can be sampled on the frames it isn't
+     * updated on. If the light has static casters, they are rendered in a texture of their own, only again when the
+     * light or one of the static casters around it changes. On every update, the static depth is copied into the map
+     * the light is sampled from and the dynamic casters are drawn on top of it.
+     */
+    class ShadowCachedMap : public ShadowMapBase
+    {
+    public:
+        /** Parameters of the light the static depth has been rendered with. */
+        struct LightState
+        {
+            bool operator== (const LightState& rhs) const;
+            bool operator!= (const LightState& rhs) const { return !(*this == rhs); }
+
+            Vector3 Position = Vector3::ZERO;
+            Quaternion Rotation = Quaternion::IDENTITY;
+            Sphere Bounds;
+            Degree SpotAngle = Degree(0.0f);
+            float DepthBias = 0.0f;
+            UINT64 Layer = 0;
+        };
+
+        ShadowCachedMap(const Light* light, UINT32 size, bool cube);
+
+        /** Returns the light this shadow map belongs to. */
+        const Light* GetLight() const { return _light; }
+
+        /** Returns true if the map is a cubemap, for radial lights. */
+        bool IsCube() const { return _cube; }
+
+        /** Returns the render target of the map the light is sampled from. */
+        SPtr<RenderTexture> GetTarget() const;
+
+        /** Returns the render target of the static casters. Allocates it on first use. */
+        SPtr<RenderTexture> GetStaticTarget();
+
+        /** Returns the bounds of the light the map has last been rendered with. */
+        const Sphere& GetBounds() const { return _contentState.Bounds; }
+
+        /**
+         * Returns true if the map holds a shadow rendered with @p state, whose static depth hasn't been invalidated
+         * since. It can be sampled without being updated, at the cost of missing what the dynamic casters did since.
+         */
+        bool HasContent(const LightState& state) const { return _hasContent && _contentState == state; }
+
+        /** Records that the map has just been rendered with @p state during frame @p frameIdx, as described by @p info. */
+        void SetContent(const LightState& state, UINT64 frameIdx, const ShadowInfo& info);
+
+        /** Returns the index of the frame the map has last been rendered on. */
+        UINT64 GetLastUpdateFrame() const { return _lastUpdateFrame; }
+
+        /** Returns information about the shadow the map holds. Only meaningful if it has content. */
+        const ShadowInfo& GetShadowInfo() const { return _shadowInfo; }
+
+        /** Returns true if the static depth has been rendered with @p state, and no static caster changed since. */
+        bool IsStaticValid(const LightState& state) const { return _staticValid && _state == state; }
+
+        /** Records that the static depth has just been rendered with @p state. */
+        void SetStaticValid(const LightState& state) { _state = state; _staticValid = true; _matchesStatic = false; }
+
+        /** Makes the next update render the static casters again. The map must be updated before being sampled again. */
+        void InvalidateStatic() { _staticValid = false; _hasContent = false; }
+
+        /**
+         * Makes the map the light is sampled from hold the static depth only. Skips the copy if nothing has been drawn on
+         * top of it since the last time.
+         */
+        void RestoreStaticDepth();
+
+        /** Records that dynamic casters have been drawn in the map the light is sampled from. */
+        void NotifyDynamicDrawn() { _matchesStatic = false; }
+
+    private:
+        const Light* _light;
+        SPtr<PooledRenderTexture> _staticMap;
+        LightState _state;
+        LightState _contentState;
+        ShadowInfo _shadowInfo;
+        UINT64 _lastUpdateFrame = 0;
+        bool _cube;
+        bool _staticValid = false;
+        bool _matchesStatic = false;
+        bool _hasContent = false;
     };
 
     /** Provides functionality for rendering shadow maps. */
@@ -296,6 +438,18 @@ namespace te
             UINT32 LightIdx;
             UINT32 MapSize;
             Vector<float> FadePercents;
+
+            /** Size the map would ideally have in the view the light covers the most of, in pixels. */
+            float Coverage = 0.0f;
+
+            /** Number of frames between two updates of the map, for lights covering a small part of the screen. */
+            UINT32 UpdateInterval = 1;
+
+            /** True if the map is kept from one frame to the next in a ShadowCachedMap. */
+            bool Persistent = false;
+
+            /** False if the persistent map of the light is sampled as is this frame. */
+            bool Update = true;
         };
 
         /** Contains references to all shadows cast by a specific light. */
@@ -322,6 +476,16 @@ namespace te
         /** Changes the default shadow map size. Will cause all shadow maps to be rebuilt. */
         void SetShadowMapSize(UINT32 size);
 
+        /** Changes the number of shadow map texels that can be rendered per frame. See RenderManOptions. */
+        void SetShadowUpdateBudget(UINT64 budget) { _updateBudget = budget; }
+
+        /**
+         * Returns true if the shadow maps sampled during frame @p frameIdx hold what rendering all of them again would
+         * give. Cached maps skipped by the update budget and far cascades waiting for their turn can lag behind the
+         * shadow casters and the view for a few frames.
+         */
+        bool AreShadowsSettled(UINT64 frameIdx) const { return frameIdx >= _settledFrame; }
+
     private:
         /** Renders cascaded shadow maps for the provided directional light viewed from the provided view. */
         void RenderCascadedShadowMaps(const RendererView& view, UINT32 lightIdx, RendererScene& scene,
@@ -335,6 +499,31 @@ namespace te
         void RenderRadialShadowMap(const RendererLight& rendererLight, const ShadowMapOptions& options, RendererScene& scene,
             const FrameInfo& frameInfo);
 
+        /** Reuses the persistent map of a light not updated this frame, as its shadow. */
+        void ReuseShadowMap(const RendererLight& rendererLight, const ShadowMapOptions& options, bool cube);
+
+        /**
+         * Returns the index of the cached shadow map of @p light with the requested size and type, creating it if there
+         * is none. Marks it as used.
+         */
+        UINT32 GetCachedShadowMap(const RendererLight& light, UINT32 size, bool cube);
+
+        /** Returns the index of the cached shadow map of @p light with the requested size and type, or -1 if none. */
+        UINT32 FindCachedShadowMap(const RendererLight& light, UINT32 size, bool cube) const;
+
+        /**
+         * Decides which spot and radial light shadows are updated this frame. Lights covering a large part of the screen
+         * are updated every frame, smaller ones at decreasing rates. Lights with nothing to sample from are always
+         * updated, the others as long as the texels rendered this frame stay within the budget, the most overdue first.
+         */
+        void ScheduleShadowUpdates(const SceneInfo& sceneInfo, UINT64 frameIdx);
+
+        /**
+         * Invalidates the static depth of the cached shadow maps whose light has been flagged for a redraw, or whose
+         * volume overlaps a static shadow caster that changed since the last call.
+         */
+        void InvalidateCachedShadowMaps(SceneInfo& sceneInfo);
+
         /**
          * Calculates optimal shadow map size, taking into account all views in the scene. Also calculates a fade value
          * that can be used for fading out small shadow maps.
@@ -346,9 +535,14 @@ namespace te
          * @param[out]	fadePercents	Value in range [0, 1] determining how much should the shadow map be faded out. Each
          *								entry corresponds to a single view.
          * @param[out]	maxFadePercent	Maximum value in the @p fadePercents array.
+         * @param[out]	coverage		Map size the light would ideally have in the view it is the largest in, in pixels.
+         *								Not clamped.
          */
         void CalcShadowMapProperties(const RendererLight& light, const RendererViewGroup& viewGroup, UINT32 border,
-            UINT32& size, Vector<float>& fadePercents, float& maxFadePercent) const;
+            UINT32& size, Vector<float>& fadePercents, float& maxFadePercent, float& coverage) const;
+
+        /** Returns the parameters the shadow map of a spot (or radial, if @p cube) light is rendered with. */
+        static ShadowCachedMap::LightState GetShadowLightState(const RendererLight& light, UINT32 mapSize, bool cube);
 
         /**
          * Generates a frustum for a single cascade of a cascaded shadow map. Also outputs spherical bounds of the
@@ -406,12 +600,33 @@ namespace te
         /** Percent of the length of a single cascade in a CSM, in which to fade out the cascade. */
         static const float CASCADE_FRACTION_FADE;
 
+        /** Maximum number of frames between two updates of a spot or radial light shadow. */
+        static const UINT32 MAX_UPDATE_INTERVAL;
+
+        /** Number of cascades of a CSM updated every frame. The farther ones are updated one per frame in turn. */
+        static const UINT32 FULL_RATE_CASCADES;
+
     private:
         UINT32 _shadowMapSize;
 
+        /** Number of texels that can be rendered per frame, 0 if unlimited. */
+        UINT64 _updateBudget = 0;
+
+        /** Number of texels rendered during frame _budgetFrame. */
+        UINT64 _spentTexels = 0;
+        UINT64 _budgetFrame = (UINT64)-1;
+
+        /** Value of SceneInfo::ShadowCastersVersion last seen, and the frame it was first seen during. */
+        UINT64 _castersVersion = (UINT64)-1;
+        UINT64 _castersChangedFrame = 0;
+
+        /** First frame from which the sampled shadow maps are all up to date, see AreShadowsSettled(). */
+        UINT64 _settledFrame = 0;
+
         Vector<ShadowMapAtlas> _dynamicShadowMaps;
         Vector<ShadowCascadedMap> _cascadedShadowMaps;
         Vector<ShadowCubemap> _shadowCubemaps;
+        Vector<ShadowCachedMap> _cachedShadowMaps;
 
         Vector<ShadowInfo> _shadowInfos;
 
@@ -424,5 +639,6 @@ namespace te
         Vector<ShadowMapOptions> _radialLightShadowOptions; // Transient
 
         SPtr<GpuParamBlockBuffer> _shadowParamsBuffer;
+        SPtr<GpuParamBlockBuffer> _shadowInstancesBuffer;
     };
 }